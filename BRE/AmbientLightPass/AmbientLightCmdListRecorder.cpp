@@ -6,6 +6,8 @@
 #include <DescriptorManager\DescriptorManager.h>
 #include <PSOCreator/PSOCreator.h>
 #include <Utils/DebugUtils.h>
+#include <Utils/Profiler.h>
+#include <Utils/RenderStats.h>
 
 // Root Signature:
 // "DescriptorTable(SRV(t0), SRV(t1), visibility = SHADER_VISIBILITY_PIXEL)" 0 -> BaseColor_MetalMask texture, AmbientAccessibility texture
@@ -91,6 +93,8 @@ void AmbientLightCmdListRecorder::Init(
 }
 
 void AmbientLightCmdListRecorder::RecordAndPushCommandLists() noexcept {
+	PROFILE_ZONE("AmbientLightCmdListRecorder::RecordAndPushCommandLists");
+
 	ASSERT(ValidateData());
 	ASSERT(sPSO != nullptr);
 	ASSERT(sRootSign != nullptr);
@@ -99,6 +103,7 @@ void AmbientLightCmdListRecorder::RecordAndPushCommandLists() noexcept {
 	ASSERT(cmdAlloc != nullptr);
 	
 	CHECK_HR(cmdAlloc->Reset());
+	RENDER_STATS_ADD(PIPELINE_STATE_CHANGES, 1UL);
 	CHECK_HR(mCmdList->Reset(cmdAlloc, sPSO));
 
 	mCmdList->RSSetViewports(1U, &Settings::sScreenViewport);
@@ -107,6 +112,7 @@ void AmbientLightCmdListRecorder::RecordAndPushCommandLists() noexcept {
 
 	ID3D12DescriptorHeap* heaps[] = { &DescriptorManager::Get().GetCbvSrcUavDescriptorHeap() };
 	mCmdList->SetDescriptorHeaps(_countof(heaps), heaps);
+	RENDER_STATS_ADD(ROOT_SIGNATURE_CHANGES, 1UL);
 	mCmdList->SetGraphicsRootSignature(sRootSign);
 	
 	mCmdList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
@@ -114,8 +120,10 @@ void AmbientLightCmdListRecorder::RecordAndPushCommandLists() noexcept {
 	// Draw object
 	mCmdList->IASetVertexBuffers(0U, 1U, &mVertexBufferData.mBufferView);
 	mCmdList->IASetIndexBuffer(&mIndexBufferData.mBufferView);
+	RENDER_STATS_ADD(DESCRIPTOR_TABLES, 1UL);
 	mCmdList->SetGraphicsRootDescriptorTable(0U, mBaseColor_MetalMaskGpuDescHandle);
-	mCmdList->DrawIndexedInstanced(mIndexBufferData.mCount, 1U, 0U, 0U, 0U);
+	RENDER_STATS_DRAW(mIndexBufferData.mCount, 1U);
+	mCmdList->DrawIndexedInstanced(mIndexBufferData.mCount, 1U, mIndexBufferData.mStartIndex, mVertexBufferData.mBaseVertex, 0U);
 
 	mCmdList->Close();
 
@@ -11,6 +11,8 @@
 #include <ModelManager\ModelManager.h>
 #include <ResourceManager\ResourceManager.h>
 #include <Utils\DebugUtils.h>
+#include <Utils/Profiler.h>
+#include <Utils/RenderStats.h>
 
 namespace {
 	void CreateCommandObjects(
@@ -107,6 +109,11 @@ namespace {
 	}
 }
 
+void AmbientLightPass::InitPSOs() noexcept {
+	AmbientLightCmdListRecorder::InitPSO();
+	AmbientOcclusionCmdListRecorder::InitPSO();
+}
+
 void AmbientLightPass::Init(
 	ID3D12Device& device,
 	CommandListExecutor& cmdListExecutor,
@@ -130,17 +137,14 @@ void AmbientLightPass::Init(
 	Model* model;
 	Microsoft::WRL::ComPtr<ID3D12Resource> uploadVertexBuffer;
 	Microsoft::WRL::ComPtr<ID3D12Resource> uploadIndexBuffer;
-	ModelManager::Get().CreateFullscreenQuad(model, *mCmdListBegin, uploadVertexBuffer, uploadIndexBuffer);
+	const std::size_t modelId{ ModelManager::Get().CreateFullscreenQuad(model, *mCmdListBegin, uploadVertexBuffer, uploadIndexBuffer) };
 	ASSERT(model != nullptr);
 
 	// Get vertex and index buffers data from the only mesh this model must have.
 	ASSERT(model->Meshes().size() == 1UL);
 	const Mesh& mesh = model->Meshes()[0U];
 	ExecuteCommandList(*mCmdQueue, *mCmdListBegin, *mFence);
-
-	// Initialize recorder's PSO
-	AmbientLightCmdListRecorder::InitPSO();
-	AmbientOcclusionCmdListRecorder::InitPSO();
+	ModelManager::Get().UploadFlushed(modelId);
 
 	// Create ambient accessibility buffer
 	CreateAmbientAccessibilityBuffer(mAmbientAccessibilityBuffer, mAmbientAccessibilityBufferRTCpuDescHandle);
@@ -170,6 +174,8 @@ void AmbientLightPass::Init(
 }
 
 void AmbientLightPass::Execute(const FrameCBuffer& frameCBuffer) noexcept {
+	PROFILE_ZONE("AmbientLightPass::Execute");
+
 	ASSERT(ValidateData());
 
 	const std::uint32_t taskCount{ 4U };
@@ -181,9 +187,7 @@ void AmbientLightPass::Execute(const FrameCBuffer& frameCBuffer) noexcept {
 	mAmbientLightRecorder->RecordAndPushCommandLists();
 
 	// Wait until all previous tasks command lists are executed
-	while (mCmdListExecutor->ExecutedCmdListCount() < taskCount) {
-		Sleep(0U);
-	}
+	mCmdListExecutor->WaitForExecutedCmdLists(taskCount);
 }
 
 bool AmbientLightPass::ValidateData() const noexcept {
@@ -231,6 +235,7 @@ void AmbientLightPass::ExecuteBeginTask() noexcept {
 	};
 	const std::uint32_t barriersCount = _countof(barriers);
 	ASSERT(barriersCount == 1UL);
+	RENDER_STATS_ADD(RESOURCE_BARRIERS, barriersCount);
 	mCmdListBegin->ResourceBarrier(barriersCount, barriers);
 
 	// Clear render targets
@@ -260,6 +265,7 @@ void AmbientLightPass::ExecuteEndingTask() noexcept {
 	};
 	const std::uint32_t barriersCount = _countof(endBarriers);
 	ASSERT(barriersCount == 1UL);
+	RENDER_STATS_ADD(RESOURCE_BARRIERS, barriersCount);
 	mCmdListEnd->ResourceBarrier(barriersCount, endBarriers);
 	CHECK_HR(mCmdListEnd->Close());
 
@@ -25,6 +25,9 @@ public:
 	AmbientLightPass(AmbientLightPass&&) = delete;
 	AmbientLightPass& operator=(AmbientLightPass&&) = delete;
 
+	// Creates ambient light and ambient occlusion pipeline states. It must be called before Init().
+	static void InitPSOs() noexcept;
+
 	// You should call this method before Execute()
 	void Init(
 		ID3D12Device& device,
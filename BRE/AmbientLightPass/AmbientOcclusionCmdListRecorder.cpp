@@ -10,6 +10,8 @@
 #include <ResourceManager/ResourceManager.h>
 #include <ShaderUtils\CBuffers.h>
 #include <Utils/DebugUtils.h>
+#include <Utils/Profiler.h>
+#include <Utils/RenderStats.h>
 
 // Root Signature:
 // "CBV(b0, visibility = SHADER_VISIBILITY_VERTEX), " \ 0 -> Frame CBuffer
@@ -158,6 +160,8 @@ void AmbientOcclusionCmdListRecorder::Init(
 }
 
 void AmbientOcclusionCmdListRecorder::RecordAndPushCommandLists(const FrameCBuffer& frameCBuffer) noexcept {
+	PROFILE_ZONE("AmbientOcclusionCmdListRecorder::RecordAndPushCommandLists");
+
 	ASSERT(ValidateData());
 	ASSERT(sPSO != nullptr);
 	ASSERT(sRootSign != nullptr);
@@ -166,6 +170,7 @@ void AmbientOcclusionCmdListRecorder::RecordAndPushCommandLists(const FrameCBuff
 	ASSERT(cmdAlloc != nullptr);
 	
 	CHECK_HR(cmdAlloc->Reset());
+	RENDER_STATS_ADD(PIPELINE_STATE_CHANGES, 1UL);
 	CHECK_HR(mCmdList->Reset(cmdAlloc, sPSO));
 
 	// Update frame constants
@@ -178,6 +183,7 @@ void AmbientOcclusionCmdListRecorder::RecordAndPushCommandLists(const FrameCBuff
 
 	ID3D12DescriptorHeap* heaps[] = { &DescriptorManager::Get().GetCbvSrcUavDescriptorHeap() };
 	mCmdList->SetDescriptorHeaps(_countof(heaps), heaps);
+	RENDER_STATS_ADD(ROOT_SIGNATURE_CHANGES, 1UL);
 	mCmdList->SetGraphicsRootSignature(sRootSign);
 	
 	mCmdList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
@@ -186,12 +192,14 @@ void AmbientOcclusionCmdListRecorder::RecordAndPushCommandLists(const FrameCBuff
 	const D3D12_GPU_VIRTUAL_ADDRESS frameCBufferGpuVAddress(uploadFrameCBuffer.Resource()->GetGPUVirtualAddress());
 	mCmdList->SetGraphicsRootConstantBufferView(0U, frameCBufferGpuVAddress);
 	mCmdList->SetGraphicsRootConstantBufferView(1U, frameCBufferGpuVAddress);
+	RENDER_STATS_ADD(DESCRIPTOR_TABLES, 1UL);
 	mCmdList->SetGraphicsRootDescriptorTable(2U, mPixelShaderBuffersGpuDescHandle);
 
 	// Draw object
 	mCmdList->IASetVertexBuffers(0U, 1U, &mVertexBufferData.mBufferView);
 	mCmdList->IASetIndexBuffer(&mIndexBufferData.mBufferView);
-	mCmdList->DrawIndexedInstanced(mIndexBufferData.mCount, 1U, 0U, 0U, 0U);
+	RENDER_STATS_DRAW(mIndexBufferData.mCount, 1U);
+	mCmdList->DrawIndexedInstanced(mIndexBufferData.mCount, 1U, mIndexBufferData.mStartIndex, mVertexBufferData.mBaseVertex, 0U);
 
 	mCmdList->Close();
 
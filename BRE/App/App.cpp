@@ -2,13 +2,16 @@
 
 #include <CommandManager/CommandManager.h>
 #include <DescriptorManager/DescriptorManager.h>
+#include <DescriptorManager/TextureRegistry.h>
 #include <GlobalData\D3dData.h>
 #include <Input/Keyboard.h>
 #include <Input/Mouse.h>
 #include <MasterRender/MasterRender.h>
 #include <Material/Material.h>
+#include <Material/MaterialRegistry.h>
 #include <ModelManager\ModelManager.h>
 #include <PSOManager\PSOManager.h>
+#include <ResourceManager/GeometryPool.h>
 #include <ResourceManager\ResourceManager.h>
 #include <RootSignatureManager\RootSignatureManager.h>
 #include <ShaderManager\ShaderManager.h>
@@ -27,32 +30,40 @@ namespace {
 		ID3D12Device& device{ D3dData::Device() };
 		CommandManager::Create(device);
 		DescriptorManager::Create(device);
+		TextureRegistry::Create(device);
 		ModelManager::Create();
 		Materials::InitMaterials();
+		MaterialRegistry::Create();
 		PSOManager::Create(device);
 		ResourceManager::Create(device);
+		GeometryPool::Create(device);
 		RootSignatureManager::Create(device);
 		ShaderManager::Create();
 
 		//ShowCursor(false);
 	}
 
-	void InitMasterRenderTask(const HWND hwnd, ID3D12Device& device, Scene* scene, MasterRender* &masterRender) noexcept {
+	void InitMasterRenderTask(
+		const HWND hwnd, 
+		ID3D12Device& device, 
+		Scene* scene, 
+		const MasterRender::RunMode& runMode, 
+		MasterRender* &masterRender) noexcept {
 		ASSERT(scene != nullptr);
 		ASSERT(masterRender == nullptr);
-		masterRender = MasterRender::Create(hwnd, device, scene);
+		masterRender = MasterRender::Create(hwnd, device, scene, runMode);
 	}
 
-	void Update() noexcept {
+	void Update(const MasterRender& masterRender) noexcept {
 		Keyboard::Get().Update();
 		Mouse::Get().Update();
-		if (Keyboard::Get().IsKeyDown(DIK_ESCAPE)) {
+		if (Keyboard::Get().IsKeyDown(DIK_ESCAPE) || masterRender.IsBenchmarkFinished()) {
 			PostQuitMessage(0);
 		}
 	}
 
-	// Runs program until Escape key is pressed.
-	std::int32_t RunMessageLoop() noexcept {
+	// Runs program until Escape key is pressed or benchmark finished.
+	std::int32_t RunMessageLoop(const MasterRender& masterRender) noexcept {
 		// Message loop
 		MSG msg{ nullptr };
 		while (msg.message != WM_QUIT) {
@@ -61,7 +72,7 @@ namespace {
 				DispatchMessage(&msg);
 			}
 			else {
-				Update();
+				Update(masterRender);
 			}
 		}
 
@@ -71,15 +82,15 @@ namespace {
 
 using namespace DirectX;
 
-App::App(HINSTANCE hInstance, Scene* scene)
+App::App(HINSTANCE hInstance, Scene* scene, const MasterRender::RunMode& runMode)
 	: mTaskSchedulerInit()
 {	
 	ASSERT(scene != nullptr);
 	D3dData::InitDirect3D(hInstance);
 	InitSystems(D3dData::Hwnd(), hInstance);
-	InitMasterRenderTask(D3dData::Hwnd(), D3dData::Device(), scene, mMasterRender);
+	InitMasterRenderTask(D3dData::Hwnd(), D3dData::Device(), scene, runMode, mMasterRender);
 
-	RunMessageLoop();
+	RunMessageLoop(*mMasterRender);
 }
 
 App::~App() {
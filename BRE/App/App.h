@@ -3,19 +3,21 @@
 #include <tbb/task_scheduler_init.h>
 #include <windows.h>
 
+#include <MasterRender/MasterRender.h>
+
 #if defined(DEBUG) || defined(_DEBUG)                                                                                                                                                            
 #define _CRTDBG_MAP_ALLOC          
 #include <cstdlib>             
 #include <crtdbg.h>               
 #endif 
 
-class MasterRender;
 class Scene;
 
 // Its responsibility is to initialize Direct3D systems, mouse, keyboard, camera, MasterRender, etc
+// It runs until Escape key is pressed or, in benchmark mode, until the benchmark finished.
 class App {
 public:
-	explicit App(HINSTANCE hInstance, Scene* scene);
+	explicit App(HINSTANCE hInstance, Scene* scene, const MasterRender::RunMode& runMode = MasterRender::RunMode());
 	~App();
 	App(const App&) = delete;
 	const App& operator=(const App&) = delete;
@@ -0,0 +1,34 @@
+#include <cstring>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+// Same as BENCHMARK_MAIN(), but results are also written as JSON to
+// BenchmarkResults.json (in the working directory) when --benchmark_out
+// is not specified, so they can be compared across runs to track regressions.
+int main(int argc, char** argv) {
+	std::vector<char*> arguments(argv, argv + argc);
+
+	bool hasOutputFile{ false };
+	for (int i = 1; i < argc; ++i) {
+		hasOutputFile |= strncmp(argv[i], "--benchmark_out=", strlen("--benchmark_out=")) == 0;
+	}
+
+	char outputFileArgument[] = "--benchmark_out=BenchmarkResults.json";
+	char outputFormatArgument[] = "--benchmark_out_format=json";
+	if (hasOutputFile == false) {
+		arguments.push_back(outputFileArgument);
+		arguments.push_back(outputFormatArgument);
+	}
+
+	int argumentCount{ static_cast<int>(arguments.size()) };
+	benchmark::Initialize(&argumentCount, arguments.data());
+	if (benchmark::ReportUnrecognizedArguments(argumentCount, arguments.data())) {
+		return 1;
+	}
+
+	benchmark::RunSpecifiedBenchmarks();
+	benchmark::Shutdown();
+
+	return 0;
+}
@@ -0,0 +1,148 @@
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <MathUtils/Bvh.h>
+#include <MathUtils/FrustumCuller.h>
+#include <Tests/TestUtils.h>
+
+namespace {
+	// Instances spread in a 1000 units cube
+	std::vector<Aabb> SceneBoxes(const std::uint32_t count) {
+		std::mt19937 generator{ 42U };
+		std::vector<Aabb> boxes(count);
+		for (Aabb& box : boxes) {
+			for (std::uint32_t j = 0U; j < 3U; ++j) {
+				box.mMin[j] = TestUtils::RandF(generator, -500.0f, 500.0f);
+				box.mMax[j] = box.mMin[j] + TestUtils::RandF(generator, 1.0f, 10.0f);
+			}
+		}
+
+		return boxes;
+	}
+
+	// Camera at the scene center
+	void ScenePlanes(float (&planes)[6U][4U]) {
+		const float eye[3U]{ 0.0f, 0.0f, 0.0f };
+		const float target[3U]{ 0.0f, 0.0f, 1.0f };
+		float viewProj[16U];
+		TestUtils::LookAtPerspective(eye, target, 3.14159265f * 0.25f, 16.0f / 9.0f, 0.1f, 1000.0f, viewProj);
+		FrustumCuller culler;
+		culler.SetViewProjection(viewProj);
+		for (std::uint32_t i = 0U; i < 6U; ++i) {
+			for (std::uint32_t j = 0U; j < 4U; ++j) {
+				planes[i][j] = culler.Planes()[i][j];
+			}
+		}
+	}
+
+	void BM_BvhBuild(benchmark::State& state) {
+		const std::vector<Aabb> boxes{ SceneBoxes(static_cast<std::uint32_t>(state.range(0))) };
+		Bvh bvh;
+		for (auto _ : state) {
+			bvh.Build(boxes.data(), static_cast<std::uint32_t>(boxes.size()));
+		}
+
+		state.SetItemsProcessed(state.iterations() * boxes.size());
+	}
+	BENCHMARK(BM_BvhBuild)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+	// Full refit after all primitives moved, to compare against BM_BvhBuild
+	void BM_BvhRefit(benchmark::State& state) {
+		std::vector<Aabb> boxes{ SceneBoxes(static_cast<std::uint32_t>(state.range(0))) };
+		Bvh bvh;
+		bvh.Build(boxes.data(), static_cast<std::uint32_t>(boxes.size()));
+		for (Aabb& box : boxes) {
+			box.mMin[1U] += 1.0f;
+			box.mMax[1U] += 1.0f;
+		}
+
+		for (auto _ : state) {
+			bvh.Refit(boxes.data());
+		}
+
+		state.SetItemsProcessed(state.iterations() * boxes.size());
+	}
+	BENCHMARK(BM_BvhRefit)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+	// Incremental refit of 1% of primitives
+	void BM_BvhRefitIncremental(benchmark::State& state) {
+		std::vector<Aabb> boxes{ SceneBoxes(static_cast<std::uint32_t>(state.range(0))) };
+		Bvh bvh;
+		bvh.Build(boxes.data(), static_cast<std::uint32_t>(boxes.size()));
+
+		std::vector<std::uint32_t> moved;
+		std::vector<Aabb> movedBoxes;
+		for (std::uint32_t i = 0U; i < boxes.size(); i += 100U) {
+			moved.push_back(i);
+			Aabb box{ boxes[i] };
+			box.mMin[1U] += 1.0f;
+			box.mMax[1U] += 1.0f;
+			movedBoxes.push_back(box);
+		}
+
+		for (auto _ : state) {
+			bvh.Refit(moved.data(), movedBoxes.data(), static_cast<std::uint32_t>(moved.size()));
+		}
+
+		state.SetItemsProcessed(state.iterations() * moved.size());
+	}
+	BENCHMARK(BM_BvhRefitIncremental)->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+	void BM_BvhFrustumQuery(benchmark::State& state) {
+		const std::vector<Aabb> boxes{ SceneBoxes(static_cast<std::uint32_t>(state.range(0))) };
+		Bvh bvh;
+		bvh.Build(boxes.data(), static_cast<std::uint32_t>(boxes.size()));
+		float planes[6U][4U];
+		ScenePlanes(planes);
+
+		std::vector<std::uint32_t> result;
+		for (auto _ : state) {
+			bvh.FrustumQuery(planes, result);
+			benchmark::DoNotOptimize(result.data());
+		}
+
+		state.SetItemsProcessed(state.iterations() * boxes.size());
+		state.counters["Visible"] = static_cast<double>(result.size());
+	}
+	BENCHMARK(BM_BvhFrustumQuery)->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+	// Light sized spheres
+	void BM_BvhSphereQuery(benchmark::State& state) {
+		const std::vector<Aabb> boxes{ SceneBoxes(static_cast<std::uint32_t>(state.range(0))) };
+		Bvh bvh;
+		bvh.Build(boxes.data(), static_cast<std::uint32_t>(boxes.size()));
+
+		std::mt19937 generator{ 7U };
+		std::vector<std::uint32_t> result;
+		for (auto _ : state) {
+			const float center[3U]{ TestUtils::RandF(generator, -500.0f, 500.0f), TestUtils::RandF(generator, -500.0f, 500.0f), TestUtils::RandF(generator, -500.0f, 500.0f) };
+			bvh.SphereQuery(center, 50.0f, result);
+			benchmark::DoNotOptimize(result.data());
+		}
+
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(BM_BvhSphereQuery)->Arg(10000)->Arg(100000);
+
+	// Segments that cross the whole scene
+	void BM_BvhRayQuery(benchmark::State& state) {
+		const std::vector<Aabb> boxes{ SceneBoxes(static_cast<std::uint32_t>(state.range(0))) };
+		Bvh bvh;
+		bvh.Build(boxes.data(), static_cast<std::uint32_t>(boxes.size()));
+
+		std::mt19937 generator{ 7U };
+		std::vector<std::uint32_t> result;
+		for (auto _ : state) {
+			const float origin[3U]{ -500.0f, TestUtils::RandF(generator, -500.0f, 500.0f), TestUtils::RandF(generator, -500.0f, 500.0f) };
+			const float direction[3U]{ 1.0f, TestUtils::RandF(generator, -0.5f, 0.5f), TestUtils::RandF(generator, -0.5f, 0.5f) };
+			bvh.RayQuery(origin, direction, 1000.0f, result);
+			benchmark::DoNotOptimize(result.data());
+		}
+
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(BM_BvhRayQuery)->Arg(10000)->Arg(100000);
+}
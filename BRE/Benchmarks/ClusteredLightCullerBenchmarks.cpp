@@ -0,0 +1,42 @@
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <MathUtils/ClusteredLightCuller.h>
+#include <Tests/TestUtils.h>
+
+namespace {
+	// Lights spread in the view frustum (60 degrees vertical field of view, 16:9), with
+	// radius 1 to 10 as ClusteredPunctualLightCmdListRecorder scenes.
+	void BM_ClusteredLightCullerBuild(benchmark::State& state) {
+		const std::uint32_t count{ static_cast<std::uint32_t>(state.range(0)) };
+		const float proj11{ 1.0f / std::tan(3.14159265f / 6.0f) };
+		const float proj00{ proj11 * 9.0f / 16.0f };
+
+		std::mt19937 generator{ 42U };
+		std::vector<float> spheres;
+		spheres.reserve(count * 4UL);
+		for (std::uint32_t i = 0U; i < count; ++i) {
+			const float z{ TestUtils::RandF(generator, 1.0f, 300.0f) };
+			spheres.push_back(TestUtils::RandF(generator, -z, z) / proj00);
+			spheres.push_back(TestUtils::RandF(generator, -z, z) / proj11);
+			spheres.push_back(z);
+			spheres.push_back(TestUtils::RandF(generator, 1.0f, 10.0f));
+		}
+
+		ClusteredLightCuller culler;
+		culler.SetProjection(1.0f, 500.0f, proj00, proj11);
+		for (auto _ : state) {
+			culler.Build(spheres.data(), count, sizeof(float) * 4UL);
+			benchmark::DoNotOptimize(culler.LightIndices().data());
+		}
+
+		state.SetItemsProcessed(state.iterations() * count);
+		state.counters["LightIndices"] = static_cast<double>(culler.LightIndices().size());
+		state.counters["MaxClusterLights"] = static_cast<double>(culler.MaxClusterLightCount());
+	}
+	BENCHMARK(BM_ClusteredLightCullerBuild)->Arg(1000)->Arg(10000)->Unit(benchmark::kMicrosecond)->UseRealTime();
+}
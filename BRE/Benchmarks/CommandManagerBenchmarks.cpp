@@ -0,0 +1,117 @@
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <tbb/parallel_for.h>
+
+#include <CommandListExecutor/CommandListExecutor.h>
+#include <CommandManager/NullCommandList.h>
+#include <CommandManager/NullCommandQueue.h>
+#include <CommandManager/QueuedFrameFences.h>
+
+namespace {
+	// As the geometry pass, draws are recorded in at most sMaxCmdListCount command lists,
+	// and each command list records at least sMinDrawsPerCmdList draws.
+	const std::uint32_t sMaxCmdListCount{ 8U };
+	const std::uint32_t sMinDrawsPerCmdList{ 64U };
+	const std::uint32_t sQueuedFrameCount{ 3U };
+
+	// Draws that share a pipeline and geometry buffers (as sorted draw packets do)
+	const std::uint32_t sDrawsPerPipeline{ 128U };
+	const std::uint32_t sDrawsPerGeometry{ 8U };
+
+	std::uint64_t sObjects[2U];
+	ID3D12PipelineState* const sPipelineState{ reinterpret_cast<ID3D12PipelineState*>(&sObjects[0U]) };
+	ID3D12RootSignature* const sRootSignature{ reinterpret_cast<ID3D12RootSignature*>(&sObjects[1U]) };
+
+	void RecordDraws(GraphicsCommandList& cmdList, const std::uint32_t firstDraw, const std::uint32_t lastDraw) {
+		GraphicsCommandList::Viewport viewport;
+		viewport.mWidth = 1920.0f;
+		viewport.mHeight = 1080.0f;
+		viewport.mMaxDepth = 1.0f;
+		GraphicsCommandList::Rect rect;
+		rect.mRight = 1920;
+		rect.mBottom = 1080;
+		GraphicsCommandList::CpuDescriptorHandle renderTargets[2U];
+		renderTargets[0U].mPtr = 0x100UL;
+		renderTargets[1U].mPtr = 0x200UL;
+		GraphicsCommandList::CpuDescriptorHandle depthStencil;
+		depthStencil.mPtr = 0x300UL;
+		cmdList.RSSetViewports(1U, &viewport);
+		cmdList.RSSetScissorRects(1U, &rect);
+		cmdList.OMSetRenderTargets(2U, renderTargets, false, &depthStencil);
+
+		for (std::uint32_t i = firstDraw; i < lastDraw; ++i) {
+			if (i == firstDraw || i % sDrawsPerPipeline == 0U) {
+				cmdList.SetPipelineState(sPipelineState);
+				cmdList.SetGraphicsRootSignature(sRootSignature);
+				cmdList.IASetPrimitiveTopology(GraphicsCommandList::sPrimitiveTopologyTriangleList);
+				cmdList.SetGraphicsRootConstantBufferView(1U, 0x1000UL);
+				cmdList.SetGraphicsRootShaderResourceView(0U, 0x2000UL);
+			}
+
+			if (i == firstDraw || i % sDrawsPerGeometry == 0U) {
+				const std::uint64_t geometryIndex{ i / sDrawsPerGeometry };
+				GraphicsCommandList::VertexBufferView vertexBufferView;
+				vertexBufferView.mBufferLocation = 0x100000UL + geometryIndex * 0x10000UL;
+				vertexBufferView.mSizeInBytes = 0x10000U;
+				vertexBufferView.mStrideInBytes = 48U;
+				cmdList.IASetVertexBuffers(0U, 1U, &vertexBufferView);
+				GraphicsCommandList::IndexBufferView indexBufferView;
+				indexBufferView.mBufferLocation = 0x80000000UL + geometryIndex * 0x8000UL;
+				indexBufferView.mSizeInBytes = 0x8000U;
+				indexBufferView.mFormat = GraphicsCommandList::sIndexFormatR32;
+				cmdList.IASetIndexBuffer(&indexBufferView);
+			}
+
+			cmdList.SetGraphicsRoot32BitConstant(5U, i, 0U);
+			cmdList.DrawIndexedInstanced(36U, 4U, 0U, 0, 0U);
+		}
+	}
+
+	// Headless frame loop: draws are recorded in parallel into null command lists,
+	// submitted through the command list executor into a null command queue, and
+	// frames are synchronized with queued frame fences (as MasterRender does).
+	// It measures recording, submission and synchronization overhead without the GPU.
+	// state.range(0) is the draw count per frame.
+	void BM_HeadlessFrameLoop(benchmark::State& state) {
+		const std::uint32_t drawCount{ static_cast<std::uint32_t>(state.range(0)) };
+		const std::uint32_t cmdListCount{ 
+			std::min(sMaxCmdListCount, std::max(std::min(drawCount, 1U), drawCount / sMinDrawsPerCmdList)) };
+
+		std::vector<NullCommandList> cmdLists(cmdListCount);
+		NullCommandQueue cmdQueue;
+		QueuedFrameFences fences(cmdQueue, sQueuedFrameCount);
+		CommandListExecutor* executor{ CommandListExecutor::Create(cmdQueue, cmdListCount) };
+
+		std::uint32_t invalidCommandCount{ 0U };
+		for (auto _ : state) {
+			executor->ResetExecutedCmdListCount();
+			tbb::parallel_for(0U, cmdListCount, [&](const std::uint32_t i) {
+				NullCommandList& cmdList(cmdLists[i]);
+				cmdList.Clear();
+				RecordDraws(cmdList, (drawCount * i) / cmdListCount, (drawCount * (i + 1U)) / cmdListCount);
+				executor->CmdListQueue().push(cmdList.Handle());
+			});
+			executor->WaitForExecutedCmdLists(cmdListCount);
+			fences.EndFrame();
+
+			for (const NullCommandList& cmdList : cmdLists) {
+				invalidCommandCount += cmdList.InvalidCommandCount();
+			}
+		}
+
+		executor->Terminate();
+		delete executor;
+		fences.Flush();
+
+		if (invalidCommandCount > 0U || cmdQueue.InvalidCallCount() > 0U) {
+			state.SkipWithError("Invalid commands or queue calls");
+		}
+
+		state.SetItemsProcessed(state.iterations() * drawCount);
+		state.counters["cmd lists"] = static_cast<double>(cmdListCount);
+	}
+	BENCHMARK(BM_HeadlessFrameLoop)->Arg(1000)->Arg(10000)->Arg(50000)->Unit(benchmark::kMicrosecond)->UseRealTime();
+}
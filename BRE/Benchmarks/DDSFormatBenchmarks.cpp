@@ -0,0 +1,141 @@
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <ResourceManager/DDSFormat.h>
+
+namespace {
+	const char* sTextureFiles[] = {
+		"textures/black.dds",
+		"textures/floor.dds",
+		"textures/floor_height.dds",
+		"textures/floor_normal.dds",
+		"textures/white.dds",
+		"textures/brick/brick3.dds",
+		"textures/brick/brick3_height.dds",
+		"textures/brick/bricks.dds",
+		"textures/brick/bricks_height.dds",
+		"textures/brick/bricks_normal.dds",
+		"textures/concrete/asphalt.dds",
+		"textures/concrete/asphalt_height.dds",
+		"textures/concrete/asphalt_normal.dds",
+	};
+
+	std::vector<std::uint8_t> ReadFile(const std::string& path) {
+		std::ifstream file(path, std::ios::binary);
+		return std::vector<std::uint8_t>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+	}
+
+	// Legacy pixel formats of the bundled textures and the most common ones written by texture tools
+	std::vector<DDS_PIXELFORMAT> PixelFormats() {
+		std::vector<DDS_PIXELFORMAT> pixelFormats;
+		const std::uint32_t fourCCs[] = {
+			MAKEFOURCC('D', 'X', 'T', '1'),
+			MAKEFOURCC('D', 'X', 'T', '3'),
+			MAKEFOURCC('D', 'X', 'T', '5'),
+			MAKEFOURCC('A', 'T', 'I', '1'),
+			MAKEFOURCC('A', 'T', 'I', '2'),
+			MAKEFOURCC('B', 'C', '5', 'U'),
+			113U, // D3DFMT_A16B16G16R16F
+			116U, // D3DFMT_A32B32G32R32F
+		};
+		for (const std::uint32_t fourCC : fourCCs) {
+			pixelFormats.push_back(DDS_PIXELFORMAT{ sizeof(DDS_PIXELFORMAT), DDS_FOURCC, fourCC, 0U, 0U, 0U, 0U, 0U });
+		}
+		pixelFormats.push_back(DDS_PIXELFORMAT{ sizeof(DDS_PIXELFORMAT), DDS_RGB, 0U, 32U, 0x000000FFU, 0x0000FF00U, 0x00FF0000U, 0xFF000000U });
+		pixelFormats.push_back(DDS_PIXELFORMAT{ sizeof(DDS_PIXELFORMAT), DDS_RGB, 0U, 32U, 0x00FF0000U, 0x0000FF00U, 0x000000FFU, 0xFF000000U });
+		pixelFormats.push_back(DDS_PIXELFORMAT{ sizeof(DDS_PIXELFORMAT), DDS_RGB, 0U, 16U, 0xF800U, 0x07E0U, 0x001FU, 0U });
+		pixelFormats.push_back(DDS_PIXELFORMAT{ sizeof(DDS_PIXELFORMAT), DDS_LUMINANCE, 0U, 8U, 0xFFU, 0U, 0U, 0U });
+
+		return pixelFormats;
+	}
+
+	void BM_GetDXGIFormat(benchmark::State& state) {
+		const std::vector<DDS_PIXELFORMAT> pixelFormats{ PixelFormats() };
+		for (auto _ : state) {
+			for (const DDS_PIXELFORMAT& pixelFormat : pixelFormats) {
+				benchmark::DoNotOptimize(DirectX::GetDXGIFormat(pixelFormat));
+			}
+		}
+
+		state.SetItemsProcessed(state.iterations() * pixelFormats.size());
+	}
+	BENCHMARK(BM_GetDXGIFormat);
+
+	// Full mip chain of a state.range(0) x state.range(0) texture in every DXGI format
+	void BM_GetSurfaceInfo(benchmark::State& state) {
+		const std::size_t size{ static_cast<std::size_t>(state.range(0)) };
+		std::size_t surfaceCount{ 0UL };
+		for (auto _ : state) {
+			std::size_t totalBytes{ 0UL };
+			surfaceCount = 0UL;
+			for (std::uint32_t format = DXGI_FORMAT_R32G32B32A32_TYPELESS; format <= DXGI_FORMAT_B4G4R4A4_UNORM; ++format) {
+				for (std::size_t mipSize = size; mipSize > 0UL; mipSize >>= 1UL, ++surfaceCount) {
+					std::size_t numBytes;
+					std::size_t rowBytes;
+					std::size_t numRows;
+					DirectX::GetSurfaceInfo(mipSize, mipSize, static_cast<DXGI_FORMAT>(format), &numBytes, &rowBytes, &numRows);
+					totalBytes += numBytes;
+				}
+			}
+			benchmark::DoNotOptimize(totalBytes);
+		}
+
+		state.SetItemsProcessed(state.iterations() * surfaceCount);
+	}
+	BENCHMARK(BM_GetSurfaceInfo)->Arg(256)->Arg(4096);
+
+	// Header parsing of the bundled textures, as DDSTextureLoader does before creating resources:
+	// validate the header, get the format and the size of each mip level.
+	void BM_DDSHeaderParsing(benchmark::State& state) {
+		std::vector<std::vector<std::uint8_t>> files;
+		for (const char* textureFile : sTextureFiles) {
+			files.push_back(ReadFile(std::string(BRE_RESOURCES_PATH) + textureFile));
+			if (files.back().size() < sizeof(std::uint32_t) + sizeof(DDS_HEADER)) {
+				state.SkipWithError((std::string("Texture not found: ") + textureFile).c_str());
+				return;
+			}
+		}
+
+		for (auto _ : state) {
+			std::size_t totalBytes{ 0UL };
+			for (const std::vector<std::uint8_t>& file : files) {
+				std::uint32_t magic;
+				memcpy(&magic, file.data(), sizeof(magic));
+				const DDS_HEADER* header{ reinterpret_cast<const DDS_HEADER*>(file.data() + sizeof(std::uint32_t)) };
+				if (magic != DDS_MAGIC || header->size != sizeof(DDS_HEADER) || header->ddspf.size != sizeof(DDS_PIXELFORMAT)) {
+					continue;
+				}
+
+				DXGI_FORMAT format{ DXGI_FORMAT_UNKNOWN };
+				if ((header->ddspf.flags & DDS_FOURCC) && MAKEFOURCC('D', 'X', '1', '0') == header->ddspf.fourCC) {
+					const DDS_HEADER_DXT10* dx10Header{ reinterpret_cast<const DDS_HEADER_DXT10*>(header + 1) };
+					format = dx10Header->dxgiFormat;
+				}
+				else {
+					format = DirectX::GetDXGIFormat(header->ddspf);
+				}
+
+				std::size_t width{ header->width };
+				std::size_t height{ header->height };
+				const std::uint32_t mipCount{ header->mipMapCount == 0U ? 1U : header->mipMapCount };
+				for (std::uint32_t i = 0U; i < mipCount; ++i) {
+					std::size_t numBytes;
+					DirectX::GetSurfaceInfo(width, height, format, &numBytes, nullptr, nullptr);
+					totalBytes += numBytes;
+					width = width > 1UL ? width >> 1UL : 1UL;
+					height = height > 1UL ? height >> 1UL : 1UL;
+				}
+			}
+			benchmark::DoNotOptimize(totalBytes);
+		}
+
+		state.SetItemsProcessed(state.iterations() * files.size());
+	}
+	BENCHMARK(BM_DDSHeaderParsing);
+}
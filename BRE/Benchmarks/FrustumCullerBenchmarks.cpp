@@ -0,0 +1,39 @@
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <MathUtils/FrustumCuller.h>
+#include <Tests/TestUtils.h>
+
+namespace {
+	// Instances spread in a 1000 units cube, seen by a camera at its center,
+	// so around 1/8 of them are visible.
+	void BM_FrustumCullerCull(benchmark::State& state) {
+		const std::uint32_t count{ static_cast<std::uint32_t>(state.range(0)) };
+		std::mt19937 generator{ 42U };
+
+		FrustumCuller culler;
+		culler.ResizeSpheres(count);
+		for (std::uint32_t i = 0U; i < count; ++i) {
+			const float center[3U]{ TestUtils::RandF(generator, -500.0f, 500.0f), TestUtils::RandF(generator, -500.0f, 500.0f), TestUtils::RandF(generator, -500.0f, 500.0f) };
+			culler.SetSphere(i, center, TestUtils::RandF(generator, 0.5f, 5.0f));
+		}
+
+		const float eye[3U]{ 0.0f, 0.0f, 0.0f };
+		const float target[3U]{ 0.0f, 0.0f, 1.0f };
+		float viewProj[16U];
+		TestUtils::LookAtPerspective(eye, target, 3.14159265f * 0.25f, 16.0f / 9.0f, 0.1f, 1000.0f, viewProj);
+		culler.SetViewProjection(viewProj);
+
+		std::vector<std::uint32_t> visibleIndices;
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(culler.Cull(visibleIndices));
+		}
+
+		state.SetItemsProcessed(state.iterations() * count);
+		state.counters["Visible"] = static_cast<double>(culler.VisibleCount());
+	}
+	BENCHMARK(BM_FrustumCullerCull)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMicrosecond);
+}
@@ -0,0 +1,128 @@
+#include <cstdint>
+
+#include <benchmark/benchmark.h>
+
+#include <GeometryGenerator/GeometryGenerator.h>
+#include <GeometryGenerator/TangentGenerator.h>
+
+using namespace DirectX;
+
+namespace {
+	// Reports generated vertices and triangles per second
+	void SetMeshCounters(benchmark::State& state, const GeometryGenerator::MeshData& meshData) {
+		state.counters["Vertices"] = benchmark::Counter(static_cast<double>(meshData.mVertices.size()));
+		state.counters["Triangles"] = benchmark::Counter(static_cast<double>(meshData.mIndices32.size() / 3UL));
+		state.SetItemsProcessed(state.iterations() * (meshData.mIndices32.size() / 3UL));
+	}
+
+	void BM_CreateBox(benchmark::State& state) {
+		GeometryGenerator::MeshData meshData;
+		for (auto _ : state) {
+			meshData = GeometryGenerator::MeshData{};
+			GeometryGenerator::CreateBox(2.0f, 2.0f, 2.0f, static_cast<std::uint32_t>(state.range(0)), meshData);
+			benchmark::DoNotOptimize(meshData.mVertices.data());
+		}
+		SetMeshCounters(state, meshData);
+	}
+	BENCHMARK(BM_CreateBox)->DenseRange(0, 6, 2)->Unit(benchmark::kMicrosecond);
+
+	void BM_CreateSphere(benchmark::State& state) {
+		const std::uint32_t sliceCount{ static_cast<std::uint32_t>(state.range(0)) };
+		GeometryGenerator::MeshData meshData;
+		for (auto _ : state) {
+			meshData = GeometryGenerator::MeshData{};
+			GeometryGenerator::CreateSphere(1.0f, sliceCount, sliceCount, meshData);
+			benchmark::DoNotOptimize(meshData.mVertices.data());
+		}
+		SetMeshCounters(state, meshData);
+	}
+	BENCHMARK(BM_CreateSphere)->Arg(16)->Arg(128)->Arg(1024)->Unit(benchmark::kMicrosecond);
+
+	void BM_CreateGeosphere(benchmark::State& state) {
+		GeometryGenerator::MeshData meshData;
+		for (auto _ : state) {
+			meshData = GeometryGenerator::MeshData{};
+			GeometryGenerator::CreateGeosphere(1.0f, static_cast<std::uint32_t>(state.range(0)), meshData);
+			benchmark::DoNotOptimize(meshData.mVertices.data());
+		}
+		SetMeshCounters(state, meshData);
+	}
+	BENCHMARK(BM_CreateGeosphere)->DenseRange(0, 6, 2)->Unit(benchmark::kMicrosecond);
+
+	void BM_CreateCylinder(benchmark::State& state) {
+		const std::uint32_t sliceCount{ static_cast<std::uint32_t>(state.range(0)) };
+		GeometryGenerator::MeshData meshData;
+		for (auto _ : state) {
+			meshData = GeometryGenerator::MeshData{};
+			GeometryGenerator::CreateCylinder(1.0f, 0.5f, 2.0f, sliceCount, sliceCount, meshData);
+			benchmark::DoNotOptimize(meshData.mVertices.data());
+		}
+		SetMeshCounters(state, meshData);
+	}
+	BENCHMARK(BM_CreateCylinder)->Arg(16)->Arg(128)->Arg(1024)->Unit(benchmark::kMicrosecond);
+
+	void BM_CreateGrid(benchmark::State& state) {
+		const std::uint32_t rowCount{ static_cast<std::uint32_t>(state.range(0)) };
+		GeometryGenerator::MeshData meshData;
+		for (auto _ : state) {
+			meshData = GeometryGenerator::MeshData{};
+			GeometryGenerator::CreateGrid(100.0f, 100.0f, rowCount, rowCount, meshData);
+			benchmark::DoNotOptimize(meshData.mVertices.data());
+		}
+		SetMeshCounters(state, meshData);
+	}
+	BENCHMARK(BM_CreateGrid)->Arg(16)->Arg(128)->Arg(1024)->Unit(benchmark::kMicrosecond);
+
+	void BM_CreateQuad(benchmark::State& state) {
+		GeometryGenerator::MeshData meshData;
+		for (auto _ : state) {
+			meshData = GeometryGenerator::MeshData{};
+			GeometryGenerator::CreateQuad(0.0f, 0.0f, 1.0f, 1.0f, 0.0f, meshData);
+			benchmark::DoNotOptimize(meshData.mVertices.data());
+		}
+		SetMeshCounters(state, meshData);
+	}
+	BENCHMARK(BM_CreateQuad);
+
+	void BM_CreateFullscreenQuad(benchmark::State& state) {
+		GeometryGenerator::MeshData meshData;
+		for (auto _ : state) {
+			meshData = GeometryGenerator::MeshData{};
+			GeometryGenerator::CreateFullscreenQuad(meshData);
+			benchmark::DoNotOptimize(meshData.mVertices.data());
+		}
+		SetMeshCounters(state, meshData);
+	}
+	BENCHMARK(BM_CreateFullscreenQuad);
+
+	// Tangent frames of meshes without tangents (see Mesh). state.range(0) is the
+	// number of grid rows and columns, 1449 is about 4 million triangles.
+	void BM_ComputeTangentFrames(benchmark::State& state) {
+		const std::uint32_t rowCount{ static_cast<std::uint32_t>(state.range(0)) };
+		GeometryGenerator::MeshData meshData;
+		GeometryGenerator::CreateGrid(100.0f, 100.0f, rowCount, rowCount, meshData);
+		for (auto _ : state) {
+			TangentGenerator::ComputeTangentFrames(meshData);
+			benchmark::ClobberMemory();
+		}
+		SetMeshCounters(state, meshData);
+	}
+	BENCHMARK(BM_ComputeTangentFrames)->Arg(64)->Arg(512)->Arg(1449)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+	// Tangent frames of meshes with imported tangents (see Mesh)
+	void BM_OrthonormalizeTangent(benchmark::State& state) {
+		GeometryGenerator::MeshData meshData;
+		GeometryGenerator::CreateSphere(1.0f, 256U, 256U, meshData);
+		for (auto _ : state) {
+			for (GeometryGenerator::Vertex& vertex : meshData.mVertices) {
+				const XMFLOAT3 tangent{ vertex.mTangentU.x, vertex.mTangentU.y, vertex.mTangentU.z };
+				const XMFLOAT3 bitangent{ vertex.mTangentU.y, vertex.mTangentU.z, vertex.mTangentU.x };
+				vertex.mTangentU = TangentGenerator::OrthonormalizeTangent(vertex.mNormal, tangent, bitangent);
+			}
+			benchmark::ClobberMemory();
+		}
+
+		state.SetItemsProcessed(state.iterations() * meshData.mVertices.size());
+	}
+	BENCHMARK(BM_OrthonormalizeTangent)->Unit(benchmark::kMicrosecond);
+}
@@ -0,0 +1,107 @@
+#include <cstdint>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <MathUtils/MathUtils.h>
+
+using namespace DirectX;
+
+namespace {
+	const std::size_t sMatrixCount{ 4096UL };
+
+	// World matrices of a scene, like the ones scenes compute with MathUtils::ComputeMatrix
+	std::vector<XMFLOAT4X4> WorldMatrices() {
+		std::vector<XMFLOAT4X4> matrices(sMatrixCount);
+		for (std::size_t i = 0UL; i < sMatrixCount; ++i) {
+			const float value{ static_cast<float>(i) };
+			MathUtils::ComputeMatrix(matrices[i], value, -value, value * 0.5f, 1.0f + value * 0.001f, 2.0f, 1.0f, value * 0.01f, value * 0.02f, value * 0.03f);
+		}
+
+		return matrices;
+	}
+
+	void BM_ComputeMatrix(benchmark::State& state) {
+		std::vector<XMFLOAT4X4> matrices(sMatrixCount);
+		for (auto _ : state) {
+			for (std::size_t i = 0UL; i < sMatrixCount; ++i) {
+				const float value{ static_cast<float>(i) };
+				MathUtils::ComputeMatrix(matrices[i], value, -value, value, 2.0f, 2.0f, 2.0f, value, value, value);
+			}
+			benchmark::ClobberMemory();
+		}
+
+		state.SetItemsProcessed(state.iterations() * sMatrixCount);
+	}
+	BENCHMARK(BM_ComputeMatrix);
+
+	void BM_GetTranspose(benchmark::State& state) {
+		const std::vector<XMFLOAT4X4> matrices{ WorldMatrices() };
+		std::vector<XMFLOAT4X4> transposes(sMatrixCount);
+		for (auto _ : state) {
+			for (std::size_t i = 0UL; i < sMatrixCount; ++i) {
+				XMStoreFloat4x4(&transposes[i], MathUtils::GetTranspose(matrices[i]));
+			}
+			benchmark::ClobberMemory();
+		}
+
+		state.SetItemsProcessed(state.iterations() * sMatrixCount);
+	}
+	BENCHMARK(BM_GetTranspose);
+
+	void BM_GetTransposeViewProj(benchmark::State& state) {
+		const std::vector<XMFLOAT4X4> matrices{ WorldMatrices() };
+		std::vector<XMFLOAT4X4> transposes(sMatrixCount);
+		for (auto _ : state) {
+			for (std::size_t i = 0UL; i < sMatrixCount; ++i) {
+				XMStoreFloat4x4(&transposes[i], MathUtils::GetTransposeViewProj(matrices[i], matrices[sMatrixCount - 1UL - i]));
+			}
+			benchmark::ClobberMemory();
+		}
+
+		state.SetItemsProcessed(state.iterations() * sMatrixCount);
+	}
+	BENCHMARK(BM_GetTransposeViewProj);
+
+	void BM_InverseTranspose(benchmark::State& state) {
+		const std::vector<XMFLOAT4X4> matrices{ WorldMatrices() };
+		std::vector<XMFLOAT4X4> inverseTransposes(sMatrixCount);
+		for (auto _ : state) {
+			for (std::size_t i = 0UL; i < sMatrixCount; ++i) {
+				XMStoreFloat4x4(&inverseTransposes[i], MathUtils::InverseTranspose(XMLoadFloat4x4(&matrices[i])));
+			}
+			benchmark::ClobberMemory();
+		}
+
+		state.SetItemsProcessed(state.iterations() * sMatrixCount);
+	}
+	BENCHMARK(BM_InverseTranspose);
+
+	void BM_RandF(benchmark::State& state) {
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(MathUtils::RandF(-1.0f, 1.0f));
+		}
+
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(BM_RandF);
+
+	void BM_RandUnitVec3(benchmark::State& state) {
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(MathUtils::RandUnitVec3());
+		}
+
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(BM_RandUnitVec3);
+
+	void BM_RandHemisphereUnitVec3(benchmark::State& state) {
+		const XMVECTOR normal{ XMVector3Normalize(XMVectorSet(1.0f, 1.0f, 0.0f, 0.0f)) };
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(MathUtils::RandHemisphereUnitVec3(normal));
+		}
+
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(BM_RandHemisphereUnitVec3);
+}
@@ -0,0 +1,38 @@
+#include <cstdint>
+#include <string>
+
+#include <assimp/Importer.hpp>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+#include <benchmark/benchmark.h>
+
+namespace {
+	// Import of the bundled models with the same post processing steps as Model
+	void BM_ImportModel(benchmark::State& state, const char* filename) {
+		const std::string filePath{ std::string(BRE_RESOURCES_PATH) + filename };
+		const std::uint32_t flags{ aiProcessPreset_TargetRealtime_Fast | aiProcess_ConvertToLeftHanded };
+
+		std::size_t vertexCount{ 0UL };
+		std::size_t faceCount{ 0UL };
+		for (auto _ : state) {
+			Assimp::Importer importer;
+			const aiScene* scene{ importer.ReadFile(filePath.c_str(), flags) };
+			if (scene == nullptr || scene->HasMeshes() == false) {
+				state.SkipWithError(importer.GetErrorString());
+				break;
+			}
+
+			vertexCount = 0UL;
+			faceCount = 0UL;
+			for (std::uint32_t i = 0U; i < scene->mNumMeshes; ++i) {
+				vertexCount += scene->mMeshes[i]->mNumVertices;
+				faceCount += scene->mMeshes[i]->mNumFaces;
+			}
+		}
+
+		state.counters["Vertices"] = benchmark::Counter(static_cast<double>(vertexCount));
+		state.counters["Triangles"] = benchmark::Counter(static_cast<double>(faceCount));
+	}
+	BENCHMARK_CAPTURE(BM_ImportModel, unreal, "models/unreal.obj")->Unit(benchmark::kMillisecond);
+	BENCHMARK_CAPTURE(BM_ImportModel, torusKnot, "models/torusKnot.obj")->Unit(benchmark::kMillisecond);
+}
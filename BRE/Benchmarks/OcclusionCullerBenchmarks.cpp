@@ -0,0 +1,113 @@
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <OcclusionCulling/OcclusionCuller.h>
+#include <Tests/TestUtils.h>
+
+namespace {
+	// Same resolution as GeometryPass
+	const std::uint32_t sWidth{ 320U };
+	const std::uint32_t sHeight{ 192U };
+	const float sIdentity[16U]{
+		1.0f, 0.0f, 0.0f, 0.0f,
+		0.0f, 1.0f, 0.0f, 0.0f,
+		0.0f, 0.0f, 1.0f, 0.0f,
+		0.0f, 0.0f, 0.0f, 1.0f };
+
+	// Camera at the origin looking at +z
+	void SceneViewProj(float viewProj[16U]) {
+		const float eye[3U]{ 0.0f, 0.0f, 0.0f };
+		const float target[3U]{ 0.0f, 0.0f, 1.0f };
+		TestUtils::LookAtPerspective(eye, target, 3.14159265f / 3.0f, static_cast<float>(sWidth) / static_cast<float>(sHeight), 0.5f, 1000.0f, viewProj);
+	}
+
+	// Quads (facing the camera) that cover around half of the screen
+	OccluderMesh SceneOccluders(const std::uint32_t quadCount) {
+		std::mt19937 generator{ 42U };
+		OccluderMesh mesh;
+		for (std::uint32_t i = 0U; i < quadCount; ++i) {
+			const float x{ TestUtils::RandF(generator, -40.0f, 40.0f) };
+			const float y{ TestUtils::RandF(generator, -25.0f, 25.0f) };
+			const float z{ TestUtils::RandF(generator, 20.0f, 80.0f) };
+			const float halfSize{ TestUtils::RandF(generator, 3.0f, 10.0f) };
+			const std::uint32_t base{ static_cast<std::uint32_t>(mesh.mPositions.size() / 3UL) };
+			const float positions[]{
+				x - halfSize, y - halfSize, z,
+				x - halfSize, y + halfSize, z,
+				x + halfSize, y + halfSize, z,
+				x + halfSize, y - halfSize, z };
+			mesh.mPositions.insert(mesh.mPositions.end(), std::begin(positions), std::end(positions));
+			const std::uint32_t indices[]{ base, base + 1U, base + 2U, base, base + 2U, base + 3U };
+			mesh.mIndices.insert(mesh.mIndices.end(), std::begin(indices), std::end(indices));
+		}
+
+		return mesh;
+	}
+
+	// Rasterization of occluders (in quads) with each kernel
+	void BM_OcclusionCullerRasterize(benchmark::State& state) {
+		const OccluderMesh occluders{ SceneOccluders(static_cast<std::uint32_t>(state.range(0))) };
+		float viewProj[16U];
+		SceneViewProj(viewProj);
+
+		OcclusionCuller culler(sWidth, sHeight);
+		culler.SetKernel(static_cast<OcclusionCuller::Kernel>(state.range(1)));
+		for (auto _ : state) {
+			culler.BeginFrame(viewProj);
+			culler.RasterizeOccluder(occluders, sIdentity);
+			culler.EndFrame();
+			benchmark::DoNotOptimize(culler.DepthBuffer().data());
+		}
+
+		state.SetItemsProcessed(state.iterations() * occluders.TriangleCount());
+	}
+
+	void RasterizeArguments(benchmark::internal::Benchmark* benchmark) {
+		for (std::uint32_t kernel = OcclusionCuller::SCALAR; kernel <= OcclusionCuller::WidestKernel(); ++kernel) {
+			benchmark->Args({ 64, kernel });
+			benchmark->Args({ 1024, kernel });
+		}
+	}
+	BENCHMARK(BM_OcclusionCullerRasterize)->Apply(RasterizeArguments)->Unit(benchmark::kMicrosecond);
+
+	// Boxes behind the occluders, spread in the view frustum
+	void BM_OcclusionCullerIsVisible(benchmark::State& state) {
+		const std::uint32_t count{ static_cast<std::uint32_t>(state.range(0)) };
+		float viewProj[16U];
+		SceneViewProj(viewProj);
+
+		OcclusionCuller culler(sWidth, sHeight);
+		culler.BeginFrame(viewProj);
+		culler.RasterizeOccluder(SceneOccluders(64U), sIdentity);
+		culler.EndFrame();
+
+		std::mt19937 generator{ 7U };
+		std::vector<Aabb> boxes(count);
+		for (Aabb& box : boxes) {
+			const float z{ TestUtils::RandF(generator, 30.0f, 500.0f) };
+			const float center[3U]{ TestUtils::RandF(generator, -z, z) * 0.9f, TestUtils::RandF(generator, -z, z) * 0.5f, z };
+			const float halfSize{ TestUtils::RandF(generator, 0.5f, 5.0f) };
+			for (std::uint32_t j = 0U; j < 3U; ++j) {
+				box.mMin[j] = center[j] - halfSize;
+				box.mMax[j] = center[j] + halfSize;
+			}
+		}
+
+		std::uint32_t visibleCount{ 0U };
+		for (auto _ : state) {
+			visibleCount = 0U;
+			for (const Aabb& box : boxes) {
+				visibleCount += culler.IsVisible(box) ? 1U : 0U;
+			}
+			benchmark::DoNotOptimize(visibleCount);
+		}
+
+		state.SetItemsProcessed(state.iterations() * count);
+		state.counters["Visible"] = static_cast<double>(visibleCount);
+	}
+	BENCHMARK(BM_OcclusionCullerIsVisible)->Arg(100000)->Unit(benchmark::kMillisecond);
+}
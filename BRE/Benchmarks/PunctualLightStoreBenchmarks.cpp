@@ -0,0 +1,43 @@
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <LightingPass/PunctualLightStore.h>
+#include <Tests/TestUtils.h>
+
+namespace {
+	// Lights spread in a 1000 units cube, seen by a camera at its center,
+	// so around 5% of them are visible.
+	void BM_PunctualLightStoreUpdate(benchmark::State& state) {
+		const std::uint32_t count{ static_cast<std::uint32_t>(state.range(0)) };
+		std::mt19937 generator{ 42U };
+		std::vector<PunctualLight> lights(count);
+		for (PunctualLight& light : lights) {
+			for (std::uint32_t j = 0U; j < 3U; ++j) {
+				light.mPosAndRange[j] = TestUtils::RandF(generator, -500.0f, 500.0f);
+			}
+			light.mPosAndRange[3U] = TestUtils::RandF(generator, 1.0f, 10.0f);
+		}
+
+		PunctualLightStore store;
+		store.Init(lights.data(), count);
+
+		const float eye[3U]{ 0.0f, 0.0f, 0.0f };
+		const float target[3U]{ 0.0f, 0.0f, 1.0f };
+		float view[16U];
+		float proj[16U];
+		TestUtils::LookAt(eye, target, view);
+		TestUtils::Perspective(3.14159265f * 0.25f, 16.0f / 9.0f, 0.1f, 1000.0f, proj);
+
+		for (auto _ : state) {
+			store.Update(view, proj);
+			benchmark::DoNotOptimize(store.VisibleLights());
+		}
+
+		state.SetItemsProcessed(state.iterations() * count);
+		state.counters["Visible"] = static_cast<double>(store.VisibleLightCount());
+	}
+	BENCHMARK(BM_PunctualLightStoreUpdate)->Arg(10000)->Arg(50000)->Unit(benchmark::kMicrosecond);
+}
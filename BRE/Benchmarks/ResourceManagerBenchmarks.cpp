@@ -0,0 +1,150 @@
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <ResourceManager/BufferParams.h>
+#include <ResourceManager/CubeMapData.h>
+#include <Utils/MemoryUtils.h>
+
+namespace {
+	// Constant buffer elements must be multiples of 256 bytes (see UploadBuffer::CalcConstantBufferByteSize)
+	const std::size_t sConstantBufferAlignment{ 256UL };
+
+	// Same layout as ObjectCBuffer (ShaderUtils/CBuffers.h)
+	struct ObjectCBuffer {
+		float mWorld[16U];
+		float mTexTransform;
+	};
+
+	void BM_CalcConstantBufferByteSize(benchmark::State& state) {
+		std::vector<std::size_t> byteSizes;
+		for (std::size_t i = 1UL; i <= 4096UL; ++i) {
+			byteSizes.push_back(i * 13UL);
+		}
+
+		for (auto _ : state) {
+			std::size_t totalSize{ 0UL };
+			for (const std::size_t byteSize : byteSizes) {
+				totalSize += MemoryUtils::AlignUp(byteSize, sConstantBufferAlignment);
+			}
+			benchmark::DoNotOptimize(totalSize);
+		}
+
+		state.SetItemsProcessed(state.iterations() * byteSizes.size());
+	}
+	BENCHMARK(BM_CalcConstantBufferByteSize);
+
+	// Packs per object constant buffers in their aligned elements, like UploadBuffer::CopyData()
+	// and UploadBuffer::CopyDataStreaming() do in upload heaps. state.range(0) is the number of objects
+	// and state.range(1) is 1 to use streaming (non-temporal) copies.
+	void BM_PackObjectCBuffers(benchmark::State& state) {
+		const std::size_t objectCount{ static_cast<std::size_t>(state.range(0)) };
+		const bool streaming{ state.range(1) != 0 };
+		const std::size_t elemSize{ MemoryUtils::AlignUp(sizeof(ObjectCBuffer), sConstantBufferAlignment) };
+
+		std::vector<ObjectCBuffer> objects(objectCount);
+		for (std::size_t i = 0UL; i < objectCount; ++i) {
+			for (std::uint32_t j = 0U; j < 16U; ++j) {
+				objects[i].mWorld[j] = static_cast<float>(i + j);
+			}
+			objects[i].mTexTransform = 2.0f;
+		}
+		std::vector<std::uint8_t> mappedData(elemSize * objectCount);
+
+		for (auto _ : state) {
+			for (std::size_t i = 0UL; i < objectCount; ++i) {
+				if (streaming) {
+					MemoryUtils::StreamingCopy(mappedData.data() + i * elemSize, &objects[i], sizeof(ObjectCBuffer));
+				}
+				else {
+					memcpy(mappedData.data() + i * elemSize, &objects[i], sizeof(ObjectCBuffer));
+				}
+			}
+			benchmark::ClobberMemory();
+		}
+
+		state.SetItemsProcessed(state.iterations() * objectCount);
+		state.SetBytesProcessed(state.iterations() * objectCount * sizeof(ObjectCBuffer));
+	}
+	BENCHMARK(BM_PackObjectCBuffers)->ArgsProduct({ { 1 << 10, 1 << 14, 1 << 17 }, { 0, 1 } });
+
+	// Vertex and index buffer parameters of meshes, as Mesh does before creating their buffers
+	void BM_BufferParams(benchmark::State& state) {
+		const std::size_t meshCount{ static_cast<std::size_t>(state.range(0)) };
+		const std::size_t vertexSize{ 48UL };
+		const std::vector<std::uint8_t> vertices(vertexSize * 1024UL);
+		const std::vector<std::uint32_t> indices(3UL * 2048UL);
+
+		for (auto _ : state) {
+			std::uint64_t byteCount{ 0UL };
+			for (std::size_t i = 0UL; i < meshCount; ++i) {
+				const std::uint32_t vertexCount{ static_cast<std::uint32_t>(1UL + i % 1024UL) };
+				const BufferCreator::BufferParams vertexBufferParams(vertices.data(), vertexCount, vertexSize);
+				const BufferCreator::BufferParams indexBufferParams(indices.data(), vertexCount * 3U, sizeof(std::uint32_t));
+				if (vertexBufferParams.ValidateData() && indexBufferParams.ValidateData()) {
+					byteCount += vertexBufferParams.ByteSize() + indexBufferParams.ByteSize();
+				}
+			}
+			benchmark::DoNotOptimize(byteCount);
+		}
+
+		state.SetItemsProcessed(state.iterations() * meshCount);
+	}
+	BENCHMARK(BM_BufferParams)->Arg(1 << 10)->Arg(1 << 16);
+
+	void WriteUInt32(std::vector<std::uint8_t>& data, const std::size_t offset, const std::uint32_t value) {
+		memcpy(data.data() + offset, &value, sizeof(value));
+	}
+
+	// DDS file of a cube map with a single mip level, as written by texture tools.
+	// If halfFloat is false, texels are 8 bits RGBA.
+	std::vector<std::uint8_t> CubeMapDDS(const std::uint32_t faceSize, const bool halfFloat) {
+		const std::size_t headerSize{ 128UL };
+		const std::size_t bytesPerTexel{ halfFloat ? 8UL : 4UL };
+		std::vector<std::uint8_t> data(headerSize + faceSize * faceSize * bytesPerTexel * CubeMapData::sFaceCount);
+
+		WriteUInt32(data, 0UL, 0x20534444U); // 'DDS '
+		WriteUInt32(data, 4UL, 124U); // Header size
+		WriteUInt32(data, 12UL, faceSize); // Height
+		WriteUInt32(data, 16UL, faceSize); // Width
+		WriteUInt32(data, 28UL, 1U); // Mip count
+		WriteUInt32(data, 76UL, 32U); // Pixel format size
+		if (halfFloat) {
+			WriteUInt32(data, 80UL, 0x4U); // Four character code
+			WriteUInt32(data, 84UL, 113U); // D3DFMT_A16B16G16R16F
+		}
+		else {
+			WriteUInt32(data, 80UL, 0x41U); // RGB with alpha
+			WriteUInt32(data, 88UL, 32U);
+			WriteUInt32(data, 92UL, 0x000000FFU);
+			WriteUInt32(data, 96UL, 0x0000FF00U);
+			WriteUInt32(data, 100UL, 0x00FF0000U);
+			WriteUInt32(data, 104UL, 0xFF000000U);
+		}
+		WriteUInt32(data, 112UL, 0xFE00U); // Cube map with all faces
+
+		for (std::size_t i = headerSize; i < data.size(); ++i) {
+			data[i] = static_cast<std::uint8_t>(i * 7UL);
+		}
+
+		return data;
+	}
+
+	// state.range(0) is the face size and state.range(1) is 1 for half float texels
+	void BM_CubeMapDataLoadDDS(benchmark::State& state) {
+		const std::vector<std::uint8_t> data{ CubeMapDDS(static_cast<std::uint32_t>(state.range(0)), state.range(1) != 0) };
+
+		CubeMapData cubeMapData;
+		for (auto _ : state) {
+			if (cubeMapData.LoadDDS(data.data(), data.size()) == false) {
+				state.SkipWithError("DDS file was not loaded");
+				break;
+			}
+		}
+
+		state.SetBytesProcessed(state.iterations() * data.size());
+	}
+	BENCHMARK(BM_CubeMapDataLoadDDS)->ArgsProduct({ { 64, 256 }, { 0, 1 } })->Unit(benchmark::kMicrosecond);
+}
@@ -0,0 +1,93 @@
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <tbb/parallel_for.h>
+
+#include <ShaderManager/ShaderFileStore.h>
+
+namespace {
+	// Number of distinct .cso files (root signatures and shaders) that the passes load
+	const std::uint32_t sShaderFileCount{ 44U };
+
+	// Shader files of 2 KB to 24 KB, written once in the benchmark files directory.
+	// They are in the page cache after the first run, so disk reads are not measured.
+	const std::vector<std::string>& ShaderPaths() {
+		static std::vector<std::string> paths;
+		if (paths.empty()) {
+			for (std::uint32_t i = 0U; i < sShaderFileCount; ++i) {
+				paths.push_back(std::string(BRE_BENCHMARK_FILES_PATH) + "Shader" + std::to_string(i) + ".cso");
+				const std::vector<char> bytes(2048UL + (i % 12UL) * 2048UL, static_cast<char>(i));
+				std::ofstream file(paths.back(), std::ios::binary | std::ios::trunc);
+				file.write(bytes.data(), bytes.size());
+			}
+		}
+
+		return paths;
+	}
+
+	// Loads of all shader files into a new store, like passes initialization does.
+	// state.range(0) is 1 to load them in parallel (as the startup task graph does).
+	void BM_ShaderFileStoreColdLoad(benchmark::State& state) {
+		const std::vector<std::string>& paths(ShaderPaths());
+		const bool parallel{ state.range(0) != 0 };
+		for (auto _ : state) {
+			ShaderFileStore store;
+			if (parallel) {
+				tbb::parallel_for(0U, sShaderFileCount, [&store, &paths](const std::uint32_t i) {
+					ShaderFileStore::View view;
+					store.Load(paths[i].c_str(), view);
+					benchmark::DoNotOptimize(view.mData);
+				});
+			}
+			else {
+				for (const std::string& path : paths) {
+					ShaderFileStore::View view;
+					store.Load(path.c_str(), view);
+					benchmark::DoNotOptimize(view.mData);
+				}
+			}
+		}
+
+		state.SetItemsProcessed(state.iterations() * sShaderFileCount);
+	}
+	BENCHMARK(BM_ShaderFileStoreColdLoad)->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+	// Loads of already mapped files (PSOs that share root signatures or shaders)
+	void BM_ShaderFileStoreInternedLoad(benchmark::State& state) {
+		const std::vector<std::string>& paths(ShaderPaths());
+		ShaderFileStore store;
+		ShaderFileStore::View view;
+		for (const std::string& path : paths) {
+			store.Load(path.c_str(), view);
+		}
+
+		for (auto _ : state) {
+			for (const std::string& path : paths) {
+				store.Load(path.c_str(), view);
+				benchmark::DoNotOptimize(view.mData);
+			}
+		}
+
+		state.SetItemsProcessed(state.iterations() * sShaderFileCount);
+	}
+	BENCHMARK(BM_ShaderFileStoreInternedLoad)->Unit(benchmark::kMicrosecond);
+
+	// Baseline: each load reads the file into a new buffer, as ShaderManager did before interning
+	void BM_ShaderFileReadCopy(benchmark::State& state) {
+		const std::vector<std::string>& paths(ShaderPaths());
+		for (auto _ : state) {
+			for (const std::string& path : paths) {
+				std::ifstream file(path, std::ios::binary);
+				const std::vector<char> bytes{ std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+				benchmark::DoNotOptimize(bytes.data());
+			}
+		}
+
+		state.SetItemsProcessed(state.iterations() * sShaderFileCount);
+	}
+	BENCHMARK(BM_ShaderFileReadCopy)->Unit(benchmark::kMicrosecond);
+}
@@ -0,0 +1,56 @@
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <MathUtils/TransformHierarchy.h>
+#include <Tests/TestUtils.h>
+
+namespace {
+	// Models with 4 levels: a root per 100 nodes, 9 children per root and 10 children per child
+	void BuildScene(const std::uint32_t nodeCount, TransformHierarchy& hierarchy) {
+		const float rotation[4U]{ 0.0f, 0.0f, 0.0f, 1.0f };
+		const float scale[3U]{ 1.0f, 1.0f, 1.0f };
+		std::mt19937 generator{ 42U };
+		std::vector<TransformHierarchy::Handle> parents;
+		for (std::uint32_t node = 0U; node < nodeCount; ++node) {
+			const float translation[3U]{ TestUtils::RandF(generator, -10.0f, 10.0f), TestUtils::RandF(generator, -10.0f, 10.0f), TestUtils::RandF(generator, -10.0f, 10.0f) };
+			const std::uint32_t modelNode{ node % 100U };
+			TransformHierarchy::Handle parent{ TransformHierarchy::sInvalidHandle };
+			if (modelNode != 0U) {
+				parent = modelNode < 10U ? node - modelNode : node - modelNode + modelNode / 10U;
+			}
+			hierarchy.AddNode(parent, translation, rotation, scale);
+		}
+	}
+
+	// Translates a percentage of the roots (so their models are updated)
+	void BM_TransformHierarchyUpdate(benchmark::State& state) {
+		const std::uint32_t nodeCount{ static_cast<std::uint32_t>(state.range(0)) };
+		const std::uint32_t modifiedPercentage{ static_cast<std::uint32_t>(state.range(1)) };
+		TransformHierarchy hierarchy;
+		BuildScene(nodeCount, hierarchy);
+		hierarchy.Update();
+
+		float translation[3U]{ 0.0f, 0.0f, 0.0f };
+		for (auto _ : state) {
+			translation[1U] += 0.01f;
+			for (std::uint32_t root = 0U; root < nodeCount; root += 100U) {
+				if ((root / 100U) % 100U < modifiedPercentage) {
+					hierarchy.SetTranslation(root, translation);
+				}
+			}
+			hierarchy.Update();
+		}
+
+		state.SetItemsProcessed(state.iterations() * nodeCount);
+		state.counters["Changed"] = static_cast<double>(hierarchy.ChangedNodeCount());
+	}
+	BENCHMARK(BM_TransformHierarchyUpdate)
+		->Args({ 100000, 0 })
+		->Args({ 100000, 10 })
+		->Args({ 100000, 100 })
+		->Unit(benchmark::kMicrosecond)
+		->UseRealTime();
+}
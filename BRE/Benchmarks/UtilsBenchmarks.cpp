@@ -0,0 +1,129 @@
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <Utils/HashUtils.h>
+#include <Utils/NumberGeneration.h>
+#include <Utils/RadixSort.h>
+
+namespace {
+	// Strings like the ones hashed at runtime (shader and resource file paths)
+	std::vector<std::string> FilePaths(const std::size_t count, const std::size_t length) {
+		std::vector<std::string> paths;
+		for (std::size_t i = 0UL; i < count; ++i) {
+			std::string path{ "resources/textures/" + std::to_string(i) + "/" };
+			path.resize(length > path.size() ? length : path.size(), 'a' + static_cast<char>(i % 26UL));
+			paths.push_back(path + ".dds");
+		}
+
+		return paths;
+	}
+
+	void BM_HashCString(benchmark::State& state) {
+		const std::vector<std::string> paths{ FilePaths(1024UL, static_cast<std::size_t>(state.range(0))) };
+		std::size_t byteCount{ 0UL };
+		for (const std::string& path : paths) {
+			byteCount += path.size();
+		}
+
+		for (auto _ : state) {
+			for (const std::string& path : paths) {
+				benchmark::DoNotOptimize(HashUtils::HashCString(path.c_str()));
+			}
+		}
+
+		state.SetItemsProcessed(state.iterations() * paths.size());
+		state.SetBytesProcessed(state.iterations() * byteCount);
+	}
+	BENCHMARK(BM_HashCString)->Arg(16)->Arg(64)->Arg(256);
+
+	void BM_HashBytes(benchmark::State& state) {
+		const std::vector<std::uint8_t> bytes(static_cast<std::size_t>(state.range(0)), 0x5AU);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(HashUtils::HashBytes(bytes.data(), bytes.size()));
+		}
+
+		state.SetBytesProcessed(state.iterations() * bytes.size());
+	}
+	BENCHMARK(BM_HashBytes)->Arg(64)->Arg(4 << 10)->Arg(256 << 10);
+
+	void BM_SizeTRand(benchmark::State& state) {
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(NumberGeneration::SizeTRand());
+		}
+
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(BM_SizeTRand);
+
+	void BM_IncrementalSizeT(benchmark::State& state) {
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(NumberGeneration::IncrementalSizeT());
+		}
+
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(BM_IncrementalSizeT)->ThreadRange(1, 8);
+
+	// Keys like render queue ones: constant pass, few pipelines and recorders, random geometry buffers, materials and depth
+	std::vector<std::uint64_t> SortKeys(const std::size_t count) {
+		std::mt19937_64 generator{ 42U };
+		std::vector<std::uint64_t> keys(count);
+		for (std::uint64_t& key : keys) {
+			key = (generator() & 0x0003007FFFFFFFFFULL) | (1ULL << 60U);
+		}
+
+		return keys;
+	}
+
+	void BM_RadixSortKeyValues(benchmark::State& state) {
+		const std::size_t count{ static_cast<std::size_t>(state.range(0)) };
+		const std::vector<std::uint64_t> sourceKeys{ SortKeys(count) };
+		std::vector<std::uint64_t> keys(count);
+		std::vector<std::uint32_t> values(count);
+		std::vector<std::uint64_t> tmpKeys(count);
+		std::vector<std::uint32_t> tmpValues(count);
+		for (auto _ : state) {
+			state.PauseTiming();
+			keys = sourceKeys;
+			for (std::uint32_t i = 0U; i < count; ++i) {
+				values[i] = i;
+			}
+			state.ResumeTiming();
+
+			RadixSort::SortKeyValues(keys.data(), values.data(), count, tmpKeys.data(), tmpValues.data());
+			benchmark::DoNotOptimize(keys.data());
+		}
+
+		state.SetItemsProcessed(state.iterations() * count);
+	}
+	BENCHMARK(BM_RadixSortKeyValues)->Arg(10000)->Arg(1000000)->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+	// Baseline for BM_RadixSortKeyValues
+	void BM_StdStableSortKeyValues(benchmark::State& state) {
+		const std::size_t count{ static_cast<std::size_t>(state.range(0)) };
+		const std::vector<std::uint64_t> sourceKeys{ SortKeys(count) };
+		std::vector<std::pair<std::uint64_t, std::uint32_t>> pairs(count);
+		for (auto _ : state) {
+			state.PauseTiming();
+			for (std::uint32_t i = 0U; i < count; ++i) {
+				pairs[i] = std::make_pair(sourceKeys[i], i);
+			}
+			state.ResumeTiming();
+
+			std::stable_sort(
+				pairs.begin(),
+				pairs.end(),
+				[](const std::pair<std::uint64_t, std::uint32_t>& a, const std::pair<std::uint64_t, std::uint32_t>& b) { return a.first < b.first; });
+			benchmark::DoNotOptimize(pairs.data());
+		}
+
+		state.SetItemsProcessed(state.iterations() * count);
+	}
+	BENCHMARK(BM_StdStableSortKeyValues)->Arg(10000)->Arg(1000000)->Unit(benchmark::kMicrosecond);
+}
@@ -0,0 +1,143 @@
+#include "CameraPath.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <string>
+
+#include <Utils/DebugUtils.h>
+
+namespace {
+	const char* sFileHeader{ "CameraPath" };
+	const std::uint32_t sFileVersion{ 1U };
+
+	DirectX::XMFLOAT3 Lerp(const DirectX::XMFLOAT3& a, const DirectX::XMFLOAT3& b, const float t) noexcept {
+		return DirectX::XMFLOAT3(a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t, a.z + (b.z - a.z) * t);
+	}
+
+	// Vector is not modified if its length is 0
+	DirectX::XMFLOAT3 Normalize(const DirectX::XMFLOAT3& v) noexcept {
+		const float length{ std::sqrt(v.x * v.x + v.y * v.y + v.z * v.z) };
+		return length > 0.0f ? DirectX::XMFLOAT3(v.x / length, v.y / length, v.z / length) : v;
+	}
+
+	std::ostream& operator<<(std::ostream& stream, const DirectX::XMFLOAT3& v) {
+		return stream << v.x << " " << v.y << " " << v.z;
+	}
+
+	std::istream& operator>>(std::istream& stream, DirectX::XMFLOAT3& v) {
+		return stream >> v.x >> v.y >> v.z;
+	}
+}
+
+void CameraPath::AddKeyframe(
+	const float time,
+	const DirectX::XMFLOAT3& position,
+	const DirectX::XMFLOAT3& look,
+	const DirectX::XMFLOAT3& up) noexcept
+{
+	ASSERT(mKeyframes.empty() || mKeyframes.back().mTime <= time);
+
+	Keyframe keyframe;
+	keyframe.mTime = time;
+	keyframe.mPosition = position;
+	keyframe.mLook = look;
+	keyframe.mUp = up;
+	mKeyframes.push_back(keyframe);
+}
+
+void CameraPath::Sample(
+	const float time,
+	DirectX::XMFLOAT3& position,
+	DirectX::XMFLOAT3& look,
+	DirectX::XMFLOAT3& up) const noexcept
+{
+	ASSERT(mKeyframes.empty() == false);
+
+	// First keyframe with greater time
+	const std::vector<Keyframe>::const_iterator it{ 
+		std::upper_bound(
+			mKeyframes.begin(), 
+			mKeyframes.end(), 
+			time, 
+			[](const float t, const Keyframe& keyframe) { return t < keyframe.mTime; }) };
+
+	if (it == mKeyframes.begin() || it == mKeyframes.end()) {
+		const Keyframe& keyframe(it == mKeyframes.begin() ? mKeyframes.front() : mKeyframes.back());
+		position = keyframe.mPosition;
+		look = Normalize(keyframe.mLook);
+		up = Normalize(keyframe.mUp);
+		return;
+	}
+
+	const Keyframe& next(*it);
+	const Keyframe& previous(*(it - 1));
+	const float interval{ next.mTime - previous.mTime };
+	const float t{ interval > 0.0f ? (time - previous.mTime) / interval : 0.0f };
+	position = Lerp(previous.mPosition, next.mPosition, t);
+	look = Normalize(Lerp(previous.mLook, next.mLook, t));
+	up = Normalize(Lerp(previous.mUp, next.mUp, t));
+}
+
+float CameraPath::Duration() const noexcept {
+	return mKeyframes.empty() ? 0.0f : mKeyframes.back().mTime - mKeyframes.front().mTime;
+}
+
+bool CameraPath::Save(const char* filename) const noexcept {
+	ASSERT(filename != nullptr);
+
+	std::ofstream fout{ filename, std::ios::trunc };
+	if (!fout) {
+		return false;
+	}
+
+	// Enough digits to read the same floats
+	fout.precision(9);
+	fout << sFileHeader << " " << sFileVersion << " " << mKeyframes.size() << "\n";
+	for (const Keyframe& keyframe : mKeyframes) {
+		fout << keyframe.mTime << " " << keyframe.mPosition << " " << keyframe.mLook << " " << keyframe.mUp << "\n";
+	}
+
+	return static_cast<bool>(fout);
+}
+
+bool CameraPath::Load(const char* filename) noexcept {
+	ASSERT(filename != nullptr);
+
+	mKeyframes.clear();
+
+	std::ifstream fin{ filename };
+	if (!fin) {
+		return false;
+	}
+
+	std::string header;
+	std::uint32_t version{ 0U };
+	std::size_t keyframeCount{ 0UL };
+	fin >> header >> version >> keyframeCount;
+	if (!fin || header != sFileHeader || version != sFileVersion) {
+		return false;
+	}
+
+	mKeyframes.resize(keyframeCount);
+	for (Keyframe& keyframe : mKeyframes) {
+		fin >> keyframe.mTime >> keyframe.mPosition >> keyframe.mLook >> keyframe.mUp;
+	}
+
+	// Times must not decrease
+	const bool isValid{ 
+		static_cast<bool>(fin) &&
+		std::is_sorted(
+			mKeyframes.begin(), 
+			mKeyframes.end(), 
+			[](const Keyframe& a, const Keyframe& b) { return a.mTime < b.mTime; }) };
+	if (isValid == false) {
+		mKeyframes.clear();
+	}
+
+	return isValid;
+}
+
+void CameraPath::Clear() noexcept {
+	mKeyframes.clear();
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <DirectXMath.h>
+#include <vector>
+
+// Camera transforms (position, look and up vectors) along time,
+// linearly interpolated between keyframes.
+// It is used to record a camera from an interactive session, and to play it back.
+// Steps:
+// - Call AddKeyframe() with increasing times (for example, once per frame), and Save() it.
+// - Or Load() a saved path.
+// - Call Sample() to get the camera transform at any time.
+class CameraPath {
+public:
+	struct Keyframe {
+		float mTime{ 0.0f };
+		DirectX::XMFLOAT3 mPosition{ 0.0f, 0.0f, 0.0f };
+		DirectX::XMFLOAT3 mLook{ 0.0f, 0.0f, 1.0f };
+		DirectX::XMFLOAT3 mUp{ 0.0f, 1.0f, 0.0f };
+	};
+
+	CameraPath() = default;
+	~CameraPath() = default;
+	CameraPath(const CameraPath&) = delete;
+	const CameraPath& operator=(const CameraPath&) = delete;
+	CameraPath(CameraPath&&) = delete;
+	CameraPath& operator=(CameraPath&&) = delete;
+
+	// time (in seconds) must not be less than the time of the last keyframe
+	void AddKeyframe(
+		const float time, 
+		const DirectX::XMFLOAT3& position, 
+		const DirectX::XMFLOAT3& look, 
+		const DirectX::XMFLOAT3& up) noexcept;
+
+	// Transform at time. Times out of the path range are clamped. Path must not be empty.
+	// Look and up vectors are normalized.
+	void Sample(
+		const float time, 
+		DirectX::XMFLOAT3& position, 
+		DirectX::XMFLOAT3& look, 
+		DirectX::XMFLOAT3& up) const noexcept;
+
+	// Time of the last keyframe relative to the first one
+	float Duration() const noexcept;
+
+	// Text file, with a keyframe per line (time, position, look and up).
+	// Returns false if the file can not be written/read, or it is not a valid path.
+	bool Save(const char* filename) const noexcept;
+	bool Load(const char* filename) noexcept;
+
+	void Clear() noexcept;
+
+	__forceinline bool IsEmpty() const noexcept { return mKeyframes.empty(); }
+	__forceinline std::size_t KeyframeCount() const noexcept { return mKeyframes.size(); }
+	__forceinline const Keyframe& GetKeyframe(const std::size_t index) const noexcept { return mKeyframes[index]; }
+
+private:
+	std::vector<Keyframe> mKeyframes;
+};
@@ -1,28 +1,41 @@
 #include "CommandListExecutor.h"
 
-#include <Utils/DebugUtils.h>
+#include <chrono>
+#include <vector>
 
-CommandListExecutor* CommandListExecutor::Create(ID3D12CommandQueue* cmdQueue, const std::uint32_t maxNumCmdLists) noexcept {
-	tbb::empty_task* parent{ new (tbb::task::allocate_root()) tbb::empty_task };
+#include <CommandManager/CommandQueue.h>
+#include <Utils/DebugUtils.h>
+#include <Utils/Profiler.h>
+#include <Utils/RenderStats.h>
 
-	// 1 reference for the parent + 1 reference for the child
-	parent->set_ref_count(2);
-	return new (parent->allocate_child()) CommandListExecutor(cmdQueue, maxNumCmdLists);
+CommandListExecutor* CommandListExecutor::Create(CommandQueue& cmdQueue, const std::uint32_t maxNumCmdLists) noexcept {
+	return new CommandListExecutor(cmdQueue, maxNumCmdLists);
 }
 
-CommandListExecutor::CommandListExecutor(ID3D12CommandQueue* cmdQueue, const std::uint32_t maxNumCmdLists)
+CommandListExecutor::CommandListExecutor(CommandQueue& cmdQueue, const std::uint32_t maxNumCmdLists)
 	: mMaxNumCmdLists(maxNumCmdLists)
 	, mCmdQueue(cmdQueue)
 {
 	ASSERT(maxNumCmdLists > 0U);
-	parent()->spawn(*this);
+
+	// Its thread is not a TBB one, so the executor always runs, even when all TBB workers are busy
+	mThread = std::thread(&CommandListExecutor::Execute, this);
 }
 
-tbb::task* CommandListExecutor::execute() {
+CommandListExecutor::~CommandListExecutor() {
+	ASSERT(mThread.joinable() == false);
+}
+
+void CommandListExecutor::Execute() noexcept {
 	ASSERT(mMaxNumCmdLists > 0);
 
-	ID3D12CommandList* *cmdLists{ new ID3D12CommandList*[mMaxNumCmdLists] };
-	while (!mTerminate) {
+	PROFILE_THREAD("Command list executor");
+
+	std::vector<ID3D12CommandList*> cmdLists(mMaxNumCmdLists);
+	for (;;) {
+		// Read it before popping, so command lists pushed before Terminate() are executed
+		const bool terminate{ mTerminate };
+
 		// Pop at most mMaxNumCmdLists from command list queue
 		while (mPendingCmdLists < mMaxNumCmdLists && mCmdListQueue.try_pop(cmdLists[mPendingCmdLists])) {
 			++mPendingCmdLists;
@@ -30,21 +43,44 @@ tbb::task* CommandListExecutor::execute() {
 
 		// Execute command lists (if any)
 		if (mPendingCmdLists != 0U) {
-			mCmdQueue->ExecuteCommandLists(mPendingCmdLists, cmdLists);
-			mExecutedCmdLists += mPendingCmdLists;
+			PROFILE_ZONE("CommandListExecutor::ExecuteCommandLists");
+			RENDER_STATS_EXECUTE(mPendingCmdLists);
+			mCmdQueue.ExecuteCommandLists(mPendingCmdLists, cmdLists.data());
+			{
+				std::lock_guard<std::mutex> lock(mExecutedMutex);
+				mExecutedCmdLists += mPendingCmdLists;
+			}
+			mExecutedCondition.notify_all();
 			mPendingCmdLists = 0U;
 		}
+		else if (terminate) {
+			break;
+		}
 		else {
-			Sleep(0U);
+			std::this_thread::yield();
 		}
 	}
+}
+
+void CommandListExecutor::ResetExecutedCmdListCount() noexcept {
+	std::lock_guard<std::mutex> lock(mExecutedMutex);
+	mExecutedCmdLists = 0U;
+}
 
-	delete[] cmdLists;
+void CommandListExecutor::WaitForExecutedCmdLists(const std::uint32_t count) noexcept {
+	PROFILE_ZONE("CommandListExecutor::WaitForExecutedCmdLists");
+	std::unique_lock<std::mutex> lock(mExecutedMutex);
 
-	return nullptr;
+	// wait_for() is inline in libstdc++ (wait() needs GLIBCXX_3.4.30), so it also runs against older
+	// standard libraries. The timeout only bounds each wait, notifications wake it up as in wait().
+	const auto isExecuted = [this, count]() { return mExecutedCmdLists >= count; };
+	while (mExecutedCondition.wait_for(lock, std::chrono::milliseconds(100), isExecuted) == false) {
+	}
 }
 
 void CommandListExecutor::Terminate() noexcept {
 	mTerminate = true;
-	parent()->wait_for_all();
-}
\ No newline at end of file
+	if (mThread.joinable()) {
+		mThread.join();
+	}
+}
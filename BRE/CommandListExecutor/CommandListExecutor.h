@@ -1,56 +1,74 @@
 #pragma once
 
 #include <atomic>
-#include <d3d12.h>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
 #include <tbb/concurrent_queue.h>
-#include <tbb/task.h>
+#include <thread>
 
-// It has the responsibility to constantly check for new command lists and execute them.
+#include <Utils/ForceInline.h>
+
+class CommandQueue;
+struct ID3D12CommandList;
+
+// It has the responsibility to constantly check for new command lists and execute them
+// in a CommandQueue (of any backend), from its own thread.
 // Steps:
-// - Use CommandListExecutor::Create() to create and spawn an instance.
-// - When you spawn it, execute() method is automatically called. You should fill the queue with
-//   command lists. You can use CommandListExecutor::CmdListQueue() fto get it.
-// - When you want to terminate this task, you should call CommandListExecutor::Terminate() 
-class CommandListExecutor : public tbb::task {
+// - Use CommandListExecutor::Create() to create an instance and start its thread.
+// - Fill the queue with command lists. You can use CommandListExecutor::CmdListQueue() to get it.
+// - When you want to terminate it, you should call CommandListExecutor::Terminate(),
+//   and then delete it.
+class CommandListExecutor {
 public:
 	// maxNumCmdLists is the maximum number of command lists to execute 
-	// by ID3D12CommandQueue::ExecuteCommandLists() operation.
-	static CommandListExecutor* Create(ID3D12CommandQueue* cmdQueue, const std::uint32_t maxNumCmdLists) noexcept;
+	// by CommandQueue::ExecuteCommandLists() operation.
+	static CommandListExecutor* Create(CommandQueue& cmdQueue, const std::uint32_t maxNumCmdLists) noexcept;
 
-	~CommandListExecutor() = default;
+	~CommandListExecutor();
 	CommandListExecutor(const CommandListExecutor&) = delete;
 	const CommandListExecutor& operator=(const CommandListExecutor&) = delete;
 	CommandListExecutor(CommandListExecutor&&) = delete;
 	CommandListExecutor& operator=(CommandListExecutor&&) = delete;
 
 	// This method is used to know if there are no more pending commands lists to execute or to process.
-	// I thought this method was going to be thread safe, but that is not the case.
-	// As I did not discover yet, why it is not thread safe, then I only use it for debugging purposes.
+	// It is only exact when no thread pushes command lists (for example, between frames).
 	__forceinline bool IsIdle() const noexcept { return mCmdListQueue.empty() && mPendingCmdLists == 0; }
 
 	// A thread safe way to know if CommandListExecutor finished processing and executing all the command lists.
 	// If you are going to execute N command lists, then you should:
 	// - Call ResetExecutedCmdListCount()
 	// - Fill queue through CmdListQueue()
-	// - Check if ExecutedCmdListCount() is equal to N, to be sure all was executed properly (sent to GPU)
-	__forceinline void ResetExecutedCmdListCount() noexcept { mExecutedCmdLists = 0U; }
+	// - Check if ExecutedCmdListCount() is equal to N, to be sure all was executed properly (sent to GPU),
+	//   or call WaitForExecutedCmdLists(N) to block until then.
+	void ResetExecutedCmdListCount() noexcept;
 	__forceinline std::uint32_t ExecutedCmdListCount() const noexcept { return mExecutedCmdLists; }
+
+	// Blocks (without spinning) until ExecutedCmdListCount() is at least count
+	void WaitForExecutedCmdLists(const std::uint32_t count) noexcept;
 	
 	// You should push all your recorded command lists in this queue
 	__forceinline tbb::concurrent_queue<ID3D12CommandList*>& CmdListQueue() noexcept { return mCmdListQueue; }
 		
+	// Executes the command lists that are already in the queue and joins the thread
 	void Terminate() noexcept;	
 
 private:
-	explicit CommandListExecutor(ID3D12CommandQueue* cmdQueue, const std::uint32_t maxNumCmdLists);
+	explicit CommandListExecutor(CommandQueue& cmdQueue, const std::uint32_t maxNumCmdLists);
 
-	// Called when tbb::task is spawned
-	tbb::task* execute() final override;
+	// Thread function
+	void Execute() noexcept;
 
-	bool mTerminate{ false };
-	std::uint32_t mExecutedCmdLists{ 0U };
+	std::atomic<bool> mTerminate{ false };
+	std::atomic<std::uint32_t> mExecutedCmdLists{ 0U };
 	std::atomic<std::uint32_t> mPendingCmdLists{ 0U };
 	std::uint32_t mMaxNumCmdLists{ 1U };
-	ID3D12CommandQueue* mCmdQueue{ nullptr };
+	CommandQueue& mCmdQueue;
 	tbb::concurrent_queue<ID3D12CommandList*> mCmdListQueue;
+
+	// Executed count is modified with the mutex locked, so waiting threads do not miss notifications
+	std::mutex mExecutedMutex;
+	std::condition_variable mExecutedCondition;
+
+	std::thread mThread;
 };
@@ -0,0 +1,197 @@
+#include "CaptureCommandList.h"
+
+#include <CommandManager/CommandStream.h>
+#include <Utils/DebugUtils.h>
+
+namespace {
+	std::uint64_t ToAddress(const void* object) noexcept {
+		return static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(object));
+	}
+}
+
+CaptureCommandList::CaptureCommandList(CommandStream& stream, GraphicsCommandList* forwardCmdList)
+	: mStream(stream)
+	, mForwardCmdList(forwardCmdList)
+{
+	ASSERT(forwardCmdList != this);
+}
+
+void CaptureCommandList::SetPipelineState(ID3D12PipelineState* pipelineState) noexcept {
+	mStream.WriteRecordType(CommandStream::SET_PIPELINE_STATE);
+	mStream.Write(ToAddress(pipelineState));
+
+	if (mForwardCmdList != nullptr) {
+		mForwardCmdList->SetPipelineState(pipelineState);
+	}
+}
+
+void CaptureCommandList::SetGraphicsRootSignature(ID3D12RootSignature* rootSignature) noexcept {
+	mStream.WriteRecordType(CommandStream::SET_ROOT_SIGNATURE);
+	mStream.Write(ToAddress(rootSignature));
+
+	if (mForwardCmdList != nullptr) {
+		mForwardCmdList->SetGraphicsRootSignature(rootSignature);
+	}
+}
+
+void CaptureCommandList::SetDescriptorHeaps(const std::uint32_t numDescriptorHeaps, ID3D12DescriptorHeap* const* descriptorHeaps) noexcept {
+	mStream.WriteRecordType(CommandStream::SET_DESCRIPTOR_HEAPS);
+	mStream.Write(numDescriptorHeaps);
+	mStream.Write(static_cast<std::uint8_t>(descriptorHeaps != nullptr ? 1U : 0U));
+	if (descriptorHeaps != nullptr) {
+		for (std::uint32_t i = 0U; i < numDescriptorHeaps; ++i) {
+			mStream.Write(ToAddress(descriptorHeaps[i]));
+		}
+	}
+
+	if (mForwardCmdList != nullptr) {
+		mForwardCmdList->SetDescriptorHeaps(numDescriptorHeaps, descriptorHeaps);
+	}
+}
+
+void CaptureCommandList::SetGraphicsRootConstantBufferView(const std::uint32_t rootParameterIndex, const std::uint64_t bufferLocation) noexcept {
+	mStream.WriteRecordType(CommandStream::SET_ROOT_CONSTANT_BUFFER_VIEW);
+	mStream.Write(rootParameterIndex);
+	mStream.Write(bufferLocation);
+
+	if (mForwardCmdList != nullptr) {
+		mForwardCmdList->SetGraphicsRootConstantBufferView(rootParameterIndex, bufferLocation);
+	}
+}
+
+void CaptureCommandList::SetGraphicsRootShaderResourceView(const std::uint32_t rootParameterIndex, const std::uint64_t bufferLocation) noexcept {
+	mStream.WriteRecordType(CommandStream::SET_ROOT_SHADER_RESOURCE_VIEW);
+	mStream.Write(rootParameterIndex);
+	mStream.Write(bufferLocation);
+
+	if (mForwardCmdList != nullptr) {
+		mForwardCmdList->SetGraphicsRootShaderResourceView(rootParameterIndex, bufferLocation);
+	}
+}
+
+void CaptureCommandList::SetGraphicsRootDescriptorTable(const std::uint32_t rootParameterIndex, const std::uint64_t baseDescriptor) noexcept {
+	mStream.WriteRecordType(CommandStream::SET_ROOT_DESCRIPTOR_TABLE);
+	mStream.Write(rootParameterIndex);
+	mStream.Write(baseDescriptor);
+
+	if (mForwardCmdList != nullptr) {
+		mForwardCmdList->SetGraphicsRootDescriptorTable(rootParameterIndex, baseDescriptor);
+	}
+}
+
+void CaptureCommandList::SetGraphicsRoot32BitConstant(const std::uint32_t rootParameterIndex, const std::uint32_t srcData, const std::uint32_t destOffsetIn32BitValues) noexcept {
+	mStream.WriteRecordType(CommandStream::SET_ROOT_CONSTANT);
+	const std::uint32_t values[3U]{ rootParameterIndex, srcData, destOffsetIn32BitValues };
+	mStream.Write(values);
+
+	if (mForwardCmdList != nullptr) {
+		mForwardCmdList->SetGraphicsRoot32BitConstant(rootParameterIndex, srcData, destOffsetIn32BitValues);
+	}
+}
+
+void CaptureCommandList::IASetPrimitiveTopology(const std::uint32_t primitiveTopology) noexcept {
+	mStream.WriteRecordType(CommandStream::SET_PRIMITIVE_TOPOLOGY);
+	mStream.Write(primitiveTopology);
+
+	if (mForwardCmdList != nullptr) {
+		mForwardCmdList->IASetPrimitiveTopology(primitiveTopology);
+	}
+}
+
+void CaptureCommandList::IASetVertexBuffers(const std::uint32_t startSlot, const std::uint32_t numViews, const VertexBufferView* views) noexcept {
+	mStream.WriteRecordType(CommandStream::SET_VERTEX_BUFFERS);
+	mStream.Write(startSlot);
+	WriteArray(numViews, views, sizeof(VertexBufferView));
+
+	if (mForwardCmdList != nullptr) {
+		mForwardCmdList->IASetVertexBuffers(startSlot, numViews, views);
+	}
+}
+
+void CaptureCommandList::IASetIndexBuffer(const IndexBufferView* view) noexcept {
+	mStream.WriteRecordType(CommandStream::SET_INDEX_BUFFER);
+	WriteArray(1U, view, sizeof(IndexBufferView));
+
+	if (mForwardCmdList != nullptr) {
+		mForwardCmdList->IASetIndexBuffer(view);
+	}
+}
+
+void CaptureCommandList::RSSetViewports(const std::uint32_t numViewports, const Viewport* viewports) noexcept {
+	mStream.WriteRecordType(CommandStream::SET_VIEWPORTS);
+	WriteArray(numViewports, viewports, sizeof(Viewport));
+
+	if (mForwardCmdList != nullptr) {
+		mForwardCmdList->RSSetViewports(numViewports, viewports);
+	}
+}
+
+void CaptureCommandList::RSSetScissorRects(const std::uint32_t numRects, const Rect* rects) noexcept {
+	mStream.WriteRecordType(CommandStream::SET_SCISSOR_RECTS);
+	WriteArray(numRects, rects, sizeof(Rect));
+
+	if (mForwardCmdList != nullptr) {
+		mForwardCmdList->RSSetScissorRects(numRects, rects);
+	}
+}
+
+void CaptureCommandList::OMSetRenderTargets(
+	const std::uint32_t numRenderTargetDescriptors,
+	const CpuDescriptorHandle* renderTargetDescriptors,
+	const bool rtsSingleHandleToDescriptorRange,
+	const CpuDescriptorHandle* depthStencilDescriptor) noexcept
+{
+	mStream.WriteRecordType(CommandStream::SET_RENDER_TARGETS);
+	mStream.Write(numRenderTargetDescriptors);
+	mStream.Write(static_cast<std::uint8_t>(rtsSingleHandleToDescriptorRange ? 1U : 0U));
+	const std::uint32_t handleCount{ 
+		rtsSingleHandleToDescriptorRange && numRenderTargetDescriptors > 0U ? 1U : numRenderTargetDescriptors };
+	WriteArray(handleCount, renderTargetDescriptors, sizeof(CpuDescriptorHandle));
+	WriteArray(1U, depthStencilDescriptor, sizeof(CpuDescriptorHandle));
+
+	if (mForwardCmdList != nullptr) {
+		mForwardCmdList->OMSetRenderTargets(
+			numRenderTargetDescriptors, 
+			renderTargetDescriptors, 
+			rtsSingleHandleToDescriptorRange, 
+			depthStencilDescriptor);
+	}
+}
+
+void CaptureCommandList::ResourceBarrier(const std::uint32_t numBarriers, const Barrier* barriers) noexcept {
+	mStream.WriteRecordType(CommandStream::RESOURCE_BARRIER);
+	WriteArray(numBarriers, barriers, sizeof(Barrier));
+
+	if (mForwardCmdList != nullptr) {
+		mForwardCmdList->ResourceBarrier(numBarriers, barriers);
+	}
+}
+
+void CaptureCommandList::DrawIndexedInstanced(
+	const std::uint32_t indexCountPerInstance,
+	const std::uint32_t instanceCount,
+	const std::uint32_t startIndexLocation,
+	const std::int32_t baseVertexLocation,
+	const std::uint32_t startInstanceLocation) noexcept
+{
+	mStream.WriteRecordType(CommandStream::DRAW_INDEXED_INSTANCED);
+	const std::uint32_t values[5U]{ 
+		indexCountPerInstance, 
+		instanceCount, 
+		startIndexLocation, 
+		static_cast<std::uint32_t>(baseVertexLocation), 
+		startInstanceLocation };
+	mStream.Write(values);
+
+	if (mForwardCmdList != nullptr) {
+		mForwardCmdList->DrawIndexedInstanced(indexCountPerInstance, instanceCount, startIndexLocation, baseVertexLocation, startInstanceLocation);
+	}
+}
+
+void CaptureCommandList::WriteArray(const std::uint32_t count, const void* data, const std::size_t elementSize) noexcept {
+	mStream.Write(count);
+	mStream.Write(static_cast<std::uint8_t>(data != nullptr ? 1U : 0U));
+	if (data != nullptr) {
+		mStream.WriteBytes(data, count * elementSize);
+	}
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <CommandManager/GraphicsCommandList.h>
+
+class CommandStream;
+
+// GraphicsCommandList backend that writes every command to a CommandStream.
+// Commands can be also forwarded to another backend (for example, a D3D12CommandList),
+// so a frame can be captured while it is recorded.
+// Arrays are captured with the elements the command reads (a single render target
+// handle if rtsSingleHandleToDescriptorRange is true). Null arrays are captured as null.
+class CaptureCommandList : public GraphicsCommandList {
+public:
+	explicit CaptureCommandList(CommandStream& stream, GraphicsCommandList* forwardCmdList = nullptr);
+	~CaptureCommandList() = default;
+	CaptureCommandList(const CaptureCommandList&) = delete;
+	const CaptureCommandList& operator=(const CaptureCommandList&) = delete;
+	CaptureCommandList(CaptureCommandList&&) = delete;
+	CaptureCommandList& operator=(CaptureCommandList&&) = delete;
+
+	void SetPipelineState(ID3D12PipelineState* pipelineState) noexcept final override;
+	void SetGraphicsRootSignature(ID3D12RootSignature* rootSignature) noexcept final override;
+	void SetDescriptorHeaps(const std::uint32_t numDescriptorHeaps, ID3D12DescriptorHeap* const* descriptorHeaps) noexcept final override;
+
+	void SetGraphicsRootConstantBufferView(const std::uint32_t rootParameterIndex, const std::uint64_t bufferLocation) noexcept final override;
+	void SetGraphicsRootShaderResourceView(const std::uint32_t rootParameterIndex, const std::uint64_t bufferLocation) noexcept final override;
+	void SetGraphicsRootDescriptorTable(const std::uint32_t rootParameterIndex, const std::uint64_t baseDescriptor) noexcept final override;
+	void SetGraphicsRoot32BitConstant(const std::uint32_t rootParameterIndex, const std::uint32_t srcData, const std::uint32_t destOffsetIn32BitValues) noexcept final override;
+
+	void IASetPrimitiveTopology(const std::uint32_t primitiveTopology) noexcept final override;
+	void IASetVertexBuffers(const std::uint32_t startSlot, const std::uint32_t numViews, const VertexBufferView* views) noexcept final override;
+	void IASetIndexBuffer(const IndexBufferView* view) noexcept final override;
+
+	void RSSetViewports(const std::uint32_t numViewports, const Viewport* viewports) noexcept final override;
+	void RSSetScissorRects(const std::uint32_t numRects, const Rect* rects) noexcept final override;
+	void OMSetRenderTargets(
+		const std::uint32_t numRenderTargetDescriptors,
+		const CpuDescriptorHandle* renderTargetDescriptors,
+		const bool rtsSingleHandleToDescriptorRange,
+		const CpuDescriptorHandle* depthStencilDescriptor) noexcept final override;
+
+	void ResourceBarrier(const std::uint32_t numBarriers, const Barrier* barriers) noexcept final override;
+
+	void DrawIndexedInstanced(
+		const std::uint32_t indexCountPerInstance,
+		const std::uint32_t instanceCount,
+		const std::uint32_t startIndexLocation,
+		const std::int32_t baseVertexLocation,
+		const std::uint32_t startInstanceLocation) noexcept final override;
+
+private:
+	// Writes count, a flag (data is not null) and the elements
+	void WriteArray(const std::uint32_t count, const void* data, const std::size_t elementSize) noexcept;
+
+	CommandStream& mStream;
+	GraphicsCommandList* mForwardCmdList{ nullptr };
+};
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+
+struct ID3D12CommandList;
+
+// Command queue interface used to submit command lists and synchronize with their execution
+// through a fence, so submission and frame synchronization code does not depend on a backend.
+// Command lists are opaque handles: ID3D12CommandList objects for D3D12CommandQueue, and
+// NullCommandList::Handle() for NullCommandQueue.
+// Backends:
+// - D3D12CommandQueue: forwards to an ID3D12CommandQueue and signals an ID3D12Fence.
+// - NullCommandQueue: counts command lists and completes fence values when they are signaled.
+// Steps:
+// - Call ExecuteCommandLists() with recorded command lists.
+// - Call Signal() with a greater fence value than the last one.
+// - Query CompletedFenceValue(), or call WaitForFenceValue() to block until the fence reaches a value.
+class CommandQueue {
+public:
+	CommandQueue() = default;
+	virtual ~CommandQueue() {}
+	CommandQueue(const CommandQueue&) = delete;
+	const CommandQueue& operator=(const CommandQueue&) = delete;
+	CommandQueue(CommandQueue&&) = delete;
+	CommandQueue& operator=(CommandQueue&&) = delete;
+
+	virtual void ExecuteCommandLists(const std::uint32_t numCommandLists, ID3D12CommandList* const* commandLists) noexcept = 0;
+
+	// The fence is set to fenceValue when all the previously executed command lists are completed
+	virtual void Signal(const std::uint64_t fenceValue) noexcept = 0;
+
+	virtual std::uint64_t CompletedFenceValue() const noexcept = 0;
+
+	// Blocks (without spinning) until CompletedFenceValue() is at least fenceValue
+	virtual void WaitForFenceValue(const std::uint64_t fenceValue) noexcept = 0;
+};
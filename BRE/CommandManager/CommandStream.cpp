@@ -0,0 +1,483 @@
+#include "CommandStream.h"
+
+#include <cstring>
+#include <fstream>
+
+#include <Utils/DebugUtils.h>
+
+namespace {
+	// Sequential reader of stream records. Reads fail (and the stream is considered
+	// corrupted) if they go beyond the end of the data.
+	class Reader {
+	public:
+		explicit Reader(const std::vector<std::uint8_t>& data) noexcept
+			: mData(data.data())
+			, mSize(data.size())
+		{
+		}
+
+		__forceinline bool IsAtEnd() const noexcept { return mOffset == mSize; }
+
+		bool ReadBytes(void* data, const std::size_t size) noexcept {
+			if (size > mSize - mOffset) {
+				return false;
+			}
+			memcpy(data, mData + mOffset, size);
+			mOffset += size;
+			return true;
+		}
+
+		template<typename T>
+		__forceinline bool Read(T& value) noexcept { return ReadBytes(&value, sizeof(T)); }
+
+		// Reads an array written by CaptureCommandList in elements (up to maxCount elements).
+		// data is nullptr if a null array was captured.
+		template<typename T>
+		bool ReadArray(T* elements, const std::size_t maxCount, std::uint32_t& count, const T*& data) noexcept {
+			std::uint8_t hasData{ 0U };
+			if (Read(count) == false || Read(hasData) == false) {
+				return false;
+			}
+			if (hasData == 0U) {
+				data = nullptr;
+				return true;
+			}
+			if (count > maxCount || ReadBytes(elements, count * sizeof(T)) == false) {
+				return false;
+			}
+			data = elements;
+			return true;
+		}
+
+		bool Skip(const std::size_t size) noexcept {
+			if (size > mSize - mOffset) {
+				return false;
+			}
+			mOffset += size;
+			return true;
+		}
+
+		__forceinline const std::uint8_t* Current() const noexcept { return mData + mOffset; }
+
+	private:
+		const std::uint8_t* mData{ nullptr };
+		std::size_t mSize{ 0UL };
+		std::size_t mOffset{ 0UL };
+	};
+
+	// Maximum array sizes of replayed commands
+	const std::uint32_t sMaxDescriptorHeapCount{ 2U };
+	const std::uint32_t sMaxBarrierCount{ 256U };
+
+	template<typename T>
+	__forceinline T* ToObject(const std::uint64_t address) noexcept {
+		return reinterpret_cast<T*>(static_cast<std::uintptr_t>(address));
+	}
+
+	// Skips the arguments of a record whose type was already read.
+	// Returns false if they go beyond the end of the data, the type is unknown,
+	// or an array has more elements than Replay() accepts.
+	bool SkipRecord(Reader& reader, const std::uint8_t type) noexcept {
+		// Arrays are a count, a flag and the elements (if the flag is not 0).
+		// Only render targets have 2 arrays (render targets and depth stencil).
+		std::size_t fixedSize{ 0UL };
+		std::size_t elementSize{ 0UL };
+		std::uint32_t maxCounts[2U]{ 0U, 0U };
+		std::uint32_t arrayCount{ 0U };
+		switch (type) {
+		case CommandStream::SET_PIPELINE_STATE:
+		case CommandStream::SET_ROOT_SIGNATURE:
+			fixedSize = sizeof(std::uint64_t);
+			break;
+		case CommandStream::SET_DESCRIPTOR_HEAPS:
+			elementSize = sizeof(std::uint64_t);
+			maxCounts[0U] = sMaxDescriptorHeapCount;
+			arrayCount = 1U;
+			break;
+		case CommandStream::SET_ROOT_CONSTANT_BUFFER_VIEW:
+		case CommandStream::SET_ROOT_SHADER_RESOURCE_VIEW:
+		case CommandStream::SET_ROOT_DESCRIPTOR_TABLE:
+			fixedSize = sizeof(std::uint32_t) + sizeof(std::uint64_t);
+			break;
+		case CommandStream::SET_ROOT_CONSTANT:
+			fixedSize = sizeof(std::uint32_t) * 3UL;
+			break;
+		case CommandStream::SET_PRIMITIVE_TOPOLOGY:
+		case CommandStream::EXECUTE_COMMAND_LISTS:
+			fixedSize = sizeof(std::uint32_t);
+			break;
+		case CommandStream::SET_VERTEX_BUFFERS:
+			fixedSize = sizeof(std::uint32_t);
+			elementSize = sizeof(GraphicsCommandList::VertexBufferView);
+			maxCounts[0U] = GraphicsCommandList::sMaxVertexBufferCount;
+			arrayCount = 1U;
+			break;
+		case CommandStream::SET_INDEX_BUFFER:
+			elementSize = sizeof(GraphicsCommandList::IndexBufferView);
+			maxCounts[0U] = 1U;
+			arrayCount = 1U;
+			break;
+		case CommandStream::SET_VIEWPORTS:
+			elementSize = sizeof(GraphicsCommandList::Viewport);
+			maxCounts[0U] = GraphicsCommandList::sMaxViewportCount;
+			arrayCount = 1U;
+			break;
+		case CommandStream::SET_SCISSOR_RECTS:
+			elementSize = sizeof(GraphicsCommandList::Rect);
+			maxCounts[0U] = GraphicsCommandList::sMaxViewportCount;
+			arrayCount = 1U;
+			break;
+		case CommandStream::SET_RENDER_TARGETS:
+			fixedSize = sizeof(std::uint32_t) + sizeof(std::uint8_t);
+			elementSize = sizeof(GraphicsCommandList::CpuDescriptorHandle);
+			maxCounts[0U] = GraphicsCommandList::sMaxRenderTargetCount;
+			maxCounts[1U] = 1U;
+			arrayCount = 2U;
+			break;
+		case CommandStream::RESOURCE_BARRIER:
+			elementSize = sizeof(GraphicsCommandList::Barrier);
+			maxCounts[0U] = sMaxBarrierCount;
+			arrayCount = 1U;
+			break;
+		case CommandStream::DRAW_INDEXED_INSTANCED:
+			fixedSize = sizeof(std::uint32_t) * 5UL;
+			break;
+		case CommandStream::BEGIN_FRAME: {
+			std::uint32_t size{ 0U };
+			return reader.Read(size) && reader.Skip(size);
+		}
+		case CommandStream::CLOSE_COMMAND_LIST:
+			break;
+		default:
+			return false;
+		}
+
+		if (reader.Skip(fixedSize) == false) {
+			return false;
+		}
+		for (std::uint32_t i = 0U; i < arrayCount; ++i) {
+			std::uint32_t count{ 0U };
+			std::uint8_t hasData{ 0U };
+			if (reader.Read(count) == false || reader.Read(hasData) == false) {
+				return false;
+			}
+			if (hasData != 0U && (count > maxCounts[i] || reader.Skip(count * elementSize) == false)) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+}
+
+void CommandStream::BeginFrame(const void* frameCBuffer, const std::uint32_t size) noexcept {
+	ASSERT(frameCBuffer != nullptr || size == 0U);
+	WriteRecordType(BEGIN_FRAME);
+	Write(size);
+	WriteBytes(frameCBuffer, size);
+}
+
+void CommandStream::CloseCommandList() noexcept {
+	WriteRecordType(CLOSE_COMMAND_LIST);
+}
+
+void CommandStream::ExecuteCommandLists(const std::uint32_t cmdListCount) noexcept {
+	WriteRecordType(EXECUTE_COMMAND_LISTS);
+	Write(cmdListCount);
+}
+
+void CommandStream::WriteRecordType(const RecordType type) noexcept {
+	ASSERT(type < RECORD_TYPE_COUNT);
+	mData.push_back(type);
+}
+
+void CommandStream::WriteBytes(const void* data, const std::size_t size) noexcept {
+	if (size > 0UL) {
+		ASSERT(data != nullptr);
+		const std::size_t offset{ mData.size() };
+		mData.resize(offset + size);
+		memcpy(mData.data() + offset, data, size);
+	}
+}
+
+bool CommandStream::Replay(GraphicsCommandList& cmdList, ReplayStats& stats) const noexcept {
+	Reader reader(mData);
+
+	// Arrays of the current command
+	std::uint64_t heapAddresses[sMaxDescriptorHeapCount];
+	ID3D12DescriptorHeap* heaps[sMaxDescriptorHeapCount];
+	GraphicsCommandList::VertexBufferView vertexBufferViews[GraphicsCommandList::sMaxVertexBufferCount];
+	GraphicsCommandList::Viewport viewports[GraphicsCommandList::sMaxViewportCount];
+	GraphicsCommandList::Rect rects[GraphicsCommandList::sMaxViewportCount];
+	GraphicsCommandList::CpuDescriptorHandle renderTargets[GraphicsCommandList::sMaxRenderTargetCount];
+	std::vector<GraphicsCommandList::Barrier> barriers(sMaxBarrierCount);
+
+	while (reader.IsAtEnd() == false) {
+		std::uint8_t type{ RECORD_TYPE_COUNT };
+		if (reader.Read(type) == false) {
+			return false;
+		}
+
+		switch (type) {
+		case SET_PIPELINE_STATE:
+		case SET_ROOT_SIGNATURE: {
+			std::uint64_t address{ 0UL };
+			if (reader.Read(address) == false) {
+				return false;
+			}
+			if (type == SET_PIPELINE_STATE) {
+				cmdList.SetPipelineState(ToObject<ID3D12PipelineState>(address));
+			}
+			else {
+				cmdList.SetGraphicsRootSignature(ToObject<ID3D12RootSignature>(address));
+			}
+			break;
+		}
+		case SET_DESCRIPTOR_HEAPS: {
+			std::uint32_t count{ 0U };
+			const std::uint64_t* addresses{ nullptr };
+			if (reader.ReadArray(heapAddresses, sMaxDescriptorHeapCount, count, addresses) == false) {
+				return false;
+			}
+			if (addresses != nullptr) {
+				for (std::uint32_t i = 0U; i < count; ++i) {
+					heaps[i] = ToObject<ID3D12DescriptorHeap>(addresses[i]);
+				}
+			}
+			cmdList.SetDescriptorHeaps(count, addresses != nullptr ? heaps : nullptr);
+			break;
+		}
+		case SET_ROOT_CONSTANT_BUFFER_VIEW:
+		case SET_ROOT_SHADER_RESOURCE_VIEW:
+		case SET_ROOT_DESCRIPTOR_TABLE: {
+			std::uint32_t rootParameterIndex{ 0U };
+			std::uint64_t address{ 0UL };
+			if (reader.Read(rootParameterIndex) == false || reader.Read(address) == false) {
+				return false;
+			}
+			if (type == SET_ROOT_CONSTANT_BUFFER_VIEW) {
+				cmdList.SetGraphicsRootConstantBufferView(rootParameterIndex, address);
+			}
+			else if (type == SET_ROOT_SHADER_RESOURCE_VIEW) {
+				cmdList.SetGraphicsRootShaderResourceView(rootParameterIndex, address);
+			}
+			else {
+				cmdList.SetGraphicsRootDescriptorTable(rootParameterIndex, address);
+			}
+			break;
+		}
+		case SET_ROOT_CONSTANT: {
+			std::uint32_t values[3U];
+			if (reader.Read(values) == false) {
+				return false;
+			}
+			cmdList.SetGraphicsRoot32BitConstant(values[0U], values[1U], values[2U]);
+			break;
+		}
+		case SET_PRIMITIVE_TOPOLOGY: {
+			std::uint32_t topology{ 0U };
+			if (reader.Read(topology) == false) {
+				return false;
+			}
+			cmdList.IASetPrimitiveTopology(topology);
+			break;
+		}
+		case SET_VERTEX_BUFFERS: {
+			std::uint32_t startSlot{ 0U };
+			std::uint32_t count{ 0U };
+			const GraphicsCommandList::VertexBufferView* views{ nullptr };
+			if (reader.Read(startSlot) == false ||
+				reader.ReadArray(vertexBufferViews, GraphicsCommandList::sMaxVertexBufferCount, count, views) == false) {
+				return false;
+			}
+			cmdList.IASetVertexBuffers(startSlot, count, views);
+			break;
+		}
+		case SET_INDEX_BUFFER: {
+			std::uint32_t count{ 0U };
+			GraphicsCommandList::IndexBufferView viewElement;
+			const GraphicsCommandList::IndexBufferView* view{ nullptr };
+			if (reader.ReadArray(&viewElement, 1UL, count, view) == false) {
+				return false;
+			}
+			cmdList.IASetIndexBuffer(view);
+			break;
+		}
+		case SET_VIEWPORTS: {
+			std::uint32_t count{ 0U };
+			const GraphicsCommandList::Viewport* data{ nullptr };
+			if (reader.ReadArray(viewports, GraphicsCommandList::sMaxViewportCount, count, data) == false) {
+				return false;
+			}
+			cmdList.RSSetViewports(count, data);
+			break;
+		}
+		case SET_SCISSOR_RECTS: {
+			std::uint32_t count{ 0U };
+			const GraphicsCommandList::Rect* data{ nullptr };
+			if (reader.ReadArray(rects, GraphicsCommandList::sMaxViewportCount, count, data) == false) {
+				return false;
+			}
+			cmdList.RSSetScissorRects(count, data);
+			break;
+		}
+		case SET_RENDER_TARGETS: {
+			std::uint32_t renderTargetCount{ 0U };
+			std::uint8_t singleHandle{ 0U };
+			std::uint32_t count{ 0U };
+			const GraphicsCommandList::CpuDescriptorHandle* data{ nullptr };
+			std::uint32_t depthStencilCount{ 0U };
+			GraphicsCommandList::CpuDescriptorHandle depthStencilElement;
+			const GraphicsCommandList::CpuDescriptorHandle* depthStencil{ nullptr };
+			if (reader.Read(renderTargetCount) == false ||
+				reader.Read(singleHandle) == false ||
+				reader.ReadArray(renderTargets, GraphicsCommandList::sMaxRenderTargetCount, count, data) == false ||
+				reader.ReadArray(&depthStencilElement, 1UL, depthStencilCount, depthStencil) == false) {
+				return false;
+			}
+			cmdList.OMSetRenderTargets(renderTargetCount, data, singleHandle != 0U, depthStencil);
+			break;
+		}
+		case RESOURCE_BARRIER: {
+			std::uint32_t count{ 0U };
+			const GraphicsCommandList::Barrier* data{ nullptr };
+			if (reader.ReadArray(barriers.data(), barriers.size(), count, data) == false) {
+				return false;
+			}
+			cmdList.ResourceBarrier(count, data);
+			break;
+		}
+		case DRAW_INDEXED_INSTANCED: {
+			std::uint32_t values[5U];
+			if (reader.Read(values) == false) {
+				return false;
+			}
+			cmdList.DrawIndexedInstanced(values[0U], values[1U], values[2U], static_cast<std::int32_t>(values[3U]), values[4U]);
+			++stats.mDrawCount;
+			break;
+		}
+		case BEGIN_FRAME: {
+			std::uint32_t size{ 0U };
+			if (reader.Read(size) == false || reader.Skip(size) == false) {
+				return false;
+			}
+			++stats.mFrameCount;
+			continue;
+		}
+		case CLOSE_COMMAND_LIST:
+			++stats.mCmdListCount;
+			continue;
+		case EXECUTE_COMMAND_LISTS: {
+			std::uint32_t cmdListCount{ 0U };
+			if (reader.Read(cmdListCount) == false) {
+				return false;
+			}
+			++stats.mExecuteCount;
+			continue;
+		}
+		default:
+			return false;
+		}
+
+		++stats.mCommandCount;
+	}
+
+	return true;
+}
+
+const void* CommandStream::FrameCBuffer(const std::uint32_t frameIndex, std::uint32_t& size) const noexcept {
+	// Frames are not indexed, so we walk records by their sizes.
+	Reader reader(mData);
+	std::uint32_t currentFrameIndex{ 0U };
+	while (reader.IsAtEnd() == false) {
+		std::uint8_t type{ RECORD_TYPE_COUNT };
+		if (reader.Read(type) == false) {
+			return nullptr;
+		}
+
+		if (type == BEGIN_FRAME) {
+			if (reader.Read(size) == false) {
+				return nullptr;
+			}
+			const std::uint8_t* data{ reader.Current() };
+			if (reader.Skip(size) == false) {
+				return nullptr;
+			}
+			if (currentFrameIndex == frameIndex) {
+				return data;
+			}
+			++currentFrameIndex;
+			continue;
+		}
+
+		if (SkipRecord(reader, type) == false) {
+			return nullptr;
+		}
+	}
+
+	return nullptr;
+}
+
+bool CommandStream::Save(const char* filename) const noexcept {
+	ASSERT(filename != nullptr);
+
+	std::ofstream fout{ filename, std::ios::binary | std::ios::trunc };
+	if (fout.is_open() == false) {
+		return false;
+	}
+
+	FileHeader header;
+	header.mDataSize = mData.size();
+	fout.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	fout.write(reinterpret_cast<const char*>(mData.data()), mData.size());
+
+	return fout.good();
+}
+
+bool CommandStream::Load(const char* filename) noexcept {
+	ASSERT(filename != nullptr);
+
+	mData.clear();
+
+	std::ifstream fin{ filename, std::ios::binary };
+	if (fin.is_open() == false) {
+		return false;
+	}
+
+	FileHeader header;
+	header.mMagic = 0U;
+	fin.read(reinterpret_cast<char*>(&header), sizeof(header));
+	if (fin.good() == false || header.mMagic != sFileMagic || header.mVersion != sFileVersion) {
+		return false;
+	}
+
+	mData.resize(static_cast<std::size_t>(header.mDataSize));
+	fin.read(reinterpret_cast<char*>(mData.data()), mData.size());
+	if (fin.good() == false) {
+		mData.clear();
+		return false;
+	}
+
+	if (IsValid() == false) {
+		mData.clear();
+		return false;
+	}
+
+	return true;
+}
+
+bool CommandStream::IsValid() const noexcept {
+	Reader reader(mData);
+	while (reader.IsAtEnd() == false) {
+		std::uint8_t type{ RECORD_TYPE_COUNT };
+		if (reader.Read(type) == false || SkipRecord(reader, type) == false) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void CommandStream::Clear() noexcept {
+	mData.clear();
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <CommandManager/GraphicsCommandList.h>
+#include <Utils/ForceInline.h>
+
+// Compact binary stream of GraphicsCommandList commands, written by CaptureCommandList.
+// Besides commands, it stores frame boundaries (with the frame constant buffer data),
+// command list closes and ExecuteCommandLists boundaries.
+// Each record is a type byte followed by its arguments (arrays are stored with their count).
+// Objects (pipeline states, root signatures, heaps, resources) are stored as addresses,
+// so a capture can only be replayed against a D3D12 backend in the process that captured it.
+// Any capture can be replayed against a NullCommandList.
+// Steps:
+// - Record commands through a CaptureCommandList, and call BeginFrame(), CloseCommandList()
+// and ExecuteCommandLists() at the same points the captured code does it.
+// - Save() it, or Load() a saved one.
+// - Call Replay() to re-issue its commands to any backend.
+class CommandStream {
+public:
+	enum RecordType : std::uint8_t {
+		SET_PIPELINE_STATE = 0U,
+		SET_ROOT_SIGNATURE,
+		SET_DESCRIPTOR_HEAPS,
+		SET_ROOT_CONSTANT_BUFFER_VIEW,
+		SET_ROOT_SHADER_RESOURCE_VIEW,
+		SET_ROOT_DESCRIPTOR_TABLE,
+		SET_ROOT_CONSTANT,
+		SET_PRIMITIVE_TOPOLOGY,
+		SET_VERTEX_BUFFERS,
+		SET_INDEX_BUFFER,
+		SET_VIEWPORTS,
+		SET_SCISSOR_RECTS,
+		SET_RENDER_TARGETS,
+		RESOURCE_BARRIER,
+		DRAW_INDEXED_INSTANCED,
+		BEGIN_FRAME,
+		CLOSE_COMMAND_LIST,
+		EXECUTE_COMMAND_LISTS,
+		RECORD_TYPE_COUNT
+	};
+
+	// Counters of a replay
+	struct ReplayStats {
+		std::uint32_t mFrameCount{ 0U };
+		std::uint32_t mCmdListCount{ 0U };
+		std::uint32_t mExecuteCount{ 0U };
+		std::uint32_t mCommandCount{ 0U };
+		std::uint32_t mDrawCount{ 0U };
+	};
+
+	CommandStream() = default;
+	~CommandStream() = default;
+	CommandStream(const CommandStream&) = delete;
+	const CommandStream& operator=(const CommandStream&) = delete;
+	CommandStream(CommandStream&&) = delete;
+	CommandStream& operator=(CommandStream&&) = delete;
+
+	// Frame boundary. frameCBuffer is the frame constant buffer data (it can be nullptr if size is 0).
+	void BeginFrame(const void* frameCBuffer, const std::uint32_t size) noexcept;
+
+	// Command list boundaries: the current command list is closed, and
+	// the last cmdListCount closed command lists are executed.
+	void CloseCommandList() noexcept;
+	void ExecuteCommandLists(const std::uint32_t cmdListCount) noexcept;
+
+	// Used by CaptureCommandList to write records
+	void WriteRecordType(const RecordType type) noexcept;
+	void WriteBytes(const void* data, const std::size_t size) noexcept;
+
+	template<typename T>
+	__forceinline void Write(const T& value) noexcept { WriteBytes(&value, sizeof(T)); }
+
+	// Re-issues all commands to cmdList and adds counters to stats.
+	// Boundaries are not commands, they are only counted.
+	// Returns false if the stream is corrupted (commands before the corrupted record are re-issued)
+	bool Replay(GraphicsCommandList& cmdList, ReplayStats& stats) const noexcept;
+
+	// Frame constant buffer data of the frameIndex-th frame. Returns nullptr if there is no such frame.
+	const void* FrameCBuffer(const std::uint32_t frameIndex, std::uint32_t& size) const noexcept;
+
+	// Returns false if the file can not be written/read or it is not a valid capture.
+	// Load() rejects truncated files and streams that are not IsValid() (and leaves it empty).
+	bool Save(const char* filename) const noexcept;
+	bool Load(const char* filename) noexcept;
+
+	// Returns true if all records are complete, of a known type, and their arrays
+	// are not larger than Replay() accepts (so Replay() of it does not fail).
+	bool IsValid() const noexcept;
+
+	void Clear() noexcept;
+
+	__forceinline const std::vector<std::uint8_t>& Data() const noexcept { return mData; }
+	__forceinline std::size_t Size() const noexcept { return mData.size(); }
+
+private:
+	// Saved files begin with it
+	struct FileHeader {
+		std::uint32_t mMagic{ sFileMagic };
+		std::uint32_t mVersion{ sFileVersion };
+		std::uint64_t mDataSize{ 0UL };
+	};
+
+	static const std::uint32_t sFileMagic{ 0x53434D43U }; // 'CMCS'
+	static const std::uint32_t sFileVersion{ 1U };
+
+	std::vector<std::uint8_t> mData;
+};
@@ -0,0 +1,56 @@
+#include "CommandStreamReplay.h"
+
+#include <chrono>
+#include <fstream>
+
+#include <Utils/DebugUtils.h>
+
+namespace CommandStreamReplay {
+	void Run(
+		const CommandStream& stream,
+		GraphicsCommandList& cmdList,
+		const std::uint32_t repeatCount,
+		Result& result) noexcept
+	{
+		ASSERT(repeatCount > 0U);
+
+		result = Result();
+		const std::chrono::high_resolution_clock::time_point begin{ std::chrono::high_resolution_clock::now() };
+		for (std::uint32_t i = 0U; i < repeatCount; ++i) {
+			if (stream.Replay(cmdList, result.mStats) == false) {
+				result.mIsValid = false;
+				break;
+			}
+			++result.mRepeatCount;
+		}
+		const std::chrono::high_resolution_clock::time_point end{ std::chrono::high_resolution_clock::now() };
+		result.mSeconds = std::chrono::duration<double>(end - begin).count();
+	}
+
+	bool WriteReport(const char* filename, const Result& result) noexcept {
+		ASSERT(filename != nullptr);
+
+		std::ofstream fout{ filename, std::ios::trunc };
+		if (fout.is_open() == false) {
+			return false;
+		}
+
+		const CommandStream::ReplayStats& stats(result.mStats);
+		const double repeatCount{ result.mRepeatCount > 0U ? static_cast<double>(result.mRepeatCount) : 1.0 };
+		fout << "valid: " << (result.mIsValid ? "yes" : "no") << "\n";
+		fout << "repetitions: " << result.mRepeatCount << "\n";
+		fout << "frames: " << stats.mFrameCount / repeatCount << "\n";
+		fout << "command lists: " << stats.mCmdListCount / repeatCount << "\n";
+		fout << "executes: " << stats.mExecuteCount / repeatCount << "\n";
+		fout << "commands: " << stats.mCommandCount / repeatCount << "\n";
+		fout << "draws: " << stats.mDrawCount / repeatCount << "\n";
+		fout << "seconds: " << result.mSeconds << "\n";
+		if (result.mSeconds > 0.0) {
+			fout << "ms per repetition: " << result.mSeconds * 1000.0 / repeatCount << "\n";
+			fout << "commands per second: " << stats.mCommandCount / result.mSeconds << "\n";
+			fout << "draws per second: " << stats.mDrawCount / result.mSeconds << "\n";
+		}
+
+		return fout.good();
+	}
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <CommandManager/CommandStream.h>
+
+class GraphicsCommandList;
+
+// Replays captured command streams at maximum speed, to measure
+// submission overhead and compare captures of different engine versions.
+namespace CommandStreamReplay {
+	struct Result {
+		// Counters of all repetitions
+		CommandStream::ReplayStats mStats;
+		std::uint32_t mRepeatCount{ 0U };
+		double mSeconds{ 0.0 };
+		// False if the stream is corrupted
+		bool mIsValid{ true };
+	};
+
+	// Replays stream repeatCount times against cmdList (of any backend).
+	// Commands are not validated here, cmdList backend does it (if it does).
+	void Run(
+		const CommandStream& stream,
+		GraphicsCommandList& cmdList,
+		const std::uint32_t repeatCount,
+		Result& result) noexcept;
+
+	// Writes a text report with counters per frame and throughput.
+	// Returns false if the file can not be written.
+	bool WriteReport(const char* filename, const Result& result) noexcept;
+}
@@ -0,0 +1,111 @@
+#include "D3D12CommandList.h"
+
+#include <cstddef>
+
+#include <Utils/RenderStats.h>
+
+// Portable arguments are forwarded as D3D12 ones, so they must have the same layout
+static_assert(sizeof(GraphicsCommandList::VertexBufferView) == sizeof(D3D12_VERTEX_BUFFER_VIEW), "Vertex buffer view layout mismatch");
+static_assert(offsetof(GraphicsCommandList::VertexBufferView, mSizeInBytes) == offsetof(D3D12_VERTEX_BUFFER_VIEW, SizeInBytes), "Vertex buffer view layout mismatch");
+static_assert(offsetof(GraphicsCommandList::VertexBufferView, mStrideInBytes) == offsetof(D3D12_VERTEX_BUFFER_VIEW, StrideInBytes), "Vertex buffer view layout mismatch");
+static_assert(sizeof(GraphicsCommandList::IndexBufferView) == sizeof(D3D12_INDEX_BUFFER_VIEW), "Index buffer view layout mismatch");
+static_assert(offsetof(GraphicsCommandList::IndexBufferView, mFormat) == offsetof(D3D12_INDEX_BUFFER_VIEW, Format), "Index buffer view layout mismatch");
+static_assert(sizeof(GraphicsCommandList::Viewport) == sizeof(D3D12_VIEWPORT), "Viewport layout mismatch");
+static_assert(sizeof(GraphicsCommandList::Rect) == sizeof(D3D12_RECT), "Rect layout mismatch");
+static_assert(sizeof(GraphicsCommandList::CpuDescriptorHandle) == sizeof(D3D12_CPU_DESCRIPTOR_HANDLE), "CPU descriptor handle layout mismatch");
+static_assert(sizeof(GraphicsCommandList::Barrier) == sizeof(D3D12_RESOURCE_BARRIER), "Resource barrier layout mismatch");
+static_assert(offsetof(GraphicsCommandList::Barrier, mResource) == offsetof(D3D12_RESOURCE_BARRIER, Transition.pResource), "Resource barrier layout mismatch");
+static_assert(offsetof(GraphicsCommandList::Barrier, mStateAfter) == offsetof(D3D12_RESOURCE_BARRIER, Transition.StateAfter), "Resource barrier layout mismatch");
+static_assert(GraphicsCommandList::sPrimitiveTopologyTriangleList == D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST, "Primitive topology mismatch");
+static_assert(GraphicsCommandList::sIndexFormatR16 == DXGI_FORMAT_R16_UINT, "Index format mismatch");
+static_assert(GraphicsCommandList::sIndexFormatR32 == DXGI_FORMAT_R32_UINT, "Index format mismatch");
+static_assert(GraphicsCommandList::sMaxVertexBufferCount == D3D12_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT, "Vertex buffer count mismatch");
+static_assert(GraphicsCommandList::sMaxViewportCount == D3D12_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE, "Viewport count mismatch");
+static_assert(GraphicsCommandList::sMaxRenderTargetCount == D3D12_SIMULTANEOUS_RENDER_TARGET_COUNT, "Render target count mismatch");
+
+D3D12CommandList::D3D12CommandList(ID3D12GraphicsCommandList& cmdList)
+	: mCmdList(cmdList)
+{
+}
+
+void D3D12CommandList::SetPipelineState(ID3D12PipelineState* pipelineState) noexcept {
+	RENDER_STATS_ADD(PIPELINE_STATE_CHANGES, 1UL);
+	mCmdList.SetPipelineState(pipelineState);
+}
+
+void D3D12CommandList::SetGraphicsRootSignature(ID3D12RootSignature* rootSignature) noexcept {
+	RENDER_STATS_ADD(ROOT_SIGNATURE_CHANGES, 1UL);
+	mCmdList.SetGraphicsRootSignature(rootSignature);
+}
+
+void D3D12CommandList::SetDescriptorHeaps(const std::uint32_t numDescriptorHeaps, ID3D12DescriptorHeap* const* descriptorHeaps) noexcept {
+	mCmdList.SetDescriptorHeaps(numDescriptorHeaps, descriptorHeaps);
+}
+
+void D3D12CommandList::SetGraphicsRootConstantBufferView(const std::uint32_t rootParameterIndex, const std::uint64_t bufferLocation) noexcept {
+	mCmdList.SetGraphicsRootConstantBufferView(rootParameterIndex, bufferLocation);
+}
+
+void D3D12CommandList::SetGraphicsRootShaderResourceView(const std::uint32_t rootParameterIndex, const std::uint64_t bufferLocation) noexcept {
+	mCmdList.SetGraphicsRootShaderResourceView(rootParameterIndex, bufferLocation);
+}
+
+void D3D12CommandList::SetGraphicsRootDescriptorTable(const std::uint32_t rootParameterIndex, const std::uint64_t baseDescriptor) noexcept {
+	RENDER_STATS_ADD(DESCRIPTOR_TABLES, 1UL);
+	D3D12_GPU_DESCRIPTOR_HANDLE descriptor;
+	descriptor.ptr = baseDescriptor;
+	mCmdList.SetGraphicsRootDescriptorTable(rootParameterIndex, descriptor);
+}
+
+void D3D12CommandList::SetGraphicsRoot32BitConstant(const std::uint32_t rootParameterIndex, const std::uint32_t srcData, const std::uint32_t destOffsetIn32BitValues) noexcept {
+	mCmdList.SetGraphicsRoot32BitConstant(rootParameterIndex, srcData, destOffsetIn32BitValues);
+}
+
+void D3D12CommandList::IASetPrimitiveTopology(const std::uint32_t primitiveTopology) noexcept {
+	mCmdList.IASetPrimitiveTopology(static_cast<D3D12_PRIMITIVE_TOPOLOGY>(primitiveTopology));
+}
+
+void D3D12CommandList::IASetVertexBuffers(const std::uint32_t startSlot, const std::uint32_t numViews, const VertexBufferView* views) noexcept {
+	mCmdList.IASetVertexBuffers(startSlot, numViews, reinterpret_cast<const D3D12_VERTEX_BUFFER_VIEW*>(views));
+}
+
+void D3D12CommandList::IASetIndexBuffer(const IndexBufferView* view) noexcept {
+	mCmdList.IASetIndexBuffer(reinterpret_cast<const D3D12_INDEX_BUFFER_VIEW*>(view));
+}
+
+void D3D12CommandList::RSSetViewports(const std::uint32_t numViewports, const Viewport* viewports) noexcept {
+	mCmdList.RSSetViewports(numViewports, reinterpret_cast<const D3D12_VIEWPORT*>(viewports));
+}
+
+void D3D12CommandList::RSSetScissorRects(const std::uint32_t numRects, const Rect* rects) noexcept {
+	mCmdList.RSSetScissorRects(numRects, reinterpret_cast<const D3D12_RECT*>(rects));
+}
+
+void D3D12CommandList::OMSetRenderTargets(
+	const std::uint32_t numRenderTargetDescriptors,
+	const CpuDescriptorHandle* renderTargetDescriptors,
+	const bool rtsSingleHandleToDescriptorRange,
+	const CpuDescriptorHandle* depthStencilDescriptor) noexcept 
+{
+	mCmdList.OMSetRenderTargets(
+		numRenderTargetDescriptors,
+		reinterpret_cast<const D3D12_CPU_DESCRIPTOR_HANDLE*>(renderTargetDescriptors),
+		rtsSingleHandleToDescriptorRange,
+		reinterpret_cast<const D3D12_CPU_DESCRIPTOR_HANDLE*>(depthStencilDescriptor));
+}
+
+void D3D12CommandList::ResourceBarrier(const std::uint32_t numBarriers, const Barrier* barriers) noexcept {
+	RENDER_STATS_ADD(RESOURCE_BARRIERS, numBarriers);
+	mCmdList.ResourceBarrier(numBarriers, reinterpret_cast<const D3D12_RESOURCE_BARRIER*>(barriers));
+}
+
+void D3D12CommandList::DrawIndexedInstanced(
+	const std::uint32_t indexCountPerInstance,
+	const std::uint32_t instanceCount,
+	const std::uint32_t startIndexLocation,
+	const std::int32_t baseVertexLocation,
+	const std::uint32_t startInstanceLocation) noexcept 
+{
+	RENDER_STATS_DRAW(indexCountPerInstance, instanceCount);
+	mCmdList.DrawIndexedInstanced(indexCountPerInstance, instanceCount, startIndexLocation, baseVertexLocation, startInstanceLocation);
+}
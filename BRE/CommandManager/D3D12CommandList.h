@@ -0,0 +1,61 @@
+#pragma once
+
+#include <d3d12.h>
+
+#include <CommandManager/GraphicsCommandList.h>
+
+// GraphicsCommandList backend that forwards commands to an ID3D12GraphicsCommandList
+// (draws, state changes and barriers are added to RenderStats counters).
+// Portable arguments have the layout of D3D12 ones, so they are forwarded without copies.
+class D3D12CommandList : public GraphicsCommandList {
+public:
+	// D3D12 arguments as GraphicsCommandList ones
+	static __forceinline const VertexBufferView* ToPortable(const D3D12_VERTEX_BUFFER_VIEW* views) noexcept { return reinterpret_cast<const VertexBufferView*>(views); }
+	static __forceinline const IndexBufferView* ToPortable(const D3D12_INDEX_BUFFER_VIEW* view) noexcept { return reinterpret_cast<const IndexBufferView*>(view); }
+	static __forceinline const Viewport* ToPortable(const D3D12_VIEWPORT* viewports) noexcept { return reinterpret_cast<const Viewport*>(viewports); }
+	static __forceinline const Rect* ToPortable(const D3D12_RECT* rects) noexcept { return reinterpret_cast<const Rect*>(rects); }
+	static __forceinline const CpuDescriptorHandle* ToPortable(const D3D12_CPU_DESCRIPTOR_HANDLE* descriptors) noexcept { return reinterpret_cast<const CpuDescriptorHandle*>(descriptors); }
+	static __forceinline const Barrier* ToPortable(const D3D12_RESOURCE_BARRIER* barriers) noexcept { return reinterpret_cast<const Barrier*>(barriers); }
+
+	explicit D3D12CommandList(ID3D12GraphicsCommandList& cmdList);
+	~D3D12CommandList() = default;
+	D3D12CommandList(const D3D12CommandList&) = delete;
+	const D3D12CommandList& operator=(const D3D12CommandList&) = delete;
+	D3D12CommandList(D3D12CommandList&&) = delete;
+	D3D12CommandList& operator=(D3D12CommandList&&) = delete;
+
+	void SetPipelineState(ID3D12PipelineState* pipelineState) noexcept final override;
+	void SetGraphicsRootSignature(ID3D12RootSignature* rootSignature) noexcept final override;
+	void SetDescriptorHeaps(const std::uint32_t numDescriptorHeaps, ID3D12DescriptorHeap* const* descriptorHeaps) noexcept final override;
+
+	void SetGraphicsRootConstantBufferView(const std::uint32_t rootParameterIndex, const std::uint64_t bufferLocation) noexcept final override;
+	void SetGraphicsRootShaderResourceView(const std::uint32_t rootParameterIndex, const std::uint64_t bufferLocation) noexcept final override;
+	void SetGraphicsRootDescriptorTable(const std::uint32_t rootParameterIndex, const std::uint64_t baseDescriptor) noexcept final override;
+	void SetGraphicsRoot32BitConstant(const std::uint32_t rootParameterIndex, const std::uint32_t srcData, const std::uint32_t destOffsetIn32BitValues) noexcept final override;
+
+	void IASetPrimitiveTopology(const std::uint32_t primitiveTopology) noexcept final override;
+	void IASetVertexBuffers(const std::uint32_t startSlot, const std::uint32_t numViews, const VertexBufferView* views) noexcept final override;
+	void IASetIndexBuffer(const IndexBufferView* view) noexcept final override;
+
+	void RSSetViewports(const std::uint32_t numViewports, const Viewport* viewports) noexcept final override;
+	void RSSetScissorRects(const std::uint32_t numRects, const Rect* rects) noexcept final override;
+	void OMSetRenderTargets(
+		const std::uint32_t numRenderTargetDescriptors,
+		const CpuDescriptorHandle* renderTargetDescriptors,
+		const bool rtsSingleHandleToDescriptorRange,
+		const CpuDescriptorHandle* depthStencilDescriptor) noexcept final override;
+
+	void ResourceBarrier(const std::uint32_t numBarriers, const Barrier* barriers) noexcept final override;
+
+	void DrawIndexedInstanced(
+		const std::uint32_t indexCountPerInstance,
+		const std::uint32_t instanceCount,
+		const std::uint32_t startIndexLocation,
+		const std::int32_t baseVertexLocation,
+		const std::uint32_t startInstanceLocation) noexcept final override;
+
+	__forceinline ID3D12GraphicsCommandList& CmdList() noexcept { return mCmdList; }
+
+private:
+	ID3D12GraphicsCommandList& mCmdList;
+};
@@ -0,0 +1,35 @@
+#include "D3D12CommandQueue.h"
+
+#include <Utils/DebugUtils.h>
+
+D3D12CommandQueue::D3D12CommandQueue(ID3D12CommandQueue& cmdQueue, ID3D12Fence& fence)
+	: mCmdQueue(cmdQueue)
+	, mFence(fence)
+	, mFenceEvent(CreateEventEx(nullptr, nullptr, false, EVENT_ALL_ACCESS))
+{
+	ASSERT(mFenceEvent != nullptr);
+}
+
+D3D12CommandQueue::~D3D12CommandQueue() {
+	CloseHandle(mFenceEvent);
+}
+
+void D3D12CommandQueue::ExecuteCommandLists(const std::uint32_t numCommandLists, ID3D12CommandList* const* commandLists) noexcept {
+	mCmdQueue.ExecuteCommandLists(numCommandLists, commandLists);
+}
+
+void D3D12CommandQueue::Signal(const std::uint64_t fenceValue) noexcept {
+	CHECK_HR(mCmdQueue.Signal(&mFence, fenceValue));
+}
+
+std::uint64_t D3D12CommandQueue::CompletedFenceValue() const noexcept {
+	return mFence.GetCompletedValue();
+}
+
+void D3D12CommandQueue::WaitForFenceValue(const std::uint64_t fenceValue) noexcept {
+	if (mFence.GetCompletedValue() < fenceValue) {
+		// Fire event when GPU hits the fence value, and wait until it is fired.
+		CHECK_HR(mFence.SetEventOnCompletion(fenceValue, mFenceEvent));
+		WaitForSingleObject(mFenceEvent, INFINITE);
+	}
+}
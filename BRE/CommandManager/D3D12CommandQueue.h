@@ -0,0 +1,32 @@
+#pragma once
+
+#include <d3d12.h>
+
+#include <CommandManager/CommandQueue.h>
+
+// CommandQueue backend that forwards command lists to an ID3D12CommandQueue
+// and signals and waits an ID3D12Fence.
+// WaitForFenceValue() must be called from a single thread at a time (it waits a single event).
+class D3D12CommandQueue : public CommandQueue {
+public:
+	explicit D3D12CommandQueue(ID3D12CommandQueue& cmdQueue, ID3D12Fence& fence);
+	~D3D12CommandQueue();
+	D3D12CommandQueue(const D3D12CommandQueue&) = delete;
+	const D3D12CommandQueue& operator=(const D3D12CommandQueue&) = delete;
+	D3D12CommandQueue(D3D12CommandQueue&&) = delete;
+	D3D12CommandQueue& operator=(D3D12CommandQueue&&) = delete;
+
+	void ExecuteCommandLists(const std::uint32_t numCommandLists, ID3D12CommandList* const* commandLists) noexcept final override;
+	void Signal(const std::uint64_t fenceValue) noexcept final override;
+	std::uint64_t CompletedFenceValue() const noexcept final override;
+	void WaitForFenceValue(const std::uint64_t fenceValue) noexcept final override;
+
+	__forceinline ID3D12CommandQueue& CmdQueue() noexcept { return mCmdQueue; }
+
+private:
+	ID3D12CommandQueue& mCmdQueue;
+	ID3D12Fence& mFence;
+
+	// Fired when the fence reaches the waited value
+	HANDLE mFenceEvent{ nullptr };
+};
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+struct ID3D12DescriptorHeap;
+struct ID3D12PipelineState;
+struct ID3D12Resource;
+struct ID3D12RootSignature;
+
+// Graphics command list interface used to record draws, so recording code does not depend
+// on a backend. Methods have the same names and parameters as ID3D12GraphicsCommandList ones,
+// but argument types are portable (it does not include D3D headers):
+// - Objects are forward declared D3D12 interfaces (they are only passed through).
+// - GPU virtual addresses and GPU descriptor handles are std::uint64_t.
+// - Structs have the layout of their D3D12 ones (D3D12CommandList checks it), so D3D12
+// arguments can be passed with D3D12CommandList::ToPortable().
+// Backends:
+// - D3D12CommandList: forwards to an ID3D12GraphicsCommandList.
+// - NullCommandList: validates, counts and stores commands in memory (it does not need a device).
+// - CaptureCommandList: writes commands to a CommandStream.
+// Reset() and Close() are not part of it, command lists are opened and closed by their owners.
+// Only geometry pass draw recording uses it. Other passes and resource creation use D3D12
+// objects directly. Submission and fences go through CommandQueue.
+class GraphicsCommandList {
+public:
+	// D3D12_VERTEX_BUFFER_VIEW
+	struct VertexBufferView {
+		std::uint64_t mBufferLocation{ 0UL };
+		std::uint32_t mSizeInBytes{ 0U };
+		std::uint32_t mStrideInBytes{ 0U };
+	};
+
+	// D3D12_INDEX_BUFFER_VIEW. Format is a DXGI_FORMAT.
+	struct IndexBufferView {
+		std::uint64_t mBufferLocation{ 0UL };
+		std::uint32_t mSizeInBytes{ 0U };
+		std::uint32_t mFormat{ 0U };
+	};
+
+	// D3D12_VIEWPORT
+	struct Viewport {
+		float mTopLeftX{ 0.0f };
+		float mTopLeftY{ 0.0f };
+		float mWidth{ 0.0f };
+		float mHeight{ 0.0f };
+		float mMinDepth{ 0.0f };
+		float mMaxDepth{ 0.0f };
+	};
+
+	// D3D12_RECT
+	struct Rect {
+		std::int32_t mLeft{ 0 };
+		std::int32_t mTop{ 0 };
+		std::int32_t mRight{ 0 };
+		std::int32_t mBottom{ 0 };
+	};
+
+	// D3D12_CPU_DESCRIPTOR_HANDLE
+	struct CpuDescriptorHandle {
+		std::size_t mPtr{ 0UL };
+	};
+
+	// D3D12_RESOURCE_BARRIER. Fields are the ones of transition barriers
+	// (type, flags and states are D3D12 enum values). Other barrier types
+	// have the same size, so they are passed through unchanged.
+	struct Barrier {
+		std::uint32_t mType{ 0U };
+		std::uint32_t mFlags{ 0U };
+		ID3D12Resource* mResource{ nullptr };
+		std::uint32_t mSubresource{ 0U };
+		std::uint32_t mStateBefore{ 0U };
+		std::uint32_t mStateAfter{ 0U };
+	};
+
+	// D3D12 values of the enums and limits used by backends
+	static const std::uint32_t sPrimitiveTopologyUndefined{ 0U }; // D3D_PRIMITIVE_TOPOLOGY_UNDEFINED
+	static const std::uint32_t sPrimitiveTopologyTriangleList{ 4U }; // D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST
+	static const std::uint32_t sIndexFormatR16{ 57U }; // DXGI_FORMAT_R16_UINT
+	static const std::uint32_t sIndexFormatR32{ 42U }; // DXGI_FORMAT_R32_UINT
+	static const std::uint32_t sResourceBarrierTypeTransition{ 0U }; // D3D12_RESOURCE_BARRIER_TYPE_TRANSITION
+	static const std::uint32_t sMaxVertexBufferCount{ 32U }; // D3D12_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT
+	static const std::uint32_t sMaxViewportCount{ 16U }; // D3D12_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE
+	static const std::uint32_t sMaxRenderTargetCount{ 8U }; // D3D12_SIMULTANEOUS_RENDER_TARGET_COUNT
+
+	GraphicsCommandList() = default;
+	virtual ~GraphicsCommandList() {}
+	GraphicsCommandList(const GraphicsCommandList&) = delete;
+	const GraphicsCommandList& operator=(const GraphicsCommandList&) = delete;
+	GraphicsCommandList(GraphicsCommandList&&) = delete;
+	GraphicsCommandList& operator=(GraphicsCommandList&&) = delete;
+
+	virtual void SetPipelineState(ID3D12PipelineState* pipelineState) noexcept = 0;
+	virtual void SetGraphicsRootSignature(ID3D12RootSignature* rootSignature) noexcept = 0;
+	virtual void SetDescriptorHeaps(const std::uint32_t numDescriptorHeaps, ID3D12DescriptorHeap* const* descriptorHeaps) noexcept = 0;
+
+	virtual void SetGraphicsRootConstantBufferView(const std::uint32_t rootParameterIndex, const std::uint64_t bufferLocation) noexcept = 0;
+	virtual void SetGraphicsRootShaderResourceView(const std::uint32_t rootParameterIndex, const std::uint64_t bufferLocation) noexcept = 0;
+	virtual void SetGraphicsRootDescriptorTable(const std::uint32_t rootParameterIndex, const std::uint64_t baseDescriptor) noexcept = 0;
+	virtual void SetGraphicsRoot32BitConstant(const std::uint32_t rootParameterIndex, const std::uint32_t srcData, const std::uint32_t destOffsetIn32BitValues) noexcept = 0;
+
+	virtual void IASetPrimitiveTopology(const std::uint32_t primitiveTopology) noexcept = 0;
+	virtual void IASetVertexBuffers(const std::uint32_t startSlot, const std::uint32_t numViews, const VertexBufferView* views) noexcept = 0;
+	virtual void IASetIndexBuffer(const IndexBufferView* view) noexcept = 0;
+
+	virtual void RSSetViewports(const std::uint32_t numViewports, const Viewport* viewports) noexcept = 0;
+	virtual void RSSetScissorRects(const std::uint32_t numRects, const Rect* rects) noexcept = 0;
+	virtual void OMSetRenderTargets(
+		const std::uint32_t numRenderTargetDescriptors,
+		const CpuDescriptorHandle* renderTargetDescriptors,
+		const bool rtsSingleHandleToDescriptorRange,
+		const CpuDescriptorHandle* depthStencilDescriptor) noexcept = 0;
+
+	virtual void ResourceBarrier(const std::uint32_t numBarriers, const Barrier* barriers) noexcept = 0;
+
+	virtual void DrawIndexedInstanced(
+		const std::uint32_t indexCountPerInstance,
+		const std::uint32_t instanceCount,
+		const std::uint32_t startIndexLocation,
+		const std::int32_t baseVertexLocation,
+		const std::uint32_t startInstanceLocation) noexcept = 0;
+};
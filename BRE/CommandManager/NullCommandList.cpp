@@ -0,0 +1,207 @@
+#include "NullCommandList.h"
+
+#include <Utils/DebugUtils.h>
+
+namespace {
+	std::uint64_t ToAddress(const void* object) noexcept {
+		return static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(object));
+	}
+}
+
+void NullCommandList::SetPipelineState(ID3D12PipelineState* pipelineState) noexcept {
+	Command& command(Record(SET_PIPELINE_STATE, pipelineState != nullptr));
+	command.mAddress = ToAddress(pipelineState);
+	mHasPipelineState = pipelineState != nullptr;
+}
+
+void NullCommandList::SetGraphicsRootSignature(ID3D12RootSignature* rootSignature) noexcept {
+	Command& command(Record(SET_ROOT_SIGNATURE, rootSignature != nullptr));
+	command.mAddress = ToAddress(rootSignature);
+	mHasRootSignature = rootSignature != nullptr;
+}
+
+void NullCommandList::SetDescriptorHeaps(const std::uint32_t numDescriptorHeaps, ID3D12DescriptorHeap* const* descriptorHeaps) noexcept {
+	// There are only 2 shader visible heap types (CBV/SRV/UAV and sampler)
+	const bool isValid{ numDescriptorHeaps > 0U && numDescriptorHeaps <= 2U && descriptorHeaps != nullptr && descriptorHeaps[0U] != nullptr };
+	Command& command(Record(SET_DESCRIPTOR_HEAPS, isValid));
+	command.mValues[0U] = numDescriptorHeaps;
+	command.mAddress = isValid ? ToAddress(descriptorHeaps[0U]) : 0UL;
+	mHasDescriptorHeaps = isValid;
+}
+
+void NullCommandList::SetGraphicsRootConstantBufferView(const std::uint32_t rootParameterIndex, const std::uint64_t bufferLocation) noexcept {
+	Command& command(Record(SET_ROOT_CONSTANT_BUFFER_VIEW, IsValidRootParameter(rootParameterIndex) && bufferLocation != 0UL));
+	command.mValues[0U] = rootParameterIndex;
+	command.mAddress = bufferLocation;
+}
+
+void NullCommandList::SetGraphicsRootShaderResourceView(const std::uint32_t rootParameterIndex, const std::uint64_t bufferLocation) noexcept {
+	Command& command(Record(SET_ROOT_SHADER_RESOURCE_VIEW, IsValidRootParameter(rootParameterIndex) && bufferLocation != 0UL));
+	command.mValues[0U] = rootParameterIndex;
+	command.mAddress = bufferLocation;
+}
+
+void NullCommandList::SetGraphicsRootDescriptorTable(const std::uint32_t rootParameterIndex, const std::uint64_t baseDescriptor) noexcept {
+	// Descriptor tables are offsets in the bound heaps
+	const bool isValid{ IsValidRootParameter(rootParameterIndex) && mHasDescriptorHeaps && baseDescriptor != 0UL };
+	Command& command(Record(SET_ROOT_DESCRIPTOR_TABLE, isValid));
+	command.mValues[0U] = rootParameterIndex;
+	command.mAddress = baseDescriptor;
+}
+
+void NullCommandList::SetGraphicsRoot32BitConstant(const std::uint32_t rootParameterIndex, const std::uint32_t srcData, const std::uint32_t destOffsetIn32BitValues) noexcept {
+	Command& command(Record(SET_ROOT_CONSTANT, IsValidRootParameter(rootParameterIndex) && destOffsetIn32BitValues < sMaxRootParameterCount));
+	command.mValues[0U] = rootParameterIndex;
+	command.mValues[1U] = srcData;
+	command.mValues[2U] = destOffsetIn32BitValues;
+}
+
+void NullCommandList::IASetPrimitiveTopology(const std::uint32_t primitiveTopology) noexcept {
+	const bool isValid{ primitiveTopology != sPrimitiveTopologyUndefined };
+	Command& command(Record(SET_PRIMITIVE_TOPOLOGY, isValid));
+	command.mValues[0U] = primitiveTopology;
+	mHasPrimitiveTopology = isValid;
+}
+
+void NullCommandList::IASetVertexBuffers(const std::uint32_t startSlot, const std::uint32_t numViews, const VertexBufferView* views) noexcept {
+	const bool isValid{ 
+		numViews > 0U && 
+		startSlot + numViews <= sMaxVertexBufferCount && 
+		views != nullptr && 
+		views[0U].mBufferLocation != 0UL && 
+		views[0U].mStrideInBytes > 0U };
+	Command& command(Record(SET_VERTEX_BUFFERS, isValid));
+	command.mValues[0U] = startSlot;
+	command.mValues[1U] = numViews;
+	if (views != nullptr) {
+		command.mValues[2U] = views[0U].mSizeInBytes;
+		command.mValues[3U] = views[0U].mStrideInBytes;
+		command.mAddress = views[0U].mBufferLocation;
+	}
+	mHasVertexBuffer = isValid;
+}
+
+void NullCommandList::IASetIndexBuffer(const IndexBufferView* view) noexcept {
+	const bool isValid{ 
+		view != nullptr && 
+		view->mBufferLocation != 0UL && 
+		(view->mFormat == sIndexFormatR16 || view->mFormat == sIndexFormatR32) };
+	Command& command(Record(SET_INDEX_BUFFER, isValid));
+	if (view != nullptr) {
+		command.mValues[0U] = view->mSizeInBytes;
+		command.mValues[1U] = view->mFormat;
+		command.mAddress = view->mBufferLocation;
+	}
+	mHasIndexBuffer = isValid;
+}
+
+void NullCommandList::RSSetViewports(const std::uint32_t numViewports, const Viewport* viewports) noexcept {
+	const bool isValid{ numViewports > 0U && numViewports <= sMaxViewportCount && viewports != nullptr };
+	Command& command(Record(SET_VIEWPORTS, isValid));
+	command.mValues[0U] = numViewports;
+	mHasViewport = isValid;
+}
+
+void NullCommandList::RSSetScissorRects(const std::uint32_t numRects, const Rect* rects) noexcept {
+	const bool isValid{ numRects > 0U && numRects <= sMaxViewportCount && rects != nullptr };
+	Command& command(Record(SET_SCISSOR_RECTS, isValid));
+	command.mValues[0U] = numRects;
+	mHasScissorRect = isValid;
+}
+
+void NullCommandList::OMSetRenderTargets(
+	const std::uint32_t numRenderTargetDescriptors,
+	const CpuDescriptorHandle* renderTargetDescriptors,
+	const bool rtsSingleHandleToDescriptorRange,
+	const CpuDescriptorHandle* depthStencilDescriptor) noexcept 
+{
+	const bool isValid{ 
+		numRenderTargetDescriptors <= sMaxRenderTargetCount &&
+		(numRenderTargetDescriptors == 0U || renderTargetDescriptors != nullptr) &&
+		(numRenderTargetDescriptors > 0U || depthStencilDescriptor != nullptr) };
+	Command& command(Record(SET_RENDER_TARGETS, isValid));
+	command.mValues[0U] = numRenderTargetDescriptors;
+	command.mValues[1U] = rtsSingleHandleToDescriptorRange ? 1U : 0U;
+	command.mValues[2U] = depthStencilDescriptor != nullptr ? 1U : 0U;
+	mHasRenderTargets = isValid;
+}
+
+void NullCommandList::ResourceBarrier(const std::uint32_t numBarriers, const Barrier* barriers) noexcept {
+	Command& command(Record(RESOURCE_BARRIER, numBarriers > 0U && barriers != nullptr));
+	command.mValues[0U] = numBarriers;
+	if (barriers != nullptr && numBarriers > 0U) {
+		command.mValues[1U] = barriers[0U].mType;
+		if (barriers[0U].mType == sResourceBarrierTypeTransition) {
+			command.mValues[2U] = barriers[0U].mStateBefore;
+			command.mValues[3U] = barriers[0U].mStateAfter;
+			command.mAddress = ToAddress(barriers[0U].mResource);
+		}
+	}
+}
+
+void NullCommandList::DrawIndexedInstanced(
+	const std::uint32_t indexCountPerInstance,
+	const std::uint32_t instanceCount,
+	const std::uint32_t startIndexLocation,
+	const std::int32_t baseVertexLocation,
+	const std::uint32_t startInstanceLocation) noexcept 
+{
+	const bool isValid{
+		mHasPipelineState &&
+		mHasRootSignature &&
+		mHasPrimitiveTopology &&
+		mHasVertexBuffer &&
+		mHasIndexBuffer &&
+		mHasViewport &&
+		mHasScissorRect &&
+		mHasRenderTargets &&
+		indexCountPerInstance > 0U &&
+		instanceCount > 0U };
+	Command& command(Record(DRAW_INDEXED_INSTANCED, isValid));
+	command.mValues[0U] = indexCountPerInstance;
+	command.mValues[1U] = instanceCount;
+	command.mValues[2U] = startIndexLocation;
+	command.mValues[3U] = static_cast<std::uint32_t>(baseVertexLocation);
+	command.mValues[4U] = startInstanceLocation;
+
+	mDrawnIndexCount += static_cast<std::uint64_t>(indexCountPerInstance) * instanceCount;
+	mDrawnInstanceCount += instanceCount;
+}
+
+void NullCommandList::Clear() noexcept {
+	mCommands.clear();
+	for (std::uint32_t i = 0U; i < COMMAND_TYPE_COUNT; ++i) {
+		mCommandCounts[i] = 0U;
+	}
+	mInvalidCommandCount = 0U;
+	mDrawnIndexCount = 0UL;
+	mDrawnInstanceCount = 0UL;
+
+	mHasPipelineState = false;
+	mHasRootSignature = false;
+	mHasDescriptorHeaps = false;
+	mHasPrimitiveTopology = false;
+	mHasVertexBuffer = false;
+	mHasIndexBuffer = false;
+	mHasViewport = false;
+	mHasScissorRect = false;
+	mHasRenderTargets = false;
+}
+
+NullCommandList::Command& NullCommandList::Record(const CommandType type, const bool isValid) noexcept {
+	ASSERT(type < COMMAND_TYPE_COUNT);
+	++mCommandCounts[type];
+	if (isValid == false) {
+		++mInvalidCommandCount;
+	}
+
+	mCommands.push_back(Command());
+	Command& command(mCommands.back());
+	command.mType = type;
+
+	return command;
+}
+
+bool NullCommandList::IsValidRootParameter(const std::uint32_t rootParameterIndex) const noexcept {
+	return mHasRootSignature && rootParameterIndex < sMaxRootParameterCount;
+}
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <CommandManager/GraphicsCommandList.h>
+#include <Utils/ForceInline.h>
+
+struct ID3D12CommandList;
+
+// GraphicsCommandList backend that does not need a device: it validates commands
+// against the current state, counts them and stores them in memory.
+// It is used to run and measure geometry pass recording code (and replays of its captures)
+// without the GPU. Together with NullCommandQueue, submission and fences run without it too.
+// Validation does not assert, invalid commands are counted (and stored anyway).
+// Steps:
+// - Record commands as in any GraphicsCommandList.
+// - Query counters and recorded Commands().
+// - Call Clear() before recording again (state is reset, as in a new command list).
+class NullCommandList : public GraphicsCommandList {
+public:
+	enum CommandType : std::uint32_t {
+		SET_PIPELINE_STATE = 0U,
+		SET_ROOT_SIGNATURE,
+		SET_DESCRIPTOR_HEAPS,
+		SET_ROOT_CONSTANT_BUFFER_VIEW,
+		SET_ROOT_SHADER_RESOURCE_VIEW,
+		SET_ROOT_DESCRIPTOR_TABLE,
+		SET_ROOT_CONSTANT,
+		SET_PRIMITIVE_TOPOLOGY,
+		SET_VERTEX_BUFFERS,
+		SET_INDEX_BUFFER,
+		SET_VIEWPORTS,
+		SET_SCISSOR_RECTS,
+		SET_RENDER_TARGETS,
+		RESOURCE_BARRIER,
+		DRAW_INDEXED_INSTANCED,
+		COMMAND_TYPE_COUNT
+	};
+
+	// Command arguments. Objects (pipeline states, root signatures, heaps) and GPU addresses
+	// or descriptors are stored in mAddress. Meaning of mValues depends on the type:
+	// - Root parameters: root parameter index and (root constant) value and offset
+	// - Counts: number of views, rects, render targets, heaps or barriers
+	// - Vertex/index buffer: start slot, size and stride (or format)
+	// - Draw: the 5 parameters of DrawIndexedInstanced (base vertex as std::uint32_t)
+	struct Command {
+		CommandType mType{ COMMAND_TYPE_COUNT };
+		std::uint32_t mValues[5U]{ 0U };
+		std::uint64_t mAddress{ 0UL };
+	};
+
+	// Root signatures have at most 64 DWORDs, so there are at most 64 root parameters
+	static const std::uint32_t sMaxRootParameterCount{ 64U };
+
+	NullCommandList() = default;
+	~NullCommandList() = default;
+	NullCommandList(const NullCommandList&) = delete;
+	const NullCommandList& operator=(const NullCommandList&) = delete;
+	NullCommandList(NullCommandList&&) = delete;
+	NullCommandList& operator=(NullCommandList&&) = delete;
+
+	void SetPipelineState(ID3D12PipelineState* pipelineState) noexcept final override;
+	void SetGraphicsRootSignature(ID3D12RootSignature* rootSignature) noexcept final override;
+	void SetDescriptorHeaps(const std::uint32_t numDescriptorHeaps, ID3D12DescriptorHeap* const* descriptorHeaps) noexcept final override;
+
+	void SetGraphicsRootConstantBufferView(const std::uint32_t rootParameterIndex, const std::uint64_t bufferLocation) noexcept final override;
+	void SetGraphicsRootShaderResourceView(const std::uint32_t rootParameterIndex, const std::uint64_t bufferLocation) noexcept final override;
+	void SetGraphicsRootDescriptorTable(const std::uint32_t rootParameterIndex, const std::uint64_t baseDescriptor) noexcept final override;
+	void SetGraphicsRoot32BitConstant(const std::uint32_t rootParameterIndex, const std::uint32_t srcData, const std::uint32_t destOffsetIn32BitValues) noexcept final override;
+
+	void IASetPrimitiveTopology(const std::uint32_t primitiveTopology) noexcept final override;
+	void IASetVertexBuffers(const std::uint32_t startSlot, const std::uint32_t numViews, const VertexBufferView* views) noexcept final override;
+	void IASetIndexBuffer(const IndexBufferView* view) noexcept final override;
+
+	void RSSetViewports(const std::uint32_t numViewports, const Viewport* viewports) noexcept final override;
+	void RSSetScissorRects(const std::uint32_t numRects, const Rect* rects) noexcept final override;
+	void OMSetRenderTargets(
+		const std::uint32_t numRenderTargetDescriptors,
+		const CpuDescriptorHandle* renderTargetDescriptors,
+		const bool rtsSingleHandleToDescriptorRange,
+		const CpuDescriptorHandle* depthStencilDescriptor) noexcept final override;
+
+	void ResourceBarrier(const std::uint32_t numBarriers, const Barrier* barriers) noexcept final override;
+
+	void DrawIndexedInstanced(
+		const std::uint32_t indexCountPerInstance,
+		const std::uint32_t instanceCount,
+		const std::uint32_t startIndexLocation,
+		const std::int32_t baseVertexLocation,
+		const std::uint32_t startInstanceLocation) noexcept final override;
+
+	// Removes recorded commands, counters and state
+	void Clear() noexcept;
+
+	// Opaque handle to execute it in a NullCommandQueue (it is never dereferenced)
+	__forceinline ID3D12CommandList* Handle() noexcept { return reinterpret_cast<ID3D12CommandList*>(this); }
+
+	__forceinline const std::vector<Command>& Commands() const noexcept { return mCommands; }
+	__forceinline std::uint32_t CommandCount(const CommandType type) const noexcept { return mCommandCounts[type]; }
+	__forceinline std::uint32_t InvalidCommandCount() const noexcept { return mInvalidCommandCount; }
+
+	// Sum of indices and instances of all draws
+	__forceinline std::uint64_t DrawnIndexCount() const noexcept { return mDrawnIndexCount; }
+	__forceinline std::uint64_t DrawnInstanceCount() const noexcept { return mDrawnInstanceCount; }
+
+private:
+	// Stores the command and counts it. It is counted as invalid if isValid is false.
+	Command& Record(const CommandType type, const bool isValid) noexcept;
+
+	bool IsValidRootParameter(const std::uint32_t rootParameterIndex) const noexcept;
+
+	std::vector<Command> mCommands;
+	std::uint32_t mCommandCounts[COMMAND_TYPE_COUNT]{ 0U };
+	std::uint32_t mInvalidCommandCount{ 0U };
+	std::uint64_t mDrawnIndexCount{ 0UL };
+	std::uint64_t mDrawnInstanceCount{ 0UL };
+
+	// Current state, to validate draws and root parameters
+	bool mHasPipelineState{ false };
+	bool mHasRootSignature{ false };
+	bool mHasDescriptorHeaps{ false };
+	bool mHasPrimitiveTopology{ false };
+	bool mHasVertexBuffer{ false };
+	bool mHasIndexBuffer{ false };
+	bool mHasViewport{ false };
+	bool mHasScissorRect{ false };
+	bool mHasRenderTargets{ false };
+};
@@ -0,0 +1,37 @@
+#include "NullCommandQueue.h"
+
+void NullCommandQueue::ExecuteCommandLists(const std::uint32_t numCommandLists, ID3D12CommandList* const* commandLists) noexcept {
+	bool isValid{ numCommandLists > 0U && commandLists != nullptr };
+	for (std::uint32_t i = 0U; isValid && i < numCommandLists; ++i) {
+		isValid = commandLists[i] != nullptr;
+	}
+
+	if (isValid == false) {
+		++mInvalidCallCount;
+	}
+	++mExecuteCount;
+	mExecutedCmdListCount += numCommandLists;
+}
+
+void NullCommandQueue::Signal(const std::uint64_t fenceValue) noexcept {
+	++mSignalCount;
+
+	// There is no GPU work, so the fence is completed as soon as it is signaled
+	std::uint64_t completedFenceValue{ mCompletedFenceValue };
+	while (completedFenceValue < fenceValue && mCompletedFenceValue.compare_exchange_weak(completedFenceValue, fenceValue) == false) {
+	}
+	if (completedFenceValue >= fenceValue) {
+		++mInvalidCallCount;
+	}
+}
+
+std::uint64_t NullCommandQueue::CompletedFenceValue() const noexcept {
+	return mCompletedFenceValue;
+}
+
+void NullCommandQueue::WaitForFenceValue(const std::uint64_t fenceValue) noexcept {
+	// Waiting a value that was not signaled would block forever with a real queue
+	if (mCompletedFenceValue < fenceValue) {
+		++mInvalidCallCount;
+	}
+}
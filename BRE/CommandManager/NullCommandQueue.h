@@ -0,0 +1,39 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include <CommandManager/CommandQueue.h>
+#include <Utils/ForceInline.h>
+
+// CommandQueue backend that does not need a device: command lists are counted (not executed),
+// and fence values are completed when they are signaled, as a GPU without work would do.
+// It is used to run and measure submission and frame synchronization code without the GPU.
+// It is thread safe. Invalid calls (null command lists, fence values that do not increase)
+// do not assert, they are counted.
+class NullCommandQueue : public CommandQueue {
+public:
+	NullCommandQueue() = default;
+	~NullCommandQueue() = default;
+	NullCommandQueue(const NullCommandQueue&) = delete;
+	const NullCommandQueue& operator=(const NullCommandQueue&) = delete;
+	NullCommandQueue(NullCommandQueue&&) = delete;
+	NullCommandQueue& operator=(NullCommandQueue&&) = delete;
+
+	void ExecuteCommandLists(const std::uint32_t numCommandLists, ID3D12CommandList* const* commandLists) noexcept final override;
+	void Signal(const std::uint64_t fenceValue) noexcept final override;
+	std::uint64_t CompletedFenceValue() const noexcept final override;
+	void WaitForFenceValue(const std::uint64_t fenceValue) noexcept final override;
+
+	__forceinline std::uint32_t ExecuteCount() const noexcept { return mExecuteCount; }
+	__forceinline std::uint32_t ExecutedCmdListCount() const noexcept { return mExecutedCmdListCount; }
+	__forceinline std::uint32_t SignalCount() const noexcept { return mSignalCount; }
+	__forceinline std::uint32_t InvalidCallCount() const noexcept { return mInvalidCallCount; }
+
+private:
+	std::atomic<std::uint32_t> mExecuteCount{ 0U };
+	std::atomic<std::uint32_t> mExecutedCmdListCount{ 0U };
+	std::atomic<std::uint32_t> mSignalCount{ 0U };
+	std::atomic<std::uint32_t> mInvalidCallCount{ 0U };
+	std::atomic<std::uint64_t> mCompletedFenceValue{ 0UL };
+};
@@ -0,0 +1,34 @@
+#include "QueuedFrameFences.h"
+
+#include <CommandManager/CommandQueue.h>
+#include <Utils/DebugUtils.h>
+#include <Utils/Profiler.h>
+
+QueuedFrameFences::QueuedFrameFences(CommandQueue& cmdQueue, const std::uint32_t queuedFrameCount)
+	: mCmdQueue(cmdQueue)
+	, mFenceValueByQueuedFrameIndex(queuedFrameCount, 0UL)
+{
+	ASSERT(queuedFrameCount > 0U);
+}
+
+void QueuedFrameFences::EndFrame() noexcept {
+	PROFILE_ZONE("QueuedFrameFences::EndFrame");
+
+	// Add an instruction to the command queue to set a new fence point. Because we 
+	// are on the GPU time line, the new fence point won't be set until the GPU finishes
+	// processing all the commands prior to this Signal().
+	mFenceValueByQueuedFrameIndex[mCurrQueuedFrameIndex] = ++mCurrFenceValue;
+	mCmdQueue.Signal(mCurrFenceValue);
+	mCurrQueuedFrameIndex = (mCurrQueuedFrameIndex + 1U) % static_cast<std::uint32_t>(mFenceValueByQueuedFrameIndex.size());
+
+	// If we executed command lists for all queued frames, then we need to wait
+	// at least 1 of them to be completed, before continue recording command lists. 
+	mCmdQueue.WaitForFenceValue(mFenceValueByQueuedFrameIndex[mCurrQueuedFrameIndex]);
+}
+
+void QueuedFrameFences::Flush() noexcept {
+	// Wait until the GPU has completed commands up to a new fence point
+	++mCurrFenceValue;
+	mCmdQueue.Signal(mCurrFenceValue);
+	mCmdQueue.WaitForFenceValue(mCurrFenceValue);
+}
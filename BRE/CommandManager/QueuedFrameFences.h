@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <Utils/ForceInline.h>
+
+class CommandQueue;
+
+// Fence values of the frames queued in a CommandQueue. The CPU records a frame while the GPU
+// executes up to queuedFrameCount previous frames, so the resources of a queued frame
+// (command allocators, constant buffers) can only be reused when its fence value is completed.
+// Steps:
+// - Record and execute the commands of the frame, using the resources of CurrentQueuedFrameIndex().
+// - Call EndFrame(). It signals the fence value of the frame, moves to the next queued frame
+//   and waits until the GPU completes it.
+// - Call Flush() to wait until all executed command lists are completed (before destroying resources).
+class QueuedFrameFences {
+public:
+	explicit QueuedFrameFences(CommandQueue& cmdQueue, const std::uint32_t queuedFrameCount);
+	~QueuedFrameFences() = default;
+	QueuedFrameFences(const QueuedFrameFences&) = delete;
+	const QueuedFrameFences& operator=(const QueuedFrameFences&) = delete;
+	QueuedFrameFences(QueuedFrameFences&&) = delete;
+	QueuedFrameFences& operator=(QueuedFrameFences&&) = delete;
+
+	void EndFrame() noexcept;
+	void Flush() noexcept;
+
+	__forceinline std::uint32_t CurrentQueuedFrameIndex() const noexcept { return mCurrQueuedFrameIndex; }
+	__forceinline std::uint64_t LastSignaledFenceValue() const noexcept { return mCurrFenceValue; }
+
+private:
+	CommandQueue& mCmdQueue;
+	std::vector<std::uint64_t> mFenceValueByQueuedFrameIndex;
+	std::uint32_t mCurrQueuedFrameIndex{ 0U };
+	std::uint64_t mCurrFenceValue{ 0UL };
+};
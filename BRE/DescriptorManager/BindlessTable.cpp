@@ -0,0 +1,39 @@
+#include "BindlessTable.h"
+
+#include <Utils/DebugUtils.h>
+
+BindlessTable::BindlessTable(const std::uint32_t capacity) noexcept
+	: mCapacity(capacity)
+{
+	ASSERT(capacity > 0U);
+	mSlotByKey.reserve(capacity);
+}
+
+std::uint32_t BindlessTable::Acquire(const void* key, bool& isNew) noexcept {
+	ASSERT(key != nullptr);
+
+	std::lock_guard<std::mutex> lock(mMutex);
+	++mAcquireCount;
+	const std::uint32_t slot{ static_cast<std::uint32_t>(mSlotByKey.size()) };
+	const std::pair<std::unordered_map<const void*, std::uint32_t>::iterator, bool> result{ mSlotByKey.emplace(key, slot) };
+	isNew = result.second;
+	ASSERT(isNew == false || slot < mCapacity);
+
+	return result.first->second;
+}
+
+std::uint32_t BindlessTable::Find(const void* key) const noexcept {
+	std::lock_guard<std::mutex> lock(mMutex);
+	const std::unordered_map<const void*, std::uint32_t>::const_iterator it{ mSlotByKey.find(key) };
+	return it == mSlotByKey.end() ? sInvalidSlot : it->second;
+}
+
+std::uint32_t BindlessTable::SlotCount() const noexcept {
+	std::lock_guard<std::mutex> lock(mMutex);
+	return static_cast<std::uint32_t>(mSlotByKey.size());
+}
+
+std::uint32_t BindlessTable::AcquireCount() const noexcept {
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mAcquireCount;
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+
+#include <Utils/ForceInline.h>
+
+// Bookkeeping of a bindless descriptor range. It assigns a slot (descriptor index
+// in the range) to each distinct resource, so a resource gets a single descriptor
+// shared by all its users. Slots are assigned in order and never released.
+// Resources are opaque keys, so it does not depend on D3D and can be tested without a device.
+// Steps:
+// - Call Acquire() with the resource. If the slot is new, create its descriptor.
+// - Index the range with the returned slot in shaders.
+class BindlessTable {
+public:
+	static const std::uint32_t sInvalidSlot{ 0xFFFFFFFFU };
+
+	explicit BindlessTable(const std::uint32_t capacity) noexcept;
+
+	~BindlessTable() = default;
+	BindlessTable(const BindlessTable&) = delete;
+	const BindlessTable& operator=(const BindlessTable&) = delete;
+	BindlessTable(BindlessTable&&) = delete;
+	BindlessTable& operator=(BindlessTable&&) = delete;
+
+	// Returns the slot of the key, assigning the next one if it does not have it.
+	// isNew is true if the slot was assigned by this call. It is thread safe.
+	std::uint32_t Acquire(const void* key, bool& isNew) noexcept;
+
+	// Returns sInvalidSlot if the key does not have a slot
+	std::uint32_t Find(const void* key) const noexcept;
+
+	__forceinline std::uint32_t Capacity() const noexcept { return mCapacity; }
+	std::uint32_t SlotCount() const noexcept;
+
+	// Number of Acquire() calls, to compare with SlotCount()
+	std::uint32_t AcquireCount() const noexcept;
+
+private:
+	std::unordered_map<const void*, std::uint32_t> mSlotByKey;
+	std::uint32_t mCapacity{ 0U };
+	std::uint32_t mAcquireCount{ 0U };
+
+	mutable std::mutex mMutex;
+};
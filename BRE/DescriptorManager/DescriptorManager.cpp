@@ -135,6 +135,24 @@ D3D12_GPU_DESCRIPTOR_HANDLE DescriptorManager::CreateShaderResourceView(
 	return gpuDescHandle;
 }
 
+D3D12_GPU_DESCRIPTOR_HANDLE DescriptorManager::ReserveCbvSrvUavDescriptors(const std::uint32_t count, D3D12_CPU_DESCRIPTOR_HANDLE& cpuDescHandle) noexcept {
+	ASSERT(count > 0U);
+
+	D3D12_GPU_DESCRIPTOR_HANDLE gpuDescHandle{};
+
+	mMutex.lock();
+	gpuDescHandle = mCurrCbvSrvUavGpuDescHandle;
+	cpuDescHandle = mCurrCbvSrvUavCpuDescHandle;
+
+	const std::size_t byteCount{ count * GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV) };
+	mCurrCbvSrvUavGpuDescHandle.ptr += byteCount;
+	mCurrCbvSrvUavCpuDescHandle.ptr += byteCount;
+
+	mMutex.unlock();
+
+	return gpuDescHandle;
+}
+
 D3D12_GPU_DESCRIPTOR_HANDLE DescriptorManager::CreateUnorderedAccessView(ID3D12Resource& res, const D3D12_UNORDERED_ACCESS_VIEW_DESC& desc) noexcept {
 	D3D12_GPU_DESCRIPTOR_HANDLE gpuDescHandle{};
 
@@ -39,6 +39,10 @@ public:
 	D3D12_GPU_DESCRIPTOR_HANDLE CreateShaderResourceView(ID3D12Resource& res, const D3D12_SHADER_RESOURCE_VIEW_DESC& desc) noexcept;
 	D3D12_GPU_DESCRIPTOR_HANDLE CreateShaderResourceView(ID3D12Resource* *res, const D3D12_SHADER_RESOURCE_VIEW_DESC* desc, const std::uint32_t count) noexcept;
 
+	// Reserves count contiguous CBV/SRV/UAV descriptors, whose views are created later
+	// by the caller (for example, bindless tables). cpuDescHandle is the first descriptor.
+	D3D12_GPU_DESCRIPTOR_HANDLE ReserveCbvSrvUavDescriptors(const std::uint32_t count, D3D12_CPU_DESCRIPTOR_HANDLE& cpuDescHandle) noexcept;
+
 	D3D12_GPU_DESCRIPTOR_HANDLE CreateUnorderedAccessView(ID3D12Resource& res, const D3D12_UNORDERED_ACCESS_VIEW_DESC& desc) noexcept;
 	D3D12_GPU_DESCRIPTOR_HANDLE CreateUnorderedAccessView(ID3D12Resource* *res, const D3D12_UNORDERED_ACCESS_VIEW_DESC* desc, const std::uint32_t count) noexcept;
 
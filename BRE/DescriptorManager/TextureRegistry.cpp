@@ -0,0 +1,50 @@
+#include "TextureRegistry.h"
+
+#include <DescriptorManager/DescriptorManager.h>
+#include <Utils/DebugUtils.h>
+
+namespace {
+	std::unique_ptr<TextureRegistry> gRegistry{ nullptr };
+}
+
+TextureRegistry& TextureRegistry::Create(ID3D12Device& device) noexcept {
+	ASSERT(gRegistry == nullptr);
+	gRegistry.reset(new TextureRegistry(device));
+	return *gRegistry.get();
+}
+
+TextureRegistry& TextureRegistry::Get() noexcept {
+	ASSERT(gRegistry != nullptr);
+	return *gRegistry.get();
+}
+
+TextureRegistry::TextureRegistry(ID3D12Device& device)
+	: mDevice(device)
+	, mTable(sMaxTextureCount)
+{
+	DescriptorManager& descriptorManager(DescriptorManager::Get());
+	mGpuDescHandleBegin = descriptorManager.ReserveCbvSrvUavDescriptors(sMaxTextureCount, mCpuDescHandleBegin);
+	mDescHandleIncrementSize = descriptorManager.GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+}
+
+std::uint32_t TextureRegistry::Register(ID3D12Resource& texture) noexcept {
+	bool isNew{ false };
+	const std::uint32_t slot{ mTable.Acquire(&texture, isNew) };
+	if (isNew) {
+		// Slots are only written once, so views are created out of the lock
+		const D3D12_RESOURCE_DESC resourceDesc{ texture.GetDesc() };
+		D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc{};
+		srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+		srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
+		srvDesc.Texture2D.MostDetailedMip = 0;
+		srvDesc.Texture2D.ResourceMinLODClamp = 0.0f;
+		srvDesc.Format = resourceDesc.Format;
+		srvDesc.Texture2D.MipLevels = resourceDesc.MipLevels;
+
+		D3D12_CPU_DESCRIPTOR_HANDLE cpuDescHandle{ mCpuDescHandleBegin };
+		cpuDescHandle.ptr += slot * mDescHandleIncrementSize;
+		mDevice.CreateShaderResourceView(&texture, &srvDesc, cpuDescHandle);
+	}
+
+	return slot;
+}
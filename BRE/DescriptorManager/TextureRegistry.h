@@ -0,0 +1,47 @@
+#pragma once
+
+#include <d3d12.h>
+#include <memory>
+
+#include <DescriptorManager/BindlessTable.h>
+
+// This class is responsible to create a single SRV per texture, in a bindless
+// descriptor range shared by all geometry pass recorders. Shaders declare an
+// unbounded textures array bound to TableBegin(), and index it with the
+// texture indices returned by Register() (stored in materials).
+// Steps:
+// - Call Create() after DescriptorManager::Create().
+// - Call Register() with each texture to get its index (it can be called from different threads).
+// - Bind TableBegin() as textures descriptor table.
+class TextureRegistry {
+public:
+	// Descriptors reserved for the range
+	static const std::uint32_t sMaxTextureCount{ 1024U };
+
+	static TextureRegistry& Create(ID3D12Device& device) noexcept;
+	static TextureRegistry& Get() noexcept;
+
+	~TextureRegistry() = default;
+	TextureRegistry(const TextureRegistry&) = delete;
+	const TextureRegistry& operator=(const TextureRegistry&) = delete;
+	TextureRegistry(TextureRegistry&&) = delete;
+	TextureRegistry& operator=(TextureRegistry&&) = delete;
+
+	// Returns the index of the texture SRV in the range, creating it if the texture was not registered.
+	std::uint32_t Register(ID3D12Resource& texture) noexcept;
+
+	__forceinline D3D12_GPU_DESCRIPTOR_HANDLE TableBegin() const noexcept { return mGpuDescHandleBegin; }
+
+	__forceinline const BindlessTable& Table() const noexcept { return mTable; }
+
+private:
+	explicit TextureRegistry(ID3D12Device& device);
+
+	ID3D12Device& mDevice;
+
+	BindlessTable mTable;
+
+	D3D12_GPU_DESCRIPTOR_HANDLE mGpuDescHandleBegin{ 0UL };
+	D3D12_CPU_DESCRIPTOR_HANDLE mCpuDescHandleBegin{ 0UL };
+	std::size_t mDescHandleIncrementSize{ 0UL };
+};
@@ -8,11 +8,14 @@
 #include <ResourceManager/ResourceManager.h>
 #include <ShaderUtils\CBuffers.h>
 #include <Utils/DebugUtils.h>
+#include <Utils/Profiler.h>
+#include <Utils/RenderStats.h>
 
 // Root Signature:
 // "CBV(b0, visibility = SHADER_VISIBILITY_VERTEX), " \ 0 -> Frame CBuffer
 // "CBV(b0, visibility = SHADER_VISIBILITY_PIXEL), " \ 1 -> Frame CBuffer
-// "DescriptorTable(SRV(t0), SRV(t1), SRV(t2), SRV(t3), SRV(t4), visibility = SHADER_VISIBILITY_PIXEL), " \ 2 -> Textures 
+// "CBV(b1, visibility = SHADER_VISIBILITY_PIXEL), " \ 2 -> Diffuse irradiance SH CBuffer
+// "DescriptorTable(SRV(t0), SRV(t1), SRV(t2), SRV(t3), visibility = SHADER_VISIBILITY_PIXEL), " \ 3 -> Textures 
 
 namespace {
 	ID3D12PipelineState* sPSO{ nullptr };
@@ -80,7 +83,7 @@ void EnvironmentLightCmdListRecorder::Init(
 	ID3D12Resource& depthBuffer,
 	const D3D12_CPU_DESCRIPTOR_HANDLE& colorBufferCpuDesc,
 	const D3D12_CPU_DESCRIPTOR_HANDLE& depthBufferCpuDesc,
-	ID3D12Resource& diffuseIrradianceCubeMap,
+	const SphericalHarmonics::Coefficients& diffuseIrradiance,
 	ID3D12Resource& specularPreConvolvedCubeMap) noexcept
 {
 	ASSERT(ValidateData() == false);
@@ -92,12 +95,14 @@ void EnvironmentLightCmdListRecorder::Init(
 	mColorBufferCpuDesc = colorBufferCpuDesc;
 	mDepthBufferCpuDesc = depthBufferCpuDesc;
 
-	BuildBuffers(geometryBuffers, geometryBuffersCount, depthBuffer, diffuseIrradianceCubeMap, specularPreConvolvedCubeMap);
+	BuildBuffers(geometryBuffers, geometryBuffersCount, depthBuffer, diffuseIrradiance, specularPreConvolvedCubeMap);
 
 	ASSERT(ValidateData());
 }
 
 void EnvironmentLightCmdListRecorder::RecordAndPushCommandLists(const FrameCBuffer& frameCBuffer) noexcept {
+	PROFILE_ZONE("EnvironmentLightCmdListRecorder::RecordAndPushCommandLists");
+
 	ASSERT(ValidateData());
 	ASSERT(sPSO != nullptr);
 	ASSERT(sRootSign != nullptr);
@@ -110,6 +115,7 @@ void EnvironmentLightCmdListRecorder::RecordAndPushCommandLists(const FrameCBuff
 	uploadFrameCBuffer.CopyData(0U, &frameCBuffer, sizeof(frameCBuffer));
 	
 	CHECK_HR(cmdAlloc->Reset());
+	RENDER_STATS_ADD(PIPELINE_STATE_CHANGES, 1UL);
 	CHECK_HR(mCmdList->Reset(cmdAlloc, sPSO));
 
 	mCmdList->RSSetViewports(1U, &Settings::sScreenViewport);
@@ -118,6 +124,7 @@ void EnvironmentLightCmdListRecorder::RecordAndPushCommandLists(const FrameCBuff
 
 	ID3D12DescriptorHeap* heaps[] = { &DescriptorManager::Get().GetCbvSrcUavDescriptorHeap() };
 	mCmdList->SetDescriptorHeaps(_countof(heaps), heaps);
+	RENDER_STATS_ADD(ROOT_SIGNATURE_CHANGES, 1UL);
 	mCmdList->SetGraphicsRootSignature(sRootSign);
 	
 	mCmdList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
@@ -126,12 +133,15 @@ void EnvironmentLightCmdListRecorder::RecordAndPushCommandLists(const FrameCBuff
 	const D3D12_GPU_VIRTUAL_ADDRESS frameCBufferGpuVAddress(uploadFrameCBuffer.Resource()->GetGPUVirtualAddress());
 	mCmdList->SetGraphicsRootConstantBufferView(0U, frameCBufferGpuVAddress);
 	mCmdList->SetGraphicsRootConstantBufferView(1U, frameCBufferGpuVAddress);
-	mCmdList->SetGraphicsRootDescriptorTable(2U, mTexturesGpuDescHandle);
+	mCmdList->SetGraphicsRootConstantBufferView(2U, mIrradianceSHCBuffer->Resource()->GetGPUVirtualAddress());
+	RENDER_STATS_ADD(DESCRIPTOR_TABLES, 1UL);
+	mCmdList->SetGraphicsRootDescriptorTable(3U, mTexturesGpuDescHandle);
 
 	// Draw object
 	mCmdList->IASetVertexBuffers(0U, 1U, &mVertexBufferData.mBufferView);
 	mCmdList->IASetIndexBuffer(&mIndexBufferData.mBufferView);
-	mCmdList->DrawIndexedInstanced(mIndexBufferData.mCount, 1U, 0U, 0U, 0U);
+	RENDER_STATS_DRAW(mIndexBufferData.mCount, 1U);
+	mCmdList->DrawIndexedInstanced(mIndexBufferData.mCount, 1U, mIndexBufferData.mStartIndex, mVertexBufferData.mBaseVertex, 0U);
 
 	mCmdList->Close();
 
@@ -157,6 +167,7 @@ bool EnvironmentLightCmdListRecorder::ValidateData() const noexcept {
 
 	const bool result =
 		mCmdList != nullptr &&
+		mIrradianceSHCBuffer != nullptr &&
 		mColorBufferCpuDesc.ptr != 0UL &&
 		mDepthBufferCpuDesc.ptr != 0UL && 
 		mTexturesGpuDescHandle.ptr != 0UL;
@@ -168,7 +179,7 @@ void EnvironmentLightCmdListRecorder::BuildBuffers(
 	Microsoft::WRL::ComPtr<ID3D12Resource>* geometryBuffers, 
 	const std::uint32_t geometryBuffersCount,
 	ID3D12Resource& depthBuffer,
-	ID3D12Resource& diffuseIrradianceCubeMap,
+	const SphericalHarmonics::Coefficients& diffuseIrradiance,
 	ID3D12Resource& specularPreConvolvedCubeMap) noexcept
 {
 	ASSERT(geometryBuffers != nullptr);
@@ -176,9 +187,9 @@ void EnvironmentLightCmdListRecorder::BuildBuffers(
 
 	// Used to create SRV descriptors
 	std::vector<D3D12_SHADER_RESOURCE_VIEW_DESC> srvDesc;
-	srvDesc.resize(geometryBuffersCount + 3U); // 3 = depth buffer + 2 cube maps
+	srvDesc.resize(geometryBuffersCount + 2U); // 2 = depth buffer + specular cube map
 	std::vector<ID3D12Resource*> res;
-	res.resize(geometryBuffersCount + 3U);
+	res.resize(geometryBuffersCount + 2U);
 
 	// Fill geometry buffers SRV descriptors
 	for (std::uint32_t i = 0U; i < geometryBuffersCount; ++i) {
@@ -203,16 +214,7 @@ void EnvironmentLightCmdListRecorder::BuildBuffers(
 	res[descIndex] = &depthBuffer;
 	++descIndex;
 
-	// Fill cube map texture descriptors	
-	srvDesc[descIndex].Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
-	srvDesc[descIndex].ViewDimension = D3D12_SRV_DIMENSION_TEXTURECUBE;
-	srvDesc[descIndex].TextureCube.MostDetailedMip = 0;
-	srvDesc[descIndex].TextureCube.MipLevels = diffuseIrradianceCubeMap.GetDesc().MipLevels;
-	srvDesc[descIndex].TextureCube.ResourceMinLODClamp = 0.0f;
-	srvDesc[descIndex].Format = diffuseIrradianceCubeMap.GetDesc().Format;
-	res[descIndex] = &diffuseIrradianceCubeMap;
-	++descIndex;
-
+	// Fill cube map texture descriptor
 	srvDesc[descIndex].Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
 	srvDesc[descIndex].ViewDimension = D3D12_SRV_DIMENSION_TEXTURECUBE;
 	srvDesc[descIndex].TextureCube.MostDetailedMip = 0;
@@ -229,4 +231,9 @@ void EnvironmentLightCmdListRecorder::BuildBuffers(
 	for (std::uint32_t i = 0U; i < Settings::sQueuedFrameCount; ++i) {
 		ResourceManager::Get().CreateUploadBuffer(frameCBufferElemSize, 1U, mFrameCBuffer[i]);
 	}
+
+	// Create diffuse irradiance cbuffer
+	const std::size_t irradianceSHCBufferElemSize{ UploadBuffer::CalcConstantBufferByteSize(sizeof(SphericalHarmonics::Coefficients)) };
+	ResourceManager::Get().CreateUploadBuffer(irradianceSHCBufferElemSize, 1U, mIrradianceSHCBuffer);
+	mIrradianceSHCBuffer->CopyData(0U, &diffuseIrradiance, sizeof(diffuseIrradiance));
 }
\ No newline at end of file
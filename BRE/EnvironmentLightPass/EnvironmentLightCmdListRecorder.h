@@ -3,6 +3,7 @@
 #include <tbb/concurrent_queue.h>
 
 #include <GlobalData/Settings.h>
+#include <MathUtils/SphericalHarmonics.h>
 #include <ResourceManager/BufferCreator.h>
 
 class UploadBuffer;
@@ -39,7 +40,7 @@ public:
 		ID3D12Resource& depthBuffer,
 		const D3D12_CPU_DESCRIPTOR_HANDLE& colorBufferCpuDesc,
 		const D3D12_CPU_DESCRIPTOR_HANDLE& depthBufferCpuDesc,
-		ID3D12Resource& diffuseIrradianceCubeMap,
+		const SphericalHarmonics::Coefficients& diffuseIrradiance,
 		ID3D12Resource& specularPreConvolvedCubeMap) noexcept;
 
 	void RecordAndPushCommandLists(const FrameCBuffer& frameCBuffer) noexcept;
@@ -51,7 +52,7 @@ private:
 		Microsoft::WRL::ComPtr<ID3D12Resource>* geometryBuffers, 
 		const std::uint32_t geometryBuffersCount,
 		ID3D12Resource& depthBuffer,
-		ID3D12Resource& diffuseIrradianceCubeMap,
+		const SphericalHarmonics::Coefficients& diffuseIrradiance,
 		ID3D12Resource& specularPreConvolvedCubeMap) noexcept;
 
 	ID3D12Device& mDevice;
@@ -63,6 +64,9 @@ private:
 
 	UploadBuffer* mFrameCBuffer[Settings::sQueuedFrameCount]{ nullptr };
 
+	// Diffuse irradiance spherical harmonics (it does not change across frames)
+	UploadBuffer* mIrradianceSHCBuffer{ nullptr };
+
 	BufferCreator::VertexBufferData mVertexBufferData;
 	BufferCreator::IndexBufferData mIndexBufferData;
 
@@ -9,6 +9,7 @@
 #include <ModelManager\ModelManager.h>
 #include <ResourceManager\ResourceManager.h>
 #include <Utils\DebugUtils.h>
+#include <Utils/Profiler.h>
 
 namespace {
 	void CreateCommandObjects(
@@ -56,6 +57,10 @@ namespace {
 	}
 }
 
+void EnvironmentLightPass::InitPSOs() noexcept {
+	EnvironmentLightCmdListRecorder::InitPSO();
+}
+
 void EnvironmentLightPass::Init(
 	ID3D12Device& device,
 	ID3D12CommandQueue& cmdQueue,
@@ -65,7 +70,7 @@ void EnvironmentLightPass::Init(
 	ID3D12Resource& depthBuffer,
 	const D3D12_CPU_DESCRIPTOR_HANDLE& colorBufferCpuDesc,
 	const D3D12_CPU_DESCRIPTOR_HANDLE& depthBufferCpuDesc,
-	ID3D12Resource& diffuseIrradianceCubeMap,
+	const SphericalHarmonics::Coefficients& diffuseIrradiance,
 	ID3D12Resource& specularPreConvolvedCubeMap) noexcept {
 
 	ASSERT(ValidateData() == false);
@@ -78,16 +83,14 @@ void EnvironmentLightPass::Init(
 	Model* model;
 	Microsoft::WRL::ComPtr<ID3D12Resource> uploadVertexBuffer;
 	Microsoft::WRL::ComPtr<ID3D12Resource> uploadIndexBuffer;
-	ModelManager::Get().CreateFullscreenQuad(model, *mCmdList, uploadVertexBuffer, uploadIndexBuffer);
+	const std::size_t modelId{ ModelManager::Get().CreateFullscreenQuad(model, *mCmdList, uploadVertexBuffer, uploadIndexBuffer) };
 	ASSERT(model != nullptr);
 
 	// Get vertex and index buffers data from the only mesh this model must have.
 	ASSERT(model->Meshes().size() == 1UL);
 	const Mesh& mesh = model->Meshes()[0U];
 	ExecuteCommandList(cmdQueue, *mCmdList, *mFence);
-
-	// Initialize recorder's PSO
-	EnvironmentLightCmdListRecorder::InitPSO();
+	ModelManager::Get().UploadFlushed(modelId);
 
 	// Initialize recorder
 	mRecorder.reset(new EnvironmentLightCmdListRecorder(device, cmdListQueue));
@@ -99,13 +102,15 @@ void EnvironmentLightPass::Init(
 		depthBuffer,
 		colorBufferCpuDesc,
 		depthBufferCpuDesc,
-		diffuseIrradianceCubeMap,
+		diffuseIrradiance,
 		specularPreConvolvedCubeMap);
 
 	ASSERT(ValidateData());
 }
 
 void EnvironmentLightPass::Execute(const FrameCBuffer& frameCBuffer) const noexcept {
+	PROFILE_ZONE("EnvironmentLightPass::Execute");
+
 	ASSERT(ValidateData());
 
 	mRecorder->RecordAndPushCommandLists(frameCBuffer);
@@ -14,7 +14,7 @@ struct ID3D12Device;
 struct ID3D12GraphicsCommandList;
 struct ID3D12Resource;
 
-// Pass responsible to apply diffuse irradiance & specular pre-convolved environment cube maps
+// Pass responsible to apply diffuse irradiance (spherical harmonics) & specular pre-convolved environment cube map
 class EnvironmentLightPass {
 public:
 	using Recorder = std::unique_ptr<EnvironmentLightCmdListRecorder>;
@@ -26,6 +26,9 @@ public:
 	EnvironmentLightPass(EnvironmentLightPass&&) = delete;
 	EnvironmentLightPass& operator=(EnvironmentLightPass&&) = delete;
 
+	// Creates recorder pipeline state. It must be called before Init().
+	static void InitPSOs() noexcept;
+
 	// You should call this method before Execute()
 	void Init(
 		ID3D12Device& device,
@@ -36,7 +39,7 @@ public:
 		ID3D12Resource& depthBuffer,
 		const D3D12_CPU_DESCRIPTOR_HANDLE& colorBufferCpuDesc,
 		const D3D12_CPU_DESCRIPTOR_HANDLE& depthBufferCpuDesc,
-		ID3D12Resource& diffuseIrradianceCubeMap,
+		const SphericalHarmonics::Coefficients& diffuseIrradiance,
 		ID3D12Resource& specularPreConvolvedCubeMap) noexcept;
 
 	void Execute(const FrameCBuffer& frameCBuffer) const noexcept;
@@ -8,14 +8,14 @@ struct Input {
 };
 
 ConstantBuffer<FrameCBuffer> gFrameCBuffer : register(b0);
+ConstantBuffer<IrradianceSH> gIrradianceSH : register(b1);
 
 SamplerState TexSampler : register (s0);
 
 Texture2D<float4> Normal_Smoothness : register (t0);
 Texture2D<float4> BaseColor_MetalMask : register (t1);
 Texture2D<float> Depth : register (t2);
-TextureCube DiffuseCubeMap : register(t3);
-TextureCube SpecularCubeMap : register(t4);
+TextureCube SpecularCubeMap : register(t3);
 
 struct Output {
 	float4 mColor : SV_Target0;
@@ -55,8 +55,8 @@ Output main(const in Input input){
 	const float3 viewV = normalize(-geomPosV);
 
 	// Diffuse reflection color.
-	// When we sample a cube map, we need to use data in world space, not view space.
-	const float3 diffuseReflection = DiffuseCubeMap.Sample(TexSampler, normalW).rgb;
+	// Spherical harmonics are in world space, not view space.
+	const float3 diffuseReflection = EvaluateIrradianceSH(normalW, gIrradianceSH.mCoefficients);
 	const float3 diffuseColor = (1.0f - baseColor_metalmask.w) * baseColor_metalmask.xyz;
 	const float3 indirectFDiffuse = diffuseColor * diffuseReflection;
 
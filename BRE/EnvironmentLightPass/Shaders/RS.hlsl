@@ -5,5 +5,6 @@
 "DENY_DOMAIN_SHADER_ROOT_ACCESS), " \
 "CBV(b0, visibility = SHADER_VISIBILITY_VERTEX), " \
 "CBV(b0, visibility = SHADER_VISIBILITY_PIXEL), " \
-"DescriptorTable(SRV(t0), SRV(t1), SRV(t2), SRV(t3), SRV(t4), visibility = SHADER_VISIBILITY_PIXEL), " \
+"CBV(b1, visibility = SHADER_VISIBILITY_PIXEL), " \
+"DescriptorTable(SRV(t0), SRV(t1), SRV(t2), SRV(t3), visibility = SHADER_VISIBILITY_PIXEL), " \
 "StaticSampler(s0, filter=FILTER_MIN_MAG_MIP_LINEAR)"
\ No newline at end of file
@@ -6,15 +6,15 @@
 #include <GeometryPass/Recorders/NormalCmdListRecorder.h>
 #include <GlobalData/D3dData.h>
 #include <Material/Material.h>
+#include <Material/MaterialRegistry.h>
 #include <MathUtils\MathUtils.h>
 #include <ModelManager\Mesh.h>
 #include <ModelManager\ModelManager.h>
+#include <ResourceManager/DiffuseIrradianceSH.h>
 #include <ResourceManager\ResourceManager.h>
 #include <Scene/SceneUtils.h>
 
 namespace {
-	SceneUtils::ResourceContainer sResourceContainer;
-
 	enum Textures {
 		// Metal
 		METAL = 0U,
@@ -26,7 +26,6 @@ namespace {
 
 		// Environment
 		SKY_BOX,
-		DIFFUSE_CUBE_MAP,
 		SPECULAR_CUBE_MAP,
 
 		TEXTURES_COUNT
@@ -45,7 +44,6 @@ namespace {
 
 		// Environment
 		"textures/cubeMaps/milkmill_cube_map.dds",
-		"textures/cubeMaps/milkmill_diffuse_cube_map.dds",
 		"textures/cubeMaps/milkmill_specular_cube_map.dds",
 	};
 
@@ -63,6 +61,8 @@ namespace {
 		"models/floor.obj",
 	};
 
+	SceneUtils::ResourceContainer sResourceContainer{ sTexFiles, sModelFiles };
+
 	const float sFloorScale{ 1.0f };
 	const float sFloorTx{ -150.0f };
 	const float sFloorTy{ -20.5f };
@@ -98,6 +98,7 @@ namespace {
 		ID3D12Resource** normals,
 		Material* materials,
 		const std::size_t numMaterials,
+		TransformHierarchy& transforms,
 		NormalCmdListRecorder* &recorder) {
 
 		ASSERT(textures != nullptr);
@@ -113,12 +114,13 @@ namespace {
 			const Mesh& mesh{ meshes[i] };
 			geomData.mVertexBufferData = mesh.VertexBufferData();
 			geomData.mIndexBufferData = mesh.IndexBufferData();
-			geomData.mWorldMatrices.reserve(numMaterials);
+			geomData.mBoundingVolumes = mesh.GetBoundingVolumes();
+			geomData.mTransformHandles.reserve(numMaterials);
 		}
 
 		// Fill material and textures
-		std::vector<Material> materialsVec;
-		materialsVec.resize(numMaterials * numMeshes);
+		std::vector<std::uint32_t> materialIndices;
+		materialIndices.resize(numMaterials * numMeshes);
 		std::vector<ID3D12Resource*> texturesVec;
 		texturesVec.resize(numMaterials * numMeshes);
 		std::vector<ID3D12Resource*> normalsVec;
@@ -130,17 +132,18 @@ namespace {
 		for (std::size_t i = 0UL; i < numMaterials; ++i) {
 			DirectX::XMFLOAT4X4 w;
 			MathUtils::ComputeMatrix(w, tx, ty, tz, scaleFactor, scaleFactor, scaleFactor);
+			const TransformHierarchy::Handle transform{ transforms.AddNode(TransformHierarchy::sInvalidHandle, &w.m[0U][0U]) };
 
-			Material& mat(materials[i]);
+			const std::uint32_t mat{ MaterialRegistry::Get().Register(materials[i]) };
 			ID3D12Resource* texture{ textures[i] };
 			ID3D12Resource* normal{ normals[i] };
 			for (std::size_t j = 0UL; j < numMeshes; ++j) {
 				const std::size_t index{ i + j * numMaterials };
-				materialsVec[index] = mat;
+				materialIndices[index] = mat;
 				texturesVec[index] = texture;
 				normalsVec[index] = normal;
 				GeometryPassCmdListRecorder::GeometryData& geomData{ geomDataVec[j] };
-				geomData.mWorldMatrices.push_back(w);
+				geomData.mTransformHandles.push_back(transform);
 			}
 
 			tx += offsetX;
@@ -153,10 +156,10 @@ namespace {
 		recorder->Init(
 			geomDataVec.data(),
 			static_cast<std::uint32_t>(geomDataVec.size()),
-			materialsVec.data(),
+			materialIndices.data(),
 			texturesVec.data(),
 			normalsVec.data(),
-			static_cast<std::uint32_t>(materialsVec.size()));
+			static_cast<std::uint32_t>(materialIndices.size()));
 	}
 
 	void GenerateRecorder(
@@ -170,6 +173,7 @@ namespace {
 		const std::vector<Mesh>& meshes,
 		Material* materials,
 		const std::size_t numMaterials,
+		TransformHierarchy& transforms,
 		ColorCmdListRecorder* &recorder) {
 
 		// Fill geometry data
@@ -182,12 +186,13 @@ namespace {
 			const Mesh& mesh{ meshes[i] };
 			geomData.mVertexBufferData = mesh.VertexBufferData();
 			geomData.mIndexBufferData = mesh.IndexBufferData();
-			geomData.mWorldMatrices.reserve(numMaterials);
+			geomData.mBoundingVolumes = mesh.GetBoundingVolumes();
+			geomData.mTransformHandles.reserve(numMaterials);
 		}
 
 		// Fill material and textures
-		std::vector<Material> materialsVec;
-		materialsVec.resize(numMaterials * numMeshes);
+		std::vector<std::uint32_t> materialIndices;
+		materialIndices.resize(numMaterials * numMeshes);
 
 		float tx{ initX };
 		float ty{ initY };
@@ -195,13 +200,14 @@ namespace {
 		for (std::size_t i = 0UL; i < numMaterials; ++i) {
 			DirectX::XMFLOAT4X4 w;
 			MathUtils::ComputeMatrix(w, tx, ty, tz, scaleFactor, scaleFactor, scaleFactor);
+			const TransformHierarchy::Handle transform{ transforms.AddNode(TransformHierarchy::sInvalidHandle, &w.m[0U][0U]) };
 
-			Material& mat(materials[i]);
+			const std::uint32_t mat{ MaterialRegistry::Get().Register(materials[i]) };
 			for (std::size_t j = 0UL; j < numMeshes; ++j) {
 				const std::size_t index{ i + j * numMaterials };
-				materialsVec[index] = mat;
+				materialIndices[index] = mat;
 				GeometryPassCmdListRecorder::GeometryData& geomData{ geomDataVec[j] };
-				geomData.mWorldMatrices.push_back(w);
+				geomData.mTransformHandles.push_back(transform);
 			}
 
 			tx += offsetX;
@@ -214,14 +220,15 @@ namespace {
 		recorder->Init(
 			geomDataVec.data(),
 			static_cast<std::uint32_t>(geomDataVec.size()),
-			materialsVec.data(),
-			static_cast<std::uint32_t>(materialsVec.size()));
+			materialIndices.data(),
+			static_cast<std::uint32_t>(materialIndices.size()));
 	}
 
 	void GenerateFloorRecorder(
 		const std::vector<Mesh>& meshes,
 		ID3D12Resource* texture,
 		ID3D12Resource* normal,
+		TransformHierarchy& transforms,
 		NormalCmdListRecorder* &recorder) {
 
 		ASSERT(texture != nullptr);
@@ -230,6 +237,7 @@ namespace {
 		// Compute world matrix
 		DirectX::XMFLOAT4X4 w;
 		MathUtils::ComputeMatrix(w, sFloorTx, sFloorTy, sFloorTz, sFloorScale, sFloorScale, sFloorScale);
+		const TransformHierarchy::Handle transform{ transforms.AddNode(TransformHierarchy::sInvalidHandle, &w.m[0U][0U]) };
 
 		const std::size_t numMeshes{ meshes.size() };
 		ASSERT(numMeshes > 0UL);
@@ -243,12 +251,16 @@ namespace {
 
 			geomData.mVertexBufferData = mesh.VertexBufferData();
 			geomData.mIndexBufferData = mesh.IndexBufferData();
+			geomData.mBoundingVolumes = mesh.GetBoundingVolumes();
 
-			geomData.mWorldMatrices.push_back(w);
+			// The floor occludes what is under it
+			geomData.mOccluderMesh = mesh.GetOccluderMesh();
+
+			geomData.mTransformHandles.push_back(transform);
 		}
 
 		// Fill material
-		Material material{ 1.0f, 1.0f, 1.0f, 0.0f, 0.85f };
+		const std::uint32_t material{ MaterialRegistry::Get().Register(Material{ 1.0f, 1.0f, 1.0f, 0.0f, 0.85f }) };
 
 		// Build recorder
 		recorder = new NormalCmdListRecorder(D3dData::Device());
@@ -265,11 +277,12 @@ namespace {
 void AmbientOcclussionScene::Init(ID3D12CommandQueue& cmdQueue) noexcept {
 	Scene::Init(cmdQueue);
 
-	// Load textures
-	sResourceContainer.LoadTextures(sTexFiles, cmdQueue, *mCmdAlloc, *mCmdList, *mFence);
+	// Upload textures and models read and imported by MasterRender tasks
+	sResourceContainer.Upload(cmdQueue, *mCmdAlloc, *mCmdList, *mFence);
+}
 
-	// Load models
-	sResourceContainer.LoadModels(sModelFiles, cmdQueue, *mCmdAlloc, *mCmdList, *mFence);
+SceneUtils::ResourceContainer* AmbientOcclussionScene::Resources() noexcept {
+	return &sResourceContainer;
 }
 
 void AmbientOcclussionScene::GenerateGeomPassRecorders(
@@ -291,6 +304,7 @@ void AmbientOcclussionScene::GenerateGeomPassRecorders(
 		floor.Meshes(),
 		textures[WOOD],
 		textures[WOOD_NORMAL],
+		mTransforms,
 		recorder);
 	tasks.push_back(std::unique_ptr<GeometryPassCmdListRecorder>(recorder));
 
@@ -355,6 +369,7 @@ void AmbientOcclussionScene::GenerateGeomPassRecorders(
 		normals.data(),
 		materials.data(),
 		materials.size(),
+		mTransforms,
 		recorder);
 	ASSERT(recorder != nullptr);
 	tasks.push_back(std::unique_ptr<GeometryPassCmdListRecorder>(recorder));
@@ -372,6 +387,7 @@ void AmbientOcclussionScene::GenerateGeomPassRecorders(
 		normals.data(),
 		materials.data(),
 		materials.size(),
+		mTransforms,
 		recorder);
 	ASSERT(recorder != nullptr);
 	tasks.push_back(std::unique_ptr<GeometryPassCmdListRecorder>(recorder));
@@ -389,6 +405,7 @@ void AmbientOcclussionScene::GenerateGeomPassRecorders(
 		normals.data(),
 		materials.data(),
 		materials.size(),
+		mTransforms,
 		recorder);
 	ASSERT(recorder != nullptr);
 	tasks.push_back(std::unique_ptr<GeometryPassCmdListRecorder>(recorder));
@@ -406,6 +423,7 @@ void AmbientOcclussionScene::GenerateGeomPassRecorders(
 		normals.data(),
 		materials.data(),
 		materials.size(),
+		mTransforms,
 		recorder);
 	ASSERT(recorder != nullptr);
 	tasks.push_back(std::unique_ptr<GeometryPassCmdListRecorder>(recorder));
@@ -423,6 +441,7 @@ void AmbientOcclussionScene::GenerateGeomPassRecorders(
 		normals.data(),
 		materials.data(),
 		materials.size(),
+		mTransforms,
 		recorder);
 	ASSERT(recorder != nullptr);
 	tasks.push_back(std::unique_ptr<GeometryPassCmdListRecorder>(recorder));
@@ -440,6 +459,7 @@ void AmbientOcclussionScene::GenerateGeomPassRecorders(
 		normals.data(),
 		materials.data(),
 		materials.size(),
+		mTransforms,
 		recorder);
 	ASSERT(recorder != nullptr);
 	tasks.push_back(std::unique_ptr<GeometryPassCmdListRecorder>(recorder));
@@ -457,6 +477,7 @@ void AmbientOcclussionScene::GenerateGeomPassRecorders(
 		normals.data(),
 		materials.data(),
 		materials.size(),
+		mTransforms,
 		recorder);
 	ASSERT(recorder != nullptr);
 	tasks.push_back(std::unique_ptr<GeometryPassCmdListRecorder>(recorder));
@@ -474,6 +495,7 @@ void AmbientOcclussionScene::GenerateGeomPassRecorders(
 		normals.data(),
 		materials.data(),
 		materials.size(),
+		mTransforms,
 		recorder);
 	ASSERT(recorder != nullptr);
 	tasks.push_back(std::unique_ptr<GeometryPassCmdListRecorder>(recorder));
@@ -491,6 +513,7 @@ void AmbientOcclussionScene::GenerateGeomPassRecorders(
 		normals.data(),
 		materials.data(),
 		materials.size(),
+		mTransforms,
 		recorder);
 	ASSERT(recorder != nullptr);
 	tasks.push_back(std::unique_ptr<GeometryPassCmdListRecorder>(recorder));
@@ -508,6 +531,7 @@ void AmbientOcclussionScene::GenerateGeomPassRecorders(
 		normals.data(),
 		materials.data(),
 		materials.size(),
+		mTransforms,
 		recorder);
 	ASSERT(recorder != nullptr);
 	tasks.push_back(std::unique_ptr<GeometryPassCmdListRecorder>(recorder));
@@ -523,11 +547,12 @@ void AmbientOcclussionScene::GenerateLightingPassRecorders(
 
 void AmbientOcclussionScene::GenerateCubeMaps(
 	ID3D12Resource* &skyBoxCubeMap,
-	ID3D12Resource* &diffuseIrradianceCubeMap,
+	SphericalHarmonics::Coefficients& diffuseIrradiance,
 	ID3D12Resource* &specularPreConvolvedCubeMap) noexcept
 {
 	skyBoxCubeMap = &sResourceContainer.GetResource(SKY_BOX);
-	diffuseIrradianceCubeMap = &sResourceContainer.GetResource(DIFFUSE_CUBE_MAP);
+	const bool diffuseIrradianceLoaded{ DiffuseIrradianceSH::LoadFromCubeMapFile(sTexFiles[SKY_BOX].c_str(), diffuseIrradiance) };
+	ASSERT(diffuseIrradianceLoaded);
 	specularPreConvolvedCubeMap = &sResourceContainer.GetResource(SPECULAR_CUBE_MAP);
 }
 
@@ -4,18 +4,18 @@
 
 #include <GeometryPass/Recorders/ColorHeightCmdListRecorder.h>
 #include <GlobalData/D3dData.h>
+#include <LightingPass/LightingPass.h>
 #include <LightingPass/PunctualLight.h>
-#include <LightingPass/Recorders/PunctualLightCmdListRecorder.h>
 #include <Material/Material.h>
+#include <Material/MaterialRegistry.h>
 #include <MathUtils\MathUtils.h>
 #include <ModelManager\Mesh.h>
 #include <ModelManager\ModelManager.h>
+#include <ResourceManager/DiffuseIrradianceSH.h>
 #include <ResourceManager\ResourceManager.h>
 #include <Scene/SceneUtils.h>
 
 namespace {
-	SceneUtils::ResourceContainer sResourceContainer;
-
 	enum Textures {
 		// Normal
 		BRICK2_NORMAL,
@@ -35,7 +35,6 @@ namespace {
 
 		// Environment
 		SKY_BOX,
-		DIFFUSE_CUBE_MAP,
 		SPECULAR_CUBE_MAP,
 
 		TEXTURES_COUNT
@@ -62,7 +61,6 @@ namespace {
 
 		// Environment
 		"textures/cubeMaps/milkmill_cube_map.dds",
-		"textures/cubeMaps/milkmill_diffuse_cube_map.dds",
 		"textures/cubeMaps/milkmill_specular_cube_map.dds",
 	};
 
@@ -77,6 +75,8 @@ namespace {
 		"models/unreal.obj",
 	};
 
+	SceneUtils::ResourceContainer sResourceContainer{ sTexFiles, sModelFiles };
+
 	const float sS{ 0.05f };
 
 	const float sTx1{ 0.0f };
@@ -88,8 +88,8 @@ namespace {
 		Microsoft::WRL::ComPtr<ID3D12Resource>* geometryBuffers,
 		const std::uint32_t geometryBuffersCount,
 		ID3D12Resource& depthBuffer,
-		PunctualLightCmdListRecorder* &recorder) {
-		recorder = new PunctualLightCmdListRecorder(D3dData::Device());
+		LightingPassCmdListRecorder* &recorder) {
+		recorder = LightingPass::CreatePunctualLightCmdListRecorder(D3dData::Device());
 		PunctualLight light[1];
 		light[0].mPosAndRange[0] = 0.0f;
 		light[0].mPosAndRange[1] = 300.0f;
@@ -121,6 +121,7 @@ namespace {
 		ID3D12Resource** heights,
 		Material* materials,
 		const std::size_t numMaterials,
+		TransformHierarchy& transforms,
 		ColorHeightCmdListRecorder* &recorder) {
 
 		ASSERT(normals != nullptr);
@@ -138,11 +139,12 @@ namespace {
 			const Mesh& mesh{ meshes[i] };
 			geomData.mVertexBufferData = mesh.VertexBufferData();
 			geomData.mIndexBufferData = mesh.IndexBufferData();
-			geomData.mWorldMatrices.reserve(numMaterials);
+			geomData.mBoundingVolumes = mesh.GetBoundingVolumes();
+			geomData.mTransformHandles.reserve(numMaterials);
 		}
 
-		std::vector<Material> materialsVec;
-		materialsVec.resize(numMaterials * numMeshes);
+		std::vector<std::uint32_t> materialIndices;
+		materialIndices.resize(numMaterials * numMeshes);
 		std::vector<ID3D12Resource*> normalsVec;
 		normalsVec.resize(numMaterials * numMeshes);
 		std::vector<ID3D12Resource*> heightsVec;
@@ -154,17 +156,18 @@ namespace {
 		for (std::size_t i = 0UL; i < numMaterials; ++i) {
 			DirectX::XMFLOAT4X4 w;
 			MathUtils::ComputeMatrix(w, tx, ty, tz, scaleFactor, scaleFactor, scaleFactor);
+			const TransformHierarchy::Handle transform{ transforms.AddNode(TransformHierarchy::sInvalidHandle, &w.m[0U][0U]) };
 
-			Material& mat(materials[i]);
+			const std::uint32_t mat{ MaterialRegistry::Get().Register(materials[i]) };
 			ID3D12Resource* normal{ normals[i] };
 			ID3D12Resource* height{ heights[i] };
 			for (std::size_t j = 0UL; j < numMeshes; ++j) {
 				const std::size_t index{ i + j * numMaterials };
-				materialsVec[index] = mat;
+				materialIndices[index] = mat;
 				normalsVec[index] = normal;
 				heightsVec[index] = height;
 				GeometryPassCmdListRecorder::GeometryData& geomData{ geomDataVec[j] };
-				geomData.mWorldMatrices.push_back(w);
+				geomData.mTransformHandles.push_back(transform);
 			}
 
 			tx += offsetX;
@@ -175,21 +178,22 @@ namespace {
 		recorder->Init(
 			geomDataVec.data(),
 			static_cast<std::uint32_t>(geomDataVec.size()),
-			materialsVec.data(),
+			materialIndices.data(),
 			normalsVec.data(),
 			heightsVec.data(),
-			static_cast<std::uint32_t>(materialsVec.size()));
+			static_cast<std::uint32_t>(materialIndices.size()));
 	}
 }
 
 void ColorHeightScene::Init(ID3D12CommandQueue& cmdQueue) noexcept {
 	Scene::Init(cmdQueue);
 
-	// Load textures
-	sResourceContainer.LoadTextures(sTexFiles, cmdQueue, *mCmdAlloc, *mCmdList, *mFence);
+	// Upload textures and models read and imported by MasterRender tasks
+	sResourceContainer.Upload(cmdQueue, *mCmdAlloc, *mCmdList, *mFence);
+}
 
-	// Load models
-	sResourceContainer.LoadModels(sModelFiles, cmdQueue, *mCmdAlloc, *mCmdList, *mFence);
+SceneUtils::ResourceContainer* ColorHeightScene::Resources() noexcept {
+	return &sResourceContainer;
 }
 
 void ColorHeightScene::GenerateGeomPassRecorders(
@@ -243,7 +247,7 @@ void ColorHeightScene::GenerateGeomPassRecorders(
 	ASSERT(numResources == _countof(height));
 
 	ColorHeightCmdListRecorder* recorder{ nullptr };
-	GenerateRecorder(sTx1, sTy1, sTz1, sOffsetX1, 0.0f, 0.0f, sS, model.Meshes(), normal, height, materials, numResources, recorder);
+	GenerateRecorder(sTx1, sTy1, sTz1, sOffsetX1, 0.0f, 0.0f, sS, model.Meshes(), normal, height, materials, numResources, mTransforms, recorder);
 	ASSERT(recorder != nullptr);
 	tasks.push_back(std::unique_ptr<GeometryPassCmdListRecorder>(recorder));
 }
@@ -260,7 +264,7 @@ void ColorHeightScene::GenerateLightingPassRecorders(
 	ASSERT(ValidateData());
 
 	tasks.resize(1UL);
-	PunctualLightCmdListRecorder* recorder{ nullptr };
+	LightingPassCmdListRecorder* recorder{ nullptr };
 	GenerateRecorder(
 		geometryBuffers,
 		geometryBuffersCount,
@@ -272,11 +276,12 @@ void ColorHeightScene::GenerateLightingPassRecorders(
 
 void ColorHeightScene::GenerateCubeMaps(
 	ID3D12Resource* &skyBoxCubeMap,
-	ID3D12Resource* &diffuseIrradianceCubeMap,
+	SphericalHarmonics::Coefficients& diffuseIrradiance,
 	ID3D12Resource* &specularPreConvolvedCubeMap) noexcept
 {
 	skyBoxCubeMap = &sResourceContainer.GetResource(SKY_BOX);
-	diffuseIrradianceCubeMap = &sResourceContainer.GetResource(DIFFUSE_CUBE_MAP);
+	const bool diffuseIrradianceLoaded{ DiffuseIrradianceSH::LoadFromCubeMapFile(sTexFiles[SKY_BOX].c_str(), diffuseIrradiance) };
+	ASSERT(diffuseIrradianceLoaded);
 	specularPreConvolvedCubeMap = &sResourceContainer.GetResource(SPECULAR_CUBE_MAP);
 }
 
@@ -4,22 +4,21 @@
 
 #include <GeometryPass/Recorders/ColorCmdListRecorder.h>
 #include <GlobalData/D3dData.h>
+#include <LightingPass/LightingPass.h>
 #include <LightingPass/PunctualLight.h>
-#include <LightingPass/Recorders/PunctualLightCmdListRecorder.h>
 #include <Material/Material.h>
+#include <Material/MaterialRegistry.h>
 #include <MathUtils\MathUtils.h>
 #include <ModelManager\Mesh.h>
 #include <ModelManager\ModelManager.h>
+#include <ResourceManager/DiffuseIrradianceSH.h>
 #include <ResourceManager\ResourceManager.h>
 #include <Scene/SceneUtils.h>
 
 namespace {
-	SceneUtils::ResourceContainer sResourceContainer;
-
 	enum Textures {
 		// Environment
 		SKY_BOX,
-		DIFFUSE_CUBE_MAP,
 		SPECULAR_CUBE_MAP,
 
 		TEXTURES_COUNT
@@ -30,7 +29,6 @@ namespace {
 	{
 		// Environment
 		"textures/cubeMaps/milkmill_cube_map.dds",
-		"textures/cubeMaps/milkmill_diffuse_cube_map.dds",
 		"textures/cubeMaps/milkmill_specular_cube_map.dds",
 	};
 
@@ -45,6 +43,8 @@ namespace {
 		"models/character1.obj",
 	};
 
+	SceneUtils::ResourceContainer sResourceContainer{ sTexFiles, sModelFiles };
+
 	const float sS{ 0.10f };
 
 	const float sTx{ 0.0f };
@@ -56,8 +56,8 @@ namespace {
 		Microsoft::WRL::ComPtr<ID3D12Resource>* geometryBuffers,
 		const std::uint32_t geometryBuffersCount,
 		ID3D12Resource& depthBuffer,
-		PunctualLightCmdListRecorder* &recorder) {
-		recorder = new PunctualLightCmdListRecorder(D3dData::Device());
+		LightingPassCmdListRecorder* &recorder) {
+		recorder = LightingPass::CreatePunctualLightCmdListRecorder(D3dData::Device());
 		PunctualLight light[1];
 		light[0].mPosAndRange[0] = 0.0f;
 		light[0].mPosAndRange[1] = 300.0f;
@@ -84,6 +84,7 @@ namespace {
 		const float offsetY,
 		const float offsetZ,
 		const std::vector<Mesh>& meshes,
+		TransformHierarchy& transforms,
 		ColorCmdListRecorder* &recorder) {
 		recorder = new ColorCmdListRecorder(D3dData::Device());
 
@@ -99,23 +100,25 @@ namespace {
 			const Mesh& mesh{ meshes[i] };
 			geomData.mVertexBufferData = mesh.VertexBufferData();
 			geomData.mIndexBufferData = mesh.IndexBufferData();
-			geomData.mWorldMatrices.reserve(numMaterials);
+			geomData.mBoundingVolumes = mesh.GetBoundingVolumes();
+			geomData.mTransformHandles.reserve(numMaterials);
 		}
 
-		std::vector<Material> materials;
-		materials.resize(numMaterials * numMeshes);
+		std::vector<std::uint32_t> materialIndices;
+		materialIndices.resize(numMaterials * numMeshes);
 		float tx{ initX };
 		float ty{ initY };
 		float tz{ initZ };
 		for (std::size_t i = 0UL; i < numMaterials; ++i) {
 			DirectX::XMFLOAT4X4 w;
 			MathUtils::ComputeMatrix(w, tx, ty, tz, sS, sS, sS, DirectX::XM_PIDIV2);
+			const TransformHierarchy::Handle transform{ transforms.AddNode(TransformHierarchy::sInvalidHandle, &w.m[0U][0U]) };
 
-			Material mat(Materials::GetMaterial(static_cast<Materials::MaterialType>(i)));
+			const std::uint32_t mat{ MaterialRegistry::Get().Register(Materials::GetMaterial(static_cast<Materials::MaterialType>(i))) };
 			for (std::size_t j = 0UL; j < numMeshes; ++j) {
-				materials[i + j * numMaterials] = mat;
+				materialIndices[i + j * numMaterials] = mat;
 				GeometryPassCmdListRecorder::GeometryData& geomData{ geomDataVec[j] };
-				geomData.mWorldMatrices.push_back(w);
+				geomData.mTransformHandles.push_back(transform);
 			}
 
 			tx += offsetX;
@@ -126,19 +129,20 @@ namespace {
 		recorder->Init(
 			geomDataVec.data(), 
 			static_cast<std::uint32_t>(geomDataVec.size()), 
-			materials.data(), 
-			static_cast<std::uint32_t>(materials.size()));
+			materialIndices.data(), 
+			static_cast<std::uint32_t>(materialIndices.size()));
 	}
 }
 
 void ColorMappingScene::Init(ID3D12CommandQueue& cmdQueue) noexcept {
 	Scene::Init(cmdQueue);
 
-	// Load textures
-	sResourceContainer.LoadTextures(sTexFiles, cmdQueue, *mCmdAlloc, *mCmdList, *mFence);
+	// Upload textures and models read and imported by MasterRender tasks
+	sResourceContainer.Upload(cmdQueue, *mCmdAlloc, *mCmdList, *mFence);
+}
 
-	// Load models
-	sResourceContainer.LoadModels(sModelFiles, cmdQueue, *mCmdAlloc, *mCmdList, *mFence);
+SceneUtils::ResourceContainer* ColorMappingScene::Resources() noexcept {
+	return &sResourceContainer;
 }
 
 void ColorMappingScene::GenerateGeomPassRecorders(
@@ -150,7 +154,7 @@ void ColorMappingScene::GenerateGeomPassRecorders(
 	Model& model = sResourceContainer.GetModel(BUNNY);
 
 	ColorCmdListRecorder* recorder{ nullptr };
-	GenerateRecorder(sTx, sTy, sTz, sOffsetX, 0.0f, 0.0f, model.Meshes(), recorder);
+	GenerateRecorder(sTx, sTy, sTz, sOffsetX, 0.0f, 0.0f, model.Meshes(), mTransforms, recorder);
 	ASSERT(recorder != nullptr);
 	tasks.push_back(std::unique_ptr<GeometryPassCmdListRecorder>(recorder));
 }
@@ -167,7 +171,7 @@ void ColorMappingScene::GenerateLightingPassRecorders(
 	ASSERT(ValidateData());
 
 	tasks.resize(1UL);
-	PunctualLightCmdListRecorder* recorder{ nullptr };
+	LightingPassCmdListRecorder* recorder{ nullptr };
 	GenerateRecorder(
 		geometryBuffers, 
 		geometryBuffersCount, 
@@ -179,11 +183,12 @@ void ColorMappingScene::GenerateLightingPassRecorders(
 
 void ColorMappingScene::GenerateCubeMaps(
 	ID3D12Resource* &skyBoxCubeMap,
-	ID3D12Resource* &diffuseIrradianceCubeMap,
+	SphericalHarmonics::Coefficients& diffuseIrradiance,
 	ID3D12Resource* &specularPreConvolvedCubeMap) noexcept 
 {
 	skyBoxCubeMap = &sResourceContainer.GetResource(SKY_BOX);
-	diffuseIrradianceCubeMap = &sResourceContainer.GetResource(DIFFUSE_CUBE_MAP);
+	const bool diffuseIrradianceLoaded{ DiffuseIrradianceSH::LoadFromCubeMapFile(sTexFiles[SKY_BOX].c_str(), diffuseIrradiance) };
+	ASSERT(diffuseIrradianceLoaded);
 	specularPreConvolvedCubeMap = &sResourceContainer.GetResource(SPECULAR_CUBE_MAP);
 }
 
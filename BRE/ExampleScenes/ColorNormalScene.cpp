@@ -4,18 +4,18 @@
 
 #include <GeometryPass/Recorders/ColorNormalCmdListRecorder.h>
 #include <GlobalData/D3dData.h>
+#include <LightingPass/LightingPass.h>
 #include <LightingPass/PunctualLight.h>
-#include <LightingPass/Recorders/PunctualLightCmdListRecorder.h>
 #include <Material/Material.h>
+#include <Material/MaterialRegistry.h>
 #include <MathUtils\MathUtils.h>
 #include <ModelManager\Mesh.h>
 #include <ModelManager\ModelManager.h>
+#include <ResourceManager/DiffuseIrradianceSH.h>
 #include <ResourceManager\ResourceManager.h>
 #include <Scene/SceneUtils.h>
 
 namespace {
-	SceneUtils::ResourceContainer sResourceContainer;
-
 	enum Textures {
 		// Normal
 		ROCK_NORMAL,
@@ -27,7 +27,6 @@ namespace {
 
 		// Environment
 		SKY_BOX,
-		DIFFUSE_CUBE_MAP,
 		SPECULAR_CUBE_MAP,
 
 		TEXTURES_COUNT
@@ -47,7 +46,6 @@ namespace {
 
 		// Environment
 		"textures/cubeMaps/milkmill_cube_map.dds",
-		"textures/cubeMaps/milkmill_diffuse_cube_map.dds",
 		"textures/cubeMaps/milkmill_specular_cube_map.dds",
 	};
 
@@ -62,6 +60,8 @@ namespace {
 		"models/mitsubaFloor.obj",
 	};
 
+	SceneUtils::ResourceContainer sResourceContainer{ sTexFiles, sModelFiles };
+
 	const float sS{ 2.0f };
 
 	const float sTx1{ 0.0f };
@@ -73,8 +73,8 @@ namespace {
 		Microsoft::WRL::ComPtr<ID3D12Resource>* geometryBuffers,
 		const std::uint32_t geometryBuffersCount,
 		ID3D12Resource& depthBuffer,
-		PunctualLightCmdListRecorder* &recorder) {
-		recorder = new PunctualLightCmdListRecorder(D3dData::Device());
+		LightingPassCmdListRecorder* &recorder) {
+		recorder = LightingPass::CreatePunctualLightCmdListRecorder(D3dData::Device());
 		PunctualLight light[1];
 		light[0].mPosAndRange[0] = 0.0f;
 		light[0].mPosAndRange[1] = 300.0f;
@@ -104,6 +104,7 @@ namespace {
 		ID3D12Resource** normals,
 		Material* materials,
 		const std::size_t numMaterials,
+		TransformHierarchy& transforms,
 		ColorNormalCmdListRecorder* &recorder) {
 
 		ASSERT(normals != nullptr);
@@ -120,11 +121,12 @@ namespace {
 			const Mesh& mesh{ meshes[i] };
 			geomData.mVertexBufferData = mesh.VertexBufferData();
 			geomData.mIndexBufferData = mesh.IndexBufferData();
-			geomData.mWorldMatrices.reserve(numMaterials);
+			geomData.mBoundingVolumes = mesh.GetBoundingVolumes();
+			geomData.mTransformHandles.reserve(numMaterials);
 		}
 
-		std::vector<Material> materialsVec;
-		materialsVec.resize(numMaterials * numMeshes);
+		std::vector<std::uint32_t> materialIndices;
+		materialIndices.resize(numMaterials * numMeshes);
 		std::vector<ID3D12Resource*> texturesVec;
 		texturesVec.resize(numMaterials * numMeshes);
 		std::vector<ID3D12Resource*> normalsVec;
@@ -136,15 +138,16 @@ namespace {
 		for (std::size_t i = 0UL; i < numMaterials; ++i) {
 			DirectX::XMFLOAT4X4 w;
 			MathUtils::ComputeMatrix(w, tx, ty, tz, sS, sS, sS);
+			const TransformHierarchy::Handle transform{ transforms.AddNode(TransformHierarchy::sInvalidHandle, &w.m[0U][0U]) };
 
-			Material& mat(materials[i]);
+			const std::uint32_t mat{ MaterialRegistry::Get().Register(materials[i]) };
 			ID3D12Resource* normal{ normals[i] };
 			for (std::size_t j = 0UL; j < numMeshes; ++j) {
 				const std::size_t index{ i + j * numMaterials };
-				materialsVec[index] = mat;
+				materialIndices[index] = mat;
 				normalsVec[index] = normal;
 				GeometryPassCmdListRecorder::GeometryData& geomData{ geomDataVec[j] };
-				geomData.mWorldMatrices.push_back(w);
+				geomData.mTransformHandles.push_back(transform);
 			}
 
 			tx += offsetX;
@@ -155,20 +158,21 @@ namespace {
 		recorder->Init(
 			geomDataVec.data(),
 			static_cast<std::uint32_t>(geomDataVec.size()),
-			materialsVec.data(),
+			materialIndices.data(),
 			normalsVec.data(),
-			static_cast<std::uint32_t>(materialsVec.size()));
+			static_cast<std::uint32_t>(materialIndices.size()));
 	}
 }
 
 void ColorNormalScene::Init(ID3D12CommandQueue& cmdQueue) noexcept {
 	Scene::Init(cmdQueue);
 
-	// Load textures
-	sResourceContainer.LoadTextures(sTexFiles, cmdQueue, *mCmdAlloc, *mCmdList, *mFence);
+	// Upload textures and models read and imported by MasterRender tasks
+	sResourceContainer.Upload(cmdQueue, *mCmdAlloc, *mCmdList, *mFence);
+}
 
-	// Load models
-	sResourceContainer.LoadModels(sModelFiles, cmdQueue, *mCmdAlloc, *mCmdList, *mFence);
+SceneUtils::ResourceContainer* ColorNormalScene::Resources() noexcept {
+	return &sResourceContainer;
 }
 
 void ColorNormalScene::GenerateGeomPassRecorders(
@@ -203,7 +207,7 @@ void ColorNormalScene::GenerateGeomPassRecorders(
 	ASSERT(numResources == _countof(normal));
 
 	ColorNormalCmdListRecorder* recorder{ nullptr };
-	GenerateRecorder(sTx1, sTy1, sTz1, sOffsetX1, 0.0f, 0.0f, model.Meshes(), normal, materials, numResources, recorder);
+	GenerateRecorder(sTx1, sTy1, sTz1, sOffsetX1, 0.0f, 0.0f, model.Meshes(), normal, materials, numResources, mTransforms, recorder);
 	ASSERT(recorder != nullptr);
 	tasks.push_back(std::unique_ptr<GeometryPassCmdListRecorder>(recorder));
 }
@@ -220,7 +224,7 @@ void ColorNormalScene::GenerateLightingPassRecorders(
 	ASSERT(ValidateData());
 
 	tasks.resize(1UL);
-	PunctualLightCmdListRecorder* recorder{ nullptr };
+	LightingPassCmdListRecorder* recorder{ nullptr };
 	GenerateRecorder(
 		geometryBuffers,
 		geometryBuffersCount,
@@ -232,11 +236,12 @@ void ColorNormalScene::GenerateLightingPassRecorders(
 
 void ColorNormalScene::GenerateCubeMaps(
 	ID3D12Resource* &skyBoxCubeMap,
-	ID3D12Resource* &diffuseIrradianceCubeMap,
+	SphericalHarmonics::Coefficients& diffuseIrradiance,
 	ID3D12Resource* &specularPreConvolvedCubeMap) noexcept
 {
 	skyBoxCubeMap = &sResourceContainer.GetResource(SKY_BOX);
-	diffuseIrradianceCubeMap = &sResourceContainer.GetResource(DIFFUSE_CUBE_MAP);
+	const bool diffuseIrradianceLoaded{ DiffuseIrradianceSH::LoadFromCubeMapFile(sTexFiles[SKY_BOX].c_str(), diffuseIrradiance) };
+	ASSERT(diffuseIrradianceLoaded);
 	specularPreConvolvedCubeMap = &sResourceContainer.GetResource(SPECULAR_CUBE_MAP);
 }
 
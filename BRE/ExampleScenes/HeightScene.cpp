@@ -4,18 +4,18 @@
 
 #include <GeometryPass/Recorders/HeightCmdListRecorder.h>
 #include <GlobalData/D3dData.h>
+#include <LightingPass/LightingPass.h>
 #include <LightingPass/PunctualLight.h>
-#include <LightingPass/Recorders/PunctualLightCmdListRecorder.h>
 #include <Material/Material.h>
+#include <Material/MaterialRegistry.h>
 #include <MathUtils\MathUtils.h>
 #include <ModelManager\Mesh.h>
 #include <ModelManager\ModelManager.h>
+#include <ResourceManager/DiffuseIrradianceSH.h>
 #include <ResourceManager\ResourceManager.h>
 #include <Scene/SceneUtils.h>
 
 namespace {
-	SceneUtils::ResourceContainer sResourceContainer;
-
 	enum Textures {
 		// Diffuse
 		BRICK2,
@@ -43,7 +43,6 @@ namespace {
 
 		// Environment
 		SKY_BOX,
-		DIFFUSE_CUBE_MAP,
 		SPECULAR_CUBE_MAP,
 
 		TEXTURES_COUNT
@@ -78,7 +77,6 @@ namespace {
 
 		// Environment
 		"textures/cubeMaps/milkmill_cube_map.dds",
-		"textures/cubeMaps/milkmill_diffuse_cube_map.dds",
 		"textures/cubeMaps/milkmill_specular_cube_map.dds",
 	};
 
@@ -93,6 +91,8 @@ namespace {
 		"models/unreal.obj",
 	};
 
+	SceneUtils::ResourceContainer sResourceContainer{ sTexFiles, sModelFiles };
+
 	const float sS{ 0.05f };
 	const float sTx1{ 0.0f };
 	const float sTy1{ -3.5f };
@@ -103,8 +103,8 @@ namespace {
 		Microsoft::WRL::ComPtr<ID3D12Resource>* geometryBuffers,
 		const std::uint32_t geometryBuffersCount,
 		ID3D12Resource& depthBuffer,
-		PunctualLightCmdListRecorder* &recorder) {
-		recorder = new PunctualLightCmdListRecorder(D3dData::Device());
+		LightingPassCmdListRecorder* &recorder) {
+		recorder = LightingPass::CreatePunctualLightCmdListRecorder(D3dData::Device());
 		PunctualLight light[1];
 		light[0].mPosAndRange[0] = 0.0f;
 		light[0].mPosAndRange[1] = 300.0f;
@@ -137,6 +137,7 @@ namespace {
 		ID3D12Resource** heights,
 		Material* materials,
 		const std::size_t numMaterials,
+		TransformHierarchy& transforms,
 		HeightCmdListRecorder* &recorder) {
 
 		ASSERT(textures != nullptr);
@@ -155,11 +156,12 @@ namespace {
 			const Mesh& mesh{ meshes[i] };
 			geomData.mVertexBufferData = mesh.VertexBufferData();
 			geomData.mIndexBufferData = mesh.IndexBufferData();
-			geomData.mWorldMatrices.reserve(numMaterials);
+			geomData.mBoundingVolumes = mesh.GetBoundingVolumes();
+			geomData.mTransformHandles.reserve(numMaterials);
 		}
 
-		std::vector<Material> materialsVec;
-		materialsVec.resize(numMaterials * numMeshes);
+		std::vector<std::uint32_t> materialIndices;
+		materialIndices.resize(numMaterials * numMeshes);
 		std::vector<ID3D12Resource*> texturesVec;
 		texturesVec.resize(numMaterials * numMeshes);
 		std::vector<ID3D12Resource*> normalsVec;
@@ -173,19 +175,20 @@ namespace {
 		for (std::size_t i = 0UL; i < numMaterials; ++i) {
 			DirectX::XMFLOAT4X4 w;
 			MathUtils::ComputeMatrix(w, tx, ty, tz, scaleFactor, scaleFactor, scaleFactor);
+			const TransformHierarchy::Handle transform{ transforms.AddNode(TransformHierarchy::sInvalidHandle, &w.m[0U][0U]) };
 
-			Material& mat(materials[i]);
+			const std::uint32_t mat{ MaterialRegistry::Get().Register(materials[i]) };
 			ID3D12Resource* texture{ textures[i] };
 			ID3D12Resource* normal{ normals[i] };
 			ID3D12Resource* height{ heights[i] };
 			for (std::size_t j = 0UL; j < numMeshes; ++j) {
 				const std::size_t index{ i + j * numMaterials };
-				materialsVec[index] = mat;
+				materialIndices[index] = mat;
 				texturesVec[index] = texture;
 				normalsVec[index] = normal;
 				heightsVec[index] = height;
 				GeometryPassCmdListRecorder::GeometryData& geomData{ geomDataVec[j] };
-				geomData.mWorldMatrices.push_back(w);
+				geomData.mTransformHandles.push_back(transform);
 			}
 
 			tx += offsetX;
@@ -196,23 +199,24 @@ namespace {
 		recorder->Init(
 			geomDataVec.data(), 
 			static_cast<std::uint32_t>(geomDataVec.size()), 
-			materialsVec.data(), 
+			materialIndices.data(), 
 			texturesVec.data(), 
 			normalsVec.data(), 
 			heightsVec.data(), 
-			static_cast<std::uint32_t>(materialsVec.size()));
+			static_cast<std::uint32_t>(materialIndices.size()));
 	}
 }
 
 void HeightScene::Init(ID3D12CommandQueue& cmdQueue) noexcept {
 	Scene::Init(cmdQueue);
 
-	// Load textures
-	sResourceContainer.LoadTextures(sTexFiles, cmdQueue, *mCmdAlloc, *mCmdList, *mFence);
+	// Upload textures and models read and imported by MasterRender tasks
+	sResourceContainer.Upload(cmdQueue, *mCmdAlloc, *mCmdList, *mFence);
+}
 
-	// Load models
-	sResourceContainer.LoadModels(sModelFiles, cmdQueue, *mCmdAlloc, *mCmdList, *mFence);
-}		
+SceneUtils::ResourceContainer* HeightScene::Resources() noexcept {
+	return &sResourceContainer;
+}
 
 void HeightScene::GenerateGeomPassRecorders(
 	std::vector<std::unique_ptr<GeometryPassCmdListRecorder>>& tasks) noexcept {
@@ -275,7 +279,7 @@ void HeightScene::GenerateGeomPassRecorders(
 	ASSERT(numResources == _countof(height));
 	
 	HeightCmdListRecorder* recorder{ nullptr };
-	GenerateRecorder(sTx1, sTy1, sTz1, sOffsetX1, 0.0f, 0.0f, sS, model.Meshes(), tex, normal, height, materials, numResources, recorder);
+	GenerateRecorder(sTx1, sTy1, sTz1, sOffsetX1, 0.0f, 0.0f, sS, model.Meshes(), tex, normal, height, materials, numResources, mTransforms, recorder);
 	ASSERT(recorder != nullptr);
 	tasks.push_back(std::unique_ptr<GeometryPassCmdListRecorder>(recorder));
 }
@@ -292,7 +296,7 @@ void HeightScene::GenerateLightingPassRecorders(
 	ASSERT(ValidateData());
 	
 	tasks.resize(1UL);
-	PunctualLightCmdListRecorder* recorder{ nullptr };
+	LightingPassCmdListRecorder* recorder{ nullptr };
 	GenerateRecorder(
 		geometryBuffers, 
 		geometryBuffersCount, 
@@ -304,11 +308,12 @@ void HeightScene::GenerateLightingPassRecorders(
 
 void HeightScene::GenerateCubeMaps(
 	ID3D12Resource* &skyBoxCubeMap,
-	ID3D12Resource* &diffuseIrradianceCubeMap,
+	SphericalHarmonics::Coefficients& diffuseIrradiance,
 	ID3D12Resource* &specularPreConvolvedCubeMap) noexcept
 {
 	skyBoxCubeMap = &sResourceContainer.GetResource(SKY_BOX);
-	diffuseIrradianceCubeMap = &sResourceContainer.GetResource(DIFFUSE_CUBE_MAP);
+	const bool diffuseIrradianceLoaded{ DiffuseIrradianceSH::LoadFromCubeMapFile(sTexFiles[SKY_BOX].c_str(), diffuseIrradiance) };
+	ASSERT(diffuseIrradianceLoaded);
 	specularPreConvolvedCubeMap = &sResourceContainer.GetResource(SPECULAR_CUBE_MAP);
 }
 
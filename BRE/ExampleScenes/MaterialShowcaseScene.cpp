@@ -6,15 +6,15 @@
 #include <GeometryPass/Recorders/NormalCmdListRecorder.h>
 #include <GlobalData/D3dData.h>
 #include <Material/Material.h>
+#include <Material/MaterialRegistry.h>
 #include <MathUtils\MathUtils.h>
 #include <ModelManager\Mesh.h>
 #include <ModelManager\ModelManager.h>
+#include <ResourceManager/DiffuseIrradianceSH.h>
 #include <ResourceManager\ResourceManager.h>
 #include <Scene/SceneUtils.h>
 
 namespace {
-	SceneUtils::ResourceContainer sResourceContainer;
-
 	enum Textures {
 		// Metal
 		METAL = 0U,
@@ -67,7 +67,6 @@ namespace {
 
 		// Environment
 		SKY_BOX,
-		DIFFUSE_CUBE_MAP,
 		SPECULAR_CUBE_MAP,
 
 		TEXTURES_COUNT
@@ -127,7 +126,6 @@ namespace {
 
 		// Environment
 		"textures/cubeMaps/milkmill_cube_map.dds",
-		"textures/cubeMaps/milkmill_diffuse_cube_map.dds",
 		"textures/cubeMaps/milkmill_specular_cube_map.dds",
 	};
 
@@ -149,6 +147,8 @@ namespace {
 		"models/floor.obj",
 	};
 
+	SceneUtils::ResourceContainer sResourceContainer{ sTexFiles, sModelFiles };
+
 	const float sFloorScale{ 1.0f };
 	const float sFloorTx{ -150.0f };
 	const float sFloorTy{ -20.5f };
@@ -199,6 +199,7 @@ namespace {
 		ID3D12Resource** normals,
 		Material* materials,
 		const std::size_t numMaterials,
+		TransformHierarchy& transforms,
 		NormalCmdListRecorder* &recorder) {
 
 		ASSERT(textures != nullptr);
@@ -214,12 +215,13 @@ namespace {
 			const Mesh& mesh{ meshes[i] };
 			geomData.mVertexBufferData = mesh.VertexBufferData();
 			geomData.mIndexBufferData = mesh.IndexBufferData();
-			geomData.mWorldMatrices.reserve(numMaterials);
+			geomData.mBoundingVolumes = mesh.GetBoundingVolumes();
+			geomData.mTransformHandles.reserve(numMaterials);
 		}
 
 		// Fill material and textures
-		std::vector<Material> materialsVec;
-		materialsVec.resize(numMaterials * numMeshes);
+		std::vector<std::uint32_t> materialIndices;
+		materialIndices.resize(numMaterials * numMeshes);
 		std::vector<ID3D12Resource*> texturesVec;
 		texturesVec.resize(numMaterials * numMeshes);
 		std::vector<ID3D12Resource*> normalsVec;
@@ -231,17 +233,18 @@ namespace {
 		for (std::size_t i = 0UL; i < numMaterials; ++i) {
 			DirectX::XMFLOAT4X4 w;
 			MathUtils::ComputeMatrix(w, tx, ty, tz, scaleFactor, scaleFactor, scaleFactor);
+			const TransformHierarchy::Handle transform{ transforms.AddNode(TransformHierarchy::sInvalidHandle, &w.m[0U][0U]) };
 
-			Material& mat(materials[i]);
+			const std::uint32_t mat{ MaterialRegistry::Get().Register(materials[i]) };
 			ID3D12Resource* texture{ textures[i] };
 			ID3D12Resource* normal{ normals[i] };
 			for (std::size_t j = 0UL; j < numMeshes; ++j) {
 				const std::size_t index{ i + j * numMaterials };
-				materialsVec[index] = mat;
+				materialIndices[index] = mat;
 				texturesVec[index] = texture;
 				normalsVec[index] = normal;
 				GeometryPassCmdListRecorder::GeometryData& geomData{ geomDataVec[j] };
-				geomData.mWorldMatrices.push_back(w);
+				geomData.mTransformHandles.push_back(transform);
 			}
 
 			tx += offsetX;
@@ -254,10 +257,10 @@ namespace {
 		recorder->Init(
 			geomDataVec.data(), 
 			static_cast<std::uint32_t>(geomDataVec.size()), 
-			materialsVec.data(), 
+			materialIndices.data(), 
 			texturesVec.data(), 
 			normalsVec.data(), 
-			static_cast<std::uint32_t>(materialsVec.size()));
+			static_cast<std::uint32_t>(materialIndices.size()));
 	}
 
 	void GenerateRecorder(
@@ -271,6 +274,7 @@ namespace {
 		const std::vector<Mesh>& meshes,
 		Material* materials,
 		const std::size_t numMaterials,
+		TransformHierarchy& transforms,
 		ColorCmdListRecorder* &recorder) {
 
 		// Fill geometry data
@@ -283,12 +287,13 @@ namespace {
 			const Mesh& mesh{ meshes[i] };
 			geomData.mVertexBufferData = mesh.VertexBufferData();
 			geomData.mIndexBufferData = mesh.IndexBufferData();
-			geomData.mWorldMatrices.reserve(numMaterials);
+			geomData.mBoundingVolumes = mesh.GetBoundingVolumes();
+			geomData.mTransformHandles.reserve(numMaterials);
 		}
 
 		// Fill material and textures
-		std::vector<Material> materialsVec;
-		materialsVec.resize(numMaterials * numMeshes);
+		std::vector<std::uint32_t> materialIndices;
+		materialIndices.resize(numMaterials * numMeshes);
 
 		float tx{ initX };
 		float ty{ initY };
@@ -296,13 +301,14 @@ namespace {
 		for (std::size_t i = 0UL; i < numMaterials; ++i) {
 			DirectX::XMFLOAT4X4 w;
 			MathUtils::ComputeMatrix(w, tx, ty, tz, scaleFactor, scaleFactor, scaleFactor);
+			const TransformHierarchy::Handle transform{ transforms.AddNode(TransformHierarchy::sInvalidHandle, &w.m[0U][0U]) };
 
-			Material& mat(materials[i]);
+			const std::uint32_t mat{ MaterialRegistry::Get().Register(materials[i]) };
 			for (std::size_t j = 0UL; j < numMeshes; ++j) {
 				const std::size_t index{ i + j * numMaterials };
-				materialsVec[index] = mat;
+				materialIndices[index] = mat;
 				GeometryPassCmdListRecorder::GeometryData& geomData{ geomDataVec[j] };
-				geomData.mWorldMatrices.push_back(w);
+				geomData.mTransformHandles.push_back(transform);
 			}
 
 			tx += offsetX;
@@ -315,14 +321,15 @@ namespace {
 		recorder->Init(
 			geomDataVec.data(),
 			static_cast<std::uint32_t>(geomDataVec.size()),
-			materialsVec.data(),
-			static_cast<std::uint32_t>(materialsVec.size()));
+			materialIndices.data(),
+			static_cast<std::uint32_t>(materialIndices.size()));
 	}
 
 	void GenerateFloorRecorder(
 		const std::vector<Mesh>& meshes,
 		ID3D12Resource* texture,
 		ID3D12Resource* normal,
+		TransformHierarchy& transforms,
 		NormalCmdListRecorder* &recorder) {
 
 		ASSERT(texture != nullptr);
@@ -331,6 +338,7 @@ namespace {
 		// Compute world matrix
 		DirectX::XMFLOAT4X4 w;
 		MathUtils::ComputeMatrix(w, sFloorTx, sFloorTy, sFloorTz, sFloorScale, sFloorScale, sFloorScale);
+		const TransformHierarchy::Handle transform{ transforms.AddNode(TransformHierarchy::sInvalidHandle, &w.m[0U][0U]) };
 
 		const std::size_t numMeshes{ meshes.size() };
 		ASSERT(numMeshes > 0UL);
@@ -344,12 +352,16 @@ namespace {
 
 			geomData.mVertexBufferData = mesh.VertexBufferData();
 			geomData.mIndexBufferData = mesh.IndexBufferData();
+			geomData.mBoundingVolumes = mesh.GetBoundingVolumes();
+
+			// The floor occludes what is under it
+			geomData.mOccluderMesh = mesh.GetOccluderMesh();
 			
-			geomData.mWorldMatrices.push_back(w);
+			geomData.mTransformHandles.push_back(transform);
 		}
 
 		// Fill material
-		Material material{ 1.0f, 1.0f, 1.0f, 0.0f, 0.85f };
+		const std::uint32_t material{ MaterialRegistry::Get().Register(Material{ 1.0f, 1.0f, 1.0f, 0.0f, 0.85f }) };
 
 		// Build recorder
 		recorder = new NormalCmdListRecorder(D3dData::Device());
@@ -366,11 +378,12 @@ namespace {
 void MaterialShowcaseScene::Init(ID3D12CommandQueue& cmdQueue) noexcept {
 	Scene::Init(cmdQueue);
 
-	// Load textures
-	sResourceContainer.LoadTextures(sTexFiles, cmdQueue, *mCmdAlloc, *mCmdList, *mFence);	
+	// Upload textures and models read and imported by MasterRender tasks
+	sResourceContainer.Upload(cmdQueue, *mCmdAlloc, *mCmdList, *mFence);
+}
 
-	// Load models
-	sResourceContainer.LoadModels(sModelFiles, cmdQueue, *mCmdAlloc, *mCmdList, *mFence);
+SceneUtils::ResourceContainer* MaterialShowcaseScene::Resources() noexcept {
+	return &sResourceContainer;
 }
 
 void MaterialShowcaseScene::GenerateGeomPassRecorders(
@@ -394,6 +407,7 @@ void MaterialShowcaseScene::GenerateGeomPassRecorders(
 		floor.Meshes(),
 		textures[WOOD],
 		textures[WOOD_NORMAL],
+		mTransforms,
 		normalRecorder);
 	tasks.push_back(std::unique_ptr<GeometryPassCmdListRecorder>(normalRecorder));
 
@@ -455,6 +469,7 @@ void MaterialShowcaseScene::GenerateGeomPassRecorders(
 		normals.data(), 
 		materials.data(), 
 		materials.size(),
+		mTransforms,
 		normalRecorder);
 	ASSERT(normalRecorder != nullptr);
 	tasks.push_back(std::unique_ptr<GeometryPassCmdListRecorder>(normalRecorder));
@@ -500,6 +515,7 @@ void MaterialShowcaseScene::GenerateGeomPassRecorders(
 		normals.data(),
 		materials.data(),
 		materials.size(),
+		mTransforms,
 		normalRecorder);
 	ASSERT(normalRecorder != nullptr);
 	tasks.push_back(std::unique_ptr<GeometryPassCmdListRecorder>(normalRecorder));
@@ -569,6 +585,7 @@ void MaterialShowcaseScene::GenerateGeomPassRecorders(
 		normals.data(),
 		materials.data(),
 		materials.size(),
+		mTransforms,
 		normalRecorder);
 	ASSERT(normalRecorder != nullptr);
 	tasks.push_back(std::unique_ptr<GeometryPassCmdListRecorder>(normalRecorder));
@@ -638,6 +655,7 @@ void MaterialShowcaseScene::GenerateGeomPassRecorders(
 		normals.data(),
 		materials.data(),
 		materials.size(),
+		mTransforms,
 		normalRecorder);
 	ASSERT(normalRecorder != nullptr);
 	tasks.push_back(std::unique_ptr<GeometryPassCmdListRecorder>(normalRecorder));
@@ -665,6 +683,7 @@ void MaterialShowcaseScene::GenerateGeomPassRecorders(
 		buddha.Meshes(),
 		materials.data(),
 		materials.size(),
+		mTransforms,
 		colorRecorder);
 	ASSERT(colorRecorder != nullptr);
 	tasks.push_back(std::unique_ptr<GeometryPassCmdListRecorder>(colorRecorder));
@@ -691,6 +710,7 @@ void MaterialShowcaseScene::GenerateGeomPassRecorders(
 		bunny.Meshes(),
 		materials.data(),
 		materials.size(),
+		mTransforms,
 		colorRecorder);
 	ASSERT(colorRecorder != nullptr);
 	tasks.push_back(std::unique_ptr<GeometryPassCmdListRecorder>(colorRecorder));
@@ -706,11 +726,12 @@ void MaterialShowcaseScene::GenerateLightingPassRecorders(
 
 void MaterialShowcaseScene::GenerateCubeMaps(
 	ID3D12Resource* &skyBoxCubeMap,
-	ID3D12Resource* &diffuseIrradianceCubeMap,
+	SphericalHarmonics::Coefficients& diffuseIrradiance,
 	ID3D12Resource* &specularPreConvolvedCubeMap) noexcept
 {
 	skyBoxCubeMap = &sResourceContainer.GetResource(SKY_BOX);
-	diffuseIrradianceCubeMap = &sResourceContainer.GetResource(DIFFUSE_CUBE_MAP);
+	const bool diffuseIrradianceLoaded{ DiffuseIrradianceSH::LoadFromCubeMapFile(sTexFiles[SKY_BOX].c_str(), diffuseIrradiance) };
+	ASSERT(diffuseIrradianceLoaded);
 	specularPreConvolvedCubeMap = &sResourceContainer.GetResource(SPECULAR_CUBE_MAP);
 }
 
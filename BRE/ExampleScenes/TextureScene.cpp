@@ -4,25 +4,24 @@
 
 #include <GeometryPass/Recorders/TextureCmdListRecorder.h>
 #include <GlobalData/D3dData.h>
+#include <LightingPass/LightingPass.h>
 #include <LightingPass/PunctualLight.h>
-#include <LightingPass/Recorders/PunctualLightCmdListRecorder.h>
 #include <Material/Material.h>
+#include <Material/MaterialRegistry.h>
 #include <MathUtils/MathUtils.h>
 #include <ModelManager\Mesh.h>
 #include <ModelManager\ModelManager.h>
+#include <ResourceManager/DiffuseIrradianceSH.h>
 #include <ResourceManager\ResourceManager.h>
 #include <Scene/SceneUtils.h>
 
 namespace {
-	SceneUtils::ResourceContainer sResourceContainer;
-
 	enum Textures {		
 		BRICK,
 		BRICK3,
 
 		// Environment
 		SKY_BOX,
-		DIFFUSE_CUBE_MAP,
 		SPECULAR_CUBE_MAP,
 
 		TEXTURES_COUNT
@@ -36,7 +35,6 @@ namespace {
 
 		// Environment
 		"textures/cubeMaps/milkmill_cube_map.dds",
-		"textures/cubeMaps/milkmill_diffuse_cube_map.dds",
 		"textures/cubeMaps/milkmill_specular_cube_map.dds",
 	};
 
@@ -50,16 +48,19 @@ namespace {
 	{
 		"models/unreal.obj",
 	};
+
+	SceneUtils::ResourceContainer sResourceContainer{ sTexFiles, sModelFiles };
 }
 
 void TextureScene::Init(ID3D12CommandQueue& cmdQueue) noexcept {
 	Scene::Init(cmdQueue);
 
-	// Load textures
-	sResourceContainer.LoadTextures(sTexFiles, cmdQueue, *mCmdAlloc, *mCmdList, *mFence);
+	// Upload textures and models read and imported by MasterRender tasks
+	sResourceContainer.Upload(cmdQueue, *mCmdAlloc, *mCmdList, *mFence);
+}
 
-	// Load models
-	sResourceContainer.LoadModels(sModelFiles, cmdQueue, *mCmdAlloc, *mCmdList, *mFence);
+SceneUtils::ResourceContainer* TextureScene::Resources() noexcept {
+	return &sResourceContainer;
 }
 
 void TextureScene::GenerateGeomPassRecorders(
@@ -78,16 +79,29 @@ void TextureScene::GenerateGeomPassRecorders(
 	ASSERT(model.HasMeshes());	
 	const Mesh& mesh{ model.Meshes()[0U] };
 
+	// Transforms are not thread safe, so they are added before recorders are built in parallel
+	const float meshSpaceOffset{ 100.0f };
+	const float scaleFactor{ 0.02f };
 	std::vector<GeometryPassCmdListRecorder::GeometryData> geomDataVec;
 	geomDataVec.resize(Settings::sCpuProcessors);
 	for (GeometryPassCmdListRecorder::GeometryData& geomData : geomDataVec) {
 		geomData.mVertexBufferData = mesh.VertexBufferData();
 		geomData.mIndexBufferData = mesh.IndexBufferData();
-		geomData.mWorldMatrices.reserve(numGeometry);
+		geomData.mBoundingVolumes = mesh.GetBoundingVolumes();
+		geomData.mTransformHandles.reserve(numGeometry);
+		for (std::size_t i = 0UL; i < numGeometry; ++i) {
+			const float tx{ MathUtils::RandF(-meshSpaceOffset, meshSpaceOffset) };
+			const float ty{ MathUtils::RandF(-meshSpaceOffset, meshSpaceOffset) };
+			const float tz{ MathUtils::RandF(-meshSpaceOffset, meshSpaceOffset) };
+
+			const float s{ scaleFactor };
+
+			DirectX::XMFLOAT4X4 world;
+			DirectX::XMStoreFloat4x4(&world, DirectX::XMMatrixScaling(s, s, s) * DirectX::XMMatrixTranslation(tx, ty, tz));
+			geomData.mTransformHandles.push_back(mTransforms.AddNode(TransformHierarchy::sInvalidHandle, &world.m[0U][0U]));
+		}
 	}
 
-	const float meshSpaceOffset{ 100.0f };
-	const float scaleFactor{ 0.02f };
 	tbb::parallel_for(tbb::blocked_range<std::size_t>(0, Settings::sCpuProcessors, numGeometry),
 		[&](const tbb::blocked_range<size_t>& r) {
 		for (size_t k = r.begin(); k != r.end(); ++k) {
@@ -95,24 +109,13 @@ void TextureScene::GenerateGeomPassRecorders(
 			tasks[k].reset(&task);
 							
 			GeometryPassCmdListRecorder::GeometryData& currGeomData{ geomDataVec[k] };
-			for (std::size_t i = 0UL; i < numGeometry; ++i) {
-				const float tx{ MathUtils::RandF(-meshSpaceOffset, meshSpaceOffset) };
-				const float ty{ MathUtils::RandF(-meshSpaceOffset, meshSpaceOffset) };
-				const float tz{ MathUtils::RandF(-meshSpaceOffset, meshSpaceOffset) };
-
-				const float s{ scaleFactor };
-
-				DirectX::XMFLOAT4X4 world;
-				DirectX::XMStoreFloat4x4(&world, DirectX::XMMatrixScaling(s, s, s) * DirectX::XMMatrixTranslation(tx, ty, tz));
-				currGeomData.mWorldMatrices.push_back(world);
-			}
 
-			std::vector<Material> materials;
-			materials.reserve(numGeometry);
+			std::vector<std::uint32_t> materialIndices;
+			materialIndices.reserve(numGeometry);
 			for (std::size_t i = 0UL; i < numGeometry; ++i) {
 				Material material;
 				material.RandomMaterial();
-				materials.push_back(material);
+				materialIndices.push_back(MaterialRegistry::Get().Register(material));
 			}
 
 			std::vector<ID3D12Resource*> tex;
@@ -121,7 +124,7 @@ void TextureScene::GenerateGeomPassRecorders(
 				tex.push_back(textures[i % 2]);
 			}
 
-			task.Init(&currGeomData, 1U, materials.data(), tex.data(), static_cast<std::uint32_t>(tex.size()));
+			task.Init(&currGeomData, 1U, materialIndices.data(), tex.data(), static_cast<std::uint32_t>(tex.size()));
 		}
 	}
 	);
@@ -144,7 +147,7 @@ void TextureScene::GenerateLightingPassRecorders(
 	tbb::parallel_for(tbb::blocked_range<std::size_t>(0, numTasks, 1U),
 		[&](const tbb::blocked_range<size_t>& r) {
 		for (size_t k = r.begin(); k != r.end(); ++k) {
-			PunctualLightCmdListRecorder& task{ *new PunctualLightCmdListRecorder(D3dData::Device()) };
+			LightingPassCmdListRecorder& task{ *LightingPass::CreatePunctualLightCmdListRecorder(D3dData::Device()) };
 			tasks[k].reset(&task);
 			PunctualLight light[2];
 			light[0].mPosAndRange[0] = 0.0f;
@@ -178,10 +181,11 @@ void TextureScene::GenerateLightingPassRecorders(
 
 void TextureScene::GenerateCubeMaps(
 	ID3D12Resource* &skyBoxCubeMap,
-	ID3D12Resource* &diffuseIrradianceCubeMap,
+	SphericalHarmonics::Coefficients& diffuseIrradiance,
 	ID3D12Resource* &specularPreConvolvedCubeMap) noexcept
 {
 	skyBoxCubeMap = &sResourceContainer.GetResource(SKY_BOX);
-	diffuseIrradianceCubeMap = &sResourceContainer.GetResource(DIFFUSE_CUBE_MAP);
+	const bool diffuseIrradianceLoaded{ DiffuseIrradianceSH::LoadFromCubeMapFile(sTexFiles[SKY_BOX].c_str(), diffuseIrradiance) };
+	ASSERT(diffuseIrradianceLoaded);
 	specularPreConvolvedCubeMap = &sResourceContainer.GetResource(SPECULAR_CUBE_MAP);
 }
\ No newline at end of file
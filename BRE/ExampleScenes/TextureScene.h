@@ -13,6 +13,8 @@ public:
 
 	void Init(ID3D12CommandQueue& cmdQueue) noexcept final override;
 
+	SceneUtils::ResourceContainer* Resources() noexcept final override;
+
 	void GenerateGeomPassRecorders(
 		std::vector<std::unique_ptr<GeometryPassCmdListRecorder>>& tasks) noexcept final override;
 	
@@ -24,6 +26,6 @@ public:
 
 	void GenerateCubeMaps(
 		ID3D12Resource* &skyBoxCubeMap,
-		ID3D12Resource* &diffuseIrradianceCubeMap,
+		SphericalHarmonics::Coefficients& diffuseIrradiance,
 		ID3D12Resource* &specularPreConvolvedCubeMap) noexcept final override;
 };
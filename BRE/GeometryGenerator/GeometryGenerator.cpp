@@ -1,6 +1,10 @@
 #include "GeometryGenerator.h"
 
 #include <algorithm>
+#include <tbb/parallel_for.h>
+#include <unordered_map>
+
+#include <Utils/DebugUtils.h>
 
 using namespace DirectX;
 
@@ -12,8 +16,8 @@ namespace {
 		const XMVECTOR n0(XMLoadFloat3(&v0.mNormal));
 		const XMVECTOR n1(XMLoadFloat3(&v1.mNormal));
 
-		const XMVECTOR tan0(XMLoadFloat3(&v0.mTangentU));
-		const XMVECTOR tan1(XMLoadFloat3(&v1.mTangentU));
+		const XMVECTOR tan0(XMLoadFloat4(&v0.mTangentU));
+		const XMVECTOR tan1(XMLoadFloat4(&v1.mTangentU));
 
 		const XMVECTOR tex0(XMLoadFloat2(&v0.mTexC));
 		const XMVECTOR tex1(XMLoadFloat2(&v1.mTexC));
@@ -22,24 +26,56 @@ namespace {
 		// since linear interpolating can make them not unit length.  
 		const XMVECTOR pos(0.5f * (p0 + p1));
 		const XMVECTOR normal(XMVector3Normalize(0.5f * (n0 + n1)));
-		const XMVECTOR tangent(XMVector3Normalize(0.5f * (tan0 + tan1)));
+		const XMVECTOR tangent(XMVectorSetW(XMVector3Normalize(0.5f * (tan0 + tan1)), v0.mTangentU.w));
 		const XMVECTOR tex(0.5f * (tex0 + tex1));
 
 		GeometryGenerator::Vertex v;
 		XMStoreFloat3(&v.mPosition, pos);
 		XMStoreFloat3(&v.mNormal, normal);
-		XMStoreFloat3(&v.mTangentU, tangent);
+		XMStoreFloat4(&v.mTangentU, tangent);
 		XMStoreFloat2(&v.mTexC, tex);
 
 		return v;
 	}
 
+	// Key of the edge between two vertex indices. It does not depend on edge direction.
+	__forceinline std::uint64_t EdgeKey(const std::uint32_t i0, const std::uint32_t i1) noexcept {
+		return i0 < i1 ? (static_cast<std::uint64_t>(i0) << 32UL) | i1 : (static_cast<std::uint64_t>(i1) << 32UL) | i0;
+	}
+
+	using MidPointIndexByEdge = std::unordered_map<std::uint64_t, std::uint32_t>;
+
+	// Returns the index of the vertex at the middle of edge (i0, i1). The vertex is
+	// created the first time the edge is found, so adjacent triangles share it.
+	std::uint32_t MidPointIndex(
+		const std::uint32_t i0, 
+		const std::uint32_t i1, 
+		MidPointIndexByEdge& midPointIndexByEdge, 
+		std::vector<GeometryGenerator::Vertex>& vertices) noexcept {
+		const std::uint32_t newIndex{ static_cast<std::uint32_t>(vertices.size()) };
+		const std::pair<MidPointIndexByEdge::iterator, bool> result{ midPointIndexByEdge.insert(std::make_pair(EdgeKey(i0, i1), newIndex)) };
+		if (result.second) {
+			const GeometryGenerator::Vertex midPoint{ MidPoint(vertices[i0], vertices[i1]) };
+			vertices.push_back(midPoint);
+		}
+
+		return result.first->second;
+	}
+
 	void Subdivide(GeometryGenerator::MeshData& meshData) noexcept {
-		// Save a copy of the input geometry.
-		GeometryGenerator::MeshData inputCopy{ meshData };
+		// Save a copy of the input indices. Input vertices are kept and
+		// midpoints are appended after them.
+		std::vector<std::uint32_t> inputIndices;
+		inputIndices.swap(meshData.mIndices32);
+
+		const std::uint32_t numTris{ static_cast<std::uint32_t>(inputIndices.size()) / 3U };
 
-		meshData.mVertices.resize(0U);
-		meshData.mIndices32.resize(0U);
+		// Each edge is shared by 2 triangles in closed meshes, but in the
+		// worst case every triangle has its own 3 edges.
+		MidPointIndexByEdge midPointIndexByEdge;
+		midPointIndexByEdge.reserve(numTris * 3U);
+		meshData.mVertices.reserve(meshData.mVertices.size() + numTris * 3U);
+		meshData.mIndices32.resize(numTris * 12U);
 
 		//       v1
 		//       *
@@ -51,116 +87,105 @@ namespace {
 	// *-----*-----*
 // v0    m2     v2
 
-		const std::uint32_t numTris{ static_cast<std::uint32_t>(inputCopy.mIndices32.size()) / 3U };
 		for (std::uint32_t i = 0; i < numTris; ++i) {
 			const std::uint32_t i3{ i * 3U };
-			const GeometryGenerator::Vertex v0{ inputCopy.mVertices[inputCopy.mIndices32[i3 + 0U]] };
-			const GeometryGenerator::Vertex v1{ inputCopy.mVertices[inputCopy.mIndices32[i3 + 1U]] };
-			const GeometryGenerator::Vertex v2{ inputCopy.mVertices[inputCopy.mIndices32[i3 + 2U]] };
+			const std::uint32_t v0{ inputIndices[i3 + 0U] };
+			const std::uint32_t v1{ inputIndices[i3 + 1U] };
+			const std::uint32_t v2{ inputIndices[i3 + 2U] };
 
 			//
-			// Generate the midpoints.
+			// Generate (or reuse) the midpoints.
 			//
 
-			const GeometryGenerator::Vertex m0{ MidPoint(v0, v1) };
-			const GeometryGenerator::Vertex m1{ MidPoint(v1, v2) };
-			const GeometryGenerator::Vertex m2{ MidPoint(v0, v2) };
+			const std::uint32_t m0{ MidPointIndex(v0, v1, midPointIndexByEdge, meshData.mVertices) };
+			const std::uint32_t m1{ MidPointIndex(v1, v2, midPointIndexByEdge, meshData.mVertices) };
+			const std::uint32_t m2{ MidPointIndex(v0, v2, midPointIndexByEdge, meshData.mVertices) };
 
 			//
 			// Add new geometry.
 			//
 
-			meshData.mVertices.push_back(v0); // 0
-			meshData.mVertices.push_back(v1); // 1
-			meshData.mVertices.push_back(v2); // 2
-			meshData.mVertices.push_back(m0); // 3
-			meshData.mVertices.push_back(m1); // 4
-			meshData.mVertices.push_back(m2); // 5
-
-			const std::uint32_t i6 = i * 6U;
+			std::uint32_t* indices{ meshData.mIndices32.data() + i * 12U };
 
-			meshData.mIndices32.push_back(i6 + 0U);
-			meshData.mIndices32.push_back(i6 + 3U);
-			meshData.mIndices32.push_back(i6 + 5U);
+			indices[0U] = v0;
+			indices[1U] = m0;
+			indices[2U] = m2;
 
-			meshData.mIndices32.push_back(i6 + 3U);
-			meshData.mIndices32.push_back(i6 + 4U);
-			meshData.mIndices32.push_back(i6 + 5U);
+			indices[3U] = m0;
+			indices[4U] = m1;
+			indices[5U] = m2;
 
-			meshData.mIndices32.push_back(i6 + 5U);
-			meshData.mIndices32.push_back(i6 + 4U);
-			meshData.mIndices32.push_back(i6 + 2U);
+			indices[6U] = m2;
+			indices[7U] = m1;
+			indices[8U] = v2;
 
-			meshData.mIndices32.push_back(i6 + 3U);
-			meshData.mIndices32.push_back(i6 + 1U);
-			meshData.mIndices32.push_back(i6 + 4U);
+			indices[9U] = m0;
+			indices[10U] = v1;
+			indices[11U] = m1;
 		}
 	}
 
-	void BuildCylinderTopCap(const float topRadius, const float height, const std::uint32_t sliceCount, GeometryGenerator::MeshData& meshData) noexcept {
-		const std::uint32_t baseIndex{ static_cast<std::uint32_t>(meshData.mVertices.size()) };
-
-		const float y{ 0.5f * height };
-		const float dTheta{ 2.0f * XM_PI / sliceCount };
-
-		// Duplicate cap ring mVertices because the texture coordinates and normals differ.
-		for (std::uint32_t i = 0U; i <= sliceCount; ++i) {
-			const float x{ topRadius * cosf(i * dTheta) };
-			const float z{ topRadius * sinf(i * dTheta) };
-
-			// Scale down by the height to try and make top cap texture coordinate area
-			// proportional to base.
-			const float u{ x / height + 0.5f };
-			const float v{ z / height + 0.5f };
-
-			meshData.mVertices.push_back(GeometryGenerator::Vertex{ XMFLOAT3{x, y, z}, XMFLOAT3{0.0f, 1.0f, 0.0f}, XMFLOAT3{1.0f, 0.0f, 0.0f}, XMFLOAT2{u, v} });
-		}
-
-		// Cap center vertex.
-		meshData.mVertices.push_back(GeometryGenerator::Vertex{ XMFLOAT3{0.0f, y, 0.0f}, XMFLOAT3{0.0f, 1.0f, 0.0f}, XMFLOAT3{1.0f, 0.0f, 0.0f}, XMFLOAT2{0.5f, 0.5f} });
-
-		// Index of center vertex.
-		const std::uint32_t centerIndex{ static_cast<std::uint32_t>(meshData.mVertices.size()) - 1U };
-
-		for (std::uint32_t i = 0U; i < sliceCount; ++i) {
-			meshData.mIndices32.push_back(centerIndex);
-			meshData.mIndices32.push_back(baseIndex + i + 1U);
-			meshData.mIndices32.push_back(baseIndex + i);
+	// Fills sines and cosines of (i * step) for i in [0, count), 4 angles at a time.
+	// Output vectors are padded to a multiple of 4 elements.
+	void ComputeSinCosTable(const float step, const std::uint32_t count, std::vector<float>& sines, std::vector<float>& cosines) noexcept {
+		const std::uint32_t paddedCount{ (count + 3U) & ~3U };
+		sines.resize(paddedCount);
+		cosines.resize(paddedCount);
+
+		const XMVECTOR offsets{ XMVectorSet(0.0f, 1.0f, 2.0f, 3.0f) };
+		for (std::uint32_t i = 0U; i < paddedCount; i += 4U) {
+			const XMVECTOR angles{ XMVectorScale(XMVectorAdd(XMVectorReplicate(static_cast<float>(i)), offsets), step) };
+			XMVECTOR s;
+			XMVECTOR c;
+			XMVectorSinCos(&s, &c, angles);
+			XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(&sines[i]), s);
+			XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(&cosines[i]), c);
 		}
 	}
 
-	void BuildCylinderBottomCap(const float bottomRadius, const float height, const std::uint32_t sliceCount, GeometryGenerator::MeshData& meshData) noexcept {
-		// 
-		// Build bottom cap.
-		//
+	// Writes cap ring and center vertices at baseVertex and cap triangles at baseIndex.
+	// y and normalY sign tell if it is the top or the bottom cap.
+	void BuildCylinderCap(
+		const float radius, 
+		const float y, 
+		const float normalY,
+		const float height, 
+		const std::uint32_t sliceCount, 
+		const std::vector<float>& sines,
+		const std::vector<float>& cosines,
+		const std::uint32_t baseVertex,
+		const std::uint32_t baseIndex,
+		GeometryGenerator::MeshData& meshData) noexcept {
+		ASSERT(baseVertex + sliceCount + 2U <= meshData.mVertices.size());
+		ASSERT(baseIndex + sliceCount * 3U <= meshData.mIndices32.size());
 
-		const std::uint32_t baseIndex{ static_cast<std::uint32_t>(meshData.mVertices.size()) };
-		const float y{ -0.5f * height };
+		GeometryGenerator::Vertex* vertices{ meshData.mVertices.data() + baseVertex };
 
-		// mVertices of ring
-		const float dTheta{ 2.0f * XM_PI / sliceCount };
+		// Duplicate cap ring mVertices because the texture coordinates and normals differ.
 		for (std::uint32_t i = 0U; i <= sliceCount; ++i) {
-			const float x{ bottomRadius * cosf(i * dTheta) };
-			const float z{ bottomRadius * sinf(i * dTheta) };
+			const float x{ radius * cosines[i] };
+			const float z{ radius * sines[i] };
 
-			// Scale down by the height to try and make top cap texture coord area
+			// Scale down by the height to try and make cap texture coordinate area
 			// proportional to base.
 			const float u{ x / height + 0.5f };
 			const float v{ z / height + 0.5f };
 
-			meshData.mVertices.push_back(GeometryGenerator::Vertex{ XMFLOAT3{x, y, z}, XMFLOAT3{0.0f, -1.0f, 0.0f}, XMFLOAT3{1.0f, 0.0f, 0.0f}, XMFLOAT2{u, v} });
+			vertices[i] = GeometryGenerator::Vertex{ XMFLOAT3{x, y, z}, XMFLOAT3{0.0f, normalY, 0.0f}, XMFLOAT3{1.0f, 0.0f, 0.0f}, XMFLOAT2{u, v} };
 		}
 
 		// Cap center vertex.
-		meshData.mVertices.push_back(GeometryGenerator::Vertex{ XMFLOAT3{0.0f, y, 0.0f}, XMFLOAT3{0.0f, -1.0f, 0.0f}, XMFLOAT3{1.0f, 0.0f, 0.0f}, XMFLOAT2{0.5f, 0.5f} });
-
-		// Cache the index of center vertex.
-		const std::uint32_t centerIndex{ static_cast<std::uint32_t>(meshData.mVertices.size()) - 1U };
+		const std::uint32_t centerIndex{ baseVertex + sliceCount + 1U };
+		vertices[sliceCount + 1U] = GeometryGenerator::Vertex{ XMFLOAT3{0.0f, y, 0.0f}, XMFLOAT3{0.0f, normalY, 0.0f}, XMFLOAT3{1.0f, 0.0f, 0.0f}, XMFLOAT2{0.5f, 0.5f} };
 
+		// Top cap triangles are wound in the opposite direction to bottom cap ones.
+		const std::uint32_t offset0{ normalY > 0.0f ? 1U : 0U };
+		const std::uint32_t offset1{ normalY > 0.0f ? 0U : 1U };
+		std::uint32_t* indices{ meshData.mIndices32.data() + baseIndex };
 		for (std::uint32_t i = 0U; i < sliceCount; ++i) {
-			meshData.mIndices32.push_back(centerIndex);
-			meshData.mIndices32.push_back(baseIndex + i);
-			meshData.mIndices32.push_back(baseIndex + i + 1U);
+			indices[i * 3U] = centerIndex;
+			indices[i * 3U + 1U] = baseVertex + i + offset0;
+			indices[i * 3U + 2U] = baseVertex + i + offset1;
 		}
 	}
 }
@@ -169,7 +194,7 @@ namespace GeometryGenerator {
 	Vertex::Vertex(const XMFLOAT3& p, const XMFLOAT3& n, const XMFLOAT3& t, const XMFLOAT2& uv) 
 		: mPosition(p)
 		, mNormal(n)
-		, mTangentU(t)
+		, mTangentU(t.x, t.y, t.z, 1.0f)
 		, mTexC(uv) 
 	{
 	}
@@ -274,88 +299,97 @@ namespace GeometryGenerator {
 		}
 	}
 
-	void GeometryGenerator::CreateSphere(const float radius, const std::uint32_t sliceCount, const std::uint32_t stackCount, MeshData& meshData) noexcept {
-		//
-		// Compute the vertices stating at the top pole and moving down the stacks.
-		//
+	void CreateSphere(const float radius, const std::uint32_t sliceCount, const std::uint32_t stackCount, MeshData& meshData) noexcept {
+		ASSERT(sliceCount > 2U);
+		ASSERT(stackCount > 1U);
+
+		// Rings do not include the poles. Each ring duplicates its first vertex
+		// because texture coordinates differ.
+		const std::uint32_t ringCount{ stackCount - 1U };
+		const std::uint32_t ringVertexCount{ sliceCount + 1U };
 
+		meshData.mVertices.resize(2U + ringCount * ringVertexCount);
+		meshData.mIndices32.resize(6U * sliceCount * ringCount);
+
+		//
 		// Poles: note that there will be texture coordinate distortion as there is
 		// not a unique point on the texture map to assign to the pole when mapping
 		// a rectangular texture onto a sphere.
-		Vertex topVertex{ XMFLOAT3{ 0.0f, +radius, 0.0f }, XMFLOAT3{ 0.0f, +1.0f, 0.0f }, XMFLOAT3{ 1.0f, 0.0f, 0.0f }, XMFLOAT2{ 0.0f, 0.0f }};
-		Vertex bottomVertex{ XMFLOAT3{ 0.0f, -radius, 0.0f }, XMFLOAT3{ 0.0f, -1.0f, 0.0f }, XMFLOAT3{ 1.0f, 0.0f, 0.0f }, XMFLOAT2{ 0.0f, 1.0f } };
+		//
 
-		meshData.mVertices.push_back(topVertex);
+		const std::uint32_t southPoleIndex{ static_cast<std::uint32_t>(meshData.mVertices.size()) - 1U };
+		meshData.mVertices[0U] = Vertex{ XMFLOAT3{ 0.0f, +radius, 0.0f }, XMFLOAT3{ 0.0f, +1.0f, 0.0f }, XMFLOAT3{ 1.0f, 0.0f, 0.0f }, XMFLOAT2{ 0.0f, 0.0f } };
+		meshData.mVertices[southPoleIndex] = Vertex{ XMFLOAT3{ 0.0f, -radius, 0.0f }, XMFLOAT3{ 0.0f, -1.0f, 0.0f }, XMFLOAT3{ 1.0f, 0.0f, 0.0f }, XMFLOAT2{ 0.0f, 1.0f } };
 
 		const float phiStep{ XM_PI / stackCount };
 		const float thetaStep{ 2.0f * XM_PI / sliceCount };
 
-		// Compute vertices for each stack ring (do not count the poles as rings).
-		std::uint32_t count{ stackCount - 1U };
-		for (std::uint32_t i = 1U; i <= count; ++i) {
-			const float phi{ i * phiStep };
-
-			// Vertices of ring.
-			for (std::uint32_t j = 0U; j <= sliceCount; ++j) {
-				const float theta{ j * thetaStep };
-
-				Vertex v;
-
-				// spherical to cartesian
-				v.mPosition.x = radius * sinf(phi) * cosf(theta);
-				v.mPosition.y = radius * cosf(phi);
-				v.mPosition.z = radius * sinf(phi) * sinf(theta);
-
-				// Partial derivative of P with respect to theta
-				v.mTangentU.x = -radius * sinf(phi) * sinf(theta);
-				v.mTangentU.y = 0.0f;
-				v.mTangentU.z = +radius * sinf(phi) * cosf(theta);
-
-				const XMVECTOR T(XMLoadFloat3(&v.mTangentU));
-				XMStoreFloat3(&v.mTangentU, XMVector3Normalize(T));
-
-				const XMVECTOR p(XMLoadFloat3(&v.mPosition));
-				XMStoreFloat3(&v.mNormal, XMVector3Normalize(p));
+		// Slices angles are the same for every ring
+		std::vector<float> sinTheta;
+		std::vector<float> cosTheta;
+		ComputeSinCosTable(thetaStep, ringVertexCount, sinTheta, cosTheta);
 
-				v.mTexC.x = theta / XM_2PI;
-				v.mTexC.y = phi / XM_PI;
+		//
+		// Compute vertices for each stack ring, and indices of the stack below it, in parallel.
+		// Top stack indices are stored first, then inner stacks and bottom stack at the end.
+		//
 
-				meshData.mVertices.push_back(v);
+		// Offset the indices to the index of the first vertex in the first ring.
+		// This is just skipping the top pole vertex.
+		const std::uint32_t baseIndex{ 1U };
+		const std::uint32_t innerStacksFirstIndex{ 3U * sliceCount };
+		tbb::parallel_for(tbb::blocked_range<std::uint32_t>(0U, ringCount, 8U),
+			[&](const tbb::blocked_range<std::uint32_t>& r) {
+			for (std::uint32_t i = r.begin(); i != r.end(); ++i) {
+				const float phi{ (i + 1U) * phiStep };
+				const float sinPhi{ sinf(phi) };
+				const XMVECTOR cosPhi{ XMVectorReplicate(cosf(phi)) };
+				const float v{ phi / XM_PI };
+
+				// Vertices of ring.
+				Vertex* vertices{ meshData.mVertices.data() + baseIndex + i * ringVertexCount };
+				for (std::uint32_t j = 0U; j < ringVertexCount; ++j) {
+					// spherical to cartesian
+					const XMVECTOR sinCosTheta{ XMVectorSet(cosTheta[j], 0.0f, sinTheta[j], 0.0f) };
+					const XMVECTOR n{ XMVectorSelect(XMVectorScale(sinCosTheta, sinPhi), cosPhi, g_XMSelect0100) };
+					XMStoreFloat3(&vertices[j].mNormal, n);
+					XMStoreFloat3(&vertices[j].mPosition, XMVectorScale(n, radius));
+
+					// Partial derivative of P with respect to theta (normalized)
+					vertices[j].mTangentU = XMFLOAT4{ -sinTheta[j], 0.0f, cosTheta[j], 1.0f };
+
+					vertices[j].mTexC = XMFLOAT2{ j * thetaStep / XM_2PI, v };
+				}
+
+				// Indices of the inner stack between this ring and the next one.
+				if (i + 1U < ringCount) {
+					std::uint32_t* indices{ meshData.mIndices32.data() + innerStacksFirstIndex + i * 6U * sliceCount };
+					for (std::uint32_t j = 0U; j < sliceCount; ++j) {
+						indices[0U] = baseIndex + i * ringVertexCount + j;
+						indices[1U] = baseIndex + i * ringVertexCount + j + 1U;
+						indices[2U] = baseIndex + (i + 1U) * ringVertexCount + j;
+
+						indices[3U] = baseIndex + (i + 1U) * ringVertexCount + j;
+						indices[4U] = baseIndex + i * ringVertexCount + j + 1U;
+						indices[5U] = baseIndex + (i + 1U) * ringVertexCount + j + 1U;
+						indices += 6U;
+					}
+				}
 			}
 		}
-
-		meshData.mVertices.push_back(bottomVertex);
+		);
 
 		//
 		// Compute indices for top stack.  The top stack was written first to the vertex buffer
 		// and connects the top pole to the first ring.
 		//
 
+		std::uint32_t* indices{ meshData.mIndices32.data() };
 		for (std::uint32_t i = 1U; i <= sliceCount; ++i) {
-			meshData.mIndices32.push_back(0U);
-			meshData.mIndices32.push_back(i + 1U);
-			meshData.mIndices32.push_back(i);
-		}
-
-		//
-		// Compute indices for inner stacks (not connected to poles).
-		//
-
-		// Offset the indices to the index of the first vertex in the first ring.
-		// This is just skipping the top pole vertex.
-		std::uint32_t baseIndex{ 1U };
-		std::uint32_t ringVertexCount{ sliceCount + 1U };
-		count = stackCount - 2U;
-		for (std::uint32_t i = 0U; i < count; ++i) {
-			for (std::uint32_t j = 0U; j < sliceCount; ++j) {
-				meshData.mIndices32.push_back(baseIndex + i * ringVertexCount + j);
-				meshData.mIndices32.push_back(baseIndex + i * ringVertexCount + j + 1U);
-				meshData.mIndices32.push_back(baseIndex + (i + 1U) * ringVertexCount + j);
-
-				meshData.mIndices32.push_back(baseIndex + (i + 1U) * ringVertexCount + j);
-				meshData.mIndices32.push_back(baseIndex + i * ringVertexCount + j + 1U);
-				meshData.mIndices32.push_back(baseIndex + (i + 1U) * ringVertexCount + j + 1U);
-			}
+			indices[0U] = 0U;
+			indices[1U] = i + 1U;
+			indices[2U] = i;
+			indices += 3U;
 		}
 
 		//
@@ -363,20 +397,18 @@ namespace GeometryGenerator {
 		// and connects the bottom pole to the bottom ring.
 		//
 
-		// South pole vertex was added last.
-		const std::uint32_t southPoleIndex{ static_cast<std::uint32_t>(meshData.mVertices.size()) - 1U };
-
 		// Offset the indices to the index of the first vertex in the last ring.
-		baseIndex = southPoleIndex - ringVertexCount;
-
+		const std::uint32_t lastRingBaseIndex{ southPoleIndex - ringVertexCount };
+		indices = meshData.mIndices32.data() + meshData.mIndices32.size() - 3U * sliceCount;
 		for (std::uint32_t i = 0U; i < sliceCount; ++i) {
-			meshData.mIndices32.push_back(southPoleIndex);
-			meshData.mIndices32.push_back(baseIndex + i);
-			meshData.mIndices32.push_back(baseIndex + i + 1);
+			indices[0U] = southPoleIndex;
+			indices[1U] = lastRingBaseIndex + i;
+			indices[2U] = lastRingBaseIndex + i + 1U;
+			indices += 3U;
 		}
 	}
 	
-	void GeometryGenerator::CreateGeosphere(const float radius, const std::uint32_t numSubdivisions, MeshData& meshData) noexcept {
+	void CreateGeosphere(const float radius, const std::uint32_t numSubdivisions, MeshData& meshData) noexcept {
 		// Put a cap on the number of subdivisions.
 		const std::uint32_t clampedNumSubdivisions{ std::min<std::uint32_t>(numSubdivisions, 6U) };
 
@@ -415,37 +447,39 @@ namespace GeometryGenerator {
 		}
 
 		// Project mVertices onto sphere and scale.
-		for (std::uint32_t i = 0U; i < meshData.mVertices.size(); ++i) {
-			// Project onto unit sphere.
-			const XMVECTOR n(XMVector3Normalize(XMLoadFloat3(&meshData.mVertices[i].mPosition)));
+		tbb::parallel_for(tbb::blocked_range<std::size_t>(0UL, meshData.mVertices.size(), 1024UL),
+			[&](const tbb::blocked_range<std::size_t>& r) {
+			for (std::size_t i = r.begin(); i != r.end(); ++i) {
+				Vertex& vertex = meshData.mVertices[i];
 
-			// Project onto sphere.
-			const XMVECTOR p(radius * n);
+				// Project onto unit sphere.
+				const XMVECTOR n(XMVector3Normalize(XMLoadFloat3(&vertex.mPosition)));
 
-			XMStoreFloat3(&meshData.mVertices[i].mPosition, p);
-			XMStoreFloat3(&meshData.mVertices[i].mNormal, n);
+				// Project onto sphere.
+				const XMVECTOR p(radius * n);
 
-			// Derive texture coordinates from spherical coordinates.
-			float theta{ atan2f(meshData.mVertices[i].mPosition.z, meshData.mVertices[i].mPosition.x) };
+				XMStoreFloat3(&vertex.mPosition, p);
+				XMStoreFloat3(&vertex.mNormal, n);
 
-			// Put in [0, 2pi].
-			if (theta < 0.0f) {
-				theta += XM_2PI;
-			}
+				// Derive texture coordinates from spherical coordinates.
+				float theta{ atan2f(vertex.mPosition.z, vertex.mPosition.x) };
 
-			const float phi{ acosf(meshData.mVertices[i].mPosition.y / radius) };
+				// Put in [0, 2pi].
+				if (theta < 0.0f) {
+					theta += XM_2PI;
+				}
 
-			meshData.mVertices[i].mTexC.x = theta / XM_2PI;
-			meshData.mVertices[i].mTexC.y = phi / XM_PI;
+				const float phi{ acosf(vertex.mPosition.y / radius) };
 
-			// Partial derivative of P with respect to theta
-			meshData.mVertices[i].mTangentU.x = -radius * sinf(phi) * sinf(theta);
-			meshData.mVertices[i].mTangentU.y = 0.0f;
-			meshData.mVertices[i].mTangentU.z = +radius * sinf(phi) * cosf(theta);
+				vertex.mTexC.x = theta / XM_2PI;
+				vertex.mTexC.y = phi / XM_PI;
 
-			const XMVECTOR T(XMLoadFloat3(&meshData.mVertices[i].mTangentU));
-			XMStoreFloat3(&meshData.mVertices[i].mTangentU, XMVector3Normalize(T));
+				// Partial derivative of P with respect to theta
+				const XMVECTOR T(XMVectorSet(-radius * sinf(phi) * sinf(theta), 0.0f, +radius * sinf(phi) * cosf(theta), 0.0f));
+				XMStoreFloat4(&vertex.mTangentU, XMVectorSetW(XMVector3Normalize(T), 1.0f));
+			}
 		}
+		);
 	}
 
 	void CreateCylinder(
@@ -455,6 +489,27 @@ namespace GeometryGenerator {
 		const std::uint32_t sliceCount, 
 		const std::uint32_t stackCount, 
 		MeshData& meshData) noexcept {
+		ASSERT(sliceCount > 2U);
+		ASSERT(stackCount > 0U);
+
+		const std::uint32_t ringCount{ stackCount + 1U };
+
+		// Add one because we duplicate the first and last vertex per ring
+		// since the texture coordinates are different.
+		const std::uint32_t ringVertexCount{ sliceCount + 1U };
+
+		// Each cap has its own ring plus a center vertex.
+		const std::uint32_t capVertexCount{ ringVertexCount + 1U };
+		const std::uint32_t stacksVertexCount{ ringCount * ringVertexCount };
+		const std::uint32_t stacksIndexCount{ stackCount * sliceCount * 6U };
+		meshData.mVertices.resize(stacksVertexCount + 2U * capVertexCount);
+		meshData.mIndices32.resize(stacksIndexCount + 2U * sliceCount * 3U);
+
+		// Slices angles are the same for every ring
+		std::vector<float> sines;
+		std::vector<float> cosines;
+		ComputeSinCosTable(2.0f * XM_PI / sliceCount, ringVertexCount, sines, cosines);
+
 		//
 		// Build Stacks.
 		// 
@@ -464,89 +519,80 @@ namespace GeometryGenerator {
 		// Amount to increment radius as we move up each stack level from bottom to top.
 		const float radiusStep{ (topRadius - bottomRadius) / stackCount };
 
-		const std::uint32_t ringCount{ stackCount + 1U };
-
-		// Compute mVertices for each stack ring starting at the bottom and moving up.
-		for (std::uint32_t i = 0U; i < ringCount; ++i) {
-			const float y{ -0.5f * height + i * stackHeight };
-			const float r{ bottomRadius + i * radiusStep };
-
-			// mVertices of ring
-			const float dTheta{ 2.0f * XM_PI / sliceCount };
-			for (std::uint32_t j = 0U; j <= sliceCount; ++j) {
-				Vertex vertex;
-
-				const float c{ cosf(j * dTheta) };
-				const float s{ sinf(j * dTheta) };
-
-				vertex.mPosition = XMFLOAT3{ r * c, y, r * s };
-
-				vertex.mTexC.x = static_cast<float>(j) / sliceCount;
-				vertex.mTexC.y = 1.0f - static_cast<float>(i) / stackCount;
-
-				// Cylinder can be parameterized as follows, where we introduce v
-				// parameter that goes in the same direction as the v tex-coord
-				// so that the bitangent goes in the same direction as the v tex-coord.
-				//   Let r0 be the bottom radius and let r1 be the top radius.
-				//   y(v) = h - hv for v in [0,1].
-				//   r(v) = r1 + (r0-r1)v
-				//
-				//   x(t, v) = r(v)*cos(t)
-				//   y(t, v) = h - hv
-				//   z(t, v) = r(v)*sin(t)
-				// 
-				//  dx/dt = -r(v)*sin(t)
-				//  dy/dt = 0
-				//  dz/dt = +r(v)*cos(t)
-				//
-				//  dx/dv = (r0-r1)*cos(t)
-				//  dy/dv = -h
-				//  dz/dv = (r0-r1)*sin(t)
-
-				// This is unit length.
-				vertex.mTangentU = XMFLOAT3{ -s, 0.0f, c };
-
-				const float dr{ bottomRadius - topRadius };
-				const XMFLOAT3 bitangent{ dr * c, -height, dr * s };
-
-				const XMVECTOR T(XMLoadFloat3(&vertex.mTangentU));
-				const XMVECTOR B(XMLoadFloat3(&bitangent));
-				const XMVECTOR N(XMVector3Normalize(XMVector3Cross(T, B)));
-				XMStoreFloat3(&vertex.mNormal, N);
-
-				meshData.mVertices.push_back(vertex);
-			}
-		}
-
-		// Add one because we duplicate the first and last vertex per ring
-		// since the texture coordinates are different.
-		const std::uint32_t ringVertexCount{ sliceCount + 1U };
-
-		// Compute indices for each stack.
-		for (std::uint32_t i = 0U; i < stackCount; ++i) {
-			for (std::uint32_t j = 0U; j < sliceCount; ++j) {
-				meshData.mIndices32.push_back(i * ringVertexCount + j);
-				meshData.mIndices32.push_back((i + 1U) * ringVertexCount + j);
-				meshData.mIndices32.push_back((i + 1U) * ringVertexCount + j + 1U);
-
-				meshData.mIndices32.push_back(i * ringVertexCount + j);
-				meshData.mIndices32.push_back((i + 1U) * ringVertexCount + j + 1U);
-				meshData.mIndices32.push_back(i * ringVertexCount + j + 1U);
+		// Cylinder can be parameterized as follows, where we introduce v
+		// parameter that goes in the same direction as the v tex-coord
+		// so that the bitangent goes in the same direction as the v tex-coord.
+		//   Let r0 be the bottom radius and let r1 be the top radius.
+		//   y(v) = h - hv for v in [0,1].
+		//   r(v) = r1 + (r0-r1)v
+		//
+		//   x(t, v) = r(v)*cos(t)
+		//   y(t, v) = h - hv
+		//   z(t, v) = r(v)*sin(t)
+		// 
+		//  dx/dt = -r(v)*sin(t)
+		//  dy/dt = 0
+		//  dz/dt = +r(v)*cos(t)
+		//
+		//  dx/dv = (r0-r1)*cos(t)
+		//  dy/dv = -h
+		//  dz/dv = (r0-r1)*sin(t)
+		const float dr{ bottomRadius - topRadius };
+
+		// Compute mVertices for each stack ring starting at the bottom and moving up,
+		// and the indices of the stack above each ring, in parallel.
+		tbb::parallel_for(tbb::blocked_range<std::uint32_t>(0U, ringCount, 8U),
+			[&](const tbb::blocked_range<std::uint32_t>& r) {
+			for (std::uint32_t i = r.begin(); i != r.end(); ++i) {
+				const float y{ -0.5f * height + i * stackHeight };
+				const float radius{ bottomRadius + i * radiusStep };
+				const float v{ 1.0f - static_cast<float>(i) / stackCount };
+
+				// mVertices of ring
+				Vertex* vertices{ meshData.mVertices.data() + i * ringVertexCount };
+				for (std::uint32_t j = 0U; j < ringVertexCount; ++j) {
+					const float c{ cosines[j] };
+					const float s{ sines[j] };
+
+					vertices[j].mPosition = XMFLOAT3{ radius * c, y, radius * s };
+					vertices[j].mTexC = XMFLOAT2{ static_cast<float>(j) / sliceCount, v };
+
+					// This is unit length.
+					const XMVECTOR T(XMVectorSet(-s, 0.0f, c, 1.0f));
+					const XMVECTOR B(XMVectorSet(dr * c, -height, dr * s, 0.0f));
+					XMStoreFloat4(&vertices[j].mTangentU, T);
+					XMStoreFloat3(&vertices[j].mNormal, XMVector3Normalize(XMVector3Cross(T, B)));
+				}
+
+				// Indices of the stack between this ring and the next one.
+				if (i < stackCount) {
+					std::uint32_t* indices{ meshData.mIndices32.data() + i * sliceCount * 6U };
+					for (std::uint32_t j = 0U; j < sliceCount; ++j) {
+						indices[0U] = i * ringVertexCount + j;
+						indices[1U] = (i + 1U) * ringVertexCount + j;
+						indices[2U] = (i + 1U) * ringVertexCount + j + 1U;
+
+						indices[3U] = i * ringVertexCount + j;
+						indices[4U] = (i + 1U) * ringVertexCount + j + 1U;
+						indices[5U] = i * ringVertexCount + j + 1U;
+						indices += 6U;
+					}
+				}
 			}
 		}
+		);
 
-		BuildCylinderTopCap(topRadius, height, sliceCount, meshData);
-		BuildCylinderBottomCap(bottomRadius, height, sliceCount, meshData);
+		BuildCylinderCap(topRadius, 0.5f * height, 1.0f, height, sliceCount, sines, cosines, stacksVertexCount, stacksIndexCount, meshData);
+		BuildCylinderCap(bottomRadius, -0.5f * height, -1.0f, height, sliceCount, sines, cosines, stacksVertexCount + capVertexCount, stacksIndexCount + sliceCount * 3U, meshData);
 	}
 
 	void CreateGrid(const float width, const float depth, const std::uint32_t m, const std::uint32_t n, MeshData& meshData) noexcept {
+		ASSERT(m > 1U);
+		ASSERT(n > 1U);
+
 		const std::uint32_t vertexCount{ m * n };
 		const std::uint32_t faceCount{ (m - 1U) * (n - 1U) * 2U };
 
-		//
-		// Create the mVertices.
-		//
-
 		const float halfWidth{ 0.5f * width };
 		const float halfDepth{ 0.5f * depth };
 
@@ -557,44 +603,47 @@ namespace GeometryGenerator {
 		const float dv{ 1.0f / (m - 1U) };
 
 		meshData.mVertices.resize(vertexCount);
-		for (std::uint32_t i = 0U; i < m; ++i) {
-			const float z{ halfDepth - i * dz };
-			for (std::uint32_t j = 0U; j < n; ++j) {
-				const float x{ -halfWidth + j * dx };
-
-				meshData.mVertices[i * n + j].mPosition = XMFLOAT3{ x, 0.0f, z };
-				meshData.mVertices[i * n + j].mNormal = XMFLOAT3{ 0.0f, 1.0f, 0.0f };
-				meshData.mVertices[i * n + j].mTangentU = XMFLOAT3{ 1.0f, 0.0f, 0.0f };
-
-				// Stretch texture over grid.
-				meshData.mVertices[i * n + j].mTexC.x = j * du;
-				meshData.mVertices[i * n + j].mTexC.y = i * dv;
-			}
-		}
+		meshData.mIndices32.resize(faceCount * 3U); // 3 indices per face
 
 		//
-		// Create the indices.
+		// Create the mVertices of each row, and the indices of the quads below it, in parallel.
 		//
 
-		meshData.mIndices32.resize(faceCount * 3U); // 3 indices per face
-
-													// Iterate over each quad and compute indices.
-		std::uint32_t k{ 0U };
-		const std::uint32_t count1{ m - 1U };
-		const std::uint32_t count2{ n - 1U };
-		for (std::uint32_t i = 0U; i < count1; ++i) {
-			for (std::uint32_t j = 0U; j < count2; ++j) {
-				meshData.mIndices32[k] = i * n + j;
-				meshData.mIndices32[k + 1U] = i * n + j + 1U;
-				meshData.mIndices32[k + 2U] = (i + 1U) * n + j;
-
-				meshData.mIndices32[k + 3U] = (i + 1U) * n + j;
-				meshData.mIndices32[k + 4U] = i * n + j + 1U;
-				meshData.mIndices32[k + 5U] = (i + 1U) * n + j + 1U;
-
-				k += 6U; // next quad
+		const std::uint32_t quadsPerRow{ n - 1U };
+		tbb::parallel_for(tbb::blocked_range<std::uint32_t>(0U, m, 16U),
+			[&](const tbb::blocked_range<std::uint32_t>& r) {
+			for (std::uint32_t i = r.begin(); i != r.end(); ++i) {
+				const float z{ halfDepth - i * dz };
+				Vertex* vertices{ meshData.mVertices.data() + i * n };
+				for (std::uint32_t j = 0U; j < n; ++j) {
+					const float x{ -halfWidth + j * dx };
+
+					vertices[j].mPosition = XMFLOAT3{ x, 0.0f, z };
+					vertices[j].mNormal = XMFLOAT3{ 0.0f, 1.0f, 0.0f };
+					vertices[j].mTangentU = XMFLOAT4{ 1.0f, 0.0f, 0.0f, 1.0f };
+
+					// Stretch texture over grid.
+					vertices[j].mTexC.x = j * du;
+					vertices[j].mTexC.y = i * dv;
+				}
+
+				if (i + 1U < m) {
+					std::uint32_t* indices{ meshData.mIndices32.data() + i * quadsPerRow * 6U };
+					for (std::uint32_t j = 0U; j < quadsPerRow; ++j) {
+						indices[0U] = i * n + j;
+						indices[1U] = i * n + j + 1U;
+						indices[2U] = (i + 1U) * n + j;
+
+						indices[3U] = (i + 1U) * n + j;
+						indices[4U] = i * n + j + 1U;
+						indices[5U] = (i + 1U) * n + j + 1U;
+
+						indices += 6U; // next quad
+					}
+				}
 			}
 		}
+		);
 	}
 
 	void CreateQuad(const float x, const float y, const float w, const float h, const float depth, MeshData& meshData) noexcept {
@@ -19,12 +19,14 @@ namespace GeometryGenerator {
 
 		~Vertex() = default;
 		Vertex(const Vertex&) = default;
+		Vertex& operator=(const Vertex&) = default;
 		Vertex(Vertex&&) = default;
 		Vertex& operator=(Vertex&&) = default;
 
 		DirectX::XMFLOAT3 mPosition = {0.0f, 0.0f, 0.0f};
         DirectX::XMFLOAT3 mNormal = { 0.0f, 0.0f, 0.0f };
-        DirectX::XMFLOAT3 mTangentU = { 0.0f, 0.0f, 0.0f };
+        // w stores tangent frame handedness: bitangent = cross(normal, tangent) * w
+        DirectX::XMFLOAT4 mTangentU = { 0.0f, 0.0f, 0.0f, 1.0f };
         DirectX::XMFLOAT2 mTexC = { 0.0f, 0.0f };
 	};
 
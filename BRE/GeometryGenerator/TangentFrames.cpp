@@ -0,0 +1,264 @@
+#include "TangentFrames.h"
+
+#include <cmath>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_sort.h>
+#include <vector>
+
+#include <Utils/DebugUtils.h>
+
+namespace {
+	// Number of triangles/vertices processed by each task
+	const std::size_t sTriangleGrainSize{ 2048UL };
+	const std::size_t sVertexGrainSize{ 2048UL };
+
+	// Smaller texture coordinate areas or lengths are considered degenerated.
+	const float sEpsilon{ 1.0e-20f };
+
+	struct Float3 {
+		float x;
+		float y;
+		float z;
+	};
+
+	__forceinline Float3 operator+(const Float3& a, const Float3& b) noexcept { return Float3{ a.x + b.x, a.y + b.y, a.z + b.z }; }
+	__forceinline Float3 operator-(const Float3& a, const Float3& b) noexcept { return Float3{ a.x - b.x, a.y - b.y, a.z - b.z }; }
+	__forceinline Float3 operator*(const Float3& a, const float s) noexcept { return Float3{ a.x * s, a.y * s, a.z * s }; }
+	__forceinline float Dot(const Float3& a, const Float3& b) noexcept { return a.x * b.x + a.y * b.y + a.z * b.z; }
+	__forceinline Float3 Cross(const Float3& a, const Float3& b) noexcept {
+		return Float3{ a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x };
+	}
+
+	// Zero vectors stay zero (as XMVector3Normalize)
+	__forceinline Float3 Normalize(const Float3& v) noexcept {
+		const float lengthSq{ Dot(v, v) };
+		return lengthSq > 0.0f ? v * (1.0f / std::sqrt(lengthSq)) : Float3{ 0.0f, 0.0f, 0.0f };
+	}
+
+	__forceinline Float3 ProjectOntoPlane(const Float3& v, const Float3& normal) noexcept {
+		return v - normal * Dot(normal, v);
+	}
+
+	// Returns an unit vector perpendicular to normal. It is used when
+	// all the triangles around a vertex have degenerated texture coordinates.
+	Float3 AnyPerpendicular(const Float3& normal) noexcept {
+		const Float3 axis{ std::fabs(normal.x) < 0.9f ? Float3{ 1.0f, 0.0f, 0.0f } : Float3{ 0.0f, 1.0f, 0.0f } };
+		return Normalize(ProjectOntoPlane(axis, normal));
+	}
+
+	// Reads attributes of interleaved vertices
+	class Vertices {
+	public:
+		Vertices(void* vertices, const TangentFrames::VertexLayout& layout) noexcept
+			: mData(static_cast<std::uint8_t*>(vertices))
+			, mLayout(layout)
+		{
+		}
+
+		__forceinline const float* Position(const std::size_t i) const noexcept { return Attribute(i, mLayout.mPositionOffset); }
+		__forceinline const float* Normal(const std::size_t i) const noexcept { return Attribute(i, mLayout.mNormalOffset); }
+		__forceinline const float* TexCoord(const std::size_t i) const noexcept { return Attribute(i, mLayout.mTexCoordOffset); }
+		__forceinline float* Tangent(const std::size_t i) const noexcept { return Attribute(i, mLayout.mTangentOffset); }
+
+		__forceinline Float3 PositionFloat3(const std::size_t i) const noexcept {
+			const float* p{ Position(i) };
+			return Float3{ p[0U], p[1U], p[2U] };
+		}
+
+		// Position, normal and texture coordinates in lexicographic order.
+		// Floats are compared as floats, so -0.0 and 0.0 are equal (as MikkTSpace does).
+		bool IsWeldKeyLess(const std::size_t a, const std::size_t b) const noexcept {
+			const float* attributesA[3U]{ Position(a), Normal(a), TexCoord(a) };
+			const float* attributesB[3U]{ Position(b), Normal(b), TexCoord(b) };
+			const std::uint32_t componentCounts[3U]{ 3U, 3U, 2U };
+			for (std::uint32_t i = 0U; i < 3U; ++i) {
+				for (std::uint32_t j = 0U; j < componentCounts[i]; ++j) {
+					if (attributesA[i][j] != attributesB[i][j]) {
+						return attributesA[i][j] < attributesB[i][j];
+					}
+				}
+			}
+			return false;
+		}
+
+	private:
+		__forceinline float* Attribute(const std::size_t i, const std::size_t offset) const noexcept {
+			return reinterpret_cast<float*>(mData + i * mLayout.mStride + offset);
+		}
+
+		std::uint8_t* mData{ nullptr };
+		TangentFrames::VertexLayout mLayout;
+	};
+
+	// Per triangle tangent and bitangent, both normalized and already
+	// flipped when texture coordinates winding is mirrored (like MikkTSpace does)
+	struct FaceFrame {
+		Float3 mTangent{ 0.0f, 0.0f, 0.0f };
+		Float3 mBitangent{ 0.0f, 0.0f, 0.0f };
+	};
+
+	void ComputeFaceFrame(const Vertices& vertices, const std::uint32_t* indices, FaceFrame& faceFrame) noexcept {
+		const Float3 p0{ vertices.PositionFloat3(indices[0U]) };
+		const Float3 e1{ vertices.PositionFloat3(indices[1U]) - p0 };
+		const Float3 e2{ vertices.PositionFloat3(indices[2U]) - p0 };
+
+		const float* uv0{ vertices.TexCoord(indices[0U]) };
+		const float* uv1{ vertices.TexCoord(indices[1U]) };
+		const float* uv2{ vertices.TexCoord(indices[2U]) };
+		const float du1{ uv1[0U] - uv0[0U] };
+		const float dv1{ uv1[1U] - uv0[1U] };
+		const float du2{ uv2[0U] - uv0[0U] };
+		const float dv2{ uv2[1U] - uv0[1U] };
+
+		// Twice the signed area in texture space.
+		const float signedArea{ du1 * dv2 - du2 * dv1 };
+		if (std::fabs(signedArea) < sEpsilon) {
+			faceFrame = FaceFrame();
+			return;
+		}
+
+		// Tangent and bitangent scaled by signedArea. Its sign restores
+		// the direction when texture coordinates are mirrored.
+		const float orientation{ signedArea > 0.0f ? 1.0f : -1.0f };
+		faceFrame.mTangent = Normalize(e1 * dv2 - e2 * dv1) * orientation;
+		faceFrame.mBitangent = Normalize(e2 * du1 - e1 * du2) * orientation;
+	}
+
+	// Angle between the two edges that share the vertex, projected onto its tangent plane.
+	float CornerAngle(const Float3& p0, const Float3& p1, const Float3& p2, const Float3& normal) noexcept {
+		const Float3 e1{ Normalize(ProjectOntoPlane(p1 - p0, normal)) };
+		const Float3 e2{ Normalize(ProjectOntoPlane(p2 - p0, normal)) };
+		const float cosAngle{ Dot(e1, e2) };
+		return std::acos(cosAngle < -1.0f ? -1.0f : (cosAngle > 1.0f ? 1.0f : cosAngle));
+	}
+
+	void OrthonormalizeFrame(const Float3& normal, const Float3& tangent, const Float3& bitangent, float result[4U]) noexcept {
+		// Gram-Schmidt
+		Float3 t{ ProjectOntoPlane(tangent, normal) };
+		t = Dot(t, t) < sEpsilon ? AnyPerpendicular(normal) : Normalize(t);
+
+		result[0U] = t.x;
+		result[1U] = t.y;
+		result[2U] = t.z;
+		result[3U] = Dot(Cross(normal, t), bitangent) < 0.0f ? -1.0f : 1.0f;
+	}
+}
+
+namespace TangentFrames {
+	void Compute(
+		void* vertexData,
+		const std::size_t vertexCount,
+		const VertexLayout& layout,
+		const std::uint32_t* indices,
+		const std::size_t indexCount) noexcept
+	{
+		ASSERT(indexCount % 3UL == 0UL);
+		const std::size_t triangleCount{ indexCount / 3UL };
+		if (vertexCount == 0UL || triangleCount == 0UL) {
+			return;
+		}
+		ASSERT(vertexData != nullptr && indices != nullptr);
+		ASSERT(vertexCount <= 0xFFFFFFFFUL);
+
+		const Vertices vertices(vertexData, layout);
+
+		// Face frames
+		std::vector<FaceFrame> faceFrames(triangleCount);
+		tbb::parallel_for(tbb::blocked_range<std::size_t>(0UL, triangleCount, sTriangleGrainSize),
+			[&](const tbb::blocked_range<std::size_t>& r) {
+			for (std::size_t i = r.begin(); i != r.end(); ++i) {
+				ComputeFaceFrame(vertices, indices + i * 3UL, faceFrames[i]);
+			}
+		}
+		);
+
+		// Weld vertices: sort them by position, normal and texture coordinates, so equal
+		// vertices are contiguous. Welded vertex w has sortedVertices[weldOffsets[w], weldOffsets[w + 1]).
+		std::vector<std::uint32_t> sortedVertices(vertexCount);
+		for (std::size_t i = 0UL; i < vertexCount; ++i) {
+			sortedVertices[i] = static_cast<std::uint32_t>(i);
+		}
+		tbb::parallel_sort(sortedVertices.begin(), sortedVertices.end(),
+			[&vertices](const std::uint32_t a, const std::uint32_t b) {
+			return vertices.IsWeldKeyLess(a, b);
+		}
+		);
+
+		std::vector<std::uint32_t> weldOffsets;
+		weldOffsets.reserve(vertexCount + 1UL);
+		std::vector<std::uint32_t> weldedVertexByVertex(vertexCount);
+		for (std::size_t i = 0UL; i < vertexCount; ++i) {
+			if (i == 0UL || vertices.IsWeldKeyLess(sortedVertices[i - 1UL], sortedVertices[i])) {
+				weldOffsets.push_back(static_cast<std::uint32_t>(i));
+			}
+			weldedVertexByVertex[sortedVertices[i]] = static_cast<std::uint32_t>(weldOffsets.size() - 1UL);
+		}
+		const std::size_t weldedVertexCount{ weldOffsets.size() };
+		weldOffsets.push_back(static_cast<std::uint32_t>(vertexCount));
+
+		// Welded vertex to triangle corner adjacency (compressed rows).
+		// Corner c belongs to triangle c / 3 and references vertex indices[c].
+		std::vector<std::uint32_t> cornerOffsets(weldedVertexCount + 1UL, 0U);
+		for (std::size_t i = 0UL; i < indexCount; ++i) {
+			ASSERT(indices[i] < vertexCount);
+			++cornerOffsets[weldedVertexByVertex[indices[i]] + 1UL];
+		}
+		for (std::size_t i = 1UL; i <= weldedVertexCount; ++i) {
+			cornerOffsets[i] += cornerOffsets[i - 1UL];
+		}
+		std::vector<std::uint32_t> corners(indexCount);
+		std::vector<std::uint32_t> cornerCursors(cornerOffsets.begin(), cornerOffsets.end() - 1);
+		for (std::size_t i = 0UL; i < indexCount; ++i) {
+			corners[cornerCursors[weldedVertexByVertex[indices[i]]]++] = static_cast<std::uint32_t>(i);
+		}
+
+		// Gather, orthonormalize and store in all the vertices of each welded vertex
+		tbb::parallel_for(tbb::blocked_range<std::size_t>(0UL, weldedVertexCount, sVertexGrainSize),
+			[&](const tbb::blocked_range<std::size_t>& r) {
+			for (std::size_t i = r.begin(); i != r.end(); ++i) {
+				const std::uint32_t vertex{ sortedVertices[weldOffsets[i]] };
+				const float* n{ vertices.Normal(vertex) };
+				const Float3 normal{ Normalize(Float3{ n[0U], n[1U], n[2U] }) };
+				const Float3 p0{ vertices.PositionFloat3(vertex) };
+
+				Float3 tangent{ 0.0f, 0.0f, 0.0f };
+				Float3 bitangent{ 0.0f, 0.0f, 0.0f };
+				for (std::uint32_t j = cornerOffsets[i]; j < cornerOffsets[i + 1UL]; ++j) {
+					const std::uint32_t corner{ corners[j] };
+					const std::uint32_t triangleIndex{ corner / 3U };
+					const std::uint32_t baseIndex{ triangleIndex * 3U };
+					const Float3 p1{ vertices.PositionFloat3(indices[baseIndex + (corner - baseIndex + 1U) % 3U]) };
+					const Float3 p2{ vertices.PositionFloat3(indices[baseIndex + (corner - baseIndex + 2U) % 3U]) };
+					const float weight{ CornerAngle(p0, p1, p2, normal) };
+
+					const FaceFrame& faceFrame = faceFrames[triangleIndex];
+					tangent = tangent + Normalize(ProjectOntoPlane(faceFrame.mTangent, normal)) * weight;
+					bitangent = bitangent + Normalize(ProjectOntoPlane(faceFrame.mBitangent, normal)) * weight;
+				}
+
+				float frame[4U];
+				OrthonormalizeFrame(normal, tangent, bitangent, frame);
+				for (std::uint32_t j = weldOffsets[i]; j < weldOffsets[i + 1UL]; ++j) {
+					float* result{ vertices.Tangent(sortedVertices[j]) };
+					for (std::uint32_t k = 0U; k < 4U; ++k) {
+						result[k] = frame[k];
+					}
+				}
+			}
+		}
+		);
+	}
+
+	void OrthonormalizeTangent(
+		const float normal[3U],
+		const float tangent[3U],
+		const float bitangent[3U],
+		float result[4U]) noexcept
+	{
+		OrthonormalizeFrame(
+			Normalize(Float3{ normal[0U], normal[1U], normal[2U] }),
+			Float3{ tangent[0U], tangent[1U], tangent[2U] },
+			Float3{ bitangent[0U], bitangent[1U], bitangent[2U] },
+			result);
+	}
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Generates per vertex tangent frames of interleaved vertices from positions, normals and
+// texture coordinates (TangentGenerator does it for GeometryGenerator::MeshData).
+// Results follow MikkTSpace conventions, so normal maps baked with it are decoded correctly:
+// - Vertices with the same position, normal and texture coordinates are welded, so they get
+// the same tangent frame even if the mesh splits them (for example, for other attributes).
+// - Face tangents are projected onto each vertex tangent plane and weighted by the corner angle.
+// - The accumulated tangent is orthonormalized against the vertex normal (Gram-Schmidt).
+// - Handedness is stored in w, so bitangent = cross(normal, tangent) * w
+// It does not depend on DirectXMath, so it can be built on any platform.
+// Steps:
+// - Compute face tangents/bitangents in parallel triangle batches.
+// - Weld vertices (parallel sort by position, normal and texture coordinates).
+// - Build welded vertex to triangle corner adjacency.
+// - Gather, orthonormalize and store tangent frames in parallel welded vertex batches.
+namespace TangentFrames {
+	// Byte offsets of the attributes of a vertex. Positions and normals are 3 floats,
+	// tangents are 4 floats and texture coordinates are 2 floats.
+	struct VertexLayout {
+		std::size_t mStride{ 0UL };
+		std::size_t mPositionOffset{ 0UL };
+		std::size_t mNormalOffset{ 0UL };
+		std::size_t mTangentOffset{ 0UL };
+		std::size_t mTexCoordOffset{ 0UL };
+	};
+
+	// indices are a triangle list. Only tangents of vertices are written.
+	void Compute(
+		void* vertices,
+		const std::size_t vertexCount,
+		const VertexLayout& layout,
+		const std::uint32_t* indices,
+		const std::size_t indexCount) noexcept;
+
+	// Orthonormalize an already existing tangent (for example, the one imported by Assimp)
+	// against normal, and compute its handedness from bitangent. result is the tangent and handedness.
+	void OrthonormalizeTangent(
+		const float normal[3U],
+		const float tangent[3U],
+		const float bitangent[3U],
+		float result[4U]) noexcept;
+}
@@ -0,0 +1,40 @@
+#include "TangentGenerator.h"
+
+#include <cstddef>
+
+#include <GeometryGenerator/TangentFrames.h>
+
+using namespace DirectX;
+
+namespace {
+	static_assert(sizeof(XMFLOAT3) == sizeof(float) * 3UL, "TangentFrames reads positions and normals as 3 floats");
+	static_assert(sizeof(XMFLOAT4) == sizeof(float) * 4UL, "TangentFrames writes tangents as 4 floats");
+	static_assert(sizeof(XMFLOAT2) == sizeof(float) * 2UL, "TangentFrames reads texture coordinates as 2 floats");
+
+	TangentFrames::VertexLayout MeshVertexLayout() noexcept {
+		TangentFrames::VertexLayout layout;
+		layout.mStride = sizeof(GeometryGenerator::Vertex);
+		layout.mPositionOffset = offsetof(GeometryGenerator::Vertex, mPosition);
+		layout.mNormalOffset = offsetof(GeometryGenerator::Vertex, mNormal);
+		layout.mTangentOffset = offsetof(GeometryGenerator::Vertex, mTangentU);
+		layout.mTexCoordOffset = offsetof(GeometryGenerator::Vertex, mTexC);
+		return layout;
+	}
+}
+
+namespace TangentGenerator {
+	void ComputeTangentFrames(GeometryGenerator::MeshData& meshData) noexcept {
+		TangentFrames::Compute(
+			meshData.mVertices.data(),
+			meshData.mVertices.size(),
+			MeshVertexLayout(),
+			meshData.mIndices32.data(),
+			meshData.mIndices32.size());
+	}
+
+	XMFLOAT4 OrthonormalizeTangent(const XMFLOAT3& normal, const XMFLOAT3& tangent, const XMFLOAT3& bitangent) noexcept {
+		XMFLOAT4 result;
+		TangentFrames::OrthonormalizeTangent(&normal.x, &tangent.x, &bitangent.x, &result.x);
+		return result;
+	}
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <GeometryGenerator/GeometryGenerator.h>
+
+// Tangent frames of GeometryGenerator::MeshData (see TangentFrames, that computes them).
+namespace TangentGenerator {
+	// meshData must have valid positions, normals, texture coordinates and
+	// a triangle list in mIndices32. Only mTangentU of each vertex is written.
+	void ComputeTangentFrames(GeometryGenerator::MeshData& meshData) noexcept;
+
+	// Orthonormalize an already existing tangent (for example, the one imported by Assimp)
+	// against normal, and compute its handedness from bitangent.
+	DirectX::XMFLOAT4 OrthonormalizeTangent(
+		const DirectX::XMFLOAT3& normal,
+		const DirectX::XMFLOAT3& tangent,
+		const DirectX::XMFLOAT3& bitangent) noexcept;
+}
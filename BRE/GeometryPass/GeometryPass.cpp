@@ -1,11 +1,16 @@
 #include "GeometryPass.h"
 
+#include <algorithm>
 #include <d3d12.h>
 #include <DirectXColors.h>
 #include <tbb/parallel_for.h>
+#include <tbb/parallel_invoke.h>
 
 #include <CommandListExecutor/CommandListExecutor.h>
+#include <CommandManager/CaptureCommandList.h>
 #include <CommandManager\CommandManager.h>
+#include <CommandManager/CommandStream.h>
+#include <CommandManager/D3D12CommandList.h>
 #include <DescriptorManager\DescriptorManager.h>
 #include <DXUtils/d3dx12.h>
 #include <GeometryPass\Recorders\ColorCmdListRecorder.h>
@@ -14,9 +19,13 @@
 #include <GeometryPass\Recorders\HeightCmdListRecorder.h>
 #include <GeometryPass\Recorders\NormalCmdListRecorder.h>
 #include <GeometryPass\Recorders\TextureCmdListRecorder.h>
+#include <Material/MaterialRegistry.h>
+#include <MathUtils/MathUtils.h>
 #include <ResourceManager\ResourceManager.h>
 #include <ShaderUtils\CBuffers.h>
 #include <Utils\DebugUtils.h>
+#include <Utils/Profiler.h>
+#include <Utils/RenderStats.h>
 
 namespace {
 	// Geometry buffer formats
@@ -94,10 +103,21 @@ namespace {
 	}
 }
 
+void GeometryPass::InitPSOs() noexcept {
+	tbb::parallel_invoke(
+		[]() { ColorCmdListRecorder::InitPSO(sBufferFormats, BUFFERS_COUNT); },
+		[]() { ColorHeightCmdListRecorder::InitPSO(sBufferFormats, BUFFERS_COUNT); },
+		[]() { ColorNormalCmdListRecorder::InitPSO(sBufferFormats, BUFFERS_COUNT); },
+		[]() { HeightCmdListRecorder::InitPSO(sBufferFormats, BUFFERS_COUNT); },
+		[]() { NormalCmdListRecorder::InitPSO(sBufferFormats, BUFFERS_COUNT); },
+		[]() { TextureCmdListRecorder::InitPSO(sBufferFormats, BUFFERS_COUNT); });
+}
+
 void GeometryPass::Init(
 	const D3D12_CPU_DESCRIPTOR_HANDLE& depthBufferCpuDesc,
 	CommandListExecutor& cmdListExecutor,
-	ID3D12CommandQueue& cmdQueue) noexcept {
+	ID3D12CommandQueue& cmdQueue,
+	TransformHierarchy& transforms) noexcept {
 
 	ASSERT(ValidateData() == false);
 	
@@ -105,20 +125,16 @@ void GeometryPass::Init(
 
 	mCmdListExecutor = &cmdListExecutor;
 	mCmdQueue = &cmdQueue;
+	mTransforms = &transforms;
 
 	CreateBuffers(mBuffers, mRtvCpuDescs);
 	CreateCommandObjects(mCmdAllocs, mCmdList);
+	for (std::uint32_t i = 0U; i < sMaxDrawPacketCmdListCount; ++i) {
+		CreateCommandObjects(mDrawPacketCmdAllocs[i], mDrawPacketCmdLists[i]);
+	}
 
 	mDepthBufferCpuDesc = depthBufferCpuDesc;
 
-	// Initialize recorders PSOs
-	ColorCmdListRecorder::InitPSO(sBufferFormats, BUFFERS_COUNT);
-	ColorHeightCmdListRecorder::InitPSO(sBufferFormats, BUFFERS_COUNT);
-	ColorNormalCmdListRecorder::InitPSO(sBufferFormats, BUFFERS_COUNT);
-	HeightCmdListRecorder::InitPSO(sBufferFormats, BUFFERS_COUNT);
-	NormalCmdListRecorder::InitPSO(sBufferFormats, BUFFERS_COUNT);
-	TextureCmdListRecorder::InitPSO(sBufferFormats, BUFFERS_COUNT);
-
 	// Build geometry buffers cpu descriptors
 	const D3D12_CPU_DESCRIPTOR_HANDLE geomBuffersCpuDescs[]{
 		mRtvCpuDescs[NORMAL_SMOOTHNESS],
@@ -127,41 +143,103 @@ void GeometryPass::Init(
 	ASSERT(_countof(geomBuffersCpuDescs) == BUFFERS_COUNT);
 	memcpy(mGeometryBuffersCpuDescs, &geomBuffersCpuDescs, sizeof(geomBuffersCpuDescs));
 
-	// Init internal data for all geometry recorders
+	// Recorders were initialized by the scene, so all their materials are registered
+	MaterialRegistry::Get().BuildBuffer();
+
+	// Init internal data for all geometry recorders (instances world data is computed
+	// from transforms), and find their pipeline states (draw packets are sorted by them)
+	mTransforms->Update();
+	ASSERT(mRecorders.size() <= (1UL << RenderQueue::sRecorderBits));
 	for (Recorders::value_type& recorder : mRecorders) {
 		ASSERT(recorder.get() != nullptr);
-		recorder->InitInternal(
-			mCmdListExecutor->CmdListQueue(),
-			mGeometryBuffersCpuDescs,
-			BUFFERS_COUNT,
-			mDepthBufferCpuDesc);
+		recorder->InitInternal(mOcclusionCuller, *mTransforms);
+		recorder->AppendOccluders(mOccluders);
+
+		ID3D12PipelineState* pipelineState{ &recorder->PipelineState() };
+		const std::vector<ID3D12PipelineState*>::const_iterator it{ std::find(mPipelineStates.begin(), mPipelineStates.end(), pipelineState) };
+		mRecorderPipelines.push_back(static_cast<std::uint32_t>(it - mPipelineStates.begin()));
+		if (it == mPipelineStates.end()) {
+			mPipelineStates.push_back(pipelineState);
+		}
 	}
+	ASSERT(mPipelineStates.size() <= (1UL << RenderQueue::sPipelineBits));
 
 	ASSERT(ValidateData());
 }
 
 void GeometryPass::Execute(const FrameCBuffer& frameCBuffer) noexcept {
+	PROFILE_ZONE("GeometryPass::Execute");
 
 	ASSERT(ValidateData());
 
 	ExecuteBeginTask();
 
-	const std::uint32_t taskCount{ static_cast<std::uint32_t>(mRecorders.size()) };
-	mCmdListExecutor->ResetExecutedCmdListCount();
+	// Transforms modified since last frame are propagated before occluders and recorders read them
+	mTransforms->Update();
 
-	// Execute geometry tasks
+	RasterizeOccluders(frameCBuffer);
+
+	// Cull recorders instances
+	const std::uint32_t taskCount{ static_cast<std::uint32_t>(mRecorders.size()) };
 	std::uint32_t grainSize{ max(1U, (taskCount) / Settings::sCpuProcessors) };
 	tbb::parallel_for(tbb::blocked_range<std::size_t>(0, taskCount, grainSize),
 		[&](const tbb::blocked_range<size_t>& r) {
 		for (size_t i = r.begin(); i != r.end(); ++i)
-			mRecorders[i]->RecordAndPushCommandLists(frameCBuffer);
+			mRecorders[i]->PrepareFrame(frameCBuffer);
 	}
 	);
 
-	// Wait until all previous tasks command lists are executed
-	while (mCmdListExecutor->ExecutedCmdListCount() < taskCount) {
-		Sleep(0U);
+	// Gather and sort draw packets. Root parameters (instances, materials and
+	// textures buffers) are per recorder, so packets are grouped by recorder.
+	mRenderQueue.Clear();
+	for (std::uint32_t i = 0U; i < taskCount; ++i) {
+		mRecorders[i]->PushDrawPackets(sRenderQueuePass, mRecorderPipelines[i], i, mRenderQueue);
+	}
+	mRenderQueue.Sort();
+
+	// Record sorted packets in consecutive ranges, a command list per range.
+	// Ranges are split evenly, so each one has at least sMinDrawPacketsPerCmdList packets
+	// (if there are less packets, then a single command list records all of them).
+	const std::uint32_t packetCount{ mRenderQueue.PacketCount() };
+	const std::uint32_t cmdListCount{
+		min(sMaxDrawPacketCmdListCount, max(min(packetCount, 1U), packetCount / sMinDrawPacketsPerCmdList)) };
+	tbb::parallel_for(tbb::blocked_range<std::uint32_t>(0U, cmdListCount, 1U),
+		[&](const tbb::blocked_range<std::uint32_t>& r) {
+		for (std::uint32_t i = r.begin(); i != r.end(); ++i) {
+			RecordDrawPackets(i, (packetCount * i) / cmdListCount, (packetCount * (i + 1U)) / cmdListCount);
+		}
 	}
+	);
+
+	// Push command lists in packets order
+	mCmdListExecutor->ResetExecutedCmdListCount();
+	mStateChanges = StateChanges();
+	for (std::uint32_t i = 0U; i < cmdListCount; ++i) {
+		mCmdListExecutor->CmdListQueue().push(mDrawPacketCmdLists[i]);
+
+		mStateChanges.mPipelineChangeCount += mCmdListStateChanges[i].mPipelineChangeCount;
+		mStateChanges.mRootParametersChangeCount += mCmdListStateChanges[i].mRootParametersChangeCount;
+		mStateChanges.mGeometryBufferChangeCount += mCmdListStateChanges[i].mGeometryBufferChangeCount;
+	}
+	mRecordedCmdListCount = cmdListCount;
+
+	// Gather culling and upload counters
+	mVisibleInstanceCount = 0U;
+	mCulledInstanceCount = 0U;
+	mOccludedInstanceCount = 0U;
+	mUploadedByteCount = 0UL;
+	for (const Recorders::value_type& recorder : mRecorders) {
+		mVisibleInstanceCount += recorder->VisibleInstanceCount();
+		mCulledInstanceCount += recorder->CulledInstanceCount();
+		mOccludedInstanceCount += recorder->OccludedInstanceCount();
+		mUploadedByteCount += recorder->UploadedByteCount();
+	}
+
+	// Wait until all previous tasks command lists are executed
+	mCmdListExecutor->WaitForExecutedCmdLists(cmdListCount);
+
+	// Next frame
+	mCurrFrameIndex = (mCurrFrameIndex + 1U) % Settings::sQueuedFrameCount;
 }
 
 bool GeometryPass::ValidateData() const noexcept {
@@ -169,6 +247,18 @@ bool GeometryPass::ValidateData() const noexcept {
 		if (mCmdAllocs[i] == nullptr) {
 			return false;
 		}
+
+		for (std::uint32_t j = 0U; j < sMaxDrawPacketCmdListCount; ++j) {
+			if (mDrawPacketCmdAllocs[j][i] == nullptr) {
+				return false;
+			}
+		}
+	}
+
+	for (std::uint32_t i = 0U; i < sMaxDrawPacketCmdListCount; ++i) {
+		if (mDrawPacketCmdLists[i] == nullptr) {
+			return false;
+		}
 	}
 
 	for (std::uint32_t i = 0U; i < BUFFERS_COUNT; ++i) {
@@ -187,7 +277,9 @@ bool GeometryPass::ValidateData() const noexcept {
 		mCmdListExecutor != nullptr &&
 		mCmdQueue != nullptr &&
 		mCmdList != nullptr &&
+		mTransforms != nullptr &&
 		mRecorders.empty() == false &&
+		mRecorderPipelines.size() == mRecorders.size() &&
 		mDepthBufferCpuDesc.ptr != 0UL;
 
 		return b;
@@ -219,5 +311,134 @@ void GeometryPass::ExecuteBeginTask() noexcept {
 	// Execute preliminary task
 	ID3D12CommandList* cmdLists[] = { mCmdList };
 	ASSERT(mCmdQueue != nullptr);
+	RENDER_STATS_EXECUTE(_countof(cmdLists));
 	mCmdQueue->ExecuteCommandLists(_countof(cmdLists), cmdLists);
+}
+
+void GeometryPass::RasterizeOccluders(const FrameCBuffer& frameCBuffer) noexcept {
+	PROFILE_ZONE("GeometryPass::RasterizeOccluders");
+
+	// Frame cbuffer matrices are transposed for shaders
+	DirectX::XMFLOAT4X4 viewProj;
+	DirectX::XMStoreFloat4x4(
+		&viewProj,
+		DirectX::XMMatrixMultiply(MathUtils::GetTranspose(frameCBuffer.mView), MathUtils::GetTranspose(frameCBuffer.mProj)));
+
+	mOcclusionCuller.BeginFrame(&viewProj.m[0U][0U]);
+
+	if (mOccluders.empty() == false) {
+		const float eyePosition[3U]{ frameCBuffer.mEyePosW.x, frameCBuffer.mEyePosW.y, frameCBuffer.mEyePosW.z };
+		OcclusionCuller::SelectOccluders(
+			mOccluders.data(),
+			static_cast<std::uint32_t>(mOccluders.size()),
+			eyePosition,
+			sMaxOccluderTriangleCount,
+			mSelectedOccluders);
+
+		for (const std::uint32_t occluderIndex : mSelectedOccluders) {
+			const OccluderInstance& occluder(mOccluders[occluderIndex]);
+			mOcclusionCuller.RasterizeOccluder(*occluder.mMesh, occluder.mWorld);
+		}
+	}
+
+	mOcclusionCuller.EndFrame();
+}
+
+void GeometryPass::RecordDrawPackets(
+	const std::uint32_t cmdListIndex,
+	const std::uint32_t firstPacket,
+	const std::uint32_t lastPacket) noexcept
+{
+	PROFILE_ZONE("GeometryPass::RecordDrawPackets");
+
+	ASSERT(cmdListIndex < sMaxDrawPacketCmdListCount);
+
+	ID3D12CommandAllocator* cmdAlloc{ mDrawPacketCmdAllocs[cmdListIndex][mCurrFrameIndex] };
+	ID3D12GraphicsCommandList& d3dCmdList(*mDrawPacketCmdLists[cmdListIndex]);
+
+	CHECK_HR(cmdAlloc->Reset());
+	CHECK_HR(d3dCmdList.Reset(cmdAlloc, nullptr));
+
+	D3D12CommandList cmdList(d3dCmdList);
+	StateChanges& stateChanges(mCmdListStateChanges[cmdListIndex]);
+	stateChanges = StateChanges();
+	RecordDrawPacketRange(cmdList, firstPacket, lastPacket, stateChanges);
+
+	CHECK_HR(d3dCmdList.Close());
+}
+
+void GeometryPass::RecordDrawPackets(GraphicsCommandList& cmdList) const noexcept {
+	ASSERT(ValidateData());
+
+	StateChanges stateChanges;
+	if (mRenderQueue.PacketCount() > 0U) {
+		RecordDrawPacketRange(cmdList, 0U, mRenderQueue.PacketCount(), stateChanges);
+	}
+}
+
+void GeometryPass::CaptureLastFrame(const FrameCBuffer& frameCBuffer, CommandStream& stream) const noexcept {
+	ASSERT(ValidateData());
+
+	stream.BeginFrame(&frameCBuffer, sizeof(FrameCBuffer));
+
+	CaptureCommandList cmdList(stream);
+	const std::uint32_t packetCount{ mRenderQueue.PacketCount() };
+	const std::uint32_t cmdListCount{ mRecordedCmdListCount };
+	for (std::uint32_t i = 0U; i < cmdListCount; ++i) {
+		StateChanges stateChanges;
+		RecordDrawPacketRange(cmdList, (packetCount * i) / cmdListCount, (packetCount * (i + 1U)) / cmdListCount, stateChanges);
+		stream.CloseCommandList();
+	}
+
+	if (cmdListCount > 0U) {
+		stream.ExecuteCommandLists(cmdListCount);
+	}
+}
+
+void GeometryPass::RecordDrawPacketRange(
+	GraphicsCommandList& cmdList,
+	const std::uint32_t firstPacket,
+	const std::uint32_t lastPacket,
+	StateChanges& stateChanges) const noexcept
+{
+	ASSERT(firstPacket < lastPacket);
+	ASSERT(lastPacket <= mRenderQueue.PacketCount());
+
+	cmdList.RSSetViewports(1U, D3D12CommandList::ToPortable(&Settings::sScreenViewport));
+	cmdList.RSSetScissorRects(1U, D3D12CommandList::ToPortable(&Settings::sScissorRect));
+	cmdList.OMSetRenderTargets(
+		BUFFERS_COUNT, 
+		D3D12CommandList::ToPortable(mGeometryBuffersCpuDescs), 
+		false, 
+		D3D12CommandList::ToPortable(&mDepthBufferCpuDesc));
+
+	ID3D12DescriptorHeap* heaps[] = { &DescriptorManager::Get().GetCbvSrcUavDescriptorHeap() };
+	cmdList.SetDescriptorHeaps(_countof(heaps), heaps);
+
+	// The first packet sets all the state
+	D3D12_GPU_VIRTUAL_ADDRESS boundVertexBuffer{ 0UL };
+	D3D12_GPU_VIRTUAL_ADDRESS boundIndexBuffer{ 0UL };
+	const DrawPacket& firstDrawPacket(mRenderQueue.SortedPacket(firstPacket));
+	std::uint64_t pipelineState{ ~RenderQueue::PipelineState(firstDrawPacket.mKey) };
+	std::uint64_t recorderState{ ~RenderQueue::RecorderState(firstDrawPacket.mKey) };
+	for (std::uint32_t i = firstPacket; i < lastPacket; ++i) {
+		const DrawPacket& packet(mRenderQueue.SortedPacket(i));
+		const GeometryPassCmdListRecorder& recorder(*mRecorders[packet.mRecorderIndex]);
+
+		// Changing root signature invalidates root parameters, so pipeline changes are recorder changes too
+		if (RenderQueue::PipelineState(packet.mKey) != pipelineState) {
+			pipelineState = RenderQueue::PipelineState(packet.mKey);
+			recorder.SetPipeline(cmdList);
+			++stateChanges.mPipelineChangeCount;
+			recorderState = ~RenderQueue::RecorderState(packet.mKey);
+		}
+
+		if (RenderQueue::RecorderState(packet.mKey) != recorderState) {
+			recorderState = RenderQueue::RecorderState(packet.mKey);
+			recorder.SetRootParameters(cmdList);
+			++stateChanges.mRootParametersChangeCount;
+		}
+
+		stateChanges.mGeometryBufferChangeCount += recorder.RecordDraw(cmdList, packet, boundVertexBuffer, boundIndexBuffer);
+	}
 }
\ No newline at end of file
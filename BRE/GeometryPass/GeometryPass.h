@@ -5,17 +5,28 @@
 
 #include <GlobalData\Settings.h>
 #include <GeometryPass\GeometryPassCmdListRecorder.h>
+#include <GeometryPass/RenderQueue.h>
+#include <MathUtils/TransformHierarchy.h>
+#include <OcclusionCulling/OcclusionCuller.h>
 
 class CommandListExecutor;
+class CommandStream;
 struct D3D12_CPU_DESCRIPTOR_HANDLE;
 struct FrameCBuffer;
 struct ID3D12CommandAllocator;
 struct ID3D12CommandQueue;
 struct ID3D12Device;
 struct ID3D12GraphicsCommandList;
+struct ID3D12PipelineState;
 struct ID3D12Resource;
 
-// Pass responsible to execute recorders related with deferred shading geometry pass
+// Pass responsible to execute recorders related with deferred shading geometry pass.
+// Each frame, it updates scene transforms first, so recorders instances follow them.
+// Before recording, the biggest occluders (on screen) are rasterized in a CPU depth buffer,
+// that recorders use to cull occluded instances.
+// Recorders visible draws are gathered in a render queue and sorted by pipeline, material (recorder),
+// depth (front to back) and mesh. Sorted draws are split in consecutive ranges, that are recorded
+// in parallel in different command lists, and executed in order.
 class GeometryPass {
 public:
 	// Geometry buffers
@@ -37,23 +48,86 @@ public:
 	// You should get recorders and fill them, before calling Init()
 	__forceinline Recorders& GetRecorders() noexcept { return mRecorders; }
 
-	// You should call this method after filling recorders and before Execute()
+	// Creates recorders pipeline states (in parallel). It does not need recorders,
+	// so it can run while the scene is loaded, but it must be called before Init().
+	static void InitPSOs() noexcept;
+
+	// You should call this method after filling recorders and before Execute().
+	// transforms are the scene transforms referenced by recorders instances.
 	void Init(
 		const D3D12_CPU_DESCRIPTOR_HANDLE& depthBufferCpuDesc,
 		CommandListExecutor& cmdListExecutor,
-		ID3D12CommandQueue& cmdQueue) noexcept;
+		ID3D12CommandQueue& cmdQueue,
+		TransformHierarchy& transforms) noexcept;
 	
 	// Get geometry buffers
 	__forceinline Microsoft::WRL::ComPtr<ID3D12Resource>* GetBuffers() noexcept { return mBuffers; }
 	
 	void Execute(const FrameCBuffer& frameCBuffer) noexcept;
 
+	// Culling counters of the last executed frame (all recorders).
+	// Culled instances include occluded ones.
+	__forceinline std::uint32_t VisibleInstanceCount() const noexcept { return mVisibleInstanceCount; }
+	__forceinline std::uint32_t CulledInstanceCount() const noexcept { return mCulledInstanceCount; }
+	__forceinline std::uint32_t OccludedInstanceCount() const noexcept { return mOccludedInstanceCount; }
+	__forceinline std::uint32_t OccluderTriangleCount() const noexcept { return mOcclusionCuller.RasterizedTriangleCount(); }
+
+	// Bytes copied to upload buffers by recorders in the last executed frame
+	__forceinline std::size_t UploadedByteCount() const noexcept { return mUploadedByteCount; }
+
+	// Draws and state changes recorded in the last executed frame (all command lists).
+	// Geometry buffer changes are vertex and index buffers bindings.
+	__forceinline std::uint32_t DrawCount() const noexcept { return mRenderQueue.PacketCount(); }
+	__forceinline std::uint32_t RecordedCmdListCount() const noexcept { return mRecordedCmdListCount; }
+	__forceinline std::uint32_t PipelineChangeCount() const noexcept { return mStateChanges.mPipelineChangeCount; }
+	__forceinline std::uint32_t RootParametersChangeCount() const noexcept { return mStateChanges.mRootParametersChangeCount; }
+	__forceinline std::uint32_t GeometryBufferChangeCount() const noexcept { return mStateChanges.mGeometryBufferChangeCount; }
+
+	// Records all sorted draw packets of the last executed frame in a single command list
+	// of any backend (for example, a NullCommandList to validate and count them).
+	void RecordDrawPackets(GraphicsCommandList& cmdList) const noexcept;
+
+	// Captures the last executed frame in stream: its frame constant buffer, and its draw packets
+	// split in the same command lists and executed in the same ExecuteCommandLists() call.
+	void CaptureLastFrame(const FrameCBuffer& frameCBuffer, CommandStream& stream) const noexcept;
+
 private:
+	// Draw packets are recorded in at most this count of command lists, and each
+	// command list records at least sMinDrawPacketsPerCmdList packets (or all of them, if there are less)
+	static const std::uint32_t sMaxDrawPacketCmdListCount{ Settings::sCpuProcessors };
+	static const std::uint32_t sMinDrawPacketsPerCmdList{ 64U };
+
+	// Render queue pass of geometry pass draw packets
+	static const std::uint32_t sRenderQueuePass{ 0U };
+
+	struct StateChanges {
+		std::uint32_t mPipelineChangeCount{ 0U };
+		std::uint32_t mRootParametersChangeCount{ 0U };
+		std::uint32_t mGeometryBufferChangeCount{ 0U };
+	};
+
 	// Method used internally for validation purposes
 	bool ValidateData() const noexcept;
 
 	void ExecuteBeginTask() noexcept;
 
+	// Selects and rasterizes occluders for current camera
+	void RasterizeOccluders(const FrameCBuffer& frameCBuffer) noexcept;
+
+	// Records sorted draw packets [firstPacket, lastPacket) in a draw packets command list.
+	void RecordDrawPackets(
+		const std::uint32_t cmdListIndex,
+		const std::uint32_t firstPacket,
+		const std::uint32_t lastPacket) noexcept;
+
+	// Records sorted draw packets [firstPacket, lastPacket), with render targets state.
+	// Pipeline and root parameters are only set when they change.
+	void RecordDrawPacketRange(
+		GraphicsCommandList& cmdList,
+		const std::uint32_t firstPacket,
+		const std::uint32_t lastPacket,
+		StateChanges& stateChanges) const noexcept;
+
 	CommandListExecutor* mCmdListExecutor{ nullptr };
 	ID3D12CommandQueue* mCmdQueue{ nullptr };
 
@@ -62,6 +136,11 @@ private:
 
 	ID3D12GraphicsCommandList* mCmdList{ nullptr };
 
+	// Command lists where draw packets are recorded, and their command allocators (1 per queued frame)
+	ID3D12CommandAllocator* mDrawPacketCmdAllocs[sMaxDrawPacketCmdListCount][Settings::sQueuedFrameCount]{ nullptr };
+	ID3D12GraphicsCommandList* mDrawPacketCmdLists[sMaxDrawPacketCmdListCount]{ nullptr };
+	std::uint32_t mCurrFrameIndex{ 0U };
+
 	// Geometry buffers data
 	Microsoft::WRL::ComPtr<ID3D12Resource> mBuffers[BUFFERS_COUNT];
 	D3D12_CPU_DESCRIPTOR_HANDLE mRtvCpuDescs[BUFFERS_COUNT];
@@ -73,4 +152,32 @@ private:
 	D3D12_CPU_DESCRIPTOR_HANDLE mGeometryBuffersCpuDescs[BUFFERS_COUNT]{ 0UL };
 	
 	Recorders mRecorders;
+
+	TransformHierarchy* mTransforms{ nullptr };
+
+	// Distinct recorders pipeline states, and the index in it of each recorder pipeline state
+	std::vector<ID3D12PipelineState*> mPipelineStates;
+	std::vector<std::uint32_t> mRecorderPipelines;
+
+	RenderQueue mRenderQueue;
+	std::uint32_t mRecordedCmdListCount{ 0U };
+	StateChanges mCmdListStateChanges[sMaxDrawPacketCmdListCount];
+	StateChanges mStateChanges;
+
+	// Occlusion culling depth buffer size, and max triangles rasterized per frame
+	static const std::uint32_t sOcclusionBufferWidth{ 320U };
+	static const std::uint32_t sOcclusionBufferHeight{ 192U };
+	static const std::uint32_t sMaxOccluderTriangleCount{ 8192U };
+
+	OcclusionCuller mOcclusionCuller{ sOcclusionBufferWidth, sOcclusionBufferHeight };
+
+	// All recorders occluders, and the ones selected in current frame.
+	// Occluders bounding spheres (only used to select them) are computed at Init().
+	std::vector<OccluderInstance> mOccluders;
+	std::vector<std::uint32_t> mSelectedOccluders;
+
+	std::uint32_t mVisibleInstanceCount{ 0U };
+	std::uint32_t mCulledInstanceCount{ 0U };
+	std::uint32_t mOccludedInstanceCount{ 0U };
+	std::size_t mUploadedByteCount{ 0UL };
 };
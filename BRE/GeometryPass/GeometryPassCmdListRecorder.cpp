@@ -1,77 +1,388 @@
 #include "GeometryPassCmdListRecorder.h"
 
-#include <CommandManager/CommandManager.h>
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <utility>
+
+#include <CommandManager/D3D12CommandList.h>
+#include <DescriptorManager/TextureRegistry.h>
+#include <Material/MaterialRegistry.h>
+#include <MathUtils/MathUtils.h>
+#include <ResourceManager/ResourceManager.h>
+#include <ResourceManager/UploadBuffer.h>
 #include <ShaderUtils\CBuffers.h>
 #include <Utils/DebugUtils.h>
+#include <Utils/Profiler.h>
 
-namespace {
-	void BuildCommandObjects(ID3D12GraphicsCommandList* &cmdList, ID3D12CommandAllocator* cmdAlloc[], const std::size_t cmdAllocCount) noexcept {
-		ASSERT(cmdList == nullptr);
+GeometryPassCmdListRecorder::GeometryPassCmdListRecorder(ID3D12Device& device, const std::uint32_t instanceOffsetRootParamIndex)
+	: mDevice(device)
+	, mInstanceOffsetRootParamIndex(instanceOffsetRootParamIndex)
+{
+}
 
-#ifdef _DEBUG
-		for (std::uint32_t i = 0U; i < cmdAllocCount; ++i) {
-			ASSERT(cmdAlloc[i] == nullptr);
+bool GeometryPassCmdListRecorder::ValidateData() const noexcept {
+	const std::size_t numGeomData{ mGeometryDataVec.size() };
+	for (std::size_t i = 0UL; i < numGeomData; ++i) {
+		const std::size_t numMatrices{ mGeometryDataVec[i].mTransformHandles.size() };
+		if (numMatrices == 0UL) {
+			return false;
 		}
-#endif
+	}
+
+	for (std::uint32_t i = 0UL; i < Settings::sQueuedFrameCount; ++i) {
+		if (mFrameCBuffer[i] == nullptr || mVisibleInstancesBuffer[i] == nullptr) {
+			return false;
+		}
+	}
+
+	return
+		numGeomData != 0UL &&
+		mInstanceStream.ValidateData() &&
+		mInstances.size() == mInstanceStream.InstanceCount() &&
+		mInstances.size() == mFrustumCuller.SphereCount() &&
+		mInstances.size() == mInstanceBoxes.size() &&
+		mVisibleInstanceCounts.size() == numGeomData &&
+		mVisibleInstanceMinDepths.size() == numGeomData &&
+		mGeometryBuffersKeys.size() == numGeomData &&
+		mMaterialKeys.size() == numGeomData;
+}
+
+void GeometryPassCmdListRecorder::InitInternal(const OcclusionCuller& occlusionCuller, const TransformHierarchy& transforms) noexcept {
+	mOcclusionCuller = &occlusionCuller;
+	mTransforms = &transforms;
+
+	UpdateInstances(true);
+}
+
+void GeometryPassCmdListRecorder::PrepareFrame(const FrameCBuffer& frameCBuffer) noexcept {
+	PROFILE_ZONE("GeometryPassCmdListRecorder::PrepareFrame");
+
+	ASSERT(ValidateData());
+
+	// Frame buffers are used until the frame packets are recorded, so the
+	// frame index is advanced here instead of after recording.
+	mCurrFrameIndex = (mCurrFrameIndex + 1U) % Settings::sQueuedFrameCount;
 
-		for (std::uint32_t i = 0U; i < cmdAllocCount; ++i) {
-			CommandManager::Get().CreateCmdAlloc(D3D12_COMMAND_LIST_TYPE_DIRECT, cmdAlloc[i]);
+	// Update frame constants
+	UploadBuffer& uploadFrameCBuffer(*mFrameCBuffer[mCurrFrameIndex]);
+	uploadFrameCBuffer.CopyData(0U, &frameCBuffer, sizeof(frameCBuffer));
+
+	UpdateInstances(false);
+	mInstanceStream.Upload(mCurrFrameIndex, mInstances.data());
+	mUploadedByteCount = sizeof(frameCBuffer) + mInstanceStream.UploadedByteCount();
+
+	// Cull instances and upload visible ones
+	CullInstances(frameCBuffer);
+}
+
+void GeometryPassCmdListRecorder::PushDrawPackets(
+	const std::uint32_t pass,
+	const std::uint32_t pipeline,
+	const std::uint32_t recorderIndex,
+	RenderQueue& renderQueue) const noexcept
+{
+	PROFILE_ZONE("GeometryPassCmdListRecorder::PushDrawPackets");
+
+	ASSERT(mVisibleInstanceCounts.size() == mGeometryDataVec.size());
+
+	DrawPacket packet;
+	packet.mRecorderIndex = recorderIndex;
+	packet.mInstanceOffset = 0U;
+	const std::uint32_t geomCount{ static_cast<std::uint32_t>(mGeometryDataVec.size()) };
+	for (std::uint32_t i = 0U; i < geomCount; ++i) {
+		const std::uint32_t instanceCount{ mVisibleInstanceCounts[i] };
+		if (instanceCount == 0U) {
+			continue;
 		}
 
-		CommandManager::Get().CreateCmdList(D3D12_COMMAND_LIST_TYPE_DIRECT, *cmdAlloc[0], cmdList);
+		const std::uint32_t depth{ RenderQueue::QuantizeDepth(mVisibleInstanceMinDepths[i], Settings::sNearPlaneZ, Settings::sFarPlaneZ) };
+		packet.mKey = RenderQueue::MakeKey(pass, pipeline, recorderIndex, mGeometryBuffersKeys[i], mMaterialKeys[i], depth);
+		packet.mGeometryIndex = i;
+		packet.mInstanceCount = instanceCount;
+		renderQueue.Push(packet);
 
-		cmdList->Close();
+		packet.mInstanceOffset += instanceCount;
 	}
 }
 
-GeometryPassCmdListRecorder::GeometryPassCmdListRecorder(ID3D12Device& device)
-	: mDevice(device)
+std::uint32_t GeometryPassCmdListRecorder::RecordDraw(
+	GraphicsCommandList& cmdList,
+	const DrawPacket& packet,
+	D3D12_GPU_VIRTUAL_ADDRESS& boundVertexBuffer,
+	D3D12_GPU_VIRTUAL_ADDRESS& boundIndexBuffer) const noexcept
 {
-	BuildCommandObjects(mCmdList, mCmdAlloc, _countof(mCmdAlloc));
+	ASSERT(packet.mGeometryIndex < mGeometryDataVec.size());
+	ASSERT(packet.mInstanceCount == mVisibleInstanceCounts[packet.mGeometryIndex]);
+
+	const GeometryData& geomData{ mGeometryDataVec[packet.mGeometryIndex] };
+	const std::uint32_t boundBufferCount{ SetGeometryBuffers(cmdList, geomData, boundVertexBuffer, boundIndexBuffer) };
+
+	cmdList.SetGraphicsRoot32BitConstant(mInstanceOffsetRootParamIndex, packet.mInstanceOffset, 0U);
+	cmdList.DrawIndexedInstanced(
+		geomData.mIndexBufferData.mCount,
+		packet.mInstanceCount,
+		geomData.mIndexBufferData.mStartIndex,
+		geomData.mVertexBufferData.mBaseVertex,
+		0U);
+
+	return boundBufferCount;
 }
 
-bool GeometryPassCmdListRecorder::ValidateData() const noexcept {
-	for (std::uint32_t i = 0UL; i < Settings::sQueuedFrameCount; ++i) {
-		if (mCmdAlloc[i] == nullptr) {
-			return false;
+void GeometryPassCmdListRecorder::AppendOccluders(std::vector<OccluderInstance>& occluders) const noexcept {
+	for (const GeometryData& geomData : mGeometryDataVec) {
+		if (geomData.mOccluderMesh == nullptr) {
+			continue;
+		}
+
+		for (const TransformHierarchy::Handle transform : geomData.mTransformHandles) {
+			OccluderInstance occluder;
+			occluder.mMesh = geomData.mOccluderMesh;
+			occluder.mWorld = mTransforms->WorldMatrix(transform);
+			geomData.mBoundingVolumes.TransformSphere(occluder.mWorld, occluder.mSphereCenter, occluder.mSphereRadius);
+			occluders.push_back(occluder);
 		}
 	}
+}
+
+
+void GeometryPassCmdListRecorder::BuildInstancesBuffers(const std::uint32_t* materialIndices, const std::uint32_t numInstances) noexcept {
+	ASSERT(materialIndices != nullptr);
+	ASSERT(numInstances != 0U);
+
+	// Structured buffers elements are tightly packed (no constant buffer alignment).
+	// Instances data is computed and uploaded later, as visible instances indices.
+	mInstanceStream.Init(numInstances);
+	for (std::uint32_t i = 0U; i < Settings::sQueuedFrameCount; ++i) {
+		ASSERT(mVisibleInstancesBuffer[i] == nullptr);
+		ResourceManager::Get().CreateUploadBuffer(sizeof(std::uint32_t), numInstances, mVisibleInstancesBuffer[i]);
+	}
+
+	mInstances.resize(numInstances);
+	mFrustumCuller.ResizeSpheres(numInstances);
+	mInstanceBoxes.resize(numInstances);
+	for (std::uint32_t i = 0U; i < numInstances; ++i) {
+		mInstances[i].mMaterialIndex = materialIndices[i];
+	}
 
 	const std::size_t numGeomData{ mGeometryDataVec.size() };
+	mChangedInstanceIndices.reserve(numInstances);
+	mChangedInstanceBoxes.reserve(numInstances);
+	mVisibleInstanceIndices.reserve(numInstances);
+	mVisibleInstanceCounts.resize(numGeomData, 0U);
+	mVisibleInstanceMinDepths.resize(numGeomData, 0.0f);
+
+	// Sort key fields of each geometry data. Geometry buffers are numbered in order
+	// of first use (a recorder uses a few GeometryPool arenas).
+	std::vector<std::pair<const ID3D12Resource*, const ID3D12Resource*>> geometryBuffers;
+	mGeometryBuffersKeys.resize(numGeomData);
+	mMaterialKeys.resize(numGeomData);
+	std::uint32_t instanceOffset{ 0U };
 	for (std::size_t i = 0UL; i < numGeomData; ++i) {
-		const std::size_t numMatrices{ mGeometryDataVec[i].mWorldMatrices.size() };
-		if (numMatrices == 0UL) {
-			return false;
+		const GeometryData& geomData{ mGeometryDataVec[i] };
+		const std::pair<const ID3D12Resource*, const ID3D12Resource*> buffers{ geomData.mVertexBufferData.mBuffer, geomData.mIndexBufferData.mBuffer };
+		const std::size_t buffersIndex{ static_cast<std::size_t>(std::find(geometryBuffers.begin(), geometryBuffers.end(), buffers) - geometryBuffers.begin()) };
+		if (buffersIndex == geometryBuffers.size()) {
+			geometryBuffers.push_back(buffers);
+		}
+		mGeometryBuffersKeys[i] = static_cast<std::uint32_t>(std::min(buffersIndex, static_cast<std::size_t>(RenderQueue::sMaxGeometryBuffers)));
+
+		const std::uint32_t instanceCount{ static_cast<std::uint32_t>(geomData.mTransformHandles.size()) };
+		ASSERT(instanceOffset + instanceCount <= numInstances);
+		std::uint32_t material{ std::min(materialIndices[instanceOffset], RenderQueue::sMixedMaterial) };
+		for (std::uint32_t j = 1U; j < instanceCount; ++j) {
+			if (materialIndices[instanceOffset + j] != materialIndices[instanceOffset]) {
+				material = RenderQueue::sMixedMaterial;
+				break;
+			}
 		}
+		mMaterialKeys[i] = material;
+		instanceOffset += instanceCount;
 	}
+	ASSERT(instanceOffset == numInstances);
+}
 
-	for (std::uint32_t i = 0UL; i < Settings::sQueuedFrameCount; ++i) {
-		if (mFrameCBuffer[i] == nullptr) {
-			return false;
+void GeometryPassCmdListRecorder::RegisterTexturedMaterials(
+	const std::uint32_t* materialIndices,
+	ID3D12Resource** diffuseTextures,
+	ID3D12Resource** normalTextures,
+	ID3D12Resource** heightTextures,
+	const std::uint32_t numInstances,
+	std::vector<std::uint32_t>& texturedMaterialIndices) noexcept
+{
+	ASSERT(materialIndices != nullptr);
+	ASSERT(numInstances != 0U);
+
+	MaterialRegistry& materialRegistry(MaterialRegistry::Get());
+	TextureRegistry& textureRegistry(TextureRegistry::Get());
+	texturedMaterialIndices.resize(numInstances);
+	for (std::uint32_t i = 0U; i < numInstances; ++i) {
+		Material material(materialRegistry.GetMaterial(materialIndices[i]));
+		if (diffuseTextures != nullptr) {
+			ASSERT(diffuseTextures[i] != nullptr);
+			material.mDiffuseTextureIndex = textureRegistry.Register(*diffuseTextures[i]);
+		}
+
+		if (normalTextures != nullptr) {
+			ASSERT(normalTextures[i] != nullptr);
+			material.mNormalTextureIndex = textureRegistry.Register(*normalTextures[i]);
 		}
+
+		if (heightTextures != nullptr) {
+			ASSERT(heightTextures[i] != nullptr);
+			material.mHeightTextureIndex = textureRegistry.Register(*heightTextures[i]);
+		}
+
+		texturedMaterialIndices[i] = materialRegistry.Register(material);
 	}
+}
 
-	return
-		mCmdList != nullptr &&
-		mObjectCBuffer != nullptr &&
-		mObjectCBufferGpuDescHandleBegin.ptr != 0UL &&
-		numGeomData != 0UL &&
-		mMaterialsCBuffer != nullptr &&
-		mMaterialsCBufferGpuDescHandleBegin.ptr != 0UL;
+void GeometryPassCmdListRecorder::UpdateInstances(const bool allInstances) noexcept {
+	ASSERT(mTransforms != nullptr);
+
+	if (allInstances == false && mTransforms->ChangedNodeCount() == 0U) {
+		return;
+	}
+
+	mChangedInstanceIndices.clear();
+	mChangedInstanceBoxes.clear();
+	std::uint32_t k = 0U;
+	for (const GeometryData& geomData : mGeometryDataVec) {
+		for (const TransformHierarchy::Handle transform : geomData.mTransformHandles) {
+			if (allInstances || mTransforms->WorldMatrixChanged(transform)) {
+				// Instances world matrices are transposed for shaders
+				const float* world{ mTransforms->WorldMatrix(transform) };
+				InstanceData& instanceData{ mInstances[k] };
+				for (std::uint32_t i = 0U; i < 4U; ++i) {
+					for (std::uint32_t j = 0U; j < 4U; ++j) {
+						instanceData.mWorld.m[j][i] = world[i * 4U + j];
+					}
+				}
+
+				float center[3U];
+				float radius;
+				geomData.mBoundingVolumes.TransformSphere(world, center, radius);
+				mFrustumCuller.SetSphere(k, center, radius);
+				geomData.mBoundingVolumes.TransformAabb(world, mInstanceBoxes[k]);
+
+				mInstanceStream.MarkDirty(k, 1U);
+				mChangedInstanceIndices.push_back(k);
+				mChangedInstanceBoxes.push_back(mInstanceBoxes[k]);
+			}
+
+			++k;
+		}
+	}
+	ASSERT(k == mInstances.size());
+
+	if (k < sBvhMinInstanceCount || mChangedInstanceIndices.empty()) {
+		return;
+	}
+
+	// The hierarchy is built at initialization, and refitted when instances move
+	if (allInstances) {
+		mBvh.Build(mInstanceBoxes.data(), k);
+		ASSERT(mBvh.ValidateData());
+	}
+	else {
+		mBvh.Refit(mChangedInstanceIndices.data(), mChangedInstanceBoxes.data(), static_cast<std::uint32_t>(mChangedInstanceIndices.size()));
+	}
 }
 
-void GeometryPassCmdListRecorder::InitInternal(
-	tbb::concurrent_queue<ID3D12CommandList*>& cmdListQueue,
-	const D3D12_CPU_DESCRIPTOR_HANDLE* geometryBuffersCpuDescs,
-	const std::uint32_t geometryBuffersCpuDescCount,
-	const D3D12_CPU_DESCRIPTOR_HANDLE& depthBufferCpuDesc) noexcept
-{
-	ASSERT(geometryBuffersCpuDescs != nullptr);
-	ASSERT(geometryBuffersCpuDescCount != 0U);
-	ASSERT(depthBufferCpuDesc.ptr != 0UL);
-
-	mCmdListQueue = &cmdListQueue;
-	mGeometryBuffersCpuDescs = geometryBuffersCpuDescs;
-	mGeometryBuffersCpuDescCount = geometryBuffersCpuDescCount;
-	mDepthBufferCpuDesc = depthBufferCpuDesc;
+void GeometryPassCmdListRecorder::CullInstances(const FrameCBuffer& frameCBuffer) noexcept {
+	ASSERT(mVisibleInstancesBuffer[mCurrFrameIndex] != nullptr);
+
+	// Frame cbuffer matrices are transposed for shaders
+	DirectX::XMFLOAT4X4 view;
+	DirectX::XMStoreFloat4x4(&view, MathUtils::GetTranspose(frameCBuffer.mView));
+	DirectX::XMFLOAT4X4 viewProj;
+	DirectX::XMStoreFloat4x4(
+		&viewProj,
+		DirectX::XMMatrixMultiply(DirectX::XMLoadFloat4x4(&view), MathUtils::GetTranspose(frameCBuffer.mProj)));
+	mFrustumCuller.SetViewProjection(&viewProj.m[0U][0U]);
+	if (mBvh.PrimitiveCount() == 0U) {
+		mFrustumCuller.Cull(mVisibleInstanceIndices);
+	}
+	else {
+		// Hierarchy returns visible instances in traversal order
+		mBvh.FrustumQuery(mFrustumCuller.Planes(), mVisibleInstanceIndices);
+		std::sort(mVisibleInstanceIndices.begin(), mVisibleInstanceIndices.end());
+	}
+
+	// Remove instances behind occluders (keeping order)
+	mOccludedInstanceCount = 0U;
+	ASSERT(mOcclusionCuller != nullptr);
+	if (mOcclusionCuller->RasterizedTriangleCount() != 0U) {
+		const std::size_t frustumVisibleCount{ mVisibleInstanceIndices.size() };
+		std::size_t count{ 0UL };
+		for (std::size_t i = 0UL; i < frustumVisibleCount; ++i) {
+			const std::uint32_t instanceIndex{ mVisibleInstanceIndices[i] };
+			mVisibleInstanceIndices[count] = instanceIndex;
+			count += mOcclusionCuller->IsVisible(mInstanceBoxes[instanceIndex]) ? 1UL : 0UL;
+		}
+		mOccludedInstanceCount = static_cast<std::uint32_t>(frustumVisibleCount - count);
+		mVisibleInstanceIndices.resize(count);
+	}
+
+	const std::uint32_t visibleCount{ static_cast<std::uint32_t>(mVisibleInstanceIndices.size()) };
+
+	// Visible indices are sorted, and instances of each geometry data are contiguous,
+	// so they are already grouped by geometry data. Instances data is not copied, only their indices.
+	if (visibleCount != 0U) {
+		const std::size_t byteCount{ visibleCount * sizeof(std::uint32_t) };
+		mVisibleInstancesBuffer[mCurrFrameIndex]->CopyDataStreaming(0U, mVisibleInstanceIndices.data(), byteCount);
+		mUploadedByteCount += byteCount;
+	}
+
+	// The nearest view depth of each geometry data instances (their boxes bounding spheres) is used to sort draws.
+	std::uint32_t visibleIndex{ 0U };
+	std::uint32_t geomInstancesEnd{ 0U };
+	const std::size_t geomCount{ mGeometryDataVec.size() };
+	for (std::size_t i = 0UL; i < geomCount; ++i) {
+		geomInstancesEnd += static_cast<std::uint32_t>(mGeometryDataVec[i].mTransformHandles.size());
+		const std::uint32_t geomVisibleBegin{ visibleIndex };
+		float minDepth{ FLT_MAX };
+		while (visibleIndex < visibleCount && mVisibleInstanceIndices[visibleIndex] < geomInstancesEnd) {
+			const Aabb& box(mInstanceBoxes[mVisibleInstanceIndices[visibleIndex]]);
+			float center[3U];
+			float sqrRadius{ 0.0f };
+			for (std::uint32_t j = 0U; j < 3U; ++j) {
+				center[j] = (box.mMin[j] + box.mMax[j]) * 0.5f;
+				const float extent{ box.mMax[j] - center[j] };
+				sqrRadius += extent * extent;
+			}
+			const float depth{ center[0U] * view._13 + center[1U] * view._23 + center[2U] * view._33 + view._43 };
+			minDepth = std::min(minDepth, depth - std::sqrt(sqrRadius));
+			++visibleIndex;
+		}
+
+		mVisibleInstanceCounts[i] = visibleIndex - geomVisibleBegin;
+		mVisibleInstanceMinDepths[i] = minDepth;
+	}
+	ASSERT(visibleIndex == visibleCount);
 }
+
+std::uint32_t GeometryPassCmdListRecorder::SetGeometryBuffers(
+	GraphicsCommandList& cmdList,
+	const GeometryData& geomData,
+	D3D12_GPU_VIRTUAL_ADDRESS& boundVertexBuffer,
+	D3D12_GPU_VIRTUAL_ADDRESS& boundIndexBuffer) noexcept
+{
+	std::uint32_t boundBufferCount{ 0U };
+
+	const D3D12_VERTEX_BUFFER_VIEW& vertexBufferView(geomData.mVertexBufferData.mBufferView);
+	if (vertexBufferView.BufferLocation != boundVertexBuffer) {
+		cmdList.IASetVertexBuffers(0U, 1U, D3D12CommandList::ToPortable(&vertexBufferView));
+		boundVertexBuffer = vertexBufferView.BufferLocation;
+		++boundBufferCount;
+	}
+
+	const D3D12_INDEX_BUFFER_VIEW& indexBufferView(geomData.mIndexBufferData.mBufferView);
+	if (indexBufferView.BufferLocation != boundIndexBuffer) {
+		cmdList.IASetIndexBuffer(D3D12CommandList::ToPortable(&indexBufferView));
+		boundIndexBuffer = indexBufferView.BufferLocation;
+		++boundBufferCount;
+	}
+
+	return boundBufferCount;
+}
\ No newline at end of file
@@ -2,19 +2,39 @@
 
 #include <d3d12.h>
 #include <DirectXMath.h>
-#include <tbb/concurrent_queue.h>
 
+#include <CommandManager/GraphicsCommandList.h>
 #include <DXUtils/D3DFactory.h>
+#include <GeometryPass/InstanceDataStream.h>
+#include <GeometryPass/RenderQueue.h>
 #include <GlobalData/Settings.h>
+#include <MathUtils/BoundingVolumes.h>
+#include <MathUtils/Bvh.h>
+#include <MathUtils/FrustumCuller.h>
+#include <MathUtils/TransformHierarchy.h>
+#include <OcclusionCulling/OcclusionCuller.h>
 #include <ResourceManager/BufferCreator.h>
+#include <ShaderUtils/CBuffers.h>
 
 struct FrameCBuffer;
 class UploadBuffer;
 
-// This class has common data and functionality to record command lists for deferred shading geometry pass.
+// This class has common data and functionality to record draws for deferred shading geometry pass.
+// Each geometry data is drawn with a single instanced draw. Instances data (world matrix
+// and material index) is stored in a structured buffer per queued frame, and shaders
+// read it through the visible instances indices buffer (indexed by SV_InstanceID).
+// Instances world matrices are read by handle from the scene transforms, and instances
+// whose transforms changed are updated each frame (only them are uploaded).
+// Instances are frustum culled each frame, and only visible ones are drawn.
+// Recorders with many instances cull them hierarchically, with a bounding volume hierarchy.
+// Frustum visible instances are then tested against the occluders rasterized by the geometry pass.
+// Draws are not recorded by recorders command lists: they push a draw packet per geometry data
+// with visible instances to the geometry pass render queue, that sorts all recorders packets
+// and records them.
 // Steps:
-// - Inherit from it and reimplement RecordAndPushCommandLists() method
-// - Call RecordAndPushCommandLists() to create command lists to execute in the GPU
+// - Inherit from it and implement PipelineState(), SetPipeline() and SetRootParameters()
+// - Call PrepareFrame() and PushDrawPackets() each frame
+// - Record packets with SetPipeline(), SetRootParameters() and RecordDraw(), in any GraphicsCommandList backend
 class GeometryPassCmdListRecorder {
 public:
 	struct GeometryData {
@@ -22,10 +42,20 @@ public:
 
 		BufferCreator::VertexBufferData mVertexBufferData;
 		BufferCreator::IndexBufferData mIndexBufferData;
-		std::vector<DirectX::XMFLOAT4X4> mWorldMatrices;
+		BoundingVolumes mBoundingVolumes;
+
+		// If it is not nullptr, instances are occlusion culling occluders
+		const OccluderMesh* mOccluderMesh{ nullptr };
+
+		// Scene transform of each instance. Instances of different geometry data
+		// can share a transform (for example, meshes of the same model).
+		std::vector<TransformHierarchy::Handle> mTransformHandles;
 	};
 
-	explicit GeometryPassCmdListRecorder(ID3D12Device& device);
+	// instanceOffsetRootParamIndex is the root parameter (a 32 bits root constant) where
+	// the index of the first instance of each draw is set, because SV_InstanceID starts at zero in each draw.
+	// Recorders root signatures have the visible instances indices SRV after it.
+	explicit GeometryPassCmdListRecorder(ID3D12Device& device, const std::uint32_t instanceOffsetRootParamIndex);
 	virtual ~GeometryPassCmdListRecorder() {}
 
 	GeometryPassCmdListRecorder(const GeometryPassCmdListRecorder&) = delete;
@@ -33,29 +63,108 @@ public:
 	GeometryPassCmdListRecorder(GeometryPassCmdListRecorder&&) = default;
 	GeometryPassCmdListRecorder& operator=(GeometryPassCmdListRecorder&&) = default;
 
-	// This method must be called before calling RecordAndPushCommandLists()
-	void InitInternal(
-		tbb::concurrent_queue<ID3D12CommandList*>& cmdListQueue,
-		const D3D12_CPU_DESCRIPTOR_HANDLE* geometryBuffersCpuDescs,
-		const std::uint32_t geometryBuffersCpuDescCount,
-		const D3D12_CPU_DESCRIPTOR_HANDLE& depthBufferCpuDesc) noexcept;
-
-	// Record command lists and push them to the queue.
-	virtual void RecordAndPushCommandLists(const FrameCBuffer& frameCBuffer) noexcept = 0;
+	// This method must be called before calling PrepareFrame(), after transforms are updated
+	void InitInternal(const OcclusionCuller& occlusionCuller, const TransformHierarchy& transforms) noexcept;
+
+	// Updates frame constants and instances whose transforms changed in the last transforms
+	// Update(), uploads modified instances and culls instances.
+	// Recorders are independent, so it can be called in parallel for different recorders.
+	void PrepareFrame(const FrameCBuffer& frameCBuffer) noexcept;
+
+	// Pushes a draw packet per geometry data with visible instances in the frame.
+	// Packets keys are built with the pass, pipeline and recorder index given by the caller,
+	// the geometry data buffers and material, and the nearest visible instance depth.
+	// recorderIndex is the index of the recorder in its pass (packets store it to be recorded).
+	void PushDrawPackets(
+		const std::uint32_t pass,
+		const std::uint32_t pipeline,
+		const std::uint32_t recorderIndex,
+		RenderQueue& renderQueue) const noexcept;
+
+	// Pipeline state shared by all recorders of the same type
+	virtual ID3D12PipelineState& PipelineState() const noexcept = 0;
+
+	// Sets pipeline state, root signature and primitive topology
+	virtual void SetPipeline(GraphicsCommandList& cmdList) const noexcept = 0;
+
+	// Sets root parameters of the current frame (frame constants, instances, materials and textures).
+	// Materials are the MaterialRegistry buffer, shared by all recorders.
+	// It must be called after SetPipeline()
+	virtual void SetRootParameters(GraphicsCommandList& cmdList) const noexcept = 0;
+
+	// Records a packet pushed by PushDrawPackets() in the current frame, after SetRootParameters().
+	// Geometry buffers are only bound if they are not the ones already bound.
+	// Bound buffers addresses must be zero for a new command list.
+	// Returns the number of bound geometry buffers.
+	std::uint32_t RecordDraw(
+		GraphicsCommandList& cmdList,
+		const DrawPacket& packet,
+		D3D12_GPU_VIRTUAL_ADDRESS& boundVertexBuffer,
+		D3D12_GPU_VIRTUAL_ADDRESS& boundIndexBuffer) const noexcept;
 
 	// This method validates all data (nullptr's, etc)
 	// When you inherit from this class, you should reimplement it to include
 	// new members
 	virtual bool ValidateData() const noexcept;
 
+	// Appends instances of geometry data with occluder mesh.
+	// World matrices are referenced (in the transforms), so nodes must not be added after this call.
+	void AppendOccluders(std::vector<OccluderInstance>& occluders) const noexcept;
+
+	// Instances counters of the last recorded frame
+	__forceinline std::uint32_t VisibleInstanceCount() const noexcept { return static_cast<std::uint32_t>(mVisibleInstanceIndices.size()); }
+	__forceinline std::uint32_t CulledInstanceCount() const noexcept { return static_cast<std::uint32_t>(mInstances.size()) - VisibleInstanceCount(); }
+	__forceinline std::uint32_t OccludedInstanceCount() const noexcept { return mOccludedInstanceCount; }
+
+	// Bytes copied to upload buffers in the last PrepareFrame() (frame constants,
+	// modified instances and visible instances indices)
+	__forceinline std::size_t UploadedByteCount() const noexcept { return mUploadedByteCount; }
+
 protected:
+	// Instances count from which the bounding volume hierarchy is used for culling.
+	// Below it, a flat SIMD test of all instances is faster.
+	static const std::uint32_t sBvhMinInstanceCount{ 256U };
+
+	// Creates instances buffers (in mGeometryDataVec order).
+	// Instance i uses the material with index materialIndices[i] in MaterialRegistry.
+	// World space data is computed later, from the transforms (see UpdateInstances()).
+	void BuildInstancesBuffers(const std::uint32_t* materialIndices, const std::uint32_t numInstances) noexcept;
+
+	// Registers textures of each instance in TextureRegistry, and a copy of its material
+	// with their indices in MaterialRegistry (instances with the same material and textures
+	// share it). Textures arrays that the recorder does not sample must be nullptr.
+	static void RegisterTexturedMaterials(
+		const std::uint32_t* materialIndices,
+		ID3D12Resource** diffuseTextures,
+		ID3D12Resource** normalTextures,
+		ID3D12Resource** heightTextures,
+		const std::uint32_t numInstances,
+		std::vector<std::uint32_t>& texturedMaterialIndices) noexcept;
+
+	// Updates world matrix and bounding volumes of instances whose transforms changed
+	// (or of all instances), and the bounding volume hierarchy.
+	void UpdateInstances(const bool allInstances) noexcept;
+
+	// Culls instances against the camera frustum (frame cbuffer view and projection) and
+	// the occlusion culler depth buffer, and copies visible instances indices to current frame buffer, grouped by geometry data.
+	void CullInstances(const FrameCBuffer& frameCBuffer) noexcept;
+
+	// Binds geometry data vertex and index buffers, only if they are not the ones
+	// already bound. Meshes sub-allocated in the same GeometryPool arena share them.
+	// Returns the number of bound buffers.
+	static std::uint32_t SetGeometryBuffers(
+		GraphicsCommandList& cmdList,
+		const GeometryData& geomData,
+		D3D12_GPU_VIRTUAL_ADDRESS& boundVertexBuffer,
+		D3D12_GPU_VIRTUAL_ADDRESS& boundIndexBuffer) noexcept;
+
 	ID3D12Device& mDevice;
-		
-	// 1 command allocater per queued frame.
-	ID3D12CommandAllocator* mCmdAlloc[Settings::sQueuedFrameCount]{ nullptr };
-	ID3D12GraphicsCommandList* mCmdList{ nullptr };
+
 	std::uint32_t mCurrFrameIndex{ 0U };
 
+	// Root constant where RecordDraw() sets the first instance of the draw
+	std::uint32_t mInstanceOffsetRootParamIndex{ 0U };
+
 	// Base command data. Once you inherits from this class, you should add
 	// more class members that represent the extra information you need (like resources, for example)
 
@@ -64,19 +173,37 @@ protected:
 	// Frame CBuffer info per queued frame.
 	UploadBuffer* mFrameCBuffer[Settings::sQueuedFrameCount]{ nullptr };
 
-	// Object CBuffer info
-	UploadBuffer* mObjectCBuffer{ nullptr };
-	D3D12_GPU_DESCRIPTOR_HANDLE mObjectCBufferGpuDescHandleBegin;
-
-	// Material CBuffer info
-	D3D12_GPU_DESCRIPTOR_HANDLE mMaterialsCBufferGpuDescHandleBegin;
-	UploadBuffer* mMaterialsCBuffer{ nullptr };
-
-	// Where we push recorded command lists
-	tbb::concurrent_queue<ID3D12CommandList*>* mCmdListQueue;
-
-	// Geometry & depth buffers cpu descriptors
-	const D3D12_CPU_DESCRIPTOR_HANDLE* mGeometryBuffersCpuDescs{ nullptr };
-	std::uint32_t mGeometryBuffersCpuDescCount{ 0U };
-	D3D12_CPU_DESCRIPTOR_HANDLE mDepthBufferCpuDesc{ 0UL };
+	// All instances data structured buffers (InstanceData), and visible instances
+	// indices structured buffer (std::uint32_t) per queued frame.
+	InstanceDataStream mInstanceStream;
+	UploadBuffer* mVisibleInstancesBuffer[Settings::sQueuedFrameCount]{ nullptr };
+	std::size_t mUploadedByteCount{ 0UL };
+
+	// All instances data, in mGeometryDataVec order, and their bounding spheres and boxes.
+	std::vector<InstanceData> mInstances;
+	std::vector<Aabb> mInstanceBoxes;
+	FrustumCuller mFrustumCuller;
+	Bvh mBvh;
+
+	// Scene transforms, updated by the geometry pass before PrepareFrame().
+	const TransformHierarchy* mTransforms{ nullptr };
+
+	// Instances updated by the last UpdateInstances(), and their boxes
+	std::vector<std::uint32_t> mChangedInstanceIndices;
+	std::vector<Aabb> mChangedInstanceBoxes;
+
+	// Occluders are rasterized before recording, by the geometry pass
+	const OcclusionCuller* mOcclusionCuller{ nullptr };
+	std::uint32_t mOccludedInstanceCount{ 0U };
+
+	// Visible instances of the current frame, their count per geometry data, and
+	// the view depth of the nearest visible instance of each geometry data
+	std::vector<std::uint32_t> mVisibleInstanceIndices;
+	std::vector<std::uint32_t> mVisibleInstanceCounts;
+	std::vector<float> mVisibleInstanceMinDepths;
+
+	// Draw packets key fields of each geometry data: index of its vertex and index
+	// buffers in the recorder, and material of its instances (see RenderQueue)
+	std::vector<std::uint32_t> mGeometryBuffersKeys;
+	std::vector<std::uint32_t> mMaterialKeys;
 };
\ No newline at end of file
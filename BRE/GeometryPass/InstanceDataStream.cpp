@@ -0,0 +1,84 @@
+#include "InstanceDataStream.h"
+
+#include <algorithm>
+
+#include <ResourceManager/ResourceManager.h>
+#include <ResourceManager/UploadBuffer.h>
+#include <ShaderUtils/CBuffers.h>
+
+void InstanceDataStream::Init(const std::uint32_t instanceCount) noexcept {
+	ASSERT(ValidateData() == false);
+	ASSERT(instanceCount > 0U);
+
+	mInstanceCount = instanceCount;
+	for (std::uint32_t i = 0U; i < Settings::sQueuedFrameCount; ++i) {
+		ResourceManager::Get().CreateUploadBuffer(sizeof(InstanceData), instanceCount, mBuffers[i]);
+	}
+
+	MarkDirty(0U, instanceCount);
+
+	ASSERT(ValidateData());
+}
+
+void InstanceDataStream::MarkDirty(const std::uint32_t firstInstance, const std::uint32_t instanceCount) noexcept {
+	ASSERT(instanceCount > 0U);
+	ASSERT(firstInstance + instanceCount <= mInstanceCount);
+
+	const Range range{ firstInstance, firstInstance + instanceCount };
+	for (std::vector<Range>& ranges : mDirtyRanges) {
+		if (ranges.empty() == false && ranges.back().mBegin <= range.mBegin && range.mBegin <= ranges.back().mEnd + sMaxCoalescedGap) {
+			ranges.back().mEnd = std::max(ranges.back().mEnd, range.mEnd);
+		}
+		else {
+			ranges.push_back(range);
+		}
+	}
+}
+
+void InstanceDataStream::Upload(const std::uint32_t frameIndex, const InstanceData* instances) noexcept {
+	ASSERT(ValidateData());
+	ASSERT(frameIndex < Settings::sQueuedFrameCount);
+	ASSERT(instances != nullptr);
+
+	mUploadedByteCount = 0UL;
+	mUploadedRangeCount = 0U;
+
+	std::vector<Range>& ranges(mDirtyRanges[frameIndex]);
+	if (ranges.empty()) {
+		return;
+	}
+
+	// Ranges marked out of order can overlap
+	std::sort(ranges.begin(), ranges.end(), [](const Range& a, const Range& b) { return a.mBegin < b.mBegin; });
+
+	UploadBuffer& buffer(*mBuffers[frameIndex]);
+	Range range(ranges.front());
+	const std::size_t rangeCount{ ranges.size() };
+	for (std::size_t i = 1UL; i <= rangeCount; ++i) {
+		if (i < rangeCount && ranges[i].mBegin <= range.mEnd + sMaxCoalescedGap) {
+			range.mEnd = std::max(range.mEnd, ranges[i].mEnd);
+			continue;
+		}
+
+		const std::size_t byteCount{ (range.mEnd - range.mBegin) * sizeof(InstanceData) };
+		buffer.CopyDataStreaming(range.mBegin, instances + range.mBegin, byteCount);
+		mUploadedByteCount += byteCount;
+		++mUploadedRangeCount;
+
+		if (i < rangeCount) {
+			range = ranges[i];
+		}
+	}
+
+	ranges.clear();
+}
+
+bool InstanceDataStream::ValidateData() const noexcept {
+	for (std::uint32_t i = 0U; i < Settings::sQueuedFrameCount; ++i) {
+		if (mBuffers[i] == nullptr) {
+			return false;
+		}
+	}
+
+	return mInstanceCount > 0U;
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <GlobalData/Settings.h>
+#include <Utils/DebugUtils.h>
+
+struct InstanceData;
+class UploadBuffer;
+
+// Streams instances data to an upload buffer per queued frame. Each buffer stores all
+// instances, and only instances modified since it was written are copied to it
+// (a modified instance is copied once to each queued frame buffer, when it is used).
+// Modified instances are tracked as ranges, that are coalesced before they are copied
+// with non-temporal stores (upload heaps are write combined memory).
+// Steps:
+// - Call Init() (all instances are modified)
+// - Call MarkDirty() for modified instances
+// - Call Upload() once per frame, before recording the frame
+class InstanceDataStream {
+public:
+	// Clean instances between modified ones are copied too, if there are
+	// no more than this count, because a copy per range is slower.
+	static const std::uint32_t sMaxCoalescedGap{ 4U };
+
+	InstanceDataStream() = default;
+	~InstanceDataStream() = default;
+	InstanceDataStream(const InstanceDataStream&) = delete;
+	const InstanceDataStream& operator=(const InstanceDataStream&) = delete;
+	InstanceDataStream(InstanceDataStream&&) = default;
+	InstanceDataStream& operator=(InstanceDataStream&&) = default;
+
+	void Init(const std::uint32_t instanceCount) noexcept;
+
+	// It is faster if instances are marked in increasing order (contiguous ones are merged here)
+	void MarkDirty(const std::uint32_t firstInstance, const std::uint32_t instanceCount) noexcept;
+
+	// Copies instances modified since the buffer of frameIndex was written.
+	// instances has InstanceCount() elements.
+	void Upload(const std::uint32_t frameIndex, const InstanceData* instances) noexcept;
+
+	__forceinline UploadBuffer& Buffer(const std::uint32_t frameIndex) const noexcept {
+		ASSERT(frameIndex < Settings::sQueuedFrameCount);
+		ASSERT(mBuffers[frameIndex] != nullptr);
+		return *mBuffers[frameIndex];
+	}
+
+	__forceinline std::uint32_t InstanceCount() const noexcept { return mInstanceCount; }
+
+	// Counters of the last Upload()
+	__forceinline std::size_t UploadedByteCount() const noexcept { return mUploadedByteCount; }
+	__forceinline std::uint32_t UploadedRangeCount() const noexcept { return mUploadedRangeCount; }
+
+	bool ValidateData() const noexcept;
+
+private:
+	struct Range {
+		std::uint32_t mBegin;
+		std::uint32_t mEnd;
+	};
+
+	UploadBuffer* mBuffers[Settings::sQueuedFrameCount]{ nullptr };
+
+	// Ranges modified since each buffer was written
+	std::vector<Range> mDirtyRanges[Settings::sQueuedFrameCount];
+
+	std::uint32_t mInstanceCount{ 0U };
+	std::size_t mUploadedByteCount{ 0UL };
+	std::uint32_t mUploadedRangeCount{ 0U };
+};
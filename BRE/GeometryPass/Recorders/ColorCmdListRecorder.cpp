@@ -2,8 +2,7 @@
 
 #include <DirectXMath.h>
 
-#include <DescriptorManager\DescriptorManager.h>
-#include <Material/Material.h>
+#include <Material/MaterialRegistry.h>
 #include <MathUtils/MathUtils.h>
 #include <PSOCreator/PSOCreator.h>
 #include <ResourceManager/ResourceManager.h>
@@ -12,10 +11,12 @@
 #include <Utils/DebugUtils.h>
 
 // Root signature:
-// "DescriptorTable(CBV(b0), visibility = SHADER_VISIBILITY_VERTEX), " \ 0 -> Object CBuffers
+// "SRV(t0, visibility = SHADER_VISIBILITY_VERTEX), " \ 0 -> Instances Data
 // "CBV(b1, visibility = SHADER_VISIBILITY_VERTEX), " \ 1 -> Frame CBuffer
-// "DescriptorTable(CBV(b0), visibility = SHADER_VISIBILITY_PIXEL), " \ 2 -> Material CBuffers
+// "SRV(t0, visibility = SHADER_VISIBILITY_PIXEL), " \ 2 -> Materials
 // "CBV(b1, visibility = SHADER_VISIBILITY_PIXEL), " \ 3 -> Frame CBuffer
+// "RootConstants(num32BitConstants = 1, b0, visibility = SHADER_VISIBILITY_VERTEX), " \ 4 -> Instance Offset
+// "SRV(t1, visibility = SHADER_VISIBILITY_VERTEX), " \ 5 -> Visible Instances
 
 namespace {
 	ID3D12PipelineState* sPSO{ nullptr };
@@ -23,7 +24,7 @@ namespace {
 }
 
 ColorCmdListRecorder::ColorCmdListRecorder(ID3D12Device& device)
-	: GeometryPassCmdListRecorder(device)
+	: GeometryPassCmdListRecorder(device, 4U)
 {
 }
 
@@ -50,161 +51,74 @@ void ColorCmdListRecorder::InitPSO(const DXGI_FORMAT* geometryBufferFormats, con
 void ColorCmdListRecorder::Init(
 	const GeometryData* geometryDataVec,
 	const std::uint32_t numGeomData,
-	const Material* materials,
-	const std::uint32_t numMaterials) noexcept
+	const std::uint32_t* materialIndices,
+	const std::uint32_t numInstances) noexcept
 {
 	ASSERT(ValidateData() == false);
 	ASSERT(geometryDataVec != nullptr);
 	ASSERT(numGeomData != 0U);
-	ASSERT(materials != nullptr);
-	ASSERT(numMaterials > 0UL);
+	ASSERT(materialIndices != nullptr);
+	ASSERT(numInstances > 0UL);
 
-	// Check that the total number of matrices (geometry to be drawn) will be equal to available materials
+	// Check that the total number of matrices (geometry to be drawn) will be equal to materials indices
 #ifdef _DEBUG
 	std::size_t totalNumMatrices{ 0UL };
 	for (std::size_t i = 0UL; i < numGeomData; ++i) {
-		const std::size_t numMatrices{ geometryDataVec[i].mWorldMatrices.size() };
+		const std::size_t numMatrices{ geometryDataVec[i].mTransformHandles.size() };
 		totalNumMatrices += numMatrices;
 		ASSERT(numMatrices != 0UL);
 	}
-	ASSERT(totalNumMatrices == numMaterials);
+	ASSERT(totalNumMatrices == numInstances);
 #endif
 	mGeometryDataVec.reserve(numGeomData);
 	for (std::uint32_t i = 0U; i < numGeomData; ++i) {
 		mGeometryDataVec.push_back(geometryDataVec[i]);
 	}
 
-	BuildBuffers(materials, numMaterials);
+	BuildBuffers(materialIndices, numInstances);
 
 	ASSERT(ValidateData());
 }
 
-void ColorCmdListRecorder::RecordAndPushCommandLists(const FrameCBuffer& frameCBuffer) noexcept {
-	ASSERT(ValidateData());
+ID3D12PipelineState& ColorCmdListRecorder::PipelineState() const noexcept {
+	ASSERT(sPSO != nullptr);
+	return *sPSO;
+}
+
+void ColorCmdListRecorder::SetPipeline(GraphicsCommandList& cmdList) const noexcept {
 	ASSERT(sPSO != nullptr);
 	ASSERT(sRootSign != nullptr);
-	ASSERT(mCmdListQueue != nullptr);
-	ASSERT(mGeometryBuffersCpuDescs != nullptr);
-	ASSERT(mGeometryBuffersCpuDescCount != 0U);
-	ASSERT(mDepthBufferCpuDesc.ptr != 0U);
-
-	ID3D12CommandAllocator* cmdAlloc{ mCmdAlloc[mCurrFrameIndex] };
-	ASSERT(cmdAlloc != nullptr);	
-	
-	// Update frame constants
-	UploadBuffer& uploadFrameCBuffer(*mFrameCBuffer[mCurrFrameIndex]);
-	uploadFrameCBuffer.CopyData(0U, &frameCBuffer, sizeof(frameCBuffer));
-
-	CHECK_HR(cmdAlloc->Reset());
-	CHECK_HR(mCmdList->Reset(cmdAlloc, sPSO));
-
-	mCmdList->RSSetViewports(1U, &Settings::sScreenViewport);
-	mCmdList->RSSetScissorRects(1U, &Settings::sScissorRect);
-	mCmdList->OMSetRenderTargets(mGeometryBuffersCpuDescCount, mGeometryBuffersCpuDescs, false, &mDepthBufferCpuDesc);
-
-	ID3D12DescriptorHeap* heaps[] = { &DescriptorManager::Get().GetCbvSrcUavDescriptorHeap() };
-	mCmdList->SetDescriptorHeaps(_countof(heaps), heaps);
-	mCmdList->SetGraphicsRootSignature(sRootSign);
-
-	const std::size_t descHandleIncSize{ mDevice.GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV) };
-	D3D12_GPU_DESCRIPTOR_HANDLE objectCBufferGpuDescHandle(mObjectCBufferGpuDescHandleBegin);
-	D3D12_GPU_DESCRIPTOR_HANDLE materialsCBufferGpuDescHandle(mMaterialsCBufferGpuDescHandleBegin);
-		
-	mCmdList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 
-	// Set frame constants root parameters
-	D3D12_GPU_VIRTUAL_ADDRESS frameCBufferGpuVAddress(uploadFrameCBuffer.Resource()->GetGPUVirtualAddress());
-	mCmdList->SetGraphicsRootConstantBufferView(1U, frameCBufferGpuVAddress);
-	mCmdList->SetGraphicsRootConstantBufferView(3U, frameCBufferGpuVAddress);
-	
-	// Draw objects
-	const std::size_t geomCount{ mGeometryDataVec.size() };
-	for (std::size_t i = 0UL; i < geomCount; ++i) {
-		GeometryData& geomData{ mGeometryDataVec[i] };
-		mCmdList->IASetVertexBuffers(0U, 1U, &geomData.mVertexBufferData.mBufferView);
-		mCmdList->IASetIndexBuffer(&geomData.mIndexBufferData.mBufferView);
-		const std::size_t worldMatsCount{ geomData.mWorldMatrices.size() };
-		for (std::size_t j = 0UL; j < worldMatsCount; ++j) {
-			mCmdList->SetGraphicsRootDescriptorTable(0U, objectCBufferGpuDescHandle);
-			objectCBufferGpuDescHandle.ptr += descHandleIncSize;
-
-			mCmdList->SetGraphicsRootDescriptorTable(2U, materialsCBufferGpuDescHandle);
-			materialsCBufferGpuDescHandle.ptr += descHandleIncSize;
-
-			mCmdList->DrawIndexedInstanced(geomData.mIndexBufferData.mCount, 1U, 0U, 0U, 0U);
-		}
-	}
-	
-	mCmdList->Close();
+	cmdList.SetPipelineState(sPSO);
+	cmdList.SetGraphicsRootSignature(sRootSign);
+	cmdList.IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+}
 
-	mCmdListQueue->push(mCmdList);
+void ColorCmdListRecorder::SetRootParameters(GraphicsCommandList& cmdList) const noexcept {
+	ASSERT(ValidateData());
 
-	// Next frame
-	mCurrFrameIndex = (mCurrFrameIndex + 1) % Settings::sQueuedFrameCount;
+	// Set frame constants root parameters
+	const D3D12_GPU_VIRTUAL_ADDRESS frameCBufferGpuVAddress(mFrameCBuffer[mCurrFrameIndex]->Resource()->GetGPUVirtualAddress());
+	cmdList.SetGraphicsRootConstantBufferView(1U, frameCBufferGpuVAddress);
+	cmdList.SetGraphicsRootConstantBufferView(3U, frameCBufferGpuVAddress);
+
+	// Set instances and materials root parameters
+	cmdList.SetGraphicsRootShaderResourceView(0U, mInstanceStream.Buffer(mCurrFrameIndex).Resource()->GetGPUVirtualAddress());
+	cmdList.SetGraphicsRootShaderResourceView(5U, mVisibleInstancesBuffer[mCurrFrameIndex]->Resource()->GetGPUVirtualAddress());
+	cmdList.SetGraphicsRootShaderResourceView(2U, MaterialRegistry::Get().Buffer().Resource()->GetGPUVirtualAddress());
 }
 
-void ColorCmdListRecorder::BuildBuffers(const Material* materials, const std::uint32_t numMaterials) noexcept {
-	ASSERT(materials != nullptr);
-	ASSERT(numMaterials != 0UL);
+void ColorCmdListRecorder::BuildBuffers(const std::uint32_t* materialIndices, const std::uint32_t numInstances) noexcept {
+	ASSERT(materialIndices != nullptr);
+	ASSERT(numInstances != 0UL);
 
 #ifdef _DEBUG
 	for (std::uint32_t i = 0U; i < Settings::sQueuedFrameCount; ++i) {
 		ASSERT(mFrameCBuffer[i] == nullptr);
 	}
 #endif
-	ASSERT(mObjectCBuffer == nullptr);
-	ASSERT(mMaterialsCBuffer == nullptr);
-
-	// Create object cbuffer and fill it
-	const std::size_t objCBufferElemSize{ UploadBuffer::CalcConstantBufferByteSize(sizeof(ObjectCBuffer)) };
-	ResourceManager::Get().CreateUploadBuffer(objCBufferElemSize, numMaterials, mObjectCBuffer);
-	std::uint32_t k = 0U;
-	const std::size_t numGeomData{ mGeometryDataVec.size() };
-	ObjectCBuffer objCBuffer;
-	for (std::size_t i = 0UL; i < numGeomData; ++i) {
-		GeometryData& geomData{ mGeometryDataVec[i] };
-		const std::uint32_t worldMatsCount{ static_cast<std::uint32_t>(geomData.mWorldMatrices.size()) };
-		for (std::uint32_t j = 0UL; j < worldMatsCount; ++j) {
-			const DirectX::XMMATRIX wMatrix = DirectX::XMMatrixTranspose(DirectX::XMLoadFloat4x4(&geomData.mWorldMatrices[j]));
-			DirectX::XMStoreFloat4x4(&objCBuffer.mWorld, wMatrix);
-			mObjectCBuffer->CopyData(k + j, &objCBuffer, sizeof(objCBuffer));
-		}
-
-		k += worldMatsCount;
-	}
 
-	// Create materials cbuffer		
-	const std::size_t matCBufferElemSize{ UploadBuffer::CalcConstantBufferByteSize(sizeof(Material)) };
-	ResourceManager::Get().CreateUploadBuffer(matCBufferElemSize, numMaterials, mMaterialsCBuffer);
-
-	D3D12_GPU_VIRTUAL_ADDRESS materialsGpuAddress{ mMaterialsCBuffer->Resource()->GetGPUVirtualAddress() };
-	D3D12_GPU_VIRTUAL_ADDRESS objCBufferGpuAddress{ mObjectCBuffer->Resource()->GetGPUVirtualAddress() };
-
-	// Create object / materials cbuffers descriptors
-	// Create textures SRV descriptors
-	std::vector<D3D12_CONSTANT_BUFFER_VIEW_DESC> objectCbufferViewDescVec;
-	objectCbufferViewDescVec.reserve(numMaterials);
-
-	std::vector<D3D12_CONSTANT_BUFFER_VIEW_DESC> materialCbufferViewDescVec;
-	materialCbufferViewDescVec.reserve(numMaterials);
-	for (std::size_t i = 0UL; i < numMaterials; ++i) {
-		// Object cbuffer desc
-		D3D12_CONSTANT_BUFFER_VIEW_DESC cBufferDesc{};
-		cBufferDesc.BufferLocation = objCBufferGpuAddress + i * objCBufferElemSize;
-		cBufferDesc.SizeInBytes = static_cast<std::uint32_t>(objCBufferElemSize);
-		objectCbufferViewDescVec.push_back(cBufferDesc);
-
-		// Material cbuffer desc
-		cBufferDesc.BufferLocation = materialsGpuAddress + i * matCBufferElemSize;
-		cBufferDesc.SizeInBytes = static_cast<std::uint32_t>(matCBufferElemSize);
-		materialCbufferViewDescVec.push_back(cBufferDesc);
-
-		mMaterialsCBuffer->CopyData(static_cast<std::uint32_t>(i), &materials[i], sizeof(Material));
-	}
-	mObjectCBufferGpuDescHandleBegin =
-		DescriptorManager::Get().CreateConstantBufferViews(objectCbufferViewDescVec.data(), static_cast<std::uint32_t>(objectCbufferViewDescVec.size()));
-	mMaterialsCBufferGpuDescHandleBegin =
-		DescriptorManager::Get().CreateConstantBufferViews(materialCbufferViewDescVec.data(), static_cast<std::uint32_t>(materialCbufferViewDescVec.size()));
+	BuildInstancesBuffers(materialIndices, numInstances);
 
 	// Create frame cbuffers
 	const std::size_t frameCBufferElemSize{ UploadBuffer::CalcConstantBufferByteSize(sizeof(FrameCBuffer)) };
@@ -2,8 +2,6 @@
 
 #include <GeometryPass/GeometryPassCmdListRecorder.h>
 
-struct Material;
-
 // Recorder that does color mapping
 class ColorCmdListRecorder : public GeometryPassCmdListRecorder {
 public:
@@ -20,15 +18,18 @@ public:
 	// This method is initialized by its corresponding pass.
 	static void InitPSO(const DXGI_FORMAT* geometryBufferFormats, const std::uint32_t geometryBufferCount) noexcept;
 
-	// This method must be called before calling RecordAndPushCommandLists()
+	// This method must be called before calling PrepareFrame().
+	// materialIndices are MaterialRegistry indices (one per instance).
 	void Init(
 		const GeometryData* geometryDataVec,
 		const std::uint32_t numGeomData,
-		const Material* materials,
-		const std::uint32_t numMaterials) noexcept;
+		const std::uint32_t* materialIndices,
+		const std::uint32_t numInstances) noexcept;
 
-	void RecordAndPushCommandLists(const FrameCBuffer& frameCBuffer) noexcept final override;
+	ID3D12PipelineState& PipelineState() const noexcept final override;
+	void SetPipeline(GraphicsCommandList& cmdList) const noexcept final override;
+	void SetRootParameters(GraphicsCommandList& cmdList) const noexcept final override;
 
 private:
-	void BuildBuffers(const Material* materials, const std::uint32_t numMaterials) noexcept;
+	void BuildBuffers(const std::uint32_t* materialIndices, const std::uint32_t numInstances) noexcept;
 };
\ No newline at end of file
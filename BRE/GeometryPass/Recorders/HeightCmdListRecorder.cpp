@@ -2,8 +2,8 @@
 
 #include <DirectXMath.h>
 
-#include <DescriptorManager\DescriptorManager.h>
-#include <Material/Material.h>
+#include <DescriptorManager/TextureRegistry.h>
+#include <Material/MaterialRegistry.h>
 #include <MathUtils/MathUtils.h>
 #include <PSOCreator/PSOCreator.h>
 #include <ResourceManager/ResourceManager.h>
@@ -12,14 +12,16 @@
 #include <Utils/DebugUtils.h>
 
 // Root signature:
-// "DescriptorTable(CBV(b0), visibility = SHADER_VISIBILITY_VERTEX), " \ 0 -> Object CBuffers
+// "SRV(t0, visibility = SHADER_VISIBILITY_VERTEX), " \ 0 -> Instances Data
 // "CBV(b1, visibility = SHADER_VISIBILITY_VERTEX), " \ 1 -> Frame CBuffer
 // "CBV(b0, visibility = SHADER_VISIBILITY_DOMAIN), " \ 2 -> Frame CBuffer
-// "DescriptorTable(SRV(t0), visibility = SHADER_VISIBILITY_DOMAIN), " \ 3 -> Height Texture
-// "DescriptorTable(CBV(b0), visibility = SHADER_VISIBILITY_PIXEL), " \ 4 -> Material CBuffers
+// "DescriptorTable(SRV(t0, space = 1, numDescriptors = unbounded), visibility = SHADER_VISIBILITY_DOMAIN), " \ 3 -> Textures
+// "SRV(t0, visibility = SHADER_VISIBILITY_PIXEL), " \ 4 -> Materials
 // "CBV(b1, visibility = SHADER_VISIBILITY_PIXEL), " \ 5 -> Frame CBuffer
-// "DescriptorTable(SRV(t0), visibility = SHADER_VISIBILITY_PIXEL), " \ 6 -> Diffuse Texture
-// "DescriptorTable(SRV(t1), visibility = SHADER_VISIBILITY_PIXEL), " \ 7 -> Normal Texture
+// "DescriptorTable(SRV(t0, space = 1, numDescriptors = unbounded), visibility = SHADER_VISIBILITY_PIXEL), " \ 6 -> Textures
+// "RootConstants(num32BitConstants = 1, b0, visibility = SHADER_VISIBILITY_VERTEX), " \ 7 -> Instance Offset
+// "SRV(t1, visibility = SHADER_VISIBILITY_VERTEX), " \ 8 -> Visible Instances
+// "SRV(t0, visibility = SHADER_VISIBILITY_DOMAIN), " \ 9 -> Materials
 
 namespace {
 	ID3D12PipelineState* sPSO{ nullptr };
@@ -27,7 +29,7 @@ namespace {
 }
 
 HeightCmdListRecorder::HeightCmdListRecorder(ID3D12Device& device)
-	: GeometryPassCmdListRecorder(device)
+	: GeometryPassCmdListRecorder(device, 7U)
 {
 }
 
@@ -57,7 +59,7 @@ void HeightCmdListRecorder::InitPSO(const DXGI_FORMAT* geometryBufferFormats, co
 void HeightCmdListRecorder::Init(
 	const GeometryData* geometryDataVec,
 	const std::uint32_t numGeomData,
-	const Material* materials,
+	const std::uint32_t* materialIndices,
 	ID3D12Resource** textures,
 	ID3D12Resource** normals,
 	ID3D12Resource** heights,
@@ -66,17 +68,17 @@ void HeightCmdListRecorder::Init(
 	ASSERT(ValidateData() == false);
 	ASSERT(geometryDataVec != nullptr);
 	ASSERT(numGeomData != 0U);
-	ASSERT(materials != nullptr);
+	ASSERT(materialIndices != nullptr);
 	ASSERT(numResources > 0UL);
 	ASSERT(textures != nullptr);
 	ASSERT(normals != nullptr);
 	ASSERT(heights != nullptr);
 
-	// Check that the total number of matrices (geometry to be drawn) will be equal to available materials
+	// Check that the total number of matrices (geometry to be drawn) will be equal to materials indices
 #ifdef _DEBUG
 	std::size_t totalNumMatrices{ 0UL };
 	for (std::size_t i = 0UL; i < numGeomData; ++i) {
-		const std::size_t numMatrices{ geometryDataVec[i].mWorldMatrices.size() };
+		const std::size_t numMatrices{ geometryDataVec[i].mTransformHandles.size() };
 		totalNumMatrices += numMatrices;
 		ASSERT(numMatrices != 0UL);
 	}
@@ -87,106 +89,53 @@ void HeightCmdListRecorder::Init(
 		mGeometryDataVec.push_back(geometryDataVec[i]);
 	}
 
-	BuildBuffers(materials, textures, normals, heights, numResources);
+	BuildBuffers(materialIndices, textures, normals, heights, numResources);
 
 	ASSERT(ValidateData());
 }
 
-void HeightCmdListRecorder::RecordAndPushCommandLists(const FrameCBuffer& frameCBuffer) noexcept {
-	ASSERT(ValidateData());
+ID3D12PipelineState& HeightCmdListRecorder::PipelineState() const noexcept {
 	ASSERT(sPSO != nullptr);
-	ASSERT(sRootSign != nullptr);
-	ASSERT(mCmdListQueue != nullptr);
-	ASSERT(mGeometryBuffersCpuDescs != nullptr);
-	ASSERT(mGeometryBuffersCpuDescCount != 0U);
-	ASSERT(mDepthBufferCpuDesc.ptr != 0U);
-
-	ID3D12CommandAllocator* cmdAlloc{ mCmdAlloc[mCurrFrameIndex] };
-	ASSERT(cmdAlloc != nullptr);
-
-	// Update frame constants
-	UploadBuffer& uploadFrameCBuffer(*mFrameCBuffer[mCurrFrameIndex]);
-	uploadFrameCBuffer.CopyData(0U, &frameCBuffer, sizeof(frameCBuffer));
-
-	CHECK_HR(cmdAlloc->Reset());
-	CHECK_HR(mCmdList->Reset(cmdAlloc, sPSO));
-
-	mCmdList->RSSetViewports(1U, &Settings::sScreenViewport);
-	mCmdList->RSSetScissorRects(1U, &Settings::sScissorRect);
-	mCmdList->OMSetRenderTargets(mGeometryBuffersCpuDescCount, mGeometryBuffersCpuDescs, false, &mDepthBufferCpuDesc);
-
-	ID3D12DescriptorHeap* heaps[] = { &DescriptorManager::Get().GetCbvSrcUavDescriptorHeap() };
-	mCmdList->SetDescriptorHeaps(_countof(heaps), heaps);
-	mCmdList->SetGraphicsRootSignature(sRootSign);
-
-	const std::size_t descHandleIncSize{ mDevice.GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV) };
-	D3D12_GPU_DESCRIPTOR_HANDLE objectCBufferGpuDescHandle(mObjectCBufferGpuDescHandleBegin);
-	D3D12_GPU_DESCRIPTOR_HANDLE materialsCBufferGpuDescHandle(mMaterialsCBufferGpuDescHandleBegin);
-	D3D12_GPU_DESCRIPTOR_HANDLE texturesBufferGpuDescHandle(mTexturesBufferGpuDescHandleBegin);
-	D3D12_GPU_DESCRIPTOR_HANDLE normalsBufferGpuDescHandle(mNormalsBufferGpuDescHandleBegin);
-	D3D12_GPU_DESCRIPTOR_HANDLE heightsBufferGpuDescHandle(mHeightsBufferGpuDescHandleBegin);
-
-	mCmdList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_3_CONTROL_POINT_PATCHLIST);
-
-	// Set frame constants root parameters
-	D3D12_GPU_VIRTUAL_ADDRESS frameCBufferGpuVAddress(uploadFrameCBuffer.Resource()->GetGPUVirtualAddress());
-	mCmdList->SetGraphicsRootConstantBufferView(1U, frameCBufferGpuVAddress);
-	mCmdList->SetGraphicsRootConstantBufferView(2U, frameCBufferGpuVAddress);
-	mCmdList->SetGraphicsRootConstantBufferView(5U, frameCBufferGpuVAddress);
-	
-	// Draw objects
-	const std::size_t geomCount{ mGeometryDataVec.size() };
-	for (std::size_t i = 0UL; i < geomCount; ++i) {
-		GeometryData& geomData{ mGeometryDataVec[i] };
-		mCmdList->IASetVertexBuffers(0U, 1U, &geomData.mVertexBufferData.mBufferView);
-		mCmdList->IASetIndexBuffer(&geomData.mIndexBufferData.mBufferView);
-		const std::size_t worldMatsCount{ geomData.mWorldMatrices.size() };
-		for (std::size_t j = 0UL; j < worldMatsCount; ++j) {
-			mCmdList->SetGraphicsRootDescriptorTable(0U, objectCBufferGpuDescHandle);
-			objectCBufferGpuDescHandle.ptr += descHandleIncSize;
-
-			mCmdList->SetGraphicsRootDescriptorTable(3U, heightsBufferGpuDescHandle);
-			heightsBufferGpuDescHandle.ptr += descHandleIncSize;
-
-			mCmdList->SetGraphicsRootDescriptorTable(4U, materialsCBufferGpuDescHandle);
-			materialsCBufferGpuDescHandle.ptr += descHandleIncSize;
-
-			mCmdList->SetGraphicsRootDescriptorTable(6U, texturesBufferGpuDescHandle);
-			texturesBufferGpuDescHandle.ptr += descHandleIncSize;
-
-			mCmdList->SetGraphicsRootDescriptorTable(7U, normalsBufferGpuDescHandle);
-			normalsBufferGpuDescHandle.ptr += descHandleIncSize;
-			
-			mCmdList->DrawIndexedInstanced(geomData.mIndexBufferData.mCount, 1U, 0U, 0U, 0U);
-		}
-	}
-
-	mCmdList->Close();
+	return *sPSO;
+}
 
-	mCmdListQueue->push(mCmdList);
+void HeightCmdListRecorder::SetPipeline(GraphicsCommandList& cmdList) const noexcept {
+	ASSERT(sPSO != nullptr);
+	ASSERT(sRootSign != nullptr);
 
-	// Next frame
-	mCurrFrameIndex = (mCurrFrameIndex + 1) % Settings::sQueuedFrameCount;
+	cmdList.SetPipelineState(sPSO);
+	cmdList.SetGraphicsRootSignature(sRootSign);
+	cmdList.IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_3_CONTROL_POINT_PATCHLIST);
 }
 
-bool HeightCmdListRecorder::ValidateData() const noexcept {
-	const bool result =
-		GeometryPassCmdListRecorder::ValidateData() &&
-		mTexturesBufferGpuDescHandleBegin.ptr != 0UL &&
-		mNormalsBufferGpuDescHandleBegin.ptr != 0UL &&
-		mHeightsBufferGpuDescHandleBegin.ptr != 0UL;
+void HeightCmdListRecorder::SetRootParameters(GraphicsCommandList& cmdList) const noexcept {
+	ASSERT(ValidateData());
 
-	return result;
+	// Set frame constants root parameters
+	const D3D12_GPU_VIRTUAL_ADDRESS frameCBufferGpuVAddress(mFrameCBuffer[mCurrFrameIndex]->Resource()->GetGPUVirtualAddress());
+	cmdList.SetGraphicsRootConstantBufferView(1U, frameCBufferGpuVAddress);
+	cmdList.SetGraphicsRootConstantBufferView(2U, frameCBufferGpuVAddress);
+	cmdList.SetGraphicsRootConstantBufferView(5U, frameCBufferGpuVAddress);
+
+	// Set instances, materials and textures root parameters. Textures tables are the bindless
+	// textures range, and shaders index them with the instance material textures indices.
+	cmdList.SetGraphicsRootShaderResourceView(0U, mInstanceStream.Buffer(mCurrFrameIndex).Resource()->GetGPUVirtualAddress());
+	cmdList.SetGraphicsRootShaderResourceView(8U, mVisibleInstancesBuffer[mCurrFrameIndex]->Resource()->GetGPUVirtualAddress());
+	const D3D12_GPU_VIRTUAL_ADDRESS materialsGpuVAddress(MaterialRegistry::Get().Buffer().Resource()->GetGPUVirtualAddress());
+	cmdList.SetGraphicsRootShaderResourceView(4U, materialsGpuVAddress);
+	cmdList.SetGraphicsRootShaderResourceView(9U, materialsGpuVAddress);
+	cmdList.SetGraphicsRootDescriptorTable(3U, TextureRegistry::Get().TableBegin().ptr);
+	cmdList.SetGraphicsRootDescriptorTable(6U, TextureRegistry::Get().TableBegin().ptr);
 }
 
 void HeightCmdListRecorder::BuildBuffers(
-	const Material* materials,
+	const std::uint32_t* materialIndices,
 	ID3D12Resource** textures,
 	ID3D12Resource** normals,
 	ID3D12Resource** heights,
 	const std::uint32_t dataCount) noexcept {
 
-	ASSERT(materials != nullptr);
+	ASSERT(materialIndices != nullptr);
 	ASSERT(textures != nullptr);
 	ASSERT(normals != nullptr);
 	ASSERT(heights != nullptr);
@@ -197,116 +146,11 @@ void HeightCmdListRecorder::BuildBuffers(
 		ASSERT(mFrameCBuffer[i] == nullptr);
 	}
 #endif
-	ASSERT(mObjectCBuffer == nullptr);
-	ASSERT(mMaterialsCBuffer == nullptr);
-
-	// Create object cbuffer and fill it
-	const std::size_t objCBufferElemSize{ UploadBuffer::CalcConstantBufferByteSize(sizeof(ObjectCBuffer)) };
-	ResourceManager::Get().CreateUploadBuffer(objCBufferElemSize, dataCount, mObjectCBuffer);
-	std::uint32_t k = 0U;
-	const std::size_t numGeomData{ mGeometryDataVec.size() };
-	ObjectCBuffer objCBuffer;
-	for (std::size_t i = 0UL; i < numGeomData; ++i) {
-		GeometryData& geomData{ mGeometryDataVec[i] };
-		const std::uint32_t worldMatsCount{ static_cast<std::uint32_t>(geomData.mWorldMatrices.size()) };
-		for (std::uint32_t j = 0UL; j < worldMatsCount; ++j) {
-			const DirectX::XMMATRIX wMatrix = DirectX::XMMatrixTranspose(DirectX::XMLoadFloat4x4(&geomData.mWorldMatrices[j]));
-			DirectX::XMStoreFloat4x4(&objCBuffer.mWorld, wMatrix);
-			mObjectCBuffer->CopyData(k + j, &objCBuffer, sizeof(objCBuffer));
-		}
-
-		k += worldMatsCount;
-	}
-
-	// Create materials cbuffer		
-	const std::size_t matCBufferElemSize{ UploadBuffer::CalcConstantBufferByteSize(sizeof(Material)) };
-	ResourceManager::Get().CreateUploadBuffer(matCBufferElemSize, dataCount, mMaterialsCBuffer);
-
-	D3D12_GPU_VIRTUAL_ADDRESS materialsGpuAddress{ mMaterialsCBuffer->Resource()->GetGPUVirtualAddress() };
-	D3D12_GPU_VIRTUAL_ADDRESS objCBufferGpuAddress{ mObjectCBuffer->Resource()->GetGPUVirtualAddress() };
-
-	// Create object / materials cbuffers descriptors
-	// Create textures SRV descriptors
-	std::vector<D3D12_CONSTANT_BUFFER_VIEW_DESC> objectCbufferViewDescVec;
-	objectCbufferViewDescVec.reserve(dataCount);
-
-	std::vector<D3D12_CONSTANT_BUFFER_VIEW_DESC> materialCbufferViewDescVec;
-	materialCbufferViewDescVec.reserve(dataCount);
-
-	std::vector<ID3D12Resource*> textureResVec;
-	textureResVec.reserve(dataCount);
-	std::vector<D3D12_SHADER_RESOURCE_VIEW_DESC> textureSrvDescVec;
-	textureSrvDescVec.reserve(dataCount);
 
-	std::vector<ID3D12Resource*> normalResVec;
-	normalResVec.reserve(dataCount);
-	std::vector<D3D12_SHADER_RESOURCE_VIEW_DESC> normalSrvDescVec;
-	normalSrvDescVec.reserve(dataCount);
-
-	std::vector<ID3D12Resource*> heightResVec;
-	heightResVec.reserve(dataCount);
-	std::vector<D3D12_SHADER_RESOURCE_VIEW_DESC> heightSrvDescVec;
-	heightSrvDescVec.reserve(dataCount);
-	for (std::size_t i = 0UL; i < dataCount; ++i) {
-		// Object cbuffer desc
-		D3D12_CONSTANT_BUFFER_VIEW_DESC cBufferDesc{};
-		cBufferDesc.BufferLocation = objCBufferGpuAddress + i * objCBufferElemSize;
-		cBufferDesc.SizeInBytes = static_cast<std::uint32_t>(objCBufferElemSize);
-		objectCbufferViewDescVec.push_back(cBufferDesc);
-
-		// Material cbuffer desc
-		cBufferDesc.BufferLocation = materialsGpuAddress + i * matCBufferElemSize;
-		cBufferDesc.SizeInBytes = static_cast<std::uint32_t>(matCBufferElemSize);
-		materialCbufferViewDescVec.push_back(cBufferDesc);
-
-		// Texture descriptor
-		textureResVec.push_back(textures[i]);
-
-		D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc{};
-		srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
-		srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
-		srvDesc.Texture2D.MostDetailedMip = 0;
-		srvDesc.Texture2D.ResourceMinLODClamp = 0.0f;
-		srvDesc.Format = textureResVec.back()->GetDesc().Format;
-		srvDesc.Texture2D.MipLevels = textureResVec.back()->GetDesc().MipLevels;
-		textureSrvDescVec.push_back(srvDesc);
-
-		// Normal descriptor
-		normalResVec.push_back(normals[i]);
-
-		srvDesc = D3D12_SHADER_RESOURCE_VIEW_DESC{};
-		srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
-		srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
-		srvDesc.Texture2D.MostDetailedMip = 0;
-		srvDesc.Texture2D.ResourceMinLODClamp = 0.0f;
-		srvDesc.Format = normalResVec.back()->GetDesc().Format;
-		srvDesc.Texture2D.MipLevels = normalResVec.back()->GetDesc().MipLevels;
-		normalSrvDescVec.push_back(srvDesc);
-
-		// Height descriptor
-		heightResVec.push_back(heights[i]);
-
-		srvDesc = D3D12_SHADER_RESOURCE_VIEW_DESC{};
-		srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
-		srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
-		srvDesc.Texture2D.MostDetailedMip = 0;
-		srvDesc.Texture2D.ResourceMinLODClamp = 0.0f;
-		srvDesc.Format = heightResVec.back()->GetDesc().Format;
-		srvDesc.Texture2D.MipLevels = heightResVec.back()->GetDesc().MipLevels;
-		heightSrvDescVec.push_back(srvDesc);
-
-		mMaterialsCBuffer->CopyData(static_cast<std::uint32_t>(i), &materials[i], sizeof(Material));
-	}
-	mObjectCBufferGpuDescHandleBegin =
-		DescriptorManager::Get().CreateConstantBufferViews(objectCbufferViewDescVec.data(), static_cast<std::uint32_t>(objectCbufferViewDescVec.size()));
-	mMaterialsCBufferGpuDescHandleBegin =
-		DescriptorManager::Get().CreateConstantBufferViews(materialCbufferViewDescVec.data(), static_cast<std::uint32_t>(materialCbufferViewDescVec.size()));
-	mTexturesBufferGpuDescHandleBegin =
-		DescriptorManager::Get().CreateShaderResourceView(textureResVec.data(), textureSrvDescVec.data(), static_cast<std::uint32_t>(textureSrvDescVec.size()));
-	mNormalsBufferGpuDescHandleBegin =
-		DescriptorManager::Get().CreateShaderResourceView(normalResVec.data(), normalSrvDescVec.data(), static_cast<std::uint32_t>(normalSrvDescVec.size()));
-	mHeightsBufferGpuDescHandleBegin =
-		DescriptorManager::Get().CreateShaderResourceView(heightResVec.data(), heightSrvDescVec.data(), static_cast<std::uint32_t>(heightSrvDescVec.size()));
+	// Instances use copies of their materials with the indices of their textures
+	std::vector<std::uint32_t> texturedMaterialIndices;
+	RegisterTexturedMaterials(materialIndices, textures, normals, heights, dataCount, texturedMaterialIndices);
+	BuildInstancesBuffers(texturedMaterialIndices.data(), dataCount);
 
 	// Create frame cbuffers
 	const std::size_t frameCBufferElemSize{ UploadBuffer::CalcConstantBufferByteSize(sizeof(FrameCBuffer)) };
@@ -2,8 +2,6 @@
 
 #include <GeometryPass/GeometryPassCmdListRecorder.h>
 
-struct Material;
-
 // Recorder that does texture mapping + normal mapping
 class NormalCmdListRecorder : public GeometryPassCmdListRecorder {
 public:
@@ -20,26 +18,24 @@ public:
 	// This method is initialized by its corresponding pass.
 	static void InitPSO(const DXGI_FORMAT* geometryBufferFormats, const std::uint32_t geometryBufferCount) noexcept;
 
-	// This method must be called before calling RecordAndPushCommandLists()
+	// This method must be called before calling PrepareFrame().
+	// materialIndices are MaterialRegistry indices (one per instance).
 	void Init(
 		const GeometryData* geometryDataVec,
 		const std::uint32_t numGeomData,
-		const Material* materials,
+		const std::uint32_t* materialIndices,
 		ID3D12Resource** textures,
 		ID3D12Resource** normals,
 		const std::uint32_t numResources) noexcept;
 
-	void RecordAndPushCommandLists(const FrameCBuffer& frameCBuffer) noexcept final override;
-
-	bool ValidateData() const noexcept final override;
+	ID3D12PipelineState& PipelineState() const noexcept final override;
+	void SetPipeline(GraphicsCommandList& cmdList) const noexcept final override;
+	void SetRootParameters(GraphicsCommandList& cmdList) const noexcept final override;
 
 private:
 	void BuildBuffers(
-		const Material* materials, 
+		const std::uint32_t* materialIndices, 
 		ID3D12Resource** textures, 
 		ID3D12Resource** normals,
 		const std::uint32_t dataCount) noexcept;
-
-	D3D12_GPU_DESCRIPTOR_HANDLE mTexturesBufferGpuDescHandleBegin;
-	D3D12_GPU_DESCRIPTOR_HANDLE mNormalsBufferGpuDescHandleBegin;
 };
\ No newline at end of file
@@ -0,0 +1,60 @@
+#include "RenderQueue.h"
+
+#include <algorithm>
+
+#include <Utils/RadixSort.h>
+
+std::uint64_t RenderQueue::MakeKey(
+	const std::uint32_t pass,
+	const std::uint32_t pipeline,
+	const std::uint32_t recorder,
+	const std::uint32_t geometryBuffers,
+	const std::uint32_t material,
+	const std::uint32_t depth) noexcept
+{
+	static_assert(sPassBits + sPipelineBits + sRecorderBits + sGeometryBuffersBits + sMaterialBits + sDepthBits == 64U, "Key fields must fill the key");
+	ASSERT(pass < (1U << sPassBits));
+	ASSERT(pipeline < (1U << sPipelineBits));
+	ASSERT(recorder < (1U << sRecorderBits));
+	ASSERT(geometryBuffers < (1U << sGeometryBuffersBits));
+	ASSERT(material < (1U << sMaterialBits));
+	ASSERT(depth < (1U << sDepthBits));
+
+	std::uint64_t key{ pass };
+	key = (key << sPipelineBits) | pipeline;
+	key = (key << sRecorderBits) | recorder;
+	key = (key << sGeometryBuffersBits) | geometryBuffers;
+	key = (key << sMaterialBits) | material;
+	key = (key << sDepthBits) | depth;
+	return key;
+}
+
+std::uint32_t RenderQueue::QuantizeDepth(const float viewDepth, const float nearZ, const float farZ) noexcept {
+	ASSERT(nearZ < farZ);
+
+	const float maxDepth{ static_cast<float>((1U << sDepthBits) - 1U) };
+	const float normalizedDepth{ std::min(std::max((viewDepth - nearZ) / (farZ - nearZ), 0.0f), 1.0f) };
+	return static_cast<std::uint32_t>(normalizedDepth * maxDepth);
+}
+
+void RenderQueue::Clear() noexcept {
+	mPackets.clear();
+	mSortedKeys.clear();
+	mSortedIndices.clear();
+}
+
+void RenderQueue::Push(const DrawPacket& packet) noexcept {
+	mSortedIndices.push_back(static_cast<std::uint32_t>(mPackets.size()));
+	mSortedKeys.push_back(packet.mKey);
+	mPackets.push_back(packet);
+}
+
+void RenderQueue::Sort() noexcept {
+	const std::size_t packetCount{ mPackets.size() };
+	ASSERT(mSortedKeys.size() == packetCount);
+	ASSERT(mSortedIndices.size() == packetCount);
+	mTmpKeys.resize(packetCount);
+	mTmpIndices.resize(packetCount);
+
+	RadixSort::SortKeyValues(mSortedKeys.data(), mSortedIndices.data(), packetCount, mTmpKeys.data(), mTmpIndices.data());
+}
\ No newline at end of file
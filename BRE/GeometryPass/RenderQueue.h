@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <Utils/DebugUtils.h>
+
+// Single instanced draw of a geometry data of a recorder
+struct DrawPacket {
+	std::uint64_t mKey;
+	std::uint32_t mRecorderIndex;
+	std::uint32_t mGeometryIndex;
+
+	// First instance in the recorder visible instances buffer, and instances count
+	std::uint32_t mInstanceOffset;
+	std::uint32_t mInstanceCount;
+};
+
+// Draw packets of a frame, sorted by a 64 bits key to minimize state changes.
+// Key fields, from most to least significant bits:
+// - pass (4 bits)
+// - pipeline (8 bits): pipeline state, root signature and topology
+// - recorder (12 bits): recorder whose root parameters (instances, materials and textures buffers) are bound
+// - geometry buffers (6 bits): index of the vertex and index buffers (GeometryPool arenas) in the recorder,
+//   so packets that share them do not bind them again
+// - material (14 bits): MaterialRegistry index of the packet instances, so packets that sample the same
+//   textures are drawn together. Materials are indexed per instance in a buffer shared by all recorders,
+//   so they are not a state change: packets with instances of different materials use sMixedMaterial.
+// - depth (20 bits): quantized view depth, so packets with the same state are drawn front to back (early z)
+// Packets with the same key keep their push order (recorders push them in geometry data order).
+// It does not depend on D3D, so it can be built on any platform.
+// Steps:
+// - Call Clear() and Push() each frame packets (it is not thread safe)
+// - Call Sort()
+// - Record SortedPacket(0) ... SortedPacket(PacketCount() - 1)
+class RenderQueue {
+public:
+	static const std::uint32_t sPassBits{ 4U };
+	static const std::uint32_t sPipelineBits{ 8U };
+	static const std::uint32_t sRecorderBits{ 12U };
+	static const std::uint32_t sGeometryBuffersBits{ 6U };
+	static const std::uint32_t sMaterialBits{ 14U };
+	static const std::uint32_t sDepthBits{ 20U };
+
+	// Material field of packets whose instances have different materials (or
+	// a material index that does not fit). Geometry buffers indices that do not
+	// fit use the maximum one too. Both only affect the order of packets.
+	static const std::uint32_t sMixedMaterial{ (1U << sMaterialBits) - 1U };
+	static const std::uint32_t sMaxGeometryBuffers{ (1U << sGeometryBuffersBits) - 1U };
+
+	RenderQueue() = default;
+	~RenderQueue() = default;
+	RenderQueue(const RenderQueue&) = delete;
+	const RenderQueue& operator=(const RenderQueue&) = delete;
+	RenderQueue(RenderQueue&&) = default;
+	RenderQueue& operator=(RenderQueue&&) = default;
+
+	// depth is a quantized depth (see QuantizeDepth())
+	static std::uint64_t MakeKey(
+		const std::uint32_t pass,
+		const std::uint32_t pipeline,
+		const std::uint32_t recorder,
+		const std::uint32_t geometryBuffers,
+		const std::uint32_t material,
+		const std::uint32_t depth) noexcept;
+
+	// Quantizes a view depth in [nearZ, farZ] (depths outside are clamped)
+	static std::uint32_t QuantizeDepth(const float viewDepth, const float nearZ, const float farZ) noexcept;
+
+	// Key bits that identify pipeline state (pass and pipeline), and pipeline
+	// and root parameters state (pass, pipeline and recorder)
+	__forceinline static std::uint64_t PipelineState(const std::uint64_t key) noexcept { return key >> (sRecorderBits + sGeometryBuffersBits + sMaterialBits + sDepthBits); }
+	__forceinline static std::uint64_t RecorderState(const std::uint64_t key) noexcept { return key >> (sGeometryBuffersBits + sMaterialBits + sDepthBits); }
+
+	void Clear() noexcept;
+	void Push(const DrawPacket& packet) noexcept;
+
+	// Sorts packets by key. Packets with the same key keep their push order.
+	void Sort() noexcept;
+
+	__forceinline std::uint32_t PacketCount() const noexcept { return static_cast<std::uint32_t>(mPackets.size()); }
+
+	// It must be called after Sort()
+	__forceinline const DrawPacket& SortedPacket(const std::uint32_t index) const noexcept {
+		ASSERT(index < mSortedIndices.size());
+		return mPackets[mSortedIndices[index]];
+	}
+
+private:
+	std::vector<DrawPacket> mPackets;
+
+	// Packets keys and indices (in push order, and in sorted order after Sort()), and radix sort temporary buffers
+	std::vector<std::uint64_t> mSortedKeys;
+	std::vector<std::uint32_t> mSortedIndices;
+	std::vector<std::uint64_t> mTmpKeys;
+	std::vector<std::uint32_t> mTmpIndices;
+};
\ No newline at end of file
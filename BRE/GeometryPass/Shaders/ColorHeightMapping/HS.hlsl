@@ -3,9 +3,10 @@
 struct Input {
 	float3 mPosW : POS_WORLD;
 	float3 mNormalW : NORMAL_WORLD;
-	float3 mTangentW : TANGENT_WORLD;
+	float4 mTangentW : TANGENT_WORLD;
 	float2 mTexCoordO : TEXCOORD0;
 	float mTessFactor : TESS;
+	uint mMaterialIndex : MATERIAL_INDEX;
 };
 
 struct HullShaderConstantOutput {
@@ -16,8 +17,9 @@ struct HullShaderConstantOutput {
 struct Output {
 	float3 mPosW : POS_WORLD;
 	float3 mNormalW : NORMAL_WORLD;
-	float3 mTangentW : TANGENT_WORLD;
+	float4 mTangentW : TANGENT_WORLD;
 	float2 mTexCoordO : TEXCOORD0;
+	uint mMaterialIndex : MATERIAL_INDEX;
 };
 
 HullShaderConstantOutput constant_hull_shader(const InputPatch<Input, NUM_PATCH_POINTS> patch, const uint patchID : SV_PrimitiveID) {
@@ -46,6 +48,7 @@ Output main(const InputPatch <Input, NUM_PATCH_POINTS> patch, const uint control
 	output.mNormalW = patch[controlPointID].mNormalW;
 	output.mTangentW = patch[controlPointID].mTangentW;
 	output.mTexCoordO = patch[controlPointID].mTexCoordO;
+	output.mMaterialIndex = patch[controlPointID].mMaterialIndex;
 	
 	return output;
 }
\ No newline at end of file
@@ -8,11 +8,13 @@ struct Input {
 	float3 mPosV : POS_VIEW;
 	float3 mNormalW : NORMAL_WORLD;
 	float3 mNormalV : NORMAL_VIEW;
+	nointerpolation uint mMaterialIndex : MATERIAL_INDEX;
 };
 
-ConstantBuffer<Material> gMaterial : register(b0);
 ConstantBuffer<FrameCBuffer> gFrameCBuffer : register(b1);
 
+StructuredBuffer<Material> gMaterials : register(t0);
+
 struct Output {	
 	float4 mNormal_Smoothness : SV_Target0;	
 	float4 mBaseColor_MetalMask : SV_Target1;
@@ -21,15 +23,17 @@ struct Output {
 Output main(const in Input input) {
 	Output output = (Output)0;
 
+	const Material material = gMaterials[input.mMaterialIndex];
+
 	// Normal (encoded in view space)
 	const float3 normal = normalize(input.mNormalV);
 	output.mNormal_Smoothness.xy = Encode(normal);
 
 	// Metal mask
-	output.mBaseColor_MetalMask = gMaterial.mBaseColor_MetalMask;
+	output.mBaseColor_MetalMask = material.mBaseColor_MetalMask;
 
 	// Smoothness
-	output.mNormal_Smoothness.z = gMaterial.mSmoothness;
+	output.mNormal_Smoothness.z = material.mSmoothness;
 		
 	return output;
 }
\ No newline at end of file
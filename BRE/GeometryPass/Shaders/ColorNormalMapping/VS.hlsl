@@ -1,15 +1,21 @@
 #include <ShaderUtils/CBuffers.hlsli>
+#include <ShaderUtils/Utils.hlsli>
 
 struct Input {
 	float3 mPosO : POSITION;
 	float3 mNormalO : NORMAL;
-	float3 mTangentO : TANGENT;
+	float4 mTangentO : TANGENT;
 	float2 mTexCoordO : TEXCOORD;
 };
 
-ConstantBuffer<ObjectCBuffer> gObjCBuffer : register(b0);
+ConstantBuffer<InstanceOffset> gInstanceOffset : register(b0);
 ConstantBuffer<FrameCBuffer> gFrameCBuffer : register(b1);
 
+StructuredBuffer<InstanceData> gInstances : register(t0);
+
+// Indices (in gInstances) of the visible instances of the frame, grouped by draw
+StructuredBuffer<uint> gVisibleInstances : register(t1);
+
 struct Output {
 	float4 mPosH : SV_POSITION;
 	float3 mPosW : POS_WORLD;
@@ -21,24 +27,31 @@ struct Output {
 	float3 mBinormalW : BINORMAL_WORLD;
 	float3 mBinormalV : BINORMAL_VIEW;
 	float2 mTexCoordO : TEXCOORD;
+	nointerpolation uint mMaterialIndex : MATERIAL_INDEX;
 };
 
-Output main(in const Input input) {
+Output main(in const Input input, in const uint instanceId : SV_InstanceID) {
+	const InstanceData instance = gInstances[gVisibleInstances[gInstanceOffset.mInstanceOffset + instanceId]];
+
 	Output output;
-	output.mPosW = mul(float4(input.mPosO, 1.0f), gObjCBuffer.mW).xyz;
+	output.mPosW = mul(float4(input.mPosO, 1.0f), instance.mW).xyz;
 	output.mPosV = mul(float4(output.mPosW, 1.0f), gFrameCBuffer.mV).xyz;
 	output.mPosH = mul(float4(output.mPosV, 1.0f), gFrameCBuffer.mP);
 
-	output.mTexCoordO = gObjCBuffer.mTexTransform * input.mTexCoordO;
+	output.mTexCoordO = instance.mTexTransform * input.mTexCoordO;
 
-	output.mNormalW = mul(float4(input.mNormalO, 0.0f), gObjCBuffer.mW).xyz;
+	output.mNormalW = mul(float4(input.mNormalO, 0.0f), instance.mW).xyz;
 	output.mNormalV = mul(float4(output.mNormalW, 0.0f), gFrameCBuffer.mV).xyz;
 
-	output.mTangentW = mul(float4(input.mTangentO, 0.0f), gObjCBuffer.mW).xyz;
+	output.mTangentW = mul(float4(input.mTangentO.xyz, 0.0f), instance.mW).xyz;
 	output.mTangentV = mul(float4(output.mTangentW, 0.0f), gFrameCBuffer.mV).xyz;
 	
-	output.mBinormalW = normalize(cross(output.mNormalW, output.mTangentW));
-	output.mBinormalV = normalize(cross(output.mNormalV, output.mTangentV));
+	// Tangent w component stores tangent frame handedness, flipped by mirroring world matrices
+	const float handedness = input.mTangentO.w * WorldHandedness(instance.mW);
+	output.mBinormalW = normalize(cross(output.mNormalW, output.mTangentW)) * handedness;
+	output.mBinormalV = normalize(cross(output.mNormalV, output.mTangentV)) * handedness;
+
+	output.mMaterialIndex = instance.mMaterialIndex;
 
 	return output;
 }
\ No newline at end of file
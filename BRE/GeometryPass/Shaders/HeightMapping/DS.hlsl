@@ -1,4 +1,5 @@
 #include <ShaderUtils/CBuffers.hlsli>
+#include <ShaderUtils/Material.hlsli>
 
 #define NUM_PATCH_POINTS 3
 #define HEIGHT_SCALE 0.07f
@@ -11,14 +12,18 @@ struct HullShaderConstantOutput {
 struct Input {
 	float3 mPosW : POS_WORLD;
 	float3 mNormalW : NORMAL_WORLD;
-	float3 mTangentW : TANGENT_WORLD;
+	float4 mTangentW : TANGENT_WORLD;
 	float2 mTexCoordO : TEXCOORD0;
+	uint mMaterialIndex : MATERIAL_INDEX;
 };
 
 ConstantBuffer<FrameCBuffer> gFrameCBuffer : register(b0);
 
+StructuredBuffer<Material> gMaterials : register(t0);
+
 SamplerState TexSampler : register (s0);
-Texture2D HeightTexture : register (t0);
+// Bindless textures (see TextureRegistry), indexed with material textures indices
+Texture2D gTextures[] : register (t0, space1);
 
 struct Output {
 	float4 mPosH : SV_Position;
@@ -31,12 +36,16 @@ struct Output {
 	float3 mBinormalW : BINORMAL_WORLD;
 	float3 mBinormalV : BINORMAL_VIEW;
 	float2 mTexCoordO : TEXCOORD0;
+	nointerpolation uint mMaterialIndex : MATERIAL_INDEX;
 };
 
 [domain("tri")]
 Output main(const HullShaderConstantOutput HSConstantOutput, const float3 uvw : SV_DomainLocation, const OutputPatch <Input, NUM_PATCH_POINTS> patch) {
 	Output output = (Output)0;
 
+	// All patch control points belong to the same instance
+	output.mMaterialIndex = patch[0].mMaterialIndex;
+
 	// Get texture coordinates
 	output.mTexCoordO = uvw.x * patch[0].mTexCoordO + uvw.y * patch[1].mTexCoordO + uvw.z * patch[2].mTexCoordO;
 
@@ -52,7 +61,7 @@ Output main(const HullShaderConstantOutput HSConstantOutput, const float3 uvw :
 	// Choose the mipmap level based on distance to the eye; specifically, choose the next miplevel every MipInterval units, and clamp the miplevel in [0, 6].
 	const float MipInterval = 20.0f;
 	const float mipLevel = clamp((length(posV) - MipInterval) / MipInterval, 0.0f, 6.0f);
-	const float height = HeightTexture.SampleLevel(TexSampler, output.mTexCoordO, mipLevel).x;
+	const float height = gTextures[NonUniformResourceIndex(gMaterials[output.mMaterialIndex].mHeightTextureIndex)].SampleLevel(TexSampler, output.mTexCoordO, mipLevel).x;
 	const float displacement = (HEIGHT_SCALE * (height - 1));
 
 	// Offset vertex along normal
@@ -60,12 +69,13 @@ Output main(const HullShaderConstantOutput HSConstantOutput, const float3 uvw :
 	posV += output.mNormalV * displacement;
 	
 	// Get tangent
-	output.mTangentW = normalize(uvw.x * patch[0].mTangentW + uvw.y * patch[1].mTangentW + uvw.z * patch[2].mTangentW);
+	output.mTangentW = normalize(uvw.x * patch[0].mTangentW.xyz + uvw.y * patch[1].mTangentW.xyz + uvw.z * patch[2].mTangentW.xyz);
 	output.mTangentV = normalize(mul(float4(output.mTangentW, 0.0f), gFrameCBuffer.mV)).xyz;
 
-	// Get binormal
-	output.mBinormalW = normalize(cross(output.mNormalW, output.mTangentW));
-	output.mBinormalV = normalize(cross(output.mNormalV, output.mTangentV));
+	// Get binormal (tangent w component stores tangent frame handedness)
+	const float handedness = patch[0].mTangentW.w;
+	output.mBinormalW = normalize(cross(output.mNormalW, output.mTangentW)) * handedness;
+	output.mBinormalV = normalize(cross(output.mNormalV, output.mTangentV)) * handedness;
 	
 	output.mPosW = posW;
 	output.mPosV = posV;
@@ -2,12 +2,14 @@
 "RootFlags(ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT | " \
 "DENY_HULL_SHADER_ROOT_ACCESS | " \
 "DENY_GEOMETRY_SHADER_ROOT_ACCESS), " \
-"DescriptorTable(CBV(b0), visibility = SHADER_VISIBILITY_VERTEX), " \
+"SRV(t0, visibility = SHADER_VISIBILITY_VERTEX), " \
 "CBV(b1, visibility = SHADER_VISIBILITY_VERTEX), " \
 "CBV(b0, visibility = SHADER_VISIBILITY_DOMAIN), " \
-"DescriptorTable(SRV(t0), visibility = SHADER_VISIBILITY_DOMAIN), " \
-"DescriptorTable(CBV(b0), visibility = SHADER_VISIBILITY_PIXEL), " \
+"DescriptorTable(SRV(t0, space = 1, numDescriptors = unbounded), visibility = SHADER_VISIBILITY_DOMAIN), " \
+"SRV(t0, visibility = SHADER_VISIBILITY_PIXEL), " \
 "CBV(b1, visibility = SHADER_VISIBILITY_PIXEL), " \
-"DescriptorTable(SRV(t0), visibility = SHADER_VISIBILITY_PIXEL), " \
-"DescriptorTable(SRV(t1), visibility = SHADER_VISIBILITY_PIXEL), " \
+"DescriptorTable(SRV(t0, space = 1, numDescriptors = unbounded), visibility = SHADER_VISIBILITY_PIXEL), " \
+"RootConstants(num32BitConstants = 1, b0, visibility = SHADER_VISIBILITY_VERTEX), " \
+"SRV(t1, visibility = SHADER_VISIBILITY_VERTEX), " \
+"SRV(t0, visibility = SHADER_VISIBILITY_DOMAIN), " \
 "StaticSampler(s0, filter=FILTER_ANISOTROPIC)"
\ No newline at end of file
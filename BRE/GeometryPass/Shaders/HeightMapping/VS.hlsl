@@ -1,4 +1,5 @@
 #include <ShaderUtils/CBuffers.hlsli>
+#include <ShaderUtils/Utils.hlsli>
 
 #define MIN_TESS_DISTANCE 25.0f
 #define MAX_TESS_DISTANCE 1.0f
@@ -8,31 +9,40 @@
 struct Input {
 	float3 mPosO : POSITION;
 	float3 mNormalO : NORMAL;
-	float3 mTangentO : TANGENT;
+	float4 mTangentO : TANGENT;
 	float2 mTexCoordO : TEXCOORD;
 };
 
-ConstantBuffer<ObjectCBuffer> gObjCBuffer : register(b0);
+ConstantBuffer<InstanceOffset> gInstanceOffset : register(b0);
 ConstantBuffer<FrameCBuffer> gFrameCBuffer : register(b1);
 
+StructuredBuffer<InstanceData> gInstances : register(t0);
+
+// Indices (in gInstances) of the visible instances of the frame, grouped by draw
+StructuredBuffer<uint> gVisibleInstances : register(t1);
+
 struct Output {
 	float3 mPosW : POS_WORLD;	
 	float3 mNormalW : NORMAL_WORLD;
-	float3 mTangentW : TANGENT_WORLD;
+	float4 mTangentW : TANGENT_WORLD;
 	float2 mTexCoordO : TEXCOORD0;
 	float mTessFactor : TESS;
+	uint mMaterialIndex : MATERIAL_INDEX;
 };
 
-Output main(in const Input input) {
+Output main(in const Input input, in const uint instanceId : SV_InstanceID) {
+	const InstanceData instance = gInstances[gVisibleInstances[gInstanceOffset.mInstanceOffset + instanceId]];
+
 	Output output;
 
-	output.mPosW = mul(float4(input.mPosO, 1.0f), gObjCBuffer.mW).xyz;
+	output.mPosW = mul(float4(input.mPosO, 1.0f), instance.mW).xyz;
 
-	output.mNormalW = mul(float4(input.mNormalO, 0.0f), gObjCBuffer.mW).xyz;
+	output.mNormalW = mul(float4(input.mNormalO, 0.0f), instance.mW).xyz;
 
-	output.mTangentW = mul(float4(input.mTangentO, 0.0f), gObjCBuffer.mW).xyz;
+	// Tangent w component stores tangent frame handedness, flipped by mirroring world matrices
+	output.mTangentW = float4(mul(float4(input.mTangentO.xyz, 0.0f), instance.mW).xyz, input.mTangentO.w * WorldHandedness(instance.mW));
 
-	output.mTexCoordO = gObjCBuffer.mTexTransform * input.mTexCoordO;
+	output.mTexCoordO = instance.mTexTransform * input.mTexCoordO;
 		
 
 	// Normalized tessellation factor. 
@@ -45,5 +55,7 @@ Output main(in const Input input) {
 	// Rescale [0,1] --> [MIN_TESS_FACTOR, MAX_TESS_FACTOR].
 	output.mTessFactor = MIN_TESS_FACTOR + tess * (MAX_TESS_FACTOR - MIN_TESS_FACTOR);
 
+	output.mMaterialIndex = instance.mMaterialIndex;
+
 	return output;
 }
\ No newline at end of file
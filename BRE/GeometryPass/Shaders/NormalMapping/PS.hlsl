@@ -13,14 +13,16 @@ struct Input {
 	float3 mBinormalW : BINORMAL_WORLD;
 	float3 mBinormalV : BINORMAL_VIEW;
 	float2 mTexCoordO : TEXCOORD;
+	nointerpolation uint mMaterialIndex : MATERIAL_INDEX;
 };
 
-ConstantBuffer<Material> gMaterial : register(b0);
 ConstantBuffer<FrameCBuffer> gFrameCBuffer : register(b1);
 
+StructuredBuffer<Material> gMaterials : register(t0);
+
 SamplerState TexSampler : register (s0);
-Texture2D DiffuseTexture : register (t0);
-Texture2D NormalTexture : register (t1);
+// Bindless textures (see TextureRegistry), indexed with material textures indices
+Texture2D gTextures[] : register (t0, space1);
 
 struct Output {
 	float4 mNormal_Smoothness : SV_Target0;
@@ -30,19 +32,21 @@ struct Output {
 Output main(const in Input input) {
 	Output output = (Output)0;
 
+	const Material material = gMaterials[input.mMaterialIndex];
+
 	// Normal (encoded in view space)
-	const float3 sampledNormal = normalize(UnmapF1(NormalTexture.Sample(TexSampler, input.mTexCoordO).xyz));
+	const float3 sampledNormal = normalize(UnmapF1(gTextures[NonUniformResourceIndex(material.mNormalTextureIndex)].Sample(TexSampler, input.mTexCoordO).xyz));
 	const float3x3 tbnW = float3x3(normalize(input.mTangentW), normalize(input.mBinormalW), normalize(input.mNormalW));
 	const float3 normalW = normalize(mul(sampledNormal, tbnW));
 	const float3x3 tbnV = float3x3(normalize(input.mTangentV), normalize(input.mBinormalV), normalize(input.mNormalV));
 	output.mNormal_Smoothness.xy = Encode(mul(sampledNormal, tbnV));
 
 	// Base color and metal mask
-	const float3 diffuseColor = DiffuseTexture.Sample(TexSampler, input.mTexCoordO).rgb;
-	output.mBaseColor_MetalMask = float4(gMaterial.mBaseColor_MetalMask.xyz * diffuseColor, gMaterial.mBaseColor_MetalMask.w);
+	const float3 diffuseColor = gTextures[NonUniformResourceIndex(material.mDiffuseTextureIndex)].Sample(TexSampler, input.mTexCoordO).rgb;
+	output.mBaseColor_MetalMask = float4(material.mBaseColor_MetalMask.xyz * diffuseColor, material.mBaseColor_MetalMask.w);
 
 	// Smoothness
-	output.mNormal_Smoothness.z = gMaterial.mSmoothness;
+	output.mNormal_Smoothness.z = material.mSmoothness;
 
 	return output;
 }
\ No newline at end of file
@@ -9,13 +9,16 @@ struct Input {
 	float3 mNormalW : NORMAL_WORLD;
 	float3 mNormalV : NORMAL_VIEW;
 	float2 mTexCoordO : TEXCOORD;
+	nointerpolation uint mMaterialIndex : MATERIAL_INDEX;
 };
 
-ConstantBuffer<Material> gMaterial : register(b0);
 ConstantBuffer<FrameCBuffer> gFrameCBuffer : register(b1);
 
+StructuredBuffer<Material> gMaterials : register(t0);
+
 SamplerState TexSampler : register (s0);
-Texture2D DiffuseTexture : register (t0);
+// Bindless textures (see TextureRegistry), indexed with material textures indices
+Texture2D gTextures[] : register (t0, space1);
 
 struct Output {
 	float4 mNormal_Smoothness : SV_Target0;
@@ -25,16 +28,18 @@ struct Output {
 Output main(const in Input input) {
 	Output output = (Output)0;
 
+	const Material material = gMaterials[input.mMaterialIndex];
+
 	// Normal (encoded in view space)
 	const float3 normal = normalize(input.mNormalV);
 	output.mNormal_Smoothness.xy = Encode(normal);
 
 	// Base color and metal mask
-	const float3 diffuseColor = DiffuseTexture.Sample(TexSampler, input.mTexCoordO).rgb;
-	output.mBaseColor_MetalMask = float4(gMaterial.mBaseColor_MetalMask.xyz * diffuseColor, gMaterial.mBaseColor_MetalMask.w);
+	const float3 diffuseColor = gTextures[NonUniformResourceIndex(material.mDiffuseTextureIndex)].Sample(TexSampler, input.mTexCoordO).rgb;
+	output.mBaseColor_MetalMask = float4(material.mBaseColor_MetalMask.xyz * diffuseColor, material.mBaseColor_MetalMask.w);
 
 	// Smoothness
-	output.mNormal_Smoothness.z = gMaterial.mSmoothness;
+	output.mNormal_Smoothness.z = material.mSmoothness;
 
 	return output;
 }
\ No newline at end of file
@@ -7,9 +7,14 @@ struct Input {
 	float2 mTexCoordO : TEXCOORD;
 };
 
-ConstantBuffer<ObjectCBuffer> gObjCBuffer : register(b0);
+ConstantBuffer<InstanceOffset> gInstanceOffset : register(b0);
 ConstantBuffer<FrameCBuffer> gFrameCBuffer : register(b1);
 
+StructuredBuffer<InstanceData> gInstances : register(t0);
+
+// Indices (in gInstances) of the visible instances of the frame, grouped by draw
+StructuredBuffer<uint> gVisibleInstances : register(t1);
+
 struct Output {
 	float4 mPosH : SV_POSITION;
 	float3 mPosW : POS_WORLD;
@@ -17,19 +22,24 @@ struct Output {
 	float3 mNormalW : NORMAL_WORLD;
 	float3 mNormalV : NORMAL_VIEW;
 	float2 mTexCoordO : TEXCOORD;
+	nointerpolation uint mMaterialIndex : MATERIAL_INDEX;
 };
 
-Output main(in const Input input) {
+Output main(in const Input input, in const uint instanceId : SV_InstanceID) {
+	const InstanceData instance = gInstances[gVisibleInstances[gInstanceOffset.mInstanceOffset + instanceId]];
+
 	Output output;
-	output.mPosW = mul(float4(input.mPosO, 1.0f), gObjCBuffer.mW).xyz;
+	output.mPosW = mul(float4(input.mPosO, 1.0f), instance.mW).xyz;
 	output.mPosV = mul(float4(output.mPosW, 1.0f), gFrameCBuffer.mV).xyz;
 
-	output.mNormalW = mul(float4(input.mNormalO, 0.0f), gObjCBuffer.mW).xyz;
+	output.mNormalW = mul(float4(input.mNormalO, 0.0f), instance.mW).xyz;
 	output.mNormalV = mul(float4(output.mNormalW, 0.0f), gFrameCBuffer.mV).xyz;
 
 	output.mPosH = mul(float4(output.mPosV, 1.0f), gFrameCBuffer.mP);
 
-	output.mTexCoordO = gObjCBuffer.mTexTransform * input.mTexCoordO;
+	output.mTexCoordO = instance.mTexTransform * input.mTexCoordO;
+
+	output.mMaterialIndex = instance.mMaterialIndex;
 
 	return output;
 }
\ No newline at end of file
@@ -22,6 +22,10 @@ public:
 	static const std::uint32_t sWindowWidth{ 1920U };
 	static const std::uint32_t sWindowHeight{ 1080U };
 
+	// If it is true, punctual lights are assigned to view frustum clusters in the CPU, and
+	// shaded in a single full screen pass. Otherwise, a screen quad is drawn per light.
+	static const bool sClusteredLightCulling{ true };
+
 	// Final buffer render target
 	static const DXGI_FORMAT sFrameBufferRTFormat{ DXGI_FORMAT_R8G8B8A8_UNORM_SRGB };
 
@@ -8,9 +8,12 @@
 #include <CommandManager\CommandManager.h>
 #include <DXUtils/d3dx12.h>
 #include <GeometryPass\GeometryPass.h>
+#include <LightingPass\Recorders\ClusteredPunctualLightCmdListRecorder.h>
 #include <LightingPass\Recorders\PunctualLightCmdListRecorder.h>
 #include <ShaderUtils\CBuffers.h>
 #include <Utils\DebugUtils.h>
+#include <Utils/Profiler.h>
+#include <Utils/RenderStats.h>
 
 namespace {
 	void CreateCommandObjects(
@@ -34,6 +37,26 @@ namespace {
 	}
 }
 
+LightingPassCmdListRecorder* LightingPass::CreatePunctualLightCmdListRecorder(ID3D12Device& device) noexcept {
+	if (Settings::sClusteredLightCulling) {
+		return new ClusteredPunctualLightCmdListRecorder(device);
+	}
+
+	return new PunctualLightCmdListRecorder(device);
+}
+
+void LightingPass::InitPSOs() noexcept {
+	if (Settings::sClusteredLightCulling) {
+		ClusteredPunctualLightCmdListRecorder::InitPSO();
+	}
+	else {
+		PunctualLightCmdListRecorder::InitPSO();
+	}
+
+	AmbientLightPass::InitPSOs();
+	EnvironmentLightPass::InitPSOs();
+}
+
 void LightingPass::Init(
 	ID3D12Device& device,
 	CommandListExecutor& cmdListExecutor,
@@ -43,7 +66,7 @@ void LightingPass::Init(
 	ID3D12Resource& depthBuffer,
 	const D3D12_CPU_DESCRIPTOR_HANDLE& colorBufferCpuDesc,
 	const D3D12_CPU_DESCRIPTOR_HANDLE& depthBufferCpuDesc,
-	ID3D12Resource& diffuseIrradianceCubeMap,
+	const SphericalHarmonics::Coefficients& diffuseIrradiance,
 	ID3D12Resource& specularPreConvolvedCubeMap) noexcept {
 
 	ASSERT(ValidateData() == false);
@@ -56,9 +79,6 @@ void LightingPass::Init(
 	mDepthBuffer = &depthBuffer;
 	mDepthBufferCpuDesc = depthBufferCpuDesc;
 
-	// Initialize recorder's pso
-	PunctualLightCmdListRecorder::InitPSO();
-
 	// Initialize ambient pass
 	ASSERT(geometryBuffers[GeometryPass::BASECOLOR_METALMASK].Get() != nullptr);
 	mAmbientLightPass.Init(
@@ -81,7 +101,7 @@ void LightingPass::Init(
 		*mDepthBuffer,
 		colorBufferCpuDesc, 
 		depthBufferCpuDesc,
-		diffuseIrradianceCubeMap,
+		diffuseIrradiance,
 		specularPreConvolvedCubeMap);
 
 	// Init internal data for all lights recorders
@@ -94,12 +114,14 @@ void LightingPass::Init(
 }
 
 void LightingPass::Execute(const FrameCBuffer& frameCBuffer) noexcept {
+	PROFILE_ZONE("LightingPass::Execute");
+
 	ASSERT(ValidateData());
 
 	ExecuteBeginTask();
 
 	// Total tasks = Light tasks + 1 ambient pass task + 1 environment light pass task
-	/*mCmdListExecutor->ResetExecutedCmdListCount();
+	mCmdListExecutor->ResetExecutedCmdListCount();
 	const std::uint32_t lightTaskCount{ static_cast<std::uint32_t>(mRecorders.size())};
 	
 	// Execute light pass tasks
@@ -112,9 +134,7 @@ void LightingPass::Execute(const FrameCBuffer& frameCBuffer) noexcept {
 	);
 	
 	// Wait until all previous tasks command lists are executed
-	while (mCmdListExecutor->ExecutedCmdListCount() < lightTaskCount) {
-		Sleep(0U);
-	}*/
+	mCmdListExecutor->WaitForExecutedCmdLists(lightTaskCount);
 
 	// Execute ambient light pass tasks
 	mAmbientLightPass.Execute(frameCBuffer);
@@ -175,6 +195,7 @@ void LightingPass::ExecuteBeginTask() noexcept {
 	};
 	const std::uint32_t barriersCount = _countof(barriers);
 	ASSERT(barriersCount == GeometryPass::BUFFERS_COUNT + 1UL);
+	RENDER_STATS_ADD(RESOURCE_BARRIERS, barriersCount);
 	mCmdList->ResourceBarrier(barriersCount, barriers);
 
 	// Clear render targets
@@ -184,6 +205,7 @@ void LightingPass::ExecuteBeginTask() noexcept {
 	// Execute preliminary task
 	{
 		ID3D12CommandList* cmdLists[] = { mCmdList };
+		RENDER_STATS_EXECUTE(_countof(cmdLists));
 		mCmdQueue->ExecuteCommandLists(_countof(cmdLists), cmdLists);
 	}
 }
@@ -207,12 +229,14 @@ void LightingPass::ExecuteEndingTask() noexcept {
 	};
 	const std::uint32_t barriersCount = _countof(endBarriers);
 	ASSERT(barriersCount == 1UL);
+	RENDER_STATS_ADD(RESOURCE_BARRIERS, barriersCount);
 	mCmdList->ResourceBarrier(barriersCount, endBarriers);
 	CHECK_HR(mCmdList->Close());
 
 	// Execute end task
 	{
 		ID3D12CommandList* cmdLists[] = { mCmdList };
+		RENDER_STATS_EXECUTE(_countof(cmdLists));
 		mCmdQueue->ExecuteCommandLists(_countof(cmdLists), cmdLists);
 	}
 }
\ No newline at end of file
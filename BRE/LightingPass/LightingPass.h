@@ -34,6 +34,13 @@ public:
 	// You should get recorders and fill them, before calling Init()
 	__forceinline Recorders& GetRecorders() noexcept { return mRecorders; }
 
+	// Creates a punctual lights recorder of the light culling mode in Settings
+	static LightingPassCmdListRecorder* CreatePunctualLightCmdListRecorder(ID3D12Device& device) noexcept;
+
+	// Creates pipeline states of lights recorders, ambient light and environment light passes.
+	// It must be called before Init().
+	static void InitPSOs() noexcept;
+
 	// You should call this method after filling recorders and before Execute()
 	void Init(
 		ID3D12Device& device,
@@ -44,7 +51,7 @@ public:
 		ID3D12Resource& depthBuffer,
 		const D3D12_CPU_DESCRIPTOR_HANDLE& colorBufferCpuDesc,
 		const D3D12_CPU_DESCRIPTOR_HANDLE& depthBufferCpuDesc,
-		ID3D12Resource& diffuseIrradianceCubeMap,
+		const SphericalHarmonics::Coefficients& diffuseIrradiance,
 		ID3D12Resource& specularPreConvolvedCubeMap) noexcept;
 
 	void Execute(const FrameCBuffer& frameCBuffer) noexcept;
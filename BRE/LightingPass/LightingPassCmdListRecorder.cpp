@@ -1,6 +1,8 @@
 #include "LightingPassCmdListRecorder.h"
 
 #include <CommandManager/CommandManager.h>
+#include <MathUtils/MathUtils.h>
+#include <ShaderUtils\CBuffers.h>
 #include <Utils/DebugUtils.h>
 
 namespace {
@@ -45,9 +47,16 @@ bool LightingPassCmdListRecorder::ValidateData() const noexcept {
 	return
 		mCmdList != nullptr &&
 		mNumLights != 0UL &&
-		mImmutableCBuffer != nullptr &&
-		mLightsBuffer != nullptr &&
-		mLightsBufferGpuDescHandleBegin.ptr != 0UL;
+		mLightStore.LightCount() == mNumLights;
+}
+
+void LightingPassCmdListRecorder::UpdateLightStore(const FrameCBuffer& frameCBuffer) noexcept {
+	// Frame cbuffer matrices are transposed for shaders
+	DirectX::XMFLOAT4X4 view;
+	DirectX::XMFLOAT4X4 proj;
+	DirectX::XMStoreFloat4x4(&view, MathUtils::GetTranspose(frameCBuffer.mView));
+	DirectX::XMStoreFloat4x4(&proj, MathUtils::GetTranspose(frameCBuffer.mProj));
+	mLightStore.Update(&view.m[0U][0U], &proj.m[0U][0U]);
 }
 
 void LightingPassCmdListRecorder::InitInternal(
@@ -6,6 +6,7 @@
 
 #include <DXUtils/D3DFactory.h>
 #include <GlobalData/Settings.h>
+#include <LightingPass/PunctualLightStore.h>
 #include <ResourceManager/BufferCreator.h>
 
 struct FrameCBuffer;
@@ -56,7 +57,17 @@ public:
 	// new members
 	virtual bool ValidateData() const noexcept;
 
+	// World space lights. They can be modified between frames (for example, to animate them)
+	__forceinline PunctualLightStore& LightStore() noexcept { return mLightStore; }
+	__forceinline const PunctualLightStore& LightStore() const noexcept { return mLightStore; }
+
+	// Lights inside the view frustum in the last recorded frame
+	__forceinline std::uint32_t VisibleLightCount() const noexcept { return mLightStore.VisibleLightCount(); }
+
 protected:
+	// Transforms lights to view space and culls them against the view frustum of the frame
+	void UpdateLightStore(const FrameCBuffer& frameCBuffer) noexcept;
+
 	ID3D12Device& mDevice;
 
 	ID3D12GraphicsCommandList* mCmdList{ nullptr };
@@ -77,6 +88,5 @@ protected:
 	UploadBuffer* mFrameCBuffer[Settings::sQueuedFrameCount]{ nullptr };
 	UploadBuffer* mImmutableCBuffer{ nullptr };
 
-	UploadBuffer* mLightsBuffer{ nullptr };
-	D3D12_GPU_DESCRIPTOR_HANDLE mLightsBufferGpuDescHandleBegin{ 0UL };
+	PunctualLightStore mLightStore;
 };
\ No newline at end of file
@@ -0,0 +1,207 @@
+#include "PunctualLightStore.h"
+
+#include <cstring>
+#include <limits>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(_M_X64) || defined(__SSE2__)
+#include <xmmintrin.h>
+#endif
+
+namespace {
+	// Padding lights range. They are outside of any plane, so they are never visible.
+	const float sPaddingRange{ -std::numeric_limits<float>::max() };
+
+	std::uint32_t PaddedCount(const std::uint32_t count) noexcept {
+		return (count + FrustumCuller::sSimdWidth - 1U) & ~(FrustumCuller::sSimdWidth - 1U);
+	}
+}
+
+void PunctualLightStore::Init(const PunctualLight* lights, const std::uint32_t count) noexcept {
+	ASSERT(lights != nullptr || count == 0U);
+
+	const std::uint32_t paddedCount{ PaddedCount(count) };
+	mPosX.assign(paddedCount, 0.0f);
+	mPosY.assign(paddedCount, 0.0f);
+	mPosZ.assign(paddedCount, 0.0f);
+	mRange.assign(paddedCount, sPaddingRange);
+	mColorAndPower.assign(paddedCount * 4UL, 0.0f);
+	for (std::uint32_t i = 0U; i < count; ++i) {
+		const PunctualLight& light(lights[i]);
+		mPosX[i] = light.mPosAndRange[0U];
+		mPosY[i] = light.mPosAndRange[1U];
+		mPosZ[i] = light.mPosAndRange[2U];
+		mRange[i] = light.mPosAndRange[3U];
+		std::memcpy(&mColorAndPower[i * 4UL], light.mColorAndPower, sizeof(light.mColorAndPower));
+	}
+
+	mVisibleLights.resize(paddedCount);
+	mVisibleIndices.resize(paddedCount);
+	mLightCount = count;
+	mVisibleCount = 0U;
+}
+
+void PunctualLightStore::SetPosition(const std::uint32_t index, const float position[3U]) noexcept {
+	ASSERT(index < mLightCount);
+	ASSERT(position != nullptr);
+
+	mPosX[index] = position[0U];
+	mPosY[index] = position[1U];
+	mPosZ[index] = position[2U];
+}
+
+void PunctualLightStore::SetRange(const std::uint32_t index, const float range) noexcept {
+	ASSERT(index < mLightCount);
+	ASSERT(range >= 0.0f);
+
+	mRange[index] = range;
+}
+
+void PunctualLightStore::SetColorAndPower(const std::uint32_t index, const float colorAndPower[4U]) noexcept {
+	ASSERT(index < mLightCount);
+	ASSERT(colorAndPower != nullptr);
+
+	std::memcpy(&mColorAndPower[index * 4UL], colorAndPower, sizeof(float) * 4UL);
+}
+
+void PunctualLightStore::Update(const float view[16U], const float proj[16U]) noexcept {
+	ASSERT(view != nullptr);
+	ASSERT(proj != nullptr);
+
+	// Planes extracted from the projection are in view space
+	mViewFrustum.SetViewProjection(proj);
+	const float (&viewPlanes)[FrustumCuller::sPlaneCount][4U] = mViewFrustum.Planes();
+
+	const std::uint32_t paddedCount{ static_cast<std::uint32_t>(mRange.size()) };
+	PunctualLight* visibleLights{ mVisibleLights.data() };
+	std::uint32_t* visibleIndices{ mVisibleIndices.data() };
+	std::uint32_t visibleCount{ 0U };
+
+	// Transformed positions of a SIMD group, and which of them are visible.
+	// Lights are written without branches (the slot is overwritten if the light is not visible)
+	float viewX[FrustumCuller::sSimdWidth];
+	float viewY[FrustumCuller::sSimdWidth];
+	float viewZ[FrustumCuller::sSimdWidth];
+	auto compactGroup = [&](const std::uint32_t first, const std::uint32_t width, const std::uint32_t mask) {
+		for (std::uint32_t j = 0U; j < width; ++j) {
+			const std::uint32_t index{ first + j };
+			PunctualLight& light(visibleLights[visibleCount]);
+			light.mPosAndRange[0U] = viewX[j];
+			light.mPosAndRange[1U] = viewY[j];
+			light.mPosAndRange[2U] = viewZ[j];
+			light.mPosAndRange[3U] = mRange[index];
+			std::memcpy(light.mColorAndPower, &mColorAndPower[index * 4UL], sizeof(light.mColorAndPower));
+			visibleIndices[visibleCount] = index;
+			visibleCount += (mask >> j) & 1U;
+		}
+	};
+
+#if defined(__AVX__)
+	__m256 m[12U];
+	for (std::uint32_t i = 0U; i < 4U; ++i) {
+		for (std::uint32_t j = 0U; j < 3U; ++j) {
+			m[i * 3U + j] = _mm256_set1_ps(view[i * 4U + j]);
+		}
+	}
+
+	__m256 planes[FrustumCuller::sPlaneCount][4U];
+	for (std::uint32_t i = 0U; i < FrustumCuller::sPlaneCount; ++i) {
+		for (std::uint32_t j = 0U; j < 4U; ++j) {
+			planes[i][j] = _mm256_set1_ps(viewPlanes[i][j]);
+		}
+	}
+
+	const __m256 zero{ _mm256_setzero_ps() };
+	for (std::uint32_t i = 0U; i < paddedCount; i += 8U) {
+		const __m256 x{ _mm256_loadu_ps(mPosX.data() + i) };
+		const __m256 y{ _mm256_loadu_ps(mPosY.data() + i) };
+		const __m256 z{ _mm256_loadu_ps(mPosZ.data() + i) };
+		const __m256 r{ _mm256_loadu_ps(mRange.data() + i) };
+
+		__m256 v[3U];
+		for (std::uint32_t j = 0U; j < 3U; ++j) {
+			v[j] = _mm256_add_ps(_mm256_mul_ps(x, m[j]), m[9U + j]);
+			v[j] = _mm256_add_ps(v[j], _mm256_mul_ps(y, m[3U + j]));
+			v[j] = _mm256_add_ps(v[j], _mm256_mul_ps(z, m[6U + j]));
+		}
+
+		__m256 inside{ _mm256_cmp_ps(r, zero, _CMP_GE_OQ) };
+		for (std::uint32_t p = 0U; p < FrustumCuller::sPlaneCount; ++p) {
+			__m256 dist{ _mm256_add_ps(_mm256_mul_ps(planes[p][0U], v[0U]), planes[p][3U]) };
+			dist = _mm256_add_ps(dist, _mm256_mul_ps(planes[p][1U], v[1U]));
+			dist = _mm256_add_ps(dist, _mm256_mul_ps(planes[p][2U], v[2U]));
+			inside = _mm256_and_ps(inside, _mm256_cmp_ps(_mm256_add_ps(dist, r), zero, _CMP_GE_OQ));
+		}
+
+		_mm256_storeu_ps(viewX, v[0U]);
+		_mm256_storeu_ps(viewY, v[1U]);
+		_mm256_storeu_ps(viewZ, v[2U]);
+		compactGroup(i, 8U, static_cast<std::uint32_t>(_mm256_movemask_ps(inside)));
+	}
+#elif defined(_M_X64) || defined(__SSE2__)
+	__m128 m[12U];
+	for (std::uint32_t i = 0U; i < 4U; ++i) {
+		for (std::uint32_t j = 0U; j < 3U; ++j) {
+			m[i * 3U + j] = _mm_set1_ps(view[i * 4U + j]);
+		}
+	}
+
+	__m128 planes[FrustumCuller::sPlaneCount][4U];
+	for (std::uint32_t i = 0U; i < FrustumCuller::sPlaneCount; ++i) {
+		for (std::uint32_t j = 0U; j < 4U; ++j) {
+			planes[i][j] = _mm_set1_ps(viewPlanes[i][j]);
+		}
+	}
+
+	const __m128 zero{ _mm_setzero_ps() };
+	for (std::uint32_t i = 0U; i < paddedCount; i += 4U) {
+		const __m128 x{ _mm_loadu_ps(mPosX.data() + i) };
+		const __m128 y{ _mm_loadu_ps(mPosY.data() + i) };
+		const __m128 z{ _mm_loadu_ps(mPosZ.data() + i) };
+		const __m128 r{ _mm_loadu_ps(mRange.data() + i) };
+
+		__m128 v[3U];
+		for (std::uint32_t j = 0U; j < 3U; ++j) {
+			v[j] = _mm_add_ps(_mm_mul_ps(x, m[j]), m[9U + j]);
+			v[j] = _mm_add_ps(v[j], _mm_mul_ps(y, m[3U + j]));
+			v[j] = _mm_add_ps(v[j], _mm_mul_ps(z, m[6U + j]));
+		}
+
+		__m128 inside{ _mm_cmpge_ps(r, zero) };
+		for (std::uint32_t p = 0U; p < FrustumCuller::sPlaneCount; ++p) {
+			__m128 dist{ _mm_add_ps(_mm_mul_ps(planes[p][0U], v[0U]), planes[p][3U]) };
+			dist = _mm_add_ps(dist, _mm_mul_ps(planes[p][1U], v[1U]));
+			dist = _mm_add_ps(dist, _mm_mul_ps(planes[p][2U], v[2U]));
+			inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(dist, r), zero));
+		}
+
+		_mm_storeu_ps(viewX, v[0U]);
+		_mm_storeu_ps(viewY, v[1U]);
+		_mm_storeu_ps(viewZ, v[2U]);
+		compactGroup(i, 4U, static_cast<std::uint32_t>(_mm_movemask_ps(inside)));
+	}
+#else
+	for (std::uint32_t i = 0U; i < paddedCount; ++i) {
+		float v[3U];
+		for (std::uint32_t j = 0U; j < 3U; ++j) {
+			v[j] = mPosX[i] * view[j] + mPosY[i] * view[4U + j] + mPosZ[i] * view[8U + j] + view[12U + j];
+		}
+
+		bool inside{ mRange[i] >= 0.0f };
+		for (std::uint32_t p = 0U; p < FrustumCuller::sPlaneCount; ++p) {
+			const float* plane{ viewPlanes[p] };
+			const float dist{ plane[0U] * v[0U] + plane[1U] * v[1U] + plane[2U] * v[2U] + plane[3U] };
+			inside = inside && (dist + mRange[i] >= 0.0f);
+		}
+
+		viewX[0U] = v[0U];
+		viewY[0U] = v[1U];
+		viewZ[0U] = v[2U];
+		compactGroup(i, 1U, inside ? 1U : 0U);
+	}
+#endif
+
+	ASSERT(visibleCount <= mLightCount);
+	mVisibleCount = visibleCount;
+}
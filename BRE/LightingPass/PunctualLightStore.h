@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <LightingPass/PunctualLight.h>
+#include <MathUtils/FrustumCuller.h>
+#include <Utils/DebugUtils.h>
+
+// Punctual lights that can be modified every frame (for example, to animate them).
+// World space positions and ranges are stored in SoA layout, so each frame they are
+// transformed to view space and culled against the view frustum 8 (AVX) or 4 (SSE) at a time.
+// Visible lights are compacted in a contiguous array, ready to be uploaded.
+// It does not depend on DirectXMath or D3D, so it can be built on any platform.
+// Steps:
+// - Call Init() with the lights (world space)
+// - Modify them with SetPosition(), SetRange() or SetColorAndPower()
+// - Call Update() each frame, and upload VisibleLights()
+class PunctualLightStore {
+public:
+	PunctualLightStore() = default;
+	~PunctualLightStore() = default;
+	PunctualLightStore(const PunctualLightStore&) = delete;
+	const PunctualLightStore& operator=(const PunctualLightStore&) = delete;
+	PunctualLightStore(PunctualLightStore&&) = default;
+	PunctualLightStore& operator=(PunctualLightStore&&) = default;
+
+	void Init(const PunctualLight* lights, const std::uint32_t count) noexcept;
+
+	void SetPosition(const std::uint32_t index, const float position[3U]) noexcept;
+	void SetRange(const std::uint32_t index, const float range) noexcept;
+	void SetColorAndPower(const std::uint32_t index, const float colorAndPower[4U]) noexcept;
+
+	// view and proj are row major matrices (row vectors, as DirectXMath), with clip space
+	// depth in [0, 1]. Lights whose spheres are outside the view frustum are culled, and
+	// the others are stored in VisibleLights() with their positions in view space.
+	void Update(const float view[16U], const float proj[16U]) noexcept;
+
+	__forceinline std::uint32_t LightCount() const noexcept { return mLightCount; }
+
+	// Results of the last Update(). Visible lights keep their relative order.
+	__forceinline std::uint32_t VisibleLightCount() const noexcept { return mVisibleCount; }
+	__forceinline const PunctualLight* VisibleLights() const noexcept { return mVisibleLights.data(); }
+	__forceinline const std::uint32_t* VisibleLightIndices() const noexcept { return mVisibleIndices.data(); }
+
+private:
+	std::uint32_t mLightCount{ 0U };
+	std::uint32_t mVisibleCount{ 0U };
+
+	// World space positions and ranges, padded to FrustumCuller::sSimdWidth elements
+	std::vector<float> mPosX;
+	std::vector<float> mPosY;
+	std::vector<float> mPosZ;
+	std::vector<float> mRange;
+
+	// 4 floats per light
+	std::vector<float> mColorAndPower;
+
+	// Only used to extract view space frustum planes from the projection
+	FrustumCuller mViewFrustum;
+
+	// They have room for all padded lights, because they are written without branches
+	std::vector<PunctualLight> mVisibleLights;
+	std::vector<std::uint32_t> mVisibleIndices;
+};
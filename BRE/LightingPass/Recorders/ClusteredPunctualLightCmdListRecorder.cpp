@@ -0,0 +1,221 @@
+#include "ClusteredPunctualLightCmdListRecorder.h"
+
+#include <DescriptorManager\DescriptorManager.h>
+#include <PSOCreator/PSOCreator.h>
+#include <ResourceManager/ResourceManager.h>
+#include <ResourceManager/UploadBuffer.h>
+#include <ShaderUtils\CBuffers.h>
+#include <Utils/DebugUtils.h>
+#include <Utils/Profiler.h>
+#include <Utils/RenderStats.h>
+
+// Root Signature:
+// "CBV(b0, visibility = SHADER_VISIBILITY_VERTEX), " \ 0 -> Frame CBuffer
+// "CBV(b0, visibility = SHADER_VISIBILITY_PIXEL), " \ 1 -> Frame CBuffer
+// "RootConstants(num32BitConstants = 4, b1, visibility = SHADER_VISIBILITY_PIXEL), " \ 2 -> Cluster params
+// "SRV(t0, visibility = SHADER_VISIBILITY_PIXEL), " \ 3 -> Visible lights buffer (view space)
+// "SRV(t1, visibility = SHADER_VISIBILITY_PIXEL), " \ 4 -> Cluster ranges buffer
+// "SRV(t2, visibility = SHADER_VISIBILITY_PIXEL), " \ 5 -> Light indices buffer
+// "DescriptorTable(SRV(t3), SRV(t4), SRV(t5), visibility = SHADER_VISIBILITY_PIXEL)" 6 -> Textures
+
+namespace {
+	ID3D12PipelineState* sPSO{ nullptr };
+	ID3D12RootSignature* sRootSign{ nullptr };
+}
+
+ClusteredPunctualLightCmdListRecorder::ClusteredPunctualLightCmdListRecorder(ID3D12Device& device)
+	: LightingPassCmdListRecorder(device)
+{
+}
+
+void ClusteredPunctualLightCmdListRecorder::InitPSO() noexcept {
+	ASSERT(sPSO == nullptr);
+	ASSERT(sRootSign == nullptr);
+
+	// Build pso and root signature
+	PSOCreator::PSOParams psoParams{};
+	const std::size_t rtCount{ _countof(psoParams.mRtFormats) };
+	psoParams.mBlendDesc = D3DFactory::AlwaysBlendDesc();
+	psoParams.mDepthStencilDesc = D3DFactory::DisableDepthStencilDesc();
+	psoParams.mPSFilename = "LightingPass/Shaders/ClusteredPunctualLight/PS.cso";
+	psoParams.mRootSignFilename = "LightingPass/Shaders/ClusteredPunctualLight/RS.cso";
+	psoParams.mVSFilename = "LightingPass/Shaders/ClusteredPunctualLight/VS.cso";
+	psoParams.mNumRenderTargets = 1U;
+	psoParams.mRtFormats[0U] = Settings::sColorBufferFormat;
+	for (std::size_t i = psoParams.mNumRenderTargets; i < rtCount; ++i) {
+		psoParams.mRtFormats[i] = DXGI_FORMAT_UNKNOWN;
+	}
+	psoParams.mTopology = D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE;
+	PSOCreator::CreatePSO(psoParams, sPSO, sRootSign);
+
+	ASSERT(sPSO != nullptr);
+	ASSERT(sRootSign != nullptr);
+}
+
+void ClusteredPunctualLightCmdListRecorder::Init(
+	Microsoft::WRL::ComPtr<ID3D12Resource>* geometryBuffers,
+	const std::uint32_t geometryBuffersCount,
+	ID3D12Resource& depthBuffer,
+	const void* lights,
+	const std::uint32_t numLights) noexcept
+{
+	ASSERT(ValidateData() == false);
+	ASSERT(geometryBuffers != nullptr);
+	ASSERT(0 < geometryBuffersCount && geometryBuffersCount < D3D12_SIMULTANEOUS_RENDER_TARGET_COUNT);
+	ASSERT(lights != nullptr);
+	ASSERT(numLights > 0U);
+
+	mNumLights = numLights;
+	mLightStore.Init(static_cast<const PunctualLight*>(lights), numLights);
+
+	BuildBuffers();
+
+	// Used to create SRV descriptors for textures (geometry buffers + depth buffer)
+	std::vector<D3D12_SHADER_RESOURCE_VIEW_DESC> srvDescVec;
+	srvDescVec.resize(geometryBuffersCount + 1U); // 1 = depth buffer
+	std::vector<ID3D12Resource*> res;
+	res.resize(geometryBuffersCount + 1U);
+
+	// Fill data for geometry buffers SRV descriptors
+	for (std::uint32_t i = 0U; i < geometryBuffersCount; ++i) {
+		res[i] = geometryBuffers[i].Get();
+
+		srvDescVec[i].Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+		srvDescVec[i].ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
+		srvDescVec[i].Texture2D.MostDetailedMip = 0;
+		srvDescVec[i].Texture2D.ResourceMinLODClamp = 0.0f;
+		srvDescVec[i].Format = res[i]->GetDesc().Format;
+		srvDescVec[i].Texture2D.MipLevels = res[i]->GetDesc().MipLevels;
+	}
+
+	// Fill depth buffer SRV description
+	const std::uint32_t resIndex = geometryBuffersCount;
+	srvDescVec[resIndex].Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+	srvDescVec[resIndex].ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
+	srvDescVec[resIndex].Texture2D.MostDetailedMip = 0;
+	srvDescVec[resIndex].Texture2D.ResourceMinLODClamp = 0.0f;
+	srvDescVec[resIndex].Format = Settings::sDepthStencilSRVFormat;
+	srvDescVec[resIndex].Texture2D.MipLevels = depthBuffer.GetDesc().MipLevels;
+	res[resIndex] = &depthBuffer;
+
+	// Create textures SRV descriptors
+	mTexturesGpuDescHandle = DescriptorManager::Get().CreateShaderResourceView(res.data(), srvDescVec.data(), static_cast<uint32_t>(srvDescVec.size()));
+
+	ASSERT(ValidateData());
+}
+
+void ClusteredPunctualLightCmdListRecorder::RecordAndPushCommandLists(const FrameCBuffer& frameCBuffer) noexcept {
+	PROFILE_ZONE("ClusteredPunctualLightCmdListRecorder::RecordAndPushCommandLists");
+
+	ASSERT(ValidateData());
+	ASSERT(sPSO != nullptr);
+	ASSERT(sRootSign != nullptr);
+	ASSERT(mCmdListQueue != nullptr);
+	ASSERT(mColorBufferCpuDesc.ptr != 0UL);
+	ASSERT(mDepthBufferCpuDesc.ptr != 0UL);
+
+	ID3D12CommandAllocator* cmdAlloc{ mCmdAlloc[mCurrFrameIndex] };
+	ASSERT(cmdAlloc != nullptr);
+
+	// Update frame constants
+	UploadBuffer& uploadFrameCBuffer(*mFrameCBuffer[mCurrFrameIndex]);
+	uploadFrameCBuffer.CopyData(0U, &frameCBuffer, sizeof(frameCBuffer));
+
+	// Transform lights to view space and cull them
+	UpdateLightStore(frameCBuffer);
+	const std::uint32_t visibleLightCount{ mLightStore.VisibleLightCount() };
+
+	// Assign visible lights to clusters. Projection diagonal is not affected by transposition.
+	mLightCuller.SetProjection(Settings::sNearPlaneZ, Settings::sFarPlaneZ, frameCBuffer.mProj._11, frameCBuffer.mProj._22);
+	mLightCuller.Build(mLightStore.VisibleLights(), visibleLightCount, sizeof(PunctualLight));
+
+	// Upload lights and clusters
+	if (visibleLightCount != 0U) {
+		mViewLightsBuffer[mCurrFrameIndex]->CopyData(0U, mLightStore.VisibleLights(), sizeof(PunctualLight) * visibleLightCount);
+	}
+	const std::vector<std::uint32_t>& clusterRanges(mLightCuller.ClusterRanges());
+	mClusterRangesBuffer[mCurrFrameIndex]->CopyData(0U, clusterRanges.data(), sizeof(std::uint32_t) * clusterRanges.size());
+	const std::vector<std::uint32_t>& lightIndices(mLightCuller.LightIndices());
+	if (lightIndices.empty() == false) {
+		mLightIndicesBuffer[mCurrFrameIndex]->CopyData(0U, lightIndices.data(), sizeof(std::uint32_t) * lightIndices.size());
+	}
+
+	const float clusterParams[4U]{
+		mLightCuller.DepthSliceScale(),
+		mLightCuller.DepthSliceBias(),
+		static_cast<float>(ClusteredLightCuller::sClusterCountX) / Settings::sWindowWidth,
+		static_cast<float>(ClusteredLightCuller::sClusterCountY) / Settings::sWindowHeight
+	};
+
+	CHECK_HR(cmdAlloc->Reset());
+	RENDER_STATS_ADD(PIPELINE_STATE_CHANGES, 1UL);
+	CHECK_HR(mCmdList->Reset(cmdAlloc, sPSO));
+
+	mCmdList->RSSetViewports(1U, &Settings::sScreenViewport);
+	mCmdList->RSSetScissorRects(1U, &Settings::sScissorRect);
+	mCmdList->OMSetRenderTargets(1U, &mColorBufferCpuDesc, false, &mDepthBufferCpuDesc);
+
+	ID3D12DescriptorHeap* heaps[] = { &DescriptorManager::Get().GetCbvSrcUavDescriptorHeap() };
+	mCmdList->SetDescriptorHeaps(_countof(heaps), heaps);
+	RENDER_STATS_ADD(ROOT_SIGNATURE_CHANGES, 1UL);
+	mCmdList->SetGraphicsRootSignature(sRootSign);
+
+	// Set root parameters
+	const D3D12_GPU_VIRTUAL_ADDRESS frameCBufferGpuVAddress(uploadFrameCBuffer.Resource()->GetGPUVirtualAddress());
+	mCmdList->SetGraphicsRootConstantBufferView(0U, frameCBufferGpuVAddress);
+	mCmdList->SetGraphicsRootConstantBufferView(1U, frameCBufferGpuVAddress);
+	mCmdList->SetGraphicsRoot32BitConstants(2U, _countof(clusterParams), clusterParams, 0U);
+	mCmdList->SetGraphicsRootShaderResourceView(3U, mViewLightsBuffer[mCurrFrameIndex]->Resource()->GetGPUVirtualAddress());
+	mCmdList->SetGraphicsRootShaderResourceView(4U, mClusterRangesBuffer[mCurrFrameIndex]->Resource()->GetGPUVirtualAddress());
+	mCmdList->SetGraphicsRootShaderResourceView(5U, mLightIndicesBuffer[mCurrFrameIndex]->Resource()->GetGPUVirtualAddress());
+	RENDER_STATS_ADD(DESCRIPTOR_TABLES, 1UL);
+	mCmdList->SetGraphicsRootDescriptorTable(6U, mTexturesGpuDescHandle);
+
+	// Full screen triangle (vertices are generated in the vertex shader)
+	mCmdList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+	RENDER_STATS_DRAW(3U, 1U);
+	mCmdList->DrawInstanced(3U, 1U, 0U, 0U);
+
+	mCmdList->Close();
+
+	mCmdListQueue->push(mCmdList);
+
+	// Next frame
+	mCurrFrameIndex = (mCurrFrameIndex + 1) % _countof(mCmdAlloc);
+}
+
+bool ClusteredPunctualLightCmdListRecorder::ValidateData() const noexcept {
+	for (std::uint32_t i = 0UL; i < Settings::sQueuedFrameCount; ++i) {
+		if (mViewLightsBuffer[i] == nullptr || mClusterRangesBuffer[i] == nullptr || mLightIndicesBuffer[i] == nullptr) {
+			return false;
+		}
+	}
+
+	return
+		LightingPassCmdListRecorder::ValidateData() &&
+		mTexturesGpuDescHandle.ptr != 0UL;
+}
+
+void ClusteredPunctualLightCmdListRecorder::BuildBuffers() noexcept {
+	ASSERT(mNumLights != 0U);
+
+	// A cluster never has more than sMaxLightsPerCluster lights
+	const std::uint32_t maxLightsPerCluster{ mNumLights < ClusteredLightCuller::sMaxLightsPerCluster ? mNumLights : ClusteredLightCuller::sMaxLightsPerCluster };
+	const std::uint32_t maxLightIndexCount{ ClusteredLightCuller::sClusterCount * maxLightsPerCluster };
+
+	// Create per frame buffers (structured buffers elements are tightly packed)
+	const std::size_t frameCBufferElemSize{ UploadBuffer::CalcConstantBufferByteSize(sizeof(FrameCBuffer)) };
+	for (std::uint32_t i = 0U; i < Settings::sQueuedFrameCount; ++i) {
+		ASSERT(mFrameCBuffer[i] == nullptr);
+		ResourceManager::Get().CreateUploadBuffer(frameCBufferElemSize, 1U, mFrameCBuffer[i]);
+
+		ASSERT(mViewLightsBuffer[i] == nullptr);
+		ResourceManager::Get().CreateUploadBuffer(sizeof(PunctualLight), mNumLights, mViewLightsBuffer[i]);
+
+		ASSERT(mClusterRangesBuffer[i] == nullptr);
+		ResourceManager::Get().CreateUploadBuffer(sizeof(std::uint32_t) * 2UL, ClusteredLightCuller::sClusterCount, mClusterRangesBuffer[i]);
+
+		ASSERT(mLightIndicesBuffer[i] == nullptr);
+		ResourceManager::Get().CreateUploadBuffer(sizeof(std::uint32_t), maxLightIndexCount, mLightIndicesBuffer[i]);
+	}
+}
\ No newline at end of file
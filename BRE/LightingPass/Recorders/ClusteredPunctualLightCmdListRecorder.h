@@ -0,0 +1,54 @@
+#pragma once
+
+#include <LightingPass/LightingPassCmdListRecorder.h>
+#include <MathUtils/ClusteredLightCuller.h>
+
+// Shades all punctual lights in a single full screen pass.
+// Each frame, lights are transformed to view space and culled in the CPU (PunctualLightStore),
+// and visible lights are assigned to view frustum clusters (ClusteredLightCuller), and each pixel only iterates the lights of its cluster.
+// Unlike PunctualLightCmdListRecorder, geometry buffers are read once per pixel, no matter
+// how many lights overlap it.
+class ClusteredPunctualLightCmdListRecorder : public LightingPassCmdListRecorder {
+public:
+	explicit ClusteredPunctualLightCmdListRecorder(ID3D12Device& device);
+
+	~ClusteredPunctualLightCmdListRecorder() = default;
+	ClusteredPunctualLightCmdListRecorder(const ClusteredPunctualLightCmdListRecorder&) = delete;
+	const ClusteredPunctualLightCmdListRecorder& operator=(const ClusteredPunctualLightCmdListRecorder&) = delete;
+	ClusteredPunctualLightCmdListRecorder(ClusteredPunctualLightCmdListRecorder&&) = default;
+	ClusteredPunctualLightCmdListRecorder& operator=(ClusteredPunctualLightCmdListRecorder&&) = default;
+
+	// This method is to initialize PSO that is a shared between all this kind
+	// of recorders.
+	// This method is initialized by its corresponding pass.
+	static void InitPSO() noexcept;
+
+	// This method must be called before RecordAndPushCommandLists()
+	void Init(
+		Microsoft::WRL::ComPtr<ID3D12Resource>* geometryBuffers,
+		const std::uint32_t geometryBuffersCount,
+		ID3D12Resource& depthBuffer,
+		const void* lights,
+		const std::uint32_t numLights) noexcept final override;
+
+	// Record command lists and push them to the queue.
+	void RecordAndPushCommandLists(const FrameCBuffer& frameCBuffer) noexcept final override;
+
+	bool ValidateData() const noexcept override;
+
+	// Light indices count of the last recorded frame
+	__forceinline std::uint32_t LightIndexCount() const noexcept { return static_cast<std::uint32_t>(mLightCuller.LightIndices().size()); }
+
+private:
+	void BuildBuffers() noexcept;
+
+	ClusteredLightCuller mLightCuller;
+
+	// Structured buffers per queued frame: visible view space lights (PunctualLight),
+	// clusters ranges (2 uint32) and light indices (uint32)
+	UploadBuffer* mViewLightsBuffer[Settings::sQueuedFrameCount]{ nullptr };
+	UploadBuffer* mClusterRangesBuffer[Settings::sQueuedFrameCount]{ nullptr };
+	UploadBuffer* mLightIndicesBuffer[Settings::sQueuedFrameCount]{ nullptr };
+
+	D3D12_GPU_DESCRIPTOR_HANDLE mTexturesGpuDescHandle{ 0UL };
+};
\ No newline at end of file
@@ -10,14 +10,15 @@
 #include <ResourceManager/UploadBuffer.h>
 #include <ShaderUtils\CBuffers.h>
 #include <Utils/DebugUtils.h>
+#include <Utils/Profiler.h>
+#include <Utils/RenderStats.h>
 
 // Root Signature:
-// "CBV(b0, visibility = SHADER_VISIBILITY_VERTEX), " \ 0 -> Frame CBuffer
-// "DescriptorTable(SRV(t0), visibility = SHADER_VISIBILITY_VERTEX), " \ 1 -> Lights Buffer
-// "CBV(b0, visibility = SHADER_VISIBILITY_GEOMETRY), " \ 2 -> Frame CBuffer
-// "CBV(b1, visibility = SHADER_VISIBILITY_GEOMETRY), " \ 3 -> Immutable CBuffer
-// "CBV(b0, visibility = SHADER_VISIBILITY_PIXEL), " \ 4 -> Frame CBuffer
-// "DescriptorTable(SRV(t0), SRV(t1), SRV(t2), visibility = SHADER_VISIBILITY_PIXEL)" 5 -> Textures
+// "SRV(t0, visibility = SHADER_VISIBILITY_VERTEX), " \ 0 -> View space lights buffer
+// "CBV(b0, visibility = SHADER_VISIBILITY_GEOMETRY), " \ 1 -> Frame CBuffer
+// "CBV(b1, visibility = SHADER_VISIBILITY_GEOMETRY), " \ 2 -> Immutable CBuffer
+// "CBV(b0, visibility = SHADER_VISIBILITY_PIXEL), " \ 3 -> Frame CBuffer
+// "DescriptorTable(SRV(t0), SRV(t1), SRV(t2), visibility = SHADER_VISIBILITY_PIXEL)" 4 -> Textures
 
 namespace {
 	ID3D12PipelineState* sPSO{ nullptr };
@@ -68,10 +69,10 @@ void PunctualLightCmdListRecorder::Init(
 	ASSERT(numLights > 0U);
 	
 	mNumLights = numLights;
+	mLightStore.Init(static_cast<const PunctualLight*>(lights), numLights);
 
-	BuildBuffers(lights);
+	BuildBuffers();
 
-	
 	// Used to create SRV descriptors for textures (geometry buffers + depth buffer)
 	std::vector<D3D12_SHADER_RESOURCE_VIEW_DESC> srvDescVec;
 	srvDescVec.resize(geometryBuffersCount + 1U); // 1 = depth buffer
@@ -103,20 +104,12 @@ void PunctualLightCmdListRecorder::Init(
 	// Create textures SRV descriptors
 	mTexturesGpuDescHandle = DescriptorManager::Get().CreateShaderResourceView(res.data(), srvDescVec.data(), static_cast<uint32_t>(srvDescVec.size()));
 
-	// Create lights buffer SRV	descriptor
-	D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc{};
-	srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
-	srvDesc.Format = mLightsBuffer->Resource()->GetDesc().Format;
-	srvDesc.ViewDimension = D3D12_SRV_DIMENSION_BUFFER;
-	srvDesc.Buffer.FirstElement = 0UL;
-	srvDesc.Buffer.NumElements = mNumLights;
-	srvDesc.Buffer.StructureByteStride = sizeof(PunctualLight);
-	mLightsBufferGpuDescHandleBegin = DescriptorManager::Get().CreateShaderResourceView(*mLightsBuffer->Resource(), srvDesc);
-	
 	ASSERT(ValidateData());
 }
 
 void PunctualLightCmdListRecorder::RecordAndPushCommandLists(const FrameCBuffer& frameCBuffer) noexcept {
+	PROFILE_ZONE("PunctualLightCmdListRecorder::RecordAndPushCommandLists");
+
 	ASSERT(ValidateData());
 	ASSERT(sPSO != nullptr);
 	ASSERT(sRootSign != nullptr);
@@ -131,7 +124,16 @@ void PunctualLightCmdListRecorder::RecordAndPushCommandLists(const FrameCBuffer&
 	UploadBuffer& uploadFrameCBuffer(*mFrameCBuffer[mCurrFrameIndex]);
 	uploadFrameCBuffer.CopyData(0U, &frameCBuffer, sizeof(frameCBuffer));
 
+	// Cull lights and upload the visible ones (they are already in view space)
+	UpdateLightStore(frameCBuffer);
+	const std::uint32_t visibleLightCount{ mLightStore.VisibleLightCount() };
+	UploadBuffer& uploadLightsBuffer(*mLightsBuffer[mCurrFrameIndex]);
+	if (visibleLightCount != 0U) {
+		uploadLightsBuffer.CopyData(0U, mLightStore.VisibleLights(), sizeof(PunctualLight) * visibleLightCount);
+	}
+
 	CHECK_HR(cmdAlloc->Reset());
+	RENDER_STATS_ADD(PIPELINE_STATE_CHANGES, 1UL);
 	CHECK_HR(mCmdList->Reset(cmdAlloc, sPSO));
 
 	mCmdList->RSSetViewports(1U, &Settings::sScreenViewport);
@@ -140,21 +142,26 @@ void PunctualLightCmdListRecorder::RecordAndPushCommandLists(const FrameCBuffer&
 
 	ID3D12DescriptorHeap* heaps[] = { &DescriptorManager::Get().GetCbvSrcUavDescriptorHeap() };
 	mCmdList->SetDescriptorHeaps(_countof(heaps), heaps);
+	RENDER_STATS_ADD(ROOT_SIGNATURE_CHANGES, 1UL);
 	mCmdList->SetGraphicsRootSignature(sRootSign);
 
 	// Set root parameters
 	const D3D12_GPU_VIRTUAL_ADDRESS frameCBufferGpuVAddress(uploadFrameCBuffer.Resource()->GetGPUVirtualAddress());
 	const D3D12_GPU_VIRTUAL_ADDRESS immutableCBufferGpuVAddress(mImmutableCBuffer->Resource()->GetGPUVirtualAddress());
-	mCmdList->SetGraphicsRootConstantBufferView(0U, frameCBufferGpuVAddress);
-	mCmdList->SetGraphicsRootDescriptorTable(1U, mLightsBufferGpuDescHandleBegin);
-	mCmdList->SetGraphicsRootConstantBufferView(2U, frameCBufferGpuVAddress);
-	mCmdList->SetGraphicsRootConstantBufferView(3U, immutableCBufferGpuVAddress);
-	mCmdList->SetGraphicsRootConstantBufferView(4U, frameCBufferGpuVAddress);
-	mCmdList->SetGraphicsRootDescriptorTable(5U, mTexturesGpuDescHandle);
+	mCmdList->SetGraphicsRootShaderResourceView(0U, uploadLightsBuffer.Resource()->GetGPUVirtualAddress());
+	mCmdList->SetGraphicsRootConstantBufferView(1U, frameCBufferGpuVAddress);
+	mCmdList->SetGraphicsRootConstantBufferView(2U, immutableCBufferGpuVAddress);
+	mCmdList->SetGraphicsRootConstantBufferView(3U, frameCBufferGpuVAddress);
+	RENDER_STATS_ADD(DESCRIPTOR_TABLES, 1UL);
+	mCmdList->SetGraphicsRootDescriptorTable(4U, mTexturesGpuDescHandle);
 	
 	mCmdList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_POINTLIST);
-	
-	mCmdList->DrawInstanced(mNumLights, 1U, 0U, 0U);
+
+	// Command list is pushed anyway, even if there is nothing to draw
+	if (visibleLightCount != 0U) {
+		RENDER_STATS_DRAW(visibleLightCount, 1U);
+		mCmdList->DrawInstanced(visibleLightCount, 1U, 0U, 0U);
+	}
 
 	mCmdList->Close();
 
@@ -165,31 +172,30 @@ void PunctualLightCmdListRecorder::RecordAndPushCommandLists(const FrameCBuffer&
 }
 
 bool PunctualLightCmdListRecorder::ValidateData() const noexcept {
-	return LightingPassCmdListRecorder::ValidateData() && mTexturesGpuDescHandle.ptr != 0UL;
+	for (std::uint32_t i = 0UL; i < Settings::sQueuedFrameCount; ++i) {
+		if (mLightsBuffer[i] == nullptr) {
+			return false;
+		}
+	}
+
+	return
+		LightingPassCmdListRecorder::ValidateData() &&
+		mImmutableCBuffer != nullptr &&
+		mTexturesGpuDescHandle.ptr != 0UL;
 }
 
-void PunctualLightCmdListRecorder::BuildBuffers(const void* lights) noexcept {
-#ifdef _DEBUG
-	for (std::uint32_t i = 0U; i < Settings::sQueuedFrameCount; ++i) {
-		ASSERT(mFrameCBuffer[i] == nullptr);
-	}
-#endif
-	ASSERT(mLightsBuffer == nullptr);
-	ASSERT(lights != nullptr);
+void PunctualLightCmdListRecorder::BuildBuffers() noexcept {
 	ASSERT(mNumLights != 0U);
 
-	// Create lights buffer and fill it
-	const std::size_t lightBufferElemSize{ sizeof(PunctualLight) };
-	ResourceManager::Get().CreateUploadBuffer(lightBufferElemSize, mNumLights, mLightsBuffer);
-	const std::uint8_t* lightsPtr = reinterpret_cast<const std::uint8_t*>(lights);
-	for (std::uint32_t i = 0UL; i < mNumLights; ++i) {
-		mLightsBuffer->CopyData(i, lightsPtr + sizeof(PunctualLight) * i, sizeof(PunctualLight));
-	}
-
-	// Create frame cbuffers
+	// Create per frame buffers. Lights buffers have room for all lights, even if
+	// only visible ones are uploaded.
 	const std::size_t frameCBufferElemSize{ UploadBuffer::CalcConstantBufferByteSize(sizeof(FrameCBuffer)) };
 	for (std::uint32_t i = 0U; i < Settings::sQueuedFrameCount; ++i) {
+		ASSERT(mFrameCBuffer[i] == nullptr);
 		ResourceManager::Get().CreateUploadBuffer(frameCBufferElemSize, 1U, mFrameCBuffer[i]);
+
+		ASSERT(mLightsBuffer[i] == nullptr);
+		ResourceManager::Get().CreateUploadBuffer(sizeof(PunctualLight), mNumLights, mLightsBuffer[i]);
 	}
 
 	// Create immutable cbuffer
@@ -2,6 +2,8 @@
 
 #include <LightingPass/LightingPassCmdListRecorder.h>
 
+// Each frame, lights are transformed to view space and culled in the CPU (PunctualLightStore),
+// and only visible lights are uploaded and drawn.
 class PunctualLightCmdListRecorder : public LightingPassCmdListRecorder {
 public:
 	explicit PunctualLightCmdListRecorder(ID3D12Device& device);
@@ -31,7 +33,10 @@ public:
 	bool ValidateData() const noexcept override;
 
 private:
-	void BuildBuffers(const void* lights) noexcept;
+	void BuildBuffers() noexcept;
+
+	// Visible lights (PunctualLight structured buffer) per queued frame
+	UploadBuffer* mLightsBuffer[Settings::sQueuedFrameCount]{ nullptr };
 
 	D3D12_GPU_DESCRIPTOR_HANDLE mTexturesGpuDescHandle{ 0UL };
 };
\ No newline at end of file
@@ -0,0 +1,85 @@
+#include <ShaderUtils/CBuffers.hlsli>
+#include <ShaderUtils/Lighting.hlsli>
+#include <ShaderUtils/Lights.hlsli>
+#include <ShaderUtils/Utils.hlsli>
+
+// They must match ClusteredLightCuller cluster counts
+#define CLUSTER_COUNT_X (16U)
+#define CLUSTER_COUNT_Y (9U)
+#define CLUSTER_COUNT_Z (24U)
+
+struct Input {
+	float4 mPosH : SV_POSITION;
+	float3 mViewRayV : VIEW_RAY;
+};
+
+ConstantBuffer<FrameCBuffer> gFrameCBuffer : register(b0);
+ConstantBuffer<ClusterParams> gClusterParams : register(b1);
+
+// View space lights
+StructuredBuffer<PunctualLight> gPunctualLights : register(t0);
+
+// Offset in light indices and lights count, per cluster
+StructuredBuffer<uint2> gClusterRanges : register(t1);
+StructuredBuffer<uint> gLightIndices : register(t2);
+
+Texture2D<float4> Normal_Smoothness : register (t3);
+Texture2D<float4> BaseColor_MetalMask : register (t4);
+Texture2D<float> Depth : register (t5);
+
+struct Output {
+	float4 mColor : SV_Target0;
+};
+
+Output main(const in Input input) {
+	Output output = (Output)0;
+
+	const int3 screenCoord = int3(input.mPosH.xy, 0);
+
+	const float4 normal_smoothness = Normal_Smoothness.Load(screenCoord);
+
+	// Sample the depth and convert to linear view space Z (assume it gets sampled as
+	// a floating point value of the range [0,1])
+	const float depth = Depth.Load(screenCoord);
+	const float depthV = NdcDepthToViewDepth(depth, gFrameCBuffer.mP);
+
+	//
+	// Reconstruct full view space position (x,y,z).
+	// Find t such that p = t * ViewRayV.
+	// p.z = t * ViewRayV.z
+	// t = p.z / ViewRayV.z
+	//
+	const float3 geomPosV = (depthV / input.mViewRayV.z) * input.mViewRayV;
+
+	// Get pixel cluster
+	const float4 clusterParams = gClusterParams.mDepthSliceScale_Bias_TileScaleX_TileScaleY;
+	const uint slice = (uint)clamp(floor(log(geomPosV.z) * clusterParams.x + clusterParams.y), 0.0f, CLUSTER_COUNT_Z - 1.0f);
+	const uint2 tile = min(uint2(input.mPosH.xy * clusterParams.zw), uint2(CLUSTER_COUNT_X - 1U, CLUSTER_COUNT_Y - 1U));
+	const uint2 clusterRange = gClusterRanges[(slice * CLUSTER_COUNT_Y + tile.y) * CLUSTER_COUNT_X + tile.x];
+
+	// Get normal
+	const float2 normal = normal_smoothness.xy;
+	const float3 normalV = normalize(Decode(normal));
+
+	const float4 baseColor_metalmask = BaseColor_MetalMask.Load(screenCoord);
+	const float smoothness = normal_smoothness.z;
+
+	// As we are working at view space, we do not need camera position to 
+	// compute vector from geometry position to camera.
+	const float3 viewV = normalize(-geomPosV);
+
+	const float3 fDiffuse = DiffuseBrdf(baseColor_metalmask.xyz, baseColor_metalmask.w);
+
+	float3 color = float3(0.0f, 0.0f, 0.0f);
+	for (uint i = 0U; i < clusterRange.y; ++i) {
+		const PunctualLight light = gPunctualLights[gLightIndices[clusterRange.x + i]];
+		const float3 lightDirV = normalize(light.mLightPosVAndRange.xyz - geomPosV);
+		const float3 lightContrib = computePunctualLightFrostbiteLightContribution(light, geomPosV, normalV);
+		const float3 fSpecular = SpecularBrdf(normalV, viewV, lightDirV, baseColor_metalmask.xyz, smoothness, baseColor_metalmask.w);
+		color += lightContrib * (fDiffuse + fSpecular);
+	}
+
+	output.mColor = float4(color, 1.0f);
+
+	return output;
+}
\ No newline at end of file
@@ -0,0 +1,11 @@
+#define RS \
+"RootFlags(DENY_HULL_SHADER_ROOT_ACCESS | " \
+"DENY_DOMAIN_SHADER_ROOT_ACCESS | " \
+"DENY_GEOMETRY_SHADER_ROOT_ACCESS), " \
+"CBV(b0, visibility = SHADER_VISIBILITY_VERTEX), " \
+"CBV(b0, visibility = SHADER_VISIBILITY_PIXEL), " \
+"RootConstants(num32BitConstants = 4, b1, visibility = SHADER_VISIBILITY_PIXEL), " \
+"SRV(t0, visibility = SHADER_VISIBILITY_PIXEL), " \
+"SRV(t1, visibility = SHADER_VISIBILITY_PIXEL), " \
+"SRV(t2, visibility = SHADER_VISIBILITY_PIXEL), " \
+"DescriptorTable(SRV(t3), SRV(t4), SRV(t5), visibility = SHADER_VISIBILITY_PIXEL)"
\ No newline at end of file
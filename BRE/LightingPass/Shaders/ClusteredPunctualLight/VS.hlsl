@@ -0,0 +1,25 @@
+#include <ShaderUtils/CBuffers.hlsli>
+
+struct Input {
+	uint mVertexId : SV_VertexID;
+};
+
+ConstantBuffer<FrameCBuffer> gFrameCBuffer : register(b0);
+
+struct Output {
+	float4 mPosH : SV_POSITION;
+	float3 mViewRayV : VIEW_RAY;
+};
+
+// Full screen triangle, without vertex buffer
+Output main(in const Input input) {
+	Output output;
+
+	// Vertices are (-1, 1), (3, 1) and (-1, -3) in NDC
+	const float2 texCoord = float2((input.mVertexId << 1U) & 2U, input.mVertexId & 2U);
+	output.mPosH = float4(texCoord * float2(2.0f, -2.0f) + float2(-1.0f, 1.0f), 0.0f, 1.0f);
+	const float4 ph = mul(output.mPosH, gFrameCBuffer.mInvP);
+	output.mViewRayV = ph.xyz / ph.w;
+
+	return output;
+}
\ No newline at end of file
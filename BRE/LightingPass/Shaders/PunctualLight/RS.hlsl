@@ -2,8 +2,7 @@
 "RootFlags(ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT | " \
 "DENY_HULL_SHADER_ROOT_ACCESS | " \
 "DENY_DOMAIN_SHADER_ROOT_ACCESS), " \
-"CBV(b0, visibility = SHADER_VISIBILITY_VERTEX), " \
-"DescriptorTable(SRV(t0), visibility = SHADER_VISIBILITY_VERTEX), " \
+"SRV(t0, visibility = SHADER_VISIBILITY_VERTEX), " \
 "CBV(b0, visibility = SHADER_VISIBILITY_GEOMETRY), " \
 "CBV(b1, visibility = SHADER_VISIBILITY_GEOMETRY), " \
 "CBV(b0, visibility = SHADER_VISIBILITY_PIXEL), " \
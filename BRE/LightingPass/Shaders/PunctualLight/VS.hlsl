@@ -1,12 +1,10 @@
-#include <ShaderUtils/CBuffers.hlsli>
 #include <ShaderUtils/Lights.hlsli>
 
 struct Input {
 	uint mVertexId : SV_VertexID;
 };
 
-ConstantBuffer<FrameCBuffer> gFrameCBuffer : register(b0);
-
+// Visible lights, already in view space
 StructuredBuffer<PunctualLight> gPunctualLights : register(t0);
 
 struct Output {
@@ -14,14 +12,8 @@ struct Output {
 };
 
 Output main(in const Input input) {
-	PunctualLight l = gPunctualLights[input.mVertexId];
-
-	float4 lightPosV = float4(l.mLightPosVAndRange.xyz, 1.0f);
-	lightPosV = mul(lightPosV, gFrameCBuffer.mV);
-
 	Output output = (Output)0;
-	output.mPunctualLight.mLightPosVAndRange = float4(lightPosV.xyz, l.mLightPosVAndRange.w);
-	output.mPunctualLight.mLightColorAndPower = l.mLightColorAndPower;
+	output.mPunctualLight = gPunctualLights[input.mVertexId];
 	return output;
 }
 
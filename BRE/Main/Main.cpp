@@ -1,3 +1,6 @@
+#include <sstream>
+#include <string>
+#include <utility>
 #include <windows.h>
 
 #include <App/App.h>
@@ -9,10 +12,78 @@
 #include <ExampleScenes\NormalScene.h>
 #include <ExampleScenes\MaterialShowcaseScene.h>
 #include <ExampleScenes\TextureScene.h>
+#include <Utils/DebugUtils.h>
 
-int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE /*hPrevInstance*/, _In_ LPSTR /*lpCmdLine*/, _In_ int /*nShowCmd*/) {
-	AmbientOcclussionScene scene;
-	App app(hInstance, &scene);
+namespace {
+	// Command line arguments:
+	// -scene <name>: scene to run (see SceneByName()). Ambient occlusion scene is run by default.
+	// -record <camera path file>: the camera path of the session is recorded to the file.
+	// -benchmark <camera path file> <frame count> <report file>: the camera path is played back 
+	// for frame count frames, and a JSON report is written. Application quits when it finished.
+	// To benchmark all scenes, run the application once per scene with the same camera path.
+	struct Arguments {
+		std::string mSceneName;
+		std::string mCameraPathFilename;
+		std::string mReportFilename;
+		MasterRender::RunMode mRunMode;
+	};
+
+	void ParseArguments(const char* cmdLine, Arguments& arguments) noexcept {
+		ASSERT(cmdLine != nullptr);
+
+		std::istringstream stream{ cmdLine };
+		std::string argument;
+		while (stream >> argument) {
+			if (argument == "-scene") {
+				stream >> arguments.mSceneName;
+			}
+			else if (argument == "-record") {
+				stream >> arguments.mCameraPathFilename;
+				arguments.mRunMode.mType = MasterRender::RunMode::RECORD_CAMERA_PATH;
+			}
+			else if (argument == "-benchmark") {
+				stream >> arguments.mCameraPathFilename >> arguments.mRunMode.mBenchmarkFrameCount >> arguments.mReportFilename;
+				arguments.mRunMode.mType = MasterRender::RunMode::BENCHMARK;
+			}
+		}
+
+		// Strings are not modified after this point
+		arguments.mRunMode.mCameraPathFilename = arguments.mCameraPathFilename.empty() ? nullptr : arguments.mCameraPathFilename.c_str();
+		arguments.mRunMode.mReportFilename = arguments.mReportFilename.empty() ? nullptr : arguments.mReportFilename.c_str();
+	}
+}
+
+int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE /*hPrevInstance*/, _In_ LPSTR lpCmdLine, _In_ int /*nShowCmd*/) {
+	Arguments arguments;
+	ParseArguments(lpCmdLine, arguments);
+
+	AmbientOcclussionScene ambientOcclusionScene;
+	ColorHeightScene colorHeightScene;
+	ColorMappingScene colorMappingScene;
+	ColorNormalScene colorNormalScene;
+	HeightScene heightScene;
+	MaterialShowcaseScene materialShowcaseScene;
+	NormalScene normalScene;
+	TextureScene textureScene;
+	const std::pair<const char*, Scene*> sceneByName[]{
+		{ "AmbientOcclusion", &ambientOcclusionScene },
+		{ "ColorHeight", &colorHeightScene },
+		{ "ColorMapping", &colorMappingScene },
+		{ "ColorNormal", &colorNormalScene },
+		{ "Height", &heightScene },
+		{ "MaterialShowcase", &materialShowcaseScene },
+		{ "Normal", &normalScene },
+		{ "Texture", &textureScene },
+	};
+
+	Scene* scene{ &ambientOcclusionScene };
+	for (const std::pair<const char*, Scene*>& entry : sceneByName) {
+		if (arguments.mSceneName == entry.first) {
+			scene = entry.second;
+		}
+	}
+
+	App app(hInstance, scene, arguments.mRunMode);
 
 	return 0;
-}
\ No newline at end of file
+}
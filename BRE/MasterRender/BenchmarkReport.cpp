@@ -0,0 +1,114 @@
+#include "BenchmarkReport.h"
+
+#include <fstream>
+
+#include <Utils/DebugUtils.h>
+
+namespace {
+	const double sMillisecondsPerNanosecond{ 1.0e-6 };
+
+	const char* sStepNames[BenchmarkReport::STEP_COUNT]{
+		"geometryPass",
+		"lightingPass",
+		"skyBoxPass",
+		"toneMappingPass",
+		"mergePass",
+		"present",
+	};
+
+	// Writes str as a JSON string (file paths can have backslashes)
+	void WriteJsonString(std::ofstream& fout, const char* str) noexcept {
+		fout << "\"";
+		for (; str != nullptr && *str != '\0'; ++str) {
+			if (*str == '\\' || *str == '"') {
+				fout << '\\';
+			}
+			fout << *str;
+		}
+		fout << "\"";
+	}
+}
+
+BenchmarkReport::BenchmarkReport(const std::uint32_t expectedFrameCount) {
+	mFrames.reserve(expectedFrameCount);
+}
+
+void BenchmarkReport::AddFrame(const Frame& frame) noexcept {
+	mFrames.push_back(frame);
+	mStats.RecordFrame(frame.mFrameTime, frame.mWaitTime);
+}
+
+bool BenchmarkReport::Write(const char* filename, const char* cameraPathFilename, const float timeStep) const noexcept {
+	ASSERT(filename != nullptr);
+
+	std::ofstream fout{ filename, std::ios::trunc };
+	if (!fout) {
+		return false;
+	}
+
+	// Mean step times
+	double meanStepTimes[STEP_COUNT]{ 0.0 };
+	for (const Frame& frame : mFrames) {
+		for (std::uint32_t i = 0U; i < STEP_COUNT; ++i) {
+			meanStepTimes[i] += frame.mStepTimes[i] * sMillisecondsPerNanosecond;
+		}
+	}
+	for (std::uint32_t i = 0U; i < STEP_COUNT && mFrames.empty() == false; ++i) {
+		meanStepTimes[i] /= mFrames.size();
+	}
+
+	// Times in milliseconds
+	const FrameStats::Summary summary{ mStats.TotalSummary() };
+	fout << "{\n";
+	fout << "\"cameraPath\":";
+	WriteJsonString(fout, cameraPathFilename);
+	fout << ",\n";
+	fout << "\"timeStep\":" << timeStep << ",\n";
+	fout << "\"frameCount\":" << mFrames.size() << ",\n";
+	fout << "\"summary\":{"
+		<< "\"meanMs\":" << summary.mMean
+		<< ",\"stdDevMs\":" << summary.mStandardDeviation
+		<< ",\"minMs\":" << summary.mMin
+		<< ",\"p50Ms\":" << summary.mP50
+		<< ",\"p95Ms\":" << summary.mP95
+		<< ",\"p99Ms\":" << summary.mP99
+		<< ",\"maxMs\":" << summary.mMax
+		<< ",\"meanCpuMs\":" << summary.mMeanCpuTime
+		<< ",\"meanWaitMs\":" << summary.mMeanWaitTime
+		<< ",\"stutterCount\":" << summary.mStutterCount
+		<< ",\"meanStepMs\":{";
+	for (std::uint32_t i = 0U; i < STEP_COUNT; ++i) {
+		fout << (i > 0U ? "," : "") << "\"" << sStepNames[i] << "\":" << meanStepTimes[i];
+	}
+	fout << "}},\n";
+
+	fout << "\"frames\":[\n";
+	for (std::size_t i = 0UL; i < mFrames.size(); ++i) {
+		const Frame& frame(mFrames[i]);
+		fout << "{\"frameMs\":" << frame.mFrameTime * sMillisecondsPerNanosecond
+			<< ",\"waitMs\":" << frame.mWaitTime * sMillisecondsPerNanosecond
+			<< ",\"draws\":" << frame.mDrawCount
+			<< ",\"visibleInstances\":" << frame.mVisibleInstanceCount
+			<< ",\"culledInstances\":" << frame.mCulledInstanceCount
+			<< ",\"stepMs\":[";
+		for (std::uint32_t j = 0U; j < STEP_COUNT; ++j) {
+			fout << (j > 0U ? "," : "") << frame.mStepTimes[j] * sMillisecondsPerNanosecond;
+		}
+		fout << (i + 1UL < mFrames.size() ? "]},\n" : "]}\n");
+	}
+	fout << "],\n";
+
+	// Names of stepMs values
+	fout << "\"steps\":[";
+	for (std::uint32_t i = 0U; i < STEP_COUNT; ++i) {
+		fout << (i > 0U ? "," : "") << "\"" << sStepNames[i] << "\"";
+	}
+	fout << "]\n}\n";
+
+	return static_cast<bool>(fout);
+}
+
+const char* BenchmarkReport::StepName(const Step step) noexcept {
+	ASSERT(step < STEP_COUNT);
+	return sStepNames[step];
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <Timer/FrameStats.h>
+#include <Utils/ForceInline.h>
+
+// Per frame measurements of a benchmark run, written as a JSON report.
+// Steps:
+// - Call AddFrame() once per measured frame.
+// - Call Write() once all frames were added.
+class BenchmarkReport {
+public:
+	// Measured steps of a frame (present includes the wait for queued frames)
+	enum Step {
+		GEOMETRY_PASS = 0U,
+		LIGHTING_PASS,
+		SKY_BOX_PASS,
+		TONE_MAPPING_PASS,
+		MERGE_PASS,
+		PRESENT,
+		STEP_COUNT
+	};
+
+	// Times in nanoseconds
+	struct Frame {
+		std::uint64_t mFrameTime{ 0UL };
+		std::uint64_t mWaitTime{ 0UL };
+		std::uint64_t mStepTimes[STEP_COUNT]{ 0UL };
+		std::uint32_t mDrawCount{ 0U };
+		std::uint32_t mVisibleInstanceCount{ 0U };
+		std::uint32_t mCulledInstanceCount{ 0U };
+	};
+
+	explicit BenchmarkReport(const std::uint32_t expectedFrameCount);
+	~BenchmarkReport() = default;
+	BenchmarkReport(const BenchmarkReport&) = delete;
+	const BenchmarkReport& operator=(const BenchmarkReport&) = delete;
+	BenchmarkReport(BenchmarkReport&&) = delete;
+	BenchmarkReport& operator=(BenchmarkReport&&) = delete;
+
+	void AddFrame(const Frame& frame) noexcept;
+
+	// Writes summary (frame time statistics and mean step times) and all frames.
+	// cameraPathFilename can be nullptr. Returns false if the file can not be written.
+	bool Write(const char* filename, const char* cameraPathFilename, const float timeStep) const noexcept;
+
+	__forceinline std::uint32_t FrameCount() const noexcept { return static_cast<std::uint32_t>(mFrames.size()); }
+	__forceinline const FrameStats& Stats() const noexcept { return mStats; }
+
+	static const char* StepName(const Step step) noexcept;
+
+private:
+	std::vector<Frame> mFrames;
+	FrameStats mStats;
+};
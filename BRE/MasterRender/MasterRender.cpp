@@ -1,23 +1,94 @@
 #include "MasterRender.h"
 
+#include <cmath>
+#include <fstream>
 #include <tbb/parallel_for.h>
 
 #include <CommandListExecutor/CommandListExecutor.h>
 #include <CommandManager/CommandManager.h>
+#include <CommandManager/CommandStream.h>
+#include <CommandManager/CommandStreamReplay.h>
+#include <CommandManager/D3D12CommandQueue.h>
+#include <CommandManager/NullCommandList.h>
+#include <CommandManager/QueuedFrameFences.h>
 #include <DescriptorManager\DescriptorManager.h>
 #include <DXUtils/d3dx12.h>
 #include <GlobalData/D3dData.h>
 #include <GlobalData/Settings.h>
 #include <Input/Keyboard.h>
 #include <Input/Mouse.h>
+#include <MasterRender/BenchmarkReport.h>
+#include <PSOManager/PSOManager.h>
 #include <ResourceManager\ResourceManager.h>
 #include <Scene/Scene.h>
+#include <Scene/SceneUtils.h>
+#include <Utils/Profiler.h>
+#include <Utils/RenderStats.h>
+#include <Utils/TaskGraph.h>
 
 using namespace DirectX;
 
 namespace {
 	const std::uint32_t MAX_NUM_CMD_LISTS{ 3U };
 	const DXGI_FORMAT sFrameBufferFormat{ DXGI_FORMAT_R8G8B8A8_UNORM };
+
+	// Startup timeline (chrome://tracing format)
+	const char* sStartupTraceFilename{ "StartupTrace.json" };
+
+	// Geometry pass capture (taken when capture key is pressed) and its replay report
+	const std::uint8_t sCaptureKey{ DIK_F12 };
+	const char* sCaptureFilename{ "FrameCapture.bin" };
+	const char* sCaptureReportFilename{ "FrameCaptureReplay.txt" };
+	const std::uint32_t sCaptureReplayCount{ 100U };
+
+	// Last profiled frames (chrome://tracing format), written on termination
+	const char* sProfileTraceFilename{ "ProfileTrace.json" };
+
+	// Frame statistics summaries, written every sFrameStatsPeriod nanoseconds and on termination
+	const char* sFrameStatsFilename{ "FrameStats.txt" };
+	const std::uint64_t sFrameStatsPeriod{ 5000000000ULL };
+
+	// Benchmark camera path time step (seconds), and frames before the measured ones
+	// (camera stays at the beginning of the path).
+	const float sBenchmarkTimeStep{ 1.0f / 60.0f };
+	const std::uint32_t sBenchmarkWarmupFrameCount{ 16U };
+
+	// Store camera data in frame constant buffer
+	void StoreCamera(const Camera& camera, FrameCBuffer& frameCBuffer) noexcept {
+		frameCBuffer.mEyePosW = camera.GetPosition4f();
+
+		DirectX::XMStoreFloat4x4(&frameCBuffer.mView, MathUtils::GetTranspose(camera.GetView4x4f()));
+		DirectX::XMFLOAT4X4 inverse;
+		camera.GetInvView4x4f(inverse);
+		DirectX::XMStoreFloat4x4(&frameCBuffer.mInvView, MathUtils::GetTranspose(inverse));
+
+		DirectX::XMStoreFloat4x4(&frameCBuffer.mProj, MathUtils::GetTranspose(camera.GetProj4x4f()));
+		camera.GetInvProj4x4f(inverse);
+		DirectX::XMStoreFloat4x4(&frameCBuffer.mInvProj, MathUtils::GetTranspose(inverse));
+	}
+
+	// Place camera at camera path time (path is looped), and store data in frame constant buffer.
+	// Camera is not moved if path is empty.
+	void PlayCameraPath(
+		Camera& camera,
+		const CameraPath& cameraPath,
+		const float time,
+		FrameCBuffer& frameCBuffer) noexcept {
+
+		if (cameraPath.IsEmpty() == false) {
+			const float duration{ cameraPath.Duration() };
+			const float pathTime{ cameraPath.GetKeyframe(0UL).mTime + (duration > 0.0f ? std::fmod(time, duration) : 0.0f) };
+			DirectX::XMFLOAT3 position;
+			DirectX::XMFLOAT3 look;
+			DirectX::XMFLOAT3 up;
+			cameraPath.Sample(pathTime, position, look, up);
+			const DirectX::XMFLOAT3 target(position.x + look.x, position.y + look.y, position.z + look.z);
+			camera.LookAt(position, target, up);
+		}
+
+		camera.UpdateViewMatrix(0.0f);
+		StoreCamera(camera, frameCBuffer);
+	}
 	
 	// Update camera's view matrix and store data in parameters.
 	void UpdateCamera(
@@ -36,17 +107,7 @@ namespace {
 		static const float sCameraMultiplier{ 10.0f };
 
 		camera.UpdateViewMatrix(deltaTime);
-
-		frameCBuffer.mEyePosW = camera.GetPosition4f();
-
-		DirectX::XMStoreFloat4x4(&frameCBuffer.mView, MathUtils::GetTranspose(camera.GetView4x4f()));
-		DirectX::XMFLOAT4X4 inverse;
-		camera.GetInvView4x4f(inverse);
-		DirectX::XMStoreFloat4x4(&frameCBuffer.mInvView, MathUtils::GetTranspose(inverse));
-
-		DirectX::XMStoreFloat4x4(&frameCBuffer.mProj, MathUtils::GetTranspose(camera.GetProj4x4f()));
-		camera.GetInvProj4x4f(inverse);
-		DirectX::XMStoreFloat4x4(&frameCBuffer.mInvProj, MathUtils::GetTranspose(inverse));
+		StoreCamera(camera, frameCBuffer);
 		
 		// Update camera based on keyboard
 		const float offset = translationDelta * (Keyboard::Get().IsKeyDown(DIK_LSHIFT) ? sCameraMultiplier : 1.0f);
@@ -121,19 +182,34 @@ namespace {
 
 using namespace DirectX;
 
-MasterRender* MasterRender::Create(const HWND hwnd, ID3D12Device& device, Scene* scene) noexcept {
+MasterRender* MasterRender::Create(const HWND hwnd, ID3D12Device& device, Scene* scene, const RunMode& runMode) noexcept {
 	ASSERT(scene != nullptr);
 
 	tbb::empty_task* parent{ new (tbb::task::allocate_root()) tbb::empty_task };
 	// Reference count is 2: 1 parent task + 1 master render task
 	parent->set_ref_count(2);
-	return new (parent->allocate_child()) MasterRender(hwnd, device, scene);
+	return new (parent->allocate_child()) MasterRender(hwnd, device, scene, runMode);
 }
 
-MasterRender::MasterRender(const HWND hwnd, ID3D12Device& device, Scene* scene)
+MasterRender::~MasterRender() = default;
+
+MasterRender::MasterRender(const HWND hwnd, ID3D12Device& device, Scene* scene, const RunMode& runMode)
 	: mHwnd(hwnd)
 	, mDevice(device)
+	, mRunMode(runMode)
 {
+	if (runMode.mType == RunMode::BENCHMARK) {
+		ASSERT(runMode.mCameraPathFilename != nullptr);
+		ASSERT(runMode.mReportFilename != nullptr);
+		ASSERT(runMode.mBenchmarkFrameCount > 0U);
+		const bool isPathLoaded{ mCameraPath.Load(runMode.mCameraPathFilename) };
+		ASSERT(isPathLoaded);
+		mBenchmarkReport.reset(new BenchmarkReport(runMode.mBenchmarkFrameCount));
+	}
+	else if (runMode.mType == RunMode::RECORD_CAMERA_PATH) {
+		ASSERT(runMode.mCameraPathFilename != nullptr);
+	}
+
 	ResourceManager::Get().CreateFence(0U, D3D12_FENCE_FLAG_NONE, mFence);
 	CreateMergePassCommandObjects();
 	CreateRtvAndDsv();
@@ -141,8 +217,11 @@ MasterRender::MasterRender(const HWND hwnd, ID3D12Device& device, Scene* scene)
 
 	mCamera.SetLens(Settings::sFieldOfView, Settings::AspectRatio(), Settings::sNearPlaneZ, Settings::sFarPlaneZ);
 
-	// Create and spawn command list processor thread.
-	mCmdListExecutor = CommandListExecutor::Create(mCmdQueue, MAX_NUM_CMD_LISTS);
+	mFrameCmdQueue.reset(new D3D12CommandQueue(*mCmdQueue, *mFence));
+	mQueuedFrameFences.reset(new QueuedFrameFences(*mFrameCmdQueue, Settings::sQueuedFrameCount));
+
+	// Create command list processor thread.
+	mCmdListExecutor = CommandListExecutor::Create(*mFrameCmdQueue, MAX_NUM_CMD_LISTS);
 	ASSERT(mCmdListExecutor != nullptr);
 	
 	InitPasses(scene);
@@ -154,59 +233,121 @@ MasterRender::MasterRender(const HWND hwnd, ID3D12Device& device, Scene* scene)
 void MasterRender::InitPasses(Scene* scene) noexcept {
 	ASSERT(scene != nullptr);
 
+	// Startup task graph. Pipeline states only depend on render targets formats, so they are created 
+	// while the scene reads its textures and imports its models. Tasks that execute command lists on the queue 
+	// and wait for them are serial.
+	TaskGraph graph;
+
+	const std::uint32_t geometryPSOs{ graph.AddTask("Geometry pass PSOs", []() { GeometryPass::InitPSOs(); }) };
+	const std::uint32_t lightingPSOs{ graph.AddTask("Lighting pass PSOs", []() { LightingPass::InitPSOs(); }) };
+	const std::uint32_t skyBoxPSOs{ graph.AddTask("Sky box pass PSOs", []() { SkyBoxPass::InitPSOs(); }) };
+	const std::uint32_t toneMappingPSOs{ graph.AddTask("Tone mapping pass PSOs", []() { ToneMappingPass::InitPSOs(); }) };
+
+	// All pipeline states were created, so serialize the new ones for next runs.
+	graph.AddTask(
+		"Store pipeline library",
+		[]() { PSOManager::Get().StorePipelineLibrary(); },
+		{ geometryPSOs, lightingPSOs, skyBoxPSOs, toneMappingPSOs });
+
+	// Read scene textures and import its models in parallel (file reads, model import
+	// and tangent frames do not use the device). Scene init only uploads them.
+	std::vector<std::uint32_t> sceneFiles;
+	SceneUtils::ResourceContainer* sceneResources{ scene->Resources() };
+	if (sceneResources != nullptr) {
+		for (std::size_t i = 0UL; i < sceneResources->TextureFileCount(); ++i) {
+			sceneFiles.push_back(graph.AddTask("Scene texture read", [sceneResources, i]() { sceneResources->ReadTexture(i); }));
+		}
+
+		for (std::size_t i = 0UL; i < sceneResources->ModelFileCount(); ++i) {
+			sceneFiles.push_back(graph.AddTask("Scene model import", [sceneResources, i]() { sceneResources->ImportModel(i); }));
+		}
+	}
+
 	// Initialize scene
-	scene->Init(*mCmdQueue);
-	
+	const std::uint32_t sceneInit{ graph.AddTask("Scene init", [this, scene]() { scene->Init(*mCmdQueue); }, sceneFiles, true) };
+
 	// Generate recorders for all the passes
-	scene->GenerateGeomPassRecorders(mGeometryPass.GetRecorders());
-	mGeometryPass.Init(DepthStencilCpuDesc(), *mCmdListExecutor, *mCmdQueue);
-
-	ID3D12Resource* skyBoxCubeMap;
-	ID3D12Resource* diffuseIrradianceCubeMap;
-	ID3D12Resource* specularPreConvolvedCubeMap;
-	scene->GenerateCubeMaps(skyBoxCubeMap, diffuseIrradianceCubeMap, specularPreConvolvedCubeMap);
-	ASSERT(skyBoxCubeMap != nullptr);
-	ASSERT(diffuseIrradianceCubeMap != nullptr);
-	ASSERT(specularPreConvolvedCubeMap != nullptr);
-
-	scene->GenerateLightingPassRecorders(
-		mGeometryPass.GetBuffers(), 
-		GeometryPass::BUFFERS_COUNT, 
-		*mDepthStencilBuffer, 
-		mLightingPass.GetRecorders());
-
-	mLightingPass.Init(
-		mDevice, 
-		*mCmdListExecutor,
-		*mCmdQueue, 
-		mGeometryPass.GetBuffers(),
-		GeometryPass::BUFFERS_COUNT,
-		*mDepthStencilBuffer,
-		mColorBufferRTVCpuDescHandle, 
-		DepthStencilCpuDesc(),
-		*diffuseIrradianceCubeMap,
-		*specularPreConvolvedCubeMap);
-
-	mSkyBoxPass.Init(
-		mDevice, 
-		*mCmdListExecutor, 
-		*mCmdQueue, 
-		*skyBoxCubeMap, 
-		mColorBufferRTVCpuDescHandle, 
-		DepthStencilCpuDesc());
-
-	mToneMappingPass.Init(
-		mDevice, 
-		*mCmdListExecutor,
-		*mCmdQueue, 
-		*mColorBuffer.Get(), 
-		DepthStencilCpuDesc());
-		
-	// Initialize fence values for all frames to the same number.
-	const std::uint64_t count{ _countof(mFenceValueByQueuedFrameIndex) };
-	for (std::uint64_t i = 0UL; i < count; ++i) {
-		mFenceValueByQueuedFrameIndex[i] = mCurrFenceValue;
-	}
+	const std::uint32_t geometryRecorders{ graph.AddTask(
+		"Geometry pass recorders", 
+		[this, scene]() { scene->GenerateGeomPassRecorders(mGeometryPass.GetRecorders()); }, 
+		{ sceneInit }) };
+
+	const std::uint32_t geometryPass{ graph.AddTask(
+		"Geometry pass init",
+		[this, scene]() { mGeometryPass.Init(DepthStencilCpuDesc(), *mCmdListExecutor, *mCmdQueue, scene->Transforms()); },
+		{ geometryRecorders, geometryPSOs }) };
+
+	ID3D12Resource* skyBoxCubeMap{ nullptr };
+	SphericalHarmonics::Coefficients diffuseIrradiance;
+	ID3D12Resource* specularPreConvolvedCubeMap{ nullptr };
+	const std::uint32_t cubeMaps{ graph.AddTask(
+		"Scene cube maps",
+		[&, scene]() {
+			scene->GenerateCubeMaps(skyBoxCubeMap, diffuseIrradiance, specularPreConvolvedCubeMap);
+			ASSERT(skyBoxCubeMap != nullptr);
+			ASSERT(specularPreConvolvedCubeMap != nullptr);
+		},
+		{ sceneInit }) };
+
+	// Lighting recorders read geometry buffers
+	const std::uint32_t lightingRecorders{ graph.AddTask(
+		"Lighting pass recorders",
+		[this, scene]() {
+			scene->GenerateLightingPassRecorders(
+				mGeometryPass.GetBuffers(), 
+				GeometryPass::BUFFERS_COUNT, 
+				*mDepthStencilBuffer, 
+				mLightingPass.GetRecorders());
+		},
+		{ geometryPass }) };
+
+	graph.AddTask(
+		"Lighting pass init",
+		[&, this]() {
+			mLightingPass.Init(
+				mDevice, 
+				*mCmdListExecutor,
+				*mCmdQueue, 
+				mGeometryPass.GetBuffers(),
+				GeometryPass::BUFFERS_COUNT,
+				*mDepthStencilBuffer,
+				mColorBufferRTVCpuDescHandle, 
+				DepthStencilCpuDesc(),
+				diffuseIrradiance,
+				*specularPreConvolvedCubeMap);
+		},
+		{ lightingRecorders, cubeMaps, lightingPSOs },
+		true);
+
+	graph.AddTask(
+		"Sky box pass init",
+		[&, this]() {
+			mSkyBoxPass.Init(
+				mDevice, 
+				*mCmdListExecutor, 
+				*mCmdQueue, 
+				*skyBoxCubeMap, 
+				mColorBufferRTVCpuDescHandle, 
+				DepthStencilCpuDesc());
+		},
+		{ cubeMaps, skyBoxPSOs },
+		true);
+
+	graph.AddTask(
+		"Tone mapping pass init",
+		[this]() {
+			mToneMappingPass.Init(
+				mDevice, 
+				*mCmdListExecutor,
+				*mCmdQueue, 
+				*mColorBuffer.Get(), 
+				DepthStencilCpuDesc());
+		},
+		{ toneMappingPSOs },
+		true);
+
+	graph.Run();
+	graph.WriteTrace(sStartupTraceFilename);
 }
 
 void MasterRender::Terminate() noexcept {
@@ -215,32 +356,149 @@ void MasterRender::Terminate() noexcept {
 }
 
 tbb::task* MasterRender::execute() {
+	PROFILE_THREAD("Master render");
+
+	std::ofstream frameStatsFile{ sFrameStatsFilename, std::ios::trunc };
+	std::uint64_t frameStatsWindowBegin{ Timer::Now() };
+	bool isFirstFrame{ true };
+	std::uint32_t frameIndex{ 0U };
+
 	while (!mTerminate) {
+		PROFILE_FRAME();
+
+		const std::uint64_t frameBeginTime{ Timer::Now() };
+
+		// Delta time of the first frame is not a frame time
 		mTimer.Tick();
-		UpdateCamera(mCamera, mTimer.DeltaTime(), mFrameCBuffer);
+		if (isFirstFrame == false) {
+			const std::uint64_t frameTime{ mTimer.DeltaNanoseconds() };
+			mFrameStats.RecordFrame(frameTime, mLastWaitTime < frameTime ? mLastWaitTime : frameTime);
+		}
+		isFirstFrame = false;
+
+		if (Timer::Now() - frameStatsWindowBegin >= sFrameStatsPeriod) {
+			FrameStats::WriteSummary(frameStatsFile, "Last period", mFrameStats.WindowSummary());
+			WriteLastFrameRenderStats(frameStatsFile);
+			frameStatsFile.flush();
+			mFrameStats.BeginWindow();
+			frameStatsWindowBegin = Timer::Now();
+		}
+
+		{
+			PROFILE_ZONE("MasterRender::UpdateCamera");
+			if (mRunMode.mType == RunMode::BENCHMARK) {
+				const std::uint32_t pathFrameIndex{ frameIndex > sBenchmarkWarmupFrameCount ? frameIndex - sBenchmarkWarmupFrameCount : 0U };
+				PlayCameraPath(mCamera, mCameraPath, pathFrameIndex * sBenchmarkTimeStep, mFrameCBuffer);
+			}
+			else {
+				UpdateCamera(mCamera, mTimer.DeltaTime(), mFrameCBuffer);
+				if (mRunMode.mType == RunMode::RECORD_CAMERA_PATH) {
+					mCameraPath.AddKeyframe(mTimer.TotalTime(), mCamera.GetPosition3f(), mCamera.GetLook3f(), mCamera.GetUp3f());
+				}
+			}
+		}
 
 		ASSERT(mCmdListExecutor->IsIdle());
 
-		// Execute passes
+		// Execute passes, measuring each step (time and render counters)
+		BenchmarkReport::Frame frame;
+		RenderStats::Counters stepRenderStats[BenchmarkReport::STEP_COUNT];
+		std::uint64_t stepBeginTime{ Timer::Now() };
+		RenderStats::Counters stepBeginCounters{ RenderStats::Snapshot() };
+		const auto endStep = [&](const BenchmarkReport::Step step) {
+			const std::uint64_t time{ Timer::Now() };
+			frame.mStepTimes[step] = time - stepBeginTime;
+			stepBeginTime = time;
+
+			const RenderStats::Counters counters{ RenderStats::Snapshot() };
+			stepRenderStats[step] = counters;
+			stepRenderStats[step] -= stepBeginCounters;
+			stepBeginCounters = counters;
+		};
+
 		mGeometryPass.Execute(mFrameCBuffer);
+		if (mRunMode.mType != RunMode::BENCHMARK && Keyboard::Get().WasKeyPressedThisFrame(sCaptureKey)) {
+			CaptureGeometryPass();
+		}
+		endStep(BenchmarkReport::GEOMETRY_PASS);
 		mLightingPass.Execute(mFrameCBuffer);
+		endStep(BenchmarkReport::LIGHTING_PASS);
 		mSkyBoxPass.Execute(mFrameCBuffer);
+		endStep(BenchmarkReport::SKY_BOX_PASS);
 		mToneMappingPass.Execute(*CurrentFrameBuffer(), CurrentFrameBufferCpuDesc());
+		endStep(BenchmarkReport::TONE_MAPPING_PASS);
 		ExecuteMergePass();
+		endStep(BenchmarkReport::MERGE_PASS);
 
 		SignalFenceAndPresent();
+		endStep(BenchmarkReport::PRESENT);
+
+		{
+			std::lock_guard<std::mutex> lock(mRenderStatsMutex);
+			for (std::uint32_t i = 0U; i < BenchmarkReport::STEP_COUNT; ++i) {
+				mLastFrameRenderStats[i] = stepRenderStats[i];
+			}
+		}
+
+		if (mBenchmarkReport.get() != nullptr && frameIndex >= sBenchmarkWarmupFrameCount && mBenchmarkFinished == false) {
+			frame.mFrameTime = Timer::Now() - frameBeginTime;
+			frame.mWaitTime = mLastWaitTime;
+			frame.mDrawCount = mGeometryPass.DrawCount();
+			frame.mVisibleInstanceCount = mGeometryPass.VisibleInstanceCount();
+			frame.mCulledInstanceCount = mGeometryPass.CulledInstanceCount();
+			mBenchmarkReport->AddFrame(frame);
+
+			if (mBenchmarkReport->FrameCount() == mRunMode.mBenchmarkFrameCount) {
+				mBenchmarkReport->Write(mRunMode.mReportFilename, mRunMode.mCameraPathFilename, sBenchmarkTimeStep);
+				mBenchmarkFinished = true;
+			}
+		}
+		++frameIndex;
 	}
 
 	// If we need to terminate, then we terminates command list processor
 	// and waits until all GPU command lists are properly executed.
 	mCmdListExecutor->Terminate();
-	FlushCommandQueue();
+	delete mCmdListExecutor;
+	mCmdListExecutor = nullptr;
+	mQueuedFrameFences->Flush();
+
+#if PROFILER_ENABLED
+	Profiler::WriteTrace(sProfileTraceFilename);
+#endif
+
+	FrameStats::WriteSummary(frameStatsFile, "Total", mFrameStats.TotalSummary());
+
+	if (mRunMode.mType == RunMode::RECORD_CAMERA_PATH) {
+		mCameraPath.Save(mRunMode.mCameraPathFilename);
+	}
 
 	return nullptr;
 }
 
+void MasterRender::GetLastFrameRenderStats(RenderStats::Counters (&stepCounters)[BenchmarkReport::STEP_COUNT]) const noexcept {
+	std::lock_guard<std::mutex> lock(mRenderStatsMutex);
+	for (std::uint32_t i = 0U; i < BenchmarkReport::STEP_COUNT; ++i) {
+		stepCounters[i] = mLastFrameRenderStats[i];
+	}
+}
+
+void MasterRender::WriteLastFrameRenderStats(std::ostream& stream) const noexcept {
+	RenderStats::Counters stepCounters[BenchmarkReport::STEP_COUNT];
+	GetLastFrameRenderStats(stepCounters);
+
+	RenderStats::Counters frameCounters;
+	for (std::uint32_t i = 0U; i < BenchmarkReport::STEP_COUNT; ++i) {
+		RenderStats::WriteCounters(stream, BenchmarkReport::StepName(static_cast<BenchmarkReport::Step>(i)), stepCounters[i]);
+		frameCounters += stepCounters[i];
+	}
+	RenderStats::WriteCounters(stream, "frame", frameCounters);
+}
+
 void MasterRender::ExecuteMergePass() {
-	ID3D12CommandAllocator* cmdAlloc{ mMergePassCmdAllocs[mCurrQueuedFrameIndex] };
+	PROFILE_ZONE("MasterRender::ExecuteMergePass");
+
+	ID3D12CommandAllocator* cmdAlloc{ mMergePassCmdAllocs[mQueuedFrameFences->CurrentQueuedFrameIndex()] };
 
 	CHECK_HR(cmdAlloc->Reset());
 	CHECK_HR(mMergePassCmdList->Reset(cmdAlloc, nullptr));
@@ -254,12 +512,30 @@ void MasterRender::ExecuteMergePass() {
 	};
 	const std::size_t barriersCount = _countof(barriers);
 	ASSERT(barriersCount == GeometryPass::BUFFERS_COUNT + 2UL);
+	RENDER_STATS_ADD(RESOURCE_BARRIERS, _countof(barriers));
 	mMergePassCmdList->ResourceBarrier(_countof(barriers), barriers);
 
 	// Execute command list
 	CHECK_HR(mMergePassCmdList->Close());
 	ID3D12CommandList* cmdLists[] = { mMergePassCmdList };
-	mCmdQueue->ExecuteCommandLists(_countof(cmdLists), cmdLists);
+	RENDER_STATS_EXECUTE(_countof(cmdLists));
+	mFrameCmdQueue->ExecuteCommandLists(_countof(cmdLists), cmdLists);
+}
+
+void MasterRender::CaptureGeometryPass() noexcept {
+	CommandStream stream;
+	mGeometryPass.CaptureLastFrame(mFrameCBuffer, stream);
+
+	// Failing to write files is not an error, capture is only a debugging aid.
+	stream.Save(sCaptureFilename);
+
+	NullCommandList cmdList;
+	CommandStreamReplay::Result result;
+	CommandStreamReplay::Run(stream, cmdList, sCaptureReplayCount, result);
+	ASSERT(result.mIsValid);
+	ASSERT(cmdList.InvalidCommandCount() == 0U);
+
+	CommandStreamReplay::WriteReport(sCaptureReportFilename, result);
 }
 
 void MasterRender::CreateRtvAndDsv() noexcept {
@@ -367,28 +643,13 @@ D3D12_CPU_DESCRIPTOR_HANDLE MasterRender::DepthStencilCpuDesc() const noexcept {
 	return mDepthStencilBufferRTV;
 }
 
-void MasterRender::FlushCommandQueue() noexcept {
-	// Signal a new fence value
-	++mCurrFenceValue;
-	CHECK_HR(mCmdQueue->Signal(mFence, mCurrFenceValue));
-
-	// Wait until the GPU has completed commands up to this fence point.
-	if (mFence->GetCompletedValue() < mCurrFenceValue) {
-		const HANDLE eventHandle{ CreateEventEx(nullptr, nullptr, false, EVENT_ALL_ACCESS) };
-		ASSERT(eventHandle);
-
-		// Fire event when GPU hits current fence.  
-		CHECK_HR(mFence->SetEventOnCompletion(mCurrFenceValue, eventHandle));
-
-		// Wait until the GPU hits current fence event is fired.
-		WaitForSingleObject(eventHandle, INFINITE);
-		CloseHandle(eventHandle);
-	}
-}
-
 void MasterRender::SignalFenceAndPresent() noexcept {
+	PROFILE_ZONE("MasterRender::SignalFenceAndPresent");
+
 	ASSERT(mSwapChain != nullptr);
 
+	const std::uint64_t beginTime{ Timer::Now() };
+
 #ifdef V_SYNC
 	static const HANDLE frameLatencyWaitableObj(mSwapChain->GetFrameLatencyWaitableObject());
 	WaitForSingleObjectEx(frameLatencyWaitableObj, INFINITE, true);
@@ -397,25 +658,9 @@ void MasterRender::SignalFenceAndPresent() noexcept {
 	CHECK_HR(mSwapChain->Present(0U, 0U));
 #endif
 	
-	// Add an instruction to the command queue to set a new fence point.  Because we 
-	// are on the GPU time line, the new fence point won't be set until the GPU finishes
-	// processing all the commands prior to this Signal().
-	mFenceValueByQueuedFrameIndex[mCurrQueuedFrameIndex] = ++mCurrFenceValue;
-	CHECK_HR(mCmdQueue->Signal(mFence, mCurrFenceValue));
-	mCurrQueuedFrameIndex = (mCurrQueuedFrameIndex + 1U) % Settings::sQueuedFrameCount;	
-
-	// If we executed command lists for all queued frames, then we need to wait
-	// at least 1 of them to be completed, before continue recording command lists. 
-	const std::uint64_t oldestFence{ mFenceValueByQueuedFrameIndex[mCurrQueuedFrameIndex] };
-	if (mFence->GetCompletedValue() < oldestFence) {
-		const HANDLE eventHandle{ CreateEventEx(nullptr, nullptr, false, EVENT_ALL_ACCESS) };
-		ASSERT(eventHandle);
-
-		// Fire event when GPU hits current fence.  
-		CHECK_HR(mFence->SetEventOnCompletion(oldestFence, eventHandle));
-
-		// Wait until the GPU hits current fence event is fired.
-		WaitForSingleObject(eventHandle, INFINITE);
-		CloseHandle(eventHandle);
-	}
+	// Signal the frame end and wait until the oldest queued frame is completed,
+	// before continue recording command lists.
+	mQueuedFrameFences->EndFrame();
+
+	mLastWaitTime = Timer::Now() - beginTime;
 }
@@ -1,19 +1,29 @@
 #pragma once
 
+#include <atomic>
 #include <d3d12.h>
 #include <dxgi1_4.h>
+#include <memory>
+#include <mutex>
+#include <ostream>
 #include <tbb/task.h>
 
 #include <Camera/Camera.h>
+#include <Camera/CameraPath.h>
 #include <GeometryPass\GeometryPass.h>
 #include <GlobalData\Settings.h>
 #include <LightingPass\LightingPass.h>
+#include <MasterRender/BenchmarkReport.h>
 #include <SkyBoxPass\SkyBoxPass.h>
 #include <ShaderUtils\CBuffers.h>
 #include <ToneMappingPass\ToneMappingPass.h>
+#include <Timer/FrameStats.h>
 #include <Timer/Timer.h>
+#include <Utils/RenderStats.h>
 
 class CommandListExecutor;
+class D3D12CommandQueue;
+class QueuedFrameFences;
 class Scene;
 
 // Initializes passes (geometry, light, skybox, etc) based on a Scene.
@@ -22,9 +32,28 @@ class Scene;
 // - When you want to terminate this task, you should call MasterRender::Terminate()
 class MasterRender : public tbb::task {
 public:
-	static MasterRender* Create(const HWND hwnd, ID3D12Device& device, Scene* scene) noexcept;
-
-	~MasterRender() = default;
+	// How the camera is controlled. Filenames must be valid while master render runs.
+	// - INTERACTIVE: live keyboard and mouse input.
+	// - RECORD_CAMERA_PATH: live input, and camera transforms are saved to mCameraPathFilename on termination.
+	// - BENCHMARK: mCameraPathFilename path is played back at a fixed time step (live input is ignored)
+	// for mBenchmarkFrameCount frames (the path is looped if it is shorter). Then a JSON report 
+	// is written to mReportFilename and IsBenchmarkFinished() returns true.
+	struct RunMode {
+		enum Type {
+			INTERACTIVE = 0U,
+			RECORD_CAMERA_PATH,
+			BENCHMARK,
+		};
+
+		Type mType{ INTERACTIVE };
+		const char* mCameraPathFilename{ nullptr };
+		const char* mReportFilename{ nullptr };
+		std::uint32_t mBenchmarkFrameCount{ 0U };
+	};
+
+	static MasterRender* Create(const HWND hwnd, ID3D12Device& device, Scene* scene, const RunMode& runMode = RunMode()) noexcept;
+
+	~MasterRender();
 	MasterRender(const MasterRender&) = delete;
 	const MasterRender& operator=(const MasterRender&) = delete;
 	MasterRender(MasterRender&&) = delete;
@@ -32,8 +61,13 @@ public:
 
 	void Terminate() noexcept;
 
+	__forceinline bool IsBenchmarkFinished() const noexcept { return mBenchmarkFinished; }
+
+	// RenderStats counters of each step of last frame. It can be called from any thread.
+	void GetLastFrameRenderStats(RenderStats::Counters (&stepCounters)[BenchmarkReport::STEP_COUNT]) const noexcept;
+
 private:
-	explicit MasterRender(const HWND hwnd, ID3D12Device& device, Scene* scene);
+	explicit MasterRender(const HWND hwnd, ID3D12Device& device, Scene* scene, const RunMode& runMode);
 
 	// Called when tbb::task is spawned
 	tbb::task* execute() final override;
@@ -50,21 +84,29 @@ private:
 
 	void ExecuteMergePass();
 
-	void FlushCommandQueue() noexcept;
+	// Writes last frame render counters, a line per step and a line for the whole frame
+	void WriteLastFrameRenderStats(std::ostream& stream) const noexcept;
+
+	// Captures geometry pass commands of the current frame to a file, and replays
+	// them against a null command list to report recording throughput.
+	void CaptureGeometryPass() noexcept;
+
 	void SignalFenceAndPresent() noexcept;
 
 	HWND mHwnd{ nullptr };
 	ID3D12Device& mDevice;
 	Microsoft::WRL::ComPtr<IDXGISwapChain3> mSwapChain{ nullptr };
 	ID3D12CommandQueue* mCmdQueue{ nullptr };
-			
-	CommandListExecutor* mCmdListExecutor{ nullptr };
-	
+
 	// Fences data for syncrhonization purposes.
 	ID3D12Fence* mFence{ nullptr };
-	std::uint32_t mCurrQueuedFrameIndex{ 0U };
-	std::uint64_t mFenceValueByQueuedFrameIndex[Settings::sQueuedFrameCount]{ 0UL };
-	std::uint64_t mCurrFenceValue{ 0UL };
+
+	// Command list executor, merge pass submission and queued frame fences
+	// use mCmdQueue and mFence through the CommandQueue interface.
+	std::unique_ptr<D3D12CommandQueue> mFrameCmdQueue;
+	std::unique_ptr<QueuedFrameFences> mQueuedFrameFences;
+			
+	CommandListExecutor* mCmdListExecutor{ nullptr };
 
 	// Passes
 	GeometryPass mGeometryPass;
@@ -95,6 +137,20 @@ private:
 
 	Camera mCamera;
 	Timer mTimer;
+
+	// Wait time is the time blocked in SignalFenceAndPresent() (last frame)
+	FrameStats mFrameStats;
+	std::uint64_t mLastWaitTime{ 0UL };
+
+	// RenderStats counters of each step of last frame
+	RenderStats::Counters mLastFrameRenderStats[BenchmarkReport::STEP_COUNT];
+	mutable std::mutex mRenderStatsMutex;
+
+	// Recorded (RECORD_CAMERA_PATH) or played back (BENCHMARK) camera path
+	RunMode mRunMode;
+	CameraPath mCameraPath;
+	std::unique_ptr<BenchmarkReport> mBenchmarkReport;
+	std::atomic<bool> mBenchmarkFinished{ false };
 	
 	// When it is true, master render thread is destroyed.
 	bool mTerminate{ false };
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <cstring>
 
 struct Material {
@@ -23,6 +24,9 @@ struct Material {
 
 		memcpy(mBaseColor_MetalMask, instance.mBaseColor_MetalMask, sizeof(mBaseColor_MetalMask));
 		mSmoothness = instance.mSmoothness;
+		mDiffuseTextureIndex = instance.mDiffuseTextureIndex;
+		mNormalTextureIndex = instance.mNormalTextureIndex;
+		mHeightTextureIndex = instance.mHeightTextureIndex;
 
 		return *this;
 	}
@@ -32,7 +36,12 @@ struct Material {
 
 	float mBaseColor_MetalMask[4U]{ 1.0f, 1.0f, 1.0f, 0.0f };
 	float mSmoothness{ 1.0f };
-	float mPad[3U];
+
+	// Textures indices in TextureRegistry. They are set by geometry pass
+	// recorders that sample textures, and ignored by the others.
+	std::uint32_t mDiffuseTextureIndex{ 0U };
+	std::uint32_t mNormalTextureIndex{ 0U };
+	std::uint32_t mHeightTextureIndex{ 0U };
 
 	void RandomSmoothness() noexcept;
 	void RandomMetalMask() noexcept;
@@ -0,0 +1,75 @@
+#include "MaterialRegistry.h"
+
+#include <cstring>
+
+#include <ResourceManager/ResourceManager.h>
+#include <ResourceManager/UploadBuffer.h>
+#include <Utils/DebugUtils.h>
+
+namespace {
+	std::unique_ptr<MaterialRegistry> gRegistry{ nullptr };
+}
+
+MaterialRegistry& MaterialRegistry::Create() noexcept {
+	ASSERT(gRegistry == nullptr);
+	gRegistry.reset(new MaterialRegistry());
+	return *gRegistry.get();
+}
+
+MaterialRegistry& MaterialRegistry::Get() noexcept {
+	ASSERT(gRegistry != nullptr);
+	return *gRegistry.get();
+}
+
+MaterialRegistry::Key::Key(const Material& material) noexcept {
+	static_assert(sizeof(mWords) == sizeof(Material), "Key must cover material data");
+	memcpy(mWords, &material, sizeof(Material));
+}
+
+bool MaterialRegistry::Key::operator==(const Key& key) const noexcept {
+	return memcmp(mWords, key.mWords, sizeof(mWords)) == 0;
+}
+
+std::size_t MaterialRegistry::KeyHasher::operator()(const Key& key) const noexcept {
+	// FNV-1a of the words
+	std::uint64_t hash{ 14695981039346656037ULL };
+	for (std::uint32_t i = 0U; i < Key::sWordCount; ++i) {
+		hash = (hash ^ key.mWords[i]) * 1099511628211ULL;
+	}
+
+	return static_cast<std::size_t>(hash);
+}
+
+std::uint32_t MaterialRegistry::Register(const Material& material) noexcept {
+	ASSERT(mBuffer == nullptr);
+
+	const Key key(material);
+
+	std::lock_guard<std::mutex> lock(mMutex);
+	++mRegisteredCount;
+	const std::uint32_t index{ static_cast<std::uint32_t>(mMaterials.size()) };
+	const std::pair<std::unordered_map<Key, std::uint32_t, KeyHasher>::iterator, bool> result{ mIndexByKey.emplace(key, index) };
+	if (result.second) {
+		mMaterials.push_back(material);
+	}
+
+	return result.first->second;
+}
+
+void MaterialRegistry::BuildBuffer() noexcept {
+	ASSERT(mBuffer == nullptr);
+
+	// Buffer can not be empty
+	if (mMaterials.empty()) {
+		mMaterials.push_back(Material());
+	}
+
+	const std::uint32_t count{ MaterialCount() };
+	ResourceManager::Get().CreateUploadBuffer(sizeof(Material), count, mBuffer);
+	mBuffer->CopyData(0U, mMaterials.data(), sizeof(Material) * count);
+}
+
+const UploadBuffer& MaterialRegistry::Buffer() const noexcept {
+	ASSERT(mBuffer != nullptr);
+	return *mBuffer;
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <Material/Material.h>
+
+class UploadBuffer;
+
+// This class is responsible to deduplicate materials of all geometry pass recorders
+// into a single structured buffer. Instances refer to materials by their index
+// in it, instead of having a material (and a buffer element) per instance.
+// Materials are identical if their data is bitwise equal.
+// Steps:
+// - Call Register() (it can be called from different threads) to get materials indices,
+// and pass them to recorders Init().
+// - Call BuildBuffer() once all materials are registered (geometry pass does it).
+// - Bind Buffer() as materials structured buffer.
+class MaterialRegistry {
+public:
+	static MaterialRegistry& Create() noexcept;
+	static MaterialRegistry& Get() noexcept;
+
+	~MaterialRegistry() = default;
+	MaterialRegistry(const MaterialRegistry&) = delete;
+	const MaterialRegistry& operator=(const MaterialRegistry&) = delete;
+	MaterialRegistry(MaterialRegistry&&) = delete;
+	MaterialRegistry& operator=(MaterialRegistry&&) = delete;
+
+	// Returns the index of the material, adding it if it was not registered.
+	// It must not be called after BuildBuffer().
+	std::uint32_t Register(const Material& material) noexcept;
+
+	// Creates and fills the materials structured buffer (Material).
+	void BuildBuffer() noexcept;
+
+	const UploadBuffer& Buffer() const noexcept;
+
+	__forceinline std::uint32_t MaterialCount() const noexcept { return static_cast<std::uint32_t>(mMaterials.size()); }
+	__forceinline const Material& GetMaterial(const std::uint32_t index) const noexcept { return mMaterials[index]; }
+
+	// Number of Register() calls, to compare with MaterialCount()
+	__forceinline std::uint32_t RegisteredCount() const noexcept { return mRegisteredCount; }
+
+private:
+	MaterialRegistry() = default;
+
+	// Material data (including textures indices) compared bitwise
+	struct Key {
+		explicit Key(const Material& material) noexcept;
+
+		bool operator==(const Key& key) const noexcept;
+
+		static const std::uint32_t sWordCount{ 8U };
+		std::uint32_t mWords[sWordCount];
+	};
+
+	struct KeyHasher {
+		std::size_t operator()(const Key& key) const noexcept;
+	};
+
+	std::vector<Material> mMaterials;
+	std::unordered_map<Key, std::uint32_t, KeyHasher> mIndexByKey;
+	std::uint32_t mRegisteredCount{ 0U };
+
+	UploadBuffer* mBuffer{ nullptr };
+
+	std::mutex mMutex;
+};
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#include <Utils/DebugUtils.h>
+
+// Axis aligned bounding box
+struct Aabb {
+	__forceinline void Merge(const Aabb& box) noexcept {
+		for (std::uint32_t j = 0U; j < 3U; ++j) {
+			mMin[j] = box.mMin[j] < mMin[j] ? box.mMin[j] : mMin[j];
+			mMax[j] = box.mMax[j] > mMax[j] ? box.mMax[j] : mMax[j];
+		}
+	}
+
+	__forceinline float Center(const std::uint32_t axis) const noexcept { return (mMin[axis] + mMax[axis]) * 0.5f; }
+
+	// Half surface area. It is enough to compare surface area heuristic costs.
+	__forceinline float HalfArea() const noexcept {
+		const float dx{ mMax[0U] - mMin[0U] };
+		const float dy{ mMax[1U] - mMin[1U] };
+		const float dz{ mMax[2U] - mMin[2U] };
+		return dx * dy + dy * dz + dz * dx;
+	}
+
+	// Box that contains nothing. Merging any box to it returns that box.
+	static Aabb Empty() noexcept {
+		const float maxValue{ std::numeric_limits<float>::max() };
+		return Aabb{ { maxValue, maxValue, maxValue }, { -maxValue, -maxValue, -maxValue } };
+	}
+
+	float mMin[3U];
+	float mMax[3U];
+};
+
+// Axis aligned bounding box and bounding sphere of a mesh, in mesh (local) space.
+// It does not depend on DirectXMath, so it can be used by platform independent code (culling).
+struct BoundingVolumes {
+	BoundingVolumes() = default;
+	~BoundingVolumes() = default;
+	BoundingVolumes(const BoundingVolumes&) = default;
+	BoundingVolumes& operator=(const BoundingVolumes&) = default;
+	BoundingVolumes(BoundingVolumes&&) = default;
+	BoundingVolumes& operator=(BoundingVolumes&&) = default;
+
+	// Computes AABB, and a sphere centered in the AABB center that encloses all positions.
+	// positions points to the first vertex position (3 floats), and stride is the
+	// byte size between consecutive positions (vertex size).
+	static BoundingVolumes FromPositions(const void* positions, const std::size_t count, const std::size_t stride) noexcept {
+		ASSERT(positions != nullptr);
+		ASSERT(count > 0UL);
+		ASSERT(stride >= sizeof(float) * 3UL);
+
+		const std::uint8_t* data{ static_cast<const std::uint8_t*>(positions) };
+		BoundingVolumes volumes;
+		float pos[3U];
+		for (std::size_t i = 0UL; i < count; ++i) {
+			std::memcpy(pos, data + i * stride, sizeof(pos));
+			const Aabb posBox{ { pos[0U], pos[1U], pos[2U] }, { pos[0U], pos[1U], pos[2U] } };
+			volumes.mAabb.Merge(posBox);
+		}
+
+		// Sphere centered in the AABB. Its radius is the distance to the farthest position,
+		// that is usually tighter than AABB half diagonal.
+		for (std::uint32_t j = 0U; j < 3U; ++j) {
+			volumes.mSphereCenter[j] = volumes.mAabb.Center(j);
+		}
+
+		float maxSqrDist{ 0.0f };
+		for (std::size_t i = 0UL; i < count; ++i) {
+			std::memcpy(pos, data + i * stride, sizeof(pos));
+			const float dx{ pos[0U] - volumes.mSphereCenter[0U] };
+			const float dy{ pos[1U] - volumes.mSphereCenter[1U] };
+			const float dz{ pos[2U] - volumes.mSphereCenter[2U] };
+			const float sqrDist{ dx * dx + dy * dy + dz * dz };
+			maxSqrDist = sqrDist > maxSqrDist ? sqrDist : maxSqrDist;
+		}
+		volumes.mSphereRadius = std::sqrt(maxSqrDist);
+
+		return volumes;
+	}
+
+	// Transforms the sphere by a row major world matrix (row vectors, translation in the 4th row).
+	// Radius is scaled by the biggest axis scale, so the result encloses the transformed mesh.
+	void TransformSphere(const float world[16U], float center[3U], float& radius) const noexcept {
+		for (std::uint32_t j = 0U; j < 3U; ++j) {
+			center[j] =
+				mSphereCenter[0U] * world[j] +
+				mSphereCenter[1U] * world[4U + j] +
+				mSphereCenter[2U] * world[8U + j] +
+				world[12U + j];
+		}
+
+		float maxSqrScale{ 0.0f };
+		for (std::uint32_t i = 0U; i < 3U; ++i) {
+			const float* row{ world + i * 4U };
+			const float sqrScale{ row[0U] * row[0U] + row[1U] * row[1U] + row[2U] * row[2U] };
+			maxSqrScale = sqrScale > maxSqrScale ? sqrScale : maxSqrScale;
+		}
+		radius = mSphereRadius * std::sqrt(maxSqrScale);
+	}
+
+	// Transforms the AABB by a row major world matrix (row vectors, translation in the 4th row),
+	// and returns the AABB of the result (Arvo's method).
+	void TransformAabb(const float world[16U], Aabb& box) const noexcept {
+		for (std::uint32_t j = 0U; j < 3U; ++j) {
+			box.mMin[j] = world[12U + j];
+			box.mMax[j] = world[12U + j];
+			for (std::uint32_t i = 0U; i < 3U; ++i) {
+				const float a{ world[i * 4U + j] * mAabb.mMin[i] };
+				const float b{ world[i * 4U + j] * mAabb.mMax[i] };
+				box.mMin[j] += a < b ? a : b;
+				box.mMax[j] += a < b ? b : a;
+			}
+		}
+	}
+
+	Aabb mAabb{ Aabb::Empty() };
+	float mSphereCenter[3U]{ 0.0f, 0.0f, 0.0f };
+	float mSphereRadius{ 0.0f };
+};
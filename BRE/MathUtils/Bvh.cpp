@@ -0,0 +1,559 @@
+#include "Bvh.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_invoke.h>
+
+namespace {
+	const std::uint32_t sInvalidIndex{ 0xFFFFFFFFU };
+
+	// Beyond this depth, nodes are split at the object median, so depth stays bounded
+	// even with degenerate primitives distributions.
+	const std::uint32_t sMaxSahDepth{ 48U };
+
+	// Traversal stack size. Tree depth is below sMaxSahDepth + log2(primitives count).
+	const std::uint32_t sMaxStackSize{ 128U };
+
+	// Temporary tree generated by the parallel build. It is flattened later.
+	struct BuildNode {
+		Aabb mBox;
+		std::uint32_t mBegin{ 0U };
+		std::uint32_t mCount{ 0U };
+		std::uint32_t mNodeCount{ 1U };
+		std::unique_ptr<BuildNode> mLeft;
+		std::unique_ptr<BuildNode> mRight;
+	};
+
+	struct Bin {
+		Aabb mBox{ Aabb::Empty() };
+		std::uint32_t mCount{ 0U };
+	};
+
+	struct BuildContext {
+		const Aabb* mBoxes;
+		const float* mCentroids;
+		std::uint32_t* mIndices;
+	};
+
+	__forceinline float Centroid(const BuildContext& context, const std::uint32_t primitive, const std::uint32_t axis) noexcept {
+		return context.mCentroids[primitive * 3U + axis];
+	}
+
+	__forceinline std::uint32_t BinIndex(const float centroid, const float minCentroid, const float scale) noexcept {
+		const std::uint32_t bin{ static_cast<std::uint32_t>((centroid - minCentroid) * scale) };
+		return bin < Bvh::sBinCount ? bin : Bvh::sBinCount - 1U;
+	}
+
+	// Returns the split position (in [begin, begin + count)) after partitioning the range
+	std::uint32_t MedianSplit(
+		const BuildContext& context,
+		const std::uint32_t begin,
+		const std::uint32_t count,
+		const std::uint32_t axis) noexcept {
+		const std::uint32_t mid{ begin + count / 2U };
+		std::nth_element(
+			context.mIndices + begin,
+			context.mIndices + mid,
+			context.mIndices + begin + count,
+			[&context, axis](const std::uint32_t a, const std::uint32_t b) {
+				return Centroid(context, a, axis) < Centroid(context, b, axis);
+			});
+
+		return mid;
+	}
+
+	std::unique_ptr<BuildNode> BuildRecursive(
+		const BuildContext& context,
+		const std::uint32_t begin,
+		const std::uint32_t count,
+		const std::uint32_t depth) noexcept {
+		ASSERT(count > 0U);
+
+		std::unique_ptr<BuildNode> node(new BuildNode());
+		node->mBegin = begin;
+		node->mCount = count;
+
+		Aabb box{ Aabb::Empty() };
+		Aabb centroidBox{ Aabb::Empty() };
+		for (std::uint32_t i = begin; i < begin + count; ++i) {
+			const std::uint32_t primitive{ context.mIndices[i] };
+			box.Merge(context.mBoxes[primitive]);
+			const float* centroid{ context.mCentroids + primitive * 3U };
+			centroidBox.Merge(Aabb{ { centroid[0U], centroid[1U], centroid[2U] }, { centroid[0U], centroid[1U], centroid[2U] } });
+		}
+		node->mBox = box;
+
+		if (count <= Bvh::sMaxLeafSize) {
+			return node;
+		}
+
+		// Axis with the largest centroids extent, for median splits
+		std::uint32_t largestAxis{ 0U };
+		for (std::uint32_t axis = 1U; axis < 3U; ++axis) {
+			const float extent{ centroidBox.mMax[axis] - centroidBox.mMin[axis] };
+			if (extent > centroidBox.mMax[largestAxis] - centroidBox.mMin[largestAxis]) {
+				largestAxis = axis;
+			}
+		}
+
+		// Find the lowest cost split between bins, for each axis
+		float bestCost{ std::numeric_limits<float>::max() };
+		std::uint32_t bestAxis{ sInvalidIndex };
+		std::uint32_t bestBin{ 0U };
+		for (std::uint32_t axis = 0U; axis < 3U && depth < sMaxSahDepth; ++axis) {
+			const float extent{ centroidBox.mMax[axis] - centroidBox.mMin[axis] };
+			if (extent <= 0.0f) {
+				continue;
+			}
+
+			const float scale{ static_cast<float>(Bvh::sBinCount) / extent };
+			Bin bins[Bvh::sBinCount];
+			for (std::uint32_t i = begin; i < begin + count; ++i) {
+				const std::uint32_t primitive{ context.mIndices[i] };
+				Bin& bin{ bins[BinIndex(Centroid(context, primitive, axis), centroidBox.mMin[axis], scale)] };
+				bin.mBox.Merge(context.mBoxes[primitive]);
+				++bin.mCount;
+			}
+
+			// Right to left sweep stores right side costs, and left to right sweep evaluates splits.
+			float rightCosts[Bvh::sBinCount];
+			Aabb rightBox{ Aabb::Empty() };
+			std::uint32_t rightCount{ 0U };
+			for (std::uint32_t i = Bvh::sBinCount - 1U; i > 0U; --i) {
+				rightBox.Merge(bins[i].mBox);
+				rightCount += bins[i].mCount;
+				rightCosts[i] = rightCount == 0U ? 0.0f : rightBox.HalfArea() * static_cast<float>(rightCount);
+			}
+
+			Aabb leftBox{ Aabb::Empty() };
+			std::uint32_t leftCount{ 0U };
+			for (std::uint32_t i = 0U; i < Bvh::sBinCount - 1U; ++i) {
+				leftBox.Merge(bins[i].mBox);
+				leftCount += bins[i].mCount;
+				if (leftCount == 0U || leftCount == count) {
+					continue;
+				}
+
+				const float cost{ leftBox.HalfArea() * static_cast<float>(leftCount) + rightCosts[i + 1U] };
+				if (cost < bestCost) {
+					bestCost = cost;
+					bestAxis = axis;
+					bestBin = i;
+				}
+			}
+		}
+
+		std::uint32_t mid;
+		if (bestAxis == sInvalidIndex) {
+			// All centroids are equal, or the tree is too deep
+			mid = MedianSplit(context, begin, count, largestAxis);
+		}
+		else {
+			const float minCentroid{ centroidBox.mMin[bestAxis] };
+			const float scale{ static_cast<float>(Bvh::sBinCount) / (centroidBox.mMax[bestAxis] - minCentroid) };
+			std::uint32_t* midIt = std::partition(
+				context.mIndices + begin,
+				context.mIndices + begin + count,
+				[&context, bestAxis, bestBin, minCentroid, scale](const std::uint32_t primitive) {
+					return BinIndex(Centroid(context, primitive, bestAxis), minCentroid, scale) <= bestBin;
+				});
+			mid = static_cast<std::uint32_t>(midIt - context.mIndices);
+			ASSERT(mid > begin && mid < begin + count);
+		}
+
+		const std::uint32_t leftCount{ mid - begin };
+		const std::uint32_t rightCount{ count - leftCount };
+		if (count >= Bvh::sParallelBuildThreshold) {
+			tbb::parallel_invoke(
+				[&]() { node->mLeft = BuildRecursive(context, begin, leftCount, depth + 1U); },
+				[&]() { node->mRight = BuildRecursive(context, mid, rightCount, depth + 1U); });
+		}
+		else {
+			node->mLeft = BuildRecursive(context, begin, leftCount, depth + 1U);
+			node->mRight = BuildRecursive(context, mid, rightCount, depth + 1U);
+		}
+
+		node->mCount = 0U;
+		node->mNodeCount = 1U + node->mLeft->mNodeCount + node->mRight->mNodeCount;
+
+		return node;
+	}
+
+	// Returns node index
+	std::uint32_t Flatten(
+		const BuildNode& buildNode,
+		const std::uint32_t parentIndex,
+		std::vector<Bvh::Node>& nodes,
+		std::vector<std::uint32_t>& parentByNode,
+		std::vector<std::uint32_t>& leafByPrimitive,
+		const std::uint32_t* indices) noexcept {
+		const std::uint32_t nodeIndex{ static_cast<std::uint32_t>(nodes.size()) };
+		nodes.push_back(Bvh::Node{ buildNode.mBox, 0U, buildNode.mCount });
+		parentByNode.push_back(parentIndex);
+
+		if (buildNode.mCount != 0U) {
+			nodes[nodeIndex].mIndex = buildNode.mBegin;
+			for (std::uint32_t i = buildNode.mBegin; i < buildNode.mBegin + buildNode.mCount; ++i) {
+				leafByPrimitive[indices[i]] = nodeIndex;
+			}
+		}
+		else {
+			Flatten(*buildNode.mLeft, nodeIndex, nodes, parentByNode, leafByPrimitive, indices);
+			nodes[nodeIndex].mIndex = Flatten(*buildNode.mRight, nodeIndex, nodes, parentByNode, leafByPrimitive, indices);
+		}
+
+		return nodeIndex;
+	}
+
+	__forceinline bool Overlap(const Aabb& a, const Aabb& b) noexcept {
+		return
+			a.mMin[0U] <= b.mMax[0U] && a.mMax[0U] >= b.mMin[0U] &&
+			a.mMin[1U] <= b.mMax[1U] && a.mMax[1U] >= b.mMin[1U] &&
+			a.mMin[2U] <= b.mMax[2U] && a.mMax[2U] >= b.mMin[2U];
+	}
+
+	__forceinline bool Contains(const Aabb& outer, const Aabb& inner) noexcept {
+		return
+			outer.mMin[0U] <= inner.mMin[0U] && outer.mMax[0U] >= inner.mMax[0U] &&
+			outer.mMin[1U] <= inner.mMin[1U] && outer.mMax[1U] >= inner.mMax[1U] &&
+			outer.mMin[2U] <= inner.mMin[2U] && outer.mMax[2U] >= inner.mMax[2U];
+	}
+
+	__forceinline bool OverlapSphere(const Aabb& box, const float center[3U], const float sqrRadius) noexcept {
+		float sqrDist{ 0.0f };
+		for (std::uint32_t j = 0U; j < 3U; ++j) {
+			const float v{ center[j] < box.mMin[j] ? box.mMin[j] - center[j] : (center[j] > box.mMax[j] ? center[j] - box.mMax[j] : 0.0f) };
+			sqrDist += v * v;
+		}
+
+		return sqrDist <= sqrRadius;
+	}
+
+	__forceinline bool OverlapRay(const Aabb& box, const float origin[3U], const float invDirection[3U], const float maxDistance) noexcept {
+		float tMin{ 0.0f };
+		float tMax{ maxDistance };
+		for (std::uint32_t j = 0U; j < 3U; ++j) {
+			const float t0{ (box.mMin[j] - origin[j]) * invDirection[j] };
+			const float t1{ (box.mMax[j] - origin[j]) * invDirection[j] };
+			tMin = std::max(tMin, std::min(t0, t1));
+			tMax = std::min(tMax, std::max(t0, t1));
+		}
+
+		return tMin <= tMax;
+	}
+
+	// Tests box against planes whose bit is set in planeMask.
+	// Returns false if box is outside any plane. Otherwise, it clears the bits
+	// of the planes box is fully inside of.
+	__forceinline bool TestPlanes(const Aabb& box, const float (&planes)[6U][4U], std::uint32_t& planeMask) noexcept {
+		float center[3U];
+		float extent[3U];
+		for (std::uint32_t j = 0U; j < 3U; ++j) {
+			center[j] = (box.mMin[j] + box.mMax[j]) * 0.5f;
+			extent[j] = (box.mMax[j] - box.mMin[j]) * 0.5f;
+		}
+
+		for (std::uint32_t i = 0U; i < 6U; ++i) {
+			if ((planeMask & (1U << i)) == 0U) {
+				continue;
+			}
+
+			const float* plane{ planes[i] };
+			const float dist{ plane[0U] * center[0U] + plane[1U] * center[1U] + plane[2U] * center[2U] + plane[3U] };
+			const float radius{ std::abs(plane[0U]) * extent[0U] + std::abs(plane[1U]) * extent[1U] + std::abs(plane[2U]) * extent[2U] };
+			if (dist + radius < 0.0f) {
+				return false;
+			}
+
+			if (dist - radius >= 0.0f) {
+				planeMask &= ~(1U << i);
+			}
+		}
+
+		return true;
+	}
+
+	// Traverses nodes whose bounds pass nodeTest, and appends the primitives of
+	// reached leaves that pass primitiveTest.
+	template<typename NodeTest, typename PrimitiveTest>
+	void Traverse(
+		const std::vector<Bvh::Node>& nodes,
+		const std::vector<std::uint32_t>& primitiveIndices,
+		const NodeTest& nodeTest,
+		const PrimitiveTest& primitiveTest,
+		std::vector<std::uint32_t>& result) noexcept {
+		if (nodes.empty()) {
+			return;
+		}
+
+		std::uint32_t stack[sMaxStackSize];
+		std::uint32_t stackSize{ 0U };
+		stack[stackSize++] = 0U;
+		while (stackSize > 0U) {
+			const std::uint32_t nodeIndex{ stack[--stackSize] };
+			const Bvh::Node& node{ nodes[nodeIndex] };
+			if (nodeTest(node.mBox) == false) {
+				continue;
+			}
+
+			if (node.IsLeaf()) {
+				for (std::uint32_t i = node.mIndex; i < node.mIndex + node.mCount; ++i) {
+					const std::uint32_t primitive{ primitiveIndices[i] };
+					if (primitiveTest(primitive)) {
+						result.push_back(primitive);
+					}
+				}
+			}
+			else {
+				ASSERT(stackSize + 2U <= sMaxStackSize);
+				stack[stackSize++] = node.mIndex;
+				stack[stackSize++] = nodeIndex + 1U;
+			}
+		}
+	}
+}
+
+void Bvh::Build(const Aabb* boxes, const std::uint32_t count) noexcept {
+	ASSERT(boxes != nullptr || count == 0U);
+
+	mNodes.clear();
+	mParentByNode.clear();
+	mPrimitiveBoxes.assign(boxes, boxes + count);
+	mPrimitiveIndices.resize(count);
+	mLeafByPrimitive.resize(count);
+	if (count == 0U) {
+		return;
+	}
+
+	std::vector<float> centroids(count * 3U);
+	tbb::parallel_for(tbb::blocked_range<std::uint32_t>(0U, count, 1024U),
+		[&](const tbb::blocked_range<std::uint32_t>& r) {
+		for (std::uint32_t i = r.begin(); i != r.end(); ++i) {
+			mPrimitiveIndices[i] = i;
+			for (std::uint32_t j = 0U; j < 3U; ++j) {
+				centroids[i * 3U + j] = boxes[i].Center(j);
+			}
+		}
+	}
+	);
+
+	const BuildContext context{ boxes, centroids.data(), mPrimitiveIndices.data() };
+	const std::unique_ptr<BuildNode> root{ BuildRecursive(context, 0U, count, 0U) };
+
+	mNodes.reserve(root->mNodeCount);
+	mParentByNode.reserve(root->mNodeCount);
+	Flatten(*root, sInvalidIndex, mNodes, mParentByNode, mLeafByPrimitive, mPrimitiveIndices.data());
+	ASSERT(mNodes.size() == root->mNodeCount);
+}
+
+void Bvh::Refit(const std::uint32_t* primitives, const Aabb* boxes, const std::uint32_t count) noexcept {
+	ASSERT(primitives != nullptr || count == 0U);
+	ASSERT(boxes != nullptr || count == 0U);
+
+	for (std::uint32_t i = 0U; i < count; ++i) {
+		const std::uint32_t primitive{ primitives[i] };
+		ASSERT(primitive < PrimitiveCount());
+		mPrimitiveBoxes[primitive] = boxes[i];
+
+		std::uint32_t nodeIndex{ mLeafByPrimitive[primitive] };
+		UpdateLeafBounds(nodeIndex);
+		nodeIndex = mParentByNode[nodeIndex];
+
+		// Stop when an ancestor bounds do not change
+		while (nodeIndex != sInvalidIndex) {
+			const Aabb oldBox{ mNodes[nodeIndex].mBox };
+			UpdateInteriorBounds(nodeIndex);
+			if (std::memcmp(&oldBox, &mNodes[nodeIndex].mBox, sizeof(Aabb)) == 0) {
+				break;
+			}
+
+			nodeIndex = mParentByNode[nodeIndex];
+		}
+	}
+}
+
+void Bvh::Refit(const Aabb* boxes) noexcept {
+	ASSERT(boxes != nullptr || PrimitiveCount() == 0U);
+
+	mPrimitiveBoxes.assign(boxes, boxes + PrimitiveCount());
+
+	// Children are always after their parent
+	for (std::size_t i = mNodes.size(); i > 0UL; --i) {
+		const std::uint32_t nodeIndex{ static_cast<std::uint32_t>(i - 1UL) };
+		if (mNodes[nodeIndex].IsLeaf()) {
+			UpdateLeafBounds(nodeIndex);
+		}
+		else {
+			UpdateInteriorBounds(nodeIndex);
+		}
+	}
+}
+
+void Bvh::FrustumQuery(const float (&planes)[6U][4U], std::vector<std::uint32_t>& result) const noexcept {
+	result.clear();
+	if (mNodes.empty()) {
+		return;
+	}
+
+	// Each stack entry stores the node and the planes its bounds are not fully inside of.
+	const std::uint32_t allPlanesMask{ (1U << 6U) - 1U };
+	std::uint32_t stack[sMaxStackSize][2U];
+	std::uint32_t stackSize{ 0U };
+	stack[stackSize][0U] = 0U;
+	stack[stackSize++][1U] = allPlanesMask;
+	while (stackSize > 0U) {
+		--stackSize;
+		const std::uint32_t nodeIndex{ stack[stackSize][0U] };
+		std::uint32_t planeMask{ stack[stackSize][1U] };
+		const Node& node{ mNodes[nodeIndex] };
+		if (TestPlanes(node.mBox, planes, planeMask) == false) {
+			continue;
+		}
+
+		if (planeMask == 0U) {
+			AppendSubtree(nodeIndex, result);
+		}
+		else if (node.IsLeaf()) {
+			for (std::uint32_t i = node.mIndex; i < node.mIndex + node.mCount; ++i) {
+				const std::uint32_t primitive{ mPrimitiveIndices[i] };
+				std::uint32_t primitivePlaneMask{ planeMask };
+				if (TestPlanes(mPrimitiveBoxes[primitive], planes, primitivePlaneMask)) {
+					result.push_back(primitive);
+				}
+			}
+		}
+		else {
+			ASSERT(stackSize + 2U <= sMaxStackSize);
+			stack[stackSize][0U] = node.mIndex;
+			stack[stackSize++][1U] = planeMask;
+			stack[stackSize][0U] = nodeIndex + 1U;
+			stack[stackSize++][1U] = planeMask;
+		}
+	}
+}
+
+void Bvh::SphereQuery(const float center[3U], const float radius, std::vector<std::uint32_t>& result) const noexcept {
+	ASSERT(center != nullptr);
+	ASSERT(radius >= 0.0f);
+
+	result.clear();
+	const float sqrRadius{ radius * radius };
+	Traverse(
+		mNodes,
+		mPrimitiveIndices,
+		[center, sqrRadius](const Aabb& box) { return OverlapSphere(box, center, sqrRadius); },
+		[this, center, sqrRadius](const std::uint32_t primitive) { return OverlapSphere(mPrimitiveBoxes[primitive], center, sqrRadius); },
+		result);
+}
+
+void Bvh::BoxQuery(const Aabb& box, std::vector<std::uint32_t>& result) const noexcept {
+	result.clear();
+	Traverse(
+		mNodes,
+		mPrimitiveIndices,
+		[&box](const Aabb& nodeBox) { return Overlap(box, nodeBox); },
+		[this, &box](const std::uint32_t primitive) { return Overlap(box, mPrimitiveBoxes[primitive]); },
+		result);
+}
+
+void Bvh::RayQuery(
+	const float origin[3U],
+	const float direction[3U],
+	const float maxDistance,
+	std::vector<std::uint32_t>& result) const noexcept {
+	ASSERT(origin != nullptr);
+	ASSERT(direction != nullptr);
+	ASSERT(maxDistance >= 0.0f);
+
+	result.clear();
+
+	// Zero components produce infinite inverses, that slab tests handle.
+	const float invDirection[3U]{ 1.0f / direction[0U], 1.0f / direction[1U], 1.0f / direction[2U] };
+	Traverse(
+		mNodes,
+		mPrimitiveIndices,
+		[origin, &invDirection, maxDistance](const Aabb& box) { return OverlapRay(box, origin, invDirection, maxDistance); },
+		[this, origin, &invDirection, maxDistance](const std::uint32_t primitive) {
+			return OverlapRay(mPrimitiveBoxes[primitive], origin, invDirection, maxDistance);
+		},
+		result);
+}
+
+bool Bvh::ValidateData() const noexcept {
+	const std::uint32_t primitiveCount{ PrimitiveCount() };
+	if (primitiveCount == 0U) {
+		return mNodes.empty();
+	}
+
+	std::vector<std::uint32_t> referenceCounts(primitiveCount, 0U);
+	const std::uint32_t nodeCount{ static_cast<std::uint32_t>(mNodes.size()) };
+	for (std::uint32_t nodeIndex = 0U; nodeIndex < nodeCount; ++nodeIndex) {
+		const Node& node{ mNodes[nodeIndex] };
+		if (node.IsLeaf()) {
+			if (node.mCount > sMaxLeafSize || node.mIndex + node.mCount > primitiveCount) {
+				return false;
+			}
+
+			for (std::uint32_t i = node.mIndex; i < node.mIndex + node.mCount; ++i) {
+				const std::uint32_t primitive{ mPrimitiveIndices[i] };
+				++referenceCounts[primitive];
+				if (mLeafByPrimitive[primitive] != nodeIndex || Contains(node.mBox, mPrimitiveBoxes[primitive]) == false) {
+					return false;
+				}
+			}
+		}
+		else {
+			if (node.mIndex <= nodeIndex + 1U || node.mIndex >= nodeCount) {
+				return false;
+			}
+
+			if (mParentByNode[nodeIndex + 1U] != nodeIndex || mParentByNode[node.mIndex] != nodeIndex) {
+				return false;
+			}
+
+			if (Contains(node.mBox, mNodes[nodeIndex + 1U].mBox) == false || Contains(node.mBox, mNodes[node.mIndex].mBox) == false) {
+				return false;
+			}
+		}
+	}
+
+	return std::all_of(referenceCounts.begin(), referenceCounts.end(), [](const std::uint32_t count) { return count == 1U; });
+}
+
+void Bvh::UpdateLeafBounds(const std::uint32_t nodeIndex) noexcept {
+	Node& node{ mNodes[nodeIndex] };
+	ASSERT(node.IsLeaf());
+
+	node.mBox = Aabb::Empty();
+	for (std::uint32_t i = node.mIndex; i < node.mIndex + node.mCount; ++i) {
+		node.mBox.Merge(mPrimitiveBoxes[mPrimitiveIndices[i]]);
+	}
+}
+
+void Bvh::UpdateInteriorBounds(const std::uint32_t nodeIndex) noexcept {
+	Node& node{ mNodes[nodeIndex] };
+	ASSERT(node.IsLeaf() == false);
+
+	node.mBox = mNodes[nodeIndex + 1U].mBox;
+	node.mBox.Merge(mNodes[node.mIndex].mBox);
+}
+
+void Bvh::AppendSubtree(const std::uint32_t nodeIndex, std::vector<std::uint32_t>& result) const noexcept {
+	std::uint32_t stack[sMaxStackSize];
+	std::uint32_t stackSize{ 0U };
+	stack[stackSize++] = nodeIndex;
+	while (stackSize > 0U) {
+		const Node& node{ mNodes[stack[--stackSize]] };
+		if (node.IsLeaf()) {
+			result.insert(result.end(), mPrimitiveIndices.begin() + node.mIndex, mPrimitiveIndices.begin() + node.mIndex + node.mCount);
+		}
+		else {
+			ASSERT(stackSize + 2U <= sMaxStackSize);
+			stack[stackSize++] = node.mIndex;
+			stack[stackSize++] = static_cast<std::uint32_t>(&node - mNodes.data()) + 1U;
+		}
+	}
+}
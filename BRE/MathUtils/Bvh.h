@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <MathUtils/BoundingVolumes.h>
+#include <Utils/DebugUtils.h>
+
+// Bounding volume hierarchy over primitives axis aligned bounding boxes
+// (for example, scene instances world space bounds).
+// It is built with a binned surface area heuristic, in parallel (subtrees
+// are built in different tasks), and flattened in depth first order:
+// the left child of an interior node is the next node, so traversal is
+// mostly linear in memory.
+// It does not depend on DirectXMath or D3D, so it can be built on any platform.
+// Steps:
+// - Call Build() with primitives bounds.
+// - Call Refit() when some primitives move (topology is kept, so quality degrades
+// if they move a lot; call Build() again in that case).
+// - Call queries. They return primitive indices (the index of the box given to Build())
+class Bvh {
+public:
+	// Max primitives count per leaf
+	static const std::uint32_t sMaxLeafSize{ 4U };
+
+	// Bins per axis used to evaluate split candidates
+	static const std::uint32_t sBinCount{ 16U };
+
+	// Primitives count under which subtrees are built in the current task
+	static const std::uint32_t sParallelBuildThreshold{ 4096U };
+
+	// 32 bytes node.
+	struct Node {
+		__forceinline bool IsLeaf() const noexcept { return mCount != 0U; }
+
+		Aabb mBox;
+
+		// Leaf: index of its first primitive index in primitive indices array.
+		// Interior node: right child node index (left child is the next node)
+		std::uint32_t mIndex;
+
+		// Leaf: primitives count. Interior node: 0
+		std::uint32_t mCount;
+	};
+
+	Bvh() = default;
+	~Bvh() = default;
+	Bvh(const Bvh&) = delete;
+	const Bvh& operator=(const Bvh&) = delete;
+	Bvh(Bvh&&) = default;
+	Bvh& operator=(Bvh&&) = default;
+
+	void Build(const Aabb* boxes, const std::uint32_t count) noexcept;
+
+	// Updates moved primitives boxes, and their ancestors bounds.
+	void Refit(const std::uint32_t* primitives, const Aabb* boxes, const std::uint32_t count) noexcept;
+
+	// Updates all primitives boxes (boxes has a box per primitive) and all nodes bounds.
+	void Refit(const Aabb* boxes) noexcept;
+
+	// Queries clear result and fill it with primitives whose boxes intersect the volume.
+
+	// Planes (a, b, c, d) such that a * x + b * y + c * z + d >= 0 inside the volume,
+	// with normalized (a, b, c). Subtrees fully inside all planes are accepted without tests.
+	void FrustumQuery(const float (&planes)[6U][4U], std::vector<std::uint32_t>& result) const noexcept;
+
+	void SphereQuery(const float center[3U], const float radius, std::vector<std::uint32_t>& result) const noexcept;
+
+	void BoxQuery(const Aabb& box, std::vector<std::uint32_t>& result) const noexcept;
+
+	// Primitives whose boxes are hit by the segment [origin, origin + direction * maxDistance]
+	void RayQuery(
+		const float origin[3U],
+		const float direction[3U],
+		const float maxDistance,
+		std::vector<std::uint32_t>& result) const noexcept;
+
+	__forceinline std::uint32_t PrimitiveCount() const noexcept { return static_cast<std::uint32_t>(mPrimitiveBoxes.size()); }
+	__forceinline const std::vector<Node>& Nodes() const noexcept { return mNodes; }
+
+	// Checks nodes bounds contain their children and primitives, and all
+	// primitives are referenced by exactly one leaf.
+	bool ValidateData() const noexcept;
+
+private:
+	void UpdateLeafBounds(const std::uint32_t nodeIndex) noexcept;
+	void UpdateInteriorBounds(const std::uint32_t nodeIndex) noexcept;
+	void AppendSubtree(const std::uint32_t nodeIndex, std::vector<std::uint32_t>& result) const noexcept;
+
+	std::vector<Node> mNodes;
+
+	// Leaves reference contiguous ranges of this array
+	std::vector<std::uint32_t> mPrimitiveIndices;
+	std::vector<Aabb> mPrimitiveBoxes;
+
+	// Used by incremental refit
+	std::vector<std::uint32_t> mParentByNode;
+	std::vector<std::uint32_t> mLeafByPrimitive;
+};
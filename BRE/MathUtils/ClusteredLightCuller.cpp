@@ -0,0 +1,208 @@
+#include "ClusteredLightCuller.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <tbb/parallel_for.h>
+
+namespace {
+	const std::uint32_t sSliceClusterCount{ ClusteredLightCuller::sClusterCountX * ClusteredLightCuller::sClusterCountY };
+
+	// Tile index of a coordinate in [0, tileCount] (tile units), clamped to valid tiles
+	__forceinline std::uint32_t TileIndex(const float coord, const std::uint32_t tileCount) noexcept {
+		const float maxTile{ static_cast<float>(tileCount - 1U) };
+		const float clampedCoord{ std::min(std::max(coord, 0.0f), maxTile) };
+		return static_cast<std::uint32_t>(clampedCoord);
+	}
+
+	__forceinline bool SphereIntersectsBox(const float center[3U], const float radius, const Aabb& box) noexcept {
+		float sqrDist{ 0.0f };
+		for (std::uint32_t j = 0U; j < 3U; ++j) {
+			const float d{ std::max(box.mMin[j] - center[j], 0.0f) + std::max(center[j] - box.mMax[j], 0.0f) };
+			sqrDist += d * d;
+		}
+
+		return sqrDist <= radius * radius;
+	}
+}
+
+void ClusteredLightCuller::SetProjection(const float nearZ, const float farZ, const float proj00, const float proj11) noexcept {
+	ASSERT(0.0f < nearZ && nearZ < farZ);
+	ASSERT(proj00 > 0.0f);
+	ASSERT(proj11 > 0.0f);
+
+	if (mClusterBoxes.empty() == false &&
+		nearZ == mNearZ &&
+		farZ == mFarZ &&
+		proj00 == mProj00 &&
+		proj11 == mProj11) {
+		return;
+	}
+
+	mNearZ = nearZ;
+	mFarZ = farZ;
+	mProj00 = proj00;
+	mProj11 = proj11;
+
+	// Exponential depth slices: slice k starts at nearZ * (farZ / nearZ) ^ (k / sClusterCountZ)
+	const float logDepthRange{ std::log(farZ / nearZ) };
+	mDepthSliceScale = sClusterCountZ / logDepthRange;
+	mDepthSliceBias = -(sClusterCountZ * std::log(nearZ)) / logDepthRange;
+	for (std::uint32_t k = 0U; k <= sClusterCountZ; ++k) {
+		mSliceDepths[k] = nearZ * std::pow(farZ / nearZ, static_cast<float>(k) / sClusterCountZ);
+	}
+	mSliceDepths[sClusterCountZ] = farZ;
+
+	// Cluster boxes enclose the 8 corners of the tile frustum between slice depths.
+	// At view depth z, the view space x of a point with NDC x is ndcX * z / proj00.
+	mClusterBoxes.resize(sClusterCount);
+	for (std::uint32_t z = 0U; z < sClusterCountZ; ++z) {
+		const float nearDepth{ mSliceDepths[z] };
+		const float farDepth{ mSliceDepths[z + 1U] };
+		for (std::uint32_t y = 0U; y < sClusterCountY; ++y) {
+			// Tiles rows go down the screen, and NDC y goes up
+			const float topNdcY{ 1.0f - 2.0f * y / sClusterCountY };
+			const float bottomNdcY{ 1.0f - 2.0f * (y + 1U) / sClusterCountY };
+			for (std::uint32_t x = 0U; x < sClusterCountX; ++x) {
+				const float leftNdcX{ 2.0f * x / sClusterCountX - 1.0f };
+				const float rightNdcX{ 2.0f * (x + 1U) / sClusterCountX - 1.0f };
+
+				Aabb& box(mClusterBoxes[ClusterIndex(x, y, z)]);
+				box.mMin[0U] = std::min(leftNdcX * nearDepth, leftNdcX * farDepth) / proj00;
+				box.mMax[0U] = std::max(rightNdcX * nearDepth, rightNdcX * farDepth) / proj00;
+				box.mMin[1U] = std::min(bottomNdcY * nearDepth, bottomNdcY * farDepth) / proj11;
+				box.mMax[1U] = std::max(topNdcY * nearDepth, topNdcY * farDepth) / proj11;
+				box.mMin[2U] = nearDepth;
+				box.mMax[2U] = farDepth;
+			}
+		}
+	}
+}
+
+void ClusteredLightCuller::Build(const void* spheres, const std::uint32_t count, const std::size_t stride) noexcept {
+	ASSERT(mClusterBoxes.size() == sClusterCount);
+	ASSERT(spheres != nullptr || count == 0U);
+	ASSERT(stride >= sizeof(float) * 4UL);
+
+	mSpheres = static_cast<const std::uint8_t*>(spheres);
+	mSphereCount = count;
+	mSphereStride = stride;
+	mClusterRanges.assign(sClusterCount * 2UL, 0U);
+
+	tbb::parallel_for(tbb::blocked_range<std::uint32_t>(0U, sClusterCountZ, 1U),
+		[this](const tbb::blocked_range<std::uint32_t>& r) {
+		for (std::uint32_t slice = r.begin(); slice != r.end(); ++slice) {
+			BuildDepthSlice(slice);
+		}
+	}
+	);
+
+	// Concatenate slices light indices
+	std::uint32_t sliceOffsets[sClusterCountZ];
+	std::uint32_t indexCount{ 0U };
+	for (std::uint32_t slice = 0U; slice < sClusterCountZ; ++slice) {
+		sliceOffsets[slice] = indexCount;
+		indexCount += static_cast<std::uint32_t>(mSliceLightIndices[slice].size());
+	}
+	mLightIndices.resize(indexCount);
+
+	tbb::parallel_for(tbb::blocked_range<std::uint32_t>(0U, sClusterCountZ, 1U),
+		[this, &sliceOffsets](const tbb::blocked_range<std::uint32_t>& r) {
+		for (std::uint32_t slice = r.begin(); slice != r.end(); ++slice) {
+			const std::vector<std::uint32_t>& sliceIndices(mSliceLightIndices[slice]);
+			if (sliceIndices.empty()) {
+				continue;
+			}
+
+			std::memcpy(mLightIndices.data() + sliceOffsets[slice], sliceIndices.data(), sliceIndices.size() * sizeof(std::uint32_t));
+			const std::uint32_t firstCluster{ slice * sSliceClusterCount };
+			for (std::uint32_t i = 0U; i < sSliceClusterCount; ++i) {
+				mClusterRanges[(firstCluster + i) * 2UL] += sliceOffsets[slice];
+			}
+		}
+	}
+	);
+
+	mSpheres = nullptr;
+}
+
+std::uint32_t ClusteredLightCuller::MaxClusterLightCount() const noexcept {
+	std::uint32_t maxCount{ 0U };
+	for (std::size_t i = 1UL; i < mClusterRanges.size(); i += 2UL) {
+		maxCount = std::max(maxCount, mClusterRanges[i]);
+	}
+
+	return maxCount;
+}
+
+void ClusteredLightCuller::BuildDepthSlice(const std::uint32_t slice) noexcept {
+	ASSERT(slice < sClusterCountZ);
+
+	const float nearDepth{ mSliceDepths[slice] };
+	const float farDepth{ mSliceDepths[slice + 1U] };
+	std::uint32_t* ranges{ mClusterRanges.data() + slice * sSliceClusterCount * 2UL };
+	std::vector<std::uint32_t>& pairs(mSlicePairs[slice]);
+	pairs.clear();
+
+	// Find (cluster, light) pairs, and lights count per cluster
+	for (std::uint32_t i = 0U; i < mSphereCount; ++i) {
+		float sphere[4U];
+		std::memcpy(sphere, mSpheres + i * mSphereStride, sizeof(sphere));
+		const float radius{ sphere[3U] };
+
+		// Depth range of the sphere inside the slice
+		const float minZ{ std::max(sphere[2U] - radius, nearDepth) };
+		const float maxZ{ std::min(sphere[2U] + radius, farDepth) };
+		if (minZ > maxZ) {
+			continue;
+		}
+
+		// NDC rectangle of the sphere bounding box in that depth range.
+		// x / z is minimum at the farthest depth if x is positive, and at the nearest one otherwise.
+		const float left{ sphere[0U] - radius };
+		const float right{ sphere[0U] + radius };
+		const float bottom{ sphere[1U] - radius };
+		const float top{ sphere[1U] + radius };
+		const float minNdcX{ mProj00 * (left >= 0.0f ? left / maxZ : left / minZ) };
+		const float maxNdcX{ mProj00 * (right >= 0.0f ? right / minZ : right / maxZ) };
+		const float minNdcY{ mProj11 * (bottom >= 0.0f ? bottom / maxZ : bottom / minZ) };
+		const float maxNdcY{ mProj11 * (top >= 0.0f ? top / minZ : top / maxZ) };
+		if (minNdcX > 1.0f || maxNdcX < -1.0f || minNdcY > 1.0f || maxNdcY < -1.0f) {
+			continue;
+		}
+
+		const std::uint32_t x0{ TileIndex((minNdcX * 0.5f + 0.5f) * sClusterCountX, sClusterCountX) };
+		const std::uint32_t x1{ TileIndex((maxNdcX * 0.5f + 0.5f) * sClusterCountX, sClusterCountX) };
+		const std::uint32_t y0{ TileIndex((0.5f - maxNdcY * 0.5f) * sClusterCountY, sClusterCountY) };
+		const std::uint32_t y1{ TileIndex((0.5f - minNdcY * 0.5f) * sClusterCountY, sClusterCountY) };
+		for (std::uint32_t y = y0; y <= y1; ++y) {
+			for (std::uint32_t x = x0; x <= x1; ++x) {
+				const std::uint32_t sliceCluster{ y * sClusterCountX + x };
+				std::uint32_t& lightCount(ranges[sliceCluster * 2UL + 1UL]);
+				if (lightCount < sMaxLightsPerCluster &&
+					SphereIntersectsBox(sphere, radius, mClusterBoxes[ClusterIndex(x, y, slice)])) {
+					++lightCount;
+					pairs.push_back(sliceCluster);
+					pairs.push_back(i);
+				}
+			}
+		}
+	}
+
+	// Offsets relative to the slice
+	std::uint32_t cursors[sSliceClusterCount];
+	std::uint32_t indexCount{ 0U };
+	for (std::uint32_t i = 0U; i < sSliceClusterCount; ++i) {
+		ranges[i * 2UL] = indexCount;
+		cursors[i] = indexCount;
+		indexCount += ranges[i * 2UL + 1UL];
+	}
+
+	// Pairs were found in lights order, so each cluster lights are sorted
+	std::vector<std::uint32_t>& sliceIndices(mSliceLightIndices[slice]);
+	sliceIndices.resize(indexCount);
+	const std::size_t pairsSize{ pairs.size() };
+	for (std::size_t i = 0UL; i < pairsSize; i += 2UL) {
+		sliceIndices[cursors[pairs[i]]++] = pairs[i + 1UL];
+	}
+}
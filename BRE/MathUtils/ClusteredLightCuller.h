@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <MathUtils/BoundingVolumes.h>
+#include <Utils/DebugUtils.h>
+
+// Assigns light spheres (in view space) to clusters (froxels) of the view frustum.
+// Clusters are screen tiles subdivided in depth slices, whose depths increase
+// exponentially from near plane to far plane, so the slice of a view depth z is:
+// floor(log(z) * DepthSliceScale() + DepthSliceBias())
+// The result is a light index list, and an (offset, count) range of it per cluster.
+// Depth slices are built in parallel.
+// View space is left handed (z increases forward) and projection is symmetric (D3D's perspective fov).
+// It does not depend on DirectXMath or D3D, so it can be built on any platform.
+// Steps:
+// - Call SetProjection() (each frame is fine, it does nothing if projection did not change)
+// - Call Build() with the view space light spheres of the frame
+// - Upload ClusterRanges() and LightIndices()
+class ClusteredLightCuller {
+public:
+	static const std::uint32_t sClusterCountX{ 16U };
+	static const std::uint32_t sClusterCountY{ 9U };
+	static const std::uint32_t sClusterCountZ{ 24U };
+	static const std::uint32_t sClusterCount{ sClusterCountX * sClusterCountY * sClusterCountZ };
+
+	// Lights beyond this count in a cluster are ignored.
+	// Light indices count is never greater than sClusterCount * sMaxLightsPerCluster.
+	static const std::uint32_t sMaxLightsPerCluster{ 256U };
+
+	ClusteredLightCuller() = default;
+	~ClusteredLightCuller() = default;
+	ClusteredLightCuller(const ClusteredLightCuller&) = delete;
+	const ClusteredLightCuller& operator=(const ClusteredLightCuller&) = delete;
+	ClusteredLightCuller(ClusteredLightCuller&&) = default;
+	ClusteredLightCuller& operator=(ClusteredLightCuller&&) = default;
+
+	// proj00 and proj11 are the x and y scales of the projection matrix
+	void SetProjection(const float nearZ, const float farZ, const float proj00, const float proj11) noexcept;
+
+	// spheres points to the first light sphere (view space center and radius, 4 floats), and
+	// stride is the byte size between consecutive spheres.
+	void Build(const void* spheres, const std::uint32_t count, const std::size_t stride) noexcept;
+
+	// Index of the cluster of a tile and a depth slice
+	__forceinline static std::uint32_t ClusterIndex(const std::uint32_t x, const std::uint32_t y, const std::uint32_t z) noexcept {
+		return (z * sClusterCountY + y) * sClusterCountX + x;
+	}
+
+	__forceinline float DepthSliceScale() const noexcept { return mDepthSliceScale; }
+	__forceinline float DepthSliceBias() const noexcept { return mDepthSliceBias; }
+
+	// 2 values per cluster: offset in light indices and lights count
+	__forceinline const std::vector<std::uint32_t>& ClusterRanges() const noexcept { return mClusterRanges; }
+	__forceinline const std::vector<std::uint32_t>& LightIndices() const noexcept { return mLightIndices; }
+
+	// View space bounds of the cluster
+	__forceinline const Aabb& ClusterBox(const std::uint32_t clusterIndex) const noexcept { ASSERT(clusterIndex < sClusterCount); return mClusterBoxes[clusterIndex]; }
+
+	// Max lights count in a cluster in the last Build()
+	std::uint32_t MaxClusterLightCount() const noexcept;
+
+private:
+	void BuildDepthSlice(const std::uint32_t slice) noexcept;
+
+	float mNearZ{ 0.0f };
+	float mFarZ{ 0.0f };
+	float mProj00{ 0.0f };
+	float mProj11{ 0.0f };
+	float mDepthSliceScale{ 0.0f };
+	float mDepthSliceBias{ 0.0f };
+
+	// Depth of the near plane of each slice, and far plane of the last slice
+	float mSliceDepths[sClusterCountZ + 1U]{};
+
+	std::vector<Aabb> mClusterBoxes;
+
+	// Input of current Build()
+	const std::uint8_t* mSpheres{ nullptr };
+	std::uint32_t mSphereCount{ 0U };
+	std::size_t mSphereStride{ 0UL };
+
+	// Light indices of each depth slice, in cluster order (offsets in mClusterRanges
+	// are relative to the slice until all slices are built)
+	std::vector<std::uint32_t> mSliceLightIndices[sClusterCountZ];
+
+	// (cluster index in slice, light index) pairs found in each depth slice
+	std::vector<std::uint32_t> mSlicePairs[sClusterCountZ];
+
+	std::vector<std::uint32_t> mClusterRanges;
+	std::vector<std::uint32_t> mLightIndices;
+};
@@ -0,0 +1,164 @@
+#include "FrustumCuller.h"
+
+#include <cmath>
+#include <limits>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(_M_X64) || defined(__SSE2__)
+#include <xmmintrin.h>
+#endif
+
+namespace {
+	// Padding spheres radius. They are outside of any plane, so they are never visible.
+	const float sPaddingRadius{ -std::numeric_limits<float>::max() };
+
+	std::uint32_t PaddedCount(const std::uint32_t count) noexcept {
+		return (count + FrustumCuller::sSimdWidth - 1U) & ~(FrustumCuller::sSimdWidth - 1U);
+	}
+}
+
+void FrustumCuller::SetViewProjection(const float viewProj[16U]) noexcept {
+	ASSERT(viewProj != nullptr);
+
+	// Gribb & Hartmann. As clip = v * M, planes are combinations of M columns.
+	// M(i, j) is viewProj[i * 4 + j].
+	for (std::uint32_t i = 0U; i < 4U; ++i) {
+		const float c0{ viewProj[i * 4U] };
+		const float c1{ viewProj[i * 4U + 1U] };
+		const float c2{ viewProj[i * 4U + 2U] };
+		const float c3{ viewProj[i * 4U + 3U] };
+		mPlanes[0U][i] = c3 + c0; // Left
+		mPlanes[1U][i] = c3 - c0; // Right
+		mPlanes[2U][i] = c3 + c1; // Bottom
+		mPlanes[3U][i] = c3 - c1; // Top
+		mPlanes[4U][i] = c2; // Near
+		mPlanes[5U][i] = c3 - c2; // Far
+	}
+
+	// Normalize, so plane equation returns signed distances (to compare with radius)
+	for (std::uint32_t i = 0U; i < sPlaneCount; ++i) {
+		float* plane{ mPlanes[i] };
+		const float length{ std::sqrt(plane[0U] * plane[0U] + plane[1U] * plane[1U] + plane[2U] * plane[2U]) };
+		ASSERT(length > 0.0f);
+		const float invLength{ 1.0f / length };
+		for (std::uint32_t j = 0U; j < 4U; ++j) {
+			plane[j] *= invLength;
+		}
+	}
+}
+
+void FrustumCuller::ResizeSpheres(const std::uint32_t count) noexcept {
+	const std::uint32_t paddedCount{ PaddedCount(count) };
+	mCenterX.resize(paddedCount, 0.0f);
+	mCenterY.resize(paddedCount, 0.0f);
+	mCenterZ.resize(paddedCount, 0.0f);
+	mRadius.resize(paddedCount, sPaddingRadius);
+
+	// Previous spheres beyond the new count become padding
+	for (std::uint32_t i = count; i < paddedCount; ++i) {
+		mRadius[i] = sPaddingRadius;
+	}
+
+	mSphereCount = count;
+	mVisibleCount = 0U;
+}
+
+void FrustumCuller::SetSphere(const std::uint32_t index, const float center[3U], const float radius) noexcept {
+	ASSERT(index < mSphereCount);
+	ASSERT(center != nullptr);
+	ASSERT(radius >= 0.0f);
+
+	mCenterX[index] = center[0U];
+	mCenterY[index] = center[1U];
+	mCenterZ[index] = center[2U];
+	mRadius[index] = radius;
+}
+
+std::uint32_t FrustumCuller::Cull(std::vector<std::uint32_t>& visibleIndices) noexcept {
+	const std::uint32_t paddedCount{ static_cast<std::uint32_t>(mRadius.size()) };
+
+	// Indices are written without branches (the slot is overwritten if the sphere is not visible),
+	// so there must be room for a whole SIMD group.
+	visibleIndices.resize(paddedCount);
+	std::uint32_t* indices{ visibleIndices.data() };
+	std::uint32_t visibleCount{ 0U };
+
+#if defined(__AVX__)
+	__m256 planes[sPlaneCount][4U];
+	for (std::uint32_t i = 0U; i < sPlaneCount; ++i) {
+		for (std::uint32_t j = 0U; j < 4U; ++j) {
+			planes[i][j] = _mm256_set1_ps(mPlanes[i][j]);
+		}
+	}
+
+	const __m256 zero{ _mm256_setzero_ps() };
+	for (std::uint32_t i = 0U; i < paddedCount; i += 8U) {
+		const __m256 x{ _mm256_loadu_ps(mCenterX.data() + i) };
+		const __m256 y{ _mm256_loadu_ps(mCenterY.data() + i) };
+		const __m256 z{ _mm256_loadu_ps(mCenterZ.data() + i) };
+		const __m256 r{ _mm256_loadu_ps(mRadius.data() + i) };
+
+		__m256 inside{ _mm256_cmp_ps(r, zero, _CMP_GE_OQ) };
+		for (std::uint32_t p = 0U; p < sPlaneCount; ++p) {
+			__m256 dist{ _mm256_add_ps(_mm256_mul_ps(planes[p][0U], x), planes[p][3U]) };
+			dist = _mm256_add_ps(dist, _mm256_mul_ps(planes[p][1U], y));
+			dist = _mm256_add_ps(dist, _mm256_mul_ps(planes[p][2U], z));
+			inside = _mm256_and_ps(inside, _mm256_cmp_ps(_mm256_add_ps(dist, r), zero, _CMP_GE_OQ));
+		}
+
+		const std::uint32_t mask{ static_cast<std::uint32_t>(_mm256_movemask_ps(inside)) };
+		for (std::uint32_t j = 0U; j < 8U; ++j) {
+			indices[visibleCount] = i + j;
+			visibleCount += (mask >> j) & 1U;
+		}
+	}
+#elif defined(_M_X64) || defined(__SSE2__)
+	__m128 planes[sPlaneCount][4U];
+	for (std::uint32_t i = 0U; i < sPlaneCount; ++i) {
+		for (std::uint32_t j = 0U; j < 4U; ++j) {
+			planes[i][j] = _mm_set1_ps(mPlanes[i][j]);
+		}
+	}
+
+	const __m128 zero{ _mm_setzero_ps() };
+	for (std::uint32_t i = 0U; i < paddedCount; i += 4U) {
+		const __m128 x{ _mm_loadu_ps(mCenterX.data() + i) };
+		const __m128 y{ _mm_loadu_ps(mCenterY.data() + i) };
+		const __m128 z{ _mm_loadu_ps(mCenterZ.data() + i) };
+		const __m128 r{ _mm_loadu_ps(mRadius.data() + i) };
+
+		__m128 inside{ _mm_cmpge_ps(r, zero) };
+		for (std::uint32_t p = 0U; p < sPlaneCount; ++p) {
+			__m128 dist{ _mm_add_ps(_mm_mul_ps(planes[p][0U], x), planes[p][3U]) };
+			dist = _mm_add_ps(dist, _mm_mul_ps(planes[p][1U], y));
+			dist = _mm_add_ps(dist, _mm_mul_ps(planes[p][2U], z));
+			inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(dist, r), zero));
+		}
+
+		const std::uint32_t mask{ static_cast<std::uint32_t>(_mm_movemask_ps(inside)) };
+		for (std::uint32_t j = 0U; j < 4U; ++j) {
+			indices[visibleCount] = i + j;
+			visibleCount += (mask >> j) & 1U;
+		}
+	}
+#else
+	for (std::uint32_t i = 0U; i < paddedCount; ++i) {
+		bool inside{ mRadius[i] >= 0.0f };
+		for (std::uint32_t p = 0U; p < sPlaneCount; ++p) {
+			const float* plane{ mPlanes[p] };
+			const float dist{ plane[0U] * mCenterX[i] + plane[1U] * mCenterY[i] + plane[2U] * mCenterZ[i] + plane[3U] };
+			inside = inside && (dist + mRadius[i] >= 0.0f);
+		}
+
+		indices[visibleCount] = i;
+		visibleCount += inside ? 1U : 0U;
+	}
+#endif
+
+	ASSERT(visibleCount <= mSphereCount);
+	visibleIndices.resize(visibleCount);
+	mVisibleCount = visibleCount;
+
+	return visibleCount;
+}
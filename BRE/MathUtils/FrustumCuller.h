@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <Utils/DebugUtils.h>
+
+// Culls bounding spheres against the 6 planes of a view frustum.
+// Spheres are stored in SoA layout (one array per component), so
+// they are tested 8 (AVX) or 4 (SSE) at a time.
+// It does not depend on DirectXMath or D3D, so it can be built on any platform.
+// Steps:
+// - Call ResizeSpheres() and SetSphere() for each sphere (world space)
+// - Call SetViewProjection() each frame
+// - Call Cull() to get the indices of the visible spheres
+class FrustumCuller {
+public:
+	static const std::uint32_t sPlaneCount{ 6U };
+
+	// Spheres arrays are padded to this count of elements
+	static const std::uint32_t sSimdWidth{ 8U };
+
+	FrustumCuller() = default;
+	~FrustumCuller() = default;
+	FrustumCuller(const FrustumCuller&) = delete;
+	const FrustumCuller& operator=(const FrustumCuller&) = delete;
+	FrustumCuller(FrustumCuller&&) = default;
+	FrustumCuller& operator=(FrustumCuller&&) = default;
+
+	// Extracts normalized frustum planes from a row major view projection matrix
+	// (row vectors, as DirectXMath), with clip space depth in [0, 1].
+	void SetViewProjection(const float viewProj[16U]) noexcept;
+
+	// New spheres (if any) are never visible until they are set.
+	void ResizeSpheres(const std::uint32_t count) noexcept;
+
+	void SetSphere(const std::uint32_t index, const float center[3U], const float radius) noexcept;
+
+	// Stores the indices of the spheres that intersect or are inside the frustum,
+	// in increasing order. Returns visible spheres count.
+	std::uint32_t Cull(std::vector<std::uint32_t>& visibleIndices) noexcept;
+
+	// Planes of the last SetViewProjection() call, to use them with other
+	// culling structures (like Bvh)
+	__forceinline const float (&Planes() const noexcept)[sPlaneCount][4U] { return mPlanes; }
+
+	__forceinline std::uint32_t SphereCount() const noexcept { return mSphereCount; }
+
+	// Counters of the last Cull() call
+	__forceinline std::uint32_t VisibleCount() const noexcept { return mVisibleCount; }
+	__forceinline std::uint32_t CulledCount() const noexcept { return mSphereCount - mVisibleCount; }
+
+private:
+	// Planes (a, b, c, d) such that a * x + b * y + c * z + d >= 0 inside the frustum.
+	float mPlanes[sPlaneCount][4U]{};
+
+	std::vector<float> mCenterX;
+	std::vector<float> mCenterY;
+	std::vector<float> mCenterZ;
+	std::vector<float> mRadius;
+
+	std::uint32_t mSphereCount{ 0U };
+	std::uint32_t mVisibleCount{ 0U };
+};
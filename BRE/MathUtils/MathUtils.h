@@ -1,8 +1,11 @@
 #pragma once
 
+#ifdef _WIN32
 #include <Windows.h>
+#endif
 #include <DirectXMath.h>
 #include <cstdint>
+#include <cstdlib>
 
 class MathUtils {
 public:
@@ -0,0 +1,192 @@
+#include "SphericalHarmonics.h"
+
+#include <cmath>
+#include <cstddef>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#include <xmmintrin.h>
+#define SPHERICAL_HARMONICS_SSE 1
+#endif
+
+#include <Utils/DebugUtils.h>
+
+namespace {
+	// Normalization constants of real spherical harmonics basis
+	const float sY00{ 0.282095f };
+	const float sY1{ 0.488603f };
+	const float sY2{ 1.092548f };
+	const float sY20{ 0.315392f };
+	const float sY22{ 0.546274f };
+
+	// Clamped cosine lobe convolution factors by band (A0 = PI, A1 = 2 * PI / 3, A2 = PI / 4), divided by PI
+	const float sCosineLobeBandFactors[3U]{ 1.0f, 2.0f / 3.0f, 0.25f };
+
+	// Band of each coefficient
+	const std::uint32_t sCoefficientBands[SphericalHarmonics::sCoefficientCount]{ 0U, 1U, 1U, 1U, 2U, 2U, 2U, 2U, 2U };
+
+	// Integral of the projected area element from face center to (x, y), in [-1, 1] face coordinates
+	float AreaElement(const float x, const float y) noexcept {
+		return std::atan2(x * y, std::sqrt(x * x + y * y + 1.0f));
+	}
+}
+
+namespace SphericalHarmonics {
+	Coefficients& Coefficients::operator+=(const Coefficients& coefficients) noexcept {
+		for (std::uint32_t i = 0U; i < sCoefficientCount; ++i) {
+			for (std::uint32_t j = 0U; j < 4U; ++j) {
+				mValues[i][j] += coefficients.mValues[i][j];
+			}
+		}
+
+		return *this;
+	}
+
+	void EvaluateBasis(const float direction[3U], float basis[sCoefficientCount]) noexcept {
+		ASSERT(direction != nullptr);
+		ASSERT(basis != nullptr);
+
+		const float x{ direction[0U] };
+		const float y{ direction[1U] };
+		const float z{ direction[2U] };
+
+		basis[0U] = sY00;
+		basis[1U] = sY1 * y;
+		basis[2U] = sY1 * z;
+		basis[3U] = sY1 * x;
+		basis[4U] = sY2 * x * y;
+		basis[5U] = sY2 * y * z;
+		basis[6U] = sY20 * (3.0f * z * z - 1.0f);
+		basis[7U] = sY2 * x * z;
+		basis[8U] = sY22 * (x * x - y * y);
+	}
+
+	void CubeMapTexelDirection(
+		const std::uint32_t face,
+		const std::uint32_t x,
+		const std::uint32_t y,
+		const std::uint32_t faceSize,
+		float direction[3U]) noexcept
+	{
+		ASSERT(face < sCubeMapFaceCount);
+		ASSERT(x < faceSize);
+		ASSERT(y < faceSize);
+		ASSERT(direction != nullptr);
+
+		const float invFaceSize{ 1.0f / static_cast<float>(faceSize) };
+		const float u{ 2.0f * (static_cast<float>(x) + 0.5f) * invFaceSize - 1.0f };
+		const float v{ 2.0f * (static_cast<float>(y) + 0.5f) * invFaceSize - 1.0f };
+
+		switch (face) {
+		case 0U: direction[0U] = 1.0f; direction[1U] = -v; direction[2U] = -u; break;
+		case 1U: direction[0U] = -1.0f; direction[1U] = -v; direction[2U] = u; break;
+		case 2U: direction[0U] = u; direction[1U] = 1.0f; direction[2U] = v; break;
+		case 3U: direction[0U] = u; direction[1U] = -1.0f; direction[2U] = -v; break;
+		case 4U: direction[0U] = u; direction[1U] = -v; direction[2U] = 1.0f; break;
+		default: direction[0U] = -u; direction[1U] = -v; direction[2U] = -1.0f; break;
+		}
+
+		const float invLength{ 1.0f / std::sqrt(direction[0U] * direction[0U] + direction[1U] * direction[1U] + direction[2U] * direction[2U]) };
+		direction[0U] *= invLength;
+		direction[1U] *= invLength;
+		direction[2U] *= invLength;
+	}
+
+	float CubeMapTexelSolidAngle(const std::uint32_t x, const std::uint32_t y, const std::uint32_t faceSize) noexcept {
+		ASSERT(x < faceSize);
+		ASSERT(y < faceSize);
+
+		const float invFaceSize{ 1.0f / static_cast<float>(faceSize) };
+		const float u0{ 2.0f * static_cast<float>(x) * invFaceSize - 1.0f };
+		const float v0{ 2.0f * static_cast<float>(y) * invFaceSize - 1.0f };
+		const float u1{ u0 + 2.0f * invFaceSize };
+		const float v1{ v0 + 2.0f * invFaceSize };
+
+		return AreaElement(u0, v0) - AreaElement(u0, v1) - AreaElement(u1, v0) + AreaElement(u1, v1);
+	}
+
+	void ProjectCubeMapRows(
+		const float* faceTexels,
+		const std::uint32_t face,
+		const std::uint32_t faceSize,
+		const std::uint32_t rowBegin,
+		const std::uint32_t rowEnd,
+		Coefficients& coefficients) noexcept
+	{
+		ASSERT(faceTexels != nullptr);
+		ASSERT(face < sCubeMapFaceCount);
+		ASSERT(rowBegin <= rowEnd);
+		ASSERT(rowEnd <= faceSize);
+
+		float direction[3U];
+		float basis[sCoefficientCount];
+
+#if SPHERICAL_HARMONICS_SSE
+		__m128 sums[sCoefficientCount];
+		for (std::uint32_t i = 0U; i < sCoefficientCount; ++i) {
+			sums[i] = _mm_loadu_ps(coefficients.mValues[i]);
+		}
+#endif
+
+		for (std::uint32_t y = rowBegin; y < rowEnd; ++y) {
+			const float* texel{ faceTexels + static_cast<std::size_t>(y) * faceSize * 4U };
+			for (std::uint32_t x = 0U; x < faceSize; ++x, texel += 4U) {
+				CubeMapTexelDirection(face, x, y, faceSize, direction);
+				EvaluateBasis(direction, basis);
+				const float solidAngle{ CubeMapTexelSolidAngle(x, y, faceSize) };
+
+#if SPHERICAL_HARMONICS_SSE
+				const __m128 radiance{ _mm_mul_ps(_mm_loadu_ps(texel), _mm_set1_ps(solidAngle)) };
+				for (std::uint32_t i = 0U; i < sCoefficientCount; ++i) {
+					sums[i] = _mm_add_ps(sums[i], _mm_mul_ps(radiance, _mm_set1_ps(basis[i])));
+				}
+#else
+				for (std::uint32_t i = 0U; i < sCoefficientCount; ++i) {
+					const float weight{ basis[i] * solidAngle };
+					for (std::uint32_t j = 0U; j < 3U; ++j) {
+						coefficients.mValues[i][j] += texel[j] * weight;
+					}
+				}
+#endif
+			}
+		}
+
+#if SPHERICAL_HARMONICS_SSE
+		for (std::uint32_t i = 0U; i < sCoefficientCount; ++i) {
+			_mm_storeu_ps(coefficients.mValues[i], sums[i]);
+			coefficients.mValues[i][3U] = 0.0f;
+		}
+#endif
+	}
+
+	void ConvolveCosineLobe(Coefficients& coefficients) noexcept {
+		for (std::uint32_t i = 0U; i < sCoefficientCount; ++i) {
+			const float factor{ sCosineLobeBandFactors[sCoefficientBands[i]] };
+			for (std::uint32_t j = 0U; j < 3U; ++j) {
+				coefficients.mValues[i][j] *= factor;
+			}
+		}
+	}
+
+	void SetConstant(const float rgb[3U], Coefficients& coefficients) noexcept {
+		ASSERT(rgb != nullptr);
+
+		coefficients = Coefficients{};
+		for (std::uint32_t j = 0U; j < 3U; ++j) {
+			coefficients.mValues[0U][j] = rgb[j] / sY00;
+		}
+	}
+
+	void Evaluate(const Coefficients& coefficients, const float direction[3U], float rgb[3U]) noexcept {
+		ASSERT(rgb != nullptr);
+
+		float basis[sCoefficientCount];
+		EvaluateBasis(direction, basis);
+
+		for (std::uint32_t j = 0U; j < 3U; ++j) {
+			rgb[j] = 0.0f;
+			for (std::uint32_t i = 0U; i < sCoefficientCount; ++i) {
+				rgb[j] += coefficients.mValues[i][j] * basis[i];
+			}
+		}
+	}
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+
+// Order 3 (L2, 9 coefficients) real spherical harmonics of RGB functions on the sphere,
+// used to store the diffuse irradiance of a sky box instead of a diffuse irradiance cube map.
+// Texels are accumulated with SSE (when available).
+// It does not depend on DirectXMath or D3D, so it can be built on any platform.
+// Steps:
+// - Call ProjectCubeMapRows() for all rows of all faces of a radiance cube map. Rows
+// can be projected in parallel to different Coefficients, and then added.
+// - Call ConvolveCosineLobe() to convert radiance to diffuse irradiance.
+// - Call Evaluate() (or EvaluateIrradianceSH() in shaders) with a world space direction.
+namespace SphericalHarmonics {
+	static const std::uint32_t sCoefficientCount{ 9U };
+	static const std::uint32_t sCubeMapFaceCount{ 6U };
+
+	// RGB coefficients, each one padded to 4 floats (w is always zero), so it has
+	// the layout of a float4 array in a constant buffer (IrradianceSH in shaders).
+	struct Coefficients {
+		Coefficients& operator+=(const Coefficients& coefficients) noexcept;
+
+		float mValues[sCoefficientCount][4U]{};
+	};
+
+	// direction must be normalized
+	void EvaluateBasis(const float direction[3U], float basis[sCoefficientCount]) noexcept;
+
+	// Normalized direction through texel center (x, y) of a face of faceSize x faceSize texels.
+	// Faces are in D3D order (+X, -X, +Y, -Y, +Z, -Z) and y grows downwards.
+	void CubeMapTexelDirection(
+		const std::uint32_t face,
+		const std::uint32_t x,
+		const std::uint32_t y,
+		const std::uint32_t faceSize,
+		float direction[3U]) noexcept;
+
+	// Solid angle of texel (x, y) of a face. The sum of all texels of all faces is 4 * PI.
+	float CubeMapTexelSolidAngle(const std::uint32_t x, const std::uint32_t y, const std::uint32_t faceSize) noexcept;
+
+	// Adds the projection of rows [rowBegin, rowEnd) of a face to coefficients.
+	// faceTexels are faceSize x faceSize RGBA floats (row major). Alpha is ignored.
+	void ProjectCubeMapRows(
+		const float* faceTexels,
+		const std::uint32_t face,
+		const std::uint32_t faceSize,
+		const std::uint32_t rowBegin,
+		const std::uint32_t rowEnd,
+		Coefficients& coefficients) noexcept;
+
+	// Convolves radiance with the clamped cosine lobe, divided by PI. Then Evaluate() returns
+	// irradiance / PI, the same value a diffuse irradiance cube map stores (Lambertian outgoing
+	// radiance of a white surface).
+	void ConvolveCosineLobe(Coefficients& coefficients) noexcept;
+
+	// Coefficients of a constant function, so Evaluate() returns rgb in all directions
+	// (ConvolveCosineLobe() does not change them).
+	void SetConstant(const float rgb[3U], Coefficients& coefficients) noexcept;
+
+	// direction must be normalized
+	void Evaluate(const Coefficients& coefficients, const float direction[3U], float rgb[3U]) noexcept;
+}
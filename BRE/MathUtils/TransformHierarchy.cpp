@@ -0,0 +1,298 @@
+#include "TransformHierarchy.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <tbb/parallel_for.h>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#include <xmmintrin.h>
+#endif
+
+namespace {
+	// Row major local matrix: scale * rotation * translation
+	void ComposeMatrix(
+		const float t[3U],
+		const float q[4U],
+		const float s[3U],
+		float m[16U]) noexcept
+	{
+		const float xx{ q[0U] * q[0U] };
+		const float yy{ q[1U] * q[1U] };
+		const float zz{ q[2U] * q[2U] };
+		const float xy{ q[0U] * q[1U] };
+		const float xz{ q[0U] * q[2U] };
+		const float yz{ q[1U] * q[2U] };
+		const float xw{ q[0U] * q[3U] };
+		const float yw{ q[1U] * q[3U] };
+		const float zw{ q[2U] * q[3U] };
+
+		m[0U] = s[0U] * (1.0f - 2.0f * (yy + zz));
+		m[1U] = s[0U] * 2.0f * (xy + zw);
+		m[2U] = s[0U] * 2.0f * (xz - yw);
+		m[3U] = 0.0f;
+		m[4U] = s[1U] * 2.0f * (xy - zw);
+		m[5U] = s[1U] * (1.0f - 2.0f * (xx + zz));
+		m[6U] = s[1U] * 2.0f * (yz + xw);
+		m[7U] = 0.0f;
+		m[8U] = s[2U] * 2.0f * (xz + yw);
+		m[9U] = s[2U] * 2.0f * (yz - xw);
+		m[10U] = s[2U] * (1.0f - 2.0f * (xx + yy));
+		m[11U] = 0.0f;
+		m[12U] = t[0U];
+		m[13U] = t[1U];
+		m[14U] = t[2U];
+		m[15U] = 1.0f;
+	}
+
+	// Inverse of ComposeMatrix() for matrices without shear
+	void DecomposeMatrix(
+		const float m[16U],
+		float t[3U],
+		float q[4U],
+		float s[3U]) noexcept
+	{
+		float r[3U][3U];
+		for (std::uint32_t i = 0U; i < 3U; ++i) {
+			const float* row{ m + i * 4U };
+			s[i] = std::sqrt(row[0U] * row[0U] + row[1U] * row[1U] + row[2U] * row[2U]);
+			ASSERT(s[i] > 0.0f);
+			for (std::uint32_t j = 0U; j < 3U; ++j) {
+				r[i][j] = row[j] / s[i];
+			}
+		}
+
+		// Reflections are stored as a negative x scale
+		const float det{
+			r[0U][0U] * (r[1U][1U] * r[2U][2U] - r[1U][2U] * r[2U][1U]) -
+			r[0U][1U] * (r[1U][0U] * r[2U][2U] - r[1U][2U] * r[2U][0U]) +
+			r[0U][2U] * (r[1U][0U] * r[2U][1U] - r[1U][1U] * r[2U][0U]) };
+		if (det < 0.0f) {
+			s[0U] = -s[0U];
+			for (std::uint32_t j = 0U; j < 3U; ++j) {
+				r[0U][j] = -r[0U][j];
+			}
+		}
+
+		const float trace{ r[0U][0U] + r[1U][1U] + r[2U][2U] };
+		if (trace > 0.0f) {
+			const float k{ 2.0f * std::sqrt(trace + 1.0f) };
+			q[0U] = (r[1U][2U] - r[2U][1U]) / k;
+			q[1U] = (r[2U][0U] - r[0U][2U]) / k;
+			q[2U] = (r[0U][1U] - r[1U][0U]) / k;
+			q[3U] = 0.25f * k;
+		}
+		else if (r[0U][0U] > r[1U][1U] && r[0U][0U] > r[2U][2U]) {
+			const float k{ 2.0f * std::sqrt(1.0f + r[0U][0U] - r[1U][1U] - r[2U][2U]) };
+			q[0U] = 0.25f * k;
+			q[1U] = (r[0U][1U] + r[1U][0U]) / k;
+			q[2U] = (r[2U][0U] + r[0U][2U]) / k;
+			q[3U] = (r[1U][2U] - r[2U][1U]) / k;
+		}
+		else if (r[1U][1U] > r[2U][2U]) {
+			const float k{ 2.0f * std::sqrt(1.0f + r[1U][1U] - r[0U][0U] - r[2U][2U]) };
+			q[0U] = (r[0U][1U] + r[1U][0U]) / k;
+			q[1U] = 0.25f * k;
+			q[2U] = (r[1U][2U] + r[2U][1U]) / k;
+			q[3U] = (r[2U][0U] - r[0U][2U]) / k;
+		}
+		else {
+			const float k{ 2.0f * std::sqrt(1.0f + r[2U][2U] - r[0U][0U] - r[1U][1U]) };
+			q[0U] = (r[2U][0U] + r[0U][2U]) / k;
+			q[1U] = (r[1U][2U] + r[2U][1U]) / k;
+			q[2U] = 0.25f * k;
+			q[3U] = (r[0U][1U] - r[1U][0U]) / k;
+		}
+
+		t[0U] = m[12U];
+		t[1U] = m[13U];
+		t[2U] = m[14U];
+	}
+
+	// result = a * b (row major)
+	__forceinline void MultiplyMatrices(const float a[16U], const float b[16U], float result[16U]) noexcept {
+#if defined(_M_X64) || defined(__SSE2__)
+		const __m128 b0{ _mm_loadu_ps(b) };
+		const __m128 b1{ _mm_loadu_ps(b + 4U) };
+		const __m128 b2{ _mm_loadu_ps(b + 8U) };
+		const __m128 b3{ _mm_loadu_ps(b + 12U) };
+		for (std::uint32_t i = 0U; i < 4U; ++i) {
+			const float* row{ a + i * 4U };
+			__m128 r{ _mm_mul_ps(_mm_set1_ps(row[0U]), b0) };
+			r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(row[1U]), b1));
+			r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(row[2U]), b2));
+			r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(row[3U]), b3));
+			_mm_storeu_ps(result + i * 4U, r);
+		}
+#else
+		for (std::uint32_t i = 0U; i < 4U; ++i) {
+			for (std::uint32_t j = 0U; j < 4U; ++j) {
+				result[i * 4U + j] =
+					a[i * 4U] * b[j] +
+					a[i * 4U + 1U] * b[4U + j] +
+					a[i * 4U + 2U] * b[8U + j] +
+					a[i * 4U + 3U] * b[12U + j];
+			}
+		}
+#endif
+	}
+}
+
+TransformHierarchy::Handle TransformHierarchy::AddNode(
+	const Handle parent,
+	const float translation[3U],
+	const float rotation[4U],
+	const float scale[3U]) noexcept
+{
+	ASSERT(parent == sInvalidHandle || parent < NodeCount());
+	ASSERT(translation != nullptr);
+	ASSERT(rotation != nullptr);
+	ASSERT(scale != nullptr);
+
+	const Handle node{ NodeCount() };
+	mParents.push_back(parent);
+	mLevels.push_back(parent == sInvalidHandle ? 0U : mLevels[parent] + 1U);
+
+	mTranslationX.push_back(translation[0U]);
+	mTranslationY.push_back(translation[1U]);
+	mTranslationZ.push_back(translation[2U]);
+	mRotationX.push_back(rotation[0U]);
+	mRotationY.push_back(rotation[1U]);
+	mRotationZ.push_back(rotation[2U]);
+	mRotationW.push_back(rotation[3U]);
+	mScaleX.push_back(scale[0U]);
+	mScaleY.push_back(scale[1U]);
+	mScaleZ.push_back(scale[2U]);
+
+	mLocalMatrices.resize(mLocalMatrices.size() + 16UL);
+	mWorldMatrices.resize(mWorldMatrices.size() + 16UL);
+	mLocalDirty.push_back(1U);
+	mWorldChanged.push_back(0U);
+	mLevelsDirty = true;
+
+	return node;
+}
+
+TransformHierarchy::Handle TransformHierarchy::AddNode(const Handle parent, const float local[16U]) noexcept {
+	ASSERT(local != nullptr);
+
+	float translation[3U];
+	float rotation[4U];
+	float scale[3U];
+	DecomposeMatrix(local, translation, rotation, scale);
+
+	return AddNode(parent, translation, rotation, scale);
+}
+
+void TransformHierarchy::SetTranslation(const Handle node, const float translation[3U]) noexcept {
+	ASSERT(translation != nullptr);
+
+	MarkDirty(node);
+	mTranslationX[node] = translation[0U];
+	mTranslationY[node] = translation[1U];
+	mTranslationZ[node] = translation[2U];
+}
+
+void TransformHierarchy::SetRotation(const Handle node, const float rotation[4U]) noexcept {
+	ASSERT(rotation != nullptr);
+
+	MarkDirty(node);
+	mRotationX[node] = rotation[0U];
+	mRotationY[node] = rotation[1U];
+	mRotationZ[node] = rotation[2U];
+	mRotationW[node] = rotation[3U];
+}
+
+void TransformHierarchy::SetScale(const Handle node, const float scale[3U]) noexcept {
+	ASSERT(scale != nullptr);
+
+	MarkDirty(node);
+	mScaleX[node] = scale[0U];
+	mScaleY[node] = scale[1U];
+	mScaleZ[node] = scale[2U];
+}
+
+void TransformHierarchy::Update() noexcept {
+	if (mLevelsDirty) {
+		BuildLevels();
+	}
+
+	// Parents world matrices are final when their children level is updated
+	mChangedNodeCount = 0U;
+	const std::uint32_t levelCount{ mLevelOffsets.empty() ? 0U : static_cast<std::uint32_t>(mLevelOffsets.size()) - 1U };
+	for (std::uint32_t level = 0U; level < levelCount; ++level) {
+		const std::uint32_t first{ mLevelOffsets[level] };
+		const std::uint32_t last{ mLevelOffsets[level + 1U] };
+		if (last - first < sParallelLevelMinNodeCount) {
+			mChangedNodeCount += UpdateLevelNodes(first, last);
+			continue;
+		}
+
+		std::atomic<std::uint32_t> changedNodeCount{ 0U };
+		tbb::parallel_for(tbb::blocked_range<std::uint32_t>(first, last, sParallelLevelMinNodeCount / 2U),
+			[this, &changedNodeCount](const tbb::blocked_range<std::uint32_t>& r) {
+			changedNodeCount += UpdateLevelNodes(r.begin(), r.end());
+		}
+		);
+		mChangedNodeCount += changedNodeCount;
+	}
+}
+
+void TransformHierarchy::BuildLevels() noexcept {
+	// Counting sort of nodes by level (nodes of each level keep their order)
+	const std::uint32_t nodeCount{ NodeCount() };
+	const std::uint32_t levelCount{ nodeCount == 0U ? 0U : *std::max_element(mLevels.begin(), mLevels.end()) + 1U };
+	mLevelOffsets.assign(levelCount + 1U, 0U);
+	for (std::uint32_t i = 0U; i < nodeCount; ++i) {
+		++mLevelOffsets[mLevels[i] + 1U];
+	}
+	for (std::uint32_t i = 0U; i < levelCount; ++i) {
+		mLevelOffsets[i + 1U] += mLevelOffsets[i];
+	}
+
+	std::vector<std::uint32_t> cursors(mLevelOffsets.begin(), mLevelOffsets.end() - 1);
+	mLevelNodes.resize(nodeCount);
+	for (std::uint32_t i = 0U; i < nodeCount; ++i) {
+		mLevelNodes[cursors[mLevels[i]]++] = i;
+	}
+
+	mLevelsDirty = false;
+}
+
+std::uint32_t TransformHierarchy::UpdateLevelNodes(const std::uint32_t first, const std::uint32_t last) noexcept {
+	ASSERT(first <= last);
+	ASSERT(last <= mLevelNodes.size());
+
+	std::uint32_t changedNodeCount{ 0U };
+	for (std::uint32_t i = first; i < last; ++i) {
+		const Handle node{ mLevelNodes[i] };
+		const Handle parent{ mParents[node] };
+		float* local{ &mLocalMatrices[node * 16UL] };
+		float* world{ &mWorldMatrices[node * 16UL] };
+
+		const bool localDirty{ mLocalDirty[node] != 0U };
+		if (localDirty) {
+			const float t[3U]{ mTranslationX[node], mTranslationY[node], mTranslationZ[node] };
+			const float q[4U]{ mRotationX[node], mRotationY[node], mRotationZ[node], mRotationW[node] };
+			const float s[3U]{ mScaleX[node], mScaleY[node], mScaleZ[node] };
+			ComposeMatrix(t, q, s, local);
+			mLocalDirty[node] = 0U;
+		}
+
+		const bool changed{ localDirty || (parent != sInvalidHandle && mWorldChanged[parent] != 0U) };
+		if (changed) {
+			if (parent == sInvalidHandle) {
+				std::memcpy(world, local, sizeof(float) * 16UL);
+			}
+			else {
+				MultiplyMatrices(local, &mWorldMatrices[parent * 16UL], world);
+			}
+		}
+
+		mWorldChanged[node] = changed ? 1U : 0U;
+		changedNodeCount += changed ? 1U : 0U;
+	}
+
+	return changedNodeCount;
+}
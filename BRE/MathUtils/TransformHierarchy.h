@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <Utils/DebugUtils.h>
+
+// Scene transforms. Each node has a local transform (translation, rotation quaternion and scale)
+// relative to its parent, and a world matrix. Both are stored in SoA layout, and nodes are referenced by handle.
+// Parents are added before their children, so nodes are always in topological order.
+// Update() computes local matrices of modified nodes and propagates them to their descendants
+// (only modified subtrees are recomputed). Nodes are processed by depth level, and
+// nodes of the same level are updated in parallel (matrix products use SSE).
+// Matrices are row major (row vectors, as DirectXMath), so world = scale * rotation * translation * parentWorld.
+// It does not depend on DirectXMath or D3D, so it can be built on any platform.
+// Steps:
+// - Call AddNode() for each node (parents first)
+// - Modify nodes with SetTranslation(), SetRotation() or SetScale()
+// - Call Update() once per frame, before reading WorldMatrix()
+class TransformHierarchy {
+public:
+	using Handle = std::uint32_t;
+	static const Handle sInvalidHandle{ 0xFFFFFFFFU };
+
+	// Levels with fewer nodes are updated in the calling thread
+	static const std::uint32_t sParallelLevelMinNodeCount{ 2048U };
+
+	TransformHierarchy() = default;
+	~TransformHierarchy() = default;
+	TransformHierarchy(const TransformHierarchy&) = delete;
+	const TransformHierarchy& operator=(const TransformHierarchy&) = delete;
+	TransformHierarchy(TransformHierarchy&&) = default;
+	TransformHierarchy& operator=(TransformHierarchy&&) = default;
+
+	// parent is sInvalidHandle for root nodes. It is not thread safe.
+	// Nodes must not be added while world matrices pointers are referenced (they could be reallocated).
+	Handle AddNode(
+		const Handle parent,
+		const float translation[3U],
+		const float rotation[4U],
+		const float scale[3U]) noexcept;
+
+	// local is a row major matrix that must be composed of scale, rotation and translation (no shear)
+	Handle AddNode(const Handle parent, const float local[16U]) noexcept;
+
+	void SetTranslation(const Handle node, const float translation[3U]) noexcept;
+	// rotation is a unit quaternion (x, y, z, w)
+	void SetRotation(const Handle node, const float rotation[4U]) noexcept;
+	void SetScale(const Handle node, const float scale[3U]) noexcept;
+
+	void Update() noexcept;
+
+	__forceinline std::uint32_t NodeCount() const noexcept { return static_cast<std::uint32_t>(mParents.size()); }
+	__forceinline Handle Parent(const Handle node) const noexcept { ASSERT(node < NodeCount()); return mParents[node]; }
+
+	// Row major matrix of the last Update()
+	__forceinline const float* WorldMatrix(const Handle node) const noexcept { ASSERT(node < NodeCount()); return &mWorldMatrices[node * 16UL]; }
+
+	// True if the world matrix of the node changed in the last Update()
+	__forceinline bool WorldMatrixChanged(const Handle node) const noexcept { ASSERT(node < NodeCount()); return mWorldChanged[node] != 0U; }
+	__forceinline std::uint32_t ChangedNodeCount() const noexcept { return mChangedNodeCount; }
+
+private:
+	void BuildLevels() noexcept;
+
+	// Updates nodes of a level in [first, last) (indices in mLevelNodes).
+	// Returns the number of nodes whose world matrix changed.
+	std::uint32_t UpdateLevelNodes(const std::uint32_t first, const std::uint32_t last) noexcept;
+
+	__forceinline void MarkDirty(const Handle node) noexcept { ASSERT(node < NodeCount()); mLocalDirty[node] = 1U; }
+
+	std::vector<Handle> mParents;
+	std::vector<std::uint32_t> mLevels;
+
+	// Local transforms
+	std::vector<float> mTranslationX;
+	std::vector<float> mTranslationY;
+	std::vector<float> mTranslationZ;
+	std::vector<float> mRotationX;
+	std::vector<float> mRotationY;
+	std::vector<float> mRotationZ;
+	std::vector<float> mRotationW;
+	std::vector<float> mScaleX;
+	std::vector<float> mScaleY;
+	std::vector<float> mScaleZ;
+
+	// 16 floats per node
+	std::vector<float> mLocalMatrices;
+	std::vector<float> mWorldMatrices;
+
+	std::vector<std::uint8_t> mLocalDirty;
+	std::vector<std::uint8_t> mWorldChanged;
+	std::uint32_t mChangedNodeCount{ 0U };
+
+	// Nodes sorted by level, and the first node of each level (and the end of the last one).
+	// They are rebuilt in the first Update() after nodes are added.
+	std::vector<Handle> mLevelNodes;
+	std::vector<std::uint32_t> mLevelOffsets;
+	bool mLevelsDirty{ false };
+};
@@ -3,10 +3,11 @@
 #include <cstdint>
 
 #include <GeometryGenerator/GeometryGenerator.h>
+#include <MathUtils/BoundingVolumes.h>
+#include <OcclusionCulling/OcclusionCuller.h>
 #include <ResourceManager\BufferCreator.h>
 #include <Utils/DebugUtils.h>
 
-struct aiMesh;
 struct ID3D12GraphicsCommandList;
 class Model;
 
@@ -19,6 +20,13 @@ public:
 	__forceinline const BufferCreator::VertexBufferData& VertexBufferData() const noexcept { ASSERT(mVertexBufferData.ValidateData()); return mVertexBufferData; }
 	__forceinline const BufferCreator::IndexBufferData& IndexBufferData() const noexcept { ASSERT(mIndexBufferData.ValidateData()); return mIndexBufferData; }
 
+	// Mesh (local) space bounds, computed from its vertices
+	__forceinline const BoundingVolumes& GetBoundingVolumes() const noexcept { return mBoundingVolumes; }
+
+	// CPU copy of the triangles, used to rasterize the mesh as an occluder.
+	// It is nullptr if the mesh has too many triangles to be an occluder.
+	__forceinline const OccluderMesh* GetOccluderMesh() const noexcept { return mOccluderMesh.mIndices.empty() ? nullptr : &mOccluderMesh; }
+
 	~Mesh() = default;
 	Mesh(const Mesh&) = delete;
 	const Mesh& operator=(const Mesh&) = delete;
@@ -29,12 +37,6 @@ private:
 	// Command lists are used to store buffers creation (vertex and index per mesh)
 	// cmdList must be in recorded state before calling these method.
 	// cmdList must be executed after calling these methods, to create the commited resource.
-	explicit Mesh(
-		const aiMesh& mesh, 
-		ID3D12GraphicsCommandList& cmdList,
-		Microsoft::WRL::ComPtr<ID3D12Resource>& uploadVertexBuffer,
-		Microsoft::WRL::ComPtr<ID3D12Resource>& uploadIndexBuffer);
-
 	explicit Mesh(
 		const GeometryGenerator::MeshData& meshData, 
 		ID3D12GraphicsCommandList& cmdList,
@@ -43,4 +45,6 @@ private:
 	
 	BufferCreator::VertexBufferData mVertexBufferData;
 	BufferCreator::IndexBufferData mIndexBufferData;
+	BoundingVolumes mBoundingVolumes;
+	OccluderMesh mOccluderMesh;
 };
\ No newline at end of file
@@ -4,15 +4,95 @@
 #include <assimp/postprocess.h>
 #include <assimp/scene.h>
 
+#include <GeometryGenerator/TangentGenerator.h>
 #include <GlobalData/Settings.h>
 #include <ResourceManager/ResourceManager.h>
 #include <Utils/DebugUtils.h>
 
+using namespace DirectX;
+
+namespace {
+	void ToMeshData(const aiMesh& mesh, GeometryGenerator::MeshData& meshData) noexcept {
+		// Positions and Normals
+		const std::size_t numVertices{ mesh.mNumVertices };
+		ASSERT(numVertices > 0U);
+		ASSERT(mesh.HasNormals());
+		meshData.mVertices.resize(numVertices);
+		for (std::uint32_t i = 0U; i < numVertices; ++i) {
+			meshData.mVertices[i].mPosition = XMFLOAT3(reinterpret_cast<const float*>(&mesh.mVertices[i]));
+			meshData.mVertices[i].mNormal = XMFLOAT3(reinterpret_cast<const float*>(&mesh.mNormals[i]));
+		}
+
+		// Texture Coordinates (if any)
+		if (mesh.HasTextureCoords(0U)) {
+			ASSERT(mesh.GetNumUVChannels() == 1U);
+			const aiVector3D* aiTextureCoordinates{ mesh.mTextureCoords[0U] };
+			ASSERT(aiTextureCoordinates != nullptr);
+			for (std::uint32_t i = 0U; i < numVertices; i++) {
+				meshData.mVertices[i].mTexC = XMFLOAT2(reinterpret_cast<const float*>(&aiTextureCoordinates[i]));
+			}
+		}
+
+		// Indices
+		ASSERT(mesh.HasFaces());
+		const std::uint32_t numFaces{ mesh.mNumFaces };
+		for (std::uint32_t i = 0U; i < numFaces; ++i) {
+			const aiFace* face = &mesh.mFaces[i];
+			ASSERT(face != nullptr);
+			// We only allow triangles
+			ASSERT(face->mNumIndices == 3U);
+
+			meshData.mIndices32.push_back(face->mIndices[0U]);
+			meshData.mIndices32.push_back(face->mIndices[1U]);
+			meshData.mIndices32.push_back(face->mIndices[2U]);
+		}
+
+		// Tangents
+		if (mesh.HasTangentsAndBitangents()) {
+			for (std::uint32_t i = 0U; i < numVertices; ++i) {
+				const XMFLOAT3 tangent(reinterpret_cast<const float*>(&mesh.mTangents[i]));
+				const XMFLOAT3 bitangent(reinterpret_cast<const float*>(&mesh.mBitangents[i]));
+				meshData.mVertices[i].mTangentU = TangentGenerator::OrthonormalizeTangent(meshData.mVertices[i].mNormal, tangent, bitangent);
+			}
+		}
+		else {
+			TangentGenerator::ComputeTangentFrames(meshData);
+		}
+	}
+}
+
 Model::Model(
 	const char* filename, 
 	ID3D12GraphicsCommandList& cmdList,
 	Microsoft::WRL::ComPtr<ID3D12Resource>& uploadVertexBuffer,
 	Microsoft::WRL::ComPtr<ID3D12Resource>& uploadIndexBuffer) {
+	std::vector<GeometryGenerator::MeshData> meshes;
+	ImportMeshes(filename, meshes);
+	for (const GeometryGenerator::MeshData& meshData : meshes) {
+		mMeshes.push_back(Mesh(meshData, cmdList, uploadVertexBuffer, uploadIndexBuffer));
+	}
+}
+
+Model::Model(
+	const GeometryGenerator::MeshData& meshData, 
+	ID3D12GraphicsCommandList& cmdList,
+	Microsoft::WRL::ComPtr<ID3D12Resource>& uploadVertexBuffer,
+	Microsoft::WRL::ComPtr<ID3D12Resource>& uploadIndexBuffer) {
+	mMeshes.push_back(Mesh(meshData, cmdList, uploadVertexBuffer, uploadIndexBuffer));
+}
+
+Model::Model(
+	const std::vector<GeometryGenerator::MeshData>& meshes,
+	ID3D12GraphicsCommandList& cmdList,
+	Microsoft::WRL::ComPtr<ID3D12Resource>& uploadVertexBuffer,
+	Microsoft::WRL::ComPtr<ID3D12Resource>& uploadIndexBuffer) {
+	ASSERT(meshes.empty() == false);
+	for (const GeometryGenerator::MeshData& meshData : meshes) {
+		mMeshes.push_back(Mesh(meshData, cmdList, uploadVertexBuffer, uploadIndexBuffer));
+	}
+}
+
+void Model::ImportMeshes(const char* filename, std::vector<GeometryGenerator::MeshData>& meshes) noexcept {
 	ASSERT(filename != nullptr);
 	std::string filePath(Settings::sResourcesPath);
 	filePath += filename;
@@ -29,17 +109,10 @@ Model::Model(
 
 	ASSERT(scene->HasMeshes());
 
+	meshes.resize(scene->mNumMeshes);
 	for (std::uint32_t i = 0U; i < scene->mNumMeshes; ++i) {
-		aiMesh* mesh{ scene->mMeshes[i] };
+		const aiMesh* mesh{ scene->mMeshes[i] };
 		ASSERT(mesh != nullptr);
-		mMeshes.push_back(Mesh(*mesh, cmdList, uploadVertexBuffer, uploadIndexBuffer));
+		ToMeshData(*mesh, meshes[i]);
 	}
-}
-
-Model::Model(
-	const GeometryGenerator::MeshData& meshData, 
-	ID3D12GraphicsCommandList& cmdList,
-	Microsoft::WRL::ComPtr<ID3D12Resource>& uploadVertexBuffer,
-	Microsoft::WRL::ComPtr<ID3D12Resource>& uploadIndexBuffer) {
-	mMeshes.push_back(Mesh(meshData, cmdList, uploadVertexBuffer, uploadIndexBuffer));
 }
\ No newline at end of file
@@ -9,7 +9,7 @@
 struct ID3D12GraphicsCommandList;
 struct ID3D12Resource;
 
-// - Load model data from a filepath.
+// - Load model data from a filepath (or import it first, and create the model from its meshes).
 // - Get meshes 
 // It stores vertex/index data in Mesh class.
 class Model {
@@ -29,6 +29,18 @@ public:
 		Microsoft::WRL::ComPtr<ID3D12Resource>& uploadVertexBuffer,
 		Microsoft::WRL::ComPtr<ID3D12Resource>& uploadIndexBuffer);
 
+	// Meshes imported with ImportMeshes()
+	explicit Model(
+		const std::vector<GeometryGenerator::MeshData>& meshes,
+		ID3D12GraphicsCommandList& cmdList,
+		Microsoft::WRL::ComPtr<ID3D12Resource>& uploadVertexBuffer,
+		Microsoft::WRL::ComPtr<ID3D12Resource>& uploadIndexBuffer);
+
+	// Reads the model file and converts its meshes (tangent frames are computed if the
+	// file does not have them). It does not use the device, so it can be called from
+	// any thread, and the model is created later from the meshes.
+	static void ImportMeshes(const char* filename, std::vector<GeometryGenerator::MeshData>& meshes) noexcept;
+
 	~Model() = default;
 	Model(const Model&) = delete;
 	const Model& operator=(const Model&) = delete;
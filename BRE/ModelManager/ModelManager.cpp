@@ -1,6 +1,10 @@
 #include "ModelManager.h"
 
+#include <functional>
+
 #include <GeometryGenerator\GeometryGenerator.h>
+#include <GeometryGenerator/TangentGenerator.h>
+#include <ResourceManager/GeometryPool.h>
 #include <Utils/DebugUtils.h>
 #include <Utils\NumberGeneration.h>
 
@@ -20,200 +24,162 @@ ModelManager& ModelManager::Get() noexcept {
 }
 
 std::size_t ModelManager::LoadModel(
-	const char* filename, 
-	Model* &model, 
+	const char* filename,
+	Model* &model,
 	ID3D12GraphicsCommandList& cmdList,
 	Microsoft::WRL::ComPtr<ID3D12Resource>& uploadVertexBuffer,
 	Microsoft::WRL::ComPtr<ID3D12Resource>& uploadIndexBuffer) noexcept {
 	ASSERT(filename != nullptr);
 
+	// Import does not use the command list, so it is done outside the lock
+	std::vector<GeometryGenerator::MeshData> meshes;
+	Model::ImportMeshes(filename, meshes);
+
+	return CreateModel(meshes, model, cmdList, uploadVertexBuffer, uploadIndexBuffer);
+}
+
+std::size_t ModelManager::CreateModel(
+	const std::vector<GeometryGenerator::MeshData>& meshes,
+	Model* &model,
+	ID3D12GraphicsCommandList& cmdList,
+	Microsoft::WRL::ComPtr<ID3D12Resource>& uploadVertexBuffer,
+	Microsoft::WRL::ComPtr<ID3D12Resource>& uploadIndexBuffer) noexcept {
+	ASSERT(meshes.empty() == false);
+
 	mMutex.lock();
-	model = new Model(filename, cmdList, uploadVertexBuffer, uploadIndexBuffer);
+	model = new Model(meshes, cmdList, uploadVertexBuffer, uploadIndexBuffer);
 	mMutex.unlock();
 
-	const std::size_t id{ NumberGeneration::IncrementalSizeT() };
-	ModelById::accessor accessor;
-#ifdef _DEBUG
-	mModelById.find(accessor, id);
-	ASSERT(accessor.empty());
-#endif
-	mModelById.insert(accessor, id);
-	accessor->second.reset(model);
-	accessor.release();
-
-	return id;
+	return InsertModel(model, nullptr);
 }
 
 std::size_t ModelManager::CreateBox(
-	const float width, 
-	const float height, 
-	const float depth, 
+	const float width,
+	const float height,
+	const float depth,
 	const std::uint32_t numSubdivisions,
-	Model* &model, 
+	Model* &model,
 	ID3D12GraphicsCommandList& cmdList,
 	Microsoft::WRL::ComPtr<ID3D12Resource>& uploadVertexBuffer,
 	Microsoft::WRL::ComPtr<ID3D12Resource>& uploadIndexBuffer) noexcept {
+	const ProceduralKey key{ ProceduralKey::BOX, { width, height, depth, static_cast<float>(numSubdivisions), 0.0f } };
+	std::size_t id;
+	if (FindProceduralModel(key, id, model)) {
+		return id;
+	}
+
 	GeometryGenerator::MeshData meshData;
 	GeometryGenerator::CreateBox(width, height, depth, numSubdivisions, meshData);
+	TangentGenerator::ComputeTangentFrames(meshData);
 
-	mMutex.lock();
-	model = new Model(meshData, cmdList, uploadVertexBuffer, uploadIndexBuffer);
-	mMutex.unlock();
-
-	const std::size_t id{ NumberGeneration::IncrementalSizeT() };
-	ModelById::accessor accessor;
-#ifdef _DEBUG
-	mModelById.find(accessor, id);
-	ASSERT(accessor.empty());
-#endif
-	mModelById.insert(accessor, id);
-	accessor->second.reset(model);
-	accessor.release();
-
-	return id;
+	return InsertProceduralModel(key, meshData, model, cmdList, uploadVertexBuffer, uploadIndexBuffer);
 }
 
 std::size_t ModelManager::CreateSphere(
-	const float radius, 
-	const std::uint32_t sliceCount, 
-	const std::uint32_t stackCount, 
-	Model* &model, 
+	const float radius,
+	const std::uint32_t sliceCount,
+	const std::uint32_t stackCount,
+	Model* &model,
 	ID3D12GraphicsCommandList& cmdList,
 	Microsoft::WRL::ComPtr<ID3D12Resource>& uploadVertexBuffer,
 	Microsoft::WRL::ComPtr<ID3D12Resource>& uploadIndexBuffer) noexcept {
+	const ProceduralKey key{ ProceduralKey::SPHERE, { radius, static_cast<float>(sliceCount), static_cast<float>(stackCount), 0.0f, 0.0f } };
+	std::size_t id;
+	if (FindProceduralModel(key, id, model)) {
+		return id;
+	}
+
 	GeometryGenerator::MeshData meshData;
 	GeometryGenerator::CreateSphere(radius, sliceCount, stackCount, meshData);
+	TangentGenerator::ComputeTangentFrames(meshData);
 
-	mMutex.lock();
-	model = new Model(meshData, cmdList, uploadVertexBuffer, uploadIndexBuffer);
-	mMutex.unlock();
-
-	const std::size_t id{ NumberGeneration::IncrementalSizeT() };
-	ModelById::accessor accessor;
-#ifdef _DEBUG
-	mModelById.find(accessor, id);
-	ASSERT(accessor.empty());
-#endif
-	mModelById.insert(accessor, id);
-	accessor->second.reset(model);
-	accessor.release();
-
-	return id;
+	return InsertProceduralModel(key, meshData, model, cmdList, uploadVertexBuffer, uploadIndexBuffer);
 }
 
 std::size_t ModelManager::CreateGeosphere(
-	const float radius, 
-	const std::uint32_t numSubdivisions, 
-	Model* &model, 
+	const float radius,
+	const std::uint32_t numSubdivisions,
+	Model* &model,
 	ID3D12GraphicsCommandList& cmdList,
 	Microsoft::WRL::ComPtr<ID3D12Resource>& uploadVertexBuffer,
 	Microsoft::WRL::ComPtr<ID3D12Resource>& uploadIndexBuffer) noexcept {
+	const ProceduralKey key{ ProceduralKey::GEOSPHERE, { radius, static_cast<float>(numSubdivisions), 0.0f, 0.0f, 0.0f } };
+	std::size_t id;
+	if (FindProceduralModel(key, id, model)) {
+		return id;
+	}
+
 	GeometryGenerator::MeshData meshData;
 	GeometryGenerator::CreateGeosphere(radius, numSubdivisions, meshData);
+	TangentGenerator::ComputeTangentFrames(meshData);
 
-	mMutex.lock();
-	model = new Model(meshData, cmdList, uploadVertexBuffer, uploadIndexBuffer);
-	mMutex.unlock();
-
-	const std::size_t id{ NumberGeneration::IncrementalSizeT() };
-	ModelById::accessor accessor;
-#ifdef _DEBUG
-	mModelById.find(accessor, id);
-	ASSERT(accessor.empty());
-#endif
-	mModelById.insert(accessor, id);
-	accessor->second.reset(model);
-	accessor.release();
-
-	return id;
+	return InsertProceduralModel(key, meshData, model, cmdList, uploadVertexBuffer, uploadIndexBuffer);
 }
 
 std::size_t ModelManager::CreateCylinder(
 	const float bottomRadius,
 	const float topRadius,
-	const float height, 
+	const float height,
 	const std::uint32_t sliceCount,
 	const std::uint32_t stackCount,
 	Model* &model
 	, ID3D12GraphicsCommandList& cmdList,
 	Microsoft::WRL::ComPtr<ID3D12Resource>& uploadVertexBuffer,
 	Microsoft::WRL::ComPtr<ID3D12Resource>& uploadIndexBuffer) noexcept {
+	const ProceduralKey key{ ProceduralKey::CYLINDER, { bottomRadius, topRadius, height, static_cast<float>(sliceCount), static_cast<float>(stackCount) } };
+	std::size_t id;
+	if (FindProceduralModel(key, id, model)) {
+		return id;
+	}
+
 	GeometryGenerator::MeshData meshData;
 	GeometryGenerator::CreateCylinder(bottomRadius, topRadius, height, sliceCount, stackCount, meshData);
+	TangentGenerator::ComputeTangentFrames(meshData);
 
-	mMutex.lock();
-	model = new Model(meshData, cmdList, uploadVertexBuffer, uploadIndexBuffer);
-	mMutex.unlock();
-
-	const std::size_t id{ NumberGeneration::IncrementalSizeT() };
-	ModelById::accessor accessor;
-#ifdef _DEBUG
-	mModelById.find(accessor, id);
-	ASSERT(accessor.empty());
-#endif
-	mModelById.insert(accessor, id);
-	accessor->second.reset(model);
-	accessor.release();
-
-	return id;
+	return InsertProceduralModel(key, meshData, model, cmdList, uploadVertexBuffer, uploadIndexBuffer);
 }
 
 std::size_t ModelManager::CreateGrid(
-	const float width, 
-	const float depth, 
-	const std::uint32_t m, 
-	const std::uint32_t n, Model* &model, 
+	const float width,
+	const float depth,
+	const std::uint32_t m,
+	const std::uint32_t n, Model* &model,
 	ID3D12GraphicsCommandList& cmdList,
 	Microsoft::WRL::ComPtr<ID3D12Resource>& uploadVertexBuffer,
 	Microsoft::WRL::ComPtr<ID3D12Resource>& uploadIndexBuffer) noexcept {
+	const ProceduralKey key{ ProceduralKey::GRID, { width, depth, static_cast<float>(m), static_cast<float>(n), 0.0f } };
+	std::size_t id;
+	if (FindProceduralModel(key, id, model)) {
+		return id;
+	}
+
 	GeometryGenerator::MeshData meshData;
 	GeometryGenerator::CreateGrid(width, depth, m, n, meshData);
+	TangentGenerator::ComputeTangentFrames(meshData);
 
-	mMutex.lock();
-	model = new Model(meshData, cmdList, uploadVertexBuffer, uploadIndexBuffer);
-	mMutex.unlock();
-
-	const std::size_t id{ NumberGeneration::IncrementalSizeT() };
-	ModelById::accessor accessor;
-#ifdef _DEBUG
-	mModelById.find(accessor, id);
-	ASSERT(accessor.empty());
-#endif
-	mModelById.insert(accessor, id);
-	accessor->second.reset(model);
-	accessor.release();
-
-	return id;
+	return InsertProceduralModel(key, meshData, model, cmdList, uploadVertexBuffer, uploadIndexBuffer);
 }
 
 std::size_t ModelManager::CreateQuad(
-	const float x, 
-	const float y, 
-	const float w, 
-	const float h, 
-	const float depth, 
-	Model* &model, 
+	const float x,
+	const float y,
+	const float w,
+	const float h,
+	const float depth,
+	Model* &model,
 	ID3D12GraphicsCommandList& cmdList,
 	Microsoft::WRL::ComPtr<ID3D12Resource>& uploadVertexBuffer,
 	Microsoft::WRL::ComPtr<ID3D12Resource>& uploadIndexBuffer) noexcept {
+	const ProceduralKey key{ ProceduralKey::QUAD, { x, y, w, h, depth } };
+	std::size_t id;
+	if (FindProceduralModel(key, id, model)) {
+		return id;
+	}
+
 	GeometryGenerator::MeshData meshData;
 	GeometryGenerator::CreateQuad(x, y, w, h, depth, meshData);
 
-	mMutex.lock();
-	model = new Model(meshData, cmdList, uploadVertexBuffer, uploadIndexBuffer);
-	mMutex.unlock();
-
-	const std::size_t id{ NumberGeneration::IncrementalSizeT() };
-	ModelById::accessor accessor;
-#ifdef _DEBUG
-	mModelById.find(accessor, id);
-	ASSERT(accessor.empty());
-#endif
-	mModelById.insert(accessor, id);
-	accessor->second.reset(model);
-	accessor.release();
-
-	return id;
+	return InsertProceduralModel(key, meshData, model, cmdList, uploadVertexBuffer, uploadIndexBuffer);
 }
 
 std::size_t ModelManager::CreateFullscreenQuad(
@@ -221,43 +187,170 @@ std::size_t ModelManager::CreateFullscreenQuad(
 	ID3D12GraphicsCommandList& cmdList,
 	Microsoft::WRL::ComPtr<ID3D12Resource>& uploadVertexBuffer,
 	Microsoft::WRL::ComPtr<ID3D12Resource>& uploadIndexBuffer) noexcept {
+	const ProceduralKey key{ ProceduralKey::FULLSCREEN_QUAD, { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f } };
+	std::size_t id;
+	if (FindProceduralModel(key, id, model)) {
+		return id;
+	}
 
 	GeometryGenerator::MeshData meshData;
 	GeometryGenerator::CreateFullscreenQuad(meshData);
 
-	mMutex.lock();
-	model = new Model(meshData, cmdList, uploadVertexBuffer, uploadIndexBuffer);
-	mMutex.unlock();
+	return InsertProceduralModel(key, meshData, model, cmdList, uploadVertexBuffer, uploadIndexBuffer);
+}
 
-	const std::size_t id{ NumberGeneration::IncrementalSizeT() };
+Model& ModelManager::GetModel(const std::size_t id) noexcept {
 	ModelById::accessor accessor;
-#ifdef _DEBUG
 	mModelById.find(accessor, id);
-	ASSERT(accessor.empty());
-#endif
-	mModelById.insert(accessor, id);
-	accessor->second.reset(model);
+	ASSERT(!accessor.empty());
+
+	Model* model{ accessor->second.mModel.get() };
 	accessor.release();
 
-	return id;
+	return *model;
 }
 
-Model& ModelManager::GetModel(const std::size_t id) noexcept {
+void ModelManager::UploadFlushed(const std::size_t id) noexcept {
 	ModelById::accessor accessor;
 	mModelById.find(accessor, id);
 	ASSERT(!accessor.empty());
 
-	Model* model{ accessor->second.get() };
+	accessor->second.mIsUploadFlushed = true;
 	accessor.release();
-
-	return *model;
 }
 
-
 void ModelManager::Erase(const std::size_t id) noexcept {
 	ModelById::accessor accessor;
 	mModelById.find(accessor, id);
 	ASSERT(!accessor.empty());
+
+	ModelEntry& entry = accessor->second;
+	ASSERT(entry.mRefCount > 0U);
+	if (--entry.mRefCount > 0U) {
+		return;
+	}
+
+	// Return meshes data to the geometry pool. GPU must not be using them anymore.
+	GeometryPool& geometryPool = GeometryPool::Get();
+	const std::vector<Mesh>& meshes = entry.mModel->Meshes();
+	for (const Mesh& mesh : meshes) {
+		geometryPool.Free(mesh.VertexBufferData());
+		geometryPool.Free(mesh.IndexBufferData());
+	}
+
+	const bool isProcedural{ entry.mIsProcedural };
+	const ProceduralKey key{ entry.mProceduralKey };
 	mModelById.erase(accessor);
 	accessor.release();
-}
\ No newline at end of file
+
+	// Forget procedural key, unless it was registered again for another model.
+	// Model accessor is released first, so locks are always taken in key, model order.
+	if (isProcedural) {
+		IdByProceduralKey::accessor keyAccessor;
+		if (mIdByProceduralKey.find(keyAccessor, key) && keyAccessor->second == id) {
+			mIdByProceduralKey.erase(keyAccessor);
+		}
+	}
+}
+
+std::size_t ModelManager::ProceduralKeyHashCompare::hash(const ProceduralKey& key) noexcept {
+	const std::hash<float> floatHash;
+	std::size_t hash{ static_cast<std::size_t>(key.mType) };
+	for (std::uint32_t i = 0U; i < ProceduralKey::sMaxParams; ++i) {
+		// 0.0f and -0.0f are equal, so they must have the same hash
+		const float param{ key.mParams[i] == 0.0f ? 0.0f : key.mParams[i] };
+		hash ^= floatHash(param) + 0x9e3779b9 + (hash << 6UL) + (hash >> 2UL);
+	}
+
+	return hash;
+}
+
+bool ModelManager::ProceduralKeyHashCompare::equal(const ProceduralKey& key1, const ProceduralKey& key2) noexcept {
+	if (key1.mType != key2.mType) {
+		return false;
+	}
+
+	for (std::uint32_t i = 0U; i < ProceduralKey::sMaxParams; ++i) {
+		if (key1.mParams[i] != key2.mParams[i]) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool ModelManager::FindProceduralModel(const ProceduralKey& key, std::size_t& id, Model* &model) noexcept {
+	IdByProceduralKey::const_accessor accessor;
+	if (mIdByProceduralKey.find(accessor, key) == false) {
+		return false;
+	}
+
+	id = accessor->second;
+	accessor.release();
+
+	// Model can be erased (or not uploaded yet) after the key is released
+	return AcquireProceduralModel(id, model);
+}
+
+bool ModelManager::AcquireProceduralModel(const std::size_t id, Model* &model) noexcept {
+	ModelById::accessor accessor;
+	if (mModelById.find(accessor, id) == false || accessor->second.mIsUploadFlushed == false) {
+		return false;
+	}
+
+	++accessor->second.mRefCount;
+	model = accessor->second.mModel.get();
+	accessor.release();
+
+	return true;
+}
+
+std::size_t ModelManager::InsertProceduralModel(
+	const ProceduralKey& key,
+	const GeometryGenerator::MeshData& meshData,
+	Model* &model,
+	ID3D12GraphicsCommandList& cmdList,
+	Microsoft::WRL::ComPtr<ID3D12Resource>& uploadVertexBuffer,
+	Microsoft::WRL::ComPtr<ID3D12Resource>& uploadIndexBuffer) noexcept {
+
+	// The key is checked again under the mutex, so concurrent identical requests
+	// only record GPU buffers creation once its upload was flushed.
+	// If the registered model was erased or is not uploaded yet, the key
+	// is registered again for the new model.
+	mMutex.lock();
+	std::size_t id;
+	IdByProceduralKey::accessor accessor;
+	if (mIdByProceduralKey.insert(accessor, key) || AcquireProceduralModel(accessor->second, model) == false) {
+		model = new Model(meshData, cmdList, uploadVertexBuffer, uploadIndexBuffer);
+		id = InsertModel(model, &key);
+		accessor->second = id;
+	}
+	else {
+		id = accessor->second;
+	}
+	accessor.release();
+	mMutex.unlock();
+
+	return id;
+}
+
+std::size_t ModelManager::InsertModel(Model* model, const ProceduralKey* proceduralKey) noexcept {
+	ASSERT(model != nullptr);
+
+	const std::size_t id{ NumberGeneration::IncrementalSizeT() };
+	ModelById::accessor accessor;
+#ifdef _DEBUG
+	mModelById.find(accessor, id);
+	ASSERT(accessor.empty());
+#endif
+	mModelById.insert(accessor, id);
+	ModelEntry& entry = accessor->second;
+	entry.mModel.reset(model);
+	if (proceduralKey != nullptr) {
+		entry.mIsProcedural = true;
+		entry.mProceduralKey = *proceduralKey;
+	}
+	accessor.release();
+
+	return id;
+}
@@ -1,9 +1,11 @@
 #pragma once
 
+#include <cstdint>
 #include <d3d12.h>
 #include <memory>
 #include <mutex>
 #include <tbb\concurrent_hash_map.h>
+#include <vector>
 #include <wrl.h>
 
 #include <ModelManager/Model.h>
@@ -11,6 +13,12 @@
 // This class is responsible to create/get/erase models or geometry
 // - Models
 // - Geometry
+// Procedural geometry is cached by its parameters: identical requests return
+// the same id and model, and nothing is recorded in the command list for them.
+// - Each request adds a reference to the model, and Erase() removes one.
+// - Cached geometry is only shared after UploadFlushed() was called for its id,
+// so its buffers are ready in the GPU. Until then, identical requests record their
+// own geometry creation in the command list.
 class ModelManager {
 public:
 	static ModelManager& Create() noexcept;
@@ -29,6 +37,13 @@ public:
 		Microsoft::WRL::ComPtr<ID3D12Resource>& uploadVertexBuffer,
 		Microsoft::WRL::ComPtr<ID3D12Resource>& uploadIndexBuffer) noexcept;
 
+	// Same, with the meshes of a model file already imported (see Model::ImportMeshes())
+	std::size_t CreateModel(
+		const std::vector<GeometryGenerator::MeshData>& meshes,
+		Model* &model, ID3D12GraphicsCommandList& cmdList,
+		Microsoft::WRL::ComPtr<ID3D12Resource>& uploadVertexBuffer,
+		Microsoft::WRL::ComPtr<ID3D12Resource>& uploadIndexBuffer) noexcept;
+
 	// Creates a box centered at the origin with the given dimensions, where each
 	// face has m rows and n columns of vertices.
 	std::size_t CreateBox(
@@ -111,17 +126,78 @@ public:
 	// Asserts if id does not exist
 	Model& GetModel(const std::size_t id) noexcept;
 
+	// Must be called once the command list of the request that returned id
+	// was executed and completed, so its procedural geometry can be shared.
 	// Asserts if id is not present
+	void UploadFlushed(const std::size_t id) noexcept;
+
+	// Removes a reference to the model. Its geometry is freed when there are
+	// no references left. Asserts if id is not present
 	void Erase(const std::size_t id) noexcept;
 
 	// Invalidate all ids.
-	__forceinline void Clear() noexcept { mModelById.clear(); }
+	__forceinline void Clear() noexcept { mModelById.clear(); mIdByProceduralKey.clear(); }
 
 private:
 	ModelManager() = default;
 
-	using ModelById = tbb::concurrent_hash_map<std::size_t, std::unique_ptr<Model>>;
+	// Procedural geometry type and its parameters (unsigned parameters are stored as floats)
+	struct ProceduralKey {
+		enum Type : std::uint32_t {
+			BOX = 0U,
+			SPHERE,
+			GEOSPHERE,
+			CYLINDER,
+			GRID,
+			QUAD,
+			FULLSCREEN_QUAD,
+		};
+
+		static const std::uint32_t sMaxParams{ 5U };
+
+		Type mType;
+		float mParams[sMaxParams];
+	};
+
+	struct ProceduralKeyHashCompare {
+		static std::size_t hash(const ProceduralKey& key) noexcept;
+		static bool equal(const ProceduralKey& key1, const ProceduralKey& key2) noexcept;
+	};
+
+	struct ModelEntry {
+		std::unique_ptr<Model> mModel;
+		std::uint32_t mRefCount{ 1U };
+
+		// Procedural key is stored with the model, to forget it when the model is erased
+		bool mIsProcedural{ false };
+		bool mIsUploadFlushed{ false };
+		ProceduralKey mProceduralKey{};
+	};
+
+	// Returns true and fills id and model if key was already generated and uploaded.
+	bool FindProceduralModel(const ProceduralKey& key, std::size_t& id, Model* &model) noexcept;
+
+	// Adds a reference to the model and returns true if it exists and its upload was flushed.
+	bool AcquireProceduralModel(const std::size_t id, Model* &model) noexcept;
+
+	// Creates the model from mesh data, registers it under key and returns its id.
+	// If the same key was registered and uploaded in the meantime, its model is returned instead.
+	std::size_t InsertProceduralModel(
+		const ProceduralKey& key,
+		const GeometryGenerator::MeshData& meshData,
+		Model* &model,
+		ID3D12GraphicsCommandList& cmdList,
+		Microsoft::WRL::ComPtr<ID3D12Resource>& uploadVertexBuffer,
+		Microsoft::WRL::ComPtr<ID3D12Resource>& uploadIndexBuffer) noexcept;
+
+	// proceduralKey is nullptr for loaded models
+	std::size_t InsertModel(Model* model, const ProceduralKey* proceduralKey) noexcept;
+
+	using ModelById = tbb::concurrent_hash_map<std::size_t, ModelEntry>;
 	ModelById mModelById;
 
+	using IdByProceduralKey = tbb::concurrent_hash_map<ProceduralKey, std::size_t, ProceduralKeyHashCompare>;
+	IdByProceduralKey mIdByProceduralKey;
+
 	std::mutex mMutex;
 };
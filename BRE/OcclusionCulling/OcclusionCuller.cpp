@@ -0,0 +1,472 @@
+#include "OcclusionCuller.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+	// Tolerance used when box depths are compared with occluders depths, so an
+	// occluder does not occlude its own bounds because of precision errors.
+	const float sDepthEpsilon{ 1.0e-5f };
+
+	// Triangles with a smaller screen area (in pixels) are skipped
+	const float sMinTriangleArea{ 1.0e-4f };
+
+	// Stores p * m (p is a point, with w = 1) in result
+	__forceinline void TransformPoint(const float p[3U], const float m[16U], float result[4U]) noexcept {
+		for (std::uint32_t j = 0U; j < 4U; ++j) {
+			result[j] = p[0U] * m[j] + p[1U] * m[4U + j] + p[2U] * m[8U + j] + m[12U + j];
+		}
+	}
+
+	void Multiply(const float a[16U], const float b[16U], float result[16U]) noexcept {
+		for (std::uint32_t i = 0U; i < 4U; ++i) {
+			for (std::uint32_t j = 0U; j < 4U; ++j) {
+				result[i * 4U + j] =
+					a[i * 4U] * b[j] +
+					a[i * 4U + 1U] * b[4U + j] +
+					a[i * 4U + 2U] * b[8U + j] +
+					a[i * 4U + 3U] * b[12U + j];
+			}
+		}
+	}
+
+	// Edge function A * x + B * y + C. It is positive at the left of a -> b (with y down, and
+	// counterclockwise triangles).
+	// C is computed from the same vertex for a -> b and b -> a, so the edge functions of
+	// triangles sharing an edge are exactly opposite, and pixel centers on it are not missed by both.
+	struct Edge {
+		Edge(const float a[3U], const float b[3U]) noexcept
+			: mA(a[1U] - b[1U])
+			, mB(b[0U] - a[0U])
+		{
+			const float* base{ (a[0U] < b[0U] || (a[0U] == b[0U] && a[1U] < b[1U])) ? a : b };
+			mC = -(mA * base[0U] + mB * base[1U]);
+		}
+
+		float mA;
+		float mB;
+		float mC;
+	};
+
+	// Triangle edges, depth plane and pixels rectangle.
+	// Edge functions and depth are evaluated at pixel centers as a * x + (b * y + c),
+	// in the same order by all kernels, so SSE2 and AVX results are equal to scalar ones.
+	struct TriangleSetup {
+		Edge mE0;
+		Edge mE1;
+		Edge mE2;
+		float mDepthA;
+		float mDepthB;
+		float mDepthC;
+		std::uint32_t mX0;
+		std::uint32_t mX1;
+		std::uint32_t mY0;
+		std::uint32_t mY1;
+	};
+
+	void RasterizeRowsScalar(const TriangleSetup& t, float* depthBuffer, const std::uint32_t width) noexcept {
+		for (std::uint32_t y = t.mY0; y <= t.mY1; ++y) {
+			const float py{ static_cast<float>(y) + 0.5f };
+			const float e0Row{ t.mE0.mB * py + t.mE0.mC };
+			const float e1Row{ t.mE1.mB * py + t.mE1.mC };
+			const float e2Row{ t.mE2.mB * py + t.mE2.mC };
+			const float zRow{ t.mDepthB * py + t.mDepthC };
+			float* row{ depthBuffer + y * width };
+			for (std::uint32_t x = t.mX0; x <= t.mX1; ++x) {
+				const float px{ static_cast<float>(x) + 0.5f };
+				if (t.mE0.mA * px + e0Row >= 0.0f && t.mE1.mA * px + e1Row >= 0.0f && t.mE2.mA * px + e2Row >= 0.0f) {
+					row[x] = std::min(row[x], t.mDepthA * px + zRow);
+				}
+			}
+		}
+	}
+
+#if defined(_M_X64) || defined(__SSE2__)
+	void RasterizeRowsSSE2(const TriangleSetup& t, float* depthBuffer, const std::uint32_t width) noexcept {
+		const std::uint32_t simdWidth{ 4U };
+		const __m128 laneOffsets{ _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f) };
+		const __m128 zero{ _mm_setzero_ps() };
+		const __m128 e0A{ _mm_set1_ps(t.mE0.mA) };
+		const __m128 e1A{ _mm_set1_ps(t.mE1.mA) };
+		const __m128 e2A{ _mm_set1_ps(t.mE2.mA) };
+		const __m128 zA{ _mm_set1_ps(t.mDepthA) };
+		for (std::uint32_t y = t.mY0; y <= t.mY1; ++y) {
+			const float py{ static_cast<float>(y) + 0.5f };
+			const __m128 e0Row{ _mm_set1_ps(t.mE0.mB * py + t.mE0.mC) };
+			const __m128 e1Row{ _mm_set1_ps(t.mE1.mB * py + t.mE1.mC) };
+			const __m128 e2Row{ _mm_set1_ps(t.mE2.mB * py + t.mE2.mC) };
+			const __m128 zRow{ _mm_set1_ps(t.mDepthB * py + t.mDepthC) };
+			float* row{ depthBuffer + y * width };
+
+			// Pixels of the first and last blocks that are outside the rectangle are outside the triangle too
+			for (std::uint32_t x = t.mX0 & ~(simdWidth - 1U); x <= t.mX1; x += simdWidth) {
+				const __m128 px{ _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), laneOffsets) };
+				const __m128 w0{ _mm_add_ps(_mm_mul_ps(e0A, px), e0Row) };
+				const __m128 w1{ _mm_add_ps(_mm_mul_ps(e1A, px), e1Row) };
+				const __m128 w2{ _mm_add_ps(_mm_mul_ps(e2A, px), e2Row) };
+				const __m128 inside{ _mm_and_ps(_mm_cmpge_ps(w0, zero), _mm_and_ps(_mm_cmpge_ps(w1, zero), _mm_cmpge_ps(w2, zero))) };
+				if (_mm_movemask_ps(inside) == 0) {
+					continue;
+				}
+
+				const __m128 z{ _mm_add_ps(_mm_mul_ps(zA, px), zRow) };
+				const __m128 depth{ _mm_loadu_ps(row + x) };
+				const __m128 minDepth{ _mm_min_ps(depth, z) };
+				_mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, minDepth), _mm_andnot_ps(inside, depth)));
+			}
+		}
+	}
+#endif
+
+#if defined(__AVX__)
+	void RasterizeRowsAVX(const TriangleSetup& t, float* depthBuffer, const std::uint32_t width) noexcept {
+		const std::uint32_t simdWidth{ 8U };
+		const __m256 laneOffsets{ _mm256_setr_ps(0.5f, 1.5f, 2.5f, 3.5f, 4.5f, 5.5f, 6.5f, 7.5f) };
+		const __m256 zero{ _mm256_setzero_ps() };
+		const __m256 e0A{ _mm256_set1_ps(t.mE0.mA) };
+		const __m256 e1A{ _mm256_set1_ps(t.mE1.mA) };
+		const __m256 e2A{ _mm256_set1_ps(t.mE2.mA) };
+		const __m256 zA{ _mm256_set1_ps(t.mDepthA) };
+		for (std::uint32_t y = t.mY0; y <= t.mY1; ++y) {
+			const float py{ static_cast<float>(y) + 0.5f };
+			const __m256 e0Row{ _mm256_set1_ps(t.mE0.mB * py + t.mE0.mC) };
+			const __m256 e1Row{ _mm256_set1_ps(t.mE1.mB * py + t.mE1.mC) };
+			const __m256 e2Row{ _mm256_set1_ps(t.mE2.mB * py + t.mE2.mC) };
+			const __m256 zRow{ _mm256_set1_ps(t.mDepthB * py + t.mDepthC) };
+			float* row{ depthBuffer + y * width };
+			for (std::uint32_t x = t.mX0 & ~(simdWidth - 1U); x <= t.mX1; x += simdWidth) {
+				const __m256 px{ _mm256_add_ps(_mm256_set1_ps(static_cast<float>(x)), laneOffsets) };
+				const __m256 w0{ _mm256_add_ps(_mm256_mul_ps(e0A, px), e0Row) };
+				const __m256 w1{ _mm256_add_ps(_mm256_mul_ps(e1A, px), e1Row) };
+				const __m256 w2{ _mm256_add_ps(_mm256_mul_ps(e2A, px), e2Row) };
+				const __m256 inside{ _mm256_and_ps(
+					_mm256_cmp_ps(w0, zero, _CMP_GE_OQ),
+					_mm256_and_ps(_mm256_cmp_ps(w1, zero, _CMP_GE_OQ), _mm256_cmp_ps(w2, zero, _CMP_GE_OQ))) };
+				if (_mm256_movemask_ps(inside) == 0) {
+					continue;
+				}
+
+				const __m256 z{ _mm256_add_ps(_mm256_mul_ps(zA, px), zRow) };
+				const __m256 depth{ _mm256_loadu_ps(row + x) };
+				_mm256_storeu_ps(row + x, _mm256_blendv_ps(depth, _mm256_min_ps(depth, z), inside));
+			}
+		}
+	}
+#endif
+
+#if defined(__AVX2__)
+	// Like RasterizeRowsAVX(), but edge functions and depth are evaluated with fused
+	// multiply-adds (one rounding instead of two), and the 3 edge tests are merged
+	// with sign bits: a pixel is inside if no edge function is negative.
+	// Only pixels whose center is almost on an edge can have a different coverage.
+	void RasterizeRowsAVX2(const TriangleSetup& t, float* depthBuffer, const std::uint32_t width) noexcept {
+		const std::uint32_t simdWidth{ 8U };
+		const __m256 laneOffsets{ _mm256_setr_ps(0.5f, 1.5f, 2.5f, 3.5f, 4.5f, 5.5f, 6.5f, 7.5f) };
+		const __m256 blockStep{ _mm256_set1_ps(static_cast<float>(simdWidth)) };
+		const __m256 e0A{ _mm256_set1_ps(t.mE0.mA) };
+		const __m256 e1A{ _mm256_set1_ps(t.mE1.mA) };
+		const __m256 e2A{ _mm256_set1_ps(t.mE2.mA) };
+		const __m256 zA{ _mm256_set1_ps(t.mDepthA) };
+		const std::uint32_t firstX{ t.mX0 & ~(simdWidth - 1U) };
+		for (std::uint32_t y = t.mY0; y <= t.mY1; ++y) {
+			const float py{ static_cast<float>(y) + 0.5f };
+			const __m256 e0Row{ _mm256_set1_ps(t.mE0.mB * py + t.mE0.mC) };
+			const __m256 e1Row{ _mm256_set1_ps(t.mE1.mB * py + t.mE1.mC) };
+			const __m256 e2Row{ _mm256_set1_ps(t.mE2.mB * py + t.mE2.mC) };
+			const __m256 zRow{ _mm256_set1_ps(t.mDepthB * py + t.mDepthC) };
+			float* row{ depthBuffer + y * width };
+			__m256 px{ _mm256_add_ps(_mm256_set1_ps(static_cast<float>(firstX)), laneOffsets) };
+			for (std::uint32_t x = firstX; x <= t.mX1; x += simdWidth, px = _mm256_add_ps(px, blockStep)) {
+				const __m256 w0{ _mm256_fmadd_ps(e0A, px, e0Row) };
+				const __m256 w1{ _mm256_fmadd_ps(e1A, px, e1Row) };
+				const __m256 w2{ _mm256_fmadd_ps(e2A, px, e2Row) };
+
+				// Lanes with a negative edge function have their sign bit set
+				const __m256i outside{ _mm256_srai_epi32(_mm256_castps_si256(_mm256_or_ps(w0, _mm256_or_ps(w1, w2))), 31) };
+				if (_mm256_testc_si256(outside, _mm256_set1_epi32(-1)) != 0) {
+					continue;
+				}
+
+				const __m256 z{ _mm256_fmadd_ps(zA, px, zRow) };
+				const __m256 depth{ _mm256_loadu_ps(row + x) };
+				_mm256_storeu_ps(row + x, _mm256_blendv_ps(_mm256_min_ps(depth, z), depth, _mm256_castsi256_ps(outside)));
+			}
+		}
+	}
+#endif
+}
+
+OcclusionCuller::OcclusionCuller(const std::uint32_t width, const std::uint32_t height) noexcept
+	: mWidth(width)
+	, mHeight(height)
+	, mTilesX(width / sTileSize)
+	, mTilesY(height / sTileSize)
+	, mDepth(width * height, 1.0f)
+	, mTileMaxDepth(mTilesX * mTilesY, 1.0f)
+{
+	ASSERT(width > 0U && width % sTileSize == 0U);
+	ASSERT(height > 0U && height % sTileSize == 0U);
+}
+
+OcclusionCuller::Kernel OcclusionCuller::WidestKernel() noexcept {
+#if defined(__AVX2__)
+	return AVX2;
+#elif defined(__AVX__)
+	return AVX;
+#elif defined(_M_X64) || defined(__SSE2__)
+	return SSE2;
+#else
+	return SCALAR;
+#endif
+}
+
+void OcclusionCuller::SetKernel(const Kernel kernel) noexcept {
+	ASSERT(kernel <= WidestKernel());
+	mKernel = kernel;
+}
+
+void OcclusionCuller::SelectOccluders(
+	const OccluderInstance* candidates,
+	const std::uint32_t candidateCount,
+	const float eyePosition[3U],
+	const std::uint32_t maxTriangleCount,
+	std::vector<std::uint32_t>& selected) noexcept {
+	ASSERT(candidates != nullptr || candidateCount == 0U);
+	ASSERT(eyePosition != nullptr);
+
+	// Squared radius over squared distance is proportional to the projected area
+	std::vector<float> scores(candidateCount);
+	std::vector<std::uint32_t> sortedCandidates(candidateCount);
+	for (std::uint32_t i = 0U; i < candidateCount; ++i) {
+		const OccluderInstance& candidate{ candidates[i] };
+		ASSERT(candidate.mMesh != nullptr);
+		const float dx{ candidate.mSphereCenter[0U] - eyePosition[0U] };
+		const float dy{ candidate.mSphereCenter[1U] - eyePosition[1U] };
+		const float dz{ candidate.mSphereCenter[2U] - eyePosition[2U] };
+		const float sqrDist{ std::max(dx * dx + dy * dy + dz * dz, 1.0e-4f) };
+		scores[i] = candidate.mSphereRadius * candidate.mSphereRadius / sqrDist;
+		sortedCandidates[i] = i;
+	}
+
+	std::sort(
+		sortedCandidates.begin(),
+		sortedCandidates.end(),
+		[&scores](const std::uint32_t a, const std::uint32_t b) { return scores[a] > scores[b]; });
+
+	selected.clear();
+	std::uint32_t triangleCount{ 0U };
+	for (const std::uint32_t candidateIndex : sortedCandidates) {
+		const std::uint32_t candidateTriangleCount{ candidates[candidateIndex].mMesh->TriangleCount() };
+		if (triangleCount + candidateTriangleCount <= maxTriangleCount) {
+			selected.push_back(candidateIndex);
+			triangleCount += candidateTriangleCount;
+		}
+	}
+}
+
+void OcclusionCuller::BeginFrame(const float viewProj[16U]) noexcept {
+	ASSERT(viewProj != nullptr);
+
+	std::copy(viewProj, viewProj + 16U, mViewProj);
+	std::fill(mDepth.begin(), mDepth.end(), 1.0f);
+	std::fill(mTileMaxDepth.begin(), mTileMaxDepth.end(), 1.0f);
+	mRasterizedTriangleCount = 0U;
+}
+
+void OcclusionCuller::RasterizeOccluder(const OccluderMesh& mesh, const float world[16U]) noexcept {
+	ASSERT(world != nullptr);
+	ASSERT(mesh.mPositions.size() % 3UL == 0UL);
+	ASSERT(mesh.mIndices.size() % 3UL == 0UL);
+
+	float worldViewProj[16U];
+	Multiply(world, mViewProj, worldViewProj);
+
+	// Screen space positions (x, y in pixels, and depth). Depth is negative
+	// if the vertex is in front of the near plane.
+	const std::size_t vertexCount{ mesh.mPositions.size() / 3UL };
+	std::vector<float> screenPositions(vertexCount * 3UL);
+	const float halfWidth{ static_cast<float>(mWidth) * 0.5f };
+	const float halfHeight{ static_cast<float>(mHeight) * 0.5f };
+	for (std::size_t i = 0UL; i < vertexCount; ++i) {
+		float clip[4U];
+		TransformPoint(&mesh.mPositions[i * 3UL], worldViewProj, clip);
+		float* screen{ &screenPositions[i * 3UL] };
+		if (clip[3U] <= 0.0f || clip[2U] < 0.0f) {
+			screen[2U] = -1.0f;
+			continue;
+		}
+
+		const float invW{ 1.0f / clip[3U] };
+		screen[0U] = (clip[0U] * invW + 1.0f) * halfWidth;
+		screen[1U] = (1.0f - clip[1U] * invW) * halfHeight;
+		screen[2U] = std::min(clip[2U] * invW, 1.0f);
+	}
+
+	const std::size_t indexCount{ mesh.mIndices.size() };
+	for (std::size_t i = 0UL; i < indexCount; i += 3UL) {
+		const float* v0{ &screenPositions[mesh.mIndices[i] * 3UL] };
+		const float* v1{ &screenPositions[mesh.mIndices[i + 1UL] * 3UL] };
+		const float* v2{ &screenPositions[mesh.mIndices[i + 2UL] * 3UL] };
+		if (v0[2U] < 0.0f || v1[2U] < 0.0f || v2[2U] < 0.0f) {
+			continue;
+		}
+
+		RasterizeTriangle(v0, v1, v2);
+	}
+}
+
+void OcclusionCuller::EndFrame() noexcept {
+	for (std::uint32_t tileY = 0U; tileY < mTilesY; ++tileY) {
+		for (std::uint32_t tileX = 0U; tileX < mTilesX; ++tileX) {
+			float maxDepth{ 0.0f };
+			for (std::uint32_t y = tileY * sTileSize; y < (tileY + 1U) * sTileSize; ++y) {
+				const float* row{ &mDepth[y * mWidth + tileX * sTileSize] };
+				for (std::uint32_t x = 0U; x < sTileSize; ++x) {
+					maxDepth = std::max(maxDepth, row[x]);
+				}
+			}
+
+			mTileMaxDepth[tileY * mTilesX + tileX] = maxDepth;
+		}
+	}
+}
+
+bool OcclusionCuller::IsVisible(const Aabb& box) const noexcept {
+	// Screen rectangle and nearest depth of box corners. As depth increases with
+	// view space depth, the nearest point of the box is one of its corners.
+	float minX{ std::numeric_limits<float>::max() };
+	float minY{ std::numeric_limits<float>::max() };
+	float maxX{ -std::numeric_limits<float>::max() };
+	float maxY{ -std::numeric_limits<float>::max() };
+	float minDepth{ std::numeric_limits<float>::max() };
+	for (std::uint32_t i = 0U; i < 8U; ++i) {
+		const float corner[3U]{
+			(i & 1U) != 0U ? box.mMax[0U] : box.mMin[0U],
+			(i & 2U) != 0U ? box.mMax[1U] : box.mMin[1U],
+			(i & 4U) != 0U ? box.mMax[2U] : box.mMin[2U] };
+		float clip[4U];
+		TransformPoint(corner, mViewProj, clip);
+		if (clip[3U] <= 0.0f || clip[2U] < 0.0f) {
+			return true;
+		}
+
+		const float invW{ 1.0f / clip[3U] };
+		const float x{ (clip[0U] * invW + 1.0f) * 0.5f * static_cast<float>(mWidth) };
+		const float y{ (1.0f - clip[1U] * invW) * 0.5f * static_cast<float>(mHeight) };
+		minX = std::min(minX, x);
+		maxX = std::max(maxX, x);
+		minY = std::min(minY, y);
+		maxY = std::max(maxY, y);
+		minDepth = std::min(minDepth, clip[2U] * invW);
+	}
+
+	if (maxX < 0.0f || maxY < 0.0f || minX >= static_cast<float>(mWidth) || minY >= static_cast<float>(mHeight)) {
+		return true;
+	}
+
+	// Pixels touched by the rectangle, plus a pixel border. Occluders only cover pixels
+	// whose centers are inside them, so the box could be visible in the border.
+	const std::uint32_t x0{ static_cast<std::uint32_t>(std::max(minX - 1.0f, 0.0f)) };
+	const std::uint32_t y0{ static_cast<std::uint32_t>(std::max(minY - 1.0f, 0.0f)) };
+	const std::uint32_t x1{ std::min(static_cast<std::uint32_t>(maxX + 1.0f), mWidth - 1U) };
+	const std::uint32_t y1{ std::min(static_cast<std::uint32_t>(maxY + 1.0f), mHeight - 1U) };
+	const float testDepth{ minDepth - sDepthEpsilon };
+
+	for (std::uint32_t tileY = y0 / sTileSize; tileY <= y1 / sTileSize; ++tileY) {
+		for (std::uint32_t tileX = x0 / sTileSize; tileX <= x1 / sTileSize; ++tileX) {
+			// Box is behind all the tile pixels
+			if (testDepth > mTileMaxDepth[tileY * mTilesX + tileX]) {
+				continue;
+			}
+
+			const std::uint32_t pixelY0{ std::max(y0, tileY * sTileSize) };
+			const std::uint32_t pixelY1{ std::min(y1, tileY * sTileSize + sTileSize - 1U) };
+			const std::uint32_t pixelX0{ std::max(x0, tileX * sTileSize) };
+			const std::uint32_t pixelX1{ std::min(x1, tileX * sTileSize + sTileSize - 1U) };
+			for (std::uint32_t y = pixelY0; y <= pixelY1; ++y) {
+				const float* row{ &mDepth[y * mWidth] };
+				for (std::uint32_t x = pixelX0; x <= pixelX1; ++x) {
+					if (testDepth <= row[x]) {
+						return true;
+					}
+				}
+			}
+		}
+	}
+
+	return false;
+}
+
+void OcclusionCuller::RasterizeTriangle(const float v0[3U], const float v1[3U], const float v2[3U]) noexcept {
+	// Make triangle counterclockwise, so edge functions are positive inside
+	const float area{ (v1[0U] - v0[0U]) * (v2[1U] - v0[1U]) - (v1[1U] - v0[1U]) * (v2[0U] - v0[0U]) };
+	if (std::abs(area) < sMinTriangleArea) {
+		return;
+	}
+
+	if (area < 0.0f) {
+		std::swap(v1, v2);
+	}
+	const float absArea{ std::abs(area) };
+
+	// Bounding rectangle, clamped to the screen
+	const float minX{ std::min(v0[0U], std::min(v1[0U], v2[0U])) };
+	const float maxX{ std::max(v0[0U], std::max(v1[0U], v2[0U])) };
+	const float minY{ std::min(v0[1U], std::min(v1[1U], v2[1U])) };
+	const float maxY{ std::max(v0[1U], std::max(v1[1U], v2[1U])) };
+	if (maxX < 0.0f || maxY < 0.0f || minX >= static_cast<float>(mWidth) || minY >= static_cast<float>(mHeight)) {
+		return;
+	}
+
+	// Depth plane: z = z0 + dzdx * (x - x0) + dzdy * (y - y0).
+	// It is offset to the farthest depth of the triangle inside each pixel.
+	const float dx1{ v1[0U] - v0[0U] };
+	const float dy1{ v1[1U] - v0[1U] };
+	const float dx2{ v2[0U] - v0[0U] };
+	const float dy2{ v2[1U] - v0[1U] };
+	const float dz1{ v1[2U] - v0[2U] };
+	const float dz2{ v2[2U] - v0[2U] };
+	const float dzdx{ (dz1 * dy2 - dz2 * dy1) / absArea };
+	const float dzdy{ (dz2 * dx1 - dz1 * dx2) / absArea };
+
+	const TriangleSetup triangle{
+		Edge(v1, v2),
+		Edge(v2, v0),
+		Edge(v0, v1),
+		dzdx,
+		dzdy,
+		v0[2U] - dzdx * v0[0U] - dzdy * v0[1U] + (std::abs(dzdx) + std::abs(dzdy)) * 0.5f,
+		static_cast<std::uint32_t>(std::max(minX, 0.0f)),
+		std::min(static_cast<std::uint32_t>(maxX), mWidth - 1U),
+		static_cast<std::uint32_t>(std::max(minY, 0.0f)),
+		std::min(static_cast<std::uint32_t>(maxY), mHeight - 1U) };
+
+	++mRasterizedTriangleCount;
+
+	switch (mKernel) {
+#if defined(__AVX2__)
+	case AVX2:
+		RasterizeRowsAVX2(triangle, mDepth.data(), mWidth);
+		break;
+#endif
+#if defined(__AVX__)
+	case AVX:
+		RasterizeRowsAVX(triangle, mDepth.data(), mWidth);
+		break;
+#endif
+#if defined(_M_X64) || defined(__SSE2__)
+	case SSE2:
+		RasterizeRowsSSE2(triangle, mDepth.data(), mWidth);
+		break;
+#endif
+	default:
+		RasterizeRowsScalar(triangle, mDepth.data(), mWidth);
+		break;
+	}
+}
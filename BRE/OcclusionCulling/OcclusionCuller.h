@@ -0,0 +1,136 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <MathUtils/BoundingVolumes.h>
+#include <Utils/DebugUtils.h>
+
+// Triangles (in mesh space) rasterized by OcclusionCuller.
+// They must be inside the mesh they represent (the mesh itself if it is low poly,
+// or a simplified proxy), otherwise visible objects could be culled.
+struct OccluderMesh {
+	OccluderMesh() = default;
+	~OccluderMesh() = default;
+	OccluderMesh(const OccluderMesh&) = delete;
+	const OccluderMesh& operator=(const OccluderMesh&) = delete;
+	OccluderMesh(OccluderMesh&&) = default;
+	OccluderMesh& operator=(OccluderMesh&&) = default;
+
+	__forceinline std::uint32_t TriangleCount() const noexcept { return static_cast<std::uint32_t>(mIndices.size() / 3UL); }
+
+	// 3 floats per position
+	std::vector<float> mPositions;
+	std::vector<std::uint32_t> mIndices;
+};
+
+// Occluder that can be rasterized in a frame
+struct OccluderInstance {
+	const OccluderMesh* mMesh;
+
+	// Row major world matrix (row vectors, translation in the 4th row)
+	const float* mWorld;
+
+	// World space bounding sphere, used to estimate its screen size
+	float mSphereCenter[3U];
+	float mSphereRadius;
+};
+
+// CPU occlusion culling. Occluders are rasterized in a low resolution depth buffer,
+// and bounding boxes are tested against it (first against the max depth of each tile,
+// and then against the depth of the pixels of the tiles that are not conclusive).
+// Depth convention is D3D's: clip space depth in [0, 1], where 0 is the near plane.
+// Rows are rasterized 8 (AVX, AVX2) or 4 (SSE2) pixels at a time. The AVX2 kernel uses
+// fused multiply-adds, so its coverage can differ from the other kernels in pixels whose
+// center is on a triangle edge. Kernel can be changed (to compare results) among the ones
+// the instruction set enabled at compile time supports.
+// It does not depend on DirectXMath or D3D, so it can be built on any platform.
+// Steps:
+// - Call SelectOccluders() to choose occluders for the current camera
+// - Call BeginFrame(), RasterizeOccluder() for each occluder and EndFrame()
+// - Call IsVisible() for each bounding box to test
+class OcclusionCuller {
+public:
+	// Tile size (in pixels) of the hierarchical depth buffer
+	static const std::uint32_t sTileSize{ 8U };
+
+	// Meshes with more triangles should not be used as occluders
+	static const std::uint32_t sMaxOccluderMeshTriangleCount{ 2048U };
+
+	// Triangle rasterization kernels
+	enum Kernel : std::uint32_t {
+		SCALAR = 0U,
+		SSE2,
+		AVX,
+		AVX2
+	};
+
+	// Widest kernel supported by the instruction set enabled at compile time.
+	// It is the default one.
+	static Kernel WidestKernel() noexcept;
+
+	// Width and height must be multiples of sTileSize
+	explicit OcclusionCuller(const std::uint32_t width, const std::uint32_t height) noexcept;
+	~OcclusionCuller() = default;
+	OcclusionCuller(const OcclusionCuller&) = delete;
+	const OcclusionCuller& operator=(const OcclusionCuller&) = delete;
+	OcclusionCuller(OcclusionCuller&&) = default;
+	OcclusionCuller& operator=(OcclusionCuller&&) = default;
+
+	// Sorts candidates by estimated screen size (from eye position) and stores in selected
+	// the indices of the biggest ones, until maxTriangleCount is reached.
+	static void SelectOccluders(
+		const OccluderInstance* candidates,
+		const std::uint32_t candidateCount,
+		const float eyePosition[3U],
+		const std::uint32_t maxTriangleCount,
+		std::vector<std::uint32_t>& selected) noexcept;
+
+	// Clears the depth buffer. viewProj is a row major view projection matrix (row vectors)
+	void BeginFrame(const float viewProj[16U]) noexcept;
+
+	// Pixels are written with the farthest triangle depth inside them, and triangles crossing
+	// the near plane are skipped, so results are conservative.
+	// Both triangle faces occlude.
+	void RasterizeOccluder(const OccluderMesh& mesh, const float world[16U]) noexcept;
+
+	// Updates tiles max depth. It must be called after all occluders are rasterized,
+	// and before testing.
+	void EndFrame() noexcept;
+
+	// Returns false if the world space box is fully behind rasterized occluders.
+	// Boxes crossing the near plane or outside the screen are considered visible (frustum culling
+	// is responsible of the latter).
+	bool IsVisible(const Aabb& box) const noexcept;
+
+	// Kernel must not be wider than WidestKernel()
+	void SetKernel(const Kernel kernel) noexcept;
+	__forceinline Kernel GetKernel() const noexcept { return mKernel; }
+
+	__forceinline std::uint32_t Width() const noexcept { return mWidth; }
+	__forceinline std::uint32_t Height() const noexcept { return mHeight; }
+	__forceinline const std::vector<float>& DepthBuffer() const noexcept { return mDepth; }
+
+	// Counters since last BeginFrame()
+	__forceinline std::uint32_t RasterizedTriangleCount() const noexcept { return mRasterizedTriangleCount; }
+
+private:
+	void RasterizeTriangle(const float v0[3U], const float v1[3U], const float v2[3U]) noexcept;
+
+	std::uint32_t mWidth{ 0U };
+	std::uint32_t mHeight{ 0U };
+	std::uint32_t mTilesX{ 0U };
+	std::uint32_t mTilesY{ 0U };
+
+	float mViewProj[16U]{};
+
+	// Row major. Each pixel stores the nearest occluder depth
+	std::vector<float> mDepth;
+
+	// Each tile stores the farthest depth of its pixels
+	std::vector<float> mTileMaxDepth;
+
+	std::uint32_t mRasterizedTriangleCount{ 0U };
+
+	Kernel mKernel{ WidestKernel() };
+};
@@ -5,6 +5,7 @@
 #include <RootSignatureManager/RootSignatureManager.h>
 #include <ShaderManager/ShaderManager.h>
 #include <Utils/DebugUtils.h>
+#include <Utils/HashUtils.h>
 
 namespace {
 
@@ -13,9 +14,10 @@ namespace {
 	void BuildPSO(const PSOCreator::PSOParams& psoParams, ID3D12PipelineState* &pso, ID3D12RootSignature* &rootSign) noexcept {
 		ASSERT(psoParams.ValidateData());
 
-		ID3DBlob* rootSignBlob{ nullptr };
-		ShaderManager::Get().LoadShaderFile(psoParams.mRootSignFilename, rootSignBlob);
-		RootSignatureManager::Get().CreateRootSignature(*rootSignBlob, rootSign);
+		D3D12_SHADER_BYTECODE rootSignByteCode{};
+		ShaderManager::Get().LoadShaderFile(psoParams.mRootSignFilename, rootSignByteCode);
+		RootSignatureManager::Get().CreateRootSignature(rootSignByteCode, rootSign);
+		const std::uint64_t rootSignHash{ HashUtils::HashBytes(rootSignByteCode.pShaderBytecode, rootSignByteCode.BytecodeLength) };
 
 		D3D12_SHADER_BYTECODE vertexShader{};
 		if (psoParams.mVSFilename != nullptr) {
@@ -62,7 +64,7 @@ namespace {
 		desc.SampleMask = psoParams.mSampleMask;
 		desc.VS = vertexShader;
 
-		PSOManager::Get().CreateGraphicsPSO(desc, pso);
+		PSOManager::Get().CreateGraphicsPSO(desc, rootSignHash, pso);
 
 		ASSERT(pso != nullptr);
 		ASSERT(rootSign != nullptr);
@@ -5,7 +5,8 @@
 #include <DXUtils/D3DFactory.h>
 #include <Utils/DebugUtils.h>
 
-// Used to create Pipeline State Objects and Root Signatures (loaded from a shader file)
+// Used to create Pipeline State Objects and Root Signatures (loaded from a shader file).
+// Pipeline State Objects are cached by PSOManager, so identical parameters do not compile them again.
 namespace PSOCreator {
 	struct PSOParams {
 		PSOParams() = default;
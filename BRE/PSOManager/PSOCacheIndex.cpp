@@ -0,0 +1,67 @@
+#include "PSOCacheIndex.h"
+
+#include <cstring>
+
+#include <Utils/DebugUtils.h>
+
+std::uint32_t PSOCacheIndex::Acquire(const std::uint64_t key, bool& isNew) noexcept {
+	const std::uint32_t entry{ EntryCount() };
+	const std::pair<std::unordered_map<std::uint64_t, std::uint32_t>::iterator, bool> result{ mEntryByKey.emplace(key, entry) };
+	isNew = result.second;
+	if (isNew) {
+		mKeys.push_back(key);
+	}
+	else {
+		++mMemoryHitCount;
+	}
+
+	return result.first->second;
+}
+
+std::uint32_t PSOCacheIndex::Find(const std::uint64_t key) const noexcept {
+	const std::unordered_map<std::uint64_t, std::uint32_t>::const_iterator it{ mEntryByKey.find(key) };
+	return it == mEntryByKey.end() ? sInvalidEntry : it->second;
+}
+
+void PSOCacheIndex::RecordLoad(const std::uint32_t entry, const bool loadedFromLibrary) noexcept {
+	ASSERT(entry < EntryCount());
+	if (loadedFromLibrary) {
+		++mLibraryHitCount;
+	}
+	else {
+		++mCompileCount;
+		++mUnstoredCount;
+	}
+}
+
+void PSOCacheIndex::Clear() noexcept {
+	mEntryByKey.clear();
+	mKeys.clear();
+}
+
+std::wstring PSOCacheIndex::EntryName(const std::uint64_t key) noexcept {
+	static const wchar_t* sDigits{ L"0123456789ABCDEF" };
+	std::wstring name(L"PSO_0000000000000000");
+	const std::size_t digitsBegin{ 4UL };
+	for (std::size_t i = 0UL; i < 16UL; ++i) {
+		name[digitsBegin + i] = sDigits[(key >> (60UL - i * 4UL)) & 0xFUL];
+	}
+
+	return name;
+}
+
+bool PSOCacheIndex::ValidateFile(const void* data, const std::size_t size, std::size_t& librarySize) noexcept {
+	librarySize = 0UL;
+	if (data == nullptr || size < sizeof(FileHeader)) {
+		return false;
+	}
+
+	FileHeader header;
+	memcpy(&header, data, sizeof(FileHeader));
+	if (header.mMagic != FileHeader::sMagic || header.mVersion != FileHeader::sVersion || header.mDataSize != size - sizeof(FileHeader)) {
+		return false;
+	}
+
+	librarySize = static_cast<std::size_t>(header.mDataSize);
+	return librarySize > 0UL;
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <Utils/ForceInline.h>
+
+// Bookkeeping of the PSO cache. It does not use the device, PSOManager owns the pipeline states
+// (indexed by the entries returned here) and the pipeline library.
+// Steps:
+// - Call Acquire() with the description hash. If the entry is new, then load the PSO from the 
+// pipeline library using EntryName() and call RecordLoad() with the result (compile it if it was not loaded).
+// - Call HasUnstoredEntries() to know if the library should be serialized again, and MarkStored() after it.
+// Cache file is a FileHeader followed by the serialized library.
+class PSOCacheIndex {
+public:
+	static const std::uint32_t sInvalidEntry{ 0xFFFFFFFF };
+
+	struct FileHeader {
+		static const std::uint32_t sMagic{ 0x434F5350 }; // "PSOC"
+		static const std::uint32_t sVersion{ 1U };
+
+		std::uint32_t mMagic{ sMagic };
+		std::uint32_t mVersion{ sVersion };
+		std::uint64_t mDataSize{ 0UL };
+	};
+
+	PSOCacheIndex() = default;
+	~PSOCacheIndex() = default;
+	PSOCacheIndex(const PSOCacheIndex&) = delete;
+	const PSOCacheIndex& operator=(const PSOCacheIndex&) = delete;
+	PSOCacheIndex(PSOCacheIndex&&) = delete;
+	PSOCacheIndex& operator=(PSOCacheIndex&&) = delete;
+
+	// Returns the entry of the key, adding it if it was not present (and isNew is true).
+	// It is not thread safe.
+	std::uint32_t Acquire(const std::uint64_t key, bool& isNew) noexcept;
+
+	// Returns sInvalidEntry if key is not present
+	std::uint32_t Find(const std::uint64_t key) const noexcept;
+
+	// Records if a new entry was loaded from the library or compiled (and then it must be stored)
+	void RecordLoad(const std::uint32_t entry, const bool loadedFromLibrary) noexcept;
+
+	__forceinline bool HasUnstoredEntries() const noexcept { return mUnstoredCount > 0U; }
+	__forceinline void MarkStored() noexcept { mUnstoredCount = 0U; }
+
+	void Clear() noexcept;
+
+	// Name of the pipeline in the library. It only depends on the key, so it is stable across runs.
+	static std::wstring EntryName(const std::uint64_t key) noexcept;
+
+	// Returns true if data (the whole file) has a valid header and its size matches. 
+	// librarySize is the size of the serialized library, that follows the header.
+	static bool ValidateFile(const void* data, const std::size_t size, std::size_t& librarySize) noexcept;
+
+	__forceinline std::uint32_t EntryCount() const noexcept { return static_cast<std::uint32_t>(mKeys.size()); }
+	__forceinline std::uint64_t EntryKey(const std::uint32_t entry) const noexcept { return mKeys[entry]; }
+	__forceinline std::uint32_t MemoryHitCount() const noexcept { return mMemoryHitCount; }
+	__forceinline std::uint32_t LibraryHitCount() const noexcept { return mLibraryHitCount; }
+	__forceinline std::uint32_t CompileCount() const noexcept { return mCompileCount; }
+
+private:
+	std::unordered_map<std::uint64_t, std::uint32_t> mEntryByKey;
+	std::vector<std::uint64_t> mKeys;
+
+	std::uint32_t mMemoryHitCount{ 0U };
+	std::uint32_t mLibraryHitCount{ 0U };
+	std::uint32_t mCompileCount{ 0U };
+	std::uint32_t mUnstoredCount{ 0U };
+};
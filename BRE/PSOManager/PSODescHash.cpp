@@ -0,0 +1,94 @@
+#include "PSODescHash.h"
+
+#include <cstring>
+
+#include <Utils/DebugUtils.h>
+#include <Utils/HashUtils.h>
+
+namespace {
+	// Hashes a plain value (without padding) by its bytes
+	template<typename T>
+	std::uint64_t HashValue(const T& value, const std::uint64_t hash) noexcept {
+		return HashUtils::HashBytes(&value, sizeof(T), hash);
+	}
+
+	// Hashes a null terminated string (including the terminator, so "a", "b" differs from "ab")
+	std::uint64_t HashString(const char* str, const std::uint64_t hash) noexcept {
+		return str == nullptr ? HashValue(0U, hash) : HashUtils::HashBytes(str, strlen(str) + 1UL, hash);
+	}
+
+	std::uint64_t HashInputLayout(const D3D12_INPUT_LAYOUT_DESC& inputLayout, std::uint64_t hash) noexcept {
+		ASSERT(inputLayout.NumElements == 0U || inputLayout.pInputElementDescs != nullptr);
+		hash = HashValue(inputLayout.NumElements, hash);
+		for (std::uint32_t i = 0U; i < inputLayout.NumElements; ++i) {
+			const D3D12_INPUT_ELEMENT_DESC& element(inputLayout.pInputElementDescs[i]);
+			hash = HashString(element.SemanticName, hash);
+			hash = HashValue(element.SemanticIndex, hash);
+			hash = HashValue(element.Format, hash);
+			hash = HashValue(element.InputSlot, hash);
+			hash = HashValue(element.AlignedByteOffset, hash);
+			hash = HashValue(element.InputSlotClass, hash);
+			hash = HashValue(element.InstanceDataStepRate, hash);
+		}
+
+		return hash;
+	}
+
+	std::uint64_t HashStreamOutput(const D3D12_STREAM_OUTPUT_DESC& streamOutput, std::uint64_t hash) noexcept {
+		ASSERT(streamOutput.NumEntries == 0U || streamOutput.pSODeclaration != nullptr);
+		ASSERT(streamOutput.NumStrides == 0U || streamOutput.pBufferStrides != nullptr);
+		hash = HashValue(streamOutput.NumEntries, hash);
+		for (std::uint32_t i = 0U; i < streamOutput.NumEntries; ++i) {
+			const D3D12_SO_DECLARATION_ENTRY& entry(streamOutput.pSODeclaration[i]);
+			hash = HashValue(entry.Stream, hash);
+			hash = HashString(entry.SemanticName, hash);
+			hash = HashValue(entry.SemanticIndex, hash);
+			hash = HashValue(entry.StartComponent, hash);
+			hash = HashValue(entry.ComponentCount, hash);
+			hash = HashValue(entry.OutputSlot, hash);
+		}
+
+		hash = HashValue(streamOutput.NumStrides, hash);
+		if (streamOutput.NumStrides > 0U) {
+			hash = HashUtils::HashBytes(streamOutput.pBufferStrides, sizeof(std::uint32_t) * streamOutput.NumStrides, hash);
+		}
+
+		return HashValue(streamOutput.RasterizedStream, hash);
+	}
+}
+
+namespace PSODescHash {
+	std::uint64_t HashShaderByteCode(const D3D12_SHADER_BYTECODE& shaderByteCode) noexcept {
+		ASSERT(shaderByteCode.BytecodeLength == 0UL || shaderByteCode.pShaderBytecode != nullptr);
+		const std::uint64_t hash{ HashValue(static_cast<std::uint64_t>(shaderByteCode.BytecodeLength), HashUtils::sFnv1aOffsetBasis) };
+		return HashUtils::HashBytes(shaderByteCode.pShaderBytecode, shaderByteCode.BytecodeLength, hash);
+	}
+
+	std::uint64_t HashGraphicsPSODesc(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc, const std::uint64_t rootSignHash) noexcept {
+		// Blend, rasterizer, depth stencil and sample descriptions only have 4 bytes members, 
+		// so they do not have padding and can be hashed by their bytes.
+		std::uint64_t hash{ HashValue(rootSignHash, HashUtils::sFnv1aOffsetBasis) };
+		hash = HashValue(HashShaderByteCode(desc.VS), hash);
+		hash = HashValue(HashShaderByteCode(desc.PS), hash);
+		hash = HashValue(HashShaderByteCode(desc.DS), hash);
+		hash = HashValue(HashShaderByteCode(desc.HS), hash);
+		hash = HashValue(HashShaderByteCode(desc.GS), hash);
+		hash = HashStreamOutput(desc.StreamOutput, hash);
+		hash = HashValue(desc.BlendState, hash);
+		hash = HashValue(desc.SampleMask, hash);
+		hash = HashValue(desc.RasterizerState, hash);
+		hash = HashValue(desc.DepthStencilState, hash);
+		hash = HashInputLayout(desc.InputLayout, hash);
+		hash = HashValue(desc.IBStripCutValue, hash);
+		hash = HashValue(desc.PrimitiveTopologyType, hash);
+		hash = HashValue(desc.NumRenderTargets, hash);
+		hash = HashUtils::HashBytes(desc.RTVFormats, sizeof(desc.RTVFormats), hash);
+		hash = HashValue(desc.DSVFormat, hash);
+		hash = HashValue(desc.SampleDesc, hash);
+		hash = HashValue(desc.NodeMask, hash);
+		hash = HashValue(desc.Flags, hash);
+
+		// Cached PSO is not part of the pipeline description
+		return hash;
+	}
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cstdint>
+#include <d3d12.h>
+
+// Stable hashes of pipeline state descriptions, used as PSO cache keys.
+// Pointed data (shaders bytecode, input layout, stream output) is hashed by content,
+// so identical descriptions built from different buffers get the same key.
+// Root signature is an object, so its hash (of its serialized blob) must be provided.
+namespace PSODescHash {
+	std::uint64_t HashShaderByteCode(const D3D12_SHADER_BYTECODE& shaderByteCode) noexcept;
+
+	std::uint64_t HashGraphicsPSODesc(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc, const std::uint64_t rootSignHash) noexcept;
+}
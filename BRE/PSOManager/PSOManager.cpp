@@ -1,12 +1,17 @@
 #include "PSOManager.h"
 
+#include <cstring>
+#include <fstream>
 #include <memory>
 
+#include <PSOManager/PSODescHash.h>
 #include <Utils/DebugUtils.h>
 #include <Utils/NumberGeneration.h>
 
 namespace {
 	std::unique_ptr<PSOManager> gManager{ nullptr };
+
+	const char* sPipelineLibraryFilename{ "PSOCache.bin" };
 }
 
 PSOManager& PSOManager::Create(ID3D12Device& device) noexcept {
@@ -22,12 +27,51 @@ PSOManager& PSOManager::Get() noexcept {
 PSOManager::PSOManager(ID3D12Device& device) 
 	: mDevice(device) 
 {
+	// Pipeline libraries need ID3D12Device1. Without it, pipeline states are only cached in memory.
+	if (SUCCEEDED(mDevice.QueryInterface(IID_PPV_ARGS(mDevice1.GetAddressOf())))) {
+		LoadPipelineLibrary();
+	}
 }
 
-std::size_t PSOManager::CreateGraphicsPSO(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& psoDesc, ID3D12PipelineState* &pso) noexcept {
-	mMutex.lock();
-	CHECK_HR(mDevice.CreateGraphicsPipelineState(&psoDesc, IID_PPV_ARGS(&pso)));
-	mMutex.unlock();
+std::size_t PSOManager::CreateGraphicsPSO(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& psoDesc, const std::uint64_t rootSignHash, ID3D12PipelineState* &pso) noexcept {
+	const std::uint64_t key{ PSODescHash::HashGraphicsPSODesc(psoDesc, rootSignHash) };
+
+	std::unique_lock<std::mutex> lock(mMutex);
+	bool isNew{ false };
+	const std::uint32_t entry{ mCacheIndex.Acquire(key, isNew) };
+	if (isNew) {
+		ASSERT(mCachedPSOs.size() == entry);
+		mCachedPSOs.push_back(nullptr);
+		lock.unlock();
+
+		// Library loads of different pipelines are thread safe (same pipeline loads are 
+		// not, but only the thread that acquired the entry creates it).
+		Microsoft::WRL::ComPtr<ID3D12PipelineState> state;
+		bool loadedFromLibrary{ false };
+		if (mLibrary.Get() != nullptr) {
+			// Loading fails if the pipeline was not stored (or the library is from an older run with different shaders).
+			const std::wstring name(PSOCacheIndex::EntryName(key));
+			loadedFromLibrary = SUCCEEDED(mLibrary->LoadGraphicsPipeline(name.c_str(), &psoDesc, IID_PPV_ARGS(state.GetAddressOf())));
+			if (loadedFromLibrary == false) {
+				CHECK_HR(mDevice.CreateGraphicsPipelineState(&psoDesc, IID_PPV_ARGS(state.GetAddressOf())));
+				CHECK_HR(mLibrary->StorePipeline(name.c_str(), state.Get()));
+			}
+		}
+		else {
+			CHECK_HR(mDevice.CreateGraphicsPipelineState(&psoDesc, IID_PPV_ARGS(state.GetAddressOf())));
+		}
+
+		lock.lock();
+		mCacheIndex.RecordLoad(entry, loadedFromLibrary);
+		mCachedPSOs[entry] = state;
+		mPSOCreated.notify_all();
+	}
+	else {
+		// Wait if other thread is still creating it
+		mPSOCreated.wait(lock, [this, entry]() { return mCachedPSOs[entry].Get() != nullptr; });
+	}
+	pso = mCachedPSOs[entry].Get();
+	lock.unlock();
 	
 	const std::size_t id{ NumberGeneration::IncrementalSizeT() };
 	PSOById::accessor accessor;
@@ -58,4 +102,62 @@ void PSOManager::Erase(const std::size_t id) noexcept {
 	ASSERT(!accessor.empty());
 	mPSOById.erase(accessor);
 	accessor.release();
-}
\ No newline at end of file
+}
+
+void PSOManager::Clear() noexcept {
+	std::lock_guard<std::mutex> lock(mMutex);
+	mPSOById.clear();
+	mCacheIndex.Clear();
+	mCachedPSOs.clear();
+}
+
+void PSOManager::StorePipelineLibrary() noexcept {
+	std::lock_guard<std::mutex> lock(mMutex);
+	if (mLibrary.Get() == nullptr || mCacheIndex.HasUnstoredEntries() == false) {
+		return;
+	}
+
+	const std::size_t librarySize{ mLibrary->GetSerializedSize() };
+	std::vector<std::uint8_t> fileData(sizeof(PSOCacheIndex::FileHeader) + librarySize);
+	PSOCacheIndex::FileHeader header;
+	header.mDataSize = librarySize;
+	memcpy(fileData.data(), &header, sizeof(header));
+	CHECK_HR(mLibrary->Serialize(fileData.data() + sizeof(header), librarySize));
+
+	// Failing to write the cache is not an error, next run will compile pipeline states again.
+	std::ofstream fout{ sPipelineLibraryFilename, std::ios::binary | std::ios::trunc };
+	if (fout) {
+		fout.write(reinterpret_cast<const char*>(fileData.data()), fileData.size());
+	}
+
+	mCacheIndex.MarkStored();
+}
+
+void PSOManager::LoadPipelineLibrary() noexcept {
+	ASSERT(mDevice1.Get() != nullptr);
+	ASSERT(mLibrary.Get() == nullptr);
+
+	std::ifstream fin{ sPipelineLibraryFilename, std::ios::binary };
+	if (fin) {
+		fin.seekg(0, std::ios_base::end);
+		const std::size_t fileSize{ static_cast<std::size_t>(fin.tellg()) };
+		fin.seekg(0, std::ios_base::beg);
+		mLibraryFileData.resize(fileSize);
+		fin.read(reinterpret_cast<char*>(mLibraryFileData.data()), fileSize);
+		fin.close();
+	}
+
+	std::size_t librarySize{ 0UL };
+	if (PSOCacheIndex::ValidateFile(mLibraryFileData.data(), mLibraryFileData.size(), librarySize)) {
+		const std::uint8_t* libraryData{ mLibraryFileData.data() + sizeof(PSOCacheIndex::FileHeader) };
+		if (SUCCEEDED(mDevice1->CreatePipelineLibrary(libraryData, librarySize, IID_PPV_ARGS(mLibrary.GetAddressOf())))) {
+			return;
+		}
+	}
+
+	// There is no cache, it is corrupted, or it was created by a different driver or adapter. 
+	// Start an empty library, that will overwrite it.
+	mLibraryFileData.clear();
+	mLibrary.Reset();
+	CHECK_HR(mDevice1->CreatePipelineLibrary(nullptr, 0UL, IID_PPV_ARGS(mLibrary.GetAddressOf())));
+}
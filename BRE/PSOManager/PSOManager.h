@@ -1,11 +1,24 @@
 #pragma once
 
+#include <condition_variable>
+#include <cstdint>
 #include <d3d12.h>
 #include <mutex>
 #include <tbb/concurrent_hash_map.h>
+#include <vector>
 #include <wrl.h>
 
-// This class is responsible to create/get/erase pipeline state objects
+#include <PSOManager/PSOCacheIndex.h>
+
+// This class is responsible to create/get/erase pipeline state objects.
+// Pipeline states are cached by a hash of their description (see PSODescHash), so 
+// identical descriptions share the same ID3D12PipelineState.
+// If the device supports pipeline libraries, compiled pipeline states are also stored
+// in a library that is serialized to disk, and loaded from it in next runs (instead of compiling them).
+// Different pipeline states can be created concurrently (compilation does not hold the lock).
+// Steps:
+// - Call CreateGraphicsPSO() to get pipeline states.
+// - Call StorePipelineLibrary() once all pipeline states were created, to serialize new ones.
 class PSOManager {
 public:
 	static PSOManager& Create(ID3D12Device& device) noexcept;
@@ -17,7 +30,8 @@ public:
 	PSOManager(PSOManager&&) = delete;
 	PSOManager& operator=(PSOManager&&) = delete;
 
-	std::size_t CreateGraphicsPSO(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& psoDesc, ID3D12PipelineState* &pso) noexcept;
+	// rootSignHash must be a hash of the serialized root signature of psoDesc.
+	std::size_t CreateGraphicsPSO(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& psoDesc, const std::uint64_t rootSignHash, ID3D12PipelineState* &pso) noexcept;
 
 	// Asserts if there is not a valid ID3D12PipelineState with current id
 	ID3D12PipelineState& GetPSO(const std::size_t id) noexcept;
@@ -26,15 +40,33 @@ public:
 	void Erase(const std::size_t id) noexcept;
 
 	// This will invalidate all ids.
-	__forceinline void Clear() noexcept { mPSOById.clear(); }
+	void Clear() noexcept;
+
+	// Serializes the pipeline library to disk, if pipeline states were compiled since last call.
+	void StorePipelineLibrary() noexcept;
+
+	__forceinline const PSOCacheIndex& CacheIndex() const noexcept { return mCacheIndex; }
 
 private:
 	explicit PSOManager(ID3D12Device& device);
 
+	void LoadPipelineLibrary() noexcept;
+
 	ID3D12Device& mDevice;
 
 	using PSOById = tbb::concurrent_hash_map<std::size_t, Microsoft::WRL::ComPtr<ID3D12PipelineState>>;
 	PSOById mPSOById;
 
+	// Pipeline states by cache index entry. It is nullptr while the entry is being created.
+	PSOCacheIndex mCacheIndex;
+	std::vector<Microsoft::WRL::ComPtr<ID3D12PipelineState>> mCachedPSOs;
+
+	// Library is nullptr if the device does not support it.
+	// It references the serialized data, so it must be kept while the library is alive.
+	Microsoft::WRL::ComPtr<ID3D12Device1> mDevice1;
+	Microsoft::WRL::ComPtr<ID3D12PipelineLibrary> mLibrary;
+	std::vector<std::uint8_t> mLibraryFileData;
+
 	std::mutex mMutex;
+	std::condition_variable mPSOCreated;
 };
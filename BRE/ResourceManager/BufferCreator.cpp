@@ -12,7 +12,7 @@ namespace {
 		ASSERT(bufferParams.ValidateData());
 
 		// Create buffer
-		const std::uint32_t byteSize{ bufferParams.mElemCount * static_cast<std::uint32_t>(bufferParams.mElemSize) };
+		const std::uint32_t byteSize{ bufferParams.ByteSize() };
 		ResourceManager::Get().CreateDefaultBuffer(cmdList, bufferParams.mData, byteSize, bufferData.mBuffer, uploadBuffer);
 		bufferData.mCount = bufferParams.mElemCount;
 
@@ -33,7 +33,7 @@ namespace {
 
 		// Create buffer
 		const std::uint32_t elemSize{ static_cast<std::uint32_t>(bufferParams.mElemSize) };
-		const std::uint32_t byteSize{ bufferParams.mElemCount * elemSize };
+		const std::uint32_t byteSize{ bufferParams.ByteSize() };
 		ResourceManager::Get().CreateDefaultBuffer(cmdList, bufferParams.mData, byteSize, bufferData.mBuffer, uploadBuffer);
 		bufferData.mCount = bufferParams.mElemCount;
 
@@ -65,17 +65,6 @@ namespace {
 }
 
 namespace BufferCreator {
-	BufferParams::BufferParams(const void* data, const std::uint32_t elemCount, const std::size_t elemSize)
-		: mData(data)
-		, mElemCount(elemCount)
-		, mElemSize(elemSize)
-	{
-	}
-
-	bool BufferParams::ValidateData() const noexcept {
-		return mData != nullptr && mElemCount != 0U && mElemSize != 0UL;
-	}
-
 	bool VertexBufferData::ValidateData() const noexcept {
 		D3D12_VERTEX_BUFFER_VIEW invalidView{};
 
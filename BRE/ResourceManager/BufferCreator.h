@@ -5,23 +5,9 @@
 #include <d3d12.h>
 #include <wrl.h>
 
-namespace  BufferCreator {
-	struct BufferParams {
-		BufferParams() = default;
-		explicit BufferParams(const void* data, const std::uint32_t elemCount, const std::size_t elemSize);
-		~BufferParams() = default;
-		BufferParams(const BufferParams&) = delete;
-		const BufferParams& operator=(const BufferParams&) = delete;
-		BufferParams(BufferParams&&) = delete;
-		BufferParams& operator=(BufferParams&&) = delete;
-
-		bool ValidateData() const noexcept;
-
-		const void* mData{ nullptr };
-		std::uint32_t mElemCount{ 0U };
-		std::size_t mElemSize{ 0UL };
-	};
+#include <ResourceManager/BufferParams.h>
 
+namespace  BufferCreator {
 	struct VertexBufferData {
 		VertexBufferData() = default;
 		~VertexBufferData() = default;
@@ -35,6 +21,7 @@ namespace  BufferCreator {
 			mBuffer = instance.mBuffer;
 			mBufferView = instance.mBufferView;
 			mCount = instance.mCount;
+			mBaseVertex = instance.mBaseVertex;
 
 			return *this;
 		}
@@ -47,6 +34,10 @@ namespace  BufferCreator {
 		ID3D12Resource* mBuffer{ nullptr };
 		D3D12_VERTEX_BUFFER_VIEW mBufferView{};
 		std::uint32_t mCount{ 0U };
+
+		// First vertex inside mBuffer. It is not zero when mBuffer
+		// is shared by several meshes (see GeometryPool)
+		std::uint32_t mBaseVertex{ 0U };
 	};
 	
 	void CreateBuffer(
@@ -68,6 +59,7 @@ namespace  BufferCreator {
 			mBuffer = instance.mBuffer;
 			mBufferView = instance.mBufferView;
 			mCount = instance.mCount;
+			mStartIndex = instance.mStartIndex;
 
 			return *this;
 		}
@@ -80,6 +72,10 @@ namespace  BufferCreator {
 		ID3D12Resource* mBuffer{ nullptr };
 		D3D12_INDEX_BUFFER_VIEW mBufferView{};
 		std::uint32_t mCount{ 0U };
+
+		// First index inside mBuffer. It is not zero when mBuffer
+		// is shared by several meshes (see GeometryPool)
+		std::uint32_t mStartIndex{ 0U };
 	};
 
 	void CreateBuffer(
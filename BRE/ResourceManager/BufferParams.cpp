@@ -0,0 +1,21 @@
+#include "BufferParams.h"
+
+#include <Utils/DebugUtils.h>
+
+namespace BufferCreator {
+	BufferParams::BufferParams(const void* data, const std::uint32_t elemCount, const std::size_t elemSize)
+		: mData(data)
+		, mElemCount(elemCount)
+		, mElemSize(elemSize)
+	{
+	}
+
+	bool BufferParams::ValidateData() const noexcept {
+		return mData != nullptr && mElemCount != 0U && mElemSize != 0UL;
+	}
+
+	std::uint32_t BufferParams::ByteSize() const noexcept {
+		ASSERT(ValidateData());
+		return mElemCount * static_cast<std::uint32_t>(mElemSize);
+	}
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace BufferCreator {
+	// Data of a vertex or index buffer to create (see BufferCreator).
+	// It does not depend on D3D, so it can be built on any platform.
+	struct BufferParams {
+		BufferParams() = default;
+		explicit BufferParams(const void* data, const std::uint32_t elemCount, const std::size_t elemSize);
+		~BufferParams() = default;
+		BufferParams(const BufferParams&) = delete;
+		const BufferParams& operator=(const BufferParams&) = delete;
+		BufferParams(BufferParams&&) = delete;
+		BufferParams& operator=(BufferParams&&) = delete;
+
+		bool ValidateData() const noexcept;
+
+		std::uint32_t ByteSize() const noexcept;
+
+		const void* mData{ nullptr };
+		std::uint32_t mElemCount{ 0U };
+		std::size_t mElemSize{ 0UL };
+	};
+}
@@ -0,0 +1,255 @@
+#include "CubeMapData.h"
+
+#include <cmath>
+#include <cstring>
+
+#include <Utils/DebugUtils.h>
+
+namespace {
+	// DDS file layout (magic, header, optional DX10 header, then faces, each one with its mip levels)
+	const std::uint32_t sMagic{ 0x20534444U }; // 'DDS '
+	const std::size_t sHeaderOffset{ 4UL };
+	const std::size_t sHeaderSize{ 124UL };
+	const std::size_t sDX10HeaderSize{ 20UL };
+
+	// Header fields offsets (relative to file begin)
+	const std::size_t sHeightOffset{ 12UL };
+	const std::size_t sWidthOffset{ 16UL };
+	const std::size_t sMipCountOffset{ 28UL };
+	const std::size_t sPixelFormatFlagsOffset{ 80UL };
+	const std::size_t sFourCCOffset{ 84UL };
+	const std::size_t sBitCountOffset{ 88UL };
+	const std::size_t sRedMaskOffset{ 92UL };
+	const std::size_t sBlueMaskOffset{ 100UL };
+	const std::size_t sCaps2Offset{ 112UL };
+	const std::size_t sDX10FormatOffset{ 128UL };
+	const std::size_t sDX10MiscFlagOffset{ 136UL };
+	const std::size_t sDX10ArraySizeOffset{ 140UL };
+
+	const std::uint32_t sPixelFormatFourCC{ 0x4U };
+	const std::uint32_t sPixelFormatRGB{ 0x40U };
+	const std::uint32_t sCaps2AllCubeMapFaces{ 0xFE00U }; // Cube map flag and its 6 faces flags
+	const std::uint32_t sDX10MiscTextureCube{ 0x4U };
+	const std::uint32_t sFourCCDX10{ 0x30315844U }; // 'DX10'
+
+	// Legacy D3DFORMAT four character codes of float formats
+	const std::uint32_t sFourCCRGBA16Float{ 113U };
+	const std::uint32_t sFourCCRGBA32Float{ 116U };
+
+	// DXGI_FORMAT values
+	const std::uint32_t sDXGIRGBA32Float{ 2U };
+	const std::uint32_t sDXGIRGBA16Float{ 10U };
+	const std::uint32_t sDXGIRGBA8Unorm{ 28U };
+	const std::uint32_t sDXGIRGBA8UnormSRGB{ 29U };
+	const std::uint32_t sDXGIBGRA8Unorm{ 87U };
+	const std::uint32_t sDXGIBGRA8UnormSRGB{ 91U };
+
+	enum Format {
+		UNSUPPORTED = 0U,
+		RGBA32_FLOAT,
+		RGBA16_FLOAT,
+		RGBA8_UNORM,
+		RGBA8_UNORM_SRGB,
+		BGRA8_UNORM,
+		BGRA8_UNORM_SRGB,
+	};
+
+	std::uint32_t ReadUInt32(const std::uint8_t* data, const std::size_t offset) noexcept {
+		std::uint32_t value;
+		memcpy(&value, data + offset, sizeof(value));
+		return value;
+	}
+
+	std::size_t BytesPerTexel(const Format format) noexcept {
+		switch (format) {
+		case RGBA32_FLOAT: return 16UL;
+		case RGBA16_FLOAT: return 8UL;
+		default: return 4UL;
+		}
+	}
+
+	Format LegacyFormat(const std::uint8_t* data) noexcept {
+		const std::uint32_t flags{ ReadUInt32(data, sPixelFormatFlagsOffset) };
+		if (flags & sPixelFormatFourCC) {
+			const std::uint32_t fourCC{ ReadUInt32(data, sFourCCOffset) };
+			if (fourCC == sFourCCRGBA32Float) {
+				return RGBA32_FLOAT;
+			}
+			if (fourCC == sFourCCRGBA16Float) {
+				return RGBA16_FLOAT;
+			}
+			return UNSUPPORTED;
+		}
+
+		if ((flags & sPixelFormatRGB) && ReadUInt32(data, sBitCountOffset) == 32U) {
+			const std::uint32_t redMask{ ReadUInt32(data, sRedMaskOffset) };
+			const std::uint32_t blueMask{ ReadUInt32(data, sBlueMaskOffset) };
+			if (redMask == 0x000000FFU && blueMask == 0x00FF0000U) {
+				return RGBA8_UNORM;
+			}
+			if (redMask == 0x00FF0000U && blueMask == 0x000000FFU) {
+				return BGRA8_UNORM;
+			}
+		}
+
+		return UNSUPPORTED;
+	}
+
+	Format DX10Format(const std::uint32_t dxgiFormat) noexcept {
+		switch (dxgiFormat) {
+		case sDXGIRGBA32Float: return RGBA32_FLOAT;
+		case sDXGIRGBA16Float: return RGBA16_FLOAT;
+		case sDXGIRGBA8Unorm: return RGBA8_UNORM;
+		case sDXGIRGBA8UnormSRGB: return RGBA8_UNORM_SRGB;
+		case sDXGIBGRA8Unorm: return BGRA8_UNORM;
+		case sDXGIBGRA8UnormSRGB: return BGRA8_UNORM_SRGB;
+		default: return UNSUPPORTED;
+		}
+	}
+
+	float HalfToFloat(const std::uint16_t half) noexcept {
+		const std::uint32_t sign{ static_cast<std::uint32_t>(half & 0x8000U) << 16U };
+		std::uint32_t exponent{ (half >> 10U) & 0x1FU };
+		std::uint32_t mantissa{ half & 0x3FFU };
+
+		std::uint32_t bits;
+		if (exponent == 0x1FU) {
+			// Infinity or NaN
+			bits = sign | 0x7F800000U | (mantissa << 13U);
+		}
+		else if (exponent != 0U) {
+			bits = sign | ((exponent + 112U) << 23U) | (mantissa << 13U);
+		}
+		else if (mantissa != 0U) {
+			// Denormal, normalize it
+			exponent = 113U;
+			while ((mantissa & 0x400U) == 0U) {
+				mantissa <<= 1U;
+				--exponent;
+			}
+			bits = sign | (exponent << 23U) | ((mantissa & 0x3FFU) << 13U);
+		}
+		else {
+			bits = sign;
+		}
+
+		float value;
+		memcpy(&value, &bits, sizeof(value));
+		return value;
+	}
+
+	void DecodeTexels(
+		const std::uint8_t* src,
+		const std::size_t texelCount,
+		const Format format,
+		const float (&unormToFloat)[256U],
+		float* dst) noexcept
+	{
+		switch (format) {
+		case RGBA32_FLOAT:
+			memcpy(dst, src, texelCount * 16UL);
+			break;
+		case RGBA16_FLOAT:
+			for (std::size_t i = 0UL; i < texelCount * 4UL; ++i) {
+				std::uint16_t half;
+				memcpy(&half, src + i * 2UL, sizeof(half));
+				dst[i] = HalfToFloat(half);
+			}
+			break;
+		default:
+			{
+				// Alpha is always linear
+				const bool isBGRA{ format == BGRA8_UNORM || format == BGRA8_UNORM_SRGB };
+				for (std::size_t i = 0UL; i < texelCount; ++i, src += 4UL, dst += 4U) {
+					dst[0U] = unormToFloat[src[isBGRA ? 2U : 0U]];
+					dst[1U] = unormToFloat[src[1U]];
+					dst[2U] = unormToFloat[src[isBGRA ? 0U : 2U]];
+					dst[3U] = static_cast<float>(src[3U]) / 255.0f;
+				}
+			}
+			break;
+		}
+	}
+}
+
+bool CubeMapData::LoadDDS(const std::uint8_t* data, const std::size_t size) noexcept {
+	ASSERT(data != nullptr || size == 0UL);
+
+	Clear();
+
+	if (size < sHeaderOffset + sHeaderSize ||
+		ReadUInt32(data, 0UL) != sMagic ||
+		ReadUInt32(data, sHeaderOffset) != sHeaderSize) {
+		return false;
+	}
+
+	const std::uint32_t width{ ReadUInt32(data, sWidthOffset) };
+	const std::uint32_t height{ ReadUInt32(data, sHeightOffset) };
+	const std::uint32_t mipCount{ ReadUInt32(data, sMipCountOffset) == 0U ? 1U : ReadUInt32(data, sMipCountOffset) };
+	if (width == 0U || width != height) {
+		return false;
+	}
+
+	Format format{ UNSUPPORTED };
+	std::size_t texelsOffset{ sHeaderOffset + sHeaderSize };
+	if ((ReadUInt32(data, sPixelFormatFlagsOffset) & sPixelFormatFourCC) && ReadUInt32(data, sFourCCOffset) == sFourCCDX10) {
+		if (size < texelsOffset + sDX10HeaderSize ||
+			(ReadUInt32(data, sDX10MiscFlagOffset) & sDX10MiscTextureCube) == 0U ||
+			ReadUInt32(data, sDX10ArraySizeOffset) != 1U) {
+			return false;
+		}
+
+		format = DX10Format(ReadUInt32(data, sDX10FormatOffset));
+		texelsOffset += sDX10HeaderSize;
+	}
+	else {
+		if ((ReadUInt32(data, sCaps2Offset) & sCaps2AllCubeMapFaces) != sCaps2AllCubeMapFaces) {
+			return false;
+		}
+
+		format = LegacyFormat(data);
+	}
+
+	if (format == UNSUPPORTED) {
+		return false;
+	}
+
+	// Each face has all its mip levels, we only decode the first one
+	const std::size_t bytesPerTexel{ BytesPerTexel(format) };
+	std::size_t faceStride{ 0UL };
+	for (std::uint32_t i = 0U; i < mipCount; ++i) {
+		const std::size_t mipSize{ width >> i > 0U ? width >> i : 1U };
+		faceStride += mipSize * mipSize * bytesPerTexel;
+	}
+
+	if (size < texelsOffset + faceStride * sFaceCount) {
+		return false;
+	}
+
+	float unormToFloat[256U];
+	const bool isSRGB{ format == RGBA8_UNORM_SRGB || format == BGRA8_UNORM_SRGB };
+	for (std::uint32_t i = 0U; i < 256U; ++i) {
+		const float value{ static_cast<float>(i) / 255.0f };
+		unormToFloat[i] = isSRGB ? (value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f)) : value;
+	}
+
+	const std::size_t faceTexelCount{ static_cast<std::size_t>(width) * width };
+	mTexels.resize(faceTexelCount * 4UL * sFaceCount);
+	for (std::uint32_t i = 0U; i < sFaceCount; ++i) {
+		DecodeTexels(data + texelsOffset + faceStride * i, faceTexelCount, format, unormToFloat, mTexels.data() + faceTexelCount * 4UL * i);
+	}
+	mFaceSize = width;
+
+	return true;
+}
+
+void CubeMapData::Clear() noexcept {
+	mTexels.clear();
+	mFaceSize = 0U;
+}
+
+const float* CubeMapData::FaceTexels(const std::uint32_t face) const noexcept {
+	ASSERT(face < sFaceCount);
+	ASSERT(IsEmpty() == false);
+	return mTexels.data() + static_cast<std::size_t>(mFaceSize) * mFaceSize * 4UL * face;
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <Utils/ForceInline.h>
+
+// Top mip level of the 6 faces of a DDS cube map, decoded to RGBA floats on the CPU
+// (for example, to project it to spherical harmonics). It does not create GPU resources.
+// Supported formats (legacy or DX10 headers): RGBA 32 bits float, RGBA 16 bits float,
+// RGBA 8 bits unorm (sRGB is converted to linear) and BGRA 8 bits unorm.
+// Block compressed formats are not supported.
+// It does not depend on D3D, so it can be built on any platform.
+class CubeMapData {
+public:
+	static const std::uint32_t sFaceCount{ 6U };
+
+	CubeMapData() = default;
+	~CubeMapData() = default;
+	CubeMapData(const CubeMapData&) = delete;
+	const CubeMapData& operator=(const CubeMapData&) = delete;
+	CubeMapData(CubeMapData&&) = default;
+	CubeMapData& operator=(CubeMapData&&) = default;
+
+	// data is the content of a DDS file. Returns false (and data is cleared) if it
+	// is not a cube map of a supported format.
+	bool LoadDDS(const std::uint8_t* data, const std::size_t size) noexcept;
+
+	void Clear() noexcept;
+
+	__forceinline bool IsEmpty() const noexcept { return mTexels.empty(); }
+	__forceinline std::uint32_t FaceSize() const noexcept { return mFaceSize; }
+
+	// FaceSize() x FaceSize() RGBA floats, row major. Faces are in D3D order (+X, -X, +Y, -Y, +Z, -Z).
+	const float* FaceTexels(const std::uint32_t face) const noexcept;
+
+private:
+	std::vector<float> mTexels;
+	std::uint32_t mFaceSize{ 0U };
+};
@@ -0,0 +1,127 @@
+//--------------------------------------------------------------------------------------
+// File: DDSFormat.h
+//
+// DDS file structures and DXGI format helpers used by DDSTextureLoader.
+// They only depend on dxgiformat.h (not on D3D), so they can be built on any platform.
+//
+// THIS CODE AND INFORMATION IS PROVIDED "AS IS" WITHOUT WARRANTY OF
+// ANY KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+// PARTICULAR PURPOSE.
+//
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// http://go.microsoft.com/fwlink/?LinkId=248926
+// http://go.microsoft.com/fwlink/?LinkId=248929
+//--------------------------------------------------------------------------------------
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <dxgiformat.h>
+
+//--------------------------------------------------------------------------------------
+// Macros
+//--------------------------------------------------------------------------------------
+#ifndef MAKEFOURCC
+    #define MAKEFOURCC(ch0, ch1, ch2, ch3)                              \
+                ((std::uint32_t)(uint8_t)(ch0) | ((std::uint32_t)(uint8_t)(ch1) << 8) |       \
+                ((std::uint32_t)(uint8_t)(ch2) << 16) | ((std::uint32_t)(uint8_t)(ch3) << 24 ))
+#endif /* defined(MAKEFOURCC) */
+
+//--------------------------------------------------------------------------------------
+// DDS file structure definitions
+//
+// See DDS.h in the 'Texconv' sample and the 'DirectXTex' library
+//--------------------------------------------------------------------------------------
+#pragma pack(push,1)
+
+const std::uint32_t DDS_MAGIC = 0x20534444; // "DDS "
+
+struct DDS_PIXELFORMAT
+{
+    std::uint32_t    size;
+    std::uint32_t    flags;
+    std::uint32_t    fourCC;
+    std::uint32_t    RGBBitCount;
+    std::uint32_t    RBitMask;
+    std::uint32_t    GBitMask;
+    std::uint32_t    BBitMask;
+    std::uint32_t    ABitMask;
+};
+
+#define DDS_FOURCC      0x00000004  // DDPF_FOURCC
+#define DDS_RGB         0x00000040  // DDPF_RGB
+#define DDS_LUMINANCE   0x00020000  // DDPF_LUMINANCE
+#define DDS_ALPHA       0x00000002  // DDPF_ALPHA
+
+#define DDS_HEADER_FLAGS_VOLUME         0x00800000  // DDSD_DEPTH
+
+#define DDS_HEIGHT 0x00000002 // DDSD_HEIGHT
+#define DDS_WIDTH  0x00000004 // DDSD_WIDTH
+
+#define DDS_CUBEMAP_POSITIVEX 0x00000600 // DDSCAPS2_CUBEMAP | DDSCAPS2_CUBEMAP_POSITIVEX
+#define DDS_CUBEMAP_NEGATIVEX 0x00000a00 // DDSCAPS2_CUBEMAP | DDSCAPS2_CUBEMAP_NEGATIVEX
+#define DDS_CUBEMAP_POSITIVEY 0x00001200 // DDSCAPS2_CUBEMAP | DDSCAPS2_CUBEMAP_POSITIVEY
+#define DDS_CUBEMAP_NEGATIVEY 0x00002200 // DDSCAPS2_CUBEMAP | DDSCAPS2_CUBEMAP_NEGATIVEY
+#define DDS_CUBEMAP_POSITIVEZ 0x00004200 // DDSCAPS2_CUBEMAP | DDSCAPS2_CUBEMAP_POSITIVEZ
+#define DDS_CUBEMAP_NEGATIVEZ 0x00008200 // DDSCAPS2_CUBEMAP | DDSCAPS2_CUBEMAP_NEGATIVEZ
+
+#define DDS_CUBEMAP_ALLFACES ( DDS_CUBEMAP_POSITIVEX | DDS_CUBEMAP_NEGATIVEX |\
+                               DDS_CUBEMAP_POSITIVEY | DDS_CUBEMAP_NEGATIVEY |\
+                               DDS_CUBEMAP_POSITIVEZ | DDS_CUBEMAP_NEGATIVEZ )
+
+#define DDS_CUBEMAP 0x00000200 // DDSCAPS2_CUBEMAP
+
+enum class DDS_MISC_FLAGS2 : std::uint32_t
+{
+    DDS_MISC_FLAGS2_ALPHA_MODE_MASK = 0x7L,
+};
+
+struct DDS_HEADER
+{
+    std::uint32_t        size;
+    std::uint32_t        flags;
+    std::uint32_t        height;
+    std::uint32_t        width;
+    std::uint32_t        pitchOrLinearSize;
+    std::uint32_t        depth; // only if DDS_HEADER_FLAGS_VOLUME is set in flags
+    std::uint32_t        mipMapCount;
+    std::uint32_t        reserved1[11];
+    DDS_PIXELFORMAT ddspf;
+    std::uint32_t        caps;
+    std::uint32_t        caps2;
+    std::uint32_t        caps3;
+    std::uint32_t        caps4;
+    std::uint32_t        reserved2;
+};
+
+struct DDS_HEADER_DXT10
+{
+    DXGI_FORMAT     dxgiFormat;
+    std::uint32_t        resourceDimension;
+    std::uint32_t        miscFlag; // see D3D11_RESOURCE_MISC_FLAG
+    std::uint32_t        arraySize;
+    std::uint32_t        miscFlags2;
+};
+
+#pragma pack(pop)
+
+namespace DirectX
+{
+    // Return the BPP for a particular format
+    std::size_t BitsPerPixel( DXGI_FORMAT fmt ) noexcept;
+
+    // Get surface information for a particular format. Output pointers can be nullptr.
+    void GetSurfaceInfo( std::size_t width,
+                         std::size_t height,
+                         DXGI_FORMAT fmt,
+                         std::size_t* outNumBytes,
+                         std::size_t* outRowBytes,
+                         std::size_t* outNumRows ) noexcept;
+
+    // Return the DXGI format of a legacy pixel format (without "DX10" extended header),
+    // or DXGI_FORMAT_UNKNOWN if it is not supported
+    DXGI_FORMAT GetDXGIFormat( const DDS_PIXELFORMAT& ddpf ) noexcept;
+}
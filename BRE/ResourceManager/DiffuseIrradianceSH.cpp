@@ -0,0 +1,167 @@
+#include "DiffuseIrradianceSH.h"
+
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <tbb/parallel_for.h>
+#include <vector>
+
+#include <GlobalData/Settings.h>
+#include <ResourceManager/CubeMapData.h>
+#include <Utils/DebugUtils.h>
+#include <Utils/HashUtils.h>
+
+namespace {
+	const char* sCacheFilename{ "IrradianceSHCache.bin" };
+
+	// Irradiance / PI used if the sky box cannot be projected
+	const float sFallbackIrradiance[3U]{ 0.2f, 0.2f, 0.2f };
+
+	// Cache file is a FileHeader followed by mEntryCount entries.
+	// Version must be incremented if projection results change.
+	struct FileHeader {
+		static const std::uint32_t sMagic{ 0x48534952 }; // "RISH"
+		static const std::uint32_t sVersion{ 1U };
+
+		std::uint32_t mMagic{ sMagic };
+		std::uint32_t mVersion{ sVersion };
+		std::uint64_t mEntryCount{ 0UL };
+	};
+
+	// mHash is the hash of the DDS file content
+	struct Entry {
+		std::uint64_t mHash{ 0UL };
+		SphericalHarmonics::Coefficients mCoefficients;
+	};
+
+	std::mutex sCacheMutex;
+
+	bool ReadFile(const char* filePath, std::vector<std::uint8_t>& data) noexcept {
+		ASSERT(filePath != nullptr);
+
+		std::ifstream fin{ filePath, std::ios::binary };
+		if (!fin) {
+			return false;
+		}
+
+		fin.seekg(0, std::ios_base::end);
+		const std::size_t fileSize{ static_cast<std::size_t>(fin.tellg()) };
+		fin.seekg(0, std::ios_base::beg);
+		data.resize(fileSize);
+		fin.read(reinterpret_cast<char*>(data.data()), fileSize);
+
+		return static_cast<bool>(fin);
+	}
+
+	// A missing or invalid cache is the same as an empty cache
+	void ReadCache(std::vector<Entry>& entries) noexcept {
+		entries.clear();
+
+		std::vector<std::uint8_t> data;
+		if (ReadFile(sCacheFilename, data) == false || data.size() < sizeof(FileHeader)) {
+			return;
+		}
+
+		FileHeader header;
+		memcpy(&header, data.data(), sizeof(header));
+		if (header.mMagic != FileHeader::sMagic ||
+			header.mVersion != FileHeader::sVersion ||
+			header.mEntryCount != (data.size() - sizeof(FileHeader)) / sizeof(Entry) ||
+			(data.size() - sizeof(FileHeader)) % sizeof(Entry) != 0UL) {
+			return;
+		}
+
+		entries.resize(static_cast<std::size_t>(header.mEntryCount));
+		memcpy(entries.data(), data.data() + sizeof(FileHeader), entries.size() * sizeof(Entry));
+	}
+
+	// Failing to write the cache is not an error, next run will project the cube map again.
+	void WriteCache(const std::vector<Entry>& entries) noexcept {
+		FileHeader header;
+		header.mEntryCount = entries.size();
+
+		std::ofstream fout{ sCacheFilename, std::ios::binary | std::ios::trunc };
+		if (fout) {
+			fout.write(reinterpret_cast<const char*>(&header), sizeof(header));
+			fout.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(Entry));
+		}
+	}
+
+	void ProjectCubeMap(const CubeMapData& cubeMap, SphericalHarmonics::Coefficients& coefficients) noexcept {
+		ASSERT(cubeMap.IsEmpty() == false);
+
+		const std::uint32_t faceSize{ cubeMap.FaceSize() };
+		const std::size_t rowCount{ static_cast<std::size_t>(faceSize) * CubeMapData::sFaceCount };
+
+		// One result per row, so they can be added in the same order every time.
+		std::vector<SphericalHarmonics::Coefficients> rowCoefficients(rowCount);
+		tbb::parallel_for(tbb::blocked_range<std::size_t>(0UL, rowCount, 8UL),
+			[&](const tbb::blocked_range<std::size_t>& r) {
+			for (std::size_t i = r.begin(); i != r.end(); ++i) {
+				const std::uint32_t face{ static_cast<std::uint32_t>(i / faceSize) };
+				const std::uint32_t row{ static_cast<std::uint32_t>(i % faceSize) };
+				SphericalHarmonics::ProjectCubeMapRows(cubeMap.FaceTexels(face), face, faceSize, row, row + 1U, rowCoefficients[i]);
+			}
+		});
+
+		coefficients = SphericalHarmonics::Coefficients{};
+		for (const SphericalHarmonics::Coefficients& row : rowCoefficients) {
+			coefficients += row;
+		}
+
+		SphericalHarmonics::ConvolveCosineLobe(coefficients);
+	}
+
+	bool LoadCoefficients(const char* filename, SphericalHarmonics::Coefficients& coefficients) noexcept {
+		ASSERT(filename != nullptr);
+
+		std::string filePath(Settings::sResourcesPath);
+		filePath += filename;
+
+		std::vector<std::uint8_t> fileData;
+		if (ReadFile(filePath.c_str(), fileData) == false) {
+			return false;
+		}
+
+		const std::uint64_t hash{ HashUtils::HashBytes(fileData.data(), fileData.size()) };
+
+		std::lock_guard<std::mutex> lock(sCacheMutex);
+		std::vector<Entry> entries;
+		ReadCache(entries);
+		for (const Entry& entry : entries) {
+			if (entry.mHash == hash) {
+				coefficients = entry.mCoefficients;
+				return true;
+			}
+		}
+
+		CubeMapData cubeMap;
+		if (cubeMap.LoadDDS(fileData.data(), fileData.size()) == false) {
+			return false;
+		}
+		fileData.clear();
+		fileData.shrink_to_fit();
+
+		Entry entry;
+		entry.mHash = hash;
+		ProjectCubeMap(cubeMap, entry.mCoefficients);
+		entries.push_back(entry);
+		WriteCache(entries);
+
+		coefficients = entry.mCoefficients;
+
+		return true;
+	}
+}
+
+namespace DiffuseIrradianceSH {
+	bool LoadFromCubeMapFile(const char* filename, SphericalHarmonics::Coefficients& coefficients) noexcept {
+		if (LoadCoefficients(filename, coefficients)) {
+			return true;
+		}
+
+		SphericalHarmonics::SetConstant(sFallbackIrradiance, coefficients);
+		return false;
+	}
+}
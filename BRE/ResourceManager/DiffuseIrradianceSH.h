@@ -0,0 +1,20 @@
+#pragma once
+
+#include <MathUtils/SphericalHarmonics.h>
+
+// Diffuse irradiance of a sky box, as order 3 spherical harmonics, computed on the CPU.
+// It replaces precomputed diffuse irradiance cube maps (a constant buffer of 9 float4
+// instead of a cube map to load and sample).
+// Steps:
+// - Hash the DDS file content, and look the hash up in the disk cache (IrradianceSHCache.bin in
+// the working directory).
+// - If it is not cached, decode the sky box cube map, project its rows in parallel, sum
+// rows in a fixed order (so the result does not depend on scheduling), convolve with the
+// clamped cosine lobe, and store it in the cache.
+namespace DiffuseIrradianceSH {
+	// filename is relative to Settings::sResourcesPath (as in ResourceManager::LoadTextureFromFile()).
+	// Sky boxes must be uncompressed cube maps (a CubeMapData format). Block compressed ones are not decoded.
+	// Returns false if the file cannot be read or it is not a supported cube map. Then coefficients are
+	// a constant ambient irradiance, so scenes are not left without ambient light.
+	bool LoadFromCubeMapFile(const char* filename, SphericalHarmonics::Coefficients& coefficients) noexcept;
+}
@@ -0,0 +1,188 @@
+#include "GeometryPool.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <DXUtils/d3dx12.h>
+#include <ResourceManager/ResourceManager.h>
+#include <Utils/DebugUtils.h>
+
+namespace {
+	std::unique_ptr<GeometryPool> gPool{ nullptr };
+
+	DXGI_FORMAT IndexFormat(const std::uint32_t elemSize) noexcept {
+		switch (elemSize)
+		{
+		case 2U:
+			return DXGI_FORMAT_R16_UINT;
+		case 4U:
+			return DXGI_FORMAT_R32_UINT;
+		default:
+			ASSERT(false);
+			return DXGI_FORMAT_UNKNOWN;
+		}
+	}
+}
+
+GeometryPool& GeometryPool::Create(ID3D12Device& device) noexcept {
+	ASSERT(gPool == nullptr);
+	gPool.reset(new GeometryPool(device));
+	return *gPool.get();
+}
+
+GeometryPool& GeometryPool::Get() noexcept {
+	ASSERT(gPool != nullptr);
+	return *gPool.get();
+}
+
+GeometryPool::GeometryPool(ID3D12Device& device)
+	: mDevice(device)
+{
+}
+
+GeometryPool::Arena::Arena(ID3D12Resource& buffer, const std::uint32_t elemSize, const std::uint32_t elemCount) noexcept
+	: mBuffer(buffer)
+	, mElemSize(elemSize)
+	, mAllocator(elemCount)
+{
+}
+
+void GeometryPool::CreateVertexBuffer(
+	ID3D12GraphicsCommandList& cmdList,
+	const BufferCreator::BufferParams& bufferParams,
+	BufferCreator::VertexBufferData& bufferData,
+	Microsoft::WRL::ComPtr<ID3D12Resource>& uploadBuffer) noexcept {
+	ASSERT(bufferParams.ValidateData());
+
+	const std::uint32_t elemSize{ static_cast<std::uint32_t>(bufferParams.mElemSize) };
+	std::uint32_t elemOffset;
+	Arena& arena = Allocate(elemSize, bufferParams.mElemCount, elemOffset);
+	RecordCopy(cmdList, bufferParams, arena.mBuffer, elemOffset * elemSize, uploadBuffer);
+
+	// The view covers the whole arena, so all its meshes can be drawn
+	// with a single binding.
+	bufferData.mBuffer = &arena.mBuffer;
+	bufferData.mCount = bufferParams.mElemCount;
+	bufferData.mBaseVertex = elemOffset;
+	bufferData.mBufferView.BufferLocation = arena.mBuffer.GetGPUVirtualAddress();
+	bufferData.mBufferView.SizeInBytes = arena.mAllocator.Capacity() * elemSize;
+	bufferData.mBufferView.StrideInBytes = elemSize;
+
+	ASSERT(bufferData.ValidateData());
+}
+
+void GeometryPool::CreateIndexBuffer(
+	ID3D12GraphicsCommandList& cmdList,
+	const BufferCreator::BufferParams& bufferParams,
+	BufferCreator::IndexBufferData& bufferData,
+	Microsoft::WRL::ComPtr<ID3D12Resource>& uploadBuffer) noexcept {
+	ASSERT(bufferParams.ValidateData());
+
+	const std::uint32_t elemSize{ static_cast<std::uint32_t>(bufferParams.mElemSize) };
+	std::uint32_t elemOffset;
+	Arena& arena = Allocate(elemSize, bufferParams.mElemCount, elemOffset);
+	RecordCopy(cmdList, bufferParams, arena.mBuffer, elemOffset * elemSize, uploadBuffer);
+
+	bufferData.mBuffer = &arena.mBuffer;
+	bufferData.mCount = bufferParams.mElemCount;
+	bufferData.mStartIndex = elemOffset;
+	bufferData.mBufferView.BufferLocation = arena.mBuffer.GetGPUVirtualAddress();
+	bufferData.mBufferView.Format = IndexFormat(elemSize);
+	bufferData.mBufferView.SizeInBytes = arena.mAllocator.Capacity() * elemSize;
+
+	ASSERT(bufferData.ValidateData());
+}
+
+void GeometryPool::Free(const BufferCreator::VertexBufferData& bufferData) noexcept {
+	ASSERT(bufferData.ValidateData());
+	Free(*bufferData.mBuffer, bufferData.mBaseVertex);
+}
+
+void GeometryPool::Free(const BufferCreator::IndexBufferData& bufferData) noexcept {
+	ASSERT(bufferData.ValidateData());
+	Free(*bufferData.mBuffer, bufferData.mStartIndex);
+}
+
+GeometryPool::Arena& GeometryPool::Allocate(const std::uint32_t elemSize, const std::uint32_t elemCount, std::uint32_t& elemOffset) noexcept {
+	ASSERT(elemSize > 0U);
+	ASSERT(elemCount > 0U);
+
+	mMutex.lock();
+
+	// First arena of the same element size with enough room
+	for (std::unique_ptr<Arena>& arena : mArenas) {
+		if (arena->mElemSize != elemSize) {
+			continue;
+		}
+
+		elemOffset = arena->mAllocator.Allocate(elemCount);
+		if (elemOffset != RangeAllocator::sInvalidOffset) {
+			Arena& result = *arena.get();
+			mMutex.unlock();
+			return result;
+		}
+	}
+
+	// Create a new arena. Buffers stay in GENERIC_READ state, except while
+	// a copy to them is being recorded.
+	const std::uint32_t arenaElemCount{ std::max(sArenaByteSize / elemSize, elemCount) };
+	const CD3DX12_HEAP_PROPERTIES heapProps{ D3D12_HEAP_TYPE_DEFAULT };
+	const CD3DX12_RESOURCE_DESC resDesc{ CD3DX12_RESOURCE_DESC::Buffer(static_cast<std::uint64_t>(arenaElemCount) * elemSize) };
+	ID3D12Resource* buffer{ nullptr };
+	ResourceManager::Get().CreateCommittedResource(heapProps, D3D12_HEAP_FLAG_NONE, resDesc, D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, buffer);
+	ASSERT(buffer != nullptr);
+
+	mArenas.push_back(std::make_unique<Arena>(*buffer, elemSize, arenaElemCount));
+	Arena& result = *mArenas.back().get();
+	elemOffset = result.mAllocator.Allocate(elemCount);
+	ASSERT(elemOffset != RangeAllocator::sInvalidOffset);
+
+	mMutex.unlock();
+
+	return result;
+}
+
+void GeometryPool::RecordCopy(
+	ID3D12GraphicsCommandList& cmdList,
+	const BufferCreator::BufferParams& bufferParams,
+	ID3D12Resource& destBuffer,
+	const std::uint32_t destByteOffset,
+	Microsoft::WRL::ComPtr<ID3D12Resource>& uploadBuffer) noexcept {
+	const std::size_t byteSize{ bufferParams.mElemCount * bufferParams.mElemSize };
+
+	// Intermediate upload buffer, only for this mesh data
+	const CD3DX12_HEAP_PROPERTIES heapProps{ D3D12_HEAP_TYPE_UPLOAD };
+	const CD3DX12_RESOURCE_DESC resDesc{ CD3DX12_RESOURCE_DESC::Buffer(byteSize) };
+	mMutex.lock();
+	CHECK_HR(mDevice.CreateCommittedResource(
+		&heapProps,
+		D3D12_HEAP_FLAG_NONE,
+		&resDesc,
+		D3D12_RESOURCE_STATE_GENERIC_READ,
+		nullptr,
+		IID_PPV_ARGS(uploadBuffer.ReleaseAndGetAddressOf())));
+	mMutex.unlock();
+
+	void* mappedData{ nullptr };
+	const D3D12_RANGE readRange{ 0UL, 0UL };
+	CHECK_HR(uploadBuffer->Map(0U, &readRange, &mappedData));
+	memcpy(mappedData, bufferParams.mData, byteSize);
+	uploadBuffer->Unmap(0U, nullptr);
+
+	CD3DX12_RESOURCE_BARRIER resBarrier{ CD3DX12_RESOURCE_BARRIER::Transition(&destBuffer, D3D12_RESOURCE_STATE_GENERIC_READ, D3D12_RESOURCE_STATE_COPY_DEST) };
+	cmdList.ResourceBarrier(1U, &resBarrier);
+	cmdList.CopyBufferRegion(&destBuffer, destByteOffset, uploadBuffer.Get(), 0UL, byteSize);
+	resBarrier = CD3DX12_RESOURCE_BARRIER::Transition(&destBuffer, D3D12_RESOURCE_STATE_COPY_DEST, D3D12_RESOURCE_STATE_GENERIC_READ);
+	cmdList.ResourceBarrier(1U, &resBarrier);
+}
+
+void GeometryPool::Free(ID3D12Resource& buffer, const std::uint32_t elemOffset) noexcept {
+	mMutex.lock();
+	for (std::unique_ptr<Arena>& arena : mArenas) {
+		if (&arena->mBuffer == &buffer) {
+			arena->mAllocator.Free(elemOffset);
+			break;
+		}
+	}
+	mMutex.unlock();
+}
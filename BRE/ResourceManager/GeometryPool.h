@@ -0,0 +1,91 @@
+#pragma once
+
+#include <d3d12.h>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <wrl.h>
+
+#include <ResourceManager/BufferCreator.h>
+#include <Utils/RangeAllocator.h>
+
+// This class is responsible to sub-allocate static vertex and index data
+// into a few big buffers (arenas), instead of a committed resource per mesh.
+// Buffer views returned cover the whole arena, and each mesh is referenced by
+// mBaseVertex / mStartIndex, so command list recorders can bind the arena once
+// and draw all its meshes (and in the future, merge them or draw them indirectly).
+// Steps:
+// - Call CreateVertexBuffer() / CreateIndexBuffer() to sub-allocate and record the copy.
+// - Use returned buffer data to bind (once per arena) and draw with its offsets.
+// - Call Free() when the mesh data is not used anymore by the GPU.
+class GeometryPool {
+public:
+	// Arena size. Meshes bigger than this get an arena of their own size.
+	static const std::uint32_t sArenaByteSize{ 32U * 1024U * 1024U };
+
+	static GeometryPool& Create(ID3D12Device& device) noexcept;
+	static GeometryPool& Get() noexcept;
+
+	~GeometryPool() = default;
+	GeometryPool(const GeometryPool&) = delete;
+	const GeometryPool& operator=(const GeometryPool&) = delete;
+	GeometryPool(GeometryPool&&) = delete;
+	GeometryPool& operator=(GeometryPool&&) = delete;
+
+	// Command lists are used to record the copy from the upload buffer to the arena.
+	// cmdList must be in recorded state before calling these methods.
+	// uploadBuffer has to be kept alive until cmdList is executed.
+	void CreateVertexBuffer(
+		ID3D12GraphicsCommandList& cmdList,
+		const BufferCreator::BufferParams& bufferParams,
+		BufferCreator::VertexBufferData& bufferData,
+		Microsoft::WRL::ComPtr<ID3D12Resource>& uploadBuffer) noexcept;
+
+	void CreateIndexBuffer(
+		ID3D12GraphicsCommandList& cmdList,
+		const BufferCreator::BufferParams& bufferParams,
+		BufferCreator::IndexBufferData& bufferData,
+		Microsoft::WRL::ComPtr<ID3D12Resource>& uploadBuffer) noexcept;
+
+	// Returns ranges to their arenas.
+	void Free(const BufferCreator::VertexBufferData& bufferData) noexcept;
+	void Free(const BufferCreator::IndexBufferData& bufferData) noexcept;
+
+	__forceinline std::size_t ArenaCount() const noexcept { return mArenas.size(); }
+
+private:
+	explicit GeometryPool(ID3D12Device& device);
+
+	// Buffer sub-allocated in elements of mElemSize bytes.
+	struct Arena {
+		explicit Arena(ID3D12Resource& buffer, const std::uint32_t elemSize, const std::uint32_t elemCount) noexcept;
+		~Arena() = default;
+		Arena(const Arena&) = delete;
+		const Arena& operator=(const Arena&) = delete;
+		Arena(Arena&&) = delete;
+		Arena& operator=(Arena&&) = delete;
+
+		ID3D12Resource& mBuffer;
+		std::uint32_t mElemSize{ 0U };
+		RangeAllocator mAllocator;
+	};
+
+	// Returns the arena where elemCount elements of elemSize bytes were allocated,
+	// and the first element offset.
+	Arena& Allocate(const std::uint32_t elemSize, const std::uint32_t elemCount, std::uint32_t& elemOffset) noexcept;
+
+	void RecordCopy(
+		ID3D12GraphicsCommandList& cmdList,
+		const BufferCreator::BufferParams& bufferParams,
+		ID3D12Resource& destBuffer,
+		const std::uint32_t destByteOffset,
+		Microsoft::WRL::ComPtr<ID3D12Resource>& uploadBuffer) noexcept;
+
+	void Free(ID3D12Resource& buffer, const std::uint32_t elemOffset) noexcept;
+
+	ID3D12Device& mDevice;
+
+	std::vector<std::unique_ptr<Arena>> mArenas;
+
+	std::mutex mMutex;
+};
@@ -61,6 +61,36 @@ std::size_t ResourceManager::LoadTextureFromFile(
 	return id;
 }
 
+std::size_t ResourceManager::LoadTextureFromMemory(
+	const std::uint8_t* data,
+	const std::size_t dataSize,
+	ID3D12Resource* &res,
+	Microsoft::WRL::ComPtr<ID3D12Resource>& uploadBuffer,
+	ID3D12GraphicsCommandList& cmdList) noexcept {
+	ASSERT(data != nullptr);
+	ASSERT(dataSize > 0UL);
+
+	Microsoft::WRL::ComPtr<ID3D12Resource> resource;
+
+	mMutex.lock();
+	CHECK_HR(DirectX::CreateDDSTextureFromMemory12(&mDevice, &cmdList, data, dataSize, resource, uploadBuffer));
+	mMutex.unlock();
+
+	const std::size_t id{ NumberGeneration::IncrementalSizeT() };
+	ResourceById::accessor accessor;
+#ifdef _DEBUG
+	mResourceById.find(accessor, id);
+	ASSERT(accessor.empty());
+#endif
+	mResourceById.insert(accessor, id);
+	accessor->second = resource;
+	accessor.release();
+
+	res = resource.Get();
+
+	return id;
+}
+
 std::size_t ResourceManager::CreateDefaultBuffer(
 	ID3D12GraphicsCommandList& cmdList,
 	const void* initData,
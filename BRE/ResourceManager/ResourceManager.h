@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <d3d12.h>
 #include <mutex>
 #include <tbb/concurrent_hash_map.h>
@@ -31,6 +32,14 @@ public:
 		Microsoft::WRL::ComPtr<ID3D12Resource>& uploadBuffer,
 		ID3D12GraphicsCommandList& cmdList) noexcept;
 
+	// Same, with the DDS file already read to memory (data can be freed after the call)
+	std::size_t LoadTextureFromMemory(
+		const std::uint8_t* data,
+		const std::size_t dataSize,
+		ID3D12Resource* &res,
+		Microsoft::WRL::ComPtr<ID3D12Resource>& uploadBuffer,
+		ID3D12GraphicsCommandList& cmdList) noexcept;
+
 	// Note: uploadBuffer has to be kept alive after the above function calls because
 	// the command list has not been executed yet that performs the actual copy.
 	// The caller can Release the uploadBuffer after it knows the copy has been executed.
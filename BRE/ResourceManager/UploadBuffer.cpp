@@ -2,6 +2,8 @@
 
 #include <DxUtils/d3dx12.h>
 #include <Utils/DebugUtils.h>
+#include <Utils/MemoryUtils.h>
+#include <Utils/RenderStats.h>
 
 UploadBuffer::UploadBuffer(ID3D12Device& device, const std::size_t elemSize, const std::uint32_t elemCount)
 	: mElemSize(elemSize)
@@ -24,20 +26,18 @@ UploadBuffer::~UploadBuffer() {
 
 void UploadBuffer::CopyData(const std::uint32_t elemIndex, const void* srcData, const std::size_t srcDataSize) const noexcept {
 	ASSERT(srcData);
+	RENDER_STATS_ADD(UPLOADED_BYTES, srcDataSize);
 	memcpy(mMappedData + elemIndex * mElemSize, srcData, srcDataSize);
 }
 
+void UploadBuffer::CopyDataStreaming(const std::uint32_t elemIndex, const void* srcData, const std::size_t srcDataSize) const noexcept {
+	ASSERT(srcData);
+	RENDER_STATS_ADD(UPLOADED_BYTES, srcDataSize);
+	MemoryUtils::StreamingCopy(mMappedData + elemIndex * mElemSize, srcData, srcDataSize);
+}
+
 std::size_t UploadBuffer::CalcConstantBufferByteSize(const std::size_t byteSize) {
 	// Constant buffers must be a multiple of the minimum hardware
-	// allocation size (usually 256 bytes).  So round up to nearest
-	// multiple of 256.  We do this by adding 255 and then masking off
-	// the lower 2 bytes which store all bits < 256.
-	// Example: Suppose byteSize = 300.
-	// (300 + 255) & ~255
-	// 555 & ~255
-	// 0x022B & ~0x00ff
-	// 0x022B & 0xff00
-	// 0x0200
-	// 512
-	return (byteSize + 255U) & ~255U;
+	// allocation size (256 bytes). So round up to nearest multiple of 256.
+	return MemoryUtils::AlignUp(byteSize, D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT);
 }
\ No newline at end of file
@@ -17,8 +17,13 @@ public:
 
 	__forceinline ID3D12Resource* Resource() const noexcept { return mBuffer.Get(); }
 
+	// Copied bytes are added to RenderStats uploaded bytes
 	void CopyData(const std::uint32_t elemIndex, const void* srcData, const std::size_t srcDataSize) const noexcept;
 
+	// Like CopyData(), but with non-temporal stores. Upload heaps are write combined memory,
+	// so it is faster for big copies.
+	void CopyDataStreaming(const std::uint32_t elemIndex, const void* srcData, const std::size_t srcDataSize) const noexcept;
+
 	static std::size_t CalcConstantBufferByteSize(const std::size_t byteSize);
 
 private:
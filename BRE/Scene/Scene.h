@@ -5,12 +5,18 @@
 
 #include <GeometryPass/GeometryPassCmdListRecorder.h>
 #include <LightingPass/LightingPassCmdListRecorder.h>
+#include <MathUtils/SphericalHarmonics.h>
+#include <MathUtils/TransformHierarchy.h>
 
 struct ID3D12CommandAllocator;
 struct ID3D12CommandQueue;
 struct ID3D12Fence;
 struct ID3D12GraphicsCommandList;
 
+namespace SceneUtils {
+	class ResourceContainer;
+}
+
 // You should inherit from this class and implement needed methods.
 // Its generated CmdListRecorder's are used by MasterRender to 
 // create/record command lists for rendering purposes.
@@ -28,6 +34,10 @@ public:
 	// User must not call it.
 	// It must be called before generating recorders
 	virtual void Init(ID3D12CommandQueue& cmdQueue) noexcept;
+
+	// Textures and models uploaded by Init(), or nullptr if the scene does not load files.
+	// MasterRender reads and imports their files in parallel tasks before calling Init().
+	virtual SceneUtils::ResourceContainer* Resources() noexcept { return nullptr; }
 	
 	virtual void GenerateGeomPassRecorders( 
 		std::vector<std::unique_ptr<GeometryPassCmdListRecorder>>& tasks) noexcept = 0;
@@ -38,11 +48,19 @@ public:
 		ID3D12Resource& depthBuffer,
 		std::vector<std::unique_ptr<LightingPassCmdListRecorder>>& tasks) noexcept = 0;
 
+	// diffuseIrradiance is usually computed from the sky box cube map (see DiffuseIrradianceSH).
+	// Then the sky box must be uncompressed, scenes assert it was projected (release builds
+	// fall back to a constant ambient).
 	virtual void GenerateCubeMaps(
 		ID3D12Resource* &skyBoxCubeMap,
-		ID3D12Resource* &diffuseIrradianceCubeMap,
+		SphericalHarmonics::Coefficients& diffuseIrradiance,
 		ID3D12Resource* &specularPreConvolvedCubeMap) noexcept = 0;
 
+	// Transforms of geometry pass recorders instances. Nodes must be added while
+	// recorders are generated. They can be modified later (between frames), and
+	// the geometry pass updates them each frame.
+	__forceinline TransformHierarchy& Transforms() noexcept { return mTransforms; }
+
 protected:
 	// Method used when the command list is ready to be closed
 	// and executed. It waits until GPU finishes command list execution.
@@ -54,4 +72,6 @@ protected:
 	ID3D12CommandAllocator* mCmdAlloc{ nullptr };
 	ID3D12GraphicsCommandList* mCmdList{ nullptr };
 	ID3D12Fence* mFence{ nullptr };
+
+	TransformHierarchy mTransforms;
 };
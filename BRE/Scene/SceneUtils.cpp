@@ -1,8 +1,10 @@
 #include "SceneUtils.h"
 
 #include <d3d12.h>
+#include <fstream>
 #include <wrl.h>
 
+#include <GlobalData/Settings.h>
 #include <ModelManager\ModelManager.h>
 #include <ResourceManager\ResourceManager.h>
 #include <Utils/DebugUtils.h>
@@ -38,74 +40,99 @@ namespace {
 }
 
 namespace SceneUtils {
-	void ResourceContainer::LoadTextures(
-		const std::vector<std::string>& texFiles,
-		ID3D12CommandQueue& cmdQueue,
-		ID3D12CommandAllocator& cmdAlloc,
-		ID3D12GraphicsCommandList& cmdList,
-		ID3D12Fence& fence) noexcept
+	ResourceContainer::ResourceContainer(const std::vector<std::string>& texFiles, const std::vector<std::string>& modelFiles)
+		: mTexFiles(texFiles)
+		, mModelFiles(modelFiles)
+		, mTextureFileData(texFiles.size())
+		, mModelMeshes(modelFiles.size())
 	{
-		ASSERT(mTextures.empty());
-
-		const std::size_t texCount = texFiles.size();
-		ASSERT(texCount > 0UL);
+	}
 
-		CHECK_HR(cmdList.Reset(&cmdAlloc, nullptr));
+	void ResourceContainer::ReadTexture(const std::size_t index) noexcept {
+		ASSERT(index < mTexFiles.size());
+		ASSERT(mTextureFileData[index].empty());
 
-		mTextures.resize(texCount);
+		std::string filePath(Settings::sResourcesPath);
+		filePath += mTexFiles[index];
 
-		std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>> uploadBuffers;
-		uploadBuffers.resize(texCount);
-		
-		for (std::size_t i = 0UL; i < texCount; ++i) {
-			ResourceManager::Get().LoadTextureFromFile(texFiles[i].c_str(), mTextures[i], uploadBuffers[i], cmdList);
-			ASSERT(mTextures[i] != nullptr);
-		}
+		std::ifstream fin{ filePath, std::ios::binary };
+		ASSERT(fin);
+		fin.seekg(0, std::ios_base::end);
+		const std::size_t fileSize{ static_cast<std::size_t>(fin.tellg()) };
+		fin.seekg(0, std::ios_base::beg);
 
-		ExecuteCommandList(cmdQueue, cmdList, fence);
+		std::vector<std::uint8_t>& data(mTextureFileData[index]);
+		data.resize(fileSize);
+		fin.read(reinterpret_cast<char*>(data.data()), fileSize);
+		ASSERT(fin && data.empty() == false);
 	}
 
-	ID3D12Resource& ResourceContainer::GetResource(const std::size_t index) noexcept {
-		ASSERT(index < mTextures.size());
-		ID3D12Resource* res = mTextures[index];
-		ASSERT(res != nullptr);
-		return *res;
+	void ResourceContainer::ImportModel(const std::size_t index) noexcept {
+		ASSERT(index < mModelFiles.size());
+		ASSERT(mModelMeshes[index].empty());
+
+		Model::ImportMeshes(mModelFiles[index].c_str(), mModelMeshes[index]);
+		ASSERT(mModelMeshes[index].empty() == false);
 	}
 
-	void ResourceContainer::LoadModels(
-		const std::vector<std::string>& modelFiles,
+	void ResourceContainer::Upload(
 		ID3D12CommandQueue& cmdQueue,
 		ID3D12CommandAllocator& cmdAlloc,
 		ID3D12GraphicsCommandList& cmdList,
 		ID3D12Fence& fence) noexcept
 	{
+		ASSERT(mTextures.empty());
 		ASSERT(mModels.empty());
 
-		const std::size_t modelCount = modelFiles.size();
-		ASSERT(modelCount > 0UL);
+		const std::size_t texCount{ mTexFiles.size() };
+		const std::size_t modelCount{ mModelFiles.size() };
+		ASSERT(texCount > 0UL || modelCount > 0UL);
 
 		CHECK_HR(cmdList.Reset(&cmdAlloc, nullptr));
 
-		mModels.resize(modelCount);
+		mTextures.resize(texCount);
+		std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>> uploadBuffers;
+		uploadBuffers.resize(texCount);
+		for (std::size_t i = 0UL; i < texCount; ++i) {
+			if (mTextureFileData[i].empty()) {
+				ReadTexture(i);
+			}
 
+			std::vector<std::uint8_t>& data(mTextureFileData[i]);
+			ResourceManager::Get().LoadTextureFromMemory(data.data(), data.size(), mTextures[i], uploadBuffers[i], cmdList);
+			ASSERT(mTextures[i] != nullptr);
+			std::vector<std::uint8_t>().swap(data);
+		}
+
+		mModels.resize(modelCount);
 		std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>> uploadVertexBuffers;
 		uploadVertexBuffers.resize(modelCount);
 		std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>> uploadIndexBuffers;
 		uploadIndexBuffers.resize(modelCount);
-
 		for (std::size_t i = 0UL; i < modelCount; ++i) {
-			ModelManager::Get().LoadModel(modelFiles[i].c_str(), mModels[i], cmdList, uploadVertexBuffers[i], uploadIndexBuffers[i]);
-			ASSERT(mTextures[i] != nullptr);
+			if (mModelMeshes[i].empty()) {
+				ImportModel(i);
+			}
+
+			ModelManager::Get().CreateModel(mModelMeshes[i], mModels[i], cmdList, uploadVertexBuffers[i], uploadIndexBuffers[i]);
+			ASSERT(mModels[i] != nullptr);
+			std::vector<GeometryGenerator::MeshData>().swap(mModelMeshes[i]);
 		}
 
 		ExecuteCommandList(cmdQueue, cmdList, fence);
 	}
 
+	ID3D12Resource& ResourceContainer::GetResource(const std::size_t index) noexcept {
+		ASSERT(index < mTextures.size());
+		ID3D12Resource* res = mTextures[index];
+		ASSERT(res != nullptr);
+		return *res;
+	}
+
 	Model& ResourceContainer::GetModel(const std::size_t index) noexcept {
 		ASSERT(index < mModels.size());
 		Model* model = mModels[index];
 		ASSERT(model != nullptr);
 		return *model;
 	}
-}
-
+}
\ No newline at end of file
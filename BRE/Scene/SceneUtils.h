@@ -1,8 +1,13 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
+#include <string>
 #include <vector>
 
+#include <GeometryGenerator/GeometryGenerator.h>
+#include <Utils/ForceInline.h>
+
 struct ID3D12CommandAllocator;
 struct ID3D12CommandQueue;
 struct ID3D12Fence;
@@ -12,21 +17,34 @@ class Model;
 
 namespace SceneUtils {
 
+	// Textures and models of a scene. Texture and model indices are their
+	// indices in texFiles and modelFiles.
+	// Loading is split in steps, so they can be run as tasks (see MasterRender):
+	// - Call ReadTexture() and ImportModel() for each file. They do not use the device,
+	// so they can be called in parallel (for different files).
+	// - Call Upload() once, after them. It reads and imports the files that were not,
+	// records all the copies in a single command list, executes it and waits for it.
 	class ResourceContainer {
 	public:
-		ResourceContainer() = default;
+		// Files must be valid while the container is used
+		explicit ResourceContainer(const std::vector<std::string>& texFiles, const std::vector<std::string>& modelFiles);
 		~ResourceContainer() = default;
 		ResourceContainer(const ResourceContainer&) = delete;
 		const ResourceContainer& operator=(const ResourceContainer&) = delete;
 		ResourceContainer(ResourceContainer&&) = delete;
 		ResourceContainer& operator=(ResourceContainer&&) = delete;
 
-		// Load all textures from texFiles. Texture index will be equal
-		// to its index in texFiles vector.
+		__forceinline std::size_t TextureFileCount() const noexcept { return mTexFiles.size(); }
+		__forceinline std::size_t ModelFileCount() const noexcept { return mModelFiles.size(); }
+
+		// Reads the DDS file of the texture to memory
+		void ReadTexture(const std::size_t index) noexcept;
+
+		// Imports the meshes of the model file (see Model::ImportMeshes())
+		void ImportModel(const std::size_t index) noexcept;
+
 		// Precondition: You must call this method at most once.
-		// Subsequent calls will fail.
-		void LoadTextures(
-			const std::vector<std::string>& texFiles,
+		void Upload(
 			ID3D12CommandQueue& cmdQueue,
 			ID3D12CommandAllocator& cmdAlloc,
 			ID3D12GraphicsCommandList& cmdList,
@@ -35,21 +53,17 @@ namespace SceneUtils {
 		ID3D12Resource& GetResource(const std::size_t index) noexcept;
 		std::vector<ID3D12Resource*>& GetResources() noexcept { return mTextures; }
 
-		// Load all models from modelFiles. Model index will be equal
-		// to its index in modelFiles vector.
-		// Precondition: You must call this method at most once.
-		// Subsequent calls will fail.
-		void LoadModels(
-			const std::vector<std::string>& modelFiles,
-			ID3D12CommandQueue& cmdQueue,
-			ID3D12CommandAllocator& cmdAlloc,
-			ID3D12GraphicsCommandList& cmdList,
-			ID3D12Fence& fence) noexcept;
-
 		Model& GetModel(const std::size_t index) noexcept;
 		std::vector<Model*>& GetModels() noexcept { return mModels; }
 
 	private:
+		const std::vector<std::string>& mTexFiles;
+		const std::vector<std::string>& mModelFiles;
+
+		// Read and imported files, until they are uploaded
+		std::vector<std::vector<std::uint8_t>> mTextureFileData;
+		std::vector<std::vector<GeometryGenerator::MeshData>> mModelMeshes;
+
 		std::vector<ID3D12Resource*> mTextures;
 		std::vector<Model*> mModels;
 	};
@@ -0,0 +1,103 @@
+#include "MappedFile.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <Utils/DebugUtils.h>
+
+MappedFile::~MappedFile() {
+	Close();
+}
+
+#ifdef _WIN32
+bool MappedFile::Open(const char* filename) noexcept {
+	ASSERT(filename != nullptr);
+	ASSERT(mData == nullptr);
+
+	mFile = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (mFile == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+
+	LARGE_INTEGER size{};
+	if (GetFileSizeEx(mFile, &size) == FALSE || size.QuadPart == 0) {
+		Close();
+		return false;
+	}
+
+	mMapping = CreateFileMappingA(mFile, nullptr, PAGE_READONLY, 0U, 0U, nullptr);
+	if (mMapping == nullptr) {
+		Close();
+		return false;
+	}
+
+	mData = MapViewOfFile(mMapping, FILE_MAP_READ, 0U, 0U, 0U);
+	if (mData == nullptr) {
+		Close();
+		return false;
+	}
+
+	mSize = static_cast<std::size_t>(size.QuadPart);
+	return true;
+}
+
+void MappedFile::Close() noexcept {
+	if (mData != nullptr) {
+		UnmapViewOfFile(mData);
+		mData = nullptr;
+	}
+
+	if (mMapping != nullptr) {
+		CloseHandle(mMapping);
+		mMapping = nullptr;
+	}
+
+	if (mFile != INVALID_HANDLE_VALUE) {
+		CloseHandle(mFile);
+		mFile = INVALID_HANDLE_VALUE;
+	}
+
+	mSize = 0UL;
+}
+#else
+bool MappedFile::Open(const char* filename) noexcept {
+	ASSERT(filename != nullptr);
+	ASSERT(mData == nullptr);
+
+	const int file{ open(filename, O_RDONLY) };
+	if (file < 0) {
+		return false;
+	}
+
+	// The mapping keeps the file referenced, so the descriptor is not needed after mmap()
+	struct stat fileStat {};
+	if (fstat(file, &fileStat) != 0 || fileStat.st_size == 0) {
+		close(file);
+		return false;
+	}
+
+	const std::size_t size{ static_cast<std::size_t>(fileStat.st_size) };
+	void* data{ mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0) };
+	close(file);
+	if (data == MAP_FAILED) {
+		return false;
+	}
+
+	mData = data;
+	mSize = size;
+	return true;
+}
+
+void MappedFile::Close() noexcept {
+	if (mData != nullptr) {
+		munmap(const_cast<void*>(mData), mSize);
+		mData = nullptr;
+	}
+
+	mSize = 0UL;
+}
+#endif
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+#include <Utils/ForceInline.h>
+
+// Read only memory mapping of a whole file. Data() is valid until Close() or destruction.
+// It uses file mappings on Windows, and mmap() on other platforms.
+class MappedFile {
+public:
+	MappedFile() = default;
+	~MappedFile();
+	MappedFile(const MappedFile&) = delete;
+	const MappedFile& operator=(const MappedFile&) = delete;
+	MappedFile(MappedFile&&) = delete;
+	MappedFile& operator=(MappedFile&&) = delete;
+
+	// Returns false if the file does not exist, is empty, or can not be mapped
+	bool Open(const char* filename) noexcept;
+	void Close() noexcept;
+
+	__forceinline const void* Data() const noexcept { return mData; }
+	__forceinline std::size_t Size() const noexcept { return mSize; }
+
+private:
+#ifdef _WIN32
+	HANDLE mFile{ INVALID_HANDLE_VALUE };
+	HANDLE mMapping{ nullptr };
+#endif
+	const void* mData{ nullptr };
+	std::size_t mSize{ 0UL };
+};
@@ -0,0 +1,61 @@
+#include "ShaderFileStore.h"
+
+#include <ShaderManager/MappedFile.h>
+#include <Utils/DebugUtils.h>
+#include <Utils/HashUtils.h>
+
+namespace {
+	ShaderFileStore::View GetFileView(const MappedFile& file) noexcept {
+		ShaderFileStore::View view;
+		view.mData = file.Data();
+		view.mSize = file.Size();
+
+		return view;
+	}
+}
+
+std::size_t ShaderFileStore::Load(const char* filename, View& view) noexcept {
+	ASSERT(filename != nullptr);
+
+	const std::size_t id{ HashUtils::HashCString(filename) };
+
+	// The accessor only locks this element, so it is mapped once 
+	// while loads of other files continue.
+	FileById::accessor accessor;
+	if (mFileById.insert(accessor, id)) {
+		accessor->second.mFilename = filename;
+		accessor->second.mFile.reset(new MappedFile());
+		const bool opened{ accessor->second.mFile->Open(filename) };
+		ASSERT(opened);
+		++mMappedFileCount;
+	}
+	else {
+		// Different paths with the same hash
+		ASSERT(accessor->second.mFilename == filename);
+		++mInternedLoadCount;
+	}
+
+	ASSERT(accessor->second.mFile.get() != nullptr);
+	view = GetFileView(*accessor->second.mFile);
+	accessor.release();
+
+	return id;
+}
+
+ShaderFileStore::View ShaderFileStore::GetView(const std::size_t id) const noexcept {
+	FileById::const_accessor accessor;
+	mFileById.find(accessor, id);
+	ASSERT(!accessor.empty());
+	const View view{ GetFileView(*accessor->second.mFile) };
+	accessor.release();
+	
+	return view;
+}
+
+void ShaderFileStore::Erase(const std::size_t id) noexcept {
+	FileById::accessor accessor;
+	mFileById.find(accessor, id);
+	ASSERT(!accessor.empty());
+	mFileById.erase(accessor);
+	accessor.release();
+}
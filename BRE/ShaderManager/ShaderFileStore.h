@@ -0,0 +1,62 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <tbb/concurrent_hash_map.h>
+
+#include <Utils/ForceInline.h>
+
+class MappedFile;
+
+// Shader files interned by the hash of their path: each file is memory mapped once,
+// and loads return views of the mapped bytes (no copies). Ids are the paths hashes.
+// Loads of different files do not block each other (only loads of the same file wait for its mapping).
+// It does not depend on D3D (ShaderManager wraps the views in shader byte codes), so it can be tested on any platform.
+class ShaderFileStore {
+public:
+	struct View {
+		const void* mData{ nullptr };
+		std::size_t mSize{ 0UL };
+	};
+
+	ShaderFileStore() = default;
+	~ShaderFileStore() = default;
+	ShaderFileStore(const ShaderFileStore&) = delete;
+	const ShaderFileStore& operator=(const ShaderFileStore&) = delete;
+	ShaderFileStore(ShaderFileStore&&) = delete;
+	ShaderFileStore& operator=(ShaderFileStore&&) = delete;
+
+	// Returns the id of the file, mapping it if it was not loaded.
+	// Asserts if the file can not be mapped. View is valid until its id is erased.
+	std::size_t Load(const char* filename, View& view) noexcept;
+
+	// Asserts if id does not exist
+	View GetView(const std::size_t id) const noexcept;
+
+	// Asserts if id is not present
+	void Erase(const std::size_t id) noexcept;
+
+	// Invalidate all ids.
+	__forceinline void Clear() noexcept { mFileById.clear(); }
+
+	__forceinline std::size_t FileCount() const noexcept { return mFileById.size(); }
+
+	// Number of files mapped, and number of loads that reused an already mapped file
+	__forceinline std::uint32_t MappedFileCount() const noexcept { return mMappedFileCount; }
+	__forceinline std::uint32_t InternedLoadCount() const noexcept { return mInternedLoadCount; }
+
+private:
+	struct ShaderFile {
+		std::string mFilename;
+		std::shared_ptr<MappedFile> mFile;
+	};
+
+	using FileById = tbb::concurrent_hash_map<std::size_t, ShaderFile>;
+	FileById mFileById;
+
+	std::atomic<std::uint32_t> mMappedFileCount{ 0U };
+	std::atomic<std::uint32_t> mInternedLoadCount{ 0U };
+};
@@ -1,12 +1,13 @@
 #pragma once
 
+#include <cstdint>
 #include <d3d12.h>
-#include <D3Dcommon.h>
-#include <mutex>
-#include <tbb\concurrent_hash_map.h>
-#include <wrl.h>
 
-// This class is responsible to create/get/erase shaders
+#include <ShaderManager/ShaderFileStore.h>
+
+// This class is responsible to load/get/erase shaders.
+// Shader files are interned by ShaderFileStore: each file is memory mapped once, 
+// and loads return views of the mapped bytes (no copies). Ids are the paths hashes.
 class ShaderManager {
 public:
 	static ShaderManager& Create() noexcept;
@@ -18,25 +19,25 @@ public:
 	ShaderManager(ShaderManager&&) = delete;
 	ShaderManager& operator=(ShaderManager&&) = delete;
 
-	// Returns id to get blob/shader byte code after creation
-	std::size_t LoadShaderFile(const char* filename, ID3DBlob* &blob) noexcept;
+	// Returns id to get shader byte code after creation.
+	// Shader byte code is valid until its id is erased.
 	std::size_t LoadShaderFile(const char* filename, D3D12_SHADER_BYTECODE& shaderByteCode) noexcept;
 	
 	// Asserts if id does not exist
-	ID3DBlob& GetBlob(const std::size_t id) noexcept;
 	D3D12_SHADER_BYTECODE GetShaderByteCode(const std::size_t id) noexcept;
 
 	// Asserts if id is not present
-	void Erase(const std::size_t id) noexcept;
+	__forceinline void Erase(const std::size_t id) noexcept { mStore.Erase(id); }
 
 	// Invalidate all ids.
-	__forceinline void Clear() noexcept { mBlobById.clear(); }
+	__forceinline void Clear() noexcept { mStore.Clear(); }
+
+	// Number of files mapped, and number of loads that reused an already mapped file
+	__forceinline std::uint32_t MappedFileCount() const noexcept { return mStore.MappedFileCount(); }
+	__forceinline std::uint32_t InternedLoadCount() const noexcept { return mStore.InternedLoadCount(); }
 
 private:
 	ShaderManager() = default;
 
-	using BlobById = tbb::concurrent_hash_map<std::size_t, Microsoft::WRL::ComPtr<ID3DBlob>>;
-	BlobById mBlobById;
-
-	std::mutex mMutex;
+	ShaderFileStore mStore;
 };
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <DirectXMath.h>
 
 #include <GlobalData\Settings.h>
@@ -17,6 +18,21 @@ struct ObjectCBuffer {
 	float mTexTransform{ 2.0f };
 };
 
+// Per instance data. It is stored in structured buffers
+// indexed by instance id (geometry pass).
+// mMaterialIndex is the index in MaterialRegistry.
+struct InstanceData {
+	InstanceData() = default;
+	~InstanceData() = default;
+	InstanceData(const InstanceData&) = default;
+	InstanceData(InstanceData&&) = default;
+	InstanceData& operator=(InstanceData&&) = default;
+
+	DirectX::XMFLOAT4X4 mWorld{ MathUtils::Identity4x4() };
+	float mTexTransform{ 2.0f };
+	std::uint32_t mMaterialIndex{ 0U };
+};
+
 // Per frame constant buffer data
 struct FrameCBuffer {
 	FrameCBuffer() = default;
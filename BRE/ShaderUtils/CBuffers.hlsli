@@ -7,6 +7,21 @@ struct ObjectCBuffer {
 	float mTexTransform;
 };
 
+// Per instance data (structured buffer element).
+// mMaterialIndex indexes the shared materials buffer (materials are deduplicated),
+// and materials have the indices of their textures in the bindless textures array.
+struct InstanceData {
+	float4x4 mW;
+	float mTexTransform;
+	uint mMaterialIndex;
+};
+
+// Root constant with the index (in visible instances) of the first instance of the draw.
+// SV_InstanceID starts at zero in every draw (StartInstanceLocation is not added)
+struct InstanceOffset {
+	uint mInstanceOffset;
+};
+
 // Per frame constant buffer data
 struct FrameCBuffer {	
 	float4x4 mV;
@@ -21,4 +36,16 @@ struct ImmutableCBuffer {
 	float4 mNearZ_FarZ_ScreenW_ScreenH;
 };
 
+// Root constants used to find the cluster of a pixel in clustered lighting.
+// Depth slice is floor(log(depthV) * scale + bias), and tile is screen coordinates * tile scale.
+struct ClusterParams {
+	float4 mDepthSliceScale_Bias_TileScaleX_TileScaleY;
+};
+
+// Diffuse irradiance (divided by PI) as order 3 spherical harmonics (SphericalHarmonics::Coefficients).
+// Coefficients are RGB, w is not used.
+struct IrradianceSH {
+	float4 mCoefficients[9];
+};
+
 #endif
\ No newline at end of file
@@ -220,4 +220,23 @@ float3 SpecularBrdf(const float3 N, const float3 V, const float3 L, const float3
 	return D * F * G_Correlated;
 }
 
+//
+// Diffuse irradiance from order 3 spherical harmonics (see IrradianceSH).
+// It returns the same value as sampling a diffuse irradiance cube map.
+// normalW must be normalized.
+//
+float3 EvaluateIrradianceSH(const float3 normalW, const float4 coefficients[9]) {
+	const float x = normalW.x;
+	const float y = normalW.y;
+	const float z = normalW.z;
+
+	float3 irradiance = 0.282095f * coefficients[0].rgb;
+	irradiance += 0.488603f * (y * coefficients[1].rgb + z * coefficients[2].rgb + x * coefficients[3].rgb);
+	irradiance += 1.092548f * (x * y * coefficients[4].rgb + y * z * coefficients[5].rgb + x * z * coefficients[7].rgb);
+	irradiance += 0.315392f * (3.0f * z * z - 1.0f) * coefficients[6].rgb;
+	irradiance += 0.546274f * (x * x - y * y) * coefficients[8].rgb;
+
+	return max(irradiance, 0.0f);
+}
+
 #endif
\ No newline at end of file
@@ -4,6 +4,11 @@
 struct Material {
 	float4 mBaseColor_MetalMask;
 	float mSmoothness;
+	// Indices in the bindless textures array (same layout than C++ Material,
+	// to be used in structured buffers)
+	uint mDiffuseTextureIndex;
+	uint mNormalTextureIndex;
+	uint mHeightTextureIndex;
 };
 
 #endif 
\ No newline at end of file
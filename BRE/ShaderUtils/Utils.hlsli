@@ -12,6 +12,13 @@ float NdcDepthToViewDepth(const float depthNDC, const float4x4 projection) {
 	return depthV;
 }
 
+// Returns -1.0f if the world matrix mirrors geometry (negative determinant) and 1.0f otherwise.
+// Cross product of transformed normal and tangent flips in that case, so tangent frame
+// handedness must be multiplied by it.
+float WorldHandedness(const float4x4 world) {
+	return determinant((float3x3)world) < 0.0f ? -1.0f : 1.0f;
+}
+
 //
 // Octahedron-normal encoding/decoding 
 //
@@ -9,6 +9,8 @@
 #include <ResourceManager/UploadBuffer.h>
 #include <ShaderUtils\CBuffers.h>
 #include <Utils/DebugUtils.h>
+#include <Utils/Profiler.h>
+#include <Utils/RenderStats.h>
 
 // Root Signature:
 // "DescriptorTable(CBV(b0), visibility = SHADER_VISIBILITY_VERTEX), " \ 0 -> Object CBuffers
@@ -99,6 +101,8 @@ void SkyBoxCmdListRecorder::Init(
 }
 
 void SkyBoxCmdListRecorder::RecordAndPushCommandLists(const FrameCBuffer& frameCBuffer) noexcept {
+	PROFILE_ZONE("SkyBoxCmdListRecorder::RecordAndPushCommandLists");
+
 	ASSERT(ValidateData());
 	ASSERT(sPSO != nullptr);
 	ASSERT(sRootSign != nullptr);
@@ -111,6 +115,7 @@ void SkyBoxCmdListRecorder::RecordAndPushCommandLists(const FrameCBuffer& frameC
 	uploadFrameCBuffer.CopyData(0U, &frameCBuffer, sizeof(frameCBuffer));
 
 	CHECK_HR(cmdAlloc->Reset());
+	RENDER_STATS_ADD(PIPELINE_STATE_CHANGES, 1UL);
 	CHECK_HR(mCmdList->Reset(cmdAlloc, sPSO));
 
 	mCmdList->RSSetViewports(1U, &Settings::sScreenViewport);
@@ -119,6 +124,7 @@ void SkyBoxCmdListRecorder::RecordAndPushCommandLists(const FrameCBuffer& frameC
 
 	ID3D12DescriptorHeap* heaps[] = { &DescriptorManager::Get().GetCbvSrcUavDescriptorHeap() };
 	mCmdList->SetDescriptorHeaps(_countof(heaps), heaps);
+	RENDER_STATS_ADD(ROOT_SIGNATURE_CHANGES, 1UL);
 	mCmdList->SetGraphicsRootSignature(sRootSign);
 
 	D3D12_GPU_DESCRIPTOR_HANDLE objectCBufferGpuDescHandle(mObjectCBufferGpuDescHandleBegin);
@@ -133,10 +139,12 @@ void SkyBoxCmdListRecorder::RecordAndPushCommandLists(const FrameCBuffer& frameC
 	// Draw object
 	mCmdList->IASetVertexBuffers(0U, 1U, &mVertexBufferData.mBufferView);
 	mCmdList->IASetIndexBuffer(&mIndexBufferData.mBufferView);
+	RENDER_STATS_ADD(DESCRIPTOR_TABLES, 2UL);
 	mCmdList->SetGraphicsRootDescriptorTable(0U, objectCBufferGpuDescHandle);
 	mCmdList->SetGraphicsRootDescriptorTable(2U, cubeMapBufferGpuDescHandle);
 
-	mCmdList->DrawIndexedInstanced(mIndexBufferData.mCount, 1U, 0U, 0U, 0U);
+	RENDER_STATS_DRAW(mIndexBufferData.mCount, 1U);
+	mCmdList->DrawIndexedInstanced(mIndexBufferData.mCount, 1U, mIndexBufferData.mStartIndex, mVertexBufferData.mBaseVertex, 0U);
 
 	mCmdList->Close();
 
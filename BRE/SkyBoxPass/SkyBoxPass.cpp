@@ -11,6 +11,7 @@
 #include <SkyBoxPass\SkyBoxCmdListRecorder.h>
 #include <ShaderUtils\CBuffers.h>
 #include <Utils\DebugUtils.h>
+#include <Utils/Profiler.h>
 
 namespace {
 	void CreateCommandObjects(
@@ -59,6 +60,10 @@ namespace {
 	}
 }
 
+void SkyBoxPass::InitPSOs() noexcept {
+	SkyBoxCmdListRecorder::InitPSO();
+}
+
 void SkyBoxPass::Init(
 	ID3D12Device& device,
 	CommandListExecutor& cmdListExecutor,
@@ -78,7 +83,7 @@ void SkyBoxPass::Init(
 	Model* model;
 	Microsoft::WRL::ComPtr<ID3D12Resource> uploadVertexBuffer;
 	Microsoft::WRL::ComPtr<ID3D12Resource> uploadIndexBuffer;
-	ModelManager::Get().CreateSphere(3000, 50, 50, model, *mCmdList, uploadVertexBuffer, uploadIndexBuffer);
+	const std::size_t modelId{ ModelManager::Get().CreateSphere(3000, 50, 50, model, *mCmdList, uploadVertexBuffer, uploadIndexBuffer) };
 	ASSERT(model != nullptr);
 	const std::vector<Mesh>& meshes(model->Meshes());
 	ASSERT(meshes.size() == 1UL);
@@ -89,9 +94,7 @@ void SkyBoxPass::Init(
 	MathUtils::ComputeMatrix(w, 0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f, 0.0f, 0.0f, 0.0f);
 	
 	ExecuteCommandList(cmdQueue, *mCmdList, *mFence);
-
-	// Initialize recoders's pso
-	SkyBoxCmdListRecorder::InitPSO();
+	ModelManager::Get().UploadFlushed(modelId);
 
 	// Initialize recorder
 	mRecorder.reset(new SkyBoxCmdListRecorder(device, cmdListExecutor.CmdListQueue()));
@@ -107,15 +110,15 @@ void SkyBoxPass::Init(
 }
 
 void SkyBoxPass::Execute(const FrameCBuffer& frameCBuffer) const noexcept {
+	PROFILE_ZONE("SkyBoxPass::Execute");
+
 	ASSERT(ValidateData());
 
 	mCmdListExecutor->ResetExecutedCmdListCount();
 	mRecorder->RecordAndPushCommandLists(frameCBuffer);
 
 	// Wait until all previous tasks command lists are executed
-	while (mCmdListExecutor->ExecutedCmdListCount() < 1U) {
-		Sleep(0U);
-	}
+	mCmdListExecutor->WaitForExecutedCmdLists(1U);
 }
 
 bool SkyBoxPass::ValidateData() const noexcept {
@@ -20,6 +20,9 @@ public:
 	SkyBoxPass(SkyBoxPass&&) = delete;
 	SkyBoxPass& operator=(SkyBoxPass&&) = delete;
 
+	// Creates recorder pipeline state. It must be called before Init().
+	static void InitPSOs() noexcept;
+
 	// You should call this method after filling recorder and before Execute()
 	void Init(
 		ID3D12Device& device,
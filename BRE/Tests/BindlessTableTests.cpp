@@ -0,0 +1,87 @@
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <tbb/parallel_for.h>
+
+#include <DescriptorManager/BindlessTable.h>
+
+namespace {
+	// gtest macros take their arguments by reference, so static members cannot be used
+	const std::uint32_t sInvalidSlot{ BindlessTable::sInvalidSlot };
+}
+
+TEST(BindlessTable, Empty) {
+	BindlessTable table{ 16U };
+	EXPECT_EQ(table.Capacity(), 16U);
+	EXPECT_EQ(table.SlotCount(), 0U);
+	EXPECT_EQ(table.AcquireCount(), 0U);
+
+	const std::uint32_t resource{ 0U };
+	EXPECT_EQ(table.Find(&resource), sInvalidSlot);
+}
+
+// Distinct resources get consecutive slots, and the same resource always gets its slot
+TEST(BindlessTable, SlotsAreShared) {
+	const std::uint32_t resourceCount{ 10U };
+	std::vector<std::uint32_t> resources(resourceCount);
+	BindlessTable table{ resourceCount };
+
+	bool isNew{ false };
+	for (std::uint32_t i = 0U; i < resourceCount; ++i) {
+		EXPECT_EQ(table.Acquire(&resources[i], isNew), i);
+		EXPECT_TRUE(isNew);
+	}
+
+	// Instances that use the same textures
+	for (std::uint32_t instance = 0U; instance < 3U; ++instance) {
+		for (std::uint32_t i = 0U; i < resourceCount; ++i) {
+			EXPECT_EQ(table.Acquire(&resources[i], isNew), i);
+			EXPECT_FALSE(isNew);
+		}
+	}
+
+	EXPECT_EQ(table.SlotCount(), resourceCount);
+	EXPECT_EQ(table.AcquireCount(), resourceCount * 4U);
+	for (std::uint32_t i = 0U; i < resourceCount; ++i) {
+		EXPECT_EQ(table.Find(&resources[i]), i);
+	}
+
+	const std::uint32_t otherResource{ 0U };
+	EXPECT_EQ(table.Find(&otherResource), sInvalidSlot);
+}
+
+// Recorders acquire slots from several threads: each resource gets a single slot,
+// and slots are dense.
+TEST(BindlessTable, ConcurrentAcquire) {
+	const std::uint32_t resourceCount{ 1000U };
+	std::vector<std::uint32_t> resources(resourceCount);
+	BindlessTable table{ resourceCount };
+
+	const std::uint32_t acquireCount{ resourceCount * 8U };
+	std::vector<std::uint32_t> slots(acquireCount);
+	std::vector<std::uint8_t> isNewFlags(acquireCount);
+	tbb::parallel_for(0U, acquireCount, [&](const std::uint32_t i) {
+		bool isNew;
+		slots[i] = table.Acquire(&resources[i % resourceCount], isNew);
+		isNewFlags[i] = isNew ? 1U : 0U;
+	});
+
+	EXPECT_EQ(table.SlotCount(), resourceCount);
+	EXPECT_EQ(table.AcquireCount(), acquireCount);
+	EXPECT_EQ(static_cast<std::uint32_t>(std::count(isNewFlags.begin(), isNewFlags.end(), 1U)), resourceCount);
+
+	std::vector<std::uint32_t> resourceSlots(resourceCount);
+	for (std::uint32_t i = 0U; i < resourceCount; ++i) {
+		resourceSlots[i] = table.Find(&resources[i]);
+	}
+	for (std::uint32_t i = 0U; i < acquireCount; ++i) {
+		ASSERT_EQ(slots[i], resourceSlots[i % resourceCount]) << "acquire " << i;
+	}
+
+	std::sort(resourceSlots.begin(), resourceSlots.end());
+	for (std::uint32_t i = 0U; i < resourceCount; ++i) {
+		ASSERT_EQ(resourceSlots[i], i);
+	}
+}
@@ -0,0 +1,247 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <MathUtils/Bvh.h>
+#include <MathUtils/FrustumCuller.h>
+#include <Tests/TestUtils.h>
+
+namespace {
+	const float sPi{ 3.14159265f };
+
+	Aabb RandomBox(std::mt19937& generator, const float sceneExtent, const float maxSize) {
+		Aabb box;
+		for (std::uint32_t j = 0U; j < 3U; ++j) {
+			box.mMin[j] = TestUtils::RandF(generator, -sceneExtent, sceneExtent);
+			box.mMax[j] = box.mMin[j] + TestUtils::RandF(generator, 0.0f, maxSize);
+		}
+
+		return box;
+	}
+
+	std::vector<Aabb> RandomBoxes(std::mt19937& generator, const std::uint32_t count) {
+		std::vector<Aabb> boxes(count);
+		for (Aabb& box : boxes) {
+			box = RandomBox(generator, 100.0f, 5.0f);
+		}
+
+		return boxes;
+	}
+
+	// Brute force references of Bvh queries
+
+	bool OverlapBox(const Aabb& a, const Aabb& b) {
+		for (std::uint32_t j = 0U; j < 3U; ++j) {
+			if (a.mMin[j] > b.mMax[j] || a.mMax[j] < b.mMin[j]) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	bool OverlapSphere(const Aabb& box, const float center[3U], const float radius) {
+		float sqrDist{ 0.0f };
+		for (std::uint32_t j = 0U; j < 3U; ++j) {
+			const float v{ std::max(box.mMin[j] - center[j], 0.0f) + std::max(center[j] - box.mMax[j], 0.0f) };
+			sqrDist += v * v;
+		}
+
+		return sqrDist <= radius * radius;
+	}
+
+	bool OverlapPlanes(const Aabb& box, const float (&planes)[6U][4U]) {
+		for (const float (&plane)[4U] : planes) {
+			// Box corner that is farthest along plane normal
+			float dist{ plane[3U] };
+			for (std::uint32_t j = 0U; j < 3U; ++j) {
+				dist += plane[j] * (plane[j] > 0.0f ? box.mMax[j] : box.mMin[j]);
+			}
+			if (dist < 0.0f) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	bool OverlapSegment(const Aabb& box, const float origin[3U], const float direction[3U], const float maxDistance) {
+		float tMin{ 0.0f };
+		float tMax{ maxDistance };
+		for (std::uint32_t j = 0U; j < 3U; ++j) {
+			const float t0{ (box.mMin[j] - origin[j]) / direction[j] };
+			const float t1{ (box.mMax[j] - origin[j]) / direction[j] };
+			tMin = std::max(tMin, std::min(t0, t1));
+			tMax = std::min(tMax, std::max(t0, t1));
+		}
+
+		return tMin <= tMax;
+	}
+
+	template<typename Predicate>
+	std::vector<std::uint32_t> BruteForce(const std::vector<Aabb>& boxes, const Predicate& predicate) {
+		std::vector<std::uint32_t> result;
+		for (std::uint32_t i = 0U; i < boxes.size(); ++i) {
+			if (predicate(boxes[i])) {
+				result.push_back(i);
+			}
+		}
+
+		return result;
+	}
+
+	std::vector<std::uint32_t> Sorted(std::vector<std::uint32_t> indices) {
+		std::sort(indices.begin(), indices.end());
+		return indices;
+	}
+
+	// Compares all queries results against brute force, with random volumes
+	void ExpectQueriesMatchBruteForce(const Bvh& bvh, const std::vector<Aabb>& boxes, std::mt19937& generator) {
+		std::vector<std::uint32_t> result;
+		for (std::uint32_t i = 0U; i < 8U; ++i) {
+			const float eye[3U]{ TestUtils::RandF(generator, -100.0f, 100.0f), TestUtils::RandF(generator, -100.0f, 100.0f), TestUtils::RandF(generator, -100.0f, 100.0f) };
+			const float target[3U]{ TestUtils::RandF(generator, -100.0f, 100.0f), TestUtils::RandF(generator, -100.0f, 100.0f), TestUtils::RandF(generator, -100.0f, 100.0f) };
+			float viewProj[16U];
+			TestUtils::LookAtPerspective(eye, target, sPi * 0.25f, 16.0f / 9.0f, 0.1f, 100.0f, viewProj);
+			FrustumCuller culler;
+			culler.SetViewProjection(viewProj);
+			const float (&planes)[6U][4U] = culler.Planes();
+			bvh.FrustumQuery(planes, result);
+			EXPECT_EQ(Sorted(result), BruteForce(boxes, [&planes](const Aabb& box) { return OverlapPlanes(box, planes); }));
+
+			const float radius{ TestUtils::RandF(generator, 0.0f, 30.0f) };
+			bvh.SphereQuery(eye, radius, result);
+			EXPECT_EQ(Sorted(result), BruteForce(boxes, [&eye, radius](const Aabb& box) { return OverlapSphere(box, eye, radius); }));
+
+			const Aabb queryBox{ RandomBox(generator, 100.0f, 40.0f) };
+			bvh.BoxQuery(queryBox, result);
+			EXPECT_EQ(Sorted(result), BruteForce(boxes, [&queryBox](const Aabb& box) { return OverlapBox(box, queryBox); }));
+
+			const float direction[3U]{ target[0U] - eye[0U], target[1U] - eye[1U], target[2U] - eye[2U] };
+			bvh.RayQuery(eye, direction, 1.0f, result);
+			EXPECT_EQ(Sorted(result), BruteForce(boxes, [&eye, &direction](const Aabb& box) { return OverlapSegment(box, eye, direction, 1.0f); }));
+		}
+	}
+}
+
+TEST(Bvh, Empty) {
+	Bvh bvh;
+	bvh.Build(nullptr, 0U);
+	EXPECT_TRUE(bvh.ValidateData());
+	EXPECT_TRUE(bvh.Nodes().empty());
+
+	std::vector<std::uint32_t> result{ 1U };
+	const float center[3U]{ 0.0f, 0.0f, 0.0f };
+	bvh.SphereQuery(center, 100.0f, result);
+	EXPECT_TRUE(result.empty());
+}
+
+TEST(Bvh, BuildIsValid) {
+	std::mt19937 generator{ 1U };
+
+	// Sizes below and above the leaf size and the parallel build threshold
+	const std::uint32_t maxLeafSize{ Bvh::sMaxLeafSize };
+	for (const std::uint32_t count : { 1U, maxLeafSize, maxLeafSize + 1U, 1000U, Bvh::sParallelBuildThreshold * 4U + 3U }) {
+		const std::vector<Aabb> boxes{ RandomBoxes(generator, count) };
+		Bvh bvh;
+		bvh.Build(boxes.data(), count);
+		ASSERT_TRUE(bvh.ValidateData()) << "count " << count;
+		EXPECT_EQ(bvh.PrimitiveCount(), count);
+
+		// Interior nodes have 2 children, so there are 2 * leaves - 1 nodes
+		std::uint32_t leafCount{ 0U };
+		for (const Bvh::Node& node : bvh.Nodes()) {
+			if (node.IsLeaf()) {
+				EXPECT_LE(node.mCount, maxLeafSize);
+				++leafCount;
+			}
+		}
+		EXPECT_EQ(bvh.Nodes().size(), leafCount * 2UL - 1UL);
+	}
+}
+
+TEST(Bvh, CoincidentCentroids) {
+	// No split can separate them, they must still be all referenced
+	const Aabb box{ { -1.0f, -1.0f, -1.0f }, { 1.0f, 1.0f, 1.0f } };
+	const std::vector<Aabb> boxes(100U, box);
+	Bvh bvh;
+	bvh.Build(boxes.data(), static_cast<std::uint32_t>(boxes.size()));
+	ASSERT_TRUE(bvh.ValidateData());
+
+	std::vector<std::uint32_t> result;
+	bvh.BoxQuery(box, result);
+	EXPECT_EQ(result.size(), boxes.size());
+}
+
+TEST(Bvh, QueriesMatchBruteForce) {
+	std::mt19937 generator{ 2U };
+	const std::vector<Aabb> boxes{ RandomBoxes(generator, 20000U) };
+	Bvh bvh;
+	bvh.Build(boxes.data(), static_cast<std::uint32_t>(boxes.size()));
+	ASSERT_TRUE(bvh.ValidateData());
+
+	ExpectQueriesMatchBruteForce(bvh, boxes, generator);
+}
+
+TEST(Bvh, IncrementalRefitMatchesRebuild) {
+	std::mt19937 generator{ 3U };
+	std::vector<Aabb> boxes{ RandomBoxes(generator, 20000U) };
+	Bvh bvh;
+	bvh.Build(boxes.data(), static_cast<std::uint32_t>(boxes.size()));
+
+	// Move 10% of primitives, some of them far away
+	std::vector<std::uint32_t> moved;
+	std::vector<Aabb> movedBoxes;
+	for (std::uint32_t i = 0U; i < boxes.size(); i += 10U) {
+		boxes[i] = RandomBox(generator, i % 20U == 0U ? 200.0f : 100.0f, 5.0f);
+		moved.push_back(i);
+		movedBoxes.push_back(boxes[i]);
+	}
+	bvh.Refit(moved.data(), movedBoxes.data(), static_cast<std::uint32_t>(moved.size()));
+	ASSERT_TRUE(bvh.ValidateData());
+
+	// Queries return the same primitives as a rebuilt hierarchy (and brute force)
+	Bvh rebuilt;
+	rebuilt.Build(boxes.data(), static_cast<std::uint32_t>(boxes.size()));
+	std::vector<std::uint32_t> result;
+	std::vector<std::uint32_t> rebuiltResult;
+	const Aabb queryBox{ { -50.0f, -50.0f, -50.0f }, { 50.0f, 50.0f, 50.0f } };
+	bvh.BoxQuery(queryBox, result);
+	rebuilt.BoxQuery(queryBox, rebuiltResult);
+	EXPECT_EQ(Sorted(result), Sorted(rebuiltResult));
+
+	ExpectQueriesMatchBruteForce(bvh, boxes, generator);
+}
+
+TEST(Bvh, FullRefitMatchesRebuild) {
+	std::mt19937 generator{ 4U };
+	std::vector<Aabb> boxes{ RandomBoxes(generator, 5000U) };
+	Bvh bvh;
+	bvh.Build(boxes.data(), static_cast<std::uint32_t>(boxes.size()));
+
+	// Translate all primitives
+	for (Aabb& box : boxes) {
+		for (std::uint32_t j = 0U; j < 3U; ++j) {
+			box.mMin[j] += 7.0f;
+			box.mMax[j] += 7.0f;
+		}
+	}
+	bvh.Refit(boxes.data());
+	ASSERT_TRUE(bvh.ValidateData());
+
+	// Root bounds are the bounds of all primitives
+	Aabb bounds{ Aabb::Empty() };
+	for (const Aabb& box : boxes) {
+		bounds.Merge(box);
+	}
+	for (std::uint32_t j = 0U; j < 3U; ++j) {
+		EXPECT_EQ(bvh.Nodes()[0U].mBox.mMin[j], bounds.mMin[j]);
+		EXPECT_EQ(bvh.Nodes()[0U].mBox.mMax[j], bounds.mMax[j]);
+	}
+
+	ExpectQueriesMatchBruteForce(bvh, boxes, generator);
+}
@@ -0,0 +1,235 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <MathUtils/ClusteredLightCuller.h>
+#include <Tests/TestUtils.h>
+
+namespace {
+	const float sNearZ{ 0.5f };
+	const float sFarZ{ 200.0f };
+
+	// 60 degrees vertical field of view, 16:9
+	const float sProj11{ 1.0f / std::tan(3.14159265f / 6.0f) };
+	const float sProj00{ sProj11 * 9.0f / 16.0f };
+
+	// gtest macros take their arguments by reference, so static members cannot be used
+	const std::uint32_t sMaxLightsPerCluster{ ClusteredLightCuller::sMaxLightsPerCluster };
+
+	void SetDefaultProjection(ClusteredLightCuller& culler) {
+		culler.SetProjection(sNearZ, sFarZ, sProj00, sProj11);
+	}
+
+	// View space spheres (center and radius), most of them in the view frustum
+	std::vector<float> RandomSpheres(std::mt19937& generator, const std::uint32_t count, const float maxRadius) {
+		std::vector<float> spheres;
+		for (std::uint32_t i = 0U; i < count; ++i) {
+			const float z{ TestUtils::RandF(generator, -5.0f, 120.0f) };
+			const float halfExtent{ std::max(std::fabs(z), 1.0f) };
+			spheres.push_back(TestUtils::RandF(generator, -halfExtent, halfExtent) * 1.2f / sProj00);
+			spheres.push_back(TestUtils::RandF(generator, -halfExtent, halfExtent) * 1.2f / sProj11);
+			spheres.push_back(z);
+			spheres.push_back(TestUtils::RandF(generator, 0.1f, maxRadius));
+		}
+
+		return spheres;
+	}
+
+	bool SphereIntersectsBox(const float sphere[4U], const Aabb& box) {
+		float sqrDist{ 0.0f };
+		for (std::uint32_t j = 0U; j < 3U; ++j) {
+			const float d{ std::max(box.mMin[j] - sphere[j], 0.0f) + std::max(sphere[j] - box.mMax[j], 0.0f) };
+			sqrDist += d * d;
+		}
+
+		return sqrDist <= sphere[3U] * sphere[3U];
+	}
+
+	// Brute force cluster of a view space point, or false if it is outside the view frustum
+	bool PointCluster(const ClusteredLightCuller& culler, const float point[3U], std::uint32_t& clusterIndex) {
+		if (point[2U] < sNearZ || point[2U] >= sFarZ) {
+			return false;
+		}
+
+		const float ndcX{ sProj00 * point[0U] / point[2U] };
+		const float ndcY{ sProj11 * point[1U] / point[2U] };
+		if (std::fabs(ndcX) >= 1.0f || std::fabs(ndcY) >= 1.0f) {
+			return false;
+		}
+
+		std::uint32_t z{ 0U };
+		while (point[2U] >= culler.ClusterBox(ClusteredLightCuller::ClusterIndex(0U, 0U, z)).mMax[2U]) {
+			++z;
+		}
+		const std::uint32_t x{ static_cast<std::uint32_t>((ndcX * 0.5f + 0.5f) * ClusteredLightCuller::sClusterCountX) };
+		const std::uint32_t y{ static_cast<std::uint32_t>((0.5f - ndcY * 0.5f) * ClusteredLightCuller::sClusterCountY) };
+		clusterIndex = ClusteredLightCuller::ClusterIndex(x, y, z);
+		return true;
+	}
+
+	std::vector<std::uint32_t> ClusterLights(const ClusteredLightCuller& culler, const std::uint32_t clusterIndex) {
+		const std::uint32_t offset{ culler.ClusterRanges()[clusterIndex * 2UL] };
+		const std::uint32_t count{ culler.ClusterRanges()[clusterIndex * 2UL + 1UL] };
+		return std::vector<std::uint32_t>(culler.LightIndices().begin() + offset, culler.LightIndices().begin() + offset + count);
+	}
+
+	// Ranges are contiguous, in cluster order, and each cluster lights are sorted and unique.
+	// Offsets of empty clusters are not used.
+	void ExpectValidRanges(const ClusteredLightCuller& culler) {
+		const std::vector<std::uint32_t>& ranges(culler.ClusterRanges());
+		ASSERT_EQ(ranges.size(), ClusteredLightCuller::sClusterCount * 2UL);
+		std::uint32_t offset{ 0U };
+		for (std::uint32_t i = 0U; i < ClusteredLightCuller::sClusterCount; ++i) {
+			if (ranges[i * 2UL + 1UL] != 0U) {
+				ASSERT_EQ(ranges[i * 2UL], offset) << "cluster " << i;
+			}
+			ASSERT_LE(ranges[i * 2UL + 1UL], sMaxLightsPerCluster);
+			offset += ranges[i * 2UL + 1UL];
+
+			const std::vector<std::uint32_t> lights{ ClusterLights(culler, i) };
+			EXPECT_TRUE(std::adjacent_find(lights.begin(), lights.end(), std::greater_equal<std::uint32_t>()) == lights.end()) << "cluster " << i;
+		}
+		EXPECT_EQ(offset, static_cast<std::uint32_t>(culler.LightIndices().size()));
+	}
+}
+
+TEST(ClusteredLightCuller, DepthSlices) {
+	ClusteredLightCuller culler;
+	SetDefaultProjection(culler);
+
+	// Slices cover [near, far], and the documented formula gives the slice of a depth
+	EXPECT_FLOAT_EQ(culler.ClusterBox(0U).mMin[2U], sNearZ);
+	EXPECT_FLOAT_EQ(culler.ClusterBox(ClusteredLightCuller::sClusterCount - 1U).mMax[2U], sFarZ);
+	for (std::uint32_t z = 0U; z < ClusteredLightCuller::sClusterCountZ; ++z) {
+		const Aabb& box(culler.ClusterBox(ClusteredLightCuller::ClusterIndex(0U, 0U, z)));
+		if (z > 0U) {
+			EXPECT_EQ(box.mMin[2U], culler.ClusterBox(ClusteredLightCuller::ClusterIndex(0U, 0U, z - 1U)).mMax[2U]);
+		}
+
+		const float midDepth{ std::sqrt(box.mMin[2U] * box.mMax[2U]) };
+		EXPECT_EQ(static_cast<std::uint32_t>(std::log(midDepth) * culler.DepthSliceScale() + culler.DepthSliceBias()), z);
+	}
+}
+
+TEST(ClusteredLightCuller, Empty) {
+	ClusteredLightCuller culler;
+	SetDefaultProjection(culler);
+	culler.Build(nullptr, 0U, sizeof(float) * 4UL);
+	ExpectValidRanges(culler);
+	EXPECT_TRUE(culler.LightIndices().empty());
+	EXPECT_EQ(culler.MaxClusterLightCount(), 0U);
+}
+
+TEST(ClusteredLightCuller, LightsOutsideFrustum) {
+	ClusteredLightCuller culler;
+	SetDefaultProjection(culler);
+
+	const float spheres[][4U]{
+		{ 0.0f, 0.0f, -10.0f, 1.0f }, // Behind the eye
+		{ 0.0f, 0.0f, 300.0f, 50.0f }, // Beyond far plane
+		{ 200.0f, 0.0f, 10.0f, 5.0f }, // Right of the frustum
+		{ 0.0f, -100.0f, 10.0f, 5.0f }, // Below the frustum
+	};
+	culler.Build(spheres, 4U, sizeof(spheres[0U]));
+	ExpectValidRanges(culler);
+	EXPECT_TRUE(culler.LightIndices().empty());
+}
+
+// Assignments must be conservative (every cluster a light reaches lists it),
+// and every assigned light must intersect the cluster bounds.
+TEST(ClusteredLightCuller, MatchesBruteForce) {
+	std::mt19937 generator{ 1U };
+	ClusteredLightCuller culler;
+	SetDefaultProjection(culler);
+
+	for (const float maxRadius : { 1.0f, 10.0f }) {
+		const std::uint32_t lightCount{ 300U };
+		const std::vector<float> spheres{ RandomSpheres(generator, lightCount, maxRadius) };
+		culler.Build(spheres.data(), lightCount, sizeof(float) * 4UL);
+		ASSERT_LE(culler.MaxClusterLightCount(), sMaxLightsPerCluster) << "radius " << maxRadius;
+		ExpectValidRanges(culler);
+
+		std::vector<std::vector<std::uint32_t>> clusterLights(ClusteredLightCuller::sClusterCount);
+		for (std::uint32_t i = 0U; i < ClusteredLightCuller::sClusterCount; ++i) {
+			clusterLights[i] = ClusterLights(culler, i);
+			for (const std::uint32_t light : clusterLights[i]) {
+				ASSERT_LT(light, lightCount);
+				EXPECT_TRUE(SphereIntersectsBox(&spheres[light * 4UL], culler.ClusterBox(i))) << "cluster " << i << ", light " << light;
+			}
+		}
+
+		// Points inside each light sphere
+		for (std::uint32_t light = 0U; light < lightCount; ++light) {
+			const float* sphere{ &spheres[light * 4UL] };
+			for (std::uint32_t sample = 0U; sample < 200U; ++sample) {
+				float point[3U];
+				float sqrLength{ 0.0f };
+				do {
+					for (float& c : point) {
+						c = TestUtils::RandF(generator, -1.0f, 1.0f);
+					}
+					sqrLength = point[0U] * point[0U] + point[1U] * point[1U] + point[2U] * point[2U];
+				} while (sqrLength > 1.0f);
+				for (std::uint32_t j = 0U; j < 3U; ++j) {
+					point[j] = sphere[j] + point[j] * sphere[3U];
+				}
+
+				std::uint32_t clusterIndex;
+				if (PointCluster(culler, point, clusterIndex)) {
+					const std::vector<std::uint32_t>& lights(clusterLights[clusterIndex]);
+					EXPECT_TRUE(std::binary_search(lights.begin(), lights.end(), light)) << "cluster " << clusterIndex << ", light " << light;
+				}
+			}
+		}
+	}
+}
+
+TEST(ClusteredLightCuller, MaxLightsPerCluster) {
+	ClusteredLightCuller culler;
+	SetDefaultProjection(culler);
+
+	// Lights beyond the limit are dropped, in lights order
+	const std::uint32_t lightCount{ ClusteredLightCuller::sMaxLightsPerCluster + 50U };
+	std::vector<float> spheres;
+	for (std::uint32_t i = 0U; i < lightCount; ++i) {
+		spheres.insert(spheres.end(), { 0.0f, 0.0f, 20.0f, 0.01f });
+	}
+	culler.Build(spheres.data(), lightCount, sizeof(float) * 4UL);
+	ExpectValidRanges(culler);
+	EXPECT_EQ(culler.MaxClusterLightCount(), sMaxLightsPerCluster);
+
+	const float center[3U]{ 0.0f, 0.0f, 20.0f };
+	std::uint32_t clusterIndex;
+	ASSERT_TRUE(PointCluster(culler, center, clusterIndex));
+	const std::vector<std::uint32_t> lights{ ClusterLights(culler, clusterIndex) };
+	ASSERT_EQ(lights.size(), sMaxLightsPerCluster);
+	EXPECT_EQ(lights.back(), ClusteredLightCuller::sMaxLightsPerCluster - 1U);
+}
+
+TEST(ClusteredLightCuller, Stride) {
+	std::mt19937 generator{ 2U };
+	const std::uint32_t lightCount{ 100U };
+	const std::vector<float> spheres{ RandomSpheres(generator, lightCount, 5.0f) };
+
+	// Light data with 4 more floats after each sphere
+	std::vector<float> lights;
+	for (std::uint32_t i = 0U; i < lightCount; ++i) {
+		lights.insert(lights.end(), spheres.begin() + i * 4UL, spheres.begin() + i * 4UL + 4UL);
+		lights.insert(lights.end(), { -1.0f, -1.0f, -1.0f, -1.0f });
+	}
+
+	ClusteredLightCuller culler;
+	SetDefaultProjection(culler);
+	culler.Build(spheres.data(), lightCount, sizeof(float) * 4UL);
+	const std::vector<std::uint32_t> expectedRanges{ culler.ClusterRanges() };
+	const std::vector<std::uint32_t> expectedIndices{ culler.LightIndices() };
+
+	culler.Build(lights.data(), lightCount, sizeof(float) * 8UL);
+	EXPECT_EQ(culler.ClusterRanges(), expectedRanges);
+	EXPECT_EQ(culler.LightIndices(), expectedIndices);
+}
@@ -0,0 +1,77 @@
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <tbb/parallel_for.h>
+
+#include <CommandListExecutor/CommandListExecutor.h>
+#include <CommandManager/NullCommandList.h>
+#include <CommandManager/NullCommandQueue.h>
+
+// Command lists pushed from several threads are all executed, in batches of at most maxNumCmdLists
+TEST(CommandListExecutor, ExecutesPushedCmdLists) {
+	const std::uint32_t cmdListCount{ 1000U };
+	const std::uint32_t maxNumCmdLists{ 4U };
+	std::vector<NullCommandList> cmdLists(cmdListCount);
+	NullCommandQueue cmdQueue;
+	CommandListExecutor* executor{ CommandListExecutor::Create(cmdQueue, maxNumCmdLists) };
+	ASSERT_NE(executor, nullptr);
+
+	executor->ResetExecutedCmdListCount();
+	tbb::parallel_for(0U, cmdListCount, [&](const std::uint32_t i) {
+		executor->CmdListQueue().push(cmdLists[i].Handle());
+	});
+	executor->WaitForExecutedCmdLists(cmdListCount);
+
+	EXPECT_EQ(executor->ExecutedCmdListCount(), cmdListCount);
+	EXPECT_TRUE(executor->IsIdle());
+	EXPECT_EQ(cmdQueue.ExecutedCmdListCount(), cmdListCount);
+	EXPECT_GE(cmdQueue.ExecuteCount(), cmdListCount / maxNumCmdLists);
+	EXPECT_LE(cmdQueue.ExecuteCount(), cmdListCount);
+	EXPECT_EQ(cmdQueue.InvalidCallCount(), 0U);
+
+	executor->Terminate();
+	delete executor;
+}
+
+// Each frame resets the count and waits its command lists, as passes do
+TEST(CommandListExecutor, WaitsEachFrame) {
+	const std::uint32_t frameCount{ 100U };
+	const std::uint32_t cmdListCount{ 8U };
+	std::vector<NullCommandList> cmdLists(cmdListCount);
+	NullCommandQueue cmdQueue;
+	CommandListExecutor* executor{ CommandListExecutor::Create(cmdQueue, 1U) };
+
+	for (std::uint32_t frame = 0U; frame < frameCount; ++frame) {
+		executor->ResetExecutedCmdListCount();
+		for (NullCommandList& cmdList : cmdLists) {
+			executor->CmdListQueue().push(cmdList.Handle());
+		}
+		executor->WaitForExecutedCmdLists(cmdListCount);
+		ASSERT_EQ(executor->ExecutedCmdListCount(), cmdListCount);
+		ASSERT_EQ(cmdQueue.ExecutedCmdListCount(), (frame + 1U) * cmdListCount);
+	}
+
+	// A command list per ExecuteCommandLists()
+	EXPECT_EQ(cmdQueue.ExecuteCount(), frameCount * cmdListCount);
+
+	executor->Terminate();
+	delete executor;
+}
+
+// Command lists pushed before Terminate() are executed
+TEST(CommandListExecutor, TerminateExecutesQueuedCmdLists) {
+	const std::uint32_t cmdListCount{ 64U };
+	std::vector<NullCommandList> cmdLists(cmdListCount);
+	NullCommandQueue cmdQueue;
+	CommandListExecutor* executor{ CommandListExecutor::Create(cmdQueue, 16U) };
+
+	for (NullCommandList& cmdList : cmdLists) {
+		executor->CmdListQueue().push(cmdList.Handle());
+	}
+	executor->Terminate();
+
+	EXPECT_EQ(cmdQueue.ExecutedCmdListCount(), cmdListCount);
+	EXPECT_TRUE(executor->IsIdle());
+	delete executor;
+}
@@ -0,0 +1,287 @@
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <CommandManager/CaptureCommandList.h>
+#include <CommandManager/CommandStream.h>
+#include <CommandManager/CommandStreamReplay.h>
+#include <CommandManager/NullCommandList.h>
+
+namespace {
+	// Objects are only passed through, so any address is a valid object
+	std::uint64_t sObjects[4U];
+	ID3D12PipelineState* const sPipelineState{ reinterpret_cast<ID3D12PipelineState*>(&sObjects[0U]) };
+	ID3D12RootSignature* const sRootSignature{ reinterpret_cast<ID3D12RootSignature*>(&sObjects[1U]) };
+	ID3D12DescriptorHeap* const sDescriptorHeap{ reinterpret_cast<ID3D12DescriptorHeap*>(&sObjects[2U]) };
+	ID3D12Resource* const sResource{ reinterpret_cast<ID3D12Resource*>(&sObjects[3U]) };
+
+	// Size of the header of saved files (magic, version and data size)
+	const std::size_t sFileHeaderSize{ sizeof(std::uint32_t) * 2UL + sizeof(std::uint64_t) };
+
+	// Records a geometry pass like frame, with every command type and
+	// arrays of several sizes (frameIndex changes its arguments)
+	void RecordFrame(GraphicsCommandList& cmdList, const std::uint32_t frameIndex) {
+		GraphicsCommandList::Barrier barriers[3U];
+		for (GraphicsCommandList::Barrier& barrier : barriers) {
+			barrier.mType = GraphicsCommandList::sResourceBarrierTypeTransition;
+			barrier.mResource = sResource;
+			barrier.mStateBefore = 0x80U;
+			barrier.mStateAfter = 0x4U;
+		}
+		cmdList.ResourceBarrier(3U, barriers);
+
+		GraphicsCommandList::Viewport viewport;
+		viewport.mWidth = 1920.0f;
+		viewport.mHeight = 1080.0f;
+		viewport.mMaxDepth = 1.0f;
+		cmdList.RSSetViewports(1U, &viewport);
+		GraphicsCommandList::Rect rect;
+		rect.mRight = 1920;
+		rect.mBottom = 1080;
+		cmdList.RSSetScissorRects(1U, &rect);
+
+		GraphicsCommandList::CpuDescriptorHandle renderTargets[3U];
+		renderTargets[0U].mPtr = 0x100UL;
+		renderTargets[1U].mPtr = 0x200UL;
+		renderTargets[2U].mPtr = 0x300UL;
+		GraphicsCommandList::CpuDescriptorHandle depthStencil;
+		depthStencil.mPtr = 0x400UL;
+		cmdList.OMSetRenderTargets(3U, renderTargets, false, &depthStencil);
+		// A single handle to a descriptor range, without depth stencil
+		cmdList.OMSetRenderTargets(2U, renderTargets, true, nullptr);
+
+		ID3D12DescriptorHeap* heaps[]{ sDescriptorHeap };
+		cmdList.SetDescriptorHeaps(1U, heaps);
+		cmdList.SetPipelineState(sPipelineState);
+		cmdList.SetGraphicsRootSignature(sRootSignature);
+		cmdList.SetGraphicsRootConstantBufferView(0U, 0x1000UL + frameIndex * 0x100UL);
+		cmdList.SetGraphicsRootShaderResourceView(1U, 0x2000UL);
+		cmdList.SetGraphicsRootDescriptorTable(2U, 0x3000UL);
+		cmdList.IASetPrimitiveTopology(GraphicsCommandList::sPrimitiveTopologyTriangleList);
+
+		for (std::uint32_t i = 0U; i < 4U; ++i) {
+			GraphicsCommandList::VertexBufferView vertexBufferViews[2U];
+			vertexBufferViews[0U].mBufferLocation = 0x10000UL + i * 0x1000UL;
+			vertexBufferViews[0U].mSizeInBytes = 0x1000U;
+			vertexBufferViews[0U].mStrideInBytes = 32U;
+			vertexBufferViews[1U] = vertexBufferViews[0U];
+			vertexBufferViews[1U].mStrideInBytes = 16U;
+			cmdList.IASetVertexBuffers(0U, 2U, vertexBufferViews);
+
+			GraphicsCommandList::IndexBufferView indexBufferView;
+			indexBufferView.mBufferLocation = 0x20000UL + i * 0x800UL;
+			indexBufferView.mSizeInBytes = 0x800U;
+			indexBufferView.mFormat = i % 2U == 0U ? GraphicsCommandList::sIndexFormatR32 : GraphicsCommandList::sIndexFormatR16;
+			cmdList.IASetIndexBuffer(&indexBufferView);
+
+			cmdList.SetGraphicsRoot32BitConstant(3U, i + frameIndex, 1U);
+			cmdList.DrawIndexedInstanced(36U + i, 1U + frameIndex, i * 6U, -static_cast<std::int32_t>(i), i);
+		}
+
+		// Invalid commands are captured and replayed too
+		cmdList.IASetIndexBuffer(nullptr);
+	}
+
+	// Captures frameCount frames (of a command list each) while they are forwarded to forwardCmdList
+	void CaptureFrames(CommandStream& stream, NullCommandList& forwardCmdList, const std::uint32_t frameCount) {
+		CaptureCommandList captureCmdList(stream, &forwardCmdList);
+		for (std::uint32_t i = 0U; i < frameCount; ++i) {
+			const float frameCBuffer[4U]{ static_cast<float>(i), 1.0f, 2.0f, 3.0f };
+			stream.BeginFrame(frameCBuffer, sizeof(frameCBuffer));
+			RecordFrame(captureCmdList, i);
+			stream.CloseCommandList();
+			stream.ExecuteCommandLists(1U);
+		}
+	}
+
+	void ExpectSameCommands(const NullCommandList& cmdList, const NullCommandList& expectedCmdList) {
+		const std::vector<NullCommandList::Command>& commands(cmdList.Commands());
+		const std::vector<NullCommandList::Command>& expectedCommands(expectedCmdList.Commands());
+		ASSERT_EQ(commands.size(), expectedCommands.size());
+		for (std::size_t i = 0UL; i < commands.size(); ++i) {
+			EXPECT_EQ(commands[i].mType, expectedCommands[i].mType) << i;
+			EXPECT_EQ(commands[i].mAddress, expectedCommands[i].mAddress) << i;
+			for (std::uint32_t j = 0U; j < 5U; ++j) {
+				EXPECT_EQ(commands[i].mValues[j], expectedCommands[i].mValues[j]) << i << " " << j;
+			}
+		}
+		EXPECT_EQ(cmdList.InvalidCommandCount(), expectedCmdList.InvalidCommandCount());
+		EXPECT_EQ(cmdList.DrawnIndexCount(), expectedCmdList.DrawnIndexCount());
+		EXPECT_EQ(cmdList.DrawnInstanceCount(), expectedCmdList.DrawnInstanceCount());
+	}
+
+	std::vector<char> ReadFile(const std::string& path) {
+		std::ifstream fin{ path, std::ios::binary };
+		return std::vector<char>(std::istreambuf_iterator<char>(fin), std::istreambuf_iterator<char>());
+	}
+
+	void WriteFile(const std::string& path, const std::vector<char>& data, const std::size_t size) {
+		std::ofstream fout{ path, std::ios::binary | std::ios::trunc };
+		fout.write(data.data(), size);
+	}
+
+	// copy is set to the first size bytes of stream
+	void CopyStream(const CommandStream& stream, const std::size_t size, CommandStream& copy) {
+		copy.Clear();
+		copy.WriteBytes(stream.Data().data(), size);
+	}
+}
+
+// Capture, save, load and replay into a null command list issues
+// the same commands the captured code recorded
+TEST(CommandStream, RoundTrip) {
+	const std::uint32_t frameCount{ 3U };
+
+	// Captured commands are forwarded
+	CommandStream stream;
+	NullCommandList recordedCmdList;
+	CaptureFrames(stream, recordedCmdList, frameCount);
+	EXPECT_TRUE(stream.IsValid());
+
+	NullCommandList directCmdList;
+	for (std::uint32_t i = 0U; i < frameCount; ++i) {
+		RecordFrame(directCmdList, i);
+	}
+	ExpectSameCommands(recordedCmdList, directCmdList);
+	EXPECT_EQ(directCmdList.InvalidCommandCount(), frameCount);
+
+	const std::string path{ std::string(BRE_TEST_FILES_PATH) + "RoundTrip.cmdstream" };
+	ASSERT_TRUE(stream.Save(path.c_str()));
+	CommandStream loadedStream;
+	ASSERT_TRUE(loadedStream.Load(path.c_str()));
+	EXPECT_EQ(loadedStream.Data(), stream.Data());
+
+	NullCommandList replayedCmdList;
+	CommandStream::ReplayStats stats;
+	ASSERT_TRUE(loadedStream.Replay(replayedCmdList, stats));
+	ExpectSameCommands(replayedCmdList, directCmdList);
+	EXPECT_EQ(stats.mFrameCount, frameCount);
+	EXPECT_EQ(stats.mCmdListCount, frameCount);
+	EXPECT_EQ(stats.mExecuteCount, frameCount);
+	EXPECT_EQ(stats.mCommandCount, directCmdList.Commands().size());
+	EXPECT_EQ(stats.mDrawCount, directCmdList.CommandCount(NullCommandList::DRAW_INDEXED_INSTANCED));
+
+	// Frame constant buffers
+	for (std::uint32_t i = 0U; i < frameCount; ++i) {
+		std::uint32_t size{ 0U };
+		const float* frameCBuffer{ static_cast<const float*>(loadedStream.FrameCBuffer(i, size)) };
+		ASSERT_NE(frameCBuffer, nullptr);
+		EXPECT_EQ(size, sizeof(float) * 4U);
+		EXPECT_EQ(frameCBuffer[0U], static_cast<float>(i));
+		EXPECT_EQ(frameCBuffer[3U], 3.0f);
+	}
+	std::uint32_t size{ 0U };
+	EXPECT_EQ(loadedStream.FrameCBuffer(frameCount, size), nullptr);
+}
+
+TEST(CommandStream, ReplayRepetitions) {
+	CommandStream stream;
+	NullCommandList recordedCmdList;
+	CaptureFrames(stream, recordedCmdList, 2U);
+
+	NullCommandList replayedCmdList;
+	CommandStreamReplay::Result result;
+	CommandStreamReplay::Run(stream, replayedCmdList, 5U, result);
+	EXPECT_TRUE(result.mIsValid);
+	EXPECT_EQ(result.mRepeatCount, 5U);
+	EXPECT_EQ(result.mStats.mFrameCount, 10U);
+	EXPECT_EQ(result.mStats.mCommandCount, recordedCmdList.Commands().size() * 5UL);
+	EXPECT_EQ(replayedCmdList.Commands().size(), recordedCmdList.Commands().size() * 5UL);
+}
+
+// Streams cut at any byte are rejected unless they are cut at a record boundary,
+// and Replay() fails (without reading beyond the end) on rejected ones.
+TEST(CommandStream, TruncatedStreams) {
+	CommandStream stream;
+	NullCommandList recordedCmdList;
+	CaptureFrames(stream, recordedCmdList, 1U);
+
+	CommandStream truncatedStream;
+	std::uint32_t invalidStreamCount{ 0U };
+	for (std::size_t size = 0UL; size < stream.Size(); ++size) {
+		CopyStream(stream, size, truncatedStream);
+		NullCommandList cmdList;
+		CommandStream::ReplayStats stats;
+		const bool isValid{ truncatedStream.IsValid() };
+		EXPECT_EQ(truncatedStream.Replay(cmdList, stats), isValid) << size;
+		if (isValid == false) {
+			++invalidStreamCount;
+		}
+	}
+	EXPECT_GT(invalidStreamCount, 0U);
+
+	// Cut in the middle of the last record (the last execute)
+	CopyStream(stream, stream.Size() - 1UL, truncatedStream);
+	EXPECT_FALSE(truncatedStream.IsValid());
+
+	// Truncated files
+	const std::string path{ std::string(BRE_TEST_FILES_PATH) + "Truncated.cmdstream" };
+	ASSERT_TRUE(stream.Save(path.c_str()));
+	const std::vector<char> file{ ReadFile(path) };
+	ASSERT_EQ(file.size(), sFileHeaderSize + stream.Size());
+
+	const std::size_t truncatedSizes[]{ 0UL, sFileHeaderSize - 1UL, sFileHeaderSize, file.size() / 2UL, file.size() - 1UL };
+	for (const std::size_t truncatedSize : truncatedSizes) {
+		WriteFile(path, file, truncatedSize);
+		CommandStream loadedStream;
+		EXPECT_FALSE(loadedStream.Load(path.c_str())) << truncatedSize;
+		EXPECT_EQ(loadedStream.Size(), 0UL) << truncatedSize;
+	}
+
+	EXPECT_FALSE(CommandStream().Load((std::string(BRE_TEST_FILES_PATH) + "Missing.cmdstream").c_str()));
+}
+
+TEST(CommandStream, CorruptedStreams) {
+	CommandStream stream;
+	NullCommandList recordedCmdList;
+	CaptureFrames(stream, recordedCmdList, 1U);
+
+	// Unknown record type (the first record is the frame begin)
+	CommandStream corruptedStream;
+	const std::uint8_t unknownType{ CommandStream::RECORD_TYPE_COUNT };
+	corruptedStream.Write(unknownType);
+	corruptedStream.WriteBytes(stream.Data().data() + 1UL, stream.Size() - 1UL);
+	EXPECT_FALSE(corruptedStream.IsValid());
+	NullCommandList cmdList;
+	CommandStream::ReplayStats stats;
+	EXPECT_FALSE(corruptedStream.Replay(cmdList, stats));
+	EXPECT_TRUE(cmdList.Commands().empty());
+
+	// Arrays larger than replayed commands accept
+	GraphicsCommandList::Viewport viewports[GraphicsCommandList::sMaxViewportCount + 1U];
+	corruptedStream.Clear();
+	{
+		CaptureCommandList captureCmdList(corruptedStream);
+		captureCmdList.RSSetViewports(GraphicsCommandList::sMaxViewportCount, viewports);
+		EXPECT_TRUE(corruptedStream.IsValid());
+		captureCmdList.RSSetViewports(GraphicsCommandList::sMaxViewportCount + 1U, viewports);
+	}
+	EXPECT_FALSE(corruptedStream.IsValid());
+	cmdList.Clear();
+	stats = CommandStream::ReplayStats();
+	EXPECT_FALSE(corruptedStream.Replay(cmdList, stats));
+	EXPECT_EQ(stats.mCommandCount, 1U);
+
+	// Corrupted files: record type, magic and version
+	const std::string path{ std::string(BRE_TEST_FILES_PATH) + "Corrupted.cmdstream" };
+	ASSERT_TRUE(stream.Save(path.c_str()));
+	const std::vector<char> file{ ReadFile(path) };
+	const std::size_t corruptedOffsets[]{ sFileHeaderSize, 0UL, sizeof(std::uint32_t) };
+	for (const std::size_t offset : corruptedOffsets) {
+		std::vector<char> corruptedFile(file);
+		corruptedFile[offset] = static_cast<char>(0xFF);
+		WriteFile(path, corruptedFile, corruptedFile.size());
+		CommandStream loadedStream;
+		EXPECT_FALSE(loadedStream.Load(path.c_str())) << offset;
+		EXPECT_EQ(loadedStream.Size(), 0UL) << offset;
+	}
+
+	// The original file is loaded
+	WriteFile(path, file, file.size());
+	CommandStream loadedStream;
+	EXPECT_TRUE(loadedStream.Load(path.c_str()));
+}
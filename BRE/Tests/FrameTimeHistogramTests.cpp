@@ -0,0 +1,211 @@
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <Timer/FrameStats.h>
+#include <Timer/FrameTimeHistogram.h>
+
+namespace {
+	const std::uint64_t sNanosecondsPerMicrosecond{ 1000UL };
+
+	// Value (in nanoseconds) of rank ceil(percentile * count / 100) of sorted values
+	std::uint64_t ExactPercentile(std::vector<std::uint64_t> values, const double percentile) {
+		std::sort(values.begin(), values.end());
+		std::size_t rank{ static_cast<std::size_t>(percentile * 0.01 * values.size() + 0.5) };
+		rank = rank == 0UL ? 1UL : rank;
+		return values[rank - 1UL];
+	}
+}
+
+TEST(FrameTimeHistogram, ExactValuesHaveTheirOwnBucket) {
+	for (std::uint32_t i = 0U; i < FrameTimeHistogram::sExactValueCount; ++i) {
+		EXPECT_EQ(FrameTimeHistogram::BucketIndex(i), i);
+		EXPECT_EQ(FrameTimeHistogram::BucketLowestValue(i), i);
+		EXPECT_EQ(FrameTimeHistogram::BucketHighestValue(i), i);
+	}
+}
+
+TEST(FrameTimeHistogram, BucketsAreContiguous) {
+	for (std::uint32_t i = 0U; i < FrameTimeHistogram::sBucketCount; ++i) {
+		const std::uint64_t lowest{ FrameTimeHistogram::BucketLowestValue(i) };
+		const std::uint64_t highest{ FrameTimeHistogram::BucketHighestValue(i) };
+		ASSERT_LE(lowest, highest);
+		EXPECT_EQ(FrameTimeHistogram::BucketIndex(lowest), i);
+		EXPECT_EQ(FrameTimeHistogram::BucketIndex(highest), i);
+
+		if (i + 1U < FrameTimeHistogram::sBucketCount) {
+			EXPECT_EQ(FrameTimeHistogram::BucketLowestValue(i + 1U), highest + 1UL);
+		}
+	}
+
+	EXPECT_EQ(FrameTimeHistogram::BucketHighestValue(FrameTimeHistogram::sBucketCount - 1U), (1ULL << FrameTimeHistogram::sMaxExponent) - 1UL);
+}
+
+TEST(FrameTimeHistogram, BucketRelativeErrorIsBounded) {
+	for (std::uint32_t i = FrameTimeHistogram::sExactValueCount; i < FrameTimeHistogram::sBucketCount; ++i) {
+		const std::uint64_t lowest{ FrameTimeHistogram::BucketLowestValue(i) };
+		const std::uint64_t width{ FrameTimeHistogram::BucketHighestValue(i) - lowest + 1UL };
+		EXPECT_LE(width * FrameTimeHistogram::sSubBucketCount, lowest);
+	}
+}
+
+TEST(FrameTimeHistogram, HugeValuesAreClampedToLastBucket) {
+	const std::uint32_t lastBucket{ FrameTimeHistogram::sBucketCount - 1U };
+	EXPECT_EQ(FrameTimeHistogram::BucketIndex(1ULL << FrameTimeHistogram::sMaxExponent), lastBucket);
+	EXPECT_EQ(FrameTimeHistogram::BucketIndex(~0ULL), lastBucket);
+
+	FrameTimeHistogram histogram;
+	const std::uint64_t huge{ ~0ULL / 2UL };
+	histogram.Record(huge);
+	EXPECT_EQ(histogram.Count(), 1UL);
+	EXPECT_EQ(histogram.Max(), huge);
+	EXPECT_EQ(histogram.Percentile(100.0), huge);
+}
+
+TEST(FrameTimeHistogram, EmptyHistogram) {
+	FrameTimeHistogram histogram;
+	EXPECT_EQ(histogram.Count(), 0UL);
+	EXPECT_EQ(histogram.Min(), 0UL);
+	EXPECT_EQ(histogram.Max(), 0UL);
+	EXPECT_EQ(histogram.Percentile(50.0), 0UL);
+	EXPECT_EQ(histogram.Mean(), 0.0);
+	EXPECT_EQ(histogram.Variance(), 0.0);
+}
+
+TEST(FrameTimeHistogram, PercentileRank) {
+	// 1 to 60 microseconds, one value per exact bucket
+	FrameTimeHistogram histogram;
+	for (std::uint64_t i = 1UL; i <= 60UL; ++i) {
+		histogram.Record(i * sNanosecondsPerMicrosecond);
+	}
+
+	// Percentiles are reported by the highest value of their bucket
+	EXPECT_EQ(histogram.Percentile(50.0), 31UL * sNanosecondsPerMicrosecond - 1UL);
+	EXPECT_EQ(histogram.Percentile(95.0), 58UL * sNanosecondsPerMicrosecond - 1UL);
+	EXPECT_EQ(histogram.Percentile(10.0), 7UL * sNanosecondsPerMicrosecond - 1UL);
+
+	// First rank is at least 1, last one is clamped to the maximum recorded value
+	EXPECT_EQ(histogram.Percentile(0.0), 2UL * sNanosecondsPerMicrosecond - 1UL);
+	EXPECT_EQ(histogram.Percentile(100.0), 60UL * sNanosecondsPerMicrosecond);
+}
+
+TEST(FrameTimeHistogram, PercentileIsAnUpperBoundWithBoundedError) {
+	std::mt19937_64 generator{ 42UL };
+	std::lognormal_distribution<double> distribution{ 9.7, 0.5 }; // ~16 ms frames
+
+	FrameTimeHistogram histogram;
+	std::vector<std::uint64_t> values;
+	for (std::uint32_t i = 0U; i < 10000U; ++i) {
+		const std::uint64_t value{ static_cast<std::uint64_t>(distribution(generator)) * sNanosecondsPerMicrosecond };
+		values.push_back(value);
+		histogram.Record(value);
+	}
+
+	for (const double percentile : { 1.0, 50.0, 90.0, 95.0, 99.0, 99.9 }) {
+		const std::uint64_t exact{ ExactPercentile(values, percentile) };
+		const std::uint64_t value{ histogram.Percentile(percentile) };
+		EXPECT_GE(value, exact) << "percentile " << percentile;
+		EXPECT_LE(static_cast<double>(value), exact * (1.0 + 1.0 / FrameTimeHistogram::sSubBucketCount) + sNanosecondsPerMicrosecond)
+			<< "percentile " << percentile;
+	}
+}
+
+TEST(FrameTimeHistogram, PercentilesAreClampedToMinAndMax) {
+	// A single value in a wide bucket is reported exactly
+	FrameTimeHistogram histogram;
+	const std::uint64_t value{ 5500UL * sNanosecondsPerMicrosecond + 123UL };
+	histogram.Record(value);
+	EXPECT_EQ(histogram.Min(), value);
+	EXPECT_EQ(histogram.Max(), value);
+	EXPECT_EQ(histogram.Percentile(0.0), value);
+	EXPECT_EQ(histogram.Percentile(50.0), value);
+	EXPECT_EQ(histogram.Percentile(100.0), value);
+
+	// Values of the same bucket are reported up to the maximum
+	histogram.Record(value + 10UL);
+	EXPECT_EQ(histogram.Min(), value);
+	EXPECT_EQ(histogram.Max(), value + 10UL);
+	EXPECT_EQ(histogram.Percentile(50.0), value + 10UL);
+}
+
+TEST(FrameTimeHistogram, MeanAndVariance) {
+	FrameTimeHistogram histogram;
+	histogram.Record(1000UL * sNanosecondsPerMicrosecond);
+	histogram.Record(3000UL * sNanosecondsPerMicrosecond);
+	EXPECT_DOUBLE_EQ(histogram.Mean(), 2000.0 * sNanosecondsPerMicrosecond);
+	EXPECT_DOUBLE_EQ(histogram.Variance(), 1000.0 * 1000.0 * sNanosecondsPerMicrosecond * sNanosecondsPerMicrosecond);
+}
+
+TEST(FrameTimeHistogram, Reset) {
+	FrameTimeHistogram histogram;
+	histogram.Record(7UL);
+	histogram.Record(70000UL);
+	histogram.Reset();
+	EXPECT_EQ(histogram.Count(), 0UL);
+	EXPECT_EQ(histogram.Min(), 0UL);
+	EXPECT_EQ(histogram.Max(), 0UL);
+	EXPECT_EQ(histogram.Percentile(99.0), 0UL);
+}
+
+TEST(FrameTimeHistogram, ConcurrentRecord) {
+	const std::uint32_t threadCount{ 8U };
+	const std::uint64_t recordsPerThread{ 100000UL };
+
+	FrameTimeHistogram histogram;
+	std::vector<std::thread> threads;
+	for (std::uint32_t i = 0U; i < threadCount; ++i) {
+		threads.emplace_back([&histogram, i, recordsPerThread]() {
+			// Thread i records (i + 1) milliseconds, and its first record is i + 1 microseconds
+			histogram.Record((i + 1UL) * sNanosecondsPerMicrosecond);
+			for (std::uint64_t j = 1UL; j < recordsPerThread; ++j) {
+				histogram.Record((i + 1UL) * 1000UL * sNanosecondsPerMicrosecond);
+			}
+		});
+	}
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+
+	const std::uint64_t count{ threadCount * recordsPerThread };
+	EXPECT_EQ(histogram.Count(), count);
+	EXPECT_EQ(histogram.Min(), 1UL * sNanosecondsPerMicrosecond);
+	EXPECT_EQ(histogram.Max(), threadCount * 1000UL * sNanosecondsPerMicrosecond);
+	EXPECT_EQ(histogram.Percentile(100.0), histogram.Max());
+
+	// Sums are exact (values are multiples of a microsecond)
+	double sum{ 0.0 };
+	for (std::uint32_t i = 0U; i < threadCount; ++i) {
+		sum += (i + 1.0) + (recordsPerThread - 1.0) * (i + 1.0) * 1000.0;
+	}
+	EXPECT_DOUBLE_EQ(histogram.Mean(), sum / count * sNanosecondsPerMicrosecond);
+
+	// Each thread has 1/8 of records, so the median is the 4th thread value
+	EXPECT_GE(histogram.Percentile(50.0), 4000UL * sNanosecondsPerMicrosecond);
+	EXPECT_LT(histogram.Percentile(50.0), 5000UL * sNanosecondsPerMicrosecond);
+}
+
+TEST(FrameStats, SummaryAndStutters) {
+	const std::uint64_t nanosecondsPerMillisecond{ 1000000UL };
+
+	FrameStats stats;
+	for (std::uint32_t i = 0U; i < 100U; ++i) {
+		stats.RecordFrame(16UL * nanosecondsPerMillisecond, 4UL * nanosecondsPerMillisecond);
+	}
+	stats.RecordFrame(100UL * nanosecondsPerMillisecond, 0UL);
+
+	const FrameStats::Summary summary{ stats.TotalSummary() };
+	EXPECT_EQ(summary.mFrameCount, 101UL);
+	EXPECT_EQ(summary.mStutterCount, 1UL);
+	EXPECT_NEAR(summary.mMin, 16.0, 0.001);
+	EXPECT_NEAR(summary.mMax, 100.0, 0.001);
+	EXPECT_NEAR(summary.mP50, 16.0, 16.0 / FrameTimeHistogram::sSubBucketCount);
+	EXPECT_NEAR(summary.mMeanWaitTime, 400.0 / 101.0, 0.001);
+
+	stats.BeginWindow();
+	EXPECT_EQ(stats.WindowSummary().mFrameCount, 0UL);
+	EXPECT_EQ(stats.TotalSummary().mFrameCount, 101UL);
+}
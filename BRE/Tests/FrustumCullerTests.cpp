@@ -0,0 +1,142 @@
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <MathUtils/FrustumCuller.h>
+#include <Tests/TestUtils.h>
+
+namespace {
+	const float sPi{ 3.14159265f };
+
+	// Camera at the origin looking at +z, 90 degrees field of view, near 1 and far 100
+	void SetDefaultCamera(FrustumCuller& culler) {
+		const float eye[3U]{ 0.0f, 0.0f, 0.0f };
+		const float target[3U]{ 0.0f, 0.0f, 1.0f };
+		float viewProj[16U];
+		TestUtils::LookAtPerspective(eye, target, sPi * 0.5f, 1.0f, 1.0f, 100.0f, viewProj);
+		culler.SetViewProjection(viewProj);
+	}
+
+	// Scalar reference, with the same planes
+	bool IsSphereVisible(const float (&planes)[FrustumCuller::sPlaneCount][4U], const float center[3U], const float radius) {
+		for (const float (&plane)[4U] : planes) {
+			if (plane[0U] * center[0U] + plane[1U] * center[1U] + plane[2U] * center[2U] + plane[3U] + radius < 0.0f) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+}
+
+TEST(FrustumCuller, PlanesAreNormalized) {
+	FrustumCuller culler;
+	SetDefaultCamera(culler);
+
+	for (const float (&plane)[4U] : culler.Planes()) {
+		EXPECT_NEAR(plane[0U] * plane[0U] + plane[1U] * plane[1U] + plane[2U] * plane[2U], 1.0f, 1.0e-5f);
+	}
+
+	// Near and far planes are at their distances from the eye
+	EXPECT_NEAR(culler.Planes()[4U][2U], 1.0f, 1.0e-5f);
+	EXPECT_NEAR(culler.Planes()[4U][3U], -1.0f, 1.0e-4f);
+	EXPECT_NEAR(culler.Planes()[5U][2U], -1.0f, 1.0e-5f);
+	EXPECT_NEAR(culler.Planes()[5U][3U], 100.0f, 1.0e-2f);
+}
+
+TEST(FrustumCuller, KnownSpheres) {
+	FrustumCuller culler;
+	SetDefaultCamera(culler);
+
+	const float spheres[][4U]{
+		{ 0.0f, 0.0f, 10.0f, 1.0f }, // Inside
+		{ 0.0f, 0.0f, -10.0f, 1.0f }, // Behind the eye
+		{ 0.0f, 0.0f, 150.0f, 1.0f }, // Beyond far plane
+		{ 0.0f, 0.0f, 100.5f, 1.0f }, // Intersects far plane
+		{ 11.0f, 0.0f, 10.0f, 0.5f }, // Right of the frustum
+		{ 10.5f, 0.0f, 10.0f, 1.0f }, // Intersects right plane
+		{ 0.0f, -12.0f, 10.0f, 1.0f }, // Below the frustum
+		{ 0.0f, 0.0f, 0.5f, 0.25f }, // Between the eye and near plane
+		{ 0.0f, 0.0f, 0.5f, 0.75f }, // Intersects near plane
+	};
+	const bool expected[]{ true, false, false, true, false, true, false, false, true };
+	const std::uint32_t count{ static_cast<std::uint32_t>(sizeof(expected) / sizeof(expected[0U])) };
+
+	culler.ResizeSpheres(count);
+	for (std::uint32_t i = 0U; i < count; ++i) {
+		culler.SetSphere(i, spheres[i], spheres[i][3U]);
+	}
+
+	std::vector<std::uint32_t> visibleIndices;
+	culler.Cull(visibleIndices);
+
+	std::vector<std::uint32_t> expectedIndices;
+	for (std::uint32_t i = 0U; i < count; ++i) {
+		if (expected[i]) {
+			expectedIndices.push_back(i);
+		}
+	}
+	EXPECT_EQ(visibleIndices, expectedIndices);
+	EXPECT_EQ(culler.VisibleCount(), static_cast<std::uint32_t>(expectedIndices.size()));
+	EXPECT_EQ(culler.CulledCount(), count - culler.VisibleCount());
+}
+
+TEST(FrustumCuller, MatchesScalarReference) {
+	std::mt19937 generator{ 42U };
+	FrustumCuller culler;
+
+	// Counts that are not multiples of the SIMD width
+	for (const std::uint32_t count : { 1U, 7U, 9U, 1000U, 10001U }) {
+		const float eye[3U]{ TestUtils::RandF(generator, -50.0f, 50.0f), TestUtils::RandF(generator, -50.0f, 50.0f), TestUtils::RandF(generator, -50.0f, 50.0f) };
+		const float target[3U]{ TestUtils::RandF(generator, -50.0f, 50.0f), TestUtils::RandF(generator, -50.0f, 50.0f), TestUtils::RandF(generator, -50.0f, 50.0f) };
+		float viewProj[16U];
+		TestUtils::LookAtPerspective(eye, target, sPi * 0.25f, 16.0f / 9.0f, 0.1f, 80.0f, viewProj);
+		culler.SetViewProjection(viewProj);
+
+		std::vector<std::uint32_t> expectedIndices;
+		culler.ResizeSpheres(count);
+		for (std::uint32_t i = 0U; i < count; ++i) {
+			const float center[3U]{ TestUtils::RandF(generator, -100.0f, 100.0f), TestUtils::RandF(generator, -100.0f, 100.0f), TestUtils::RandF(generator, -100.0f, 100.0f) };
+			const float radius{ TestUtils::RandF(generator, 0.0f, 5.0f) };
+			culler.SetSphere(i, center, radius);
+			if (IsSphereVisible(culler.Planes(), center, radius)) {
+				expectedIndices.push_back(i);
+			}
+		}
+
+		std::vector<std::uint32_t> visibleIndices;
+		EXPECT_EQ(culler.Cull(visibleIndices), static_cast<std::uint32_t>(expectedIndices.size()));
+		EXPECT_EQ(visibleIndices, expectedIndices) << "count " << count;
+	}
+}
+
+TEST(FrustumCuller, ResizeSpheres) {
+	FrustumCuller culler;
+	SetDefaultCamera(culler);
+
+	const float center[3U]{ 0.0f, 0.0f, 10.0f };
+	culler.ResizeSpheres(10U);
+	for (std::uint32_t i = 0U; i < 10U; ++i) {
+		culler.SetSphere(i, center, 1.0f);
+	}
+
+	std::vector<std::uint32_t> visibleIndices;
+	EXPECT_EQ(culler.Cull(visibleIndices), 10U);
+
+	// Removed spheres become padding, and new spheres are not visible until they are set
+	culler.ResizeSpheres(3U);
+	EXPECT_EQ(culler.Cull(visibleIndices), 3U);
+	culler.ResizeSpheres(12U);
+	EXPECT_EQ(culler.Cull(visibleIndices), 3U);
+	EXPECT_EQ(culler.CulledCount(), 9U);
+	culler.SetSphere(11U, center, 1.0f);
+	culler.Cull(visibleIndices);
+	EXPECT_EQ(visibleIndices, (std::vector<std::uint32_t>{ 0U, 1U, 2U, 11U }));
+
+	culler.ResizeSpheres(0U);
+	EXPECT_EQ(culler.Cull(visibleIndices), 0U);
+	EXPECT_TRUE(visibleIndices.empty());
+}
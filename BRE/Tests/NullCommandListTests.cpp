@@ -0,0 +1,258 @@
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+#include <CommandManager/NullCommandList.h>
+
+namespace {
+	// Objects are only passed through, so any address is a valid object
+	std::uint64_t sObjects[4U];
+	ID3D12PipelineState* const sPipelineState{ reinterpret_cast<ID3D12PipelineState*>(&sObjects[0U]) };
+	ID3D12RootSignature* const sRootSignature{ reinterpret_cast<ID3D12RootSignature*>(&sObjects[1U]) };
+	ID3D12DescriptorHeap* const sDescriptorHeap{ reinterpret_cast<ID3D12DescriptorHeap*>(&sObjects[2U]) };
+	ID3D12Resource* const sResource{ reinterpret_cast<ID3D12Resource*>(&sObjects[3U]) };
+
+	// gtest macros take their arguments by reference, so static members cannot be used
+	const std::uint32_t sIndexFormatR32{ GraphicsCommandList::sIndexFormatR32 };
+	const std::uint32_t sTriangleList{ GraphicsCommandList::sPrimitiveTopologyTriangleList };
+
+	// State a draw needs. Each one can be skipped, to check draws without it are invalid.
+	enum DrawState : std::uint32_t {
+		PIPELINE_STATE = 0U,
+		ROOT_SIGNATURE,
+		PRIMITIVE_TOPOLOGY,
+		VERTEX_BUFFER,
+		INDEX_BUFFER,
+		VIEWPORT,
+		SCISSOR_RECT,
+		RENDER_TARGETS,
+		DRAW_STATE_COUNT
+	};
+
+	void SetDrawState(GraphicsCommandList& cmdList, const std::uint32_t skippedState = DRAW_STATE_COUNT) {
+		if (skippedState != PIPELINE_STATE) {
+			cmdList.SetPipelineState(sPipelineState);
+		}
+		if (skippedState != ROOT_SIGNATURE) {
+			cmdList.SetGraphicsRootSignature(sRootSignature);
+		}
+		if (skippedState != PRIMITIVE_TOPOLOGY) {
+			cmdList.IASetPrimitiveTopology(sTriangleList);
+		}
+		if (skippedState != VERTEX_BUFFER) {
+			GraphicsCommandList::VertexBufferView view;
+			view.mBufferLocation = 0x10000UL;
+			view.mSizeInBytes = 4096U;
+			view.mStrideInBytes = 32U;
+			cmdList.IASetVertexBuffers(0U, 1U, &view);
+		}
+		if (skippedState != INDEX_BUFFER) {
+			GraphicsCommandList::IndexBufferView view;
+			view.mBufferLocation = 0x20000UL;
+			view.mSizeInBytes = 1024U;
+			view.mFormat = sIndexFormatR32;
+			cmdList.IASetIndexBuffer(&view);
+		}
+		if (skippedState != VIEWPORT) {
+			GraphicsCommandList::Viewport viewport;
+			viewport.mWidth = 1920.0f;
+			viewport.mHeight = 1080.0f;
+			viewport.mMaxDepth = 1.0f;
+			cmdList.RSSetViewports(1U, &viewport);
+		}
+		if (skippedState != SCISSOR_RECT) {
+			GraphicsCommandList::Rect rect;
+			rect.mRight = 1920;
+			rect.mBottom = 1080;
+			cmdList.RSSetScissorRects(1U, &rect);
+		}
+		if (skippedState != RENDER_TARGETS) {
+			GraphicsCommandList::CpuDescriptorHandle renderTargets[2U];
+			renderTargets[0U].mPtr = 0x100UL;
+			renderTargets[1U].mPtr = 0x200UL;
+			GraphicsCommandList::CpuDescriptorHandle depthStencil;
+			depthStencil.mPtr = 0x300UL;
+			cmdList.OMSetRenderTargets(2U, renderTargets, false, &depthStencil);
+		}
+	}
+}
+
+TEST(NullCommandList, ValidDraws) {
+	NullCommandList cmdList;
+	SetDrawState(cmdList);
+	cmdList.DrawIndexedInstanced(36U, 10U, 0U, 0, 0U);
+	cmdList.DrawIndexedInstanced(6U, 1U, 36U, -4, 10U);
+
+	EXPECT_EQ(cmdList.InvalidCommandCount(), 0U);
+	EXPECT_EQ(cmdList.Commands().size(), DRAW_STATE_COUNT + 2UL);
+	EXPECT_EQ(cmdList.CommandCount(NullCommandList::DRAW_INDEXED_INSTANCED), 2U);
+	EXPECT_EQ(cmdList.CommandCount(NullCommandList::SET_PIPELINE_STATE), 1U);
+	EXPECT_EQ(cmdList.CommandCount(NullCommandList::SET_ROOT_CONSTANT), 0U);
+	EXPECT_EQ(cmdList.DrawnIndexCount(), 36UL * 10UL + 6UL);
+	EXPECT_EQ(cmdList.DrawnInstanceCount(), 11UL);
+
+	// Draw arguments are stored as they were recorded
+	const NullCommandList::Command& draw(cmdList.Commands().back());
+	EXPECT_EQ(draw.mType, NullCommandList::DRAW_INDEXED_INSTANCED);
+	EXPECT_EQ(draw.mValues[0U], 6U);
+	EXPECT_EQ(draw.mValues[1U], 1U);
+	EXPECT_EQ(draw.mValues[2U], 36U);
+	EXPECT_EQ(static_cast<std::int32_t>(draw.mValues[3U]), -4);
+	EXPECT_EQ(draw.mValues[4U], 10U);
+}
+
+// A draw is invalid if any of the state it needs was not set
+TEST(NullCommandList, DrawsNeedAllState) {
+	for (std::uint32_t skippedState = 0U; skippedState < DRAW_STATE_COUNT; ++skippedState) {
+		NullCommandList cmdList;
+		SetDrawState(cmdList, skippedState);
+		EXPECT_EQ(cmdList.InvalidCommandCount(), 0U) << skippedState;
+
+		cmdList.DrawIndexedInstanced(36U, 1U, 0U, 0, 0U);
+		EXPECT_EQ(cmdList.InvalidCommandCount(), 1U) << skippedState;
+
+		// Invalid commands are still stored and counted
+		EXPECT_EQ(cmdList.CommandCount(NullCommandList::DRAW_INDEXED_INSTANCED), 1U);
+	}
+
+	// Empty draws
+	NullCommandList cmdList;
+	SetDrawState(cmdList);
+	cmdList.DrawIndexedInstanced(0U, 1U, 0U, 0, 0U);
+	cmdList.DrawIndexedInstanced(36U, 0U, 0U, 0, 0U);
+	EXPECT_EQ(cmdList.InvalidCommandCount(), 2U);
+}
+
+TEST(NullCommandList, RootParameters) {
+	NullCommandList cmdList;
+
+	// Root parameters need a root signature, and descriptor tables need descriptor heaps
+	cmdList.SetGraphicsRootConstantBufferView(0U, 0x1000UL);
+	EXPECT_EQ(cmdList.InvalidCommandCount(), 1U);
+	cmdList.SetGraphicsRootSignature(sRootSignature);
+	cmdList.SetGraphicsRootConstantBufferView(0U, 0x1000UL);
+	cmdList.SetGraphicsRootShaderResourceView(1U, 0x2000UL);
+	cmdList.SetGraphicsRoot32BitConstant(2U, 7U, 0U);
+	EXPECT_EQ(cmdList.InvalidCommandCount(), 1U);
+	cmdList.SetGraphicsRootDescriptorTable(3U, 0x3000UL);
+	EXPECT_EQ(cmdList.InvalidCommandCount(), 2U);
+	ID3D12DescriptorHeap* heaps[]{ sDescriptorHeap };
+	cmdList.SetDescriptorHeaps(1U, heaps);
+	cmdList.SetGraphicsRootDescriptorTable(3U, 0x3000UL);
+	EXPECT_EQ(cmdList.InvalidCommandCount(), 2U);
+
+	// Out of range indices, null addresses and descriptors
+	cmdList.SetGraphicsRootConstantBufferView(NullCommandList::sMaxRootParameterCount, 0x1000UL);
+	cmdList.SetGraphicsRootShaderResourceView(1U, 0UL);
+	cmdList.SetGraphicsRootDescriptorTable(3U, 0UL);
+	EXPECT_EQ(cmdList.InvalidCommandCount(), 5U);
+
+	// Arguments are stored in commands
+	const std::vector<NullCommandList::Command>& commands(cmdList.Commands());
+	ASSERT_EQ(commands.size(), 11UL);
+	EXPECT_EQ(commands[2U].mType, NullCommandList::SET_ROOT_CONSTANT_BUFFER_VIEW);
+	EXPECT_EQ(commands[2U].mValues[0U], 0U);
+	EXPECT_EQ(commands[2U].mAddress, 0x1000UL);
+	EXPECT_EQ(commands[4U].mType, NullCommandList::SET_ROOT_CONSTANT);
+	EXPECT_EQ(commands[4U].mValues[0U], 2U);
+	EXPECT_EQ(commands[4U].mValues[1U], 7U);
+	EXPECT_EQ(commands[6U].mType, NullCommandList::SET_DESCRIPTOR_HEAPS);
+	EXPECT_EQ(commands[6U].mAddress, reinterpret_cast<std::uint64_t>(sDescriptorHeap));
+	EXPECT_EQ(commands[7U].mAddress, 0x3000UL);
+}
+
+TEST(NullCommandList, InvalidArguments) {
+	NullCommandList cmdList;
+
+	cmdList.SetPipelineState(nullptr);
+	cmdList.SetGraphicsRootSignature(nullptr);
+	EXPECT_EQ(cmdList.InvalidCommandCount(), 2U);
+
+	ID3D12DescriptorHeap* heaps[]{ sDescriptorHeap, sDescriptorHeap, sDescriptorHeap };
+	cmdList.SetDescriptorHeaps(3U, heaps);
+	cmdList.SetDescriptorHeaps(0U, heaps);
+	EXPECT_EQ(cmdList.InvalidCommandCount(), 4U);
+
+	cmdList.IASetPrimitiveTopology(GraphicsCommandList::sPrimitiveTopologyUndefined);
+	EXPECT_EQ(cmdList.InvalidCommandCount(), 5U);
+
+	// Slots out of range, null buffers and 0 strides
+	GraphicsCommandList::VertexBufferView vertexBufferView;
+	vertexBufferView.mBufferLocation = 0x10000UL;
+	vertexBufferView.mStrideInBytes = 32U;
+	cmdList.IASetVertexBuffers(GraphicsCommandList::sMaxVertexBufferCount, 1U, &vertexBufferView);
+	cmdList.IASetVertexBuffers(0U, 1U, nullptr);
+	vertexBufferView.mStrideInBytes = 0U;
+	cmdList.IASetVertexBuffers(0U, 1U, &vertexBufferView);
+	EXPECT_EQ(cmdList.InvalidCommandCount(), 8U);
+
+	// Only 16 and 32 bits indices
+	GraphicsCommandList::IndexBufferView indexBufferView;
+	indexBufferView.mBufferLocation = 0x20000UL;
+	indexBufferView.mFormat = 0U;
+	cmdList.IASetIndexBuffer(&indexBufferView);
+	cmdList.IASetIndexBuffer(nullptr);
+	indexBufferView.mFormat = GraphicsCommandList::sIndexFormatR16;
+	cmdList.IASetIndexBuffer(&indexBufferView);
+	EXPECT_EQ(cmdList.InvalidCommandCount(), 10U);
+
+	GraphicsCommandList::Viewport viewports[GraphicsCommandList::sMaxViewportCount + 1U];
+	GraphicsCommandList::Rect rects[GraphicsCommandList::sMaxViewportCount + 1U];
+	cmdList.RSSetViewports(GraphicsCommandList::sMaxViewportCount + 1U, viewports);
+	cmdList.RSSetScissorRects(GraphicsCommandList::sMaxViewportCount + 1U, rects);
+	cmdList.RSSetViewports(GraphicsCommandList::sMaxViewportCount, viewports);
+	cmdList.RSSetScissorRects(GraphicsCommandList::sMaxViewportCount, rects);
+	EXPECT_EQ(cmdList.InvalidCommandCount(), 12U);
+
+	// Too many render targets, or neither render targets nor depth stencil
+	GraphicsCommandList::CpuDescriptorHandle renderTargets[GraphicsCommandList::sMaxRenderTargetCount + 1U];
+	cmdList.OMSetRenderTargets(GraphicsCommandList::sMaxRenderTargetCount + 1U, renderTargets, false, nullptr);
+	cmdList.OMSetRenderTargets(0U, nullptr, false, nullptr);
+	cmdList.OMSetRenderTargets(0U, nullptr, false, &renderTargets[0U]);
+	EXPECT_EQ(cmdList.InvalidCommandCount(), 14U);
+
+	cmdList.ResourceBarrier(0U, nullptr);
+	EXPECT_EQ(cmdList.InvalidCommandCount(), 15U);
+}
+
+TEST(NullCommandList, TransitionBarriers) {
+	NullCommandList cmdList;
+
+	GraphicsCommandList::Barrier barriers[2U];
+	barriers[0U].mType = GraphicsCommandList::sResourceBarrierTypeTransition;
+	barriers[0U].mResource = sResource;
+	barriers[0U].mStateBefore = 0x80U;
+	barriers[0U].mStateAfter = 0x4U;
+	barriers[1U] = barriers[0U];
+	cmdList.ResourceBarrier(2U, barriers);
+
+	EXPECT_EQ(cmdList.InvalidCommandCount(), 0U);
+	ASSERT_EQ(cmdList.Commands().size(), 1UL);
+	const NullCommandList::Command& command(cmdList.Commands()[0U]);
+	EXPECT_EQ(command.mType, NullCommandList::RESOURCE_BARRIER);
+	EXPECT_EQ(command.mValues[0U], 2U);
+	EXPECT_EQ(command.mValues[2U], 0x80U);
+	EXPECT_EQ(command.mValues[3U], 0x4U);
+	EXPECT_EQ(command.mAddress, reinterpret_cast<std::uint64_t>(sResource));
+}
+
+// Clear() resets commands, counters and state, as a new command list
+TEST(NullCommandList, Clear) {
+	NullCommandList cmdList;
+	SetDrawState(cmdList);
+	cmdList.DrawIndexedInstanced(36U, 2U, 0U, 0, 0U);
+	cmdList.SetPipelineState(nullptr);
+	EXPECT_EQ(cmdList.InvalidCommandCount(), 1U);
+
+	cmdList.Clear();
+	EXPECT_TRUE(cmdList.Commands().empty());
+	EXPECT_EQ(cmdList.InvalidCommandCount(), 0U);
+	EXPECT_EQ(cmdList.DrawnIndexCount(), 0UL);
+	EXPECT_EQ(cmdList.DrawnInstanceCount(), 0UL);
+	for (std::uint32_t i = 0U; i < NullCommandList::COMMAND_TYPE_COUNT; ++i) {
+		EXPECT_EQ(cmdList.CommandCount(static_cast<NullCommandList::CommandType>(i)), 0U);
+	}
+
+	cmdList.DrawIndexedInstanced(36U, 2U, 0U, 0, 0U);
+	EXPECT_EQ(cmdList.InvalidCommandCount(), 1U);
+}
@@ -0,0 +1,313 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <OcclusionCulling/OcclusionCuller.h>
+#include <Tests/TestUtils.h>
+
+namespace {
+	const float sPi{ 3.14159265f };
+	const std::uint32_t sWidth{ 320U };
+	const std::uint32_t sHeight{ 192U };
+	const float sIdentity[16U]{
+		1.0f, 0.0f, 0.0f, 0.0f,
+		0.0f, 1.0f, 0.0f, 0.0f,
+		0.0f, 0.0f, 1.0f, 0.0f,
+		0.0f, 0.0f, 0.0f, 1.0f };
+
+	// Camera at the origin looking at +z
+	void CameraViewProj(float viewProj[16U]) {
+		const float eye[3U]{ 0.0f, 0.0f, 0.0f };
+		const float target[3U]{ 0.0f, 0.0f, 1.0f };
+		TestUtils::LookAtPerspective(eye, target, sPi / 3.0f, static_cast<float>(sWidth) / static_cast<float>(sHeight), 0.5f, 100.0f, viewProj);
+	}
+
+	// Appends a quad facing -z, centered at (x, y, z)
+	void AddQuad(const float x, const float y, const float z, const float halfWidth, const float halfHeight, OccluderMesh& mesh) {
+		const std::uint32_t base{ static_cast<std::uint32_t>(mesh.mPositions.size() / 3UL) };
+		const float positions[]{
+			x - halfWidth, y - halfHeight, z,
+			x - halfWidth, y + halfHeight, z,
+			x + halfWidth, y + halfHeight, z,
+			x + halfWidth, y - halfHeight, z };
+		mesh.mPositions.insert(mesh.mPositions.end(), std::begin(positions), std::end(positions));
+		const std::uint32_t indices[]{ base, base + 1U, base + 2U, base, base + 2U, base + 3U };
+		mesh.mIndices.insert(mesh.mIndices.end(), std::begin(indices), std::end(indices));
+	}
+
+	// Random triangles in front of the camera, with both windings
+	OccluderMesh RandomTriangles(std::mt19937& generator, const std::uint32_t triangleCount) {
+		OccluderMesh mesh;
+		for (std::uint32_t i = 0U; i < triangleCount * 3U; ++i) {
+			const float z{ TestUtils::RandF(generator, 2.0f, 60.0f) };
+			mesh.mPositions.push_back(TestUtils::RandF(generator, -z, z));
+			mesh.mPositions.push_back(TestUtils::RandF(generator, -z, z) * 0.6f);
+			mesh.mPositions.push_back(z);
+			mesh.mIndices.push_back(i);
+		}
+
+		return mesh;
+	}
+
+	std::vector<float> Rasterize(const OccluderMesh& mesh, const OcclusionCuller::Kernel kernel) {
+		float viewProj[16U];
+		CameraViewProj(viewProj);
+		OcclusionCuller culler(sWidth, sHeight);
+		culler.SetKernel(kernel);
+		culler.BeginFrame(viewProj);
+		culler.RasterizeOccluder(mesh, sIdentity);
+		culler.EndFrame();
+		return culler.DepthBuffer();
+	}
+
+	// Double sided ray triangle test (Moller-Trumbore) for origin + t * direction, with t in (0, maxT)
+	bool IntersectsTriangle(const float origin[3U], const float direction[3U], const float maxT, const float* v0, const float* v1, const float* v2) {
+		const float e1[3U]{ v1[0U] - v0[0U], v1[1U] - v0[1U], v1[2U] - v0[2U] };
+		const float e2[3U]{ v2[0U] - v0[0U], v2[1U] - v0[1U], v2[2U] - v0[2U] };
+		const float p[3U]{
+			direction[1U] * e2[2U] - direction[2U] * e2[1U],
+			direction[2U] * e2[0U] - direction[0U] * e2[2U],
+			direction[0U] * e2[1U] - direction[1U] * e2[0U] };
+		const float det{ e1[0U] * p[0U] + e1[1U] * p[1U] + e1[2U] * p[2U] };
+		if (std::fabs(det) < 1.0e-8f) {
+			return false;
+		}
+
+		const float invDet{ 1.0f / det };
+		const float s[3U]{ origin[0U] - v0[0U], origin[1U] - v0[1U], origin[2U] - v0[2U] };
+		const float u{ (s[0U] * p[0U] + s[1U] * p[1U] + s[2U] * p[2U]) * invDet };
+		if (u < 0.0f || u > 1.0f) {
+			return false;
+		}
+
+		const float q[3U]{ s[1U] * e1[2U] - s[2U] * e1[1U], s[2U] * e1[0U] - s[0U] * e1[2U], s[0U] * e1[1U] - s[1U] * e1[0U] };
+		const float v{ (direction[0U] * q[0U] + direction[1U] * q[1U] + direction[2U] * q[2U]) * invDet };
+		if (v < 0.0f || u + v > 1.0f) {
+			return false;
+		}
+
+		const float t{ (e2[0U] * q[0U] + e2[1U] * q[1U] + e2[2U] * q[2U]) * invDet };
+		return t > 0.0f && t < maxT;
+	}
+
+	// Ground truth: a point is visible if it is inside the frustum and the segment
+	// from the eye (at the origin) to it does not cross any occluder triangle.
+	bool IsPointVisible(const float point[3U], const float viewProj[16U], const OccluderMesh& occluders) {
+		float clip[3U];
+		const float w{ TestUtils::TransformPoint(point, viewProj, clip) };
+		if (w <= 0.0f || std::fabs(clip[0U]) > w || std::fabs(clip[1U]) > w || clip[2U] < 0.0f || clip[2U] > w) {
+			return false;
+		}
+
+		const float origin[3U]{ 0.0f, 0.0f, 0.0f };
+		for (std::size_t i = 0UL; i < occluders.mIndices.size(); i += 3UL) {
+			if (IntersectsTriangle(
+				origin,
+				point,
+				1.0f - 1.0e-4f,
+				&occluders.mPositions[occluders.mIndices[i] * 3UL],
+				&occluders.mPositions[occluders.mIndices[i + 1UL] * 3UL],
+				&occluders.mPositions[occluders.mIndices[i + 2UL] * 3UL])) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	// Samples a grid of points on each box face
+	bool IsBoxVisible(const Aabb& box, const float viewProj[16U], const OccluderMesh& occluders) {
+		const std::uint32_t samples{ 6U };
+		for (std::uint32_t axis = 0U; axis < 3U; ++axis) {
+			const std::uint32_t u{ (axis + 1U) % 3U };
+			const std::uint32_t v{ (axis + 2U) % 3U };
+			for (const float side : { box.mMin[axis], box.mMax[axis] }) {
+				for (std::uint32_t i = 0U; i <= samples; ++i) {
+					for (std::uint32_t j = 0U; j <= samples; ++j) {
+						float point[3U];
+						point[axis] = side;
+						point[u] = box.mMin[u] + (box.mMax[u] - box.mMin[u]) * static_cast<float>(i) / static_cast<float>(samples);
+						point[v] = box.mMin[v] + (box.mMax[v] - box.mMin[v]) * static_cast<float>(j) / static_cast<float>(samples);
+						if (IsPointVisible(point, viewProj, occluders)) {
+							return true;
+						}
+					}
+				}
+			}
+		}
+
+		return false;
+	}
+
+	Aabb Box(const float x, const float y, const float z, const float halfSize) {
+		return Aabb{ { x - halfSize, y - halfSize, z - halfSize }, { x + halfSize, y + halfSize, z + halfSize } };
+	}
+}
+
+TEST(OcclusionCuller, KernelsMatchScalar) {
+	std::mt19937 generator{ 1U };
+	for (std::uint32_t iteration = 0U; iteration < 10U; ++iteration) {
+		const OccluderMesh mesh{ RandomTriangles(generator, 50U) };
+		const std::vector<float> scalarDepth{ Rasterize(mesh, OcclusionCuller::SCALAR) };
+		for (std::uint32_t kernel = OcclusionCuller::SSE2; kernel <= OcclusionCuller::WidestKernel(); ++kernel) {
+			const std::vector<float> depth{ Rasterize(mesh, static_cast<OcclusionCuller::Kernel>(kernel)) };
+			if (kernel != OcclusionCuller::AVX2) {
+				// Same operations in the same order
+				EXPECT_EQ(depth, scalarDepth) << "kernel " << kernel;
+				continue;
+			}
+
+			// Fused multiply-adds only change coverage of pixels whose center is on an edge,
+			// and depth within rounding errors.
+			std::uint32_t coveredCount{ 0U };
+			std::uint32_t coverageMismatchCount{ 0U };
+			for (std::size_t i = 0UL; i < depth.size(); ++i) {
+				coveredCount += scalarDepth[i] < 1.0f ? 1U : 0U;
+				if (std::fabs(depth[i] - scalarDepth[i]) > 1.0e-5f) {
+					++coverageMismatchCount;
+				}
+			}
+			EXPECT_LE(coverageMismatchCount * 1000U, coveredCount) << "kernel " << kernel;
+		}
+	}
+}
+
+TEST(OcclusionCuller, SetKernel) {
+	OcclusionCuller culler(sWidth, sHeight);
+	EXPECT_EQ(culler.GetKernel(), OcclusionCuller::WidestKernel());
+	culler.SetKernel(OcclusionCuller::SCALAR);
+	EXPECT_EQ(culler.GetKernel(), OcclusionCuller::SCALAR);
+}
+
+// Pixel centers on the diagonal of a quad (square on screen) must be covered by one of its triangles
+TEST(OcclusionCuller, SharedEdgesAreWatertight) {
+	OccluderMesh quad;
+	AddQuad(0.0f, 0.0f, 10.0f, 2.0f, 2.0f, quad);
+	for (std::uint32_t kernel = OcclusionCuller::SCALAR; kernel <= OcclusionCuller::WidestKernel(); ++kernel) {
+		const std::vector<float> depth{ Rasterize(quad, static_cast<OcclusionCuller::Kernel>(kernel)) };
+		for (std::uint32_t y = sHeight / 2U - 30U; y < sHeight / 2U + 30U; ++y) {
+			for (std::uint32_t x = sWidth / 2U - 30U; x < sWidth / 2U + 30U; ++x) {
+				ASSERT_LT(depth[y * sWidth + x], 1.0f) << "kernel " << kernel << ", pixel " << x << " " << y;
+			}
+		}
+	}
+}
+
+TEST(OcclusionCuller, WallOccludesBoxesBehindIt) {
+	float viewProj[16U];
+	CameraViewProj(viewProj);
+	OccluderMesh wall;
+	AddQuad(0.0f, 0.0f, 10.0f, 100.0f, 100.0f, wall);
+
+	OcclusionCuller culler(sWidth, sHeight);
+	culler.BeginFrame(viewProj);
+	culler.RasterizeOccluder(wall, sIdentity);
+	culler.EndFrame();
+	EXPECT_EQ(culler.RasterizedTriangleCount(), 2U);
+
+	EXPECT_FALSE(culler.IsVisible(Box(0.0f, 0.0f, 20.0f, 1.0f)));
+	EXPECT_FALSE(culler.IsVisible(Box(5.0f, -3.0f, 50.0f, 4.0f)));
+	EXPECT_TRUE(culler.IsVisible(Box(0.0f, 0.0f, 5.0f, 1.0f)));
+	EXPECT_TRUE(culler.IsVisible(Box(0.0f, 0.0f, 10.0f, 1.0f)));
+
+	// Crosses the near plane, and outside the screen
+	EXPECT_TRUE(culler.IsVisible(Box(0.0f, 0.0f, 0.0f, 1.0f)));
+	EXPECT_TRUE(culler.IsVisible(Box(0.0f, 0.0f, -20.0f, 1.0f)));
+	EXPECT_TRUE(culler.IsVisible(Box(200.0f, 0.0f, 20.0f, 1.0f)));
+}
+
+TEST(OcclusionCuller, BoxPeekingAroundOccluderIsVisible) {
+	float viewProj[16U];
+	CameraViewProj(viewProj);
+	OccluderMesh occluder;
+	AddQuad(0.0f, 0.0f, 10.0f, 2.0f, 2.0f, occluder);
+
+	OcclusionCuller culler(sWidth, sHeight);
+	culler.BeginFrame(viewProj);
+	culler.RasterizeOccluder(occluder, sIdentity);
+	culler.EndFrame();
+
+	// Boxes behind it are hidden only if they are inside its projection
+	EXPECT_FALSE(culler.IsVisible(Box(0.0f, 0.0f, 20.0f, 2.0f)));
+	EXPECT_TRUE(culler.IsVisible(Box(0.0f, 0.0f, 20.0f, 5.0f)));
+	EXPECT_TRUE(culler.IsVisible(Box(4.5f, 0.0f, 20.0f, 1.0f)));
+}
+
+// Occlusion must be conservative: boxes with a visible point must never be culled
+TEST(OcclusionCuller, ConservativeAgainstRayCasting) {
+	std::mt19937 generator{ 2U };
+	float viewProj[16U];
+	CameraViewProj(viewProj);
+
+	for (std::uint32_t kernel = OcclusionCuller::SCALAR; kernel <= OcclusionCuller::WidestKernel(); ++kernel) {
+		std::uint32_t culledCount{ 0U };
+		for (std::uint32_t scene = 0U; scene < 4U; ++scene) {
+			OccluderMesh occluders;
+			for (std::uint32_t i = 0U; i < 6U; ++i) {
+				AddQuad(
+					TestUtils::RandF(generator, -10.0f, 10.0f),
+					TestUtils::RandF(generator, -6.0f, 6.0f),
+					TestUtils::RandF(generator, 8.0f, 30.0f),
+					TestUtils::RandF(generator, 2.0f, 8.0f),
+					TestUtils::RandF(generator, 2.0f, 8.0f),
+					occluders);
+			}
+
+			OcclusionCuller culler(sWidth, sHeight);
+			culler.SetKernel(static_cast<OcclusionCuller::Kernel>(kernel));
+			culler.BeginFrame(viewProj);
+			culler.RasterizeOccluder(occluders, sIdentity);
+			culler.EndFrame();
+
+			for (std::uint32_t i = 0U; i < 300U; ++i) {
+				const Aabb box{ Box(
+					TestUtils::RandF(generator, -20.0f, 20.0f),
+					TestUtils::RandF(generator, -12.0f, 12.0f),
+					TestUtils::RandF(generator, 10.0f, 60.0f),
+					TestUtils::RandF(generator, 0.25f, 2.0f)) };
+				if (culler.IsVisible(box) == false) {
+					EXPECT_FALSE(IsBoxVisible(box, viewProj, occluders)) << "kernel " << kernel << ", box " << i;
+					++culledCount;
+				}
+			}
+		}
+
+		// Occluders cover a good part of the screen, so some boxes must be culled
+		EXPECT_GT(culledCount, 100U) << "kernel " << kernel;
+	}
+}
+
+TEST(OcclusionCuller, SelectOccluders) {
+	OccluderMesh small;
+	AddQuad(0.0f, 0.0f, 0.0f, 1.0f, 1.0f, small);
+	OccluderMesh big;
+	for (std::uint32_t i = 0U; i < 4U; ++i) {
+		AddQuad(0.0f, 0.0f, static_cast<float>(i), 1.0f, 1.0f, big);
+	}
+
+	// Estimated screen sizes: 2 > 0 > 3 > 1
+	const float eye[3U]{ 0.0f, 0.0f, 0.0f };
+	const OccluderInstance candidates[]{
+		{ &small, sIdentity, { 0.0f, 0.0f, 10.0f }, 2.0f },
+		{ &big, sIdentity, { 0.0f, 0.0f, 40.0f }, 2.0f },
+		{ &big, sIdentity, { 0.0f, 0.0f, 5.0f }, 3.0f },
+		{ &small, sIdentity, { 0.0f, 20.0f, 0.0f }, 2.0f } };
+
+	std::vector<std::uint32_t> selected;
+	OcclusionCuller::SelectOccluders(candidates, 4U, eye, 100U, selected);
+	EXPECT_EQ(selected, (std::vector<std::uint32_t>{ 2U, 0U, 3U, 1U }));
+
+	// Candidates that do not fit in the budget are skipped, but smaller ones are still taken
+	OcclusionCuller::SelectOccluders(candidates, 4U, eye, 12U, selected);
+	EXPECT_EQ(selected, (std::vector<std::uint32_t>{ 2U, 0U, 3U }));
+	OcclusionCuller::SelectOccluders(candidates, 4U, eye, 5U, selected);
+	EXPECT_EQ(selected, (std::vector<std::uint32_t>{ 0U, 3U }));
+
+	OcclusionCuller::SelectOccluders(candidates, 0U, eye, 100U, selected);
+	EXPECT_TRUE(selected.empty());
+}
@@ -0,0 +1,119 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <PSOManager/PSOCacheIndex.h>
+
+namespace {
+	// gtest macros take their arguments by reference, so static members cannot be used
+	const std::uint32_t sInvalidEntry{ PSOCacheIndex::sInvalidEntry };
+
+	// Cache file with a library of librarySize bytes
+	std::vector<std::uint8_t> CacheFile(const std::size_t librarySize) {
+		PSOCacheIndex::FileHeader header;
+		header.mDataSize = librarySize;
+		std::vector<std::uint8_t> file(sizeof(header) + librarySize, 0xABU);
+		memcpy(file.data(), &header, sizeof(header));
+		return file;
+	}
+}
+
+TEST(PSOCacheIndex, Empty) {
+	PSOCacheIndex index;
+	EXPECT_EQ(index.EntryCount(), 0U);
+	EXPECT_EQ(index.Find(42ULL), sInvalidEntry);
+	EXPECT_FALSE(index.HasUnstoredEntries());
+}
+
+// First run: every pipeline misses and is compiled. Identical descriptions hit in memory.
+TEST(PSOCacheIndex, ColdStart) {
+	PSOCacheIndex index;
+	const std::uint64_t keys[]{ 0x1111ULL, 0x2222ULL, 0x3333ULL };
+	bool isNew{ false };
+	for (std::uint32_t i = 0U; i < 3U; ++i) {
+		EXPECT_EQ(index.Acquire(keys[i], isNew), i);
+		ASSERT_TRUE(isNew);
+		index.RecordLoad(i, false);
+	}
+
+	EXPECT_EQ(index.Acquire(keys[1U], isNew), 1U);
+	EXPECT_FALSE(isNew);
+	EXPECT_EQ(index.Acquire(keys[1U], isNew), 1U);
+	EXPECT_FALSE(isNew);
+
+	EXPECT_EQ(index.EntryCount(), 3U);
+	EXPECT_EQ(index.EntryKey(2U), keys[2U]);
+	EXPECT_EQ(index.Find(keys[0U]), 0U);
+	EXPECT_EQ(index.MemoryHitCount(), 2U);
+	EXPECT_EQ(index.LibraryHitCount(), 0U);
+	EXPECT_EQ(index.CompileCount(), 3U);
+
+	// Compiled pipelines must be stored once
+	EXPECT_TRUE(index.HasUnstoredEntries());
+	index.MarkStored();
+	EXPECT_FALSE(index.HasUnstoredEntries());
+}
+
+// Warm start: pipelines are loaded from the library, and only a new one is compiled
+TEST(PSOCacheIndex, WarmStart) {
+	PSOCacheIndex index;
+	bool isNew{ false };
+	for (std::uint64_t key = 1ULL; key <= 6ULL; ++key) {
+		const std::uint32_t entry{ index.Acquire(key, isNew) };
+		ASSERT_TRUE(isNew);
+		index.RecordLoad(entry, true);
+	}
+	EXPECT_EQ(index.LibraryHitCount(), 6U);
+	EXPECT_EQ(index.CompileCount(), 0U);
+	EXPECT_FALSE(index.HasUnstoredEntries());
+
+	const std::uint32_t entry{ index.Acquire(7ULL, isNew) };
+	ASSERT_TRUE(isNew);
+	index.RecordLoad(entry, false);
+	EXPECT_EQ(index.CompileCount(), 1U);
+	EXPECT_TRUE(index.HasUnstoredEntries());
+}
+
+TEST(PSOCacheIndex, Clear) {
+	PSOCacheIndex index;
+	bool isNew{ false };
+	index.Acquire(5ULL, isNew);
+	index.Clear();
+	EXPECT_EQ(index.EntryCount(), 0U);
+	EXPECT_EQ(index.Find(5ULL), sInvalidEntry);
+	EXPECT_EQ(index.Acquire(5ULL, isNew), 0U);
+	EXPECT_TRUE(isNew);
+}
+
+// Names are the key in hexadecimal, so they are stable across runs
+TEST(PSOCacheIndex, EntryName) {
+	EXPECT_EQ(PSOCacheIndex::EntryName(0ULL), std::wstring(L"PSO_0000000000000000"));
+	EXPECT_EQ(PSOCacheIndex::EntryName(0x0123456789ABCDEFULL), std::wstring(L"PSO_0123456789ABCDEF"));
+	EXPECT_EQ(PSOCacheIndex::EntryName(0xFFFFFFFFFFFFFFFFULL), std::wstring(L"PSO_FFFFFFFFFFFFFFFF"));
+}
+
+TEST(PSOCacheIndex, ValidateFile) {
+	std::size_t librarySize{ 0UL };
+	std::vector<std::uint8_t> file{ CacheFile(100UL) };
+	EXPECT_TRUE(PSOCacheIndex::ValidateFile(file.data(), file.size(), librarySize));
+	EXPECT_EQ(librarySize, 100UL);
+
+	// Truncated file, or header only
+	EXPECT_FALSE(PSOCacheIndex::ValidateFile(file.data(), file.size() - 1UL, librarySize));
+	EXPECT_EQ(librarySize, 0UL);
+	EXPECT_FALSE(PSOCacheIndex::ValidateFile(file.data(), sizeof(PSOCacheIndex::FileHeader) - 1UL, librarySize));
+	const std::vector<std::uint8_t> emptyLibraryFile{ CacheFile(0UL) };
+	EXPECT_FALSE(PSOCacheIndex::ValidateFile(emptyLibraryFile.data(), emptyLibraryFile.size(), librarySize));
+	EXPECT_FALSE(PSOCacheIndex::ValidateFile(nullptr, 0UL, librarySize));
+
+	// Other file, or an older version
+	file[0U] ^= 0xFFU;
+	EXPECT_FALSE(PSOCacheIndex::ValidateFile(file.data(), file.size(), librarySize));
+	file = CacheFile(100UL);
+	++file[offsetof(PSOCacheIndex::FileHeader, mVersion)];
+	EXPECT_FALSE(PSOCacheIndex::ValidateFile(file.data(), file.size(), librarySize));
+}
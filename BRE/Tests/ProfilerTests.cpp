@@ -0,0 +1,210 @@
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <Utils/Profiler.h>
+
+namespace {
+	// gtest macros take their arguments by reference, so static members cannot be used
+	const std::uint32_t sEventCountPerThread{ Profiler::sEventCountPerThread };
+
+	// Trace event, parsed from its line (WriteTrace() writes an event per line)
+	struct TraceEvent {
+		std::string mName;
+		std::string mPhase;
+		std::uint32_t mThread{ 0U };
+		double mBegin{ 0.0 };
+		double mDuration{ 0.0 };
+		std::uint32_t mDepth{ 0U };
+		std::string mThreadName;
+	};
+
+	// Returns the text after "key": until the next delimiter (without quotes)
+	std::string Value(const std::string& line, const char* key) {
+		const std::string pattern{ std::string("\"") + key + "\":" };
+		std::size_t begin{ line.find(pattern) };
+		if (begin == std::string::npos) {
+			return std::string();
+		}
+
+		begin += pattern.size();
+		if (line[begin] == '"') {
+			++begin;
+			return line.substr(begin, line.find('"', begin) - begin);
+		}
+
+		return line.substr(begin, line.find_first_of(",}", begin) - begin);
+	}
+
+	std::vector<TraceEvent> WriteAndParseTrace(const char* name) {
+		const std::string path{ std::string(BRE_TEST_FILES_PATH) + name };
+		std::vector<TraceEvent> events;
+		EXPECT_TRUE(Profiler::WriteTrace(path.c_str()));
+
+		std::ifstream file(path);
+		std::string line;
+		std::getline(file, line);
+		EXPECT_EQ(line, "{\"traceEvents\":[");
+		while (std::getline(file, line) && line != "]}") {
+			TraceEvent event;
+			event.mName = Value(line, "name");
+			event.mPhase = Value(line, "ph");
+			event.mThread = static_cast<std::uint32_t>(std::stoul(Value(line, "tid")));
+			if (event.mPhase == "M") {
+				event.mThreadName = Value(line.substr(line.find("\"args\"")), "name");
+			}
+			else {
+				event.mBegin = std::atof(Value(line, "ts").c_str());
+			}
+			if (event.mPhase == "X") {
+				event.mDuration = std::atof(Value(line, "dur").c_str());
+				event.mDepth = static_cast<std::uint32_t>(std::stoul(Value(line, "depth")));
+			}
+			events.push_back(event);
+		}
+		EXPECT_EQ(line, "]}");
+
+		return events;
+	}
+
+	// Events of the thread track with the given name
+	std::vector<TraceEvent> ThreadEvents(const std::vector<TraceEvent>& events, const char* threadName) {
+		std::uint32_t thread{ 0xFFFFFFFFU };
+		for (const TraceEvent& event : events) {
+			if (event.mPhase == "M" && event.mThreadName == threadName) {
+				thread = event.mThread;
+			}
+		}
+
+		std::vector<TraceEvent> threadEvents;
+		for (const TraceEvent& event : events) {
+			if (event.mPhase != "M" && event.mThread == thread) {
+				threadEvents.push_back(event);
+			}
+		}
+
+		return threadEvents;
+	}
+
+	void BusyWait(const std::uint64_t nanoseconds) {
+		const std::uint64_t end{ Profiler::Now() + nanoseconds };
+		while (Profiler::Now() < end) {
+		}
+	}
+}
+
+// Zones are recorded when they end, with their depth, and children are inside their parents
+TEST(Profiler, NestedZones) {
+	const std::uint32_t threadCount{ Profiler::ThreadCount() };
+	const std::uint32_t frameCount{ Profiler::FrameCount() };
+
+	// A new thread, so its track only has these events
+	std::thread thread([]() {
+		PROFILE_THREAD("NestedZonesThread");
+		{
+			PROFILE_ZONE("Outer");
+			BusyWait(10000UL);
+			{
+				PROFILE_ZONE("Inner");
+				{
+					PROFILE_ZONE("Innermost");
+					BusyWait(10000UL);
+				}
+				BusyWait(10000UL);
+			}
+			BusyWait(10000UL);
+		}
+		PROFILE_FRAME();
+	});
+	thread.join();
+	EXPECT_EQ(Profiler::ThreadCount(), threadCount + 1U);
+	EXPECT_EQ(Profiler::FrameCount(), frameCount + 1U);
+
+	const std::vector<TraceEvent> events{ ThreadEvents(WriteAndParseTrace("ProfilerNestedZones.json"), "NestedZonesThread") };
+	ASSERT_EQ(events.size(), 4UL);
+	const TraceEvent& innermost(events[0U]);
+	const TraceEvent& inner(events[1U]);
+	const TraceEvent& outer(events[2U]);
+	EXPECT_EQ(innermost.mName, "Innermost");
+	EXPECT_EQ(inner.mName, "Inner");
+	EXPECT_EQ(outer.mName, "Outer");
+	EXPECT_EQ(innermost.mDepth, 2U);
+	EXPECT_EQ(inner.mDepth, 1U);
+	EXPECT_EQ(outer.mDepth, 0U);
+	EXPECT_EQ(events[3U].mName, "Frame");
+	EXPECT_EQ(events[3U].mPhase, "i");
+
+	// Busy waits are 10 microseconds
+	EXPECT_GE(innermost.mDuration, 10.0);
+	EXPECT_GE(inner.mDuration, 20.0);
+	EXPECT_GE(outer.mDuration, 40.0);
+	EXPECT_LE(outer.mBegin, inner.mBegin);
+	EXPECT_LE(inner.mBegin, innermost.mBegin);
+	EXPECT_LE(innermost.mBegin + innermost.mDuration, inner.mBegin + inner.mDuration + 0.001);
+	EXPECT_LE(inner.mBegin + inner.mDuration, outer.mBegin + outer.mDuration + 0.001);
+	EXPECT_LE(outer.mBegin + outer.mDuration, events[3U].mBegin + 0.001);
+}
+
+// Only the last sEventCountPerThread events of a thread are kept
+TEST(Profiler, EventRing) {
+	const std::uint32_t zoneCount{ Profiler::sEventCountPerThread + 100U };
+	std::thread thread([zoneCount]() {
+		PROFILE_THREAD("EventRingThread");
+		for (std::uint32_t i = 0U; i < zoneCount; ++i) {
+			PROFILE_ZONE(i < 100U ? "Overwritten" : "Kept");
+		}
+	});
+	thread.join();
+
+	const std::vector<TraceEvent> events{ ThreadEvents(WriteAndParseTrace("ProfilerEventRing.json"), "EventRingThread") };
+	ASSERT_EQ(events.size(), sEventCountPerThread);
+	for (std::uint32_t i = 0U; i < events.size(); ++i) {
+		ASSERT_EQ(events[i].mName, "Kept") << "event " << i;
+		if (i > 0U) {
+			ASSERT_LE(events[i - 1U].mBegin, events[i].mBegin) << "event " << i;
+		}
+	}
+}
+
+// Traces written while other threads record events are well formed
+TEST(Profiler, WriteWhileRecording) {
+	std::atomic<bool> stop{ false };
+	std::vector<std::thread> threads;
+	for (std::uint32_t i = 0U; i < 3U; ++i) {
+		threads.emplace_back([&stop]() {
+			while (stop == false) {
+				PROFILE_ZONE("Recording");
+				PROFILE_ZONE("RecordingChild");
+			}
+		});
+	}
+
+	std::vector<std::vector<TraceEvent>> traces;
+	for (std::uint32_t i = 0U; i < 5U; ++i) {
+		traces.push_back(WriteAndParseTrace("ProfilerWriteWhileRecording.json"));
+	}
+
+	// Threads are joined before checking traces, so a failed assertion does not leave them running
+	stop = true;
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+
+	for (const std::vector<TraceEvent>& events : traces) {
+		for (const TraceEvent& event : events) {
+			if (event.mName == "Recording") {
+				ASSERT_EQ(event.mDepth, 0U);
+			}
+			else if (event.mName == "RecordingChild") {
+				ASSERT_EQ(event.mDepth, 1U);
+			}
+			ASSERT_GE(event.mDuration, 0.0);
+		}
+	}
+}
@@ -0,0 +1,194 @@
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <LightingPass/PunctualLightStore.h>
+#include <Tests/TestUtils.h>
+
+namespace {
+	const float sPi{ 3.14159265f };
+
+	struct Camera {
+		float mView[16U];
+		float mProj[16U];
+	};
+
+	Camera RandomCamera(std::mt19937& generator) {
+		const float eye[3U]{ TestUtils::RandF(generator, -50.0f, 50.0f), TestUtils::RandF(generator, -50.0f, 50.0f), TestUtils::RandF(generator, -50.0f, 50.0f) };
+		const float target[3U]{ TestUtils::RandF(generator, -50.0f, 50.0f), TestUtils::RandF(generator, -50.0f, 50.0f), TestUtils::RandF(generator, -50.0f, 50.0f) };
+		Camera camera;
+		TestUtils::LookAt(eye, target, camera.mView);
+		TestUtils::Perspective(sPi * 0.25f, 16.0f / 9.0f, 0.1f, 80.0f, camera.mProj);
+		return camera;
+	}
+
+	std::vector<PunctualLight> RandomLights(std::mt19937& generator, const std::uint32_t count) {
+		std::vector<PunctualLight> lights(count);
+		for (PunctualLight& light : lights) {
+			for (std::uint32_t j = 0U; j < 3U; ++j) {
+				light.mPosAndRange[j] = TestUtils::RandF(generator, -100.0f, 100.0f);
+			}
+			light.mPosAndRange[3U] = TestUtils::RandF(generator, 0.0f, 10.0f);
+			for (float& c : light.mColorAndPower) {
+				c = TestUtils::RandF(generator, 0.0f, 1.0f);
+			}
+		}
+
+		return lights;
+	}
+
+	// Scalar reference: the sphere is transformed to view space and compared against
+	// the clip space planes of the projection (in double precision).
+	// It returns false if the light is too close to a plane to decide.
+	bool IsLightVisible(const PunctualLight& light, const Camera& camera, bool& visible, double viewPosition[3U]) {
+		for (std::uint32_t j = 0U; j < 3U; ++j) {
+			viewPosition[j] =
+				static_cast<double>(light.mPosAndRange[0U]) * camera.mView[j] +
+				static_cast<double>(light.mPosAndRange[1U]) * camera.mView[4U + j] +
+				static_cast<double>(light.mPosAndRange[2U]) * camera.mView[8U + j] +
+				camera.mView[12U + j];
+		}
+
+		// Left, right, bottom, top, near and far planes of the projection (column combinations)
+		const float* p{ camera.mProj };
+		const double planes[6U][4U]{
+			{ p[3U] + p[0U], p[7U] + p[4U], p[11U] + p[8U], p[15U] + p[12U] },
+			{ p[3U] - p[0U], p[7U] - p[4U], p[11U] - p[8U], p[15U] - p[12U] },
+			{ p[3U] + p[1U], p[7U] + p[5U], p[11U] + p[9U], p[15U] + p[13U] },
+			{ p[3U] - p[1U], p[7U] - p[5U], p[11U] - p[9U], p[15U] - p[13U] },
+			{ p[2U], p[6U], p[10U], p[14U] },
+			{ p[3U] - p[2U], p[7U] - p[6U], p[11U] - p[10U], p[15U] - p[14U] } };
+
+		visible = true;
+		for (const double (&plane)[4U] : planes) {
+			const double length{ std::sqrt(plane[0U] * plane[0U] + plane[1U] * plane[1U] + plane[2U] * plane[2U]) };
+			const double dist{ (plane[0U] * viewPosition[0U] + plane[1U] * viewPosition[1U] + plane[2U] * viewPosition[2U] + plane[3U]) / length };
+			const double margin{ dist + light.mPosAndRange[3U] };
+			if (std::fabs(margin) < 1.0e-3) {
+				return false;
+			}
+			visible = visible && margin >= 0.0;
+		}
+
+		return true;
+	}
+
+	// Compares visible lights against the scalar reference
+	void ExpectMatchesReference(const PunctualLightStore& store, const std::vector<PunctualLight>& lights, const Camera& camera) {
+		std::uint32_t visibleIndex{ 0U };
+		for (std::uint32_t i = 0U; i < lights.size(); ++i) {
+			bool expectedVisible;
+			double viewPosition[3U];
+			const bool decided{ IsLightVisible(lights[i], camera, expectedVisible, viewPosition) };
+			const bool visible{ visibleIndex < store.VisibleLightCount() && store.VisibleLightIndices()[visibleIndex] == i };
+			if (decided) {
+				EXPECT_EQ(visible, expectedVisible) << "light " << i;
+			}
+			if (visible == false) {
+				continue;
+			}
+
+			// View space position, same range and color
+			const PunctualLight& visibleLight(store.VisibleLights()[visibleIndex]);
+			for (std::uint32_t j = 0U; j < 3U; ++j) {
+				EXPECT_NEAR(visibleLight.mPosAndRange[j], viewPosition[j], 1.0e-3) << "light " << i;
+			}
+			EXPECT_EQ(visibleLight.mPosAndRange[3U], lights[i].mPosAndRange[3U]);
+			for (std::uint32_t j = 0U; j < 4U; ++j) {
+				EXPECT_EQ(visibleLight.mColorAndPower[j], lights[i].mColorAndPower[j]);
+			}
+			++visibleIndex;
+		}
+
+		EXPECT_EQ(visibleIndex, store.VisibleLightCount());
+	}
+}
+
+TEST(PunctualLightStore, Empty) {
+	PunctualLightStore store;
+	store.Init(nullptr, 0U);
+	std::mt19937 generator{ 1U };
+	const Camera camera{ RandomCamera(generator) };
+	store.Update(camera.mView, camera.mProj);
+	EXPECT_EQ(store.LightCount(), 0U);
+	EXPECT_EQ(store.VisibleLightCount(), 0U);
+}
+
+TEST(PunctualLightStore, MatchesScalarReference) {
+	std::mt19937 generator{ 2U };
+
+	// Counts that are not multiples of the SIMD width, so padding lights are tested
+	for (const std::uint32_t count : { 1U, 7U, 9U, 1000U, 5003U }) {
+		const std::vector<PunctualLight> lights{ RandomLights(generator, count) };
+		PunctualLightStore store;
+		store.Init(lights.data(), count);
+		EXPECT_EQ(store.LightCount(), count);
+		for (std::uint32_t i = 0U; i < 4U; ++i) {
+			const Camera camera{ RandomCamera(generator) };
+			store.Update(camera.mView, camera.mProj);
+			ExpectMatchesReference(store, lights, camera);
+		}
+	}
+}
+
+TEST(PunctualLightStore, KnownLights) {
+	// Camera at the origin looking at +z
+	Camera camera;
+	const float eye[3U]{ 0.0f, 0.0f, 0.0f };
+	const float target[3U]{ 0.0f, 0.0f, 1.0f };
+	TestUtils::LookAt(eye, target, camera.mView);
+	TestUtils::Perspective(sPi * 0.5f, 1.0f, 1.0f, 100.0f, camera.mProj);
+
+	const float spheres[][4U]{
+		{ 0.0f, 0.0f, 10.0f, 1.0f }, // Inside
+		{ 0.0f, 0.0f, -10.0f, 1.0f }, // Behind the eye
+		{ 0.0f, 0.0f, 100.5f, 1.0f }, // Intersects far plane
+		{ 11.0f, 0.0f, 10.0f, 0.5f }, // Right of the frustum
+		{ 0.0f, 0.0f, 0.5f, 0.75f }, // Intersects near plane
+		{ 0.0f, 12.0f, 10.0f, 1.0f }, // Above the frustum
+	};
+	const std::uint32_t count{ 6U };
+	std::vector<PunctualLight> lights(count);
+	for (std::uint32_t i = 0U; i < count; ++i) {
+		for (std::uint32_t j = 0U; j < 4U; ++j) {
+			lights[i].mPosAndRange[j] = spheres[i][j];
+		}
+	}
+
+	PunctualLightStore store;
+	store.Init(lights.data(), count);
+	store.Update(camera.mView, camera.mProj);
+	ASSERT_EQ(store.VisibleLightCount(), 3U);
+	EXPECT_EQ(store.VisibleLightIndices()[0U], 0U);
+	EXPECT_EQ(store.VisibleLightIndices()[1U], 2U);
+	EXPECT_EQ(store.VisibleLightIndices()[2U], 4U);
+}
+
+TEST(PunctualLightStore, Setters) {
+	std::mt19937 generator{ 3U };
+	std::vector<PunctualLight> lights{ RandomLights(generator, 37U) };
+	PunctualLightStore store;
+	store.Init(lights.data(), static_cast<std::uint32_t>(lights.size()));
+
+	// Move, resize and recolor some lights, as an animation does
+	for (std::uint32_t i = 0U; i < lights.size(); i += 3U) {
+		PunctualLight& light(lights[i]);
+		for (std::uint32_t j = 0U; j < 3U; ++j) {
+			light.mPosAndRange[j] = TestUtils::RandF(generator, -100.0f, 100.0f);
+		}
+		light.mPosAndRange[3U] = TestUtils::RandF(generator, 0.0f, 20.0f);
+		light.mColorAndPower[3U] = TestUtils::RandF(generator, 1.0f, 2.0f);
+		store.SetPosition(i, light.mPosAndRange);
+		store.SetRange(i, light.mPosAndRange[3U]);
+		store.SetColorAndPower(i, light.mColorAndPower);
+	}
+
+	for (std::uint32_t i = 0U; i < 4U; ++i) {
+		const Camera camera{ RandomCamera(generator) };
+		store.Update(camera.mView, camera.mProj);
+		ExpectMatchesReference(store, lights, camera);
+	}
+}
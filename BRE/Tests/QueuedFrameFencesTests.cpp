@@ -0,0 +1,79 @@
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <CommandManager/CommandQueue.h>
+#include <CommandManager/NullCommandQueue.h>
+#include <CommandManager/QueuedFrameFences.h>
+
+namespace {
+	// Records signaled and waited fence values. Fence values are completed when they are signaled.
+	class RecordingCommandQueue : public CommandQueue {
+	public:
+		void ExecuteCommandLists(const std::uint32_t, ID3D12CommandList* const*) noexcept final override {}
+		void Signal(const std::uint64_t fenceValue) noexcept final override { mSignals.push_back(fenceValue); }
+		std::uint64_t CompletedFenceValue() const noexcept final override { return mSignals.empty() ? 0UL : mSignals.back(); }
+		void WaitForFenceValue(const std::uint64_t fenceValue) noexcept final override { mWaits.push_back(fenceValue); }
+
+		std::vector<std::uint64_t> mSignals;
+		std::vector<std::uint64_t> mWaits;
+	};
+}
+
+// Each frame signals a new fence value and waits the one of the frame queuedFrameCount frames ago
+TEST(QueuedFrameFences, WaitsOldestQueuedFrame) {
+	const std::uint32_t queuedFrameCount{ 3U };
+	RecordingCommandQueue cmdQueue;
+	QueuedFrameFences fences(cmdQueue, queuedFrameCount);
+	EXPECT_EQ(fences.CurrentQueuedFrameIndex(), 0U);
+
+	const std::uint32_t frameCount{ 7U };
+	for (std::uint32_t frame = 0U; frame < frameCount; ++frame) {
+		fences.EndFrame();
+		EXPECT_EQ(fences.CurrentQueuedFrameIndex(), (frame + 1U) % queuedFrameCount);
+		EXPECT_EQ(fences.LastSignaledFenceValue(), frame + 1UL);
+	}
+
+	const std::vector<std::uint64_t> expectedSignals{ 1UL, 2UL, 3UL, 4UL, 5UL, 6UL, 7UL };
+	EXPECT_EQ(cmdQueue.mSignals, expectedSignals);
+
+	// The first frames reuse resources that were never used (fence value 0)
+	const std::vector<std::uint64_t> expectedWaits{ 0UL, 0UL, 1UL, 2UL, 3UL, 4UL, 5UL };
+	EXPECT_EQ(cmdQueue.mWaits, expectedWaits);
+
+	// Flush waits all executed command lists
+	fences.Flush();
+	EXPECT_EQ(cmdQueue.mSignals.back(), 8UL);
+	EXPECT_EQ(cmdQueue.mWaits.back(), 8UL);
+}
+
+TEST(QueuedFrameFences, SingleQueuedFrame) {
+	RecordingCommandQueue cmdQueue;
+	QueuedFrameFences fences(cmdQueue, 1U);
+	fences.EndFrame();
+	fences.EndFrame();
+	EXPECT_EQ(fences.CurrentQueuedFrameIndex(), 0U);
+
+	// Each frame waits itself
+	EXPECT_EQ(cmdQueue.mSignals, cmdQueue.mWaits);
+}
+
+// Null queue completes signaled values, so frames never wait values that were not signaled
+TEST(QueuedFrameFences, NullCommandQueue) {
+	NullCommandQueue cmdQueue;
+	QueuedFrameFences fences(cmdQueue, 3U);
+	for (std::uint32_t frame = 0U; frame < 10U; ++frame) {
+		fences.EndFrame();
+	}
+	fences.Flush();
+
+	EXPECT_EQ(cmdQueue.SignalCount(), 11U);
+	EXPECT_EQ(cmdQueue.CompletedFenceValue(), 11UL);
+	EXPECT_EQ(cmdQueue.InvalidCallCount(), 0U);
+
+	// Waiting values that were not signaled, or signaling values that do not increase, are invalid
+	cmdQueue.WaitForFenceValue(12UL);
+	cmdQueue.Signal(11UL);
+	EXPECT_EQ(cmdQueue.InvalidCallCount(), 2U);
+}
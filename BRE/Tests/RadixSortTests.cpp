@@ -0,0 +1,88 @@
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <Utils/RadixSort.h>
+
+namespace {
+	// Sorts keys with values (their original indices) and compares them against std::stable_sort
+	void ExpectSortedAsStableSort(std::vector<std::uint64_t> keys) {
+		const std::size_t count{ keys.size() };
+		std::vector<std::pair<std::uint64_t, std::uint32_t>> expected(count);
+		std::vector<std::uint32_t> values(count);
+		for (std::uint32_t i = 0U; i < count; ++i) {
+			expected[i] = std::make_pair(keys[i], i);
+			values[i] = i;
+		}
+		std::stable_sort(
+			expected.begin(),
+			expected.end(),
+			[](const std::pair<std::uint64_t, std::uint32_t>& a, const std::pair<std::uint64_t, std::uint32_t>& b) { return a.first < b.first; });
+
+		std::vector<std::uint64_t> tmpKeys(count);
+		std::vector<std::uint32_t> tmpValues(count);
+		RadixSort::SortKeyValues(keys.data(), values.data(), count, tmpKeys.data(), tmpValues.data());
+
+		for (std::size_t i = 0UL; i < count; ++i) {
+			ASSERT_EQ(keys[i], expected[i].first) << "count " << count << ", index " << i;
+			ASSERT_EQ(values[i], expected[i].second) << "count " << count << ", index " << i;
+		}
+	}
+
+	std::vector<std::uint64_t> RandomKeys(std::mt19937_64& generator, const std::size_t count, const std::uint64_t mask) {
+		std::vector<std::uint64_t> keys(count);
+		for (std::uint64_t& key : keys) {
+			key = generator() & mask;
+		}
+
+		return keys;
+	}
+}
+
+TEST(RadixSort, SmallInputs) {
+	ExpectSortedAsStableSort({});
+	ExpectSortedAsStableSort({ 42ULL });
+	ExpectSortedAsStableSort({ 2ULL, 1ULL });
+	ExpectSortedAsStableSort({ ~0ULL, 0ULL, 1ULL << 63U, 1ULL << 56U, 255ULL, 256ULL });
+}
+
+TEST(RadixSort, RandomKeys) {
+	std::mt19937_64 generator{ 1U };
+
+	// Sizes below and above the parallel block size
+	for (const std::size_t count : { 100UL, 16383UL, 16384UL, 100000UL, 1000000UL }) {
+		ExpectSortedAsStableSort(RandomKeys(generator, count, ~0ULL));
+	}
+}
+
+// Many equal keys test stability, and constant digits test skipped passes
+TEST(RadixSort, DuplicatedAndConstantDigits) {
+	std::mt19937_64 generator{ 2U };
+	for (const std::size_t count : { 1000UL, 200000UL }) {
+		ExpectSortedAsStableSort(RandomKeys(generator, count, 0xFULL));
+		ExpectSortedAsStableSort(RandomKeys(generator, count, 0xFF00FF0000000000ULL));
+		ExpectSortedAsStableSort(std::vector<std::uint64_t>(count, 0x1234567890ABCDEFULL));
+
+		// Render queue like keys: constant pass, few pipelines and recorders
+		std::vector<std::uint64_t> keys{ RandomKeys(generator, count, 0x0003007FFFFFFFFFULL) };
+		for (std::uint64_t& key : keys) {
+			key |= 1ULL << 60U;
+		}
+		ExpectSortedAsStableSort(keys);
+	}
+}
+
+TEST(RadixSort, SortedAndReversedKeys) {
+	std::vector<std::uint64_t> keys(50000UL);
+	for (std::size_t i = 0UL; i < keys.size(); ++i) {
+		keys[i] = i * 0x9E3779B1ULL;
+	}
+	ExpectSortedAsStableSort(keys);
+
+	std::reverse(keys.begin(), keys.end());
+	ExpectSortedAsStableSort(keys);
+}
@@ -0,0 +1,146 @@
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <Utils/RangeAllocator.h>
+
+namespace {
+	// gtest macros take their arguments by reference, so static members cannot be used
+	const std::uint32_t sInvalidOffset{ RangeAllocator::sInvalidOffset };
+
+	// Reference allocator: a flag per unit, first fit by linear search
+	class ReferenceAllocator {
+	public:
+		explicit ReferenceAllocator(const std::uint32_t capacity)
+			: mIsAllocated(capacity, false)
+		{
+		}
+
+		std::uint32_t Allocate(const std::uint32_t size) {
+			std::uint32_t freeCount{ 0U };
+			for (std::uint32_t i = 0U; i < mIsAllocated.size(); ++i) {
+				freeCount = mIsAllocated[i] ? 0U : freeCount + 1U;
+				if (freeCount == size) {
+					const std::uint32_t offset{ i + 1U - size };
+					for (std::uint32_t j = offset; j <= i; ++j) {
+						mIsAllocated[j] = true;
+					}
+					return offset;
+				}
+			}
+
+			return sInvalidOffset;
+		}
+
+		void Free(const std::uint32_t offset, const std::uint32_t size) {
+			for (std::uint32_t i = offset; i < offset + size; ++i) {
+				mIsAllocated[i] = false;
+			}
+		}
+
+		std::uint32_t LargestFreeRange() const {
+			std::uint32_t largestSize{ 0U };
+			std::uint32_t freeCount{ 0U };
+			for (const bool isAllocated : mIsAllocated) {
+				freeCount = isAllocated ? 0U : freeCount + 1U;
+				largestSize = freeCount > largestSize ? freeCount : largestSize;
+			}
+			return largestSize;
+		}
+
+	private:
+		std::vector<bool> mIsAllocated;
+	};
+}
+
+// Ranges are taken from the beginning of the first free range big enough
+TEST(RangeAllocator, FirstFit) {
+	RangeAllocator allocator(100U);
+	EXPECT_EQ(allocator.Allocate(10U), 0U);
+	EXPECT_EQ(allocator.Allocate(20U), 10U);
+	EXPECT_EQ(allocator.Allocate(30U), 30U);
+	EXPECT_EQ(allocator.Allocate(5U), 60U);
+	EXPECT_EQ(allocator.UsedSize(), 65U);
+	EXPECT_EQ(allocator.AllocationCount(), 4UL);
+
+	// Free ranges of 10 at 0 and 30 at 30
+	allocator.Free(0U);
+	allocator.Free(30U);
+	EXPECT_TRUE(allocator.ValidateData());
+
+	// The first free range is too small, the second one is split
+	EXPECT_EQ(allocator.Allocate(15U), 30U);
+	// The first free range fits, even if a later one fits better
+	EXPECT_EQ(allocator.Allocate(10U), 0U);
+	EXPECT_EQ(allocator.Allocate(15U), 45U);
+	EXPECT_EQ(allocator.Allocate(35U), 65U);
+	EXPECT_EQ(allocator.FreeSize(), 0U);
+	EXPECT_EQ(allocator.Allocate(1U), sInvalidOffset);
+	EXPECT_TRUE(allocator.ValidateData());
+}
+
+// Freed ranges are merged with free neighbors, so a range as big
+// as all the freed space can be allocated again
+TEST(RangeAllocator, MergesFreedRanges) {
+	RangeAllocator allocator(40U);
+	std::uint32_t offsets[4U];
+	for (std::uint32_t& offset : offsets) {
+		offset = allocator.Allocate(10U);
+	}
+	EXPECT_EQ(allocator.LargestFreeRange(), 0U);
+
+	// Next, previous, and both neighbors free
+	allocator.Free(offsets[1U]);
+	allocator.Free(offsets[0U]);
+	EXPECT_EQ(allocator.LargestFreeRange(), 20U);
+	allocator.Free(offsets[3U]);
+	EXPECT_EQ(allocator.LargestFreeRange(), 20U);
+	EXPECT_EQ(allocator.FreeSize(), 30U);
+	EXPECT_EQ(allocator.Allocate(30U), sInvalidOffset);
+	allocator.Free(offsets[2U]);
+	EXPECT_TRUE(allocator.ValidateData());
+	EXPECT_EQ(allocator.LargestFreeRange(), 40U);
+	EXPECT_EQ(allocator.AllocationCount(), 0UL);
+
+	EXPECT_EQ(allocator.Allocate(40U), 0U);
+	EXPECT_TRUE(allocator.ValidateData());
+}
+
+// Random allocations and frees give the same offsets as a reference allocator
+TEST(RangeAllocator, MatchesReference) {
+	const std::uint32_t capacity{ 1000U };
+	RangeAllocator allocator(capacity);
+	ReferenceAllocator reference(capacity);
+
+	struct Allocation {
+		std::uint32_t mOffset;
+		std::uint32_t mSize;
+	};
+	std::vector<Allocation> allocations;
+
+	std::mt19937 generator{ 7U };
+	std::uniform_int_distribution<std::uint32_t> sizeDistribution{ 1U, 60U };
+	for (std::uint32_t i = 0U; i < 5000U; ++i) {
+		if (allocations.empty() || generator() % 5U < 3U) {
+			const std::uint32_t size{ sizeDistribution(generator) };
+			const std::uint32_t offset{ allocator.Allocate(size) };
+			ASSERT_EQ(offset, reference.Allocate(size)) << i;
+			if (offset != sInvalidOffset) {
+				allocations.push_back(Allocation{ offset, size });
+			}
+		}
+		else {
+			const std::size_t index{ generator() % allocations.size() };
+			allocator.Free(allocations[index].mOffset);
+			reference.Free(allocations[index].mOffset, allocations[index].mSize);
+			allocations[index] = allocations.back();
+			allocations.pop_back();
+		}
+
+		ASSERT_TRUE(allocator.ValidateData()) << i;
+		ASSERT_EQ(allocator.LargestFreeRange(), reference.LargestFreeRange()) << i;
+		ASSERT_EQ(allocator.AllocationCount(), allocations.size()) << i;
+	}
+}
@@ -0,0 +1,108 @@
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <GeometryPass/RenderQueue.h>
+
+namespace {
+	DrawPacket Packet(const std::uint64_t key, const std::uint32_t recorderIndex, const std::uint32_t geometryIndex) {
+		DrawPacket packet{};
+		packet.mKey = key;
+		packet.mRecorderIndex = recorderIndex;
+		packet.mGeometryIndex = geometryIndex;
+		return packet;
+	}
+}
+
+TEST(RenderQueue, KeyFieldsOrder) {
+	// Each field is more significant than all the following ones together
+	const std::uint32_t maxDepth{ (1U << RenderQueue::sDepthBits) - 1U };
+	const std::uint32_t maxMaterial{ (1U << RenderQueue::sMaterialBits) - 1U };
+	const std::uint32_t maxGeometryBuffers{ (1U << RenderQueue::sGeometryBuffersBits) - 1U };
+	const std::uint32_t maxRecorder{ (1U << RenderQueue::sRecorderBits) - 1U };
+	const std::uint32_t maxPipeline{ (1U << RenderQueue::sPipelineBits) - 1U };
+	EXPECT_LT(RenderQueue::MakeKey(0U, 0U, 0U, 0U, 0U, maxDepth), RenderQueue::MakeKey(0U, 0U, 0U, 0U, 1U, 0U));
+	EXPECT_LT(RenderQueue::MakeKey(0U, 0U, 0U, 0U, maxMaterial, maxDepth), RenderQueue::MakeKey(0U, 0U, 0U, 1U, 0U, 0U));
+	EXPECT_LT(RenderQueue::MakeKey(0U, 0U, 0U, maxGeometryBuffers, maxMaterial, maxDepth), RenderQueue::MakeKey(0U, 0U, 1U, 0U, 0U, 0U));
+	EXPECT_LT(RenderQueue::MakeKey(0U, 0U, maxRecorder, maxGeometryBuffers, maxMaterial, maxDepth), RenderQueue::MakeKey(0U, 1U, 0U, 0U, 0U, 0U));
+	EXPECT_LT(RenderQueue::MakeKey(0U, maxPipeline, maxRecorder, maxGeometryBuffers, maxMaterial, maxDepth), RenderQueue::MakeKey(1U, 0U, 0U, 0U, 0U, 0U));
+	EXPECT_EQ(RenderQueue::MakeKey(15U, maxPipeline, maxRecorder, maxGeometryBuffers, maxMaterial, maxDepth), ~0ULL);
+
+	// State extraction ignores geometry buffers, material and depth
+	const std::uint64_t key{ RenderQueue::MakeKey(3U, 7U, 11U, 2U, 100U, 1000U) };
+	EXPECT_EQ(RenderQueue::PipelineState(key), RenderQueue::PipelineState(RenderQueue::MakeKey(3U, 7U, 12U, 0U, 0U, 0U)));
+	EXPECT_NE(RenderQueue::PipelineState(key), RenderQueue::PipelineState(RenderQueue::MakeKey(3U, 8U, 11U, 2U, 100U, 1000U)));
+	EXPECT_EQ(RenderQueue::RecorderState(key), RenderQueue::RecorderState(RenderQueue::MakeKey(3U, 7U, 11U, 5U, 9U, 0U)));
+	EXPECT_NE(RenderQueue::RecorderState(key), RenderQueue::RecorderState(RenderQueue::MakeKey(3U, 7U, 12U, 2U, 100U, 1000U)));
+}
+
+TEST(RenderQueue, QuantizeDepth) {
+	const std::uint32_t maxDepth{ (1U << RenderQueue::sDepthBits) - 1U };
+	EXPECT_EQ(RenderQueue::QuantizeDepth(1.0f, 1.0f, 100.0f), 0U);
+	EXPECT_EQ(RenderQueue::QuantizeDepth(100.0f, 1.0f, 100.0f), maxDepth);
+	EXPECT_EQ(RenderQueue::QuantizeDepth(-5.0f, 1.0f, 100.0f), 0U);
+	EXPECT_EQ(RenderQueue::QuantizeDepth(500.0f, 1.0f, 100.0f), maxDepth);
+	EXPECT_LT(RenderQueue::QuantizeDepth(10.0f, 1.0f, 100.0f), RenderQueue::QuantizeDepth(10.01f, 1.0f, 100.0f));
+}
+
+TEST(RenderQueue, SortGroupsStateAndKeepsPushOrder) {
+	RenderQueue queue;
+	queue.Clear();
+	queue.Push(Packet(RenderQueue::MakeKey(0U, 1U, 0U, 0U, 0U, 10U), 0U, 0U));
+	queue.Push(Packet(RenderQueue::MakeKey(0U, 0U, 1U, 0U, 0U, 20U), 1U, 0U));
+	queue.Push(Packet(RenderQueue::MakeKey(0U, 0U, 1U, 0U, 0U, 5U), 1U, 1U));
+	queue.Push(Packet(RenderQueue::MakeKey(0U, 1U, 0U, 0U, 0U, 10U), 0U, 1U));
+	queue.Push(Packet(RenderQueue::MakeKey(0U, 0U, 2U, 0U, 0U, 0U), 2U, 0U));
+	queue.Sort();
+
+	// Pipeline, then recorder, then front to back. Equal keys keep push order.
+	const std::uint32_t expected[][2U]{ { 1U, 1U }, { 1U, 0U }, { 2U, 0U }, { 0U, 0U }, { 0U, 1U } };
+	ASSERT_EQ(queue.PacketCount(), 5U);
+	for (std::uint32_t i = 0U; i < 5U; ++i) {
+		EXPECT_EQ(queue.SortedPacket(i).mRecorderIndex, expected[i][0U]) << "packet " << i;
+		EXPECT_EQ(queue.SortedPacket(i).mGeometryIndex, expected[i][1U]) << "packet " << i;
+	}
+
+	queue.Clear();
+	EXPECT_EQ(queue.PacketCount(), 0U);
+	queue.Sort();
+}
+
+TEST(RenderQueue, SortGroupsGeometryBuffersAndMaterials) {
+	// Packets of a recorder whose geometry data use 2 arenas and 3 materials
+	// (geometry data 5 has instances of different materials)
+	const std::uint32_t mixedMaterial{ RenderQueue::sMixedMaterial };
+	const std::uint32_t fields[][3U]{
+		// geometry buffers, material, depth
+		{ 1U, 7U, 10U },
+		{ 0U, 7U, 30U },
+		{ 1U, 3U, 40U },
+		{ 0U, 3U, 20U },
+		{ 0U, 7U, 5U },
+		{ 0U, mixedMaterial, 0U },
+	};
+
+	RenderQueue queue;
+	queue.Clear();
+	for (std::uint32_t i = 0U; i < 6U; ++i) {
+		queue.Push(Packet(RenderQueue::MakeKey(0U, 0U, 0U, fields[i][0U], fields[i][1U], fields[i][2U]), 0U, i));
+	}
+	queue.Sort();
+
+	// Buffers are bound once per arena, packets of the same material are contiguous
+	// and front to back, and packets with mixed materials go last in their arena.
+	const std::uint32_t expected[]{ 3U, 4U, 1U, 5U, 2U, 0U };
+	ASSERT_EQ(queue.PacketCount(), 6U);
+	std::uint32_t geometryBuffersChanges{ 0U };
+	for (std::uint32_t i = 0U; i < 6U; ++i) {
+		EXPECT_EQ(queue.SortedPacket(i).mGeometryIndex, expected[i]) << "packet " << i;
+		if (i > 0U && fields[expected[i]][0U] != fields[expected[i - 1U]][0U]) {
+			++geometryBuffersChanges;
+		}
+	}
+	EXPECT_EQ(geometryBuffersChanges, 1U);
+
+	// All fields are below the recorder, so state does not change
+	EXPECT_EQ(RenderQueue::RecorderState(queue.SortedPacket(0U).mKey), RenderQueue::RecorderState(queue.SortedPacket(5U).mKey));
+}
@@ -0,0 +1,99 @@
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <Utils/RenderStats.h>
+
+namespace {
+	RenderStats::Counters Difference(const RenderStats::Counters& before) {
+		RenderStats::Counters difference{ RenderStats::Snapshot() };
+		difference -= before;
+		return difference;
+	}
+}
+
+TEST(RenderStats, SnapshotDifference) {
+	const RenderStats::Counters before{ RenderStats::Snapshot() };
+
+	RenderStats::AddDraw(36U, 4U);
+	RenderStats::AddDraw(6U, 1U);
+	RenderStats::AddExecute(3U);
+	RenderStats::Add(RenderStats::UPLOADED_BYTES, 1024UL);
+	RenderStats::Add(RenderStats::RESOURCE_BARRIERS, 2UL);
+
+	const RenderStats::Counters difference{ Difference(before) };
+	EXPECT_EQ(difference.mValues[RenderStats::DRAW_CALLS], 2UL);
+	EXPECT_EQ(difference.mValues[RenderStats::INSTANCES], 5UL);
+	EXPECT_EQ(difference.mValues[RenderStats::INDICES], 150UL);
+	EXPECT_EQ(difference.mValues[RenderStats::EXECUTE_COMMAND_LISTS_CALLS], 1UL);
+	EXPECT_EQ(difference.mValues[RenderStats::COMMAND_LISTS], 3UL);
+	EXPECT_EQ(difference.mValues[RenderStats::UPLOADED_BYTES], 1024UL);
+	EXPECT_EQ(difference.mValues[RenderStats::RESOURCE_BARRIERS], 2UL);
+	EXPECT_EQ(difference.mValues[RenderStats::PIPELINE_STATE_CHANGES], 0UL);
+	EXPECT_EQ(difference.mValues[RenderStats::ROOT_SIGNATURE_CHANGES], 0UL);
+	EXPECT_EQ(difference.mValues[RenderStats::DESCRIPTOR_TABLES], 0UL);
+
+	// Nothing is added between snapshots
+	const RenderStats::Counters after{ RenderStats::Snapshot() };
+	const RenderStats::Counters emptyDifference{ Difference(after) };
+	for (std::uint32_t i = 0U; i < RenderStats::COUNTER_COUNT; ++i) {
+		EXPECT_EQ(emptyDifference.mValues[i], 0UL) << RenderStats::CounterName(static_cast<RenderStats::Counter>(i));
+	}
+
+	// Counters are written in order, preceded by the label
+	std::ostringstream stream;
+	RenderStats::WriteCounters(stream, "frame", difference);
+	EXPECT_EQ(stream.str().find("frame: draws 2, instances 5, indices 150,"), 0UL);
+	EXPECT_NE(stream.str().find("uploaded bytes 1024\n"), std::string::npos);
+}
+
+// Each thread increments its own shard. Once threads are joined, the
+// snapshot has all their increments (shards outlive their threads).
+TEST(RenderStats, MultithreadedTotal) {
+	const std::uint32_t threadCount{ 8U };
+	const std::uint32_t drawCount{ 100000U };
+
+	const RenderStats::Counters before{ RenderStats::Snapshot() };
+
+	std::vector<std::thread> threads;
+	for (std::uint32_t i = 0U; i < threadCount; ++i) {
+		threads.emplace_back([i, drawCount]() {
+			for (std::uint32_t j = 0U; j < drawCount; ++j) {
+				RenderStats::AddDraw(3U, i + 1U);
+				RenderStats::Add(RenderStats::DESCRIPTOR_TABLES, 2UL);
+			}
+			RenderStats::AddExecute(i);
+		});
+	}
+
+	// Snapshots while threads increment counters must not block them
+	// or go backwards
+	RenderStats::Counters previous{ before };
+	for (std::uint32_t i = 0U; i < 100U; ++i) {
+		const RenderStats::Counters current{ RenderStats::Snapshot() };
+		for (std::uint32_t j = 0U; j < RenderStats::COUNTER_COUNT; ++j) {
+			EXPECT_GE(current.mValues[j], previous.mValues[j]);
+		}
+		previous = current;
+	}
+
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+
+	// Sum of (i + 1) for i in [0, threadCount) and of i for i in [0, threadCount)
+	const std::uint64_t instanceCount{ static_cast<std::uint64_t>(drawCount) * threadCount * (threadCount + 1U) / 2U };
+	const std::uint64_t cmdListCount{ threadCount * (threadCount - 1U) / 2U };
+
+	const RenderStats::Counters difference{ Difference(before) };
+	EXPECT_EQ(difference.mValues[RenderStats::DRAW_CALLS], static_cast<std::uint64_t>(drawCount) * threadCount);
+	EXPECT_EQ(difference.mValues[RenderStats::INSTANCES], instanceCount);
+	EXPECT_EQ(difference.mValues[RenderStats::INDICES], instanceCount * 3UL);
+	EXPECT_EQ(difference.mValues[RenderStats::DESCRIPTOR_TABLES], static_cast<std::uint64_t>(drawCount) * threadCount * 2UL);
+	EXPECT_EQ(difference.mValues[RenderStats::EXECUTE_COMMAND_LISTS_CALLS], static_cast<std::uint64_t>(threadCount));
+	EXPECT_EQ(difference.mValues[RenderStats::COMMAND_LISTS], cmdListCount);
+}
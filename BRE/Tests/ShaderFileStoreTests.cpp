@@ -0,0 +1,124 @@
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <tbb/parallel_for.h>
+
+#include <ShaderManager/MappedFile.h>
+#include <ShaderManager/ShaderFileStore.h>
+
+namespace {
+	// Writes a file of size bytes that depend on seed, and returns its path
+	std::string WriteFile(const char* name, const std::size_t size, const std::uint8_t seed) {
+		const std::string path{ std::string(BRE_TEST_FILES_PATH) + name };
+		std::vector<char> bytes(size);
+		for (std::size_t i = 0UL; i < size; ++i) {
+			bytes[i] = static_cast<char>(seed + i * 7UL);
+		}
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		file.write(bytes.data(), bytes.size());
+		return path;
+	}
+
+	bool ViewMatches(const ShaderFileStore::View& view, const std::size_t size, const std::uint8_t seed) {
+		if (view.mData == nullptr || view.mSize != size) {
+			return false;
+		}
+
+		const std::uint8_t* bytes{ static_cast<const std::uint8_t*>(view.mData) };
+		for (std::size_t i = 0UL; i < size; ++i) {
+			if (bytes[i] != static_cast<std::uint8_t>(seed + i * 7UL)) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+}
+
+TEST(ShaderFileStore, MappedFile) {
+	const std::string path{ WriteFile("MappedFile.cso", 1000UL, 1U) };
+	MappedFile file;
+	ASSERT_TRUE(file.Open(path.c_str()));
+	ShaderFileStore::View view;
+	view.mData = file.Data();
+	view.mSize = file.Size();
+	EXPECT_TRUE(ViewMatches(view, 1000UL, 1U));
+	file.Close();
+	EXPECT_EQ(file.Data(), nullptr);
+	EXPECT_EQ(file.Size(), 0UL);
+
+	// Missing and empty files can not be mapped
+	EXPECT_FALSE(file.Open((std::string(BRE_TEST_FILES_PATH) + "Missing.cso").c_str()));
+	const std::string emptyPath{ WriteFile("Empty.cso", 0UL, 0U) };
+	EXPECT_FALSE(file.Open(emptyPath.c_str()));
+}
+
+// Loads of the same path return the same id and the same mapped bytes
+TEST(ShaderFileStore, Interning) {
+	const std::string vsPath{ WriteFile("VS.cso", 4000UL, 2U) };
+	const std::string psPath{ WriteFile("PS.cso", 3000UL, 3U) };
+	ShaderFileStore store;
+
+	ShaderFileStore::View vsView;
+	const std::size_t vsId{ store.Load(vsPath.c_str(), vsView) };
+	EXPECT_TRUE(ViewMatches(vsView, 4000UL, 2U));
+
+	ShaderFileStore::View psView;
+	const std::size_t psId{ store.Load(psPath.c_str(), psView) };
+	EXPECT_NE(psId, vsId);
+	EXPECT_TRUE(ViewMatches(psView, 3000UL, 3U));
+
+	// A path in another string is the same file
+	const std::string vsPathCopy{ vsPath };
+	ShaderFileStore::View vsView2;
+	EXPECT_EQ(store.Load(vsPathCopy.c_str(), vsView2), vsId);
+	EXPECT_EQ(vsView2.mData, vsView.mData);
+	EXPECT_EQ(vsView2.mSize, vsView.mSize);
+
+	EXPECT_EQ(store.FileCount(), 2UL);
+	EXPECT_EQ(store.MappedFileCount(), 2U);
+	EXPECT_EQ(store.InternedLoadCount(), 1U);
+	EXPECT_EQ(store.GetView(psId).mData, psView.mData);
+
+	// Erased files are mapped again
+	store.Erase(vsId);
+	EXPECT_EQ(store.FileCount(), 1UL);
+	EXPECT_EQ(store.Load(vsPath.c_str(), vsView), vsId);
+	EXPECT_TRUE(ViewMatches(vsView, 4000UL, 2U));
+	EXPECT_EQ(store.MappedFileCount(), 3U);
+
+	store.Clear();
+	EXPECT_EQ(store.FileCount(), 0UL);
+}
+
+// Passes load their shaders from several threads: each file is mapped once
+TEST(ShaderFileStore, ConcurrentLoads) {
+	const std::uint32_t fileCount{ 16U };
+	const std::uint32_t loadsPerFile{ 64U };
+	std::vector<std::string> paths;
+	for (std::uint32_t i = 0U; i < fileCount; ++i) {
+		paths.push_back(WriteFile(("Concurrent" + std::to_string(i) + ".cso").c_str(), 512UL + i * 100UL, static_cast<std::uint8_t>(i)));
+	}
+
+	ShaderFileStore store;
+	const std::uint32_t loadCount{ fileCount * loadsPerFile };
+	std::vector<ShaderFileStore::View> views(loadCount);
+	std::vector<std::size_t> ids(loadCount);
+	tbb::parallel_for(0U, loadCount, [&](const std::uint32_t i) {
+		ids[i] = store.Load(paths[i % fileCount].c_str(), views[i]);
+	});
+
+	EXPECT_EQ(store.FileCount(), fileCount);
+	EXPECT_EQ(store.MappedFileCount(), fileCount);
+	EXPECT_EQ(store.InternedLoadCount(), loadCount - fileCount);
+	for (std::uint32_t i = 0U; i < loadCount; ++i) {
+		const std::uint32_t file{ i % fileCount };
+		ASSERT_EQ(ids[i], ids[file]) << "load " << i;
+		ASSERT_EQ(views[i].mData, views[file].mData) << "load " << i;
+		ASSERT_TRUE(ViewMatches(views[i], 512UL + file * 100UL, static_cast<std::uint8_t>(file))) << "load " << i;
+	}
+}
@@ -0,0 +1,297 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <MathUtils/SphericalHarmonics.h>
+#include <ResourceManager/CubeMapData.h>
+#include <Tests/TestUtils.h>
+
+namespace {
+	const float sPi{ 3.14159265f };
+	const std::uint32_t sCoefficientCount{ SphericalHarmonics::sCoefficientCount };
+	const std::uint32_t sFaceSize{ 64U };
+
+	using Radiance = std::function<float(const float direction[3U])>;
+
+	// Projects a cube map whose texels are radiance(direction) in the 3 channels
+	SphericalHarmonics::Coefficients Project(const Radiance& radiance, const std::uint32_t faceSize = sFaceSize) {
+		SphericalHarmonics::Coefficients coefficients;
+		std::vector<float> texels(faceSize * faceSize * 4UL);
+		for (std::uint32_t face = 0U; face < SphericalHarmonics::sCubeMapFaceCount; ++face) {
+			for (std::uint32_t y = 0U; y < faceSize; ++y) {
+				for (std::uint32_t x = 0U; x < faceSize; ++x) {
+					float direction[3U];
+					SphericalHarmonics::CubeMapTexelDirection(face, x, y, faceSize, direction);
+					const float value{ radiance(direction) };
+					float* texel{ &texels[(y * faceSize + x) * 4UL] };
+					texel[0U] = value;
+					texel[1U] = value;
+					texel[2U] = value;
+					texel[3U] = 1.0f;
+				}
+			}
+			SphericalHarmonics::ProjectCubeMapRows(texels.data(), face, faceSize, 0U, faceSize, coefficients);
+		}
+
+		return coefficients;
+	}
+
+	void RandomDirection(std::mt19937& generator, float direction[3U]) {
+		float sqrLength{ 0.0f };
+		do {
+			for (std::uint32_t j = 0U; j < 3U; ++j) {
+				direction[j] = TestUtils::RandF(generator, -1.0f, 1.0f);
+			}
+			sqrLength = direction[0U] * direction[0U] + direction[1U] * direction[1U] + direction[2U] * direction[2U];
+		} while (sqrLength > 1.0f || sqrLength < 0.01f);
+
+		const float length{ std::sqrt(sqrLength) };
+		for (std::uint32_t j = 0U; j < 3U; ++j) {
+			direction[j] /= length;
+		}
+	}
+
+	// A function in the first 3 bands (so L2 projection reproduces it):
+	// 1 + 0.5 x - 0.25 y z + 0.3 (3 z^2 - 1)
+	float QuadraticRadiance(const float d[3U]) {
+		return 1.0f + 0.5f * d[0U] - 0.25f * d[1U] * d[2U] + 0.3f * (3.0f * d[2U] * d[2U] - 1.0f);
+	}
+}
+
+TEST(SphericalHarmonics, SolidAngles) {
+	for (const std::uint32_t faceSize : { 1U, 7U, 64U }) {
+		double sum{ 0.0 };
+		for (std::uint32_t y = 0U; y < faceSize; ++y) {
+			for (std::uint32_t x = 0U; x < faceSize; ++x) {
+				sum += SphericalHarmonics::CubeMapTexelSolidAngle(x, y, faceSize);
+			}
+		}
+		EXPECT_NEAR(sum * SphericalHarmonics::sCubeMapFaceCount, 4.0 * sPi, 1.0e-4) << "face size " << faceSize;
+	}
+}
+
+// Face centers are the axes, in D3D order
+TEST(SphericalHarmonics, CubeMapTexelDirections) {
+	const float axes[SphericalHarmonics::sCubeMapFaceCount][3U]{
+		{ 1.0f, 0.0f, 0.0f }, { -1.0f, 0.0f, 0.0f },
+		{ 0.0f, 1.0f, 0.0f }, { 0.0f, -1.0f, 0.0f },
+		{ 0.0f, 0.0f, 1.0f }, { 0.0f, 0.0f, -1.0f } };
+	for (std::uint32_t face = 0U; face < SphericalHarmonics::sCubeMapFaceCount; ++face) {
+		float direction[3U];
+		SphericalHarmonics::CubeMapTexelDirection(face, 0U, 0U, 1U, direction);
+		for (std::uint32_t j = 0U; j < 3U; ++j) {
+			EXPECT_FLOAT_EQ(direction[j], axes[face][j]) << "face " << face;
+		}
+	}
+}
+
+// Projections of the basis functions are the unit coefficients (the basis is orthonormal)
+TEST(SphericalHarmonics, BasisIsOrthonormal) {
+	for (std::uint32_t i = 0U; i < sCoefficientCount; ++i) {
+		const SphericalHarmonics::Coefficients coefficients{ Project([i](const float direction[3U]) {
+			float basis[sCoefficientCount];
+			SphericalHarmonics::EvaluateBasis(direction, basis);
+			return basis[i];
+		}) };
+
+		for (std::uint32_t k = 0U; k < sCoefficientCount; ++k) {
+			EXPECT_NEAR(coefficients.mValues[k][0U], i == k ? 1.0f : 0.0f, 2.0e-3f) << "basis " << i << ", coefficient " << k;
+		}
+	}
+}
+
+// Analytic projection of a + b z: a sqrt(4 PI) and b sqrt(4 PI / 3)
+TEST(SphericalHarmonics, ProjectionMatchesAnalytic) {
+	const float a{ 0.7f };
+	const float b{ -0.4f };
+	const SphericalHarmonics::Coefficients coefficients{ Project([a, b](const float direction[3U]) { return a + b * direction[2U]; }) };
+
+	for (std::uint32_t k = 0U; k < sCoefficientCount; ++k) {
+		float expected{ 0.0f };
+		if (k == 0U) {
+			expected = a * std::sqrt(4.0f * sPi);
+		}
+		else if (k == 2U) {
+			expected = b * std::sqrt(4.0f * sPi / 3.0f);
+		}
+
+		for (std::uint32_t j = 0U; j < 3U; ++j) {
+			EXPECT_NEAR(coefficients.mValues[k][j], expected, 2.0e-3f) << "coefficient " << k;
+		}
+		EXPECT_EQ(coefficients.mValues[k][3U], 0.0f);
+	}
+}
+
+// Functions in the first 3 bands are reconstructed
+TEST(SphericalHarmonics, Reconstruction) {
+	const SphericalHarmonics::Coefficients coefficients{ Project(QuadraticRadiance) };
+	std::mt19937 generator{ 1U };
+	for (std::uint32_t i = 0U; i < 1000U; ++i) {
+		float direction[3U];
+		RandomDirection(generator, direction);
+		float rgb[3U];
+		SphericalHarmonics::Evaluate(coefficients, direction, rgb);
+		for (std::uint32_t j = 0U; j < 3U; ++j) {
+			ASSERT_NEAR(rgb[j], QuadraticRadiance(direction), 2.0e-3f);
+		}
+	}
+}
+
+// Irradiance / PI of each band is scaled by 1, 2 / 3 and 1 / 4:
+// a + b z + c (3 z^2 - 1) radiance gives a + 2 / 3 b nz + 1 / 4 c (3 nz^2 - 1) irradiance / PI
+TEST(SphericalHarmonics, ConvolveCosineLobe) {
+	const float a{ 0.6f };
+	const float b{ 0.3f };
+	const float c{ 0.1f };
+	SphericalHarmonics::Coefficients coefficients{ Project([a, b, c](const float d[3U]) {
+		return a + b * d[2U] + c * (3.0f * d[2U] * d[2U] - 1.0f);
+	}) };
+	SphericalHarmonics::ConvolveCosineLobe(coefficients);
+
+	std::mt19937 generator{ 2U };
+	for (std::uint32_t i = 0U; i < 1000U; ++i) {
+		float normal[3U];
+		RandomDirection(generator, normal);
+		float rgb[3U];
+		SphericalHarmonics::Evaluate(coefficients, normal, rgb);
+		const float expected{ a + 2.0f / 3.0f * b * normal[2U] + 0.25f * c * (3.0f * normal[2U] * normal[2U] - 1.0f) };
+		ASSERT_NEAR(rgb[0U], expected, 2.0e-3f);
+	}
+}
+
+// Irradiance of a sky that is white above the horizon, against numerical integration.
+// L2 spherical harmonics do not represent the sky, but they represent its irradiance: the sky has
+// no even bands above 0, and the clamped cosine lobe has no odd bands above 1.
+TEST(SphericalHarmonics, HemisphereIrradiance) {
+	const Radiance sky{ [](const float d[3U]) { return d[1U] > 0.0f ? 1.0f : 0.0f; } };
+	SphericalHarmonics::Coefficients coefficients{ Project(sky) };
+	SphericalHarmonics::ConvolveCosineLobe(coefficients);
+
+	std::mt19937 generator{ 3U };
+	const std::uint32_t faceSize{ 32U };
+	for (std::uint32_t i = 0U; i < 20U; ++i) {
+		float normal[3U];
+		RandomDirection(generator, normal);
+
+		double irradiance{ 0.0 };
+		for (std::uint32_t face = 0U; face < SphericalHarmonics::sCubeMapFaceCount; ++face) {
+			for (std::uint32_t y = 0U; y < faceSize; ++y) {
+				for (std::uint32_t x = 0U; x < faceSize; ++x) {
+					float direction[3U];
+					SphericalHarmonics::CubeMapTexelDirection(face, x, y, faceSize, direction);
+					const float cosine{ normal[0U] * direction[0U] + normal[1U] * direction[1U] + normal[2U] * direction[2U] };
+					irradiance += std::fmax(cosine, 0.0f) * sky(direction) * SphericalHarmonics::CubeMapTexelSolidAngle(x, y, faceSize);
+				}
+			}
+		}
+
+		// Analytic irradiance / PI is (1 + ny) / 2 for this sky
+		EXPECT_NEAR(irradiance / sPi, (1.0f + normal[1U]) * 0.5f, 5.0e-3f);
+
+		float rgb[3U];
+		SphericalHarmonics::Evaluate(coefficients, normal, rgb);
+		EXPECT_NEAR(rgb[0U], irradiance / sPi, 5.0e-3);
+	}
+}
+
+// Rows can be projected separately and then added
+TEST(SphericalHarmonics, ProjectRows) {
+	const std::uint32_t faceSize{ 16U };
+	std::vector<float> texels(faceSize * faceSize * 4UL);
+	std::mt19937 generator{ 4U };
+	for (float& texel : texels) {
+		texel = TestUtils::RandF(generator, 0.0f, 4.0f);
+	}
+
+	SphericalHarmonics::Coefficients whole;
+	SphericalHarmonics::ProjectCubeMapRows(texels.data(), 3U, faceSize, 0U, faceSize, whole);
+
+	SphericalHarmonics::Coefficients rows;
+	for (std::uint32_t row = 0U; row < faceSize; row += 5U) {
+		SphericalHarmonics::Coefficients rowCoefficients;
+		SphericalHarmonics::ProjectCubeMapRows(texels.data(), 3U, faceSize, row, std::min(row + 5U, faceSize), rowCoefficients);
+		rows += rowCoefficients;
+	}
+
+	for (std::uint32_t k = 0U; k < sCoefficientCount; ++k) {
+		for (std::uint32_t j = 0U; j < 4U; ++j) {
+			EXPECT_NEAR(rows.mValues[k][j], whole.mValues[k][j], 1.0e-5f) << "coefficient " << k;
+		}
+	}
+}
+
+// Constant coefficients (the fallback ambient when a sky box cannot be projected)
+TEST(SphericalHarmonics, SetConstant) {
+	const float ambient[3U]{ 0.2f, 0.3f, 0.4f };
+	SphericalHarmonics::Coefficients coefficients;
+	SphericalHarmonics::SetConstant(ambient, coefficients);
+
+	// Same as the projection of constant radiance
+	const SphericalHarmonics::Coefficients projected{ Project([](const float*) { return 0.3f; }) };
+	EXPECT_NEAR(coefficients.mValues[0U][1U], projected.mValues[0U][1U], 1.0e-4f);
+
+	std::mt19937 generator{ 5U };
+	for (std::uint32_t convolved = 0U; convolved < 2U; ++convolved) {
+		for (std::uint32_t i = 0U; i < 100U; ++i) {
+			float direction[3U];
+			RandomDirection(generator, direction);
+			float rgb[3U];
+			SphericalHarmonics::Evaluate(coefficients, direction, rgb);
+			for (std::uint32_t j = 0U; j < 3U; ++j) {
+				ASSERT_NEAR(rgb[j], ambient[j], 1.0e-5f);
+			}
+		}
+		SphericalHarmonics::ConvolveCosineLobe(coefficients);
+	}
+}
+
+// A diffuse irradiance cube map (the one scenes used before irradiance was computed as
+// spherical harmonics, downsampled to 16 x 16 faces) is smooth, so its L2 projection
+// reconstructs it with a small error (6.0% mean absolute error at 128 x 128).
+TEST(SphericalHarmonics, DiffuseCubeMapReconstruction) {
+	std::ifstream fin{ std::string(BRE_TEST_DATA_PATH) + "milkmill_diffuse_cube_map_16.dds", std::ios::binary };
+	ASSERT_TRUE(fin.is_open());
+	const std::vector<std::uint8_t> data{ std::istreambuf_iterator<char>(fin), std::istreambuf_iterator<char>() };
+	CubeMapData cubeMap;
+	ASSERT_TRUE(cubeMap.LoadDDS(data.data(), data.size()));
+	const std::uint32_t faceSize{ cubeMap.FaceSize() };
+	ASSERT_EQ(faceSize, 16U);
+
+	// It already stores irradiance / PI, so it is not convolved
+	SphericalHarmonics::Coefficients coefficients;
+	for (std::uint32_t face = 0U; face < SphericalHarmonics::sCubeMapFaceCount; ++face) {
+		SphericalHarmonics::ProjectCubeMapRows(cubeMap.FaceTexels(face), face, faceSize, 0U, faceSize, coefficients);
+	}
+
+	// Absolute error relative to the mean value, weighted by texel solid angles
+	double absoluteError{ 0.0 };
+	double value{ 0.0 };
+	for (std::uint32_t face = 0U; face < SphericalHarmonics::sCubeMapFaceCount; ++face) {
+		const float* texels{ cubeMap.FaceTexels(face) };
+		for (std::uint32_t y = 0U; y < faceSize; ++y) {
+			for (std::uint32_t x = 0U; x < faceSize; ++x) {
+				float direction[3U];
+				SphericalHarmonics::CubeMapTexelDirection(face, x, y, faceSize, direction);
+				float rgb[3U];
+				SphericalHarmonics::Evaluate(coefficients, direction, rgb);
+				const float solidAngle{ SphericalHarmonics::CubeMapTexelSolidAngle(x, y, faceSize) };
+				const float* texel{ texels + (y * faceSize + x) * 4UL };
+				for (std::uint32_t j = 0U; j < 3U; ++j) {
+					absoluteError += std::fabs(rgb[j] - texel[j]) * solidAngle;
+					value += std::fabs(texel[j]) * solidAngle;
+				}
+			}
+		}
+	}
+
+	ASSERT_GT(value, 0.0);
+	const double meanAbsoluteError{ absoluteError / value };
+	EXPECT_LT(meanAbsoluteError, 0.065);
+}
@@ -0,0 +1,379 @@
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <GeometryGenerator/TangentFrames.h>
+
+namespace {
+	const float sTolerance{ 1.0e-4f };
+
+	// Interleaved vertex, with the attribute order of GeometryGenerator::Vertex
+	struct Vertex {
+		float mPosition[3U];
+		float mNormal[3U];
+		float mTangent[4U];
+		float mTexCoord[2U];
+	};
+
+	struct Mesh {
+		std::vector<Vertex> mVertices;
+		std::vector<std::uint32_t> mIndices;
+	};
+
+	void AddVertex(const float x, const float y, const float z, const float u, const float v, Mesh& mesh) {
+		mesh.mVertices.push_back(Vertex{ { x, y, z }, { 0.0f, 0.0f, 1.0f }, { 0.0f, 0.0f, 0.0f, 0.0f }, { u, v } });
+	}
+
+	void AddTriangle(const std::uint32_t i0, const std::uint32_t i1, const std::uint32_t i2, Mesh& mesh) {
+		mesh.mIndices.push_back(i0);
+		mesh.mIndices.push_back(i1);
+		mesh.mIndices.push_back(i2);
+	}
+
+	void ComputeTangentFrames(Mesh& mesh) {
+		TangentFrames::VertexLayout layout;
+		layout.mStride = sizeof(Vertex);
+		layout.mPositionOffset = offsetof(Vertex, mPosition);
+		layout.mNormalOffset = offsetof(Vertex, mNormal);
+		layout.mTangentOffset = offsetof(Vertex, mTangent);
+		layout.mTexCoordOffset = offsetof(Vertex, mTexCoord);
+		TangentFrames::Compute(mesh.mVertices.data(), mesh.mVertices.size(), layout, mesh.mIndices.data(), mesh.mIndices.size());
+	}
+
+	// Triangle in the xy plane (normal +z) with u along +x and v along +y
+	Mesh RightHandedTriangle() {
+		Mesh mesh;
+		AddVertex(0.0f, 0.0f, 0.0f, 0.0f, 0.0f, mesh);
+		AddVertex(1.0f, 0.0f, 0.0f, 1.0f, 0.0f, mesh);
+		AddVertex(0.0f, 1.0f, 0.0f, 0.0f, 1.0f, mesh);
+		AddTriangle(0U, 1U, 2U, mesh);
+		return mesh;
+	}
+
+	// Grid of a height field with smooth normals. Texture coordinates are mirrored
+	// at x = 0 (u = |x|), as meshes that share a texture between both halves.
+	// There are no vertices at x = 0, where tangents of both halves would cancel.
+	Mesh MirroredHeightField(const std::uint32_t size) {
+		Mesh mesh;
+		for (std::uint32_t i = 0U; i <= size; ++i) {
+			for (std::uint32_t j = 0U; j <= size; ++j) {
+				const float x{ -1.0f + 2.0f * j / size + 0.5f / size };
+				const float y{ -1.0f + 2.0f * i / size };
+				const float z{ 0.2f * std::sin(3.0f * x) * std::cos(2.0f * y) };
+				const float dzdx{ 0.6f * std::cos(3.0f * x) * std::cos(2.0f * y) };
+				const float dzdy{ -0.4f * std::sin(3.0f * x) * std::sin(2.0f * y) };
+				const float invLength{ 1.0f / std::sqrt(dzdx * dzdx + dzdy * dzdy + 1.0f) };
+				mesh.mVertices.push_back(Vertex{
+					{ x, y, z },
+					{ -dzdx * invLength, -dzdy * invLength, invLength },
+					{ 0.0f, 0.0f, 0.0f, 0.0f },
+					{ std::fabs(x), 0.5f * y + 0.5f } });
+			}
+		}
+		for (std::uint32_t i = 0U; i < size; ++i) {
+			for (std::uint32_t j = 0U; j < size; ++j) {
+				const std::uint32_t v0{ i * (size + 1U) + j };
+				AddTriangle(v0, v0 + 1U, v0 + size + 1U, mesh);
+				AddTriangle(v0 + 1U, v0 + size + 2U, v0 + size + 1U, mesh);
+			}
+		}
+		return mesh;
+	}
+
+	// Same triangles, each one with its own 3 vertices (as meshes whose vertices
+	// are split by other attributes, or not indexed)
+	Mesh TriangleSoup(const Mesh& mesh) {
+		Mesh soup;
+		for (const std::uint32_t index : mesh.mIndices) {
+			soup.mIndices.push_back(static_cast<std::uint32_t>(soup.mVertices.size()));
+			soup.mVertices.push_back(mesh.mVertices[index]);
+		}
+		return soup;
+	}
+
+	bool IsSameVertex(const Vertex& a, const Vertex& b) {
+		for (std::uint32_t i = 0U; i < 3U; ++i) {
+			if (a.mPosition[i] != b.mPosition[i] || a.mNormal[i] != b.mNormal[i]) {
+				return false;
+			}
+		}
+		return a.mTexCoord[0U] == b.mTexCoord[0U] && a.mTexCoord[1U] == b.mTexCoord[1U];
+	}
+
+	// Straightforward MikkTSpace style tangent frame of a vertex, in double precision:
+	// the corner angle weighted sum of face tangents and bitangents of all the corners
+	// of all the vertices with the same position, normal and texture coordinates,
+	// projected onto the tangent plane, and then orthonormalized.
+	void ReferenceTangentFrame(const Mesh& mesh, const std::uint32_t vertexIndex, double frame[4U]) {
+		const Vertex& vertex{ mesh.mVertices[vertexIndex] };
+		const double nLength{ std::sqrt(
+			static_cast<double>(vertex.mNormal[0U]) * vertex.mNormal[0U] +
+			static_cast<double>(vertex.mNormal[1U]) * vertex.mNormal[1U] +
+			static_cast<double>(vertex.mNormal[2U]) * vertex.mNormal[2U]) };
+		const double n[3U]{ vertex.mNormal[0U] / nLength, vertex.mNormal[1U] / nLength, vertex.mNormal[2U] / nLength };
+
+		// Projects v onto the tangent plane and normalizes it (zero vectors stay zero)
+		const auto projectNormalize = [&n](double v[3U]) {
+			const double d{ v[0U] * n[0U] + v[1U] * n[1U] + v[2U] * n[2U] };
+			for (std::uint32_t k = 0U; k < 3U; ++k) {
+				v[k] -= n[k] * d;
+			}
+			const double length{ std::sqrt(v[0U] * v[0U] + v[1U] * v[1U] + v[2U] * v[2U]) };
+			for (std::uint32_t k = 0U; k < 3U && length > 0.0; ++k) {
+				v[k] /= length;
+			}
+		};
+
+		double tangent[3U]{ 0.0, 0.0, 0.0 };
+		double bitangent[3U]{ 0.0, 0.0, 0.0 };
+		for (std::size_t c = 0UL; c < mesh.mIndices.size(); ++c) {
+			if (IsSameVertex(mesh.mVertices[mesh.mIndices[c]], vertex) == false) {
+				continue;
+			}
+
+			const std::size_t base{ c - c % 3UL };
+			const Vertex& v0{ mesh.mVertices[mesh.mIndices[c]] };
+			const Vertex& v1{ mesh.mVertices[mesh.mIndices[base + (c - base + 1UL) % 3UL]] };
+			const Vertex& v2{ mesh.mVertices[mesh.mIndices[base + (c - base + 2UL) % 3UL]] };
+
+			double e1[3U];
+			double e2[3U];
+			for (std::uint32_t k = 0U; k < 3U; ++k) {
+				e1[k] = static_cast<double>(v1.mPosition[k]) - v0.mPosition[k];
+				e2[k] = static_cast<double>(v2.mPosition[k]) - v0.mPosition[k];
+			}
+			const double du1{ static_cast<double>(v1.mTexCoord[0U]) - v0.mTexCoord[0U] };
+			const double dv1{ static_cast<double>(v1.mTexCoord[1U]) - v0.mTexCoord[1U] };
+			const double du2{ static_cast<double>(v2.mTexCoord[0U]) - v0.mTexCoord[0U] };
+			const double dv2{ static_cast<double>(v2.mTexCoord[1U]) - v0.mTexCoord[1U] };
+			const double signedArea{ du1 * dv2 - du2 * dv1 };
+			if (std::fabs(signedArea) < 1.0e-20) {
+				continue;
+			}
+
+			// Face tangent and bitangent (scaled by the signed area, so they flip if mirrored)
+			double faceTangent[3U];
+			double faceBitangent[3U];
+			for (std::uint32_t k = 0U; k < 3U; ++k) {
+				faceTangent[k] = (e1[k] * dv2 - e2[k] * dv1) * signedArea;
+				faceBitangent[k] = (e2[k] * du1 - e1[k] * du2) * signedArea;
+			}
+			projectNormalize(faceTangent);
+			projectNormalize(faceBitangent);
+
+			// Corner angle in the tangent plane
+			projectNormalize(e1);
+			projectNormalize(e2);
+			const double cosAngle{ e1[0U] * e2[0U] + e1[1U] * e2[1U] + e1[2U] * e2[2U] };
+			const double angle{ std::acos(cosAngle < -1.0 ? -1.0 : (cosAngle > 1.0 ? 1.0 : cosAngle)) };
+
+			for (std::uint32_t k = 0U; k < 3U; ++k) {
+				tangent[k] += faceTangent[k] * angle;
+				bitangent[k] += faceBitangent[k] * angle;
+			}
+		}
+
+		projectNormalize(tangent);
+		const double cross[3U]{
+			n[1U] * tangent[2U] - n[2U] * tangent[1U],
+			n[2U] * tangent[0U] - n[0U] * tangent[2U],
+			n[0U] * tangent[1U] - n[1U] * tangent[0U] };
+		frame[0U] = tangent[0U];
+		frame[1U] = tangent[1U];
+		frame[2U] = tangent[2U];
+		frame[3U] = cross[0U] * bitangent[0U] + cross[1U] * bitangent[1U] + cross[2U] * bitangent[2U] < 0.0 ? -1.0 : 1.0;
+	}
+
+	void ExpectTangent(const Vertex& vertex, const float x, const float y, const float z, const float w) {
+		EXPECT_NEAR(vertex.mTangent[0U], x, sTolerance);
+		EXPECT_NEAR(vertex.mTangent[1U], y, sTolerance);
+		EXPECT_NEAR(vertex.mTangent[2U], z, sTolerance);
+		EXPECT_EQ(vertex.mTangent[3U], w);
+	}
+
+	// Unit length, perpendicular to normal and valid handedness
+	void ExpectValidFrame(const Vertex& vertex) {
+		const float* t{ vertex.mTangent };
+		const float* n{ vertex.mNormal };
+		ASSERT_TRUE(std::isfinite(t[0U]) && std::isfinite(t[1U]) && std::isfinite(t[2U]));
+		EXPECT_NEAR(t[0U] * t[0U] + t[1U] * t[1U] + t[2U] * t[2U], 1.0f, sTolerance);
+		EXPECT_NEAR((t[0U] * n[0U] + t[1U] * n[1U] + t[2U] * n[2U]) / std::sqrt(n[0U] * n[0U] + n[1U] * n[1U] + n[2U] * n[2U]), 0.0f, sTolerance);
+		EXPECT_TRUE(t[3U] == 1.0f || t[3U] == -1.0f);
+	}
+}
+
+TEST(TangentFrames, RightHandedFrame) {
+	Mesh mesh{ RightHandedTriangle() };
+	ComputeTangentFrames(mesh);
+
+	// bitangent = cross(+z, +x) * w = +y
+	for (const Vertex& vertex : mesh.mVertices) {
+		ExpectTangent(vertex, 1.0f, 0.0f, 0.0f, 1.0f);
+	}
+}
+
+TEST(TangentFrames, MirroredTexCoordsFlipHandedness) {
+	// u grows along -x, v along +y
+	Mesh mesh;
+	AddVertex(0.0f, 0.0f, 0.0f, 1.0f, 0.0f, mesh);
+	AddVertex(1.0f, 0.0f, 0.0f, 0.0f, 0.0f, mesh);
+	AddVertex(0.0f, 1.0f, 0.0f, 1.0f, 1.0f, mesh);
+	AddTriangle(0U, 1U, 2U, mesh);
+	ComputeTangentFrames(mesh);
+
+	// bitangent = cross(+z, -x) * w = +y
+	for (const Vertex& vertex : mesh.mVertices) {
+		ExpectTangent(vertex, -1.0f, 0.0f, 0.0f, -1.0f);
+	}
+}
+
+TEST(TangentFrames, MirroredGeometryMatchesTransformedFrame) {
+	// Mirroring positions (x -> -x) must give the transformed tangent with flipped
+	// handedness, which is what geometry pass vertex shaders do for world matrices
+	// with negative determinant.
+	Mesh mesh{ RightHandedTriangle() };
+	for (Vertex& vertex : mesh.mVertices) {
+		vertex.mPosition[0U] = -vertex.mPosition[0U];
+	}
+	ComputeTangentFrames(mesh);
+
+	for (const Vertex& vertex : mesh.mVertices) {
+		ExpectTangent(vertex, -1.0f, 0.0f, 0.0f, -1.0f);
+	}
+}
+
+TEST(TangentFrames, DegeneratedTexCoords) {
+	// All the texture coordinates are equal, so there is no tangent to compute
+	Mesh mesh;
+	AddVertex(0.0f, 0.0f, 0.0f, 0.5f, 0.5f, mesh);
+	AddVertex(1.0f, 0.0f, 0.0f, 0.5f, 0.5f, mesh);
+	AddVertex(0.0f, 1.0f, 0.0f, 0.5f, 0.5f, mesh);
+	AddTriangle(0U, 1U, 2U, mesh);
+	ComputeTangentFrames(mesh);
+
+	for (const Vertex& vertex : mesh.mVertices) {
+		ExpectValidFrame(vertex);
+	}
+}
+
+TEST(TangentFrames, DegeneratedNeighborIsIgnored) {
+	// Vertex 0 is shared by a valid triangle and by one with collapsed texture coordinates
+	Mesh mesh{ RightHandedTriangle() };
+	AddVertex(-1.0f, 0.0f, 0.0f, 0.0f, 0.0f, mesh);
+	AddVertex(0.0f, -1.0f, 0.0f, 0.0f, 0.0f, mesh);
+	AddTriangle(0U, 3U, 4U, mesh);
+	ComputeTangentFrames(mesh);
+
+	ExpectTangent(mesh.mVertices[0U], 1.0f, 0.0f, 0.0f, 1.0f);
+	ExpectValidFrame(mesh.mVertices[3U]);
+	ExpectValidFrame(mesh.mVertices[4U]);
+}
+
+TEST(TangentFrames, CornerAngleWeighting) {
+	// Vertex 0 is shared by two triangles:
+	// - 90 degrees corner with face tangent +x
+	// - 45 degrees corner with face tangent +y
+	// so its tangent is (2, 1, 0) normalized (it would be (1, 1, 0) with equal weights).
+	Mesh mesh{ RightHandedTriangle() };
+	AddVertex(0.0f, 1.0f, 0.0f, 1.0f, 0.0f, mesh);
+	AddVertex(-1.0f, 1.0f, 0.0f, 1.0f, 1.0f, mesh);
+	AddTriangle(0U, 3U, 4U, mesh);
+	ComputeTangentFrames(mesh);
+
+	const float invLength{ 1.0f / std::sqrt(5.0f) };
+	ExpectTangent(mesh.mVertices[0U], 2.0f * invLength, invLength, 0.0f, 1.0f);
+
+	// Vertices that only belong to one triangle keep its face tangent. Vertices 2 and 3
+	// have the same position and normal but different texture coordinates (a seam), so
+	// they are not welded.
+	ExpectTangent(mesh.mVertices[1U], 1.0f, 0.0f, 0.0f, 1.0f);
+	ExpectTangent(mesh.mVertices[2U], 1.0f, 0.0f, 0.0f, 1.0f);
+	ExpectTangent(mesh.mVertices[3U], 0.0f, 1.0f, 0.0f, 1.0f);
+	ExpectTangent(mesh.mVertices[4U], 0.0f, 1.0f, 0.0f, 1.0f);
+}
+
+// Vertices with the same position, normal and texture coordinates are welded,
+// so a mesh gets the same frames with its vertices shared or split
+TEST(TangentFrames, WeldsSplitVertices) {
+	Mesh mesh{ MirroredHeightField(16U) };
+	Mesh soup{ TriangleSoup(mesh) };
+	ComputeTangentFrames(mesh);
+	ComputeTangentFrames(soup);
+
+	for (std::size_t i = 0UL; i < soup.mIndices.size(); ++i) {
+		const Vertex& vertex{ mesh.mVertices[mesh.mIndices[i]] };
+		const Vertex& splitVertex{ soup.mVertices[soup.mIndices[i]] };
+		for (std::uint32_t j = 0U; j < 3U; ++j) {
+			ASSERT_NEAR(splitVertex.mTangent[j], vertex.mTangent[j], 1.0e-5f) << i;
+		}
+		ASSERT_EQ(splitVertex.mTangent[3U], vertex.mTangent[3U]) << i;
+	}
+
+	// -0.0 and 0.0 are the same coordinate
+	Mesh signedZeroMesh{ RightHandedTriangle() };
+	AddVertex(-0.0f, 0.0f, 0.0f, -0.0f, 0.0f, signedZeroMesh);
+	AddVertex(0.0f, -1.0f, 0.0f, 0.0f, -1.0f, signedZeroMesh);
+	AddVertex(1.0f, -1.0f, 0.0f, 0.0f, -1.0f, signedZeroMesh);
+	AddTriangle(3U, 4U, 5U, signedZeroMesh);
+	ComputeTangentFrames(signedZeroMesh);
+	for (std::uint32_t j = 0U; j < 4U; ++j) {
+		EXPECT_EQ(signedZeroMesh.mVertices[0U].mTangent[j], signedZeroMesh.mVertices[3U].mTangent[j]);
+	}
+}
+
+// Frames match a straightforward double precision implementation, with
+// mirrored texture coordinates and split vertices
+TEST(TangentFrames, MatchesReference) {
+	Mesh mesh{ MirroredHeightField(12U) };
+
+	// Split the vertices of the first rows of triangles
+	const std::size_t splitIndexCount{ mesh.mIndices.size() / 4UL };
+	for (std::size_t i = 0UL; i < splitIndexCount; ++i) {
+		mesh.mVertices.push_back(mesh.mVertices[mesh.mIndices[i]]);
+		mesh.mIndices[i] = static_cast<std::uint32_t>(mesh.mVertices.size() - 1UL);
+	}
+	ComputeTangentFrames(mesh);
+
+	std::uint32_t leftHandedCount{ 0U };
+	for (std::uint32_t i = 0U; i < mesh.mVertices.size(); ++i) {
+		const Vertex& vertex{ mesh.mVertices[i] };
+		ExpectValidFrame(vertex);
+
+		double frame[4U];
+		ReferenceTangentFrame(mesh, i, frame);
+		for (std::uint32_t j = 0U; j < 3U; ++j) {
+			ASSERT_NEAR(vertex.mTangent[j], frame[j], 1.0e-4) << i;
+		}
+		ASSERT_EQ(vertex.mTangent[3U], frame[3U]) << i;
+		leftHandedCount += vertex.mTangent[3U] < 0.0f ? 1U : 0U;
+	}
+
+	// Both halves are represented
+	EXPECT_GT(leftHandedCount, 0U);
+	EXPECT_LT(leftHandedCount, mesh.mVertices.size());
+}
+
+TEST(TangentFrames, OrthonormalizeTangent) {
+	const float normal[3U]{ 0.0f, 0.0f, 2.0f };
+	const float tangent[3U]{ 3.0f, 0.0f, 1.0f };
+	const float bitangent[3U]{ 0.0f, 1.0f, 0.0f };
+	const float negativeBitangent[3U]{ 0.0f, -1.0f, 0.0f };
+	Vertex vertex{};
+
+	// Gram-Schmidt removes the normal component and normalizes
+	TangentFrames::OrthonormalizeTangent(normal, tangent, bitangent, vertex.mTangent);
+	ExpectTangent(vertex, 1.0f, 0.0f, 0.0f, 1.0f);
+
+	// Handedness comes from the bitangent side
+	TangentFrames::OrthonormalizeTangent(normal, tangent, negativeBitangent, vertex.mTangent);
+	ExpectTangent(vertex, 1.0f, 0.0f, 0.0f, -1.0f);
+
+	// A tangent parallel to the normal is replaced by any perpendicular one
+	const float parallelTangent[3U]{ 0.0f, 0.0f, 1.0f };
+	TangentFrames::OrthonormalizeTangent(normal, parallelTangent, bitangent, vertex.mTangent);
+	EXPECT_NEAR(vertex.mTangent[0U] * vertex.mTangent[0U] + vertex.mTangent[1U] * vertex.mTangent[1U] + vertex.mTangent[2U] * vertex.mTangent[2U], 1.0f, sTolerance);
+	EXPECT_NEAR(vertex.mTangent[2U], 0.0f, sTolerance);
+}
@@ -0,0 +1,91 @@
+#include <cmath>
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+#include <GeometryGenerator/GeometryGenerator.h>
+#include <GeometryGenerator/TangentGenerator.h>
+
+using namespace DirectX;
+
+namespace {
+	const float sTolerance{ 1.0e-4f };
+
+	void AddVertex(const XMFLOAT3& position, const XMFLOAT2& texCoord, GeometryGenerator::MeshData& meshData) {
+		meshData.mVertices.push_back(GeometryGenerator::Vertex{ position, XMFLOAT3{ 0.0f, 0.0f, 1.0f }, XMFLOAT3{ 0.0f, 0.0f, 0.0f }, texCoord });
+	}
+
+	void AddTriangle(const std::uint32_t i0, const std::uint32_t i1, const std::uint32_t i2, GeometryGenerator::MeshData& meshData) {
+		meshData.mIndices32.push_back(i0);
+		meshData.mIndices32.push_back(i1);
+		meshData.mIndices32.push_back(i2);
+	}
+
+	// Triangle in the xy plane (normal +z) with u along +x and v along +y
+	GeometryGenerator::MeshData RightHandedTriangle() {
+		GeometryGenerator::MeshData meshData;
+		AddVertex(XMFLOAT3{ 0.0f, 0.0f, 0.0f }, XMFLOAT2{ 0.0f, 0.0f }, meshData);
+		AddVertex(XMFLOAT3{ 1.0f, 0.0f, 0.0f }, XMFLOAT2{ 1.0f, 0.0f }, meshData);
+		AddVertex(XMFLOAT3{ 0.0f, 1.0f, 0.0f }, XMFLOAT2{ 0.0f, 1.0f }, meshData);
+		AddTriangle(0U, 1U, 2U, meshData);
+		return meshData;
+	}
+
+	void ExpectTangent(const XMFLOAT4& tangent, const float x, const float y, const float z, const float w) {
+		EXPECT_NEAR(tangent.x, x, sTolerance);
+		EXPECT_NEAR(tangent.y, y, sTolerance);
+		EXPECT_NEAR(tangent.z, z, sTolerance);
+		EXPECT_EQ(tangent.w, w);
+	}
+
+	// Unit length, perpendicular to normal and valid handedness
+	void ExpectValidFrame(const GeometryGenerator::Vertex& vertex) {
+		const XMFLOAT4& t = vertex.mTangentU;
+		const XMFLOAT3& n = vertex.mNormal;
+		ASSERT_TRUE(std::isfinite(t.x) && std::isfinite(t.y) && std::isfinite(t.z));
+		EXPECT_NEAR(t.x * t.x + t.y * t.y + t.z * t.z, 1.0f, sTolerance);
+		EXPECT_NEAR((t.x * n.x + t.y * n.y + t.z * n.z) / std::sqrt(n.x * n.x + n.y * n.y + n.z * n.z), 0.0f, sTolerance);
+		EXPECT_TRUE(t.w == 1.0f || t.w == -1.0f);
+	}
+}
+
+TEST(TangentGenerator, RightHandedFrame) {
+	GeometryGenerator::MeshData meshData{ RightHandedTriangle() };
+	TangentGenerator::ComputeTangentFrames(meshData);
+
+	// bitangent = cross(+z, +x) * w = +y
+	for (const GeometryGenerator::Vertex& vertex : meshData.mVertices) {
+		ExpectTangent(vertex.mTangentU, 1.0f, 0.0f, 0.0f, 1.0f);
+	}
+}
+
+TEST(TangentGenerator, GeneratedMeshesHaveValidFrames) {
+	GeometryGenerator::MeshData sphere;
+	GeometryGenerator::CreateSphere(1.0f, 32U, 32U, sphere);
+	TangentGenerator::ComputeTangentFrames(sphere);
+	for (const GeometryGenerator::Vertex& vertex : sphere.mVertices) {
+		ExpectValidFrame(vertex);
+	}
+
+	GeometryGenerator::MeshData grid;
+	GeometryGenerator::CreateGrid(10.0f, 10.0f, 16U, 16U, grid);
+	TangentGenerator::ComputeTangentFrames(grid);
+	for (const GeometryGenerator::Vertex& vertex : grid.mVertices) {
+		ExpectValidFrame(vertex);
+	}
+}
+
+TEST(TangentGenerator, OrthonormalizeTangent) {
+	const XMFLOAT3 normal{ 0.0f, 0.0f, 2.0f };
+
+	// Gram-Schmidt removes the normal component and normalizes
+	ExpectTangent(TangentGenerator::OrthonormalizeTangent(normal, XMFLOAT3{ 3.0f, 0.0f, 1.0f }, XMFLOAT3{ 0.0f, 1.0f, 0.0f }), 1.0f, 0.0f, 0.0f, 1.0f);
+
+	// Handedness comes from the bitangent side
+	ExpectTangent(TangentGenerator::OrthonormalizeTangent(normal, XMFLOAT3{ 3.0f, 0.0f, 1.0f }, XMFLOAT3{ 0.0f, -1.0f, 0.0f }), 1.0f, 0.0f, 0.0f, -1.0f);
+
+	// A tangent parallel to the normal is replaced by any perpendicular one
+	const XMFLOAT4 tangent{ TangentGenerator::OrthonormalizeTangent(normal, XMFLOAT3{ 0.0f, 0.0f, 1.0f }, XMFLOAT3{ 0.0f, 1.0f, 0.0f }) };
+	EXPECT_NEAR(tangent.x * tangent.x + tangent.y * tangent.y + tangent.z * tangent.z, 1.0f, sTolerance);
+	EXPECT_NEAR(tangent.z, 0.0f, sTolerance);
+}
@@ -0,0 +1,138 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <Utils/TaskGraph.h>
+
+namespace {
+	// Order of start and end events of a task, from a counter shared by all tasks
+	struct TaskEvents {
+		std::uint32_t mStart{ 0U };
+		std::uint32_t mEnd{ 0U };
+		std::uint32_t mRunCount{ 0U };
+	};
+}
+
+TEST(TaskGraph, Empty) {
+	TaskGraph graph;
+	graph.Run();
+	EXPECT_EQ(graph.TaskCount(), 0U);
+}
+
+// A task starts after all its dependencies ended, and each task runs once
+TEST(TaskGraph, DependencyOrder) {
+	std::mt19937 generator{ 1U };
+	const std::uint32_t taskCount{ 500U };
+	std::vector<TaskEvents> events(taskCount);
+	std::vector<std::vector<std::uint32_t>> dependencies(taskCount);
+	std::atomic<std::uint32_t> eventCounter{ 0U };
+
+	TaskGraph graph;
+	for (std::uint32_t i = 0U; i < taskCount; ++i) {
+		// Dependencies among previous tasks: up to 8 for even tasks (added with a vector),
+		// and up to 3 for odd tasks (added with an initializer_list)
+		std::vector<std::uint32_t>& taskDependencies(dependencies[i]);
+		const std::uint32_t maxDependencyCount{ i % 2U == 0U ? 8U : 3U };
+		const std::uint32_t dependencyCount{ static_cast<std::uint32_t>(generator() % (maxDependencyCount + 1U)) };
+		for (std::uint32_t j = 0U; i > 0U && j < dependencyCount; ++j) {
+			taskDependencies.push_back(generator() % i);
+		}
+		std::sort(taskDependencies.begin(), taskDependencies.end());
+		taskDependencies.erase(std::unique(taskDependencies.begin(), taskDependencies.end()), taskDependencies.end());
+
+		TaskEvents& taskEvents(events[i]);
+		const std::function<void()> function{ [&taskEvents, &eventCounter]() {
+			taskEvents.mStart = eventCounter++;
+			++taskEvents.mRunCount;
+			taskEvents.mEnd = eventCounter++;
+		} };
+
+		if (i % 2U == 0U) {
+			graph.AddTask("Task", function, taskDependencies);
+			continue;
+		}
+
+		switch (taskDependencies.size()) {
+		case 0U:
+			graph.AddTask("Task", function);
+			break;
+		case 1U:
+			graph.AddTask("Task", function, { taskDependencies[0U] });
+			break;
+		case 2U:
+			graph.AddTask("Task", function, { taskDependencies[0U], taskDependencies[1U] });
+			break;
+		default:
+			graph.AddTask("Task", function, { taskDependencies[0U], taskDependencies[1U], taskDependencies[2U] });
+			break;
+		}
+	}
+
+	graph.Run();
+	EXPECT_EQ(eventCounter, taskCount * 2U);
+	for (std::uint32_t i = 0U; i < taskCount; ++i) {
+		ASSERT_EQ(events[i].mRunCount, 1U) << "task " << i;
+		for (const std::uint32_t dependency : dependencies[i]) {
+			ASSERT_LT(events[dependency].mEnd, events[i].mStart) << "task " << i << ", dependency " << dependency;
+			ASSERT_LE(graph.TaskEndTime(dependency), graph.TaskStartTime(i)) << "task " << i << ", dependency " << dependency;
+		}
+	}
+}
+
+// Serial tasks do not overlap, even without dependencies between them
+TEST(TaskGraph, SerialTasks) {
+	std::atomic<std::uint32_t> runningSerialCount{ 0U };
+	std::atomic<std::uint32_t> maxRunningSerialCount{ 0U };
+	std::atomic<std::uint32_t> finishedCount{ 0U };
+
+	TaskGraph graph;
+	const std::uint32_t root{ graph.AddTask("Root", []() {}) };
+	for (std::uint32_t i = 0U; i < 32U; ++i) {
+		const bool serial{ i % 2U == 0U };
+		graph.AddTask(serial ? "Serial" : "Parallel", [&, serial]() {
+			if (serial) {
+				const std::uint32_t running{ ++runningSerialCount };
+				std::uint32_t maxRunning{ maxRunningSerialCount };
+				while (running > maxRunning && !maxRunningSerialCount.compare_exchange_weak(maxRunning, running)) {
+				}
+			}
+			std::this_thread::sleep_for(std::chrono::microseconds(200));
+			if (serial) {
+				--runningSerialCount;
+			}
+			++finishedCount;
+		}, { root }, serial);
+	}
+
+	graph.Run();
+	EXPECT_EQ(finishedCount, 32U);
+	EXPECT_EQ(maxRunningSerialCount, 1U);
+}
+
+TEST(TaskGraph, WriteTrace) {
+	TaskGraph graph;
+	const std::uint32_t load{ graph.AddTask("LoadTextures", []() {}) };
+	graph.AddTask("CreatePSOs", []() {});
+	graph.AddTask("UploadTextures", []() {}, { load }, true);
+	graph.Run();
+	EXPECT_GE(graph.RunTime(), graph.TaskEndTime(2U));
+
+	const std::string path{ std::string(BRE_TEST_FILES_PATH) + "TaskGraphTrace.json" };
+	ASSERT_TRUE(graph.WriteTrace(path.c_str()));
+	std::ifstream file(path);
+	const std::string trace{ std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+	EXPECT_EQ(trace.find("{\"traceEvents\":["), 0UL);
+	EXPECT_NE(trace.find("\"name\":\"LoadTextures\",\"cat\":\"parallel\""), std::string::npos);
+	EXPECT_NE(trace.find("\"name\":\"CreatePSOs\",\"cat\":\"parallel\""), std::string::npos);
+	EXPECT_NE(trace.find("\"name\":\"UploadTextures\",\"cat\":\"serial\""), std::string::npos);
+}
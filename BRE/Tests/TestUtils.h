@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+
+// Helpers shared by tests and benchmarks of culling and light structures.
+// Matrices are row major with row vectors (as DirectXMath), and projections
+// are left handed with clip space depth in [0, 1] (as D3D).
+namespace TestUtils {
+	inline void Multiply(const float a[16U], const float b[16U], float result[16U]) noexcept {
+		for (std::uint32_t i = 0U; i < 4U; ++i) {
+			for (std::uint32_t j = 0U; j < 4U; ++j) {
+				float sum{ 0.0f };
+				for (std::uint32_t k = 0U; k < 4U; ++k) {
+					sum += a[i * 4U + k] * b[k * 4U + j];
+				}
+				result[i * 4U + j] = sum;
+			}
+		}
+	}
+
+	// View matrix of a camera at eye looking at target, with +y up
+	inline void LookAt(const float eye[3U], const float target[3U], float view[16U]) noexcept {
+		float z[3U]{ target[0U] - eye[0U], target[1U] - eye[1U], target[2U] - eye[2U] };
+		const float zLength{ std::sqrt(z[0U] * z[0U] + z[1U] * z[1U] + z[2U] * z[2U]) };
+		for (float& c : z) {
+			c /= zLength;
+		}
+
+		// x = cross(up, z), y = cross(z, x)
+		const float up[3U]{ std::fabs(z[1U]) > 0.99f ? 1.0f : 0.0f, std::fabs(z[1U]) > 0.99f ? 0.0f : 1.0f, 0.0f };
+		float x[3U]{ up[1U] * z[2U] - up[2U] * z[1U], up[2U] * z[0U] - up[0U] * z[2U], up[0U] * z[1U] - up[1U] * z[0U] };
+		const float xLength{ std::sqrt(x[0U] * x[0U] + x[1U] * x[1U] + x[2U] * x[2U]) };
+		for (float& c : x) {
+			c /= xLength;
+		}
+		const float y[3U]{ z[1U] * x[2U] - z[2U] * x[1U], z[2U] * x[0U] - z[0U] * x[2U], z[0U] * x[1U] - z[1U] * x[0U] };
+
+		for (std::uint32_t i = 0U; i < 3U; ++i) {
+			view[i * 4U] = x[i];
+			view[i * 4U + 1U] = y[i];
+			view[i * 4U + 2U] = z[i];
+			view[i * 4U + 3U] = 0.0f;
+		}
+		view[12U] = -(x[0U] * eye[0U] + x[1U] * eye[1U] + x[2U] * eye[2U]);
+		view[13U] = -(y[0U] * eye[0U] + y[1U] * eye[1U] + y[2U] * eye[2U]);
+		view[14U] = -(z[0U] * eye[0U] + z[1U] * eye[1U] + z[2U] * eye[2U]);
+		view[15U] = 1.0f;
+	}
+
+	inline void Perspective(const float fovY, const float aspectRatio, const float nearZ, const float farZ, float projection[16U]) noexcept {
+		const float yScale{ 1.0f / std::tan(fovY * 0.5f) };
+		const float range{ farZ / (farZ - nearZ) };
+		for (std::uint32_t i = 0U; i < 16U; ++i) {
+			projection[i] = 0.0f;
+		}
+		projection[0U] = yScale / aspectRatio;
+		projection[5U] = yScale;
+		projection[10U] = range;
+		projection[11U] = 1.0f;
+		projection[14U] = -range * nearZ;
+	}
+
+	inline void LookAtPerspective(
+		const float eye[3U],
+		const float target[3U],
+		const float fovY,
+		const float aspectRatio,
+		const float nearZ,
+		const float farZ,
+		float viewProj[16U]) noexcept {
+		float view[16U];
+		float projection[16U];
+		LookAt(eye, target, view);
+		Perspective(fovY, aspectRatio, nearZ, farZ, projection);
+		Multiply(view, projection, viewProj);
+	}
+
+	// Transforms point by a row major matrix and returns clip space w
+	inline float TransformPoint(const float point[3U], const float matrix[16U], float clip[3U]) noexcept {
+		float result[4U];
+		for (std::uint32_t j = 0U; j < 4U; ++j) {
+			result[j] = point[0U] * matrix[j] + point[1U] * matrix[4U + j] + point[2U] * matrix[8U + j] + matrix[12U + j];
+		}
+		clip[0U] = result[0U];
+		clip[1U] = result[1U];
+		clip[2U] = result[2U];
+		return result[3U];
+	}
+
+	inline float RandF(std::mt19937& generator, const float min, const float max) noexcept {
+		return std::uniform_real_distribution<float>{ min, max }(generator);
+	}
+}
@@ -0,0 +1,251 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <MathUtils/TransformHierarchy.h>
+#include <Tests/TestUtils.h>
+
+namespace {
+	struct LocalTransform {
+		float mTranslation[3U];
+		float mRotation[4U];
+		float mScale[3U];
+	};
+
+	// Rotates v by the unit quaternion q: v + 2w (q x v) + 2 q x (q x v)
+	void Rotate(const float q[4U], const float v[3U], float result[3U]) {
+		const float t[3U]{
+			2.0f * (q[1U] * v[2U] - q[2U] * v[1U]),
+			2.0f * (q[2U] * v[0U] - q[0U] * v[2U]),
+			2.0f * (q[0U] * v[1U] - q[1U] * v[0U]) };
+		result[0U] = v[0U] + q[3U] * t[0U] + (q[1U] * t[2U] - q[2U] * t[1U]);
+		result[1U] = v[1U] + q[3U] * t[1U] + (q[2U] * t[0U] - q[0U] * t[2U]);
+		result[2U] = v[2U] + q[3U] * t[2U] + (q[0U] * t[1U] - q[1U] * t[0U]);
+	}
+
+	// Reference local matrix: rows are the scaled and rotated basis vectors, and translation
+	void LocalMatrix(const LocalTransform& transform, float m[16U]) {
+		for (std::uint32_t i = 0U; i < 3U; ++i) {
+			const float axis[3U]{ i == 0U ? 1.0f : 0.0f, i == 1U ? 1.0f : 0.0f, i == 2U ? 1.0f : 0.0f };
+			float row[3U];
+			Rotate(transform.mRotation, axis, row);
+			for (std::uint32_t j = 0U; j < 3U; ++j) {
+				m[i * 4U + j] = row[j] * transform.mScale[i];
+			}
+			m[i * 4U + 3U] = 0.0f;
+		}
+		for (std::uint32_t j = 0U; j < 3U; ++j) {
+			m[12U + j] = transform.mTranslation[j];
+		}
+		m[15U] = 1.0f;
+	}
+
+	LocalTransform RandomTransform(std::mt19937& generator) {
+		LocalTransform transform;
+		for (float& c : transform.mTranslation) {
+			c = TestUtils::RandF(generator, -10.0f, 10.0f);
+		}
+
+		float length{ 0.0f };
+		for (float& c : transform.mRotation) {
+			c = TestUtils::RandF(generator, -1.0f, 1.0f);
+			length += c * c;
+		}
+		length = std::sqrt(length);
+		for (float& c : transform.mRotation) {
+			c /= length;
+		}
+
+		for (float& c : transform.mScale) {
+			c = TestUtils::RandF(generator, 0.5f, 2.0f);
+		}
+
+		return transform;
+	}
+
+	// Brute force world matrices (nodes are in topological order)
+	std::vector<float> ReferenceWorldMatrices(const TransformHierarchy& hierarchy, const std::vector<LocalTransform>& transforms) {
+		std::vector<float> worlds(transforms.size() * 16UL);
+		for (std::uint32_t node = 0U; node < transforms.size(); ++node) {
+			float local[16U];
+			LocalMatrix(transforms[node], local);
+			const TransformHierarchy::Handle parent{ hierarchy.Parent(node) };
+			if (parent == TransformHierarchy::sInvalidHandle) {
+				std::copy(local, local + 16U, &worlds[node * 16UL]);
+			}
+			else {
+				TestUtils::Multiply(local, &worlds[parent * 16UL], &worlds[node * 16UL]);
+			}
+		}
+
+		return worlds;
+	}
+
+	// Tolerance is relative to the largest matrix element, because translations of deep nodes
+	// are sums of large terms that can cancel (and SIMD builds use fused multiply add).
+	void ExpectMatchesReference(const TransformHierarchy& hierarchy, const std::vector<LocalTransform>& transforms) {
+		const std::vector<float> worlds{ ReferenceWorldMatrices(hierarchy, transforms) };
+		for (std::uint32_t node = 0U; node < transforms.size(); ++node) {
+			float maxElement{ 1.0f };
+			for (std::uint32_t j = 0U; j < 16U; ++j) {
+				maxElement = std::max(maxElement, std::fabs(worlds[node * 16UL + j]));
+			}
+			for (std::uint32_t j = 0U; j < 16U; ++j) {
+				ASSERT_NEAR(hierarchy.WorldMatrix(node)[j], worlds[node * 16UL + j], 1.0e-4f * maxElement) << "node " << node << ", element " << j;
+			}
+		}
+	}
+
+	// Random forest with level sizes above the parallel update threshold
+	void BuildRandomHierarchy(std::mt19937& generator, const std::uint32_t nodeCount, TransformHierarchy& hierarchy, std::vector<LocalTransform>& transforms) {
+		for (std::uint32_t node = 0U; node < nodeCount; ++node) {
+			// A tenth of nodes are roots, and the others have a random previous parent
+			const bool isRoot{ node == 0U || generator() % 10U == 0U };
+			const TransformHierarchy::Handle parent{ isRoot ? TransformHierarchy::sInvalidHandle : static_cast<TransformHierarchy::Handle>(generator() % node) };
+			transforms.push_back(RandomTransform(generator));
+			const LocalTransform& transform(transforms.back());
+			EXPECT_EQ(hierarchy.AddNode(parent, transform.mTranslation, transform.mRotation, transform.mScale), node);
+		}
+	}
+}
+
+TEST(TransformHierarchy, KnownTransforms) {
+	TransformHierarchy hierarchy;
+
+	// Root rotates 90 degrees around z, and scales by 2. Child is translated along x.
+	const float halfSqrt2{ std::sqrt(0.5f) };
+	const float rootTranslation[3U]{ 0.0f, 0.0f, 5.0f };
+	const float rootRotation[4U]{ 0.0f, 0.0f, halfSqrt2, halfSqrt2 };
+	const float rootScale[3U]{ 2.0f, 2.0f, 2.0f };
+	const TransformHierarchy::Handle root{ hierarchy.AddNode(TransformHierarchy::sInvalidHandle, rootTranslation, rootRotation, rootScale) };
+
+	const float childTranslation[3U]{ 1.0f, 0.0f, 0.0f };
+	const float identityRotation[4U]{ 0.0f, 0.0f, 0.0f, 1.0f };
+	const float unitScale[3U]{ 1.0f, 1.0f, 1.0f };
+	const TransformHierarchy::Handle child{ hierarchy.AddNode(root, childTranslation, identityRotation, unitScale) };
+	EXPECT_EQ(hierarchy.Parent(child), root);
+	hierarchy.Update();
+
+	// Child origin: x axis is rotated to y, scaled by 2, and translated
+	const float* world{ hierarchy.WorldMatrix(child) };
+	EXPECT_NEAR(world[12U], 0.0f, 1.0e-6f);
+	EXPECT_NEAR(world[13U], 2.0f, 1.0e-6f);
+	EXPECT_NEAR(world[14U], 5.0f, 1.0e-6f);
+
+	// Child x axis
+	EXPECT_NEAR(world[0U], 0.0f, 1.0e-6f);
+	EXPECT_NEAR(world[1U], 2.0f, 1.0e-6f);
+	EXPECT_NEAR(world[2U], 0.0f, 1.0e-6f);
+}
+
+TEST(TransformHierarchy, MatchesBruteForce) {
+	std::mt19937 generator{ 1U };
+	TransformHierarchy hierarchy;
+	std::vector<LocalTransform> transforms;
+	BuildRandomHierarchy(generator, 20000U, hierarchy, transforms);
+	hierarchy.Update();
+	EXPECT_EQ(hierarchy.ChangedNodeCount(), hierarchy.NodeCount());
+	ExpectMatchesReference(hierarchy, transforms);
+
+	// Nothing changes without modifications
+	hierarchy.Update();
+	EXPECT_EQ(hierarchy.ChangedNodeCount(), 0U);
+	ExpectMatchesReference(hierarchy, transforms);
+}
+
+// Only modified nodes and their descendants are updated
+TEST(TransformHierarchy, ModifiedSubtrees) {
+	std::mt19937 generator{ 2U };
+	TransformHierarchy hierarchy;
+	std::vector<LocalTransform> transforms;
+	BuildRandomHierarchy(generator, 20000U, hierarchy, transforms);
+	hierarchy.Update();
+
+	for (std::uint32_t iteration = 0U; iteration < 3U; ++iteration) {
+		std::vector<std::uint8_t> expectedChanged(transforms.size(), 0U);
+		for (std::uint32_t i = 0U; i < 50U; ++i) {
+			const TransformHierarchy::Handle node{ static_cast<TransformHierarchy::Handle>(generator() % transforms.size()) };
+			const LocalTransform transform{ RandomTransform(generator) };
+			LocalTransform& nodeTransform(transforms[node]);
+			switch (i % 3U) {
+			case 0U:
+				std::copy(transform.mTranslation, transform.mTranslation + 3U, nodeTransform.mTranslation);
+				hierarchy.SetTranslation(node, transform.mTranslation);
+				break;
+			case 1U:
+				std::copy(transform.mRotation, transform.mRotation + 4U, nodeTransform.mRotation);
+				hierarchy.SetRotation(node, transform.mRotation);
+				break;
+			default:
+				std::copy(transform.mScale, transform.mScale + 3U, nodeTransform.mScale);
+				hierarchy.SetScale(node, transform.mScale);
+				break;
+			}
+			expectedChanged[node] = 1U;
+		}
+
+		std::uint32_t expectedChangedCount{ 0U };
+		for (std::uint32_t node = 0U; node < transforms.size(); ++node) {
+			const TransformHierarchy::Handle parent{ hierarchy.Parent(node) };
+			if (parent != TransformHierarchy::sInvalidHandle && expectedChanged[parent] != 0U) {
+				expectedChanged[node] = 1U;
+			}
+			expectedChangedCount += expectedChanged[node];
+		}
+
+		hierarchy.Update();
+		EXPECT_EQ(hierarchy.ChangedNodeCount(), expectedChangedCount);
+		for (std::uint32_t node = 0U; node < transforms.size(); ++node) {
+			ASSERT_EQ(hierarchy.WorldMatrixChanged(node), expectedChanged[node] != 0U) << "node " << node;
+		}
+		ExpectMatchesReference(hierarchy, transforms);
+	}
+}
+
+TEST(TransformHierarchy, AddNodesAfterUpdate) {
+	std::mt19937 generator{ 3U };
+	TransformHierarchy hierarchy;
+	std::vector<LocalTransform> transforms;
+	BuildRandomHierarchy(generator, 100U, hierarchy, transforms);
+	hierarchy.Update();
+
+	// New nodes are children of existing ones
+	for (std::uint32_t i = 0U; i < 100U; ++i) {
+		const TransformHierarchy::Handle parent{ static_cast<TransformHierarchy::Handle>(generator() % transforms.size()) };
+		transforms.push_back(RandomTransform(generator));
+		const LocalTransform& transform(transforms.back());
+		hierarchy.AddNode(parent, transform.mTranslation, transform.mRotation, transform.mScale);
+	}
+	hierarchy.Update();
+	EXPECT_EQ(hierarchy.ChangedNodeCount(), 100U);
+	ExpectMatchesReference(hierarchy, transforms);
+}
+
+// Matrices are decomposed in translation, rotation and scale, including reflections
+TEST(TransformHierarchy, AddNodeFromMatrix) {
+	std::mt19937 generator{ 4U };
+	TransformHierarchy hierarchy;
+	std::vector<float> matrices;
+	for (std::uint32_t i = 0U; i < 100U; ++i) {
+		LocalTransform transform{ RandomTransform(generator) };
+		if (i % 2U == 0U) {
+			transform.mScale[i % 3U] = -transform.mScale[i % 3U];
+		}
+
+		float local[16U];
+		LocalMatrix(transform, local);
+		matrices.insert(matrices.end(), local, local + 16U);
+		hierarchy.AddNode(TransformHierarchy::sInvalidHandle, local);
+	}
+	hierarchy.Update();
+
+	for (std::uint32_t node = 0U; node < 100U; ++node) {
+		for (std::uint32_t j = 0U; j < 16U; ++j) {
+			EXPECT_NEAR(hierarchy.WorldMatrix(node)[j], matrices[node * 16UL + j], 1.0e-4f) << "node " << node << ", element " << j;
+		}
+	}
+}
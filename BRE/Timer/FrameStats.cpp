@@ -0,0 +1,84 @@
+#include "FrameStats.h"
+
+#include <cmath>
+
+#include <Utils/DebugUtils.h>
+
+namespace {
+	const double sMillisecondsPerNanosecond{ 1.0e-6 };
+
+	// Weight of the last frame in the average frame time
+	const double sAverageWeight{ 0.1 };
+}
+
+const double FrameStats::sStutterFactor{ 2.0 };
+
+void FrameStats::RecordFrame(const std::uint64_t frameTime, const std::uint64_t waitTime) noexcept {
+	ASSERT(waitTime <= frameTime);
+
+	const double time{ static_cast<double>(frameTime) };
+	if (mAverageFrameTime > 0.0 && time > sStutterFactor * mAverageFrameTime) {
+		mWindow.mStutterCount.fetch_add(1UL, std::memory_order_relaxed);
+		mTotal.mStutterCount.fetch_add(1UL, std::memory_order_relaxed);
+	}
+	mAverageFrameTime = mAverageFrameTime > 0.0 ? mAverageFrameTime + (time - mAverageFrameTime) * sAverageWeight : time;
+
+	mWindow.mFrameTimes.Record(frameTime);
+	mWindow.mWaitTimes.Record(waitTime);
+	mTotal.mFrameTimes.Record(frameTime);
+	mTotal.mWaitTimes.Record(waitTime);
+}
+
+void FrameStats::BeginWindow() noexcept {
+	mWindow.mFrameTimes.Reset();
+	mWindow.mWaitTimes.Reset();
+	mWindow.mStutterCount.store(0UL, std::memory_order_relaxed);
+}
+
+FrameStats::Summary FrameStats::WindowSummary() const noexcept {
+	return GetSummary(mWindow);
+}
+
+FrameStats::Summary FrameStats::TotalSummary() const noexcept {
+	return GetSummary(mTotal);
+}
+
+void FrameStats::WriteSummary(std::ostream& stream, const char* label, const Summary& summary) noexcept {
+	ASSERT(label != nullptr);
+
+	stream << label
+		<< ": frames " << summary.mFrameCount
+		<< ", mean " << summary.mMean
+		<< " ms, std dev " << summary.mStandardDeviation
+		<< " ms, min " << summary.mMin
+		<< " ms, p50 " << summary.mP50
+		<< " ms, p95 " << summary.mP95
+		<< " ms, p99 " << summary.mP99
+		<< " ms, max " << summary.mMax
+		<< " ms, cpu " << summary.mMeanCpuTime
+		<< " ms, wait " << summary.mMeanWaitTime
+		<< " ms (p99 " << summary.mP99WaitTime
+		<< " ms), stutters " << summary.mStutterCount
+		<< "\n";
+}
+
+FrameStats::Summary FrameStats::GetSummary(const Histograms& histograms) noexcept {
+	const FrameTimeHistogram& frameTimes(histograms.mFrameTimes);
+	const FrameTimeHistogram& waitTimes(histograms.mWaitTimes);
+
+	Summary summary;
+	summary.mFrameCount = frameTimes.Count();
+	summary.mStutterCount = histograms.mStutterCount.load(std::memory_order_relaxed);
+	summary.mMean = frameTimes.Mean() * sMillisecondsPerNanosecond;
+	summary.mStandardDeviation = std::sqrt(frameTimes.Variance()) * sMillisecondsPerNanosecond;
+	summary.mMin = frameTimes.Min() * sMillisecondsPerNanosecond;
+	summary.mMax = frameTimes.Max() * sMillisecondsPerNanosecond;
+	summary.mP50 = frameTimes.Percentile(50.0) * sMillisecondsPerNanosecond;
+	summary.mP95 = frameTimes.Percentile(95.0) * sMillisecondsPerNanosecond;
+	summary.mP99 = frameTimes.Percentile(99.0) * sMillisecondsPerNanosecond;
+	summary.mMeanWaitTime = waitTimes.Mean() * sMillisecondsPerNanosecond;
+	summary.mMeanCpuTime = summary.mMean - summary.mMeanWaitTime;
+	summary.mP99WaitTime = waitTimes.Percentile(99.0) * sMillisecondsPerNanosecond;
+
+	return summary;
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+
+#include <Timer/FrameTimeHistogram.h>
+
+// Frame time statistics of the whole run and of the current window
+// (a window is the time since last BeginWindow() call, used for periodic summaries).
+// Each frame has a total time, and a wait time (time blocked waiting for the GPU or presentation),
+// so CPU time is total time minus wait time.
+// A frame is a stutter if it takes more than sStutterFactor times the average frame time of last frames.
+// Steps:
+// - Call RecordFrame() once per frame (always from the same thread).
+// - Call WindowSummary() or TotalSummary() (from any thread) to query statistics.
+// - Call BeginWindow() to begin a new window, for example, after writing WindowSummary().
+class FrameStats {
+public:
+	static const double sStutterFactor;
+
+	// Times in milliseconds
+	struct Summary {
+		std::uint64_t mFrameCount{ 0UL };
+		std::uint64_t mStutterCount{ 0UL };
+		double mMean{ 0.0 };
+		double mStandardDeviation{ 0.0 };
+		double mMin{ 0.0 };
+		double mMax{ 0.0 };
+		double mP50{ 0.0 };
+		double mP95{ 0.0 };
+		double mP99{ 0.0 };
+		double mMeanCpuTime{ 0.0 };
+		double mMeanWaitTime{ 0.0 };
+		double mP99WaitTime{ 0.0 };
+	};
+
+	FrameStats() = default;
+	~FrameStats() = default;
+	FrameStats(const FrameStats&) = delete;
+	const FrameStats& operator=(const FrameStats&) = delete;
+	FrameStats(FrameStats&&) = delete;
+	FrameStats& operator=(FrameStats&&) = delete;
+
+	// Times in nanoseconds. waitTime must not be greater than frameTime.
+	void RecordFrame(const std::uint64_t frameTime, const std::uint64_t waitTime) noexcept;
+
+	void BeginWindow() noexcept;
+
+	Summary WindowSummary() const noexcept;
+	Summary TotalSummary() const noexcept;
+
+	// Writes summary in a single line, preceded by label
+	static void WriteSummary(std::ostream& stream, const char* label, const Summary& summary) noexcept;
+
+private:
+	struct Histograms {
+		FrameTimeHistogram mFrameTimes;
+		FrameTimeHistogram mWaitTimes;
+		std::atomic<std::uint64_t> mStutterCount{ 0UL };
+	};
+
+	static Summary GetSummary(const Histograms& histograms) noexcept;
+
+	Histograms mWindow;
+	Histograms mTotal;
+
+	// Exponential moving average of frame times (nanoseconds) to detect stutters
+	double mAverageFrameTime{ 0.0 };
+};
@@ -0,0 +1,139 @@
+#include "FrameTimeHistogram.h"
+
+#include <Utils/DebugUtils.h>
+
+namespace {
+	const std::uint64_t sNanosecondsPerMicrosecond{ 1000UL };
+
+	// Index of the most significant bit (value must not be 0)
+	std::uint32_t MostSignificantBit(std::uint64_t value) noexcept {
+		ASSERT(value != 0UL);
+		std::uint32_t bit{ 0U };
+		while (value >>= 1UL) {
+			++bit;
+		}
+		return bit;
+	}
+}
+
+FrameTimeHistogram::FrameTimeHistogram() {
+	static_assert(sExactValueCount == sSubBucketCount * 2U, "Exact values must cover powers of 2 below the first split one");
+	Reset();
+}
+
+void FrameTimeHistogram::Record(const std::uint64_t nanoseconds) noexcept {
+	const std::uint64_t microseconds{ nanoseconds / sNanosecondsPerMicrosecond };
+	mBuckets[BucketIndex(microseconds)].fetch_add(1UL, std::memory_order_relaxed);
+	mCount.fetch_add(1UL, std::memory_order_relaxed);
+	mSum.fetch_add(microseconds, std::memory_order_relaxed);
+	mSumOfSquares.fetch_add(microseconds * microseconds, std::memory_order_relaxed);
+
+	std::uint64_t currentMin{ mMin.load(std::memory_order_relaxed) };
+	while (nanoseconds < currentMin && mMin.compare_exchange_weak(currentMin, nanoseconds, std::memory_order_relaxed) == false) {
+	}
+	std::uint64_t currentMax{ mMax.load(std::memory_order_relaxed) };
+	while (nanoseconds > currentMax && mMax.compare_exchange_weak(currentMax, nanoseconds, std::memory_order_relaxed) == false) {
+	}
+}
+
+void FrameTimeHistogram::Reset() noexcept {
+	for (std::uint32_t i = 0U; i < sBucketCount; ++i) {
+		mBuckets[i].store(0UL, std::memory_order_relaxed);
+	}
+	mCount.store(0UL, std::memory_order_relaxed);
+	mMin.store(~0ULL, std::memory_order_relaxed);
+	mMax.store(0UL, std::memory_order_relaxed);
+	mSum.store(0UL, std::memory_order_relaxed);
+	mSumOfSquares.store(0UL, std::memory_order_relaxed);
+}
+
+std::uint64_t FrameTimeHistogram::Percentile(const double percentile) const noexcept {
+	ASSERT(percentile >= 0.0 && percentile <= 100.0);
+
+	const std::uint64_t count{ Count() };
+	if (count == 0UL) {
+		return 0UL;
+	}
+
+	// Rank of the value (at least the first one)
+	std::uint64_t rank{ static_cast<std::uint64_t>(percentile * 0.01 * count + 0.5) };
+	rank = rank == 0UL ? 1UL : rank;
+
+	std::uint64_t cumulativeCount{ 0UL };
+	for (std::uint32_t i = 0U; i < sBucketCount; ++i) {
+		cumulativeCount += mBuckets[i].load(std::memory_order_relaxed);
+		if (cumulativeCount >= rank) {
+			// Bucket values are reported by their highest value, clamped to recorded range
+			const std::uint64_t value{ (BucketHighestValue(i) + 1UL) * sNanosecondsPerMicrosecond - 1UL };
+			const std::uint64_t minValue{ Min() };
+			const std::uint64_t maxValue{ Max() };
+			return value < minValue ? minValue : (value > maxValue ? maxValue : value);
+		}
+	}
+
+	// Buckets can be behind count if Record() is being called
+	return Max();
+}
+
+std::uint64_t FrameTimeHistogram::Min() const noexcept {
+	const std::uint64_t minValue{ mMin.load(std::memory_order_relaxed) };
+	return minValue == ~0ULL ? 0UL : minValue;
+}
+
+double FrameTimeHistogram::Mean() const noexcept {
+	const std::uint64_t count{ Count() };
+	if (count == 0UL) {
+		return 0.0;
+	}
+
+	return static_cast<double>(mSum.load(std::memory_order_relaxed)) / count * sNanosecondsPerMicrosecond;
+}
+
+double FrameTimeHistogram::Variance() const noexcept {
+	const std::uint64_t count{ Count() };
+	if (count == 0UL) {
+		return 0.0;
+	}
+
+	const double mean{ static_cast<double>(mSum.load(std::memory_order_relaxed)) / count };
+	const double meanOfSquares{ static_cast<double>(mSumOfSquares.load(std::memory_order_relaxed)) / count };
+	const double variance{ meanOfSquares - mean * mean };
+	return (variance > 0.0 ? variance : 0.0) * sNanosecondsPerMicrosecond * sNanosecondsPerMicrosecond;
+}
+
+std::uint32_t FrameTimeHistogram::BucketIndex(const std::uint64_t microseconds) noexcept {
+	if (microseconds < sExactValueCount) {
+		return static_cast<std::uint32_t>(microseconds);
+	}
+
+	// Split exponents begin at 6 (sExactValueCount is 2^6). Sub buckets are the 5 bits after the most significant one.
+	std::uint32_t exponent{ MostSignificantBit(microseconds) };
+	if (exponent >= sMaxExponent) {
+		return sBucketCount - 1U;
+	}
+
+	const std::uint32_t shift{ exponent - 5U };
+	const std::uint32_t subBucket{ static_cast<std::uint32_t>(microseconds >> shift) - sSubBucketCount };
+	return sExactValueCount + (exponent - 6U) * sSubBucketCount + subBucket;
+}
+
+std::uint64_t FrameTimeHistogram::BucketLowestValue(const std::uint32_t bucketIndex) noexcept {
+	ASSERT(bucketIndex < sBucketCount);
+	if (bucketIndex < sExactValueCount) {
+		return bucketIndex;
+	}
+
+	const std::uint32_t exponent{ (bucketIndex - sExactValueCount) / sSubBucketCount + 6U };
+	const std::uint32_t subBucket{ (bucketIndex - sExactValueCount) % sSubBucketCount };
+	return static_cast<std::uint64_t>(sSubBucketCount + subBucket) << (exponent - 5U);
+}
+
+std::uint64_t FrameTimeHistogram::BucketHighestValue(const std::uint32_t bucketIndex) noexcept {
+	ASSERT(bucketIndex < sBucketCount);
+	if (bucketIndex < sExactValueCount) {
+		return bucketIndex;
+	}
+
+	const std::uint32_t exponent{ (bucketIndex - sExactValueCount) / sSubBucketCount + 6U };
+	return BucketLowestValue(bucketIndex) + (1ULL << (exponent - 5U)) - 1UL;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// Lock-free histogram of durations (HDR histogram style), with microseconds resolution.
+// Values below sExactValueCount microseconds have their own bucket. Above it, each power of 2
+// is split in sSubBucketCount buckets, so percentiles have less than 1 / sSubBucketCount relative error
+// with a fixed size (no allocations).
+// Record() can be called from different threads at the same time as queries.
+// Reset() must not be called at the same time as Record().
+class FrameTimeHistogram {
+public:
+	static const std::uint32_t sExactValueCount{ 64U };
+	static const std::uint32_t sSubBucketCount{ 32U };
+	// Values of 2^sMaxExponent microseconds or more (more than 35 minutes) are clamped to the last bucket
+	static const std::uint32_t sMaxExponent{ 31U };
+	static const std::uint32_t sBucketCount{ sExactValueCount + (sMaxExponent - 6U) * sSubBucketCount };
+
+	FrameTimeHistogram();
+	~FrameTimeHistogram() = default;
+	FrameTimeHistogram(const FrameTimeHistogram&) = delete;
+	const FrameTimeHistogram& operator=(const FrameTimeHistogram&) = delete;
+	FrameTimeHistogram(FrameTimeHistogram&&) = delete;
+	FrameTimeHistogram& operator=(FrameTimeHistogram&&) = delete;
+
+	void Record(const std::uint64_t nanoseconds) noexcept;
+
+	void Reset() noexcept;
+
+	// Duration (in nanoseconds) that is greater or equal than percentile % of recorded durations.
+	// percentile must be in [0, 100]. Returns 0 if there are no recorded durations.
+	std::uint64_t Percentile(const double percentile) const noexcept;
+
+	std::uint64_t Count() const noexcept { return mCount.load(std::memory_order_relaxed); }
+	std::uint64_t Min() const noexcept;
+	std::uint64_t Max() const noexcept { return mMax.load(std::memory_order_relaxed); }
+
+	// In nanoseconds (squared for variance)
+	double Mean() const noexcept;
+	double Variance() const noexcept;
+
+	static std::uint32_t BucketIndex(const std::uint64_t microseconds) noexcept;
+
+	// Lowest and highest microseconds of the bucket values
+	static std::uint64_t BucketLowestValue(const std::uint32_t bucketIndex) noexcept;
+	static std::uint64_t BucketHighestValue(const std::uint32_t bucketIndex) noexcept;
+
+private:
+	std::atomic<std::uint64_t> mBuckets[sBucketCount];
+	std::atomic<std::uint64_t> mCount{ 0UL };
+	std::atomic<std::uint64_t> mMin{ ~0ULL };
+	std::atomic<std::uint64_t> mMax{ 0UL };
+
+	// Sums in microseconds, so squares do not overflow
+	std::atomic<std::uint64_t> mSum{ 0UL };
+	std::atomic<std::uint64_t> mSumOfSquares{ 0UL };
+};
@@ -1,38 +1,34 @@
 #include "Timer.h"
 
-#include <windows.h>
+#include <chrono>
+
+const double Timer::sSecondsPerNanosecond{ 1.0e-9 };
 
 Timer::Timer() {
-	std::int64_t countsPerSec;
-	QueryPerformanceFrequency(reinterpret_cast<LARGE_INTEGER*>(&countsPerSec));
-	mSecondsPerCount = 1.0 / static_cast<double>(countsPerSec);
 	Reset();
 }
 
+std::uint64_t Timer::Now() noexcept {
+	return static_cast<std::uint64_t>(
+		std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
 void Timer::Reset() noexcept {
-	std::int64_t currTime;
-	QueryPerformanceCounter(reinterpret_cast<LARGE_INTEGER*>(&currTime));
+	const std::uint64_t currTime{ Now() };
 
 	mBaseTime = currTime;
 	mPrevTime = currTime;
+	mCurrTime = currTime;
+	mDeltaTime = 0UL;
 }
 
 void Timer::Tick() noexcept {
-	std::int64_t currTime;
-	QueryPerformanceCounter(reinterpret_cast<LARGE_INTEGER*>(&currTime));
-	mCurrTime = currTime;
+	// Steady clock is monotonic, so time difference is never negative
+	mCurrTime = Now();
 
 	// Time difference between this frame and the previous.
-	mDeltaTime = (mCurrTime - mPrevTime) * mSecondsPerCount;
+	mDeltaTime = mCurrTime - mPrevTime;
 
 	// Prepare for next frame.
 	mPrevTime = mCurrTime;
-
-	// Force nonnegative.  The DXSDK's CDXUTTimer mentions that if the 
-	// processor goes into a power save mode or we get shuffled to another
-	// processor, then mDeltaTime can be negative.
-	if(mDeltaTime < 0.0) {
-		mDeltaTime = 0.0;
-	}
 }
-
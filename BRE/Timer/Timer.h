@@ -2,6 +2,7 @@
 
 #include <cstdint>
 
+// Frame timer based on a portable monotonic clock (std::chrono::steady_clock)
 class Timer {
 public:
 	Timer();
@@ -11,9 +12,15 @@ public:
 	Timer(Timer&&) = delete;
 	Timer& operator=(Timer&&) = delete;
 
+	// Nanoseconds of the monotonic clock, to measure intervals
+	static std::uint64_t Now() noexcept;
+
 	// Time in seconds (1.0f is 1 second)
-	float TotalTime() const noexcept { return static_cast<float>((mCurrTime - mBaseTime) * mSecondsPerCount); }
-	float DeltaTime() const noexcept { return static_cast<float>(mDeltaTime); }
+	float TotalTime() const noexcept { return static_cast<float>((mCurrTime - mBaseTime) * sSecondsPerNanosecond); }
+	float DeltaTime() const noexcept { return static_cast<float>(mDeltaTime * sSecondsPerNanosecond); }
+
+	// Time between the last 2 ticks in nanoseconds
+	std::uint64_t DeltaNanoseconds() const noexcept { return mDeltaTime; }
 
 	// Call before message loop.
 	void Reset() noexcept; 
@@ -22,9 +29,10 @@ public:
 	void Tick() noexcept;  
 
 private:
-	double mSecondsPerCount{ 0.0 };
-	double mDeltaTime{ 0.0 };
-	std::int64_t mBaseTime{ 0 };
-	std::int64_t mPrevTime{ 0 };
-	std::int64_t mCurrTime{ 0 };
-};
\ No newline at end of file
+	static const double sSecondsPerNanosecond;
+
+	std::uint64_t mDeltaTime{ 0UL };
+	std::uint64_t mBaseTime{ 0UL };
+	std::uint64_t mPrevTime{ 0UL };
+	std::uint64_t mCurrTime{ 0UL };
+};
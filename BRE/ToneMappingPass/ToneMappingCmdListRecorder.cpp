@@ -6,6 +6,8 @@
 #include <DescriptorManager\DescriptorManager.h>
 #include <PSOCreator/PSOCreator.h>
 #include <Utils/DebugUtils.h>
+#include <Utils/Profiler.h>
+#include <Utils/RenderStats.h>
 
 // Root Signature:
 // "DescriptorTable(SRV(t0), visibility = SHADER_VISIBILITY_PIXEL)" 0 -> Color Buffer Texture
@@ -85,6 +87,7 @@ void ToneMappingCmdListRecorder::Init(
 }
 
 void ToneMappingCmdListRecorder::RecordAndPushCommandLists(const D3D12_CPU_DESCRIPTOR_HANDLE& frameBufferCpuDesc) noexcept {
+	PROFILE_ZONE("ToneMappingCmdListRecorder::RecordAndPushCommandLists");
 
 	ASSERT(ValidateData());
 	ASSERT(sPSO != nullptr);
@@ -94,6 +97,7 @@ void ToneMappingCmdListRecorder::RecordAndPushCommandLists(const D3D12_CPU_DESCR
 	ASSERT(cmdAlloc != nullptr);
 	
 	CHECK_HR(cmdAlloc->Reset());
+	RENDER_STATS_ADD(PIPELINE_STATE_CHANGES, 1UL);
 	CHECK_HR(mCmdList->Reset(cmdAlloc, sPSO));
 
 	mCmdList->RSSetViewports(1U, &Settings::sScreenViewport);
@@ -102,6 +106,7 @@ void ToneMappingCmdListRecorder::RecordAndPushCommandLists(const D3D12_CPU_DESCR
 
 	ID3D12DescriptorHeap* heaps[] = { &DescriptorManager::Get().GetCbvSrcUavDescriptorHeap() };
 	mCmdList->SetDescriptorHeaps(_countof(heaps), heaps);
+	RENDER_STATS_ADD(ROOT_SIGNATURE_CHANGES, 1UL);
 	mCmdList->SetGraphicsRootSignature(sRootSign);
 	
 	mCmdList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
@@ -109,8 +114,10 @@ void ToneMappingCmdListRecorder::RecordAndPushCommandLists(const D3D12_CPU_DESCR
 	// Draw object
 	mCmdList->IASetVertexBuffers(0U, 1U, &mVertexBufferData.mBufferView);
 	mCmdList->IASetIndexBuffer(&mIndexBufferData.mBufferView);
+	RENDER_STATS_ADD(DESCRIPTOR_TABLES, 1UL);
 	mCmdList->SetGraphicsRootDescriptorTable(0U, mColorBufferGpuDescHandle);
-	mCmdList->DrawIndexedInstanced(mIndexBufferData.mCount, 1U, 0U, 0U, 0U);
+	RENDER_STATS_DRAW(mIndexBufferData.mCount, 1U);
+	mCmdList->DrawIndexedInstanced(mIndexBufferData.mCount, 1U, mIndexBufferData.mStartIndex, mVertexBufferData.mBaseVertex, 0U);
 
 	mCmdList->Close();
 
@@ -12,6 +12,8 @@
 #include <ResourceManager\ResourceManager.h>
 #include <ShaderUtils\CBuffers.h>
 #include <Utils\DebugUtils.h>
+#include <Utils/Profiler.h>
+#include <Utils/RenderStats.h>
 
 namespace {
 	void CreateCommandObjects(
@@ -63,6 +65,10 @@ namespace {
 	}
 }
 
+void ToneMappingPass::InitPSOs() noexcept {
+	ToneMappingCmdListRecorder::InitPSO();
+}
+
 void ToneMappingPass::Init(
 	ID3D12Device& device,
 	CommandListExecutor& cmdListExecutor,
@@ -83,16 +89,14 @@ void ToneMappingPass::Init(
 	Model* model;
 	Microsoft::WRL::ComPtr<ID3D12Resource> uploadVertexBuffer;
 	Microsoft::WRL::ComPtr<ID3D12Resource> uploadIndexBuffer;
-	ModelManager::Get().CreateFullscreenQuad(model, *mCmdList, uploadVertexBuffer, uploadIndexBuffer);
+	const std::size_t modelId{ ModelManager::Get().CreateFullscreenQuad(model, *mCmdList, uploadVertexBuffer, uploadIndexBuffer) };
 	ASSERT(model != nullptr);
 
 	// Get vertex and index buffers data from the only mesh this model must have.
 	ASSERT(model->Meshes().size() == 1UL);
 	const Mesh& mesh = model->Meshes()[0U];
 	ExecuteCommandList(cmdQueue, *mCmdList, *mFence);
-
-	// Initialize recorder's PSO
-	ToneMappingCmdListRecorder::InitPSO();
+	ModelManager::Get().UploadFlushed(modelId);
 
 	// Initialize recorder
 	mRecorder.reset(new ToneMappingCmdListRecorder(device, cmdListExecutor.CmdListQueue()));
@@ -104,6 +108,7 @@ void ToneMappingPass::Init(
 void ToneMappingPass::Execute(
 	ID3D12Resource& frameBuffer,
 	const D3D12_CPU_DESCRIPTOR_HANDLE& frameBufferCpuDesc) noexcept {
+	PROFILE_ZONE("ToneMappingPass::Execute");
 
 	ASSERT(ValidateData());
 	ASSERT(frameBufferCpuDesc.ptr != 0UL);
@@ -114,9 +119,7 @@ void ToneMappingPass::Execute(
 	mRecorder->RecordAndPushCommandLists(frameBufferCpuDesc);
 
 	// Wait until all previous tasks command lists are executed
-	while (mCmdListExecutor->ExecutedCmdListCount() < 1) {
-		Sleep(0U);
-	}
+	mCmdListExecutor->WaitForExecutedCmdLists(1U);
 }
 
 bool ToneMappingPass::ValidateData() const noexcept {
@@ -158,6 +161,7 @@ void ToneMappingPass::ExecuteBeginTask(
 		CD3DX12_RESOURCE_BARRIER::Transition(mColorBuffer, D3D12_RESOURCE_STATE_RENDER_TARGET, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE),
 		CD3DX12_RESOURCE_BARRIER::Transition(&frameBuffer, D3D12_RESOURCE_STATE_PRESENT, D3D12_RESOURCE_STATE_RENDER_TARGET),
 	};
+	RENDER_STATS_ADD(RESOURCE_BARRIERS, _countof(barriers));
 	mCmdList->ResourceBarrier(_countof(barriers), barriers);
 
 	// Clear render targets
@@ -167,5 +171,6 @@ void ToneMappingPass::ExecuteBeginTask(
 	// Execute preliminary task
 	mCmdListExecutor->ResetExecutedCmdListCount();
 	ID3D12CommandList* cmdLists[] = { mCmdList };
+	RENDER_STATS_EXECUTE(_countof(cmdLists));
 	mCmdQueue->ExecuteCommandLists(_countof(cmdLists), cmdLists);
 }
@@ -27,6 +27,9 @@ public:
 	ToneMappingPass(ToneMappingPass&&) = delete;
 	ToneMappingPass& operator=(ToneMappingPass&&) = delete;
 
+	// Creates recorder pipeline state. It must be called before Init().
+	static void InitPSOs() noexcept;
+
 	// You should call this method before Execute()
 	void Init(
 		ID3D12Device& device,
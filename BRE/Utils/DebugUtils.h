@@ -1,10 +1,15 @@
 #pragma once
 
 #include <cassert>
-#include <comdef.h>
 #include <string>
 
+#ifdef _WIN32
+#include <comdef.h>
+
 #include <Utils\StringUtils.h>
+#endif
+
+#include <Utils/ForceInline.h>
 
 #if defined(DEBUG) || defined(_DEBUG)
 #define ASSERT(condition) \
@@ -13,7 +18,9 @@
 #define ASSERT(condition) (condition)
 #endif
 
-#ifndef CHECK_HR
+// HRESULT checks are only available on Windows. ASSERT is also available
+// on other platforms, so platform independent code (math, allocators, etc) can use it.
+#if defined(_WIN32) && !defined(CHECK_HR)
 #define CHECK_HR(x) \
 { \
     const HRESULT hr__ = (x);                                               \
@@ -0,0 +1,8 @@
+#pragma once
+
+// __forceinline is MSVC only. Other compilers (Linux builds of the platform
+// independent modules) get an equivalent definition, so headers can use it
+// without depending on Windows headers.
+#if !defined(_MSC_VER) && !defined(__forceinline)
+#define __forceinline inline __attribute__((always_inline))
+#endif
@@ -13,4 +13,15 @@ namespace HashUtils {
 
 		return hash;
 	}
+
+	std::uint64_t HashBytes(const void* data, const std::size_t size, const std::uint64_t hash) noexcept {
+		ASSERT(data != nullptr || size == 0UL);
+		const std::uint8_t* bytes{ static_cast<const std::uint8_t*>(data) };
+		std::uint64_t result{ hash };
+		for (std::size_t i = 0UL; i < size; ++i) {
+			result = (result ^ bytes[i]) * 1099511628211ULL;
+		}
+
+		return result;
+	}
 }
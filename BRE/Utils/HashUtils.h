@@ -1,7 +1,13 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 
 namespace HashUtils {
 	std::size_t HashCString(const char* p) noexcept;
+
+	// FNV-1a (64 bits). It is stable across runs and platforms, so it can be persisted.
+	// Pass the result of a previous call as hash to chain several byte ranges.
+	const std::uint64_t sFnv1aOffsetBasis{ 14695981039346656037ULL };
+	std::uint64_t HashBytes(const void* data, const std::size_t size, const std::uint64_t hash = sFnv1aOffsetBasis) noexcept;
 }
@@ -0,0 +1,55 @@
+#include "MemoryUtils.h"
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "DebugUtils.h"
+
+namespace MemoryUtils {
+	void StreamingCopy(void* destination, const void* source, const std::size_t size) noexcept {
+		ASSERT(destination != nullptr || size == 0UL);
+		ASSERT(source != nullptr || size == 0UL);
+
+#if defined(_M_X64) || defined(__SSE2__)
+		std::uint8_t* dst{ static_cast<std::uint8_t*>(destination) };
+		const std::uint8_t* src{ static_cast<const std::uint8_t*>(source) };
+		std::size_t remainingSize{ size };
+
+		// Non-temporal stores need 16 bytes aligned destinations
+		const std::size_t headSize{ (16UL - (reinterpret_cast<std::uintptr_t>(dst) & 15UL)) & 15UL };
+		if (headSize >= remainingSize) {
+			std::memcpy(dst, src, remainingSize);
+			return;
+		}
+		std::memcpy(dst, src, headSize);
+		dst += headSize;
+		src += headSize;
+		remainingSize -= headSize;
+
+		// A cache line per iteration, so write combining buffers are filled completely
+		for (; remainingSize >= 64UL; remainingSize -= 64UL, dst += 64UL, src += 64UL) {
+			const __m128i a{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(src)) };
+			const __m128i b{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 16UL)) };
+			const __m128i c{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 32UL)) };
+			const __m128i d{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 48UL)) };
+			_mm_stream_si128(reinterpret_cast<__m128i*>(dst), a);
+			_mm_stream_si128(reinterpret_cast<__m128i*>(dst + 16UL), b);
+			_mm_stream_si128(reinterpret_cast<__m128i*>(dst + 32UL), c);
+			_mm_stream_si128(reinterpret_cast<__m128i*>(dst + 48UL), d);
+		}
+
+		for (; remainingSize >= 16UL; remainingSize -= 16UL, dst += 16UL, src += 16UL) {
+			_mm_stream_si128(reinterpret_cast<__m128i*>(dst), _mm_loadu_si128(reinterpret_cast<const __m128i*>(src)));
+		}
+
+		std::memcpy(dst, src, remainingSize);
+		_mm_sfence();
+#else
+		std::memcpy(destination, source, size);
+#endif
+	}
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstddef>
+
+#include <Utils/ForceInline.h>
+
+namespace MemoryUtils {
+	// Rounds size up to the next multiple of alignment, which must be a power of 2.
+	__forceinline std::size_t AlignUp(const std::size_t size, const std::size_t alignment) noexcept {
+		return (size + alignment - 1UL) & ~(alignment - 1UL);
+	}
+
+	// Copies with non-temporal stores (they bypass the cache), so it is meant for destinations
+	// the CPU writes but does not read, like write combined upload heaps.
+	// Stores are fenced before returning.
+	void StreamingCopy(void* destination, const void* source, const std::size_t size) noexcept;
+}
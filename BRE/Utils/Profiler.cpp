@@ -0,0 +1,193 @@
+#include "Profiler.h"
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <Utils/DebugUtils.h>
+
+namespace {
+	struct Event {
+		const char* mName{ nullptr };
+		std::uint64_t mBegin{ 0UL };
+		std::uint64_t mEnd{ 0UL };
+		std::uint32_t mDepth{ 0U };
+		bool mIsFrameMarker{ false };
+	};
+
+	// Events ring of a thread. Only its thread writes events, and it publishes
+	// them by incrementing mEventCount (so readers can copy them without locks).
+	// mWriteCount is incremented before an event is written, so readers can discard
+	// the event that is overwritten while they copy it.
+	struct ThreadTrack {
+		Event mEvents[Profiler::sEventCountPerThread];
+		std::atomic<std::uint64_t> mEventCount{ 0UL };
+		std::atomic<std::uint64_t> mWriteCount{ 0UL };
+		const char* mName{ nullptr };
+		std::uint32_t mIndex{ 0U };
+		std::uint32_t mDepth{ 0U };
+	};
+
+	static_assert((Profiler::sEventCountPerThread & (Profiler::sEventCountPerThread - 1U)) == 0U, "Event count must be a power of 2");
+
+	const std::chrono::high_resolution_clock::time_point sStartTime{ std::chrono::high_resolution_clock::now() };
+
+	// Tracks are never destroyed, so thread local pointers are always valid.
+	std::vector<std::unique_ptr<ThreadTrack>> sTracks;
+	std::mutex sTracksMutex;
+
+	std::atomic<std::uint32_t> sFrameCount{ 0U };
+
+	thread_local ThreadTrack* sCurrentTrack{ nullptr };
+
+	ThreadTrack& CurrentTrack() noexcept {
+		if (sCurrentTrack == nullptr) {
+			std::lock_guard<std::mutex> lock(sTracksMutex);
+			sTracks.emplace_back(new ThreadTrack());
+			sCurrentTrack = sTracks.back().get();
+			sCurrentTrack->mIndex = static_cast<std::uint32_t>(sTracks.size() - 1UL);
+		}
+
+		return *sCurrentTrack;
+	}
+
+	void PushEvent(ThreadTrack& track, const Event& event) noexcept {
+		const std::uint64_t index{ track.mEventCount.load(std::memory_order_relaxed) };
+		track.mWriteCount.store(index + 1UL, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		track.mEvents[index & (Profiler::sEventCountPerThread - 1U)] = event;
+		track.mEventCount.store(index + 1UL, std::memory_order_release);
+	}
+
+	// Copies events that are in the ring of the track
+	void CopyEvents(const ThreadTrack& track, std::vector<Event>& events) noexcept {
+		const std::uint64_t eventCount{ track.mEventCount.load(std::memory_order_acquire) };
+		const std::uint64_t firstEvent{ eventCount > Profiler::sEventCountPerThread ? eventCount - Profiler::sEventCountPerThread : 0UL };
+		events.clear();
+		for (std::uint64_t i = firstEvent; i < eventCount; ++i) {
+			events.push_back(track.mEvents[i & (Profiler::sEventCountPerThread - 1U)]);
+		}
+
+		// Discard events that were overwritten while we copied them (including the event
+		// that is being written, which is not published yet)
+		std::atomic_thread_fence(std::memory_order_acquire);
+		const std::uint64_t writeCount{ track.mWriteCount.load(std::memory_order_relaxed) };
+		if (writeCount > firstEvent + Profiler::sEventCountPerThread) {
+			const std::uint64_t overwrittenCount{ writeCount - Profiler::sEventCountPerThread - firstEvent };
+			events.erase(
+				events.begin(), 
+				events.begin() + static_cast<std::ptrdiff_t>(overwrittenCount < events.size() ? overwrittenCount : events.size()));
+		}
+	}
+
+	// Microseconds with nanoseconds precision
+	void WriteMicroseconds(std::ofstream& fout, const std::uint64_t nanoseconds) noexcept {
+		fout << nanoseconds / 1000UL << ".";
+		const std::uint64_t fraction{ nanoseconds % 1000UL };
+		fout << (fraction < 100UL ? "0" : "") << (fraction < 10UL ? "0" : "") << fraction;
+	}
+}
+
+namespace Profiler {
+	std::uint64_t Now() noexcept {
+		return static_cast<std::uint64_t>(
+			std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - sStartTime).count());
+	}
+
+	void SetThreadName(const char* name) noexcept {
+		ASSERT(name != nullptr);
+		CurrentTrack().mName = name;
+	}
+
+	void MarkFrame() noexcept {
+		Event event;
+		event.mName = "Frame";
+		event.mBegin = Now();
+		event.mEnd = event.mBegin;
+		event.mIsFrameMarker = true;
+		PushEvent(CurrentTrack(), event);
+
+		sFrameCount.fetch_add(1U, std::memory_order_relaxed);
+	}
+
+	Zone::Zone(const char* name) noexcept
+		: mName(name)
+		, mBegin(Now())
+	{
+		ASSERT(name != nullptr);
+		++CurrentTrack().mDepth;
+	}
+
+	Zone::~Zone() {
+		ThreadTrack& track(CurrentTrack());
+		ASSERT(track.mDepth > 0U);
+		--track.mDepth;
+
+		Event event;
+		event.mName = mName;
+		event.mBegin = mBegin;
+		event.mEnd = Now();
+		event.mDepth = track.mDepth;
+		PushEvent(track, event);
+	}
+
+	std::uint32_t FrameCount() noexcept {
+		return sFrameCount.load(std::memory_order_relaxed);
+	}
+
+	std::uint32_t ThreadCount() noexcept {
+		std::lock_guard<std::mutex> lock(sTracksMutex);
+		return static_cast<std::uint32_t>(sTracks.size());
+	}
+
+	bool WriteTrace(const char* filename) noexcept {
+		ASSERT(filename != nullptr);
+
+		std::ofstream fout{ filename, std::ios::trunc };
+		if (!fout) {
+			return false;
+		}
+
+		std::lock_guard<std::mutex> lock(sTracksMutex);
+
+		// Thread names metadata ("ph": "M"), complete events ("ph": "X") for zones,
+		// and global instant events ("ph": "i") for frame markers. Times in microseconds.
+		fout << "{\"traceEvents\":[\n";
+		bool isFirstEvent{ true };
+		std::vector<Event> events;
+		events.reserve(sEventCountPerThread);
+		for (const std::unique_ptr<ThreadTrack>& track : sTracks) {
+			fout << (isFirstEvent ? "" : ",\n");
+			isFirstEvent = false;
+			fout << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << track->mIndex
+				<< ",\"args\":{\"name\":\"";
+			if (track->mName != nullptr) {
+				fout << track->mName;
+			}
+			else {
+				fout << "Thread " << track->mIndex;
+			}
+			fout << "\"}}";
+
+			CopyEvents(*track, events);
+			for (const Event& event : events) {
+				fout << ",\n{\"name\":\"" << event.mName << "\",\"pid\":0,\"tid\":" << track->mIndex << ",\"ts\":";
+				WriteMicroseconds(fout, event.mBegin);
+				if (event.mIsFrameMarker) {
+					fout << ",\"ph\":\"i\",\"s\":\"g\"}";
+				}
+				else {
+					fout << ",\"ph\":\"X\",\"dur\":";
+					WriteMicroseconds(fout, event.mEnd - event.mBegin);
+					fout << ",\"args\":{\"depth\":" << event.mDepth << "}}";
+				}
+			}
+		}
+		fout << "\n]}\n";
+
+		return static_cast<bool>(fout);
+	}
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+
+// Set it to 0 to compile out all zones, frame markers and thread names
+// (PROFILE_* macros expand to nothing).
+#ifndef PROFILER_ENABLED
+#define PROFILER_ENABLED 1
+#endif
+
+// Low overhead hierarchical CPU profiler.
+// Each thread records its events in its own ring (only the thread writes to it, without locks),
+// so only the last sEventCountPerThread events of each thread are kept.
+// Zones are recorded when they end, with their nesting depth. Frame markers are instant events.
+// Steps:
+// - Use PROFILE_ZONE("Name") at the beginning of a scope to measure it (name must be a string literal).
+// - Use PROFILE_FRAME() once per frame, and PROFILE_THREAD("Name") to name a thread track.
+// - Call Profiler::WriteTrace() to inspect last events (chrome://tracing format), a track per thread.
+namespace Profiler {
+	static const std::uint32_t sEventCountPerThread{ 1U << 14U };
+
+	// Nanoseconds since profiler start
+	std::uint64_t Now() noexcept;
+
+	// name must be valid until the trace is written
+	void SetThreadName(const char* name) noexcept;
+
+	void MarkFrame() noexcept;
+
+	// Scoped zone. name must be valid until the trace is written
+	class Zone {
+	public:
+		explicit Zone(const char* name) noexcept;
+		~Zone();
+		Zone(const Zone&) = delete;
+		const Zone& operator=(const Zone&) = delete;
+		Zone(Zone&&) = delete;
+		Zone& operator=(Zone&&) = delete;
+
+	private:
+		const char* mName{ nullptr };
+		std::uint64_t mBegin{ 0UL };
+	};
+
+	// Number of frame markers and threads with events
+	std::uint32_t FrameCount() noexcept;
+	std::uint32_t ThreadCount() noexcept;
+
+	// It can be called while other threads record events (events overwritten
+	// while it is called are not written). Returns false if the file can not be written.
+	bool WriteTrace(const char* filename) noexcept;
+}
+
+#define PROFILER_CONCAT_IMPL(a, b) a##b
+#define PROFILER_CONCAT(a, b) PROFILER_CONCAT_IMPL(a, b)
+
+#if PROFILER_ENABLED
+#define PROFILE_ZONE(name) const Profiler::Zone PROFILER_CONCAT(profilerZone, __LINE__){ name }
+#define PROFILE_FRAME() Profiler::MarkFrame()
+#define PROFILE_THREAD(name) Profiler::SetThreadName(name)
+#else
+#define PROFILE_ZONE(name)
+#define PROFILE_FRAME()
+#define PROFILE_THREAD(name)
+#endif
@@ -0,0 +1,118 @@
+#include "RadixSort.h"
+
+#include <algorithm>
+#include <cstring>
+#include <tbb/parallel_for.h>
+#include <utility>
+#include <vector>
+
+#include "DebugUtils.h"
+
+namespace {
+	const std::uint32_t sDigitBits{ 8U };
+	const std::uint32_t sBucketCount{ 1U << sDigitBits };
+	const std::uint32_t sPassCount{ 64U / sDigitBits };
+
+	// Inputs smaller than this are sorted in a single block (without tasks)
+	const std::size_t sMinBlockSize{ 16384UL };
+	const std::size_t sMaxBlockCount{ 64UL };
+
+	__forceinline std::uint32_t Digit(const std::uint64_t key, const std::uint32_t shift) noexcept {
+		return static_cast<std::uint32_t>(key >> shift) & (sBucketCount - 1U);
+	}
+
+	template<typename BlockFunction>
+	void ForEachBlock(const std::size_t blockCount, const BlockFunction& function) noexcept {
+		if (blockCount == 1UL) {
+			function(0UL);
+			return;
+		}
+
+		tbb::parallel_for(tbb::blocked_range<std::size_t>(0UL, blockCount, 1UL),
+			[&function](const tbb::blocked_range<std::size_t>& r) {
+			for (std::size_t block = r.begin(); block != r.end(); ++block) {
+				function(block);
+			}
+		}
+		);
+	}
+}
+
+namespace RadixSort {
+	void SortKeyValues(
+		std::uint64_t* keys,
+		std::uint32_t* values,
+		const std::size_t count,
+		std::uint64_t* tmpKeys,
+		std::uint32_t* tmpValues) noexcept
+	{
+		ASSERT(count == 0UL || (keys != nullptr && values != nullptr && tmpKeys != nullptr && tmpValues != nullptr));
+
+		if (count < 2UL) {
+			return;
+		}
+
+		const std::size_t blockCount{ std::min(sMaxBlockCount, std::max<std::size_t>(1UL, count / sMinBlockSize)) };
+		const std::size_t blockSize{ (count + blockCount - 1UL) / blockCount };
+
+		// Digits count per block, that become block output offsets before scattering
+		std::vector<std::uint32_t> blockOffsets(blockCount * sBucketCount);
+
+		std::uint64_t* srcKeys{ keys };
+		std::uint32_t* srcValues{ values };
+		std::uint64_t* dstKeys{ tmpKeys };
+		std::uint32_t* dstValues{ tmpValues };
+		for (std::uint32_t pass = 0U; pass < sPassCount; ++pass) {
+			const std::uint32_t shift{ pass * sDigitBits };
+
+			ForEachBlock(blockCount, [&](const std::size_t block) {
+				std::uint32_t* histogram{ blockOffsets.data() + block * sBucketCount };
+				std::fill_n(histogram, sBucketCount, 0U);
+				const std::size_t end{ std::min(count, (block + 1UL) * blockSize) };
+				for (std::size_t i = block * blockSize; i < end; ++i) {
+					++histogram[Digit(srcKeys[i], shift)];
+				}
+			});
+
+			// Skip the pass if all keys have the same digit
+			const std::uint32_t firstDigit{ Digit(srcKeys[0UL], shift) };
+			std::size_t firstDigitCount{ 0UL };
+			for (std::size_t block = 0UL; block < blockCount; ++block) {
+				firstDigitCount += blockOffsets[block * sBucketCount + firstDigit];
+			}
+			if (firstDigitCount == count) {
+				continue;
+			}
+
+			// Buckets are consecutive, and inside each bucket, blocks are consecutive (so it is stable)
+			std::uint32_t offset{ 0U };
+			for (std::uint32_t digit = 0U; digit < sBucketCount; ++digit) {
+				for (std::size_t block = 0UL; block < blockCount; ++block) {
+					std::uint32_t& blockOffset(blockOffsets[block * sBucketCount + digit]);
+					const std::uint32_t digitCount{ blockOffset };
+					blockOffset = offset;
+					offset += digitCount;
+				}
+			}
+
+			ForEachBlock(blockCount, [&](const std::size_t block) {
+				std::uint32_t* offsets{ blockOffsets.data() + block * sBucketCount };
+				const std::size_t end{ std::min(count, (block + 1UL) * blockSize) };
+				for (std::size_t i = block * blockSize; i < end; ++i) {
+					const std::uint32_t dstIndex{ offsets[Digit(srcKeys[i], shift)]++ };
+					dstKeys[dstIndex] = srcKeys[i];
+					dstValues[dstIndex] = srcValues[i];
+				}
+			});
+
+			std::swap(srcKeys, dstKeys);
+			std::swap(srcValues, dstValues);
+		}
+
+		// An odd number of passes leaves the result in temporary arrays
+		if (srcKeys != keys) {
+			std::memcpy(keys, srcKeys, count * sizeof(std::uint64_t));
+			std::memcpy(values, srcValues, count * sizeof(std::uint32_t));
+		}
+	}
+}
\ No newline at end of file
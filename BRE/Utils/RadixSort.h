@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace RadixSort {
+	// Stable LSD radix sort of 64 bits keys (8 bits per pass), that moves their 32 bits values with them.
+	// Passes where all keys have the same digit are skipped, so keys whose most significant
+	// bits are constant are cheaper to sort.
+	// Big inputs are split in blocks, that are histogrammed and scattered in parallel.
+	// tmpKeys and tmpValues must have room for count elements. Sorted data is stored in keys and values.
+	void SortKeyValues(
+		std::uint64_t* keys,
+		std::uint32_t* values,
+		const std::size_t count,
+		std::uint64_t* tmpKeys,
+		std::uint32_t* tmpValues) noexcept;
+}
\ No newline at end of file
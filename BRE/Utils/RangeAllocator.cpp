@@ -0,0 +1,107 @@
+#include "RangeAllocator.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include "DebugUtils.h"
+
+RangeAllocator::RangeAllocator(const std::uint32_t capacity) noexcept
+	: mCapacity(capacity)
+{
+	ASSERT(capacity > 0U);
+	mSizeByFreeOffset.insert(std::make_pair(0U, capacity));
+}
+
+std::uint32_t RangeAllocator::Allocate(const std::uint32_t size) noexcept {
+	ASSERT(size > 0U);
+
+	for (SizeByOffset::iterator it = mSizeByFreeOffset.begin(); it != mSizeByFreeOffset.end(); ++it) {
+		if (it->second < size) {
+			continue;
+		}
+
+		// Take the beginning of the free range and keep the remaining
+		const std::uint32_t offset{ it->first };
+		const std::uint32_t remainingSize{ it->second - size };
+		mSizeByFreeOffset.erase(it);
+		if (remainingSize > 0U) {
+			mSizeByFreeOffset.insert(std::make_pair(offset + size, remainingSize));
+		}
+
+		mSizeByAllocatedOffset.insert(std::make_pair(offset, size));
+		mUsedSize += size;
+
+		return offset;
+	}
+
+	return sInvalidOffset;
+}
+
+void RangeAllocator::Free(const std::uint32_t offset) noexcept {
+	SizeByOffset::iterator allocatedIt{ mSizeByAllocatedOffset.find(offset) };
+	ASSERT(allocatedIt != mSizeByAllocatedOffset.end());
+
+	std::uint32_t freeOffset{ offset };
+	std::uint32_t freeSize{ allocatedIt->second };
+	mUsedSize -= freeSize;
+	mSizeByAllocatedOffset.erase(allocatedIt);
+
+	// Merge with next free range
+	SizeByOffset::iterator nextIt{ mSizeByFreeOffset.lower_bound(freeOffset) };
+	if (nextIt != mSizeByFreeOffset.end() && nextIt->first == freeOffset + freeSize) {
+		freeSize += nextIt->second;
+		nextIt = mSizeByFreeOffset.erase(nextIt);
+	}
+
+	// Merge with previous free range
+	if (nextIt != mSizeByFreeOffset.begin()) {
+		SizeByOffset::iterator prevIt{ std::prev(nextIt) };
+		if (prevIt->first + prevIt->second == freeOffset) {
+			freeOffset = prevIt->first;
+			freeSize += prevIt->second;
+			mSizeByFreeOffset.erase(prevIt);
+		}
+	}
+
+	mSizeByFreeOffset.insert(std::make_pair(freeOffset, freeSize));
+}
+
+std::uint32_t RangeAllocator::LargestFreeRange() const noexcept {
+	std::uint32_t largestSize{ 0U };
+	for (const SizeByOffset::value_type& freeRange : mSizeByFreeOffset) {
+		largestSize = std::max(largestSize, freeRange.second);
+	}
+
+	return largestSize;
+}
+
+bool RangeAllocator::ValidateData() const noexcept {
+	// Walk free and allocated ranges in offset order. They must be contiguous,
+	// and two free ranges must never be adjacent (they should have been merged).
+	SizeByOffset::const_iterator freeIt{ mSizeByFreeOffset.begin() };
+	SizeByOffset::const_iterator allocatedIt{ mSizeByAllocatedOffset.begin() };
+	std::uint32_t offset{ 0U };
+	std::uint32_t usedSize{ 0U };
+	bool prevWasFree{ false };
+	while (freeIt != mSizeByFreeOffset.end() || allocatedIt != mSizeByAllocatedOffset.end()) {
+		if (freeIt != mSizeByFreeOffset.end() && freeIt->first == offset) {
+			if (prevWasFree || freeIt->second == 0U) {
+				return false;
+			}
+			offset += freeIt->second;
+			prevWasFree = true;
+			++freeIt;
+		}
+		else if (allocatedIt != mSizeByAllocatedOffset.end() && allocatedIt->first == offset) {
+			offset += allocatedIt->second;
+			usedSize += allocatedIt->second;
+			prevWasFree = false;
+			++allocatedIt;
+		}
+		else {
+			return false;
+		}
+	}
+
+	return offset == mCapacity && usedSize == mUsedSize;
+}
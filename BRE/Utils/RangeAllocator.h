@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+
+#include <Utils/ForceInline.h>
+
+// Sub-allocates [offset, offset + size) ranges inside [0, capacity).
+// It does not own memory, units are chosen by the caller (elements, bytes, etc).
+// It is used to sub-allocate big GPU buffers, but it does not depend on D3D.
+// Steps:
+// - Allocate() ranges. It uses first fit.
+// - Free() ranges. Adjacent free ranges are merged.
+// Allocated ranges never move (GeometryPool meshes and draw packets keep their offsets).
+// It is not thread-safe.
+class RangeAllocator {
+public:
+	static const std::uint32_t sInvalidOffset{ 0xFFFFFFFFU };
+
+	explicit RangeAllocator(const std::uint32_t capacity) noexcept;
+	~RangeAllocator() = default;
+	RangeAllocator(const RangeAllocator&) = delete;
+	const RangeAllocator& operator=(const RangeAllocator&) = delete;
+	RangeAllocator(RangeAllocator&&) = default;
+	RangeAllocator& operator=(RangeAllocator&&) = default;
+
+	// Returns sInvalidOffset if there is not a free range big enough.
+	std::uint32_t Allocate(const std::uint32_t size) noexcept;
+
+	// offset must be a value returned by Allocate()
+	void Free(const std::uint32_t offset) noexcept;
+
+	__forceinline std::uint32_t Capacity() const noexcept { return mCapacity; }
+	__forceinline std::uint32_t UsedSize() const noexcept { return mUsedSize; }
+	__forceinline std::uint32_t FreeSize() const noexcept { return mCapacity - mUsedSize; }
+	__forceinline std::size_t AllocationCount() const noexcept { return mSizeByAllocatedOffset.size(); }
+	std::uint32_t LargestFreeRange() const noexcept;
+
+	// Checks free and allocated ranges do not overlap and cover all capacity.
+	bool ValidateData() const noexcept;
+
+private:
+	using SizeByOffset = std::map<std::uint32_t, std::uint32_t>;
+	SizeByOffset mSizeByFreeOffset;
+	SizeByOffset mSizeByAllocatedOffset;
+
+	std::uint32_t mCapacity{ 0U };
+	std::uint32_t mUsedSize{ 0U };
+};
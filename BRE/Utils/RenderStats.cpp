@@ -0,0 +1,133 @@
+#include "RenderStats.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+#include <Utils/DebugUtils.h>
+
+namespace {
+	const std::size_t sCacheLineSize{ 64UL };
+
+	// Counters of a thread. Only its thread writes them, so increments
+	// are a relaxed load and store instead of a locked read-modify-write.
+	// Alignment keeps counters of different threads in different cache lines.
+	struct alignas(sCacheLineSize) Shard {
+		std::atomic<std::uint64_t> mValues[RenderStats::COUNTER_COUNT];
+	};
+	static_assert(sizeof(Shard) % sCacheLineSize == 0UL, "Shards must not share cache lines");
+
+	// Shards are never destroyed, so thread local pointers are always valid.
+	// operator new does not align to more than max_align_t before C++17, so
+	// shards are placed in cache line aligned addresses of their storage.
+	std::vector<std::unique_ptr<std::uint8_t[]>> sShardStorages;
+	std::vector<Shard*> sShards;
+	std::mutex sShardsMutex;
+
+	thread_local Shard* sCurrentShard{ nullptr };
+
+	Shard& CurrentShard() noexcept {
+		if (sCurrentShard == nullptr) {
+			std::unique_ptr<std::uint8_t[]> storage{ new std::uint8_t[sizeof(Shard) + sCacheLineSize - 1UL] };
+			const std::uintptr_t address{ reinterpret_cast<std::uintptr_t>(storage.get()) };
+			const std::uintptr_t alignedAddress{ (address + sCacheLineSize - 1UL) & ~static_cast<std::uintptr_t>(sCacheLineSize - 1UL) };
+			Shard* shard{ new (reinterpret_cast<void*>(alignedAddress)) Shard() };
+			for (std::uint32_t i = 0U; i < RenderStats::COUNTER_COUNT; ++i) {
+				shard->mValues[i].store(0UL, std::memory_order_relaxed);
+			}
+
+			std::lock_guard<std::mutex> lock(sShardsMutex);
+			sShardStorages.push_back(std::move(storage));
+			sShards.push_back(shard);
+			sCurrentShard = shard;
+		}
+
+		return *sCurrentShard;
+	}
+
+	__forceinline void Increment(std::atomic<std::uint64_t>& value, const std::uint64_t increment) noexcept {
+		value.store(value.load(std::memory_order_relaxed) + increment, std::memory_order_relaxed);
+	}
+
+	const char* sCounterNames[RenderStats::COUNTER_COUNT]{
+		"draws",
+		"instances",
+		"indices",
+		"pso changes",
+		"root signature changes",
+		"descriptor tables",
+		"barriers",
+		"command lists",
+		"executes",
+		"uploaded bytes",
+	};
+}
+
+namespace RenderStats {
+	Counters& Counters::operator+=(const Counters& counters) noexcept {
+		for (std::uint32_t i = 0U; i < COUNTER_COUNT; ++i) {
+			mValues[i] += counters.mValues[i];
+		}
+
+		return *this;
+	}
+
+	Counters& Counters::operator-=(const Counters& counters) noexcept {
+		for (std::uint32_t i = 0U; i < COUNTER_COUNT; ++i) {
+			ASSERT(mValues[i] >= counters.mValues[i]);
+			mValues[i] -= counters.mValues[i];
+		}
+
+		return *this;
+	}
+
+	void Add(const Counter counter, const std::uint64_t value) noexcept {
+		ASSERT(counter < COUNTER_COUNT);
+		Increment(CurrentShard().mValues[counter], value);
+	}
+
+	void AddDraw(const std::uint32_t indexCountPerInstance, const std::uint32_t instanceCount) noexcept {
+		Shard& shard(CurrentShard());
+		Increment(shard.mValues[DRAW_CALLS], 1UL);
+		Increment(shard.mValues[INSTANCES], instanceCount);
+		Increment(shard.mValues[INDICES], static_cast<std::uint64_t>(indexCountPerInstance) * instanceCount);
+	}
+
+	void AddExecute(const std::uint32_t cmdListCount) noexcept {
+		Shard& shard(CurrentShard());
+		Increment(shard.mValues[EXECUTE_COMMAND_LISTS_CALLS], 1UL);
+		Increment(shard.mValues[COMMAND_LISTS], cmdListCount);
+	}
+
+	Counters Snapshot() noexcept {
+		Counters counters;
+
+		std::lock_guard<std::mutex> lock(sShardsMutex);
+		for (const Shard* shard : sShards) {
+			for (std::uint32_t i = 0U; i < COUNTER_COUNT; ++i) {
+				counters.mValues[i] += shard->mValues[i].load(std::memory_order_relaxed);
+			}
+		}
+
+		return counters;
+	}
+
+	const char* CounterName(const Counter counter) noexcept {
+		ASSERT(counter < COUNTER_COUNT);
+		return sCounterNames[counter];
+	}
+
+	void WriteCounters(std::ostream& stream, const char* label, const Counters& counters) noexcept {
+		ASSERT(label != nullptr);
+
+		stream << label << ":";
+		for (std::uint32_t i = 0U; i < COUNTER_COUNT; ++i) {
+			stream << (i == 0U ? " " : ", ") << sCounterNames[i] << " " << counters.mValues[i];
+		}
+		stream << "\n";
+	}
+}
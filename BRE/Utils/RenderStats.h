@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+
+// Set it to 0 to compile out all counters (RENDER_STATS_* macros expand to nothing).
+#ifndef RENDER_STATS_ENABLED
+#define RENDER_STATS_ENABLED 1
+#endif
+
+// Counters of the work submitted to the GPU (draws, state changes, barriers, uploads, etc).
+// Each thread increments its own shard (only the thread writes to it, without locks or
+// atomic read-modify-write operations), and shards are summed when counters are read.
+// Counters are never reset, work between two points is the difference of their snapshots.
+// Steps:
+// - Use RENDER_STATS_* macros where work is recorded or submitted.
+// - Call RenderStats::Snapshot() (from any thread) before and after the work to measure,
+// and subtract them.
+namespace RenderStats {
+	enum Counter {
+		DRAW_CALLS = 0U,
+		INSTANCES,
+		INDICES, // Vertices of non indexed draws are counted as indices
+		PIPELINE_STATE_CHANGES,
+		ROOT_SIGNATURE_CHANGES,
+		DESCRIPTOR_TABLES,
+		RESOURCE_BARRIERS,
+		COMMAND_LISTS,
+		EXECUTE_COMMAND_LISTS_CALLS,
+		UPLOADED_BYTES,
+		COUNTER_COUNT
+	};
+
+	struct Counters {
+		Counters& operator+=(const Counters& counters) noexcept;
+		Counters& operator-=(const Counters& counters) noexcept;
+
+		std::uint64_t mValues[COUNTER_COUNT]{ 0UL };
+	};
+
+	void Add(const Counter counter, const std::uint64_t value) noexcept;
+
+	// Adds a draw call, its instances and its indices (indexCountPerInstance * instanceCount)
+	void AddDraw(const std::uint32_t indexCountPerInstance, const std::uint32_t instanceCount) noexcept;
+
+	// Adds an ExecuteCommandLists() call and its command lists
+	void AddExecute(const std::uint32_t cmdListCount) noexcept;
+
+	// Sum of all threads counters. Increments done while it is called can be missing.
+	Counters Snapshot() noexcept;
+
+	const char* CounterName(const Counter counter) noexcept;
+
+	// Writes counters in a single line, preceded by label
+	void WriteCounters(std::ostream& stream, const char* label, const Counters& counters) noexcept;
+}
+
+#if RENDER_STATS_ENABLED
+#define RENDER_STATS_ADD(counter, value) RenderStats::Add(RenderStats::counter, value)
+#define RENDER_STATS_DRAW(indexCountPerInstance, instanceCount) RenderStats::AddDraw(indexCountPerInstance, instanceCount)
+#define RENDER_STATS_EXECUTE(cmdListCount) RenderStats::AddExecute(cmdListCount)
+#else
+#define RENDER_STATS_ADD(counter, value)
+#define RENDER_STATS_DRAW(indexCountPerInstance, instanceCount)
+#define RENDER_STATS_EXECUTE(cmdListCount)
+#endif
@@ -0,0 +1,151 @@
+#include "TaskGraph.h"
+
+#include <fstream>
+#include <thread>
+
+#include "DebugUtils.h"
+
+namespace {
+	std::uint64_t Microseconds(const std::chrono::steady_clock::time_point& begin, const std::chrono::steady_clock::time_point& end) noexcept {
+		return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count());
+	}
+}
+
+std::uint32_t TaskGraph::AddTask(
+	const char* name, 
+	const std::function<void()>& function, 
+	const std::initializer_list<std::uint32_t> dependencies,
+	const bool serial) noexcept 
+{
+	return AddTask(name, function, dependencies.begin(), dependencies.size(), serial);
+}
+
+std::uint32_t TaskGraph::AddTask(
+	const char* name,
+	const std::function<void()>& function,
+	const std::vector<std::uint32_t>& dependencies,
+	const bool serial) noexcept
+{
+	return AddTask(name, function, dependencies.data(), dependencies.size(), serial);
+}
+
+std::uint32_t TaskGraph::AddTask(
+	const char* name,
+	const std::function<void()>& function,
+	const std::uint32_t* dependencies,
+	const std::size_t dependencyCount,
+	const bool serial) noexcept
+{
+	ASSERT(name != nullptr);
+	ASSERT(function);
+	ASSERT(dependencies != nullptr || dependencyCount == 0UL);
+	ASSERT(mExecuted == false);
+
+	const std::uint32_t id{ TaskCount() };
+	mTasks.emplace_back(new Task());
+	Task& task(*mTasks.back());
+	task.mName = name;
+	task.mFunction = function;
+	task.mSerial = serial;
+	for (std::size_t i = 0UL; i < dependencyCount; ++i) {
+		const std::uint32_t dependency{ dependencies[i] };
+		ASSERT(dependency < id);
+		mTasks[dependency]->mSuccessors.push_back(id);
+		++task.mDependencyCount;
+	}
+
+	return id;
+}
+
+void TaskGraph::Run() noexcept {
+	ASSERT(mExecuted == false);
+	mExecuted = true;
+
+	for (std::unique_ptr<Task>& task : mTasks) {
+		task->mPendingCount = task->mDependencyCount;
+	}
+
+	mRunStart = Clock::now();
+
+	tbb::task_group taskGroup;
+	const std::uint32_t taskCount{ TaskCount() };
+	for (std::uint32_t i = 0U; i < taskCount; ++i) {
+		if (mTasks[i]->mDependencyCount == 0U) {
+			taskGroup.run([this, i, &taskGroup]() { Execute(i, taskGroup); });
+		}
+	}
+	taskGroup.wait();
+
+	mRunTime = Microseconds(mRunStart, Clock::now());
+
+#ifdef _DEBUG
+	for (const std::unique_ptr<Task>& task : mTasks) {
+		ASSERT(task->mPendingCount == 0U);
+		ASSERT(task->mEnd >= task->mStart);
+	}
+#endif
+}
+
+void TaskGraph::Execute(const std::uint32_t id, tbb::task_group& taskGroup) noexcept {
+	Task& task(*mTasks[id]);
+	ASSERT(task.mPendingCount == 0U);
+
+	task.mThread = static_cast<std::uint32_t>(std::hash<std::thread::id>()(std::this_thread::get_id()));
+	if (task.mSerial) {
+		std::lock_guard<std::mutex> lock(mSerialMutex);
+		task.mStart = Clock::now();
+		task.mFunction();
+		task.mEnd = Clock::now();
+	}
+	else {
+		task.mStart = Clock::now();
+		task.mFunction();
+		task.mEnd = Clock::now();
+	}
+
+	// The last finished dependency spawns the successor
+	for (const std::uint32_t successor : task.mSuccessors) {
+		if (--mTasks[successor]->mPendingCount == 0U) {
+			taskGroup.run([this, successor, &taskGroup]() { Execute(successor, taskGroup); });
+		}
+	}
+}
+
+std::uint64_t TaskGraph::TaskStartTime(const std::uint32_t id) const noexcept {
+	ASSERT(mExecuted);
+	ASSERT(id < TaskCount());
+	return Microseconds(mRunStart, mTasks[id]->mStart);
+}
+
+std::uint64_t TaskGraph::TaskEndTime(const std::uint32_t id) const noexcept {
+	ASSERT(mExecuted);
+	ASSERT(id < TaskCount());
+	return Microseconds(mRunStart, mTasks[id]->mEnd);
+}
+
+bool TaskGraph::WriteTrace(const char* filename) const noexcept {
+	ASSERT(filename != nullptr);
+	ASSERT(mExecuted);
+
+	std::ofstream fout{ filename, std::ios::trunc };
+	if (!fout) {
+		return false;
+	}
+
+	// Complete events ("ph": "X") with time stamps and durations in microseconds
+	fout << "{\"traceEvents\":[\n";
+	const std::uint32_t taskCount{ TaskCount() };
+	for (std::uint32_t i = 0U; i < taskCount; ++i) {
+		const Task& task(*mTasks[i]);
+		const std::uint64_t start{ TaskStartTime(i) };
+		fout << "{\"name\":\"" << task.mName
+			<< "\",\"cat\":\"" << (task.mSerial ? "serial" : "parallel")
+			<< "\",\"ph\":\"X\",\"ts\":" << start
+			<< ",\"dur\":" << TaskEndTime(i) - start
+			<< ",\"pid\":0,\"tid\":" << task.mThread
+			<< (i + 1U < taskCount ? "},\n" : "}\n");
+	}
+	fout << "]}\n";
+
+	return static_cast<bool>(fout);
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <tbb/task_group.h>
+#include <vector>
+
+#include <Utils/ForceInline.h>
+
+// Runs a set of tasks with explicit dependencies, as concurrently as they allow.
+// A task starts once all its dependencies finished. Serial tasks never run at the same 
+// time as other serial tasks (use it for steps that submit to the device and wait for it).
+// Start and end times of each task are recorded, so the timeline can be written as a trace.
+// Steps:
+// - Call AddTask() for each task. Dependencies must be already added tasks, so the graph can not have cycles.
+// - Call Run() once. It blocks until all tasks finished.
+// - Call WriteTrace() to inspect the timeline (chrome://tracing format).
+class TaskGraph {
+public:
+	TaskGraph() = default;
+	~TaskGraph() = default;
+	TaskGraph(const TaskGraph&) = delete;
+	const TaskGraph& operator=(const TaskGraph&) = delete;
+	TaskGraph(TaskGraph&&) = delete;
+	TaskGraph& operator=(TaskGraph&&) = delete;
+
+	// Returns the task id, to be used as dependency of next tasks.
+	// name must be valid until the trace is written.
+	std::uint32_t AddTask(
+		const char* name, 
+		const std::function<void()>& function, 
+		const std::initializer_list<std::uint32_t> dependencies = {},
+		const bool serial = false) noexcept;
+
+	// Same, for a number of dependencies only known at run time
+	std::uint32_t AddTask(
+		const char* name,
+		const std::function<void()>& function,
+		const std::vector<std::uint32_t>& dependencies,
+		const bool serial = false) noexcept;
+
+	void Run() noexcept;
+
+	// Returns false if the file can not be written
+	bool WriteTrace(const char* filename) const noexcept;
+
+	__forceinline std::uint32_t TaskCount() const noexcept { return static_cast<std::uint32_t>(mTasks.size()); }
+
+	// Times in microseconds since Run() started
+	std::uint64_t TaskStartTime(const std::uint32_t id) const noexcept;
+	std::uint64_t TaskEndTime(const std::uint32_t id) const noexcept;
+
+	// Total Run() time in microseconds
+	__forceinline std::uint64_t RunTime() const noexcept { return mRunTime; }
+
+private:
+	using Clock = std::chrono::steady_clock;
+
+	struct Task {
+		const char* mName{ nullptr };
+		std::function<void()> mFunction;
+		std::vector<std::uint32_t> mSuccessors;
+		std::uint32_t mDependencyCount{ 0U };
+		bool mSerial{ false };
+
+		// Dependencies not finished yet, while running
+		std::atomic<std::uint32_t> mPendingCount{ 0U };
+
+		Clock::time_point mStart;
+		Clock::time_point mEnd;
+		std::uint32_t mThread{ 0U };
+	};
+
+	std::uint32_t AddTask(
+		const char* name,
+		const std::function<void()>& function,
+		const std::uint32_t* dependencies,
+		const std::size_t dependencyCount,
+		const bool serial) noexcept;
+
+	void Execute(const std::uint32_t id, tbb::task_group& taskGroup) noexcept;
+
+	std::vector<std::unique_ptr<Task>> mTasks;
+
+	Clock::time_point mRunStart;
+	std::uint64_t mRunTime{ 0UL };
+	bool mExecuted{ false };
+
+	std::mutex mSerialMutex;
+};